@@ -6,7 +6,7 @@ greaterThan(QT_MINOR_VERSION, 12) {
 }
 
 TARGET = gitqlient
-QT += widgets core network webenginewidgets webchannel
+QT += widgets core network webenginewidgets webchannel concurrent
 DEFINES += QT_DEPRECATED_WARNINGS
 QMAKE_LFLAGS += -no-pie
 
@@ -51,6 +51,7 @@ SOURCES += src/main.cpp
 
 include(src/App.pri)
 include(QLogger/QLogger.pri)
+include(pgo.pri)
 
 INCLUDEPATH += QLogger
 
@@ -42,6 +42,8 @@ bool QLoggerManager::addDestination(const QString &fileDest, const QString &modu
 
       startWriter(module, log, mode, notify);
 
+      rebuildFilterSnapshot();
+
       return true;
    }
 
@@ -69,6 +71,9 @@ bool QLoggerManager::addDestination(const QString &fileDest, const QStringList &
       }
    }
 
+   if (allAdded)
+      rebuildFilterSnapshot();
+
    return allAdded;
 }
 
@@ -166,6 +171,41 @@ void QLoggerManager::writeAndDequeueMessages(const QString &module)
    }
 }
 
+bool QLoggerManager::levelEnabled(const QString &module, LogLevel level)
+{
+   // The snapshot is immutable and swapped in atomically on configuration changes, so the drop
+   // decision every QLog_ call makes is a lock-free read instead of serializing the threads on
+   // the manager mutex.
+   if (const auto snapshot = mFilterSnapshot.loadAcquire())
+   {
+      const auto iter = snapshot->constFind(module);
+
+      // Modules without a destination yet go through the non-writer queue, so they count as enabled.
+      if (iter == snapshot->constEnd())
+         return true;
+
+      return iter->enabled && iter->level <= level;
+   }
+
+   return true;
+}
+
+void QLoggerManager::rebuildFilterSnapshot()
+{
+   const auto snapshot = new QHash<QString, FilterEntry>();
+
+   for (auto iter = mModuleDest.cbegin(); iter != mModuleDest.cend(); ++iter)
+   {
+      snapshot->insert(iter.key(),
+                       { iter.value()->getLevel(),
+                         iter.value()->getMode() != LogMode::Disabled && !iter.value()->isStop() });
+   }
+
+   // A logging thread may still read the superseded snapshot, so it is retired instead of deleted.
+   if (const auto old = mFilterSnapshot.fetchAndStoreOrdered(snapshot))
+      mRetiredSnapshots.append(old);
+}
+
 void QLoggerManager::enqueueMessage(const QString &module, LogLevel level, const QString &message,
                                     const QString &function, const QString &file, int line)
 {
@@ -197,6 +237,8 @@ void QLoggerManager::pause()
 
    for (auto &logWriter : mModuleDest)
       logWriter->stop(mIsStop);
+
+   rebuildFilterSnapshot();
 }
 
 void QLoggerManager::resume()
@@ -207,6 +249,8 @@ void QLoggerManager::resume()
 
    for (auto &logWriter : mModuleDest)
       logWriter->stop(mIsStop);
+
+   rebuildFilterSnapshot();
 }
 
 void QLoggerManager::overwriteLogMode(LogMode mode)
@@ -217,6 +261,8 @@ void QLoggerManager::overwriteLogMode(LogMode mode)
 
    for (auto &logWriter : mModuleDest)
       logWriter->setLogMode(mode);
+
+   rebuildFilterSnapshot();
 }
 
 void QLoggerManager::overwriteLogLevel(LogLevel level)
@@ -227,6 +273,8 @@ void QLoggerManager::overwriteLogLevel(LogLevel level)
 
    for (auto &logWriter : mModuleDest)
       logWriter->setLogLevel(level);
+
+   rebuildFilterSnapshot();
 }
 
 void QLoggerManager::overwriteMaxFileSize(int maxSize)
@@ -256,6 +304,10 @@ QLoggerManager::~QLoggerManager()
       delete dest;
 
    mModuleDest.clear();
+
+   delete mFilterSnapshot.fetchAndStoreOrdered(nullptr);
+   qDeleteAll(mRetiredSnapshots);
+   mRetiredSnapshots.clear();
 }
 
 }
@@ -24,9 +24,12 @@
 
 #include <QLoggerLevel.h>
 
+#include <QAtomicPointer>
+#include <QHash>
 #include <QMutex>
 #include <QMap>
 #include <QVariant>
+#include <QVector>
 
 namespace QLogger
 {
@@ -103,6 +106,15 @@ public:
    void enqueueMessage(const QString &module, LogLevel level, const QString &message, const QString &function,
                        const QString &file, int line);
 
+   /**
+    * @brief levelEnabled Checks whether a message of the given level for the given module would be accepted. Used by
+    * the log macros to skip the message formatting entirely when the level filter rejects it.
+    * @param module The module that wants to write the message.
+    * @param level The level of the message.
+    * @return True if a message of that level would be written, otherwise false.
+    */
+   bool levelEnabled(const QString &module, LogLevel level);
+
    /**
     * @brief Whether the QLogger is paused or not.
     */
@@ -169,6 +181,16 @@ public:
    void overwriteMaxFileSize(int maxSize);
 
 private:
+   /**
+    * @brief The per-module data the drop-fast-path needs: the level threshold and whether the
+    * destination currently accepts messages at all.
+    */
+   struct FilterEntry
+   {
+      LogLevel level;
+      bool enabled;
+   };
+
    /**
     * @brief Checks if the logger is stop
     */
@@ -179,6 +201,18 @@ private:
     */
    QMap<QString, QLoggerWriter *> mModuleDest;
 
+   /**
+    * @brief Immutable snapshot of the module filters, swapped in atomically on every configuration
+    * change so levelEnabled() reads it without taking the mutex.
+    */
+   QAtomicPointer<const QHash<QString, FilterEntry>> mFilterSnapshot;
+
+   /**
+    * @brief Superseded snapshots. A reader may still hold a pointer to one while the swap happens,
+    * so they are retired here and freed with the manager instead of deleted on the spot.
+    */
+   QVector<const QHash<QString, FilterEntry> *> mRetiredSnapshots;
+
    /**
     * @brief Defines the queue of messages when no writters have been set yet.
     */
@@ -232,6 +266,12 @@ private:
     * @param module The module to dequeue the messages from
     */
    void writeAndDequeueMessages(const QString &module);
+
+   /**
+    * @brief Publishes a fresh immutable snapshot of the module filters. Must be called with the
+    * mutex held by every method that changes a destination's level, mode or stop state.
+    */
+   void rebuildFilterSnapshot();
 };
 
 /**
@@ -251,15 +291,42 @@ extern void QLog_(const QString &module, QLogger::LogLevel level, const QString
 
 }
 
+#ifndef QLOGGER_MIN_LEVEL
+/**
+ * @brief Build-time minimum log level. Calls below this level compile to nothing, so release builds can strip Trace
+ * and Debug logging entirely with DEFINES += QLOGGER_MIN_LEVEL=2. The values match the LogLevel enum.
+ */
+#   define QLOGGER_MIN_LEVEL 0
+#endif
+
+#ifndef QLog_Enqueue
+/**
+ * @brief Common implementation of the log macros. The level filter is checked before the message argument is
+ * evaluated, so a rejected message never pays for its QString formatting; levels below QLOGGER_MIN_LEVEL are removed
+ * at compile time.
+ * @param module The module that the message references.
+ * @param level The level of the message.
+ * @param levelValue The numeric value of the level, compared against QLOGGER_MIN_LEVEL.
+ * @param message The message.
+ */
+#   define QLog_Enqueue(module, level, levelValue, message)                                                            \
+      do                                                                                                               \
+      {                                                                                                                \
+         if ((levelValue) >= QLOGGER_MIN_LEVEL && QLogger::QLoggerManager::getInstance()->levelEnabled(module, level)) \
+         {                                                                                                             \
+            QLogger::QLoggerManager::getInstance()->enqueueMessage(module, level, message, __FUNCTION__, __FILE__,     \
+                                                                   __LINE__);                                          \
+         }                                                                                                             \
+      } while (false)
+#endif
+
 #ifndef QLog_Trace
 /**
  * @brief Used to store Trace level messages.
  * @param module The module that the message references.
  * @param message The message.
  */
-#   define QLog_Trace(module, message)                                                                                 \
-      QLogger::QLoggerManager::getInstance()->enqueueMessage(module, QLogger::LogLevel::Trace, message, __FUNCTION__,  \
-                                                             __FILE__, __LINE__)
+#   define QLog_Trace(module, message) QLog_Enqueue(module, QLogger::LogLevel::Trace, 0, message)
 #endif
 
 #ifndef QLog_Debug
@@ -268,9 +335,7 @@ extern void QLog_(const QString &module, QLogger::LogLevel level, const QString
  * @param module The module that the message references.
  * @param message The message.
  */
-#   define QLog_Debug(module, message)                                                                                 \
-      QLogger::QLoggerManager::getInstance()->enqueueMessage(module, QLogger::LogLevel::Debug, message, __FUNCTION__,  \
-                                                             __FILE__, __LINE__)
+#   define QLog_Debug(module, message) QLog_Enqueue(module, QLogger::LogLevel::Debug, 1, message)
 #endif
 
 #ifndef QLog_Info
@@ -279,9 +344,7 @@ extern void QLog_(const QString &module, QLogger::LogLevel level, const QString
  * @param module The module that the message references.
  * @param message The message.
  */
-#   define QLog_Info(module, message)                                                                                  \
-      QLogger::QLoggerManager::getInstance()->enqueueMessage(module, QLogger::LogLevel::Info, message, __FUNCTION__,   \
-                                                             __FILE__, __LINE__)
+#   define QLog_Info(module, message) QLog_Enqueue(module, QLogger::LogLevel::Info, 2, message)
 #endif
 
 #ifndef QLog_Warning
@@ -290,9 +353,7 @@ extern void QLog_(const QString &module, QLogger::LogLevel level, const QString
  * @param module The module that the message references.
  * @param message The message.
  */
-#   define QLog_Warning(module, message)                                                                               \
-      QLogger::QLoggerManager::getInstance()->enqueueMessage(module, QLogger::LogLevel::Warning, message,              \
-                                                             __FUNCTION__, __FILE__, __LINE__)
+#   define QLog_Warning(module, message) QLog_Enqueue(module, QLogger::LogLevel::Warning, 3, message)
 #endif
 
 #ifndef QLog_Error
@@ -301,9 +362,7 @@ extern void QLog_(const QString &module, QLogger::LogLevel level, const QString
  * @param module The module that the message references.
  * @param message The message.
  */
-#   define QLog_Error(module, message)                                                                                 \
-      QLogger::QLoggerManager::getInstance()->enqueueMessage(module, QLogger::LogLevel::Error, message, __FUNCTION__,  \
-                                                             __FILE__, __LINE__)
+#   define QLog_Error(module, message) QLog_Enqueue(module, QLogger::LogLevel::Error, 4, message)
 #endif
 
 #ifndef QLog_Fatal
@@ -312,7 +371,5 @@ extern void QLog_(const QString &module, QLogger::LogLevel level, const QString
  * @param module The module that the message references.
  * @param message The message.
  */
-#   define QLog_Fatal(module, message)                                                                                 \
-      QLogger::QLoggerManager::getInstance()->enqueueMessage(module, QLogger::LogLevel::Fatal, message, __FUNCTION__,  \
-                                                             __FILE__, __LINE__)
+#   define QLog_Fatal(module, message) QLog_Enqueue(module, QLogger::LogLevel::Fatal, 5, message)
 #endif
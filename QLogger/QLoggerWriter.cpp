@@ -5,6 +5,7 @@
 #include <QTextStream>
 #include <QDir>
 #include <QDebug>
+#include <QtConcurrent/QtConcurrentRun>
 
 namespace
 {
@@ -33,6 +34,37 @@ QString levelToText(const QLogger::LogLevel &level)
 
    return QString();
 }
+
+/**
+ * @brief Compresses a rotated log file. The compressed data is written next to the original with
+ * a .z suffix and swapped in atomically; the uncompressed file is only removed once the swap
+ * succeeded, so a crash mid-compression never loses logs.
+ * @param path The rotated file to compress.
+ */
+void compressRotatedFile(const QString &path)
+{
+   QFile in(path);
+
+   if (!in.open(QIODevice::ReadOnly))
+      return;
+
+   const auto compressed = qCompress(in.readAll(), 9);
+   in.close();
+
+   if (compressed.isEmpty())
+      return;
+
+   const auto tmpName = path + QString::fromLatin1(".z.tmp");
+
+   if (QFile out(tmpName); out.open(QIODevice::WriteOnly))
+   {
+      out.write(compressed);
+      out.close();
+
+      if (QFile::rename(tmpName, path + QString::fromLatin1(".z")))
+         QFile::remove(path);
+   }
+}
 }
 
 namespace QLogger
@@ -121,28 +153,41 @@ QString QLoggerWriter::generateDuplicateFilename(const QString &fileDestination,
    return path;
 }
 
-void QLoggerWriter::write(const EnqueuedMessage &message)
+void QLoggerWriter::write(const QVector<EnqueuedMessage> &messages)
 {
+   if (messages.isEmpty())
+      return;
+
    // Write data to console
    if (mMode == LogMode::OnlyConsole || mMode == LogMode::Full)
-      qInfo() << message.message;
+   {
+      for (const auto &message : messages)
+         qInfo() << message.message;
+   }
 
    if (mMode == LogMode::OnlyConsole)
       return;
 
-   // Write data to file
+   // Write data to file. The file is opened once per drained batch, so a burst of log calls
+   // costs a single open/flush/close cycle instead of one per message.
    QFile file(mFileDestination);
 
    const auto prevFilename = renameFileIfFull();
 
+   // The rename itself is a single atomic swap; the compression of the rotated file runs on the
+   // global pool so the writer thread goes straight back to appending.
+   if (!prevFilename.isEmpty())
+      QtConcurrent::run(compressRotatedFile, prevFilename);
+
    if (file.open(QIODevice::ReadWrite | QIODevice::Text | QIODevice::Append))
    {
       QTextStream out(&file);
 
       if (!prevFilename.isEmpty())
-         out << QString("%1 - Previous log %2\n").arg(message.threadId, prevFilename);
+         out << QString("%1 - Previous log %2\n").arg(messages.constFirst().threadId, prevFilename);
 
-      out << message.message;
+      for (const auto &message : messages)
+         out << message.message;
 
       file.close();
    }
@@ -151,8 +196,6 @@ void QLoggerWriter::write(const EnqueuedMessage &message)
 void QLoggerWriter::enqueue(const QDateTime &date, const QString &threadId, const QString &module, LogLevel level,
                             const QString &function, const QString &fileName, int line, const QString &message)
 {
-   QMutexLocker locker(&mutex);
-
    if (mMode == LogMode::Disabled)
       return;
 
@@ -207,6 +250,10 @@ void QLoggerWriter::enqueue(const QDateTime &date, const QString &threadId, cons
 
    text.append(QString::fromLatin1("\n"));
 
+   // Only the queue append runs under the lock: the message was formatted above on the caller's
+   // thread without serializing against the other threads that log concurrently.
+   QMutexLocker locker(&mutex);
+
    messages.append({ threadId, text });
 
    if (!mIsStop)
@@ -230,8 +277,7 @@ void QLoggerWriter::run()
          std::swap(copy, messages);
       }
 
-      for (const auto &msg : qAsConst(copy))
-         write(msg);
+      write(copy);
 
       copy.clear();
 
@@ -184,12 +184,12 @@ private:
                                             int fileSuffixNumber = 1);
 
    /**
-    * @brief Writes a message in a file. If the file is full, it truncates it and prints a first line with the
-    * information of the old file.
+    * @brief Writes a batch of messages in a file opening it only once. If the file is full, it truncates it and
+    * prints a first line with the information of the old file.
     *
-    * @param message Pair of values consistent on the date and the message to be log.
+    * @param messages The batch of messages drained from the queue.
     */
-   void write(const EnqueuedMessage &message);
+   void write(const QVector<EnqueuedMessage> &messages);
 };
 
 }
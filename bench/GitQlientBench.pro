@@ -0,0 +1,42 @@
+#Benchmark harness for the load pipeline. It links the same sources as the application and
+#replays recorded git output through GitRepoLoader, GitCache and DiffHelper, so performance
+#changes can ship with before/after numbers. Build it separately from GitQlient.pro:
+#   qmake bench/GitQlientBench.pro && make
+CONFIG += qt warn_on c++ 17 c++1z console
+CONFIG -= app_bundle
+
+greaterThan(QT_MINOR_VERSION, 12) {
+!msvc:QMAKE_CXXFLAGS += -Werror
+}
+
+TARGET = gitqlientbench
+QT += widgets core network webenginewidgets webchannel concurrent
+DEFINES += QT_DEPRECATED_WARNINGS
+QMAKE_LFLAGS += -no-pie
+
+SOURCES += $$PWD/main.cpp
+
+include($$PWD/../src/App.pri)
+include($$PWD/../QLogger/QLogger.pri)
+include($$PWD/../pgo.pri)
+
+INCLUDEPATH += $$PWD/../QLogger
+
+VERSION = 1.3.2
+
+GQ_SHA = $$system(git rev-parse HEAD)
+
+DEFINES += \
+    VER=\\\"$$VERSION\\\" \
+    SHA_VER=\\\"$$GQ_SHA\\\"
+
+DEFINES += \
+   QT_NO_JAVA_STYLE_ITERATORS \
+   QT_NO_CAST_TO_ASCII \
+   QT_RESTRICTED_CAST_FROM_ASCII \
+   QT_DISABLE_DEPRECATED_BEFORE=0x050900 \
+   QT_USE_QSTRINGBUILDER
+
+OTHER_FILES += \
+    $$PWD/fixtures/gitqlient.log.qz \
+    $$PWD/fixtures/gitqlient.diff.qz
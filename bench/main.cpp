@@ -0,0 +1,270 @@
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+#include <CommitInfo.h>
+#include <DiffHelper.h>
+#include <GitBase.h>
+#include <GitCache.h>
+#include <GitQlientSettings.h>
+#include <GitRepoLoader.h>
+#include <WipRevisionInfo.h>
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QProcess>
+#include <QSharedPointer>
+#include <QTextStream>
+
+/**
+ * @brief The GitQlientBench class drives the load pipeline with recorded git output instead of a
+ * live repository. It is declared as a friend of GitRepoLoader and GitCache so it measures exactly
+ * the code the application runs, without widening their interfaces for the benchmark's sake.
+ *
+ * Two modes are available:
+ * - `gitqlientbench --record <repoPath> <fixtureDir>` records the log and diff output of the given
+ * repository into compressed fixtures. Large local checkouts make the most useful corpora.
+ * - `gitqlientbench <fixtureDir>` replays every fixture in the directory through the parse, cache
+ * setup and lanes stages and prints the timing and memory numbers of each stage.
+ */
+class GitQlientBench
+{
+public:
+   static int record(const QString &repoPath, const QString &fixtureDir);
+   static int replay(const QString &fixtureDir);
+
+private:
+   static QByteArray runGit(const QString &repoPath, const QStringList &arguments, bool &ok);
+   static bool writeFixture(const QString &filePath, const QByteArray &data);
+   static QByteArray readFixture(const QString &filePath);
+   static qint64 peakRssInKb();
+   static void replayFixture(QTextStream &out, const QFileInfo &logFixture);
+};
+
+int GitQlientBench::record(const QString &repoPath, const QString &fixtureDir)
+{
+   QTextStream out(stdout);
+
+   // The arguments must stay in sync with the command built by GitRepoLoader::requestRevisions,
+   // otherwise the replay would parse a corpus the application never produces.
+   auto ok = false;
+   const auto log = runGit(repoPath,
+                           { "log", "--author-date-order", "--no-color", "--log-size", "--parents", "--boundary", "-z",
+                             "--pretty=format:%m%HX%P%n%cn<%ce>%n%an<%ae>%n%at%n%s%n ", "--all" },
+                           ok);
+
+   if (!ok || log.isEmpty())
+   {
+      out << "Could not record the log of " << repoPath << Qt::endl;
+      return 1;
+   }
+
+   // The diff between the root commit and HEAD is the largest diff the repository can produce,
+   // which is what the DiffHelper stage should be measured against.
+   const auto roots = runGit(repoPath, { "rev-list", "--max-parents=0", "HEAD" }, ok);
+   const auto root = QString::fromUtf8(roots).split('\n', Qt::SkipEmptyParts).constLast().trimmed();
+   const auto diff = runGit(repoPath, { "diff", "--no-color", root, "HEAD" }, ok);
+
+   const auto name = QDir(repoPath).dirName();
+   const auto dir = QDir(fixtureDir);
+
+   if (!writeFixture(dir.filePath(name + ".log.qz"), log) || !writeFixture(dir.filePath(name + ".diff.qz"), diff))
+   {
+      out << "Could not write the fixtures into " << fixtureDir << Qt::endl;
+      return 1;
+   }
+
+   out << "Recorded " << name << ": " << log.count() << " bytes of log and " << diff.count() << " bytes of diff."
+       << Qt::endl;
+
+   return 0;
+}
+
+int GitQlientBench::replay(const QString &fixtureDir)
+{
+   QTextStream out(stdout);
+
+   const auto fixtures = QDir(fixtureDir).entryInfoList({ "*.log.qz" }, QDir::Files, QDir::Name);
+
+   if (fixtures.isEmpty())
+   {
+      out << "No *.log.qz fixtures found in " << fixtureDir << Qt::endl;
+      return 1;
+   }
+
+   for (const auto &fixture : fixtures)
+      replayFixture(out, fixture);
+
+   return 0;
+}
+
+void GitQlientBench::replayFixture(QTextStream &out, const QFileInfo &logFixture)
+{
+   auto log = readFixture(logFixture.absoluteFilePath());
+
+   if (log.isEmpty())
+   {
+      out << logFixture.fileName() << ": could not read the fixture." << Qt::endl;
+      return;
+   }
+
+   out << logFixture.fileName() << " (" << log.count() << " bytes)" << Qt::endl;
+
+   const auto cache = QSharedPointer<GitCache>::create();
+   GitRepoLoader loader(QSharedPointer<GitBase>::create(QString()), cache,
+                        QSharedPointer<GitQlientSettings>::create());
+
+   QElapsedTimer timer;
+   timer.start();
+
+   QList<QPair<QString, QString>> subtrees;
+   const auto commits = loader.processUnsignedLog(log, subtrees);
+
+   const auto parseMs = timer.restart();
+
+   // The WIP revision normally comes from GitWip; a fake one parented on the newest commit keeps
+   // the cache topology identical to a live load without touching git.
+   const WipRevisionInfo wip { commits.isEmpty() ? QString() : commits.constFirst().sha(), QString(), QString() };
+
+   cache->setup(wip, commits);
+
+   const auto setupMs = timer.restart();
+
+   cache->mLanesFuture.waitForFinished();
+
+   const auto lanesMs = timer.restart();
+
+   // The scroll stage replays what the delegate pulls from the cache for every visible row: the
+   // commit record and its lanes. It keeps the row-lookup path hot in the recorded profile
+   // without needing a windowing system to rasterize the rows.
+   auto laneCells = 0;
+
+   for (auto row = 0; row < commits.count(); ++row)
+      laneCells += cache->commitInfo(row).getLanesCount();
+
+   const auto scrollMs = timer.restart();
+
+   out << "   parse: " << commits.count() << " commits in " << parseMs << " ms ("
+       << (parseMs > 0 ? commits.count() * 1000 / parseMs : 0) << " commits/s)" << Qt::endl;
+   out << "   cache setup: " << setupMs << " ms" << Qt::endl;
+   out << "   lanes: " << lanesMs << " ms" << Qt::endl;
+   out << "   scroll: " << commits.count() << " rows (" << laneCells << " lane cells) in " << scrollMs << " ms"
+       << Qt::endl;
+
+   const auto diffPath = logFixture.absoluteFilePath().replace(".log.qz", ".diff.qz");
+
+   if (const auto diff = readFixture(diffPath); !diff.isEmpty())
+   {
+      const auto text = QString::fromUtf8(diff);
+
+      QPair<QStringList, QVector<ChunkDiffInfo::ChunkInfo>> newFileData;
+      QPair<QStringList, QVector<ChunkDiffInfo::ChunkInfo>> oldFileData;
+
+      timer.restart();
+
+      const auto diffInfo = DiffHelper::processDiff(text, newFileData, oldFileData);
+
+      out << "   diff: " << newFileData.first.count() << " lines and " << diffInfo.chunks.count() << " chunks in "
+          << timer.elapsed() << " ms" << Qt::endl;
+   }
+
+   if (const auto peakRss = peakRssInKb(); peakRss > 0)
+      out << "   peak RSS: " << peakRss / 1024 << " MB" << Qt::endl;
+}
+
+QByteArray GitQlientBench::runGit(const QString &repoPath, const QStringList &arguments, bool &ok)
+{
+   QProcess git;
+   git.setWorkingDirectory(repoPath);
+   git.start("git", arguments);
+
+   ok = git.waitForFinished(-1) && git.exitCode() == 0;
+
+   return git.readAllStandardOutput();
+}
+
+bool GitQlientBench::writeFixture(const QString &filePath, const QByteArray &data)
+{
+   QFile file(filePath);
+
+   if (!file.open(QIODevice::WriteOnly))
+      return false;
+
+   return file.write(qCompress(data, 9)) != -1;
+}
+
+QByteArray GitQlientBench::readFixture(const QString &filePath)
+{
+   QFile file(filePath);
+
+   if (!file.open(QIODevice::ReadOnly))
+      return {};
+
+   return qUncompress(file.readAll());
+}
+
+qint64 GitQlientBench::peakRssInKb()
+{
+#ifdef Q_OS_LINUX
+   QFile status("/proc/self/status");
+
+   if (status.open(QIODevice::ReadOnly))
+   {
+      while (!status.atEnd())
+      {
+         const auto line = status.readLine();
+
+         if (line.startsWith("VmHWM:"))
+            return line.mid(6).trimmed().split(' ').constFirst().toLongLong();
+      }
+   }
+#endif
+
+   return -1;
+}
+
+int main(int argc, char *argv[])
+{
+   QCoreApplication app(argc, argv);
+
+   QCoreApplication::setOrganizationName("CescSoftware");
+   QCoreApplication::setOrganizationDomain("francescmm.com");
+   QCoreApplication::setApplicationName("GitQlientBench");
+
+   const auto arguments = app.arguments();
+
+   if (arguments.count() == 4 && arguments.at(1) == "--record")
+      return GitQlientBench::record(arguments.at(2), arguments.at(3));
+
+   if (arguments.count() == 2)
+      return GitQlientBench::replay(arguments.at(1));
+
+   QTextStream(stdout) << "Usage:" << Qt::endl
+                       << "   gitqlientbench <fixtureDir>                    Replays the recorded fixtures." << Qt::endl
+                       << "   gitqlientbench --record <repoPath> <fixtureDir> Records fixtures from a repository."
+                       << Qt::endl;
+
+   return 1;
+}
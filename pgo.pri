@@ -0,0 +1,30 @@
+#Profile-guided optimization for the release build, gcc/clang only. The build is two-phase and
+#the profiles come from replaying the recorded workloads with the benchmark harness, which drives
+#the hot parse, cache, scroll and diff loops with real corpora:
+#   qmake CONFIG+=pgo-generate && make
+#   qmake bench/GitQlientBench.pro CONFIG+=pgo-generate && make
+#   ./gitqlientbench bench/fixtures
+#   make distclean && qmake CONFIG+=pgo-use && make
+#The counters land in $$PGO_DIR (overridable with qmake PGO_DIR=...), where pgo-use expects
+#them. With clang the raw profiles need an llvm-profdata merge into that directory first. LTO is
+#enabled in both phases so the profile is collected under the same inlining decisions the
+#optimized build makes.
+
+isEmpty(PGO_DIR) {
+   PGO_DIR = $$OUT_PWD/pgo-profiles
+}
+
+pgo-generate:!msvc {
+   QMAKE_CXXFLAGS += -fprofile-generate=$$PGO_DIR -flto
+   QMAKE_LFLAGS += -fprofile-generate=$$PGO_DIR -flto
+}
+
+pgo-use:!msvc {
+   QMAKE_CXXFLAGS += -fprofile-use=$$PGO_DIR -flto
+   QMAKE_LFLAGS += -fprofile-use=$$PGO_DIR -flto
+
+   #-fprofile-correction tolerates the slightly inconsistent counters the multithreaded replay
+   #produces instead of failing the build. The flag is gcc-only, so it stays scoped to the g++
+   #mkspecs; under clang the llvm-profdata merge already reconciles the counters.
+   *-g++*: QMAKE_CXXFLAGS += -fprofile-correction
+}
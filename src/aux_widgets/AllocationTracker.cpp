@@ -0,0 +1,45 @@
+#include "AllocationTracker.h"
+
+#include <algorithm>
+#include <cstring>
+
+AllocationTracker *AllocationTracker::instance()
+{
+   static AllocationTracker tracker;
+
+   return &tracker;
+}
+
+void AllocationTracker::recordAlloc(const char *site, quint64 bytes)
+{
+   QMutexLocker guard(&mMutex);
+
+   auto &entry = mSites[QByteArray::fromRawData(site, static_cast<int>(strlen(site)))];
+   entry.liveBytes += bytes;
+   entry.peakBytes = std::max(entry.peakBytes, entry.liveBytes);
+   ++entry.allocations;
+}
+
+void AllocationTracker::recordFree(const char *site, quint64 bytes)
+{
+   QMutexLocker guard(&mMutex);
+
+   auto &entry = mSites[QByteArray::fromRawData(site, static_cast<int>(strlen(site)))];
+   entry.liveBytes -= std::min(entry.liveBytes, bytes);
+}
+
+QVector<AllocationTracker::SiteReport> AllocationTracker::reports()
+{
+   QMutexLocker guard(&mMutex);
+
+   QVector<SiteReport> result;
+   result.reserve(mSites.count());
+
+   for (auto iter = mSites.cbegin(); iter != mSites.cend(); ++iter)
+      result.append({ QString::fromUtf8(iter.key()), iter->liveBytes, iter->peakBytes, iter->allocations });
+
+   std::sort(result.begin(), result.end(),
+             [](const SiteReport &a, const SiteReport &b) { return a.liveBytes > b.liveBytes; });
+
+   return result;
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+#include <QHash>
+#include <QMutex>
+#include <QString>
+#include <QVector>
+
+/**
+ * @brief The AllocationTracker class records, per allocation site, the live bytes, the peak bytes
+ * and the number of allocations of the long-lived caches. It only receives data when the build is
+ * configured with ALLOC_TRACKING (see AuxiliarWidgets.pri); in regular builds the GQ_TRACK_ALLOC
+ * and GQ_TRACK_FREE macros compile to nothing, so the hot paths pay zero cost. The diagnostics
+ * panel in GeneralConfigDlg lists the sites next to the MemoryTracker reports, which attributes
+ * multi-GB sessions to the load that produced them without an external profiler.
+ */
+class AllocationTracker
+{
+public:
+   /**
+    * @brief The SiteReport struct is the snapshot of one allocation site.
+    */
+   struct SiteReport
+   {
+      QString site;
+      quint64 liveBytes = 0;
+      quint64 peakBytes = 0;
+      quint64 allocations = 0;
+   };
+
+   /**
+    * @brief instance Gets the application wide tracker.
+    * @return The tracker instance.
+    */
+   static AllocationTracker *instance();
+
+   /**
+    * @brief recordAlloc Accounts an allocation to the given site.
+    * @param site The allocation site tag. Expected to be a string literal.
+    * @param bytes The allocated bytes.
+    */
+   void recordAlloc(const char *site, quint64 bytes);
+
+   /**
+    * @brief recordFree Removes freed bytes from the given site.
+    * @param site The allocation site tag. Expected to be a string literal.
+    * @param bytes The freed bytes.
+    */
+   void recordFree(const char *site, quint64 bytes);
+
+   /**
+    * @brief reports Snapshots every site.
+    * @return The list of reports sorted by live bytes.
+    */
+   QVector<SiteReport> reports();
+
+private:
+   struct Site
+   {
+      quint64 liveBytes = 0;
+      quint64 peakBytes = 0;
+      quint64 allocations = 0;
+   };
+
+   QMutex mMutex;
+   QHash<QByteArray, Site> mSites;
+
+   AllocationTracker() = default;
+};
+
+#ifdef ALLOC_TRACKING
+#   define GQ_TRACK_ALLOC(site, bytes) AllocationTracker::instance()->recordAlloc(site, bytes)
+#   define GQ_TRACK_FREE(site, bytes) AllocationTracker::instance()->recordFree(site, bytes)
+#else
+#   define GQ_TRACK_ALLOC(site, bytes) static_cast<void>(0)
+#   define GQ_TRACK_FREE(site, bytes) static_cast<void>(0)
+#endif
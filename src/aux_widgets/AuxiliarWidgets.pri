@@ -1,5 +1,11 @@
 INCLUDEPATH += $$PWD
 
+# Allocation-site tracking for the long-lived caches. Enable it with:
+#   qmake ALLOC_TRACKING=1
+!isEmpty(ALLOC_TRACKING) {
+   DEFINES += ALLOC_TRACKING
+}
+
 FORMS += \
     $$PWD/BranchDlg.ui \
     $$PWD/CreateRepoDlg.ui \
@@ -8,36 +14,58 @@ FORMS += \
     $$PWD/PullDlg.ui
 
 HEADERS += \
+    $$PWD/AllocationTracker.h \
     $$PWD/BranchDlg.h \
     $$PWD/ButtonLink.hpp \
     $$PWD/CheckBox.h \
     $$PWD/ClickableFrame.h \
     $$PWD/Colors.h \
+    $$PWD/CommandPalette.h \
     $$PWD/CommitInfoPanel.h \
+    $$PWD/CommitTreeBrowser.h \
     $$PWD/ConflictButton.h \
+    $$PWD/ConflictMarkerIndex.h \
     $$PWD/CreateRepoDlg.h \
     $$PWD/GitQlientUpdater.h \
     $$PWD/Highlighter.h \
     $$PWD/InitialRepoConfig.h \
+    $$PWD/MemoryTracker.h \
+    $$PWD/OperationProgressPanel.h \
+    $$PWD/PerfHud.h \
+    $$PWD/PerfProfiler.h \
     $$PWD/PomodoroButton.h \
     $$PWD/PomodoroConfigDlg.h \
     $$PWD/ProgressDlg.h \
     $$PWD/PullDlg.h \
+    $$PWD/RepoHealthWidget.h \
+    $$PWD/RepositoryStatsWidget.h \
+    $$PWD/TaskPool.h \
     $$PWD/WaitingDlg.h
 
 SOURCES += \
+    $$PWD/AllocationTracker.cpp \
     $$PWD/BranchDlg.cpp \
     $$PWD/ButtonLink.cpp \
     $$PWD/CheckBox.cpp \
     $$PWD/ClickableFrame.cpp \
+    $$PWD/CommandPalette.cpp \
     $$PWD/CommitInfoPanel.cpp \
+    $$PWD/CommitTreeBrowser.cpp \
     $$PWD/ConflictButton.cpp \
+    $$PWD/ConflictMarkerIndex.cpp \
     $$PWD/CreateRepoDlg.cpp \
     $$PWD/GitQlientUpdater.cpp \
     $$PWD/Highlighter.cpp \
     $$PWD/InitialRepoConfig.cpp \
+    $$PWD/MemoryTracker.cpp \
+    $$PWD/OperationProgressPanel.cpp \
+    $$PWD/PerfHud.cpp \
+    $$PWD/PerfProfiler.cpp \
     $$PWD/PomodoroButton.cpp \
     $$PWD/PomodoroConfigDlg.cpp \
     $$PWD/ProgressDlg.cpp \
     $$PWD/PullDlg.cpp \
+    $$PWD/RepoHealthWidget.cpp \
+    $$PWD/RepositoryStatsWidget.cpp \
+    $$PWD/TaskPool.cpp \
     $$PWD/WaitingDlg.cpp
@@ -2,12 +2,15 @@
 #include "ui_BranchDlg.h"
 
 #include <GitBranches.h>
+#include <GitCache.h>
 #include <GitStashes.h>
 #include <GitQlientStyles.h>
 
+#include <QCompleter>
 #include <QFile>
 #include <QMessageBox>
 
+#include <algorithm>
 #include <utility>
 
 BranchDlg::BranchDlg(BranchDlgConfig config, QWidget *parent)
@@ -56,6 +59,28 @@ BranchDlg::BranchDlg(BranchDlgConfig config, QWidget *parent)
          break;
    }
 
+   if (mConfig.mCache)
+   {
+      const auto appendBranches = [this](References::Type type) {
+         const auto branches = mConfig.mCache->getBranchesSnapshot(type);
+
+         for (const auto &branch : *branches)
+            mExistingRefs.append(branch.second);
+      };
+
+      appendBranches(References::Type::LocalBranch);
+      appendBranches(References::Type::RemoteBranches);
+
+      std::sort(mExistingRefs.begin(), mExistingRefs.end());
+
+      // The completer runs a binary search over the sorted snapshot on every keystroke; no git
+      // process is involved while the user types
+      const auto completer = new QCompleter(mExistingRefs, this);
+      completer->setModelSorting(QCompleter::CaseSensitivelySortedModel);
+      completer->setCaseSensitivity(Qt::CaseSensitive);
+      ui->leNewName->setCompleter(completer);
+   }
+
    connect(ui->leNewName, &QLineEdit::editingFinished, this, &BranchDlg::checkNewBranchName);
    connect(ui->leNewName, &QLineEdit::returnPressed, this, &BranchDlg::accept);
    connect(ui->pbAccept, &QPushButton::clicked, this, &BranchDlg::accept);
@@ -69,13 +94,24 @@ BranchDlg::~BranchDlg()
 
 void BranchDlg::checkNewBranchName()
 {
-   if (ui->leNewName->text() == ui->leOldName->text() && mConfig.mDialogMode != BranchDlgMode::PUSH_UPSTREAM)
+   if (mConfig.mDialogMode == BranchDlgMode::PUSH_UPSTREAM)
+      return;
+
+   if (ui->leNewName->text() == ui->leOldName->text() || nameCollides(ui->leNewName->text()))
       ui->leNewName->setStyleSheet("border: 1px solid red;");
+   else
+      ui->leNewName->setStyleSheet("");
+}
+
+bool BranchDlg::nameCollides(const QString &name) const
+{
+   return std::binary_search(mExistingRefs.cbegin(), mExistingRefs.cend(), name);
 }
 
 void BranchDlg::accept()
 {
-   if (ui->leNewName->text() == ui->leOldName->text() && mConfig.mDialogMode != BranchDlgMode::PUSH_UPSTREAM)
+   if ((ui->leNewName->text() == ui->leOldName->text() || nameCollides(ui->leNewName->text()))
+       && mConfig.mDialogMode != BranchDlgMode::PUSH_UPSTREAM)
       ui->leNewName->setStyleSheet("border: 1px solid red;");
    else
    {
@@ -31,6 +31,7 @@ class BranchDlg;
 }
 
 class GitBase;
+class GitCache;
 
 /**
  * @brief The mode indicates what operation will perform the dialog
@@ -68,6 +69,12 @@ struct BranchDlgConfig
     * @brief mGit The GitBase object to perform the git branch operations.
     */
    QSharedPointer<GitBase> mGit;
+   /**
+    * @brief mCache The internal repository cache, when the caller has one at hand. It backs the
+    * name completion and the collision validation with the in-memory reference snapshot, so
+    * typing never spawns a git process.
+    */
+   QSharedPointer<GitCache> mCache = nullptr;
 };
 
 /**
@@ -106,12 +113,22 @@ public:
 private:
    Ui::BranchDlg *ui = nullptr;
    BranchDlgConfig mConfig;
+   QStringList mExistingRefs;
 
    /**
-    * @brief Validates that the new branch name is not the same for the creation and renaming cases. If the user is
-    * trying to push the branch it won't validate it's name.
+    * @brief Validates that the new branch name is not the same for the creation and renaming cases and that it
+    * doesn't collide with an existing reference. If the user is trying to push the branch it won't validate it's
+    * name.
     */
    void checkNewBranchName();
+
+   /**
+    * @brief nameCollides Checks the new name against the sorted reference names taken from the cache with a binary
+    * search, so the validation is instant and doesn't spawn a process.
+    * @param name The branch name to check.
+    * @return True when a reference with that name already exists.
+    */
+   bool nameCollides(const QString &name) const;
    /**
     * @brief Executes the Git actions based on the configuration once the validation as taken place.
     */
@@ -0,0 +1,212 @@
+#include "CommandPalette.h"
+
+#include <GitCache.h>
+
+#include <QEvent>
+#include <QKeyEvent>
+#include <QLineEdit>
+#include <QListWidget>
+#include <QVBoxLayout>
+
+#include <algorithm>
+
+namespace
+{
+constexpr auto MaxShownResults = 50;
+constexpr auto MaxShaResults = 20;
+constexpr auto MinShaPrefixLength = 4;
+
+bool looksLikeShaPrefix(const QString &text)
+{
+   if (text.count() < MinShaPrefixLength)
+      return false;
+
+   return std::all_of(text.cbegin(), text.cend(), [](QChar c) { return c.isDigit() || (c >= 'a' && c <= 'f'); });
+}
+
+/**
+ * @brief matchScore Ranks @p lowered against the lowered @p query: a prefix match beats a
+ * substring match, which beats a scattered subsequence, and shorter names win inside each tier.
+ * @param lowered The pre-lowered entry name.
+ * @param query The lowered query.
+ * @return The score of the match, lower is better, or -1 when the entry doesn't match.
+ */
+int matchScore(const QString &lowered, const QString &query)
+{
+   if (lowered.startsWith(query))
+      return lowered.count();
+
+   if (const auto pos = lowered.indexOf(query); pos >= 0)
+      return 1000 + pos + lowered.count();
+
+   auto queryPos = 0;
+
+   for (auto i = 0; i < lowered.count() && queryPos < query.count(); ++i)
+   {
+      if (lowered.at(i) == query.at(queryPos))
+         ++queryPos;
+   }
+
+   return queryPos == query.count() ? 2000 + lowered.count() : -1;
+}
+}
+
+CommandPalette::CommandPalette(const QSharedPointer<GitCache> &cache, QWidget *parent)
+   : QFrame(parent)
+   , mCache(cache)
+   , mFilter(new QLineEdit())
+   , mResults(new QListWidget())
+{
+   setWindowFlags(Qt::Popup);
+   setObjectName("CommandPalette");
+
+   mFilter->setPlaceholderText(tr("Go to branch, tag or commit..."));
+   mFilter->installEventFilter(this);
+
+   mResults->setSelectionMode(QAbstractItemView::SingleSelection);
+   mResults->setFocusPolicy(Qt::NoFocus);
+
+   const auto layout = new QVBoxLayout(this);
+   layout->setContentsMargins(5, 5, 5, 5);
+   layout->setSpacing(5);
+   layout->addWidget(mFilter);
+   layout->addWidget(mResults);
+
+   connect(mFilter, &QLineEdit::textChanged, this, &CommandPalette::updateResults);
+   connect(mResults, &QListWidget::itemActivated, this, [this](QListWidgetItem *) { activateCurrent(); });
+
+   resize(450, 300);
+}
+
+void CommandPalette::open()
+{
+   rebuildEntries();
+
+   mFilter->clear();
+   updateResults();
+
+   if (const auto widget = parentWidget())
+      move(widget->mapToGlobal(QPoint((widget->width() - width()) / 2, 100)));
+
+   show();
+   mFilter->setFocus();
+}
+
+bool CommandPalette::eventFilter(QObject *obj, QEvent *event)
+{
+   if (obj == mFilter && event->type() == QEvent::KeyPress)
+   {
+      const auto keyEvent = static_cast<QKeyEvent *>(event);
+      const auto row = mResults->currentRow();
+
+      switch (keyEvent->key())
+      {
+         case Qt::Key_Up:
+            mResults->setCurrentRow(std::max(row - 1, 0));
+            return true;
+         case Qt::Key_Down:
+            mResults->setCurrentRow(std::min(row + 1, mResults->count() - 1));
+            return true;
+         case Qt::Key_Enter:
+         case Qt::Key_Return:
+            activateCurrent();
+            return true;
+         case Qt::Key_Escape:
+            hide();
+            return true;
+         default:
+            break;
+      }
+   }
+
+   return QFrame::eventFilter(obj, event);
+}
+
+void CommandPalette::rebuildEntries()
+{
+   const auto generation = mCache->referenceGeneration();
+
+   if (generation == mEntriesGeneration)
+      return;
+
+   mEntries.clear();
+
+   const auto appendBranches = [this](References::Type type) {
+      const auto branches = mCache->getBranches(type);
+
+      for (const auto &branch : branches)
+      {
+         for (const auto &name : branch.second)
+            mEntries.append({ name, name.toLower(), branch.first });
+      }
+   };
+
+   appendBranches(References::Type::LocalBranch);
+   appendBranches(References::Type::RemoteBranches);
+
+   const auto tags = mCache->getTags(References::Type::LocalTag);
+
+   for (auto iter = tags.cbegin(); iter != tags.cend(); ++iter)
+      mEntries.append({ iter.key(), iter.key().toLower(), iter.value() });
+
+   mEntriesGeneration = generation;
+}
+
+void CommandPalette::updateResults()
+{
+   const auto query = mFilter->text().trimmed().toLower();
+
+   mResults->clear();
+
+   QVector<QPair<int, const Entry *>> matches;
+
+   for (const auto &entry : qAsConst(mEntries))
+   {
+      if (const auto score = query.isEmpty() ? 0 : matchScore(entry.lowered, query); score >= 0)
+         matches.append(qMakePair(score, &entry));
+   }
+
+   std::stable_sort(matches.begin(), matches.end(),
+                    [](const QPair<int, const Entry *> &a, const QPair<int, const Entry *> &b) {
+                       return a.first < b.first;
+                    });
+
+   const auto end = std::min(matches.count(), MaxShownResults);
+
+   for (auto i = 0; i < end; ++i)
+   {
+      const auto item = new QListWidgetItem(matches.at(i).second->name, mResults);
+      item->setData(Qt::UserRole, matches.at(i).second->sha);
+   }
+
+   // A hex-looking query is also resolved against the sorted sha table, so a pasted abbreviated
+   // sha navigates even when no ref matches
+   if (looksLikeShaPrefix(query))
+   {
+      const auto shas = mCache->shasStartingWith(query, MaxShaResults);
+
+      for (const auto &sha : shas)
+      {
+         const auto item = new QListWidgetItem(QString("%1 (commit)").arg(sha.left(12)), mResults);
+         item->setData(Qt::UserRole, sha);
+      }
+   }
+
+   if (mResults->count() > 0)
+      mResults->setCurrentRow(0);
+}
+
+void CommandPalette::activateCurrent()
+{
+   const auto item = mResults->currentItem();
+
+   if (!item)
+      return;
+
+   const auto sha = item->data(Qt::UserRole).toString();
+
+   hide();
+
+   if (!sha.isEmpty())
+      emit shaSelected(sha);
+}
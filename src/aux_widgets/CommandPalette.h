@@ -0,0 +1,110 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+#include <QFrame>
+#include <QSharedPointer>
+#include <QVector>
+
+class GitCache;
+class QLineEdit;
+class QListWidget;
+
+/**
+ * @brief The CommandPalette class is the Ctrl+P popup that jumps to any branch, tag or commit of
+ * the repository by name. The entries are taken from the GitCache indexes when the palette opens,
+ * stamped with the reference generation so reopening it only rebuilds the table when the
+ * references actually changed. Every keystroke ranks the entries with a prefix, substring and
+ * subsequence match over the pre-lowered names, and hex-looking queries are additionally resolved
+ * against the sorted sha table of the cache, so matching stays well below a millisecond even with
+ * hundreds of refs.
+ */
+class CommandPalette : public QFrame
+{
+   Q_OBJECT
+
+signals:
+   /**
+    * @brief shaSelected Emitted when the user activates an entry, with the sha it resolves to.
+    * @param sha The sha to navigate to.
+    */
+   void shaSelected(const QString &sha);
+
+public:
+   /**
+    * @brief Default constructor.
+    * @param cache The internal repository cache the entries are taken from.
+    * @param parent The parent widget.
+    */
+   explicit CommandPalette(const QSharedPointer<GitCache> &cache, QWidget *parent = nullptr);
+
+   /**
+    * @brief open Refreshes the entries if the references changed, positions the palette over the
+    * parent widget and shows it with the filter focused.
+    */
+   void open();
+
+protected:
+   /**
+    * @brief eventFilter Routes Up, Down, Enter and Escape from the filter field to the results
+    * list so the palette is fully keyboard driven.
+    * @param obj The watched object.
+    * @param event The event.
+    * @return True when the event was handled.
+    */
+   bool eventFilter(QObject *obj, QEvent *event) override;
+
+private:
+   /**
+    * @brief The Entry struct is one navigable item: its display name, the pre-lowered name the
+    * matcher runs over and the sha the entry resolves to.
+    */
+   struct Entry
+   {
+      QString name;
+      QString lowered;
+      QString sha;
+   };
+
+   QSharedPointer<GitCache> mCache;
+   QLineEdit *mFilter = nullptr;
+   QListWidget *mResults = nullptr;
+   QVector<Entry> mEntries;
+   int mEntriesGeneration = -1;
+
+   /**
+    * @brief rebuildEntries Refills the entry table from the branches and tags of the cache when
+    * the reference generation moved since the last build.
+    */
+   void rebuildEntries();
+   /**
+    * @brief updateResults Ranks the entries against the current filter text and shows the best
+    * matches.
+    */
+   void updateResults();
+   /**
+    * @brief activateCurrent Emits @ref shaSelected for the selected result and closes the palette.
+    */
+   void activateCurrent();
+};
@@ -1,6 +1,7 @@
 #include <CommitInfoPanel.h>
 #include <CommitInfo.h>
 
+#include <QDateTime>
 #include <QVBoxLayout>
 #include <QLabel>
 #include <QScrollArea>
@@ -59,7 +60,7 @@ void CommitInfoPanel::configure(const CommitInfo &commit)
    mLabelTitle->setText(commit.shortLog());
    mLabelAuthor->setText(authorName);
 
-   QDateTime commitDate = QDateTime::fromSecsSinceEpoch(commit.authorDate().toInt());
+   QDateTime commitDate = QDateTime::fromSecsSinceEpoch(commit.authorDateSecs());
    mLabelDateTime->setText(commitDate.toString("dd/MM/yyyy hh:mm"));
 
    const auto description = commit.longLog();
@@ -0,0 +1,110 @@
+#include "CommitTreeBrowser.h"
+
+#include <GitBase.h>
+
+#include <QStyle>
+
+namespace
+{
+enum Role
+{
+   TreeOid = Qt::UserRole,
+   Listed
+};
+}
+
+CommitTreeBrowser::CommitTreeBrowser(const QSharedPointer<GitBase> &git, QWidget *parent)
+   : QTreeWidget(parent)
+   , mGit(git)
+{
+   setColumnCount(1);
+   setHeaderHidden(true);
+   setContextMenuPolicy(Qt::NoContextMenu);
+
+   connect(this, &QTreeWidget::itemExpanded, this, &CommitTreeBrowser::onItemExpanded);
+   connect(this, &QTreeWidget::itemDoubleClicked, this, &CommitTreeBrowser::onItemDoubleClicked);
+}
+
+void CommitTreeBrowser::showCommitTree(const QString &sha)
+{
+   if (sha.isEmpty() || sha == mCurrentSha)
+      return;
+
+   mCurrentSha = sha;
+
+   clear();
+
+   QScopedPointer<GitTree> git(new GitTree(mGit));
+   const auto rootOid = git->getCommitTreeOid(sha);
+
+   if (!rootOid.isEmpty())
+      addEntries(nullptr, rootOid);
+}
+
+void CommitTreeBrowser::onItemExpanded(QTreeWidgetItem *item)
+{
+   const auto treeOid = item->data(0, TreeOid).toString();
+
+   if (treeOid.isEmpty() || item->data(0, Listed).toBool())
+      return;
+
+   item->setData(0, Listed, true);
+
+   qDeleteAll(item->takeChildren());
+
+   addEntries(item, treeOid);
+}
+
+void CommitTreeBrowser::onItemDoubleClicked(QTreeWidgetItem *item, int)
+{
+   if (item->data(0, TreeOid).toString().isEmpty())
+      emit fileSelected(relativePath(item));
+}
+
+void CommitTreeBrowser::addEntries(QTreeWidgetItem *parent, const QString &treeOid)
+{
+   const auto entries = entriesForTree(treeOid);
+
+   for (const auto &entry : entries)
+   {
+      const auto item = parent ? new QTreeWidgetItem(parent) : new QTreeWidgetItem(this);
+      item->setText(0, entry.name);
+
+      if (entry.isDir)
+      {
+         item->setIcon(0, style()->standardIcon(QStyle::SP_DirIcon));
+         item->setData(0, TreeOid, entry.oid);
+
+         // The placeholder makes the expander visible; it is replaced by the real listing the
+         // first time the directory is expanded
+         new QTreeWidgetItem(item);
+      }
+      else
+         item->setIcon(0, style()->standardIcon(QStyle::SP_FileIcon));
+   }
+}
+
+QVector<GitTree::TreeEntry> CommitTreeBrowser::entriesForTree(const QString &treeOid)
+{
+   const auto iter = mSubtreeCache.constFind(treeOid);
+
+   if (iter != mSubtreeCache.cend())
+      return iter.value();
+
+   QScopedPointer<GitTree> git(new GitTree(mGit));
+   const auto entries = git->getTreeEntries(treeOid);
+
+   mSubtreeCache.insert(treeOid, entries);
+
+   return entries;
+}
+
+QString CommitTreeBrowser::relativePath(QTreeWidgetItem *item) const
+{
+   auto path = item->text(0);
+
+   for (auto parent = item->parent(); parent; parent = parent->parent())
+      path.prepend(parent->text(0) + "/");
+
+   return path;
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+#include <GitTree.h>
+
+#include <QHash>
+#include <QSharedPointer>
+#include <QTreeWidget>
+
+class GitBase;
+
+/**
+ * @brief The CommitTreeBrowser class shows the file tree of a commit snapshot without checking it
+ * out. The tree is paged: only the root is listed when a commit is shown and every directory is
+ * listed with a single git ls-tree call the first time it is expanded. The listings are cached by
+ * tree oid, so directories that did not change between commits are served from memory when
+ * browsing another snapshot.
+ */
+class CommitTreeBrowser : public QTreeWidget
+{
+   Q_OBJECT
+
+signals:
+   /**
+    * @brief fileSelected Signal triggered when the user selects a file of the snapshot.
+    * @param filePath The path of the file relative to the repository root.
+    */
+   void fileSelected(const QString &filePath);
+
+public:
+   /**
+    * @brief Default constructor.
+    *
+    * @param git The git object to perform Git commands.
+    * @param parent The parent widget if needed.
+    */
+   explicit CommitTreeBrowser(const QSharedPointer<GitBase> &git, QWidget *parent = nullptr);
+
+   /**
+    * @brief showCommitTree Shows the root of the tree of the given commit. Nothing is reloaded
+    * when the commit is the one already shown.
+    * @param sha The sha of the commit to browse.
+    */
+   void showCommitTree(const QString &sha);
+
+private:
+   QSharedPointer<GitBase> mGit;
+   QString mCurrentSha;
+   QHash<QString, QVector<GitTree::TreeEntry>> mSubtreeCache;
+
+   /**
+    * @brief onItemExpanded Replaces the placeholder child of the expanded directory with its real
+    * listing, fetched through the subtree cache.
+    * @param item The expanded directory item.
+    */
+   void onItemExpanded(QTreeWidgetItem *item);
+   /**
+    * @brief onItemDoubleClicked Emits @ref fileSelected for file items.
+    * @param item The activated item.
+    * @param column The activated column. Not used.
+    */
+   void onItemDoubleClicked(QTreeWidgetItem *item, int column);
+   /**
+    * @brief addEntries Adds the entries of the given tree as children of the parent item, where
+    * directories get a placeholder child so they show an expander before being listed.
+    * @param parent The item to fill, or nullptr for the invisible root.
+    * @param treeOid The oid of the tree to list.
+    */
+   void addEntries(QTreeWidgetItem *parent, const QString &treeOid);
+   /**
+    * @brief entriesForTree Returns the listing of the given tree, from the cache when present.
+    * @param treeOid The oid of the tree to list.
+    * @return The entries of the tree.
+    */
+   QVector<GitTree::TreeEntry> entriesForTree(const QString &treeOid);
+   /**
+    * @brief relativePath Builds the repository-relative path of the given item.
+    * @param item The item to resolve.
+    * @return The path relative to the repository root.
+    */
+   QString relativePath(QTreeWidgetItem *item) const;
+};
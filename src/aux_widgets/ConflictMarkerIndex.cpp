@@ -0,0 +1,121 @@
+#include "ConflictMarkerIndex.h"
+
+#include <TaskPool.h>
+
+#include <QFile>
+#include <QFileInfo>
+#include <QMutexLocker>
+#include <QtConcurrent>
+
+ConflictMarkerIndex::ConflictMarkerIndex(QObject *parent)
+   : QObject(parent)
+{
+}
+
+ConflictMarkerIndex::~ConflictMarkerIndex()
+{
+   mGeneration.ref();
+   mFuture.waitForFinished();
+}
+
+void ConflictMarkerIndex::scan(const QString &workingDir, const QStringList &files)
+{
+   QHash<QString, FileEntry> cached;
+
+   {
+      QMutexLocker lock(&mMutex);
+      cached = mEntries;
+   }
+
+   mGeneration.ref();
+
+   const auto generation = mGeneration.loadAcquire();
+
+   // A scan still in flight is superseded by the generation bump and drained before the future is
+   // reassigned, so the destructor never misses a running task that captured this
+   mFuture.waitForFinished();
+
+   mFuture = QtConcurrent::run(TaskPool::instance()->pool(), [this, workingDir, files, cached, generation]() {
+      // The per-file work is mapped over the pool so a merge with many conflicts uses every core;
+      // files whose modification time matches the cached entry are not re-read.
+      const auto entries = QtConcurrent::blockingMapped(
+          files, std::function<QPair<QString, FileEntry>(const QString &)>([workingDir, &cached](const QString &file) {
+             const QFileInfo info(QString("%1/%2").arg(workingDir, file));
+
+             if (const auto entry = cached.constFind(file);
+                 entry != cached.cend() && entry->modified == info.lastModified())
+             {
+                return qMakePair(file, *entry);
+             }
+
+             FileEntry entry;
+             entry.modified = info.lastModified();
+             entry.ranges = scanFile(info.absoluteFilePath());
+
+             return qMakePair(file, entry);
+          }));
+
+      // A superseded generation means the index is being destroyed or a newer scan replaced this
+      // one; the stale results are dropped without touching the members
+      if (generation != mGeneration.loadAcquire())
+         return;
+
+      {
+         QMutexLocker lock(&mMutex);
+
+         for (const auto &entry : entries)
+            mEntries.insert(entry.first, entry.second);
+      }
+
+      emit indexUpdated();
+   });
+}
+
+QVector<QPair<int, int>> ConflictMarkerIndex::markerRanges(const QString &file) const
+{
+   QMutexLocker lock(&mMutex);
+
+   return mEntries.value(file).ranges;
+}
+
+bool ConflictMarkerIndex::hasMarkers(const QString &file) const
+{
+   QMutexLocker lock(&mMutex);
+
+   return !mEntries.value(file).ranges.isEmpty();
+}
+
+void ConflictMarkerIndex::clear()
+{
+   QMutexLocker lock(&mMutex);
+
+   mEntries.clear();
+}
+
+QVector<QPair<int, int>> ConflictMarkerIndex::scanFile(const QString &fullPath)
+{
+   QVector<QPair<int, int>> ranges;
+   QFile file(fullPath);
+
+   if (!file.open(QIODevice::ReadOnly))
+      return ranges;
+
+   auto line = 0;
+   auto sectionStart = -1;
+
+   while (!file.atEnd())
+   {
+      const auto content = file.readLine();
+      ++line;
+
+      if (content.startsWith("<<<<<<<"))
+         sectionStart = line;
+      else if (content.startsWith(">>>>>>>") && sectionStart != -1)
+      {
+         ranges.append(qMakePair(sectionStart, line));
+         sectionStart = -1;
+      }
+   }
+
+   return ranges;
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+#include <QAtomicInt>
+#include <QDateTime>
+#include <QFuture>
+#include <QHash>
+#include <QMutex>
+#include <QObject>
+#include <QPair>
+#include <QVector>
+
+/**
+ * @brief The ConflictMarkerIndex class locates the conflict marker sections of the files of a
+ * merge. The files are scanned in parallel on the shared worker pool and the resulting line
+ * ranges are cached per file, invalidated by modification time, so re-entering the merge view or
+ * refreshing it after saving one file only re-reads what actually changed.
+ */
+class ConflictMarkerIndex : public QObject
+{
+   Q_OBJECT
+
+signals:
+   /**
+    * @brief indexUpdated Signal triggered when a scan finishes and the ranges are current.
+    */
+   void indexUpdated();
+
+public:
+   explicit ConflictMarkerIndex(QObject *parent = nullptr);
+   /**
+    * @brief Destructor. Cancels a scan still in flight and waits for it, so the owning view can
+    * be destroyed while files are being read.
+    */
+   ~ConflictMarkerIndex();
+
+   /**
+    * @brief scan Scans the given files for conflict markers in the background. Files whose
+    * modification time matches the cached entry are served from the cache.
+    * @param workingDir The working directory the file names are relative to.
+    * @param files The files to scan.
+    */
+   void scan(const QString &workingDir, const QStringList &files);
+   /**
+    * @brief markerRanges Gets the conflict sections of a file as 1-based line ranges.
+    * @param file The file name relative to the working directory.
+    * @return The (first line, last line) pair of every conflict section.
+    */
+   QVector<QPair<int, int>> markerRanges(const QString &file) const;
+   /**
+    * @brief hasMarkers Whether the last scan found conflict markers in the file.
+    * @param file The file name relative to the working directory.
+    * @return True when the file still contains conflict sections.
+    */
+   bool hasMarkers(const QString &file) const;
+   /**
+    * @brief clear Drops all the cached ranges.
+    */
+   void clear();
+
+private:
+   struct FileEntry
+   {
+      QDateTime modified;
+      QVector<QPair<int, int>> ranges;
+   };
+
+   mutable QMutex mMutex;
+   QHash<QString, FileEntry> mEntries;
+   QAtomicInt mGeneration;
+   QFuture<void> mFuture;
+
+   static QVector<QPair<int, int>> scanFile(const QString &fullPath);
+};
@@ -22,7 +22,13 @@ CreateRepoDlg::CreateRepoDlg(CreateRepoDlgType type, QSharedPointer<GitConfig> g
    ui->setupUi(this);
 
    if (mType == CreateRepoDlgType::INIT)
+   {
       ui->leURL->setHidden(true);
+      ui->cbPartial->setHidden(true);
+      ui->cbShallow->setHidden(true);
+      ui->sbDepth->setHidden(true);
+      ui->cbSingleBranch->setHidden(true);
+   }
 
    const auto operation = mType == CreateRepoDlgType::INIT ? QString("init") : QString("clone");
    const auto checkText = ui->chbOpen->text().arg(operation);
@@ -39,6 +45,7 @@ CreateRepoDlg::CreateRepoDlg(CreateRepoDlgType type, QSharedPointer<GitConfig> g
    connect(ui->pbAccept, &QPushButton::clicked, this, &CreateRepoDlg::accept);
    connect(ui->pbCancel, &QPushButton::clicked, this, &QDialog::reject);
    connect(ui->cbGitUser, &CheckBox::clicked, this, &CreateRepoDlg::showGitControls);
+   connect(ui->cbShallow, &CheckBox::toggled, ui->sbDepth, &QSpinBox::setEnabled);
 
    showGitControls();
 }
@@ -108,7 +115,9 @@ void CreateRepoDlg::accept()
             if (!dir.exists())
                dir.mkpath(fullPath);
 
-            ret = mGit->clone(url, fullPath);
+            const auto depth = ui->cbShallow->isChecked() ? ui->sbDepth->value() : 0;
+
+            ret = mGit->clone(url, fullPath, ui->cbPartial->isChecked(), depth, ui->cbSingleBranch->isChecked());
          }
          else
          {
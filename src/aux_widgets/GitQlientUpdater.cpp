@@ -139,44 +139,78 @@ void GitQlientUpdater::downloadFile()
    request.setUrl(QUrl(mGitQlientDownloadUrl));
 
    const auto fileName = mGitQlientDownloadUrl.split("/").last();
+   const auto destination = QString("%1/%2").arg(
+       QStandardPaths::standardLocations(QStandardPaths::DownloadLocation).constFirst(), fileName);
+
+   /* The download streams into a .part file so a broken connection resumes from the last byte
+      written instead of starting over. */
+   const auto partialFile = new QFile(destination + ".part", this);
+   const auto resumeOffset = partialFile->size();
+
+   if (resumeOffset > 0)
+      request.setRawHeader("Range", QString("bytes=%1-").arg(resumeOffset).toUtf8());
+
+   if (!partialFile->open(QIODevice::WriteOnly | QIODevice::Append))
+   {
+      QLog_Error("Ui", QString("Unable to open {%1} to download the update.").arg(partialFile->fileName()));
+      partialFile->deleteLater();
+      return;
+   }
 
    const auto reply = mManager->get(request);
+   const auto rangeChecked = QSharedPointer<bool>::create(false);
+
+   connect(reply, &QNetworkReply::readyRead, this, [reply, partialFile, rangeChecked]() {
+      if (!*rangeChecked)
+      {
+         /* A server that ignores the Range header answers 200 with the full content, so the
+            partial data written so far must be dropped. */
+         if (reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() != 206)
+            partialFile->resize(0);
 
-   connect(reply, &QNetworkReply::downloadProgress, this, [this](qint64 read, qint64 total) {
+         *rangeChecked = true;
+      }
+
+      partialFile->write(reply->readAll());
+   });
+
+   connect(reply, &QNetworkReply::downloadProgress, this, [this, resumeOffset](qint64 read, qint64 total) {
       if (mDownloadLog == nullptr)
       {
-         mDownloadLog
-             = new QProgressDialog(tr("Downloading..."), tr("Close"), 0, total, qobject_cast<QWidget *>(parent()));
+         mDownloadLog = new QProgressDialog(tr("Downloading..."), tr("Close"), 0, total + resumeOffset,
+                                            qobject_cast<QWidget *>(parent()));
          mDownloadLog->setAttribute(Qt::WA_DeleteOnClose);
          mDownloadLog->setAutoClose(false);
          mDownloadLog->setAutoReset(false);
-         mDownloadLog->setMaximum(total);
+         mDownloadLog->setMaximum(total + resumeOffset);
          mDownloadLog->setCancelButton(nullptr);
          mDownloadLog->setWindowFlag(Qt::FramelessWindowHint);
 
          connect(mDownloadLog, &QProgressDialog::destroyed, this, [this]() { mDownloadLog = nullptr; });
       }
 
-      mDownloadLog->setValue(read);
+      mDownloadLog->setValue(read + resumeOffset);
       mDownloadLog->show();
    });
 
-   connect(reply, &QNetworkReply::finished, this, [this, reply, fileName]() {
-      mDownloadLog->close();
-      mDownloadLog = nullptr;
-
-      const auto b = reply->readAll();
-      const auto destination = QString("%1/%2").arg(
-          QStandardPaths::standardLocations(QStandardPaths::DownloadLocation).constFirst(), fileName);
-      QFile file(destination);
-      if (file.open(QIODevice::WriteOnly))
+   connect(reply, &QNetworkReply::finished, this, [this, reply, partialFile, destination]() {
+      if (mDownloadLog)
       {
-         QDataStream out(&file);
-         out << b;
+         mDownloadLog->close();
+         mDownloadLog = nullptr;
+      }
 
-         file.close();
+      partialFile->write(reply->readAll());
+      partialFile->close();
+
+      /* On failure the partial file stays on disk so the next attempt resumes it. */
+      if (reply->error() == QNetworkReply::NoError)
+      {
+         QFile::remove(destination);
+         partialFile->rename(destination);
       }
 
+      partialFile->deleteLater();
       reply->deleteLater();
    });
 }
@@ -55,6 +55,7 @@
 #ifndef HIGHLIGHTER_H
 #define HIGHLIGHTER_H
 
+#include <QHash>
 #include <QSyntaxHighlighter>
 #include <QTextCharFormat>
 #include <QRegularExpression>
@@ -75,12 +76,13 @@ protected:
    void highlightBlock(const QString &text) override;
 
 private:
-   struct HighlightingRule
+   struct FormatSpan
    {
-      QRegularExpression pattern;
-      QTextCharFormat format;
+      int start;
+      int length;
+      int rule;
    };
-   QVector<HighlightingRule> highlightingRules;
+   QHash<QString, QVector<FormatSpan>> mFormatCache;
 
    QRegularExpression commentStartExpression;
    QRegularExpression commentEndExpression;
@@ -17,6 +17,8 @@ InitialRepoConfig::InitialRepoConfig(const QSharedPointer<GitQlientSettings> &se
 
    ui->autoFetch->setValue(mSettings->localValue("AutoFetch", 5).toInt());
    ui->pruneOnFetch->setChecked(settings->localValue("PruneOnFetch", true).toBool());
+   ui->fetchTags->setChecked(settings->localValue("FetchTags", true).toBool());
+   ui->fetchRefPrefixes->setText(settings->localValue("FetchRefPrefixes", QString()).toString());
    ui->updateOnPull->setChecked(settings->localValue("UpdateOnPull", false).toBool());
    ui->sbMaxCommits->setValue(settings->localValue("MaxCommits", 0).toInt());
 }
@@ -25,6 +27,8 @@ InitialRepoConfig::~InitialRepoConfig()
 {
    mSettings->setLocalValue("AutoFetch", ui->autoFetch->value());
    mSettings->setLocalValue("PruneOnFetch", ui->pruneOnFetch->isChecked());
+   mSettings->setLocalValue("FetchTags", ui->fetchTags->isChecked());
+   mSettings->setLocalValue("FetchRefPrefixes", ui->fetchRefPrefixes->text().trimmed());
    mSettings->setLocalValue("UpdateOnPull", ui->updateOnPull->isChecked());
    mSettings->setLocalValue("MaxCommits", ui->sbMaxCommits->value());
 
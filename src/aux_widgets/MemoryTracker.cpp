@@ -0,0 +1,68 @@
+#include "MemoryTracker.h"
+
+#include <algorithm>
+
+MemoryTracker *MemoryTracker::instance()
+{
+   static MemoryTracker tracker;
+
+   return &tracker;
+}
+
+int MemoryTracker::add(const QString &name, std::function<quint64()> bytes, std::function<void()> purge)
+{
+   QMutexLocker lock(&mMutex);
+
+   const auto id = mNextId++;
+   mEntries.insert(id, { name, std::move(bytes), std::move(purge) });
+
+   return id;
+}
+
+void MemoryTracker::remove(int id)
+{
+   QMutexLocker lock(&mMutex);
+
+   mEntries.remove(id);
+}
+
+QVector<MemoryTracker::Report> MemoryTracker::reports()
+{
+   // The callbacks are evaluated outside the tracker lock: they take the locks of their own
+   // caches and must not be serialized against register/deregister calls from other threads.
+   QVector<QPair<int, Entry>> entries;
+
+   {
+      QMutexLocker lock(&mMutex);
+
+      entries.reserve(mEntries.count());
+
+      for (auto iter = mEntries.cbegin(); iter != mEntries.cend(); ++iter)
+         entries.append(qMakePair(iter.key(), iter.value()));
+   }
+
+   QVector<Report> reports;
+   reports.reserve(entries.count());
+
+   for (const auto &entry : entries)
+      reports.append({ entry.first, entry.second.name, entry.second.bytes(), entry.second.purge != nullptr });
+
+   std::sort(reports.begin(), reports.end(), [](const Report &a, const Report &b) { return a.bytes > b.bytes; });
+
+   return reports;
+}
+
+void MemoryTracker::purge(int id)
+{
+   std::function<void()> purge;
+
+   {
+      QMutexLocker lock(&mMutex);
+
+      if (const auto iter = mEntries.constFind(id); iter != mEntries.cend())
+         purge = iter->purge;
+   }
+
+   if (purge)
+      purge();
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+#include <QMap>
+#include <QMutex>
+#include <QString>
+#include <QVector>
+
+#include <functional>
+
+/**
+ * @brief The MemoryTracker class is the registry where the long-lived caches account their resident
+ * sizes. Every cache registers a callback that estimates its heap bytes and, when it makes sense, a
+ * second one that purges it. The diagnostics panel in GeneralConfigDlg enumerates the registry, and
+ * the same callbacks are the hooks a future global memory budget can drive.
+ */
+class MemoryTracker
+{
+public:
+   /**
+    * @brief The Report struct is the snapshot of one registered cache.
+    */
+   struct Report
+   {
+      int id = -1;
+      QString name;
+      quint64 bytes = 0;
+      bool purgeable = false;
+   };
+
+   /**
+    * @brief instance Gets the application wide tracker.
+    * @return The tracker instance.
+    */
+   static MemoryTracker *instance();
+
+   /**
+    * @brief add Registers a cache. The callbacks are invoked from the thread that asks for the
+    * reports, so they must do their own locking.
+    * @param name The name shown in the diagnostics panel.
+    * @param bytes Callback that estimates the cache's current heap bytes.
+    * @param purge Optional callback that drops the cached data.
+    * @return The id to deregister the cache with.
+    */
+   int add(const QString &name, std::function<quint64()> bytes, std::function<void()> purge = nullptr);
+
+   /**
+    * @brief remove Deregisters a cache. Must be called before the cache is destroyed.
+    * @param id The id returned by @ref add.
+    */
+   void remove(int id);
+
+   /**
+    * @brief reports Evaluates every registered cache.
+    * @return The list of reports sorted by size.
+    */
+   QVector<Report> reports();
+
+   /**
+    * @brief purge Purges the given cache if it registered a purge callback.
+    * @param id The id of the cache.
+    */
+   void purge(int id);
+
+private:
+   struct Entry
+   {
+      QString name;
+      std::function<quint64()> bytes;
+      std::function<void()> purge;
+   };
+
+   MemoryTracker() = default;
+
+   QMutex mMutex;
+   QMap<int, Entry> mEntries;
+   int mNextId = 0;
+};
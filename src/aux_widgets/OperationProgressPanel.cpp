@@ -0,0 +1,82 @@
+#include "OperationProgressPanel.h"
+
+#include <QEvent>
+#include <QLabel>
+#include <QVBoxLayout>
+
+OperationProgressPanel::OperationProgressPanel(QWidget *parent)
+   : QFrame(parent)
+   , mLayout(new QVBoxLayout(this))
+{
+   setObjectName("sectionFrame");
+
+   mLayout->setContentsMargins(10, 5, 10, 5);
+   mLayout->setSpacing(5);
+
+   parent->installEventFilter(this);
+
+   hide();
+}
+
+void OperationProgressPanel::startOperation(const QString &id, const QString &description)
+{
+   auto row = mRows.value(id, nullptr);
+
+   if (!row)
+   {
+      row = new QLabel();
+      mRows.insert(id, row);
+      mLayout->addWidget(row);
+   }
+
+   mDescriptions.insert(id, description);
+   row->setText(description);
+
+   show();
+   raise();
+   adjustSize();
+   relocate();
+}
+
+void OperationProgressPanel::updateOperation(const QString &id, int percentage)
+{
+   if (const auto row = mRows.value(id, nullptr))
+   {
+      row->setText(QString("%1 (%2%)").arg(mDescriptions.value(id)).arg(percentage));
+      adjustSize();
+      relocate();
+   }
+}
+
+void OperationProgressPanel::finishOperation(const QString &id)
+{
+   if (const auto row = mRows.take(id))
+   {
+      mDescriptions.remove(id);
+      mLayout->removeWidget(row);
+      delete row;
+
+      if (mRows.isEmpty())
+         hide();
+      else
+      {
+         adjustSize();
+         relocate();
+      }
+   }
+}
+
+bool OperationProgressPanel::eventFilter(QObject *obj, QEvent *event)
+{
+   if (obj == parentWidget() && event->type() == QEvent::Resize)
+      relocate();
+
+   return QFrame::eventFilter(obj, event);
+}
+
+void OperationProgressPanel::relocate()
+{
+   static const auto margin = 10;
+
+   move(parentWidget()->width() - width() - margin, parentWidget()->height() - height() - margin);
+}
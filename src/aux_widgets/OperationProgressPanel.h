@@ -0,0 +1,88 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+#include <QFrame>
+#include <QHash>
+
+class QLabel;
+class QVBoxLayout;
+
+/**
+ * @brief The OperationProgressPanel class is a non-modal surface showing one row per background
+ * git operation (repository load, fetch, pull). It floats over the bottom-right corner of its
+ * parent, so long operations stay visible without blocking any interaction the way a modal
+ * waiting dialog would.
+ */
+class OperationProgressPanel : public QFrame
+{
+   Q_OBJECT
+
+public:
+   /**
+    * @brief Default constructor.
+    * @param parent The widget the panel floats over.
+    */
+   explicit OperationProgressPanel(QWidget *parent);
+
+   /**
+    * @brief startOperation Adds a row for the given operation. Starting an already shown
+    * operation updates its description.
+    * @param id The identifier of the operation.
+    * @param description The text shown in the row.
+    */
+   void startOperation(const QString &id, const QString &description);
+   /**
+    * @brief updateOperation Appends the progress percentage to the row of the given operation.
+    * @param id The identifier of the operation.
+    * @param percentage The progress in the range 0 to 100.
+    */
+   void updateOperation(const QString &id, int percentage);
+   /**
+    * @brief finishOperation Removes the row of the given operation, hiding the panel when it was
+    * the last one.
+    * @param id The identifier of the operation.
+    */
+   void finishOperation(const QString &id);
+
+protected:
+   /**
+    * @brief eventFilter Keeps the panel anchored to the bottom-right corner when the parent is
+    * resized.
+    * @param obj The watched object.
+    * @param event The event to filter.
+    * @return bool Returns false so the event continues its propagation.
+    */
+   bool eventFilter(QObject *obj, QEvent *event) override;
+
+private:
+   QVBoxLayout *mLayout = nullptr;
+   QHash<QString, QLabel *> mRows;
+   QHash<QString, QString> mDescriptions;
+
+   /**
+    * @brief relocate Moves the panel to the bottom-right corner of the parent.
+    */
+   void relocate();
+};
@@ -0,0 +1,93 @@
+#include "PerfHud.h"
+
+#include <PerfProfiler.h>
+
+#include <QFileDialog>
+#include <QHBoxLayout>
+#include <QPushButton>
+#include <QTimer>
+#include <QTreeWidget>
+#include <QVBoxLayout>
+
+PerfHud::PerfHud(QWidget *parent)
+   : QFrame(parent)
+   , mStats(new QTreeWidget())
+   , mRefreshTimer(new QTimer(this))
+{
+   setWindowFlags(Qt::Tool | Qt::WindowStaysOnTopHint);
+   setWindowTitle(tr("Performance HUD"));
+   setAttribute(Qt::WA_DeleteOnClose, false);
+
+   mStats->setColumnCount(6);
+   mStats->setHeaderLabels(
+       { tr("Scope"), tr("Category"), tr("Calls"), tr("Total (ms)"), tr("Avg (ms)"), tr("Max (ms)") });
+   mStats->setRootIsDecorated(false);
+   mStats->setSortingEnabled(false);
+
+   const auto exportBtn = new QPushButton(tr("Export trace..."));
+   connect(exportBtn, &QPushButton::clicked, this, &PerfHud::exportTrace);
+
+   const auto resetBtn = new QPushButton(tr("Reset"));
+   connect(resetBtn, &QPushButton::clicked, this, [this]() {
+      PerfProfiler::instance()->clear();
+      refresh();
+   });
+
+   const auto buttonsLayout = new QHBoxLayout();
+   buttonsLayout->setContentsMargins(QMargins());
+   buttonsLayout->addWidget(exportBtn);
+   buttonsLayout->addWidget(resetBtn);
+   buttonsLayout->addStretch();
+
+   const auto layout = new QVBoxLayout(this);
+   layout->setContentsMargins(10, 10, 10, 10);
+   layout->addWidget(mStats);
+   layout->addLayout(buttonsLayout);
+
+   mRefreshTimer->setInterval(1000);
+   connect(mRefreshTimer, &QTimer::timeout, this, &PerfHud::refresh);
+
+   resize(600, 300);
+}
+
+void PerfHud::showEvent(QShowEvent *event)
+{
+   PerfProfiler::instance()->setEnabled(true);
+   mRefreshTimer->start();
+   refresh();
+
+   QFrame::showEvent(event);
+}
+
+void PerfHud::closeEvent(QCloseEvent *event)
+{
+   PerfProfiler::instance()->setEnabled(false);
+   mRefreshTimer->stop();
+
+   QFrame::closeEvent(event);
+}
+
+void PerfHud::refresh()
+{
+   mStats->clear();
+
+   const auto stats = PerfProfiler::instance()->stats();
+
+   for (const auto &stat : stats)
+   {
+      const auto item = new QTreeWidgetItem({ stat.name, stat.category, QString::number(stat.count),
+                                              QString::number(stat.totalUs / 1000.0, 'f', 1),
+                                              QString::number(stat.totalUs / 1000.0 / stat.count, 'f', 3),
+                                              QString::number(stat.maxUs / 1000.0, 'f', 1) });
+      mStats->addTopLevelItem(item);
+   }
+}
+
+void PerfHud::exportTrace()
+{
+   const auto fileName
+       = QFileDialog::getSaveFileName(this, tr("Export trace"), "gitqlient-trace.json", tr("Trace files (*.json)"));
+
+   if (!fileName.isEmpty())
+      PerfProfiler::instance()->exportTrace(fileName);
+}
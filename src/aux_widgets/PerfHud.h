@@ -0,0 +1,73 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+#include <QFrame>
+
+class QTreeWidget;
+class QTimer;
+
+/**
+ * @brief The PerfHud class shows the numbers collected by the PerfProfiler in a small always on
+ * top window: per scope call counts, total, average and maximum times, refreshed once per second.
+ * Recording starts when the HUD is shown and stops when it is closed, and the captured events can
+ * be exported in the chrome://tracing JSON format for offline analysis.
+ */
+class PerfHud : public QFrame
+{
+   Q_OBJECT
+
+public:
+   /**
+    * @brief Default constructor.
+    * @param parent The parent widget.
+    */
+   explicit PerfHud(QWidget *parent = nullptr);
+
+protected:
+   /**
+    * @brief showEvent Starts the recording when the HUD becomes visible.
+    * @param event The show event.
+    */
+   void showEvent(QShowEvent *event) override;
+   /**
+    * @brief closeEvent Stops the recording. The collected data is kept so it can be exported the
+    * next time the HUD is opened.
+    * @param event The close event.
+    */
+   void closeEvent(QCloseEvent *event) override;
+
+private:
+   QTreeWidget *mStats = nullptr;
+   QTimer *mRefreshTimer = nullptr;
+
+   /**
+    * @brief refresh Rebuilds the stats tree from the profiler aggregates.
+    */
+   void refresh();
+   /**
+    * @brief exportTrace Asks for a destination file and writes the recorded trace.
+    */
+   void exportTrace();
+};
@@ -0,0 +1,118 @@
+#include "PerfProfiler.h"
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QThread>
+
+#include <algorithm>
+
+namespace
+{
+// The event buffer is bounded so a profiling session left on for hours cannot grow without
+// limit: once full, the older half is dropped and the aggregated stats keep the totals.
+constexpr auto MaxRecordedEvents = 200000;
+}
+
+PerfProfiler *PerfProfiler::instance()
+{
+   static PerfProfiler profiler;
+
+   return &profiler;
+}
+
+PerfProfiler::PerfProfiler()
+{
+   mClock.start();
+}
+
+void PerfProfiler::setEnabled(bool enabled)
+{
+   mEnabled.storeRelease(enabled ? 1 : 0);
+}
+
+void PerfProfiler::addEvent(const char *name, const char *category, qint64 startUs, qint64 durationUs)
+{
+   const auto threadId = reinterpret_cast<quintptr>(QThread::currentThreadId());
+
+   QMutexLocker lock(&mMutex);
+
+   if (mEvents.count() >= MaxRecordedEvents)
+      mEvents.remove(0, mEvents.count() / 2);
+
+   mEvents.append({ name, category, startUs, durationUs, threadId });
+
+   auto &stat = mStats[name];
+
+   if (stat.count == 0)
+   {
+      stat.name = QString::fromUtf8(name);
+      stat.category = QString::fromUtf8(category);
+   }
+
+   ++stat.count;
+   stat.totalUs += durationUs;
+   stat.maxUs = qMax(stat.maxUs, durationUs);
+}
+
+QVector<PerfProfiler::Stat> PerfProfiler::stats() const
+{
+   QVector<Stat> stats;
+
+   {
+      QMutexLocker lock(&mMutex);
+
+      stats.reserve(mStats.count());
+
+      for (const auto &stat : mStats)
+         stats.append(stat);
+   }
+
+   std::sort(stats.begin(), stats.end(), [](const Stat &a, const Stat &b) { return a.totalUs > b.totalUs; });
+
+   return stats;
+}
+
+bool PerfProfiler::exportTrace(const QString &filePath) const
+{
+   QVector<Event> events;
+
+   {
+      QMutexLocker lock(&mMutex);
+      events = mEvents;
+   }
+
+   const auto pid = QCoreApplication::applicationPid();
+
+   QJsonArray traceEvents;
+
+   for (const auto &event : events)
+   {
+      traceEvents.append(QJsonObject { { "name", QString::fromUtf8(event.name) },
+                                       { "cat", QString::fromUtf8(event.category) },
+                                       { "ph", QStringLiteral("X") },
+                                       { "ts", event.startUs },
+                                       { "dur", event.durationUs },
+                                       { "pid", pid },
+                                       { "tid", static_cast<qint64>(event.threadId) } });
+   }
+
+   QFile file(filePath);
+
+   if (!file.open(QIODevice::WriteOnly))
+      return false;
+
+   file.write(QJsonDocument(QJsonObject { { "traceEvents", traceEvents } }).toJson(QJsonDocument::Compact));
+
+   return true;
+}
+
+void PerfProfiler::clear()
+{
+   QMutexLocker lock(&mMutex);
+
+   mEvents.clear();
+   mStats.clear();
+}
@@ -0,0 +1,163 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+#include <QAtomicInt>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QMutex>
+#include <QVector>
+
+/**
+ * @brief The PerfProfiler class collects the timings reported by the scoped timers placed on the
+ * hot paths (process execution, log parsing, cache setup, lanes and painting). It is disabled by
+ * default and instrumented code only pays an atomic read until the HUD enables it, so the timers
+ * can stay in release builds and be switched on when a user reports a slow repository.
+ */
+class PerfProfiler
+{
+public:
+   /**
+    * @brief The Stat struct aggregates all the recorded scopes that share a name.
+    */
+   struct Stat
+   {
+      QString name;
+      QString category;
+      int count = 0;
+      qint64 totalUs = 0;
+      qint64 maxUs = 0;
+   };
+
+   /**
+    * @brief instance Gets the application wide profiler.
+    * @return The profiler instance.
+    */
+   static PerfProfiler *instance();
+
+   /**
+    * @brief isEnabled Tells whether the scopes are being recorded.
+    * @return True if the profiler records, otherwise false.
+    */
+   bool isEnabled() const { return mEnabled.loadAcquire() != 0; }
+   /**
+    * @brief setEnabled Starts or stops the recording. The collected data survives a stop so it can
+    * still be exported afterwards.
+    * @param enabled True to record the instrumented scopes.
+    */
+   void setEnabled(bool enabled);
+
+   /**
+    * @brief nowUs Gets the current timestamp in the profiler's time base.
+    * @return Microseconds since the profiler was created.
+    */
+   qint64 nowUs() const { return mClock.nsecsElapsed() / 1000; }
+
+   /**
+    * @brief addEvent Records one finished scope. Called by @ref PerfScopedTimer.
+    * @param name The name of the scope. Must be a string literal.
+    * @param category The category of the scope. Must be a string literal.
+    * @param startUs The timestamp when the scope was entered.
+    * @param durationUs The time spent inside the scope.
+    */
+   void addEvent(const char *name, const char *category, qint64 startUs, qint64 durationUs);
+
+   /**
+    * @brief stats Gets the aggregated numbers per scope for the HUD.
+    * @return The list of stats sorted by total time spent.
+    */
+   QVector<Stat> stats() const;
+
+   /**
+    * @brief exportTrace Writes the recorded events in the chrome://tracing JSON format, so an
+    * incident capture can be inspected in a trace viewer without rebuilding the app.
+    * @param filePath The destination file.
+    * @return True if the file was written, otherwise false.
+    */
+   bool exportTrace(const QString &filePath) const;
+
+   /**
+    * @brief clear Drops the recorded events and the aggregated stats.
+    */
+   void clear();
+
+private:
+   struct Event
+   {
+      const char *name;
+      const char *category;
+      qint64 startUs;
+      qint64 durationUs;
+      quintptr threadId;
+   };
+
+   PerfProfiler();
+
+   QAtomicInt mEnabled;
+   QElapsedTimer mClock;
+   mutable QMutex mMutex;
+   QVector<Event> mEvents;
+   QHash<const char *, Stat> mStats;
+};
+
+/**
+ * @brief The PerfScopedTimer class reports the lifetime of its scope to the @ref PerfProfiler.
+ * When the profiler is disabled the constructor is a single atomic read and the destructor a
+ * pointer check.
+ */
+class PerfScopedTimer
+{
+public:
+   /**
+    * @brief Default constructor.
+    * @param name The name of the scope. Must be a string literal.
+    * @param category The category of the scope. Must be a string literal.
+    */
+   PerfScopedTimer(const char *name, const char *category)
+   {
+      if (PerfProfiler::instance()->isEnabled())
+      {
+         mName = name;
+         mCategory = category;
+         mStartUs = PerfProfiler::instance()->nowUs();
+      }
+   }
+
+   ~PerfScopedTimer()
+   {
+      if (mName)
+      {
+         const auto profiler = PerfProfiler::instance();
+         profiler->addEvent(mName, mCategory, mStartUs, profiler->nowUs() - mStartUs);
+      }
+   }
+
+   PerfScopedTimer(const PerfScopedTimer &) = delete;
+   PerfScopedTimer &operator=(const PerfScopedTimer &) = delete;
+
+private:
+   const char *mName = nullptr;
+   const char *mCategory = nullptr;
+   qint64 mStartUs = 0;
+};
@@ -4,13 +4,14 @@
 
 #include <QKeyEvent>
 
-ProgressDlg::ProgressDlg(const QString &labelText, const QString &cancelButtonText, int maximum, bool autoClose)
+ProgressDlg::ProgressDlg(const QString &labelText, const QString &cancelButtonText, int maximum, bool autoClose,
+                         bool modal)
    : QProgressDialog(labelText, cancelButtonText, 0, maximum)
 {
    setAutoClose(autoClose);
    setAutoReset(false);
    setAttribute(Qt::WA_DeleteOnClose);
-   setWindowModality(Qt::ApplicationModal);
+   setWindowModality(modal ? Qt::ApplicationModal : Qt::NonModal);
    setWindowFlags(Qt::FramelessWindowHint);
 
    setStyleSheet(GitQlientStyles::getStyles());
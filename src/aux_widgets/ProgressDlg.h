@@ -42,8 +42,11 @@ public:
     * @param maximum Maximum value.
     * @param autoReset Tells the progress dialog if it should automatically reset.
     * @param autoClose Tells the progress dialog if it should automatically close.
+    * @param modal Tells the progress dialog if it blocks the application. Long git operations use a non-modal dialog
+    * so the UI stays interactive while they run.
     */
-   explicit ProgressDlg(const QString &labelText, const QString &cancelButtonText, int maximum, bool autoClose);
+   explicit ProgressDlg(const QString &labelText, const QString &cancelButtonText, int maximum, bool autoClose,
+                        bool modal = true);
 
    /**
     * @brief Detects the press event to avoid closing the dialog when the Esc key is pressed.
@@ -0,0 +1,160 @@
+#include "RepoHealthWidget.h"
+
+#include <GitAsyncProcess.h>
+#include <GitBase.h>
+#include <GitCache.h>
+#include <GitQlientSettings.h>
+
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QGridLayout>
+#include <QLabel>
+#include <QListWidget>
+
+namespace
+{
+// Thresholds mirroring the ones git uses for `gc --auto` and `maintenance run --auto`, so the
+// recommendations match what the idle maintenance pass will actually do.
+constexpr auto LooseObjectsThreshold = 1000;
+constexpr auto PackCountThreshold = 10;
+
+QString formatKib(qint64 kib)
+{
+   if (kib >= 1024)
+      return QString("%1 MiB").arg(kib / 1024.0, 0, 'f', 1);
+
+   return QString("%1 KiB").arg(kib);
+}
+}
+
+RepoHealthWidget::RepoHealthWidget(const QSharedPointer<GitBase> &git, const QSharedPointer<GitCache> &cache,
+                                   QWidget *parent)
+   : QFrame(parent)
+   , mGit(git)
+   , mLooseObjects(new QLabel(tr("Loose objects: -")))
+   , mPacks(new QLabel(tr("Packs: -")))
+   , mCommitGraph(new QLabel(tr("Commit-graph: -")))
+   , mLastMaintenance(new QLabel(tr("Last maintenance: -")))
+   , mRecommendations(new QListWidget())
+{
+   const auto layout = new QGridLayout(this);
+   layout->setContentsMargins(10, 10, 10, 10);
+   layout->setSpacing(10);
+   layout->addWidget(mLooseObjects, 0, 0);
+   layout->addWidget(mPacks, 0, 1);
+   layout->addWidget(mCommitGraph, 1, 0);
+   layout->addWidget(mLastMaintenance, 1, 1);
+   layout->addWidget(new QLabel(tr("Recommendations")), 2, 0, 1, 2);
+   layout->addWidget(mRecommendations, 3, 0, 1, 2);
+
+   connect(cache.get(), &GitCache::signalCacheUpdated, this, &RepoHealthWidget::onCacheUpdated);
+}
+
+void RepoHealthWidget::showEvent(QShowEvent *event)
+{
+   QFrame::showEvent(event);
+
+   if (mDirty)
+   {
+      mDirty = false;
+      collectMetrics();
+   }
+}
+
+void RepoHealthWidget::onCacheUpdated()
+{
+   if (isVisible())
+      collectMetrics();
+   else
+      mDirty = true;
+}
+
+void RepoHealthWidget::collectMetrics()
+{
+   if (mCollecting)
+      return;
+
+   mCollecting = true;
+
+   const auto process = new GitAsyncProcess(mGit->getWorkingDir());
+   process->setPriority(GitExecPriority::Background);
+
+   connect(process, &GitAsyncProcess::signalDataReady, this, [this](GitExecResult result) {
+      mCollecting = false;
+
+      if (result.success)
+         refreshMetrics(result.output.toString());
+   });
+
+   if (!process->run("git count-objects -v").success)
+   {
+      process->deleteLater();
+
+      mCollecting = false;
+   }
+}
+
+void RepoHealthWidget::refreshMetrics(const QString &countObjectsOutput)
+{
+   auto looseCount = 0LL;
+   auto looseKib = 0LL;
+   auto packKib = 0LL;
+
+#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
+   const auto lines = countObjectsOutput.split('\n', Qt::SkipEmptyParts);
+#else
+   const auto lines = countObjectsOutput.split('\n', QString::SkipEmptyParts);
+#endif
+
+   for (const auto &line : lines)
+   {
+      const auto field = line.section(':', 0, 0).trimmed();
+      const auto value = line.section(':', 1).trimmed().toLongLong();
+
+      if (field == "count")
+         looseCount = value;
+      else if (field == "size")
+         looseKib = value;
+      else if (field == "size-pack")
+         packKib = value;
+   }
+
+   const auto gitDir = mGit->getGitDir();
+   const auto packCount
+       = QDir(QString("%1/objects/pack").arg(gitDir)).entryList({ "*.pack" }, QDir::Files).count();
+   const auto hasCommitGraph = QFileInfo::exists(QString("%1/objects/info/commit-graph").arg(gitDir))
+       || QFileInfo::exists(QString("%1/objects/info/commit-graphs/commit-graph-chain").arg(gitDir));
+
+   mLooseObjects->setText(tr("Loose objects: %1 (%2)").arg(looseCount).arg(formatKib(looseKib)));
+   mPacks->setText(tr("Packs: %1 (%2)").arg(packCount).arg(formatKib(packKib)));
+   mCommitGraph->setText(hasCommitGraph ? tr("Commit-graph: present") : tr("Commit-graph: missing"));
+
+   GitQlientSettings settings(gitDir);
+   const auto lastRun = settings.localValue("LastMaintenance", 0).toLongLong();
+   mLastMaintenance->setText(lastRun > 0
+                                 ? tr("Last maintenance: %1")
+                                       .arg(QDateTime::fromSecsSinceEpoch(lastRun).toString("dd MMM yyyy hh:mm"))
+                                 : tr("Last maintenance: never"));
+
+   mRecommendations->clear();
+
+   if (!hasCommitGraph)
+      mRecommendations->addItem(tr("The commit-graph is missing: log traversal reads every commit object. The "
+                                   "commit-graph maintenance task will write it."));
+
+   if (looseCount > LooseObjectsThreshold)
+      mRecommendations->addItem(tr("%1 loose objects slow down object lookup. The loose-objects maintenance task "
+                                   "will pack them.")
+                                    .arg(looseCount));
+
+   if (packCount > PackCountThreshold)
+      mRecommendations->addItem(tr("%1 packs multiply the indexes git searches per lookup. The incremental-repack "
+                                   "maintenance task will consolidate them.")
+                                    .arg(packCount));
+
+   if (mRecommendations->count() == 0)
+      mRecommendations->addItem(tr("The repository is in good shape."));
+   else
+      mRecommendations->addItem(tr("These tasks run automatically during the next idle maintenance pass."));
+}
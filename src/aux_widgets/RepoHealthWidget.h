@@ -0,0 +1,91 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+#include <QFrame>
+#include <QSharedPointer>
+
+class GitBase;
+class GitCache;
+class QLabel;
+class QListWidget;
+
+/**
+ * @brief The RepoHealthWidget class shows the on-disk health of the repository: loose object
+ * count and size, pack count and size, and whether a commit-graph is present. The metrics are
+ * collected by a background `git count-objects -v` run at background priority plus a couple of
+ * filesystem checks, and the results are cached: a new collection is only scheduled after the
+ * cache has been rebuilt (i.e. after a mutating operation) and while the panel is on screen.
+ * The panel also lists which of the idle maintenance tasks would improve the current state.
+ */
+class RepoHealthWidget : public QFrame
+{
+   Q_OBJECT
+
+public:
+   /**
+    * @brief Default constructor.
+    * @param git The git object to perform Git operations.
+    * @param cache The internal cache of the current repository.
+    * @param parent The parent widget if needed.
+    */
+   explicit RepoHealthWidget(const QSharedPointer<GitBase> &git, const QSharedPointer<GitCache> &cache,
+                             QWidget *parent = nullptr);
+
+protected:
+   /**
+    * @brief showEvent Schedules a metrics collection when the widget becomes visible with stale
+    * data.
+    * @param event The show event.
+    */
+   void showEvent(QShowEvent *event) override;
+
+private:
+   QSharedPointer<GitBase> mGit;
+   QLabel *mLooseObjects = nullptr;
+   QLabel *mPacks = nullptr;
+   QLabel *mCommitGraph = nullptr;
+   QLabel *mLastMaintenance = nullptr;
+   QListWidget *mRecommendations = nullptr;
+   bool mDirty = true;
+   bool mCollecting = false;
+
+   /**
+    * @brief onCacheUpdated Schedules a collection when visible, otherwise marks the cached
+    * metrics as stale. The cache is only rebuilt after operations that touched the object
+    * database, so this is the refresh trigger.
+    */
+   void onCacheUpdated();
+   /**
+    * @brief collectMetrics Runs `git count-objects -v` through the background priority class and
+    * refreshes the panel when the output arrives.
+    */
+   void collectMetrics();
+   /**
+    * @brief refreshMetrics Parses the count-objects output, checks the commit-graph and pack
+    * files on disk and repopulates the labels and the recommendation list.
+    * @param countObjectsOutput The raw output of `git count-objects -v`.
+    */
+   void refreshMetrics(const QString &countObjectsOutput);
+};
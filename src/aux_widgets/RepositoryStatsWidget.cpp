@@ -0,0 +1,76 @@
+#include "RepositoryStatsWidget.h"
+
+#include <GitCache.h>
+#include <RepositoryStats.h>
+
+#include <QGridLayout>
+#include <QLabel>
+#include <QListWidget>
+
+RepositoryStatsWidget::RepositoryStatsWidget(const QSharedPointer<GitCache> &cache, QWidget *parent)
+   : QFrame(parent)
+   , mStats(new RepositoryStats(cache, this))
+   , mTotalCommits(new QLabel(tr("Commits: -")))
+   , mContributorsList(new QListWidget())
+   , mActivityList(new QListWidget())
+   , mBranchesList(new QListWidget())
+{
+   const auto layout = new QGridLayout(this);
+   layout->setContentsMargins(10, 10, 10, 10);
+   layout->setSpacing(10);
+   layout->addWidget(mTotalCommits, 0, 0, 1, 3);
+   layout->addWidget(new QLabel(tr("Top contributors")), 1, 0);
+   layout->addWidget(new QLabel(tr("Activity per month")), 1, 1);
+   layout->addWidget(new QLabel(tr("Commits per branch")), 1, 2);
+   layout->addWidget(mContributorsList, 2, 0);
+   layout->addWidget(mActivityList, 2, 1);
+   layout->addWidget(mBranchesList, 2, 2);
+
+   connect(cache.get(), &GitCache::signalCacheUpdated, this, &RepositoryStatsWidget::onCacheUpdated);
+   connect(mStats, &RepositoryStats::statsReady, this, &RepositoryStatsWidget::refreshStats);
+}
+
+void RepositoryStatsWidget::showEvent(QShowEvent *event)
+{
+   QFrame::showEvent(event);
+
+   if (mDirty)
+   {
+      mDirty = false;
+      mStats->scheduleUpdate();
+   }
+}
+
+void RepositoryStatsWidget::onCacheUpdated()
+{
+   if (isVisible())
+      mStats->scheduleUpdate();
+   else
+      mDirty = true;
+}
+
+void RepositoryStatsWidget::refreshStats()
+{
+   mTotalCommits->setText(tr("Commits: %1").arg(mStats->totalCommits()));
+
+   mContributorsList->clear();
+
+   const auto contributors = mStats->contributors();
+
+   for (const auto &contributor : contributors)
+      mContributorsList->addItem(QString("%1 (%2)").arg(contributor.author).arg(contributor.commits));
+
+   mActivityList->clear();
+
+   const auto activity = mStats->monthlyActivity();
+
+   for (const auto &month : activity)
+      mActivityList->addItem(QString("%1 (%2)").arg(month.first).arg(month.second));
+
+   mBranchesList->clear();
+
+   const auto branches = mStats->branchActivity();
+
+   for (const auto &branch : branches)
+      mBranchesList->addItem(QString("%1 (%2)").arg(branch.branch).arg(branch.commits));
+}
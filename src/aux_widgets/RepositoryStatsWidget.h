@@ -0,0 +1,75 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+#include <QFrame>
+#include <QSharedPointer>
+
+class GitCache;
+class RepositoryStats;
+class QLabel;
+class QListWidget;
+
+/**
+ * @brief The RepositoryStatsWidget class shows the analytics computed by RepositoryStats:
+ * contributors, monthly activity and per-branch commit counts. The computation is only scheduled
+ * while the widget is on screen; cache updates arriving while it is hidden mark it dirty and the
+ * next show event catches up.
+ */
+class RepositoryStatsWidget : public QFrame
+{
+   Q_OBJECT
+
+public:
+   /**
+    * @brief Default constructor.
+    * @param cache The internal cache of the current repository.
+    * @param parent The parent widget if needed.
+    */
+   explicit RepositoryStatsWidget(const QSharedPointer<GitCache> &cache, QWidget *parent = nullptr);
+
+protected:
+   /**
+    * @brief showEvent Schedules a stats refresh when the widget becomes visible with stale data.
+    * @param event The show event.
+    */
+   void showEvent(QShowEvent *event) override;
+
+private:
+   RepositoryStats *mStats = nullptr;
+   QLabel *mTotalCommits = nullptr;
+   QListWidget *mContributorsList = nullptr;
+   QListWidget *mActivityList = nullptr;
+   QListWidget *mBranchesList = nullptr;
+   bool mDirty = true;
+
+   /**
+    * @brief onCacheUpdated Schedules a refresh when visible, otherwise marks the data as stale.
+    */
+   void onCacheUpdated();
+   /**
+    * @brief refreshStats Repopulates the lists with the freshly computed values.
+    */
+   void refreshStats();
+};
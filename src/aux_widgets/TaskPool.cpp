@@ -0,0 +1,62 @@
+#include "TaskPool.h"
+
+#include <QRunnable>
+#include <QThread>
+
+namespace
+{
+class TaggedTask : public QRunnable
+{
+public:
+   TaggedTask(std::function<void()> task, std::function<bool()> cancelled)
+      : mTask(std::move(task))
+      , mCancelled(std::move(cancelled))
+   {
+   }
+
+   void run() override
+   {
+      if (!mCancelled())
+         mTask();
+   }
+
+private:
+   std::function<void()> mTask;
+   std::function<bool()> mCancelled;
+};
+}
+
+TaskPool *TaskPool::instance()
+{
+   static TaskPool pool;
+   return &pool;
+}
+
+TaskPool::TaskPool()
+{
+   mPool.setMaxThreadCount(QThread::idealThreadCount());
+}
+
+void TaskPool::run(const QString &tag, const std::function<void()> &task)
+{
+   QMutexLocker lock(&mMutex);
+
+   const auto generation = mGenerations.value(tag, 0);
+
+   mPool.start(new TaggedTask(task, [this, tag, generation]() {
+      QMutexLocker lock(&mMutex);
+      return mGenerations.value(tag, 0) != generation;
+   }));
+}
+
+void TaskPool::cancel(const QString &tag)
+{
+   QMutexLocker lock(&mMutex);
+
+   ++mGenerations[tag];
+}
+
+void TaskPool::waitForDone()
+{
+   mPool.waitForDone();
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+#include <QHash>
+#include <QMutex>
+#include <QString>
+#include <QThreadPool>
+
+#include <functional>
+
+/**
+ * @brief The TaskPool class is the shared pool all the background computations of the application
+ * run on. It is sized to the cores of the machine, so several repositories refreshing at the same
+ * time compete for one bounded set of threads instead of each spawning its own. Tasks can carry a
+ * tag: cancelling the tag skips every queued task that still carries it, which gives the callers
+ * the same supersede semantics the generation counters implement locally.
+ */
+class TaskPool
+{
+public:
+   /**
+    * @brief instance Gets the application wide pool.
+    * @return The pool instance.
+    */
+   static TaskPool *instance();
+
+   /**
+    * @brief pool Gives access to the underlying QThreadPool so QtConcurrent::run can schedule on
+    * it and return a future.
+    * @return The underlying thread pool.
+    */
+   QThreadPool *pool() { return &mPool; }
+
+   /**
+    * @brief run Enqueues a task under the given tag. The task runs on the next free thread unless
+    * the tag is cancelled before it starts.
+    * @param tag The tag grouping related tasks.
+    * @param task The work to execute.
+    */
+   void run(const QString &tag, const std::function<void()> &task);
+
+   /**
+    * @brief cancel Discards the queued tasks of the given tag. A task that already started is not
+    * interrupted; long-running work should keep checking its own generation counter.
+    * @param tag The tag to cancel.
+    */
+   void cancel(const QString &tag);
+
+   /**
+    * @brief waitForDone Blocks until every scheduled task finished.
+    */
+   void waitForDone();
+
+private:
+   TaskPool();
+
+   QThreadPool mPool;
+   QMutex mMutex;
+   QHash<QString, int> mGenerations;
+};
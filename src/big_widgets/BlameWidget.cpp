@@ -2,12 +2,14 @@
 
 #include <GitHistory.h>
 #include <FileBlameWidget.h>
+#include <CommitTreeBrowser.h>
 #include <BranchesViewDelegate.h>
 #include <RepositoryViewDelegate.h>
 #include <CommitHistoryModel.h>
 #include <CommitHistoryView.h>
 #include <CommitHistoryColumns.h>
 #include <CommitInfo.h>
+#include <TaskPool.h>
 
 #include <QFileSystemModel>
 #include <QTreeView>
@@ -16,7 +18,9 @@
 #include <QMenu>
 #include <QApplication>
 #include <QClipboard>
+#include <QPointer>
 #include <QTabWidget>
+#include <QtConcurrent>
 
 BlameWidget::BlameWidget(const QSharedPointer<GitCache> &cache, const QSharedPointer<GitBase> &git,
                          const QSharedPointer<GitQlientSettings> &settings, QWidget *parent)
@@ -28,6 +32,7 @@ BlameWidget::BlameWidget(const QSharedPointer<GitCache> &cache, const QSharedPoi
    , mRepoModel(new CommitHistoryModel(mCache, mGit, nullptr))
    , mRepoView(new CommitHistoryView(mCache, mGit, mSettings, nullptr))
    , fileSystemView(new QTreeView())
+   , mCommitTreeBrowser(new CommitTreeBrowser(git))
    , mTabWidget(new QTabWidget())
 {
    mTabWidget->setObjectName("HistoryTab");
@@ -52,17 +57,23 @@ BlameWidget::BlameWidget(const QSharedPointer<GitCache> &cache, const QSharedPoi
    fileSystemModel->setFilter(QDir::AllDirs | QDir::Files | QDir::NoDotAndDotDot);
 
    fileSystemView->setModel(fileSystemModel);
-   fileSystemView->setMaximumWidth(450);
    fileSystemView->header()->setSectionHidden(1, true);
    fileSystemView->header()->setSectionHidden(2, true);
    fileSystemView->header()->setSectionHidden(3, true);
    fileSystemView->setContextMenuPolicy(Qt::CustomContextMenu);
    connect(fileSystemView, &QTreeView::clicked, this, &BlameWidget::showFileHistoryByIndex);
 
+   connect(mCommitTreeBrowser, &CommitTreeBrowser::fileSelected, this, &BlameWidget::showFileHistory);
+
+   const auto filesTabWidget = new QTabWidget();
+   filesTabWidget->setMaximumWidth(450);
+   filesTabWidget->addTab(fileSystemView, tr("Working dir"));
+   filesTabWidget->addTab(mCommitTreeBrowser, tr("Commit tree"));
+
    const auto historyBlameLayout = new QGridLayout(this);
    historyBlameLayout->setContentsMargins(QMargins());
    historyBlameLayout->addWidget(mRepoView, 0, 0);
-   historyBlameLayout->addWidget(fileSystemView, 1, 0);
+   historyBlameLayout->addWidget(filesTabWidget, 1, 0);
    historyBlameLayout->addWidget(mTabWidget, 0, 1, 2, 1);
 
    mTabWidget->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
@@ -104,53 +115,94 @@ void BlameWidget::init(const QString &workingDirectory)
 
 void BlameWidget::showFileHistory(const QString &filePath)
 {
-   if (!mTabsMap.contains(filePath))
+   if (mTabsMap.contains(filePath))
    {
-      QScopedPointer<GitHistory> git(new GitHistory(mGit));
-      auto ret = git->history(filePath);
+      mTabWidget->setCurrentWidget(mTabsMap.value(filePath));
+      return;
+   }
 
-      if (ret.success)
-      {
-#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
-         auto shaHistory = ret.output.toString().split("\n", Qt::SkipEmptyParts);
-#else
-         auto shaHistory = ret.output.toString().split("\n", QString::SkipEmptyParts);
-#endif
-         for (auto i = 0; i < shaHistory.size();)
-         {
-            if (shaHistory.at(i).startsWith("gpg:"))
-            {
-               shaHistory.takeAt(i);
+   if (mPendingHistories.contains(filePath))
+      return;
 
-               if (shaHistory.size() <= i)
-                  break;
-            }
-            else
-               ++i;
-         }
+   mPendingHistories.insert(filePath);
 
-         mRepoView->blockSignals(true);
-         mRepoView->filterBySha(shaHistory);
-         mRepoView->blockSignals(false);
+   // The follow walk visits the whole history and can take seconds on deep repositories, so it runs
+   // on the task pool and fills the shared chain cache; re-opening the file is then served from it
+   QPointer<BlameWidget> guard(this);
+   const auto gitBase = mGit;
+
+   QtConcurrent::run(TaskPool::instance()->pool(), [guard, gitBase, filePath]() {
+      QScopedPointer<GitHistory> git(new GitHistory(gitBase));
+      const auto ret = git->history(filePath);
+      const auto shaHistory = ret.success ? parseShaHistory(ret.output.toString()) : QStringList();
+
+      if (!guard)
+         return;
+
+      QMetaObject::invokeMethod(
+          guard,
+          [guard, filePath, shaHistory]() {
+             if (!guard)
+                return;
+
+             guard->mPendingHistories.remove(filePath);
+
+             if (!shaHistory.isEmpty())
+                guard->onFileHistoryReady(filePath, shaHistory);
+          },
+          Qt::QueuedConnection);
+   });
+}
+
+void BlameWidget::onFileHistoryReady(const QString &filePath, const QStringList &shaHistory)
+{
+   if (mTabsMap.contains(filePath))
+   {
+      mTabWidget->setCurrentWidget(mTabsMap.value(filePath));
+      return;
+   }
+
+   mRepoView->blockSignals(true);
+   mRepoView->filterBySha(shaHistory);
+   mRepoView->blockSignals(false);
+
+   const auto previousSha = shaHistory.count() > 1 ? shaHistory.at(1) : QString(tr("No info"));
+   const auto fileBlameWidget = new FileBlameWidget(mCache, mGit);
 
-         const auto previousSha = shaHistory.count() > 1 ? shaHistory.at(1) : QString(tr("No info"));
-         const auto fileBlameWidget = new FileBlameWidget(mCache, mGit);
+   fileBlameWidget->setup(filePath, shaHistory.constFirst(), previousSha);
+   connect(fileBlameWidget, &FileBlameWidget::signalCommitSelected, mRepoView, &CommitHistoryView::focusOnCommit);
 
-         fileBlameWidget->setup(filePath, shaHistory.constFirst(), previousSha);
-         connect(fileBlameWidget, &FileBlameWidget::signalCommitSelected, mRepoView, &CommitHistoryView::focusOnCommit);
+   const auto index = mTabWidget->addTab(fileBlameWidget, filePath.split("/").last());
+   mTabWidget->setTabsClosable(true);
+   mTabWidget->blockSignals(true);
+   mTabWidget->setCurrentIndex(index);
+   mTabWidget->blockSignals(false);
 
-         const auto index = mTabWidget->addTab(fileBlameWidget, filePath.split("/").last());
-         mTabWidget->setTabsClosable(true);
-         mTabWidget->blockSignals(true);
-         mTabWidget->setCurrentIndex(index);
-         mTabWidget->blockSignals(false);
+   mLastTabIndex = index;
+   mTabsMap.insert(filePath, fileBlameWidget);
+}
+
+QStringList BlameWidget::parseShaHistory(const QString &output)
+{
+#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
+   auto shaHistory = output.split("\n", Qt::SkipEmptyParts);
+#else
+   auto shaHistory = output.split("\n", QString::SkipEmptyParts);
+#endif
+   for (auto i = 0; i < shaHistory.size();)
+   {
+      if (shaHistory.at(i).startsWith("gpg:"))
+      {
+         shaHistory.takeAt(i);
 
-         mLastTabIndex = index;
-         mTabsMap.insert(filePath, fileBlameWidget);
+         if (shaHistory.size() <= i)
+            break;
       }
+      else
+         ++i;
    }
-   else
-      mTabWidget->setCurrentWidget(mTabsMap.value(filePath));
+
+   return shaHistory;
 }
 
 void BlameWidget::onNewRevisions(int totalCommits)
@@ -161,12 +213,17 @@ void BlameWidget::onNewRevisions(int totalCommits)
 void BlameWidget::reloadBlame(const QModelIndex &index)
 {
    mSelectedRow = index.row();
+
+   const auto sha
+       = mRepoView->model()->index(index.row(), static_cast<int>(CommitHistoryColumns::Sha)).data().toString();
+
+   // The snapshot browser follows the selected commit; only the root of the tree is listed here
+   mCommitTreeBrowser->showCommitTree(sha);
+
    const auto blameWidget = qobject_cast<FileBlameWidget *>(mTabWidget->currentWidget());
 
    if (blameWidget)
    {
-      const auto sha
-          = mRepoView->model()->index(index.row(), static_cast<int>(CommitHistoryColumns::Sha)).data().toString();
       const auto previousSha
           = mRepoView->model()->index(index.row() + 1, static_cast<int>(CommitHistoryColumns::Sha)).data().toString();
       blameWidget->reload(sha, previousSha);
@@ -188,23 +245,7 @@ void BlameWidget::reloadHistory(int tabIndex)
 
       if (ret.success)
       {
-#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
-         auto shaHistory = ret.output.toString().split("\n", Qt::SkipEmptyParts);
-#else
-         auto shaHistory = ret.output.toString().split("\n", QString::SkipEmptyParts);
-#endif
-         for (auto i = 0; i < shaHistory.size();)
-         {
-            if (shaHistory.at(i).startsWith("gpg:"))
-            {
-               shaHistory.takeAt(i);
-
-               if (shaHistory.size() <= i)
-                  break;
-            }
-            else
-               ++i;
-         }
+         const auto shaHistory = parseShaHistory(ret.output.toString());
 
          mRepoView->blockSignals(true);
          mRepoView->filterBySha(shaHistory);
@@ -25,11 +25,13 @@
 
 #include <QFrame>
 #include <QMap>
+#include <QSet>
 
 class GitCache;
 class GitBase;
 class QFileSystemModel;
 class FileBlameWidget;
+class CommitTreeBrowser;
 class QTreeView;
 class CommitHistoryModel;
 class CommitHistoryView;
@@ -41,8 +43,8 @@ class GitQlientSettings;
 /**
  * @brief The BlameWidget class creates the layout that contains all the widgets that are part of the blame and history
  * view. The blame&history view is formed by a view that shows the history view of a given file, another view that shows
- * the files in the repository folder, and finally a central widget in the form of a QTabWidget that openes as many file
- * blames as the user wants.
+ * the files in the repository folder next to a browser of the tree of the selected commit, and finally a central widget
+ * in the form of a QTabWidget that openes as many file blames as the user wants.
  *
  * After the widget is instantiated and before its first use, it needs to be initialized by calling the @ref init
  * method. Once it's done, it can open files requested by other widgets by using the @p showFileHistory method, that
@@ -116,12 +118,14 @@ private:
    CommitHistoryModel *mRepoModel = nullptr;
    CommitHistoryView *mRepoView = nullptr;
    QTreeView *fileSystemView = nullptr;
+   CommitTreeBrowser *mCommitTreeBrowser = nullptr;
    QTabWidget *mTabWidget = nullptr;
    QString mWorkingDirectory;
    QMap<QString, FileBlameWidget *> mTabsMap;
    RepositoryViewDelegate *mItemDelegate = nullptr;
    int mSelectedRow = -1;
    int mLastTabIndex = 0;
+   QSet<QString> mPendingHistories;
 
    /**
     * @brief Opens the blame for a given index from the file system model. This method configures both the history view,
@@ -153,6 +157,24 @@ private:
     */
    void reloadHistory(int tabIndex);
 
+   /**
+    * @brief Turns the raw output of the follow walk into the list of SHAs of the file, dropping the gpg signature
+    * lines git may interleave.
+    *
+    * @param output The raw `git log --follow` output.
+    * @return QStringList The SHAs where the file was modified, newest first.
+    */
+   static QStringList parseShaHistory(const QString &output);
+
+   /**
+    * @brief Configures the history view and opens the blame tab once the follow walk of the file finished on the
+    * worker thread.
+    *
+    * @param filePath The full file path.
+    * @param shaHistory The SHAs where the file was modified, newest first.
+    */
+   void onFileHistoryReady(const QString &filePath, const QStringList &shaHistory);
+
    /*!
      \brief Retrieves the SHA from the QModelIndex and triggers the \ref signalOpenDiff signal.
 
@@ -5,6 +5,8 @@
 #include <GitBase.h>
 #include <GitQlientSettings.h>
 #include <QLogger.h>
+#include <RepoHealthWidget.h>
+#include <RepositoryStatsWidget.h>
 
 #include <QDir>
 #include <QFileInfo>
@@ -40,7 +42,7 @@ qint64 dirSize(QString dirPath)
 }
 }
 
-ConfigWidget::ConfigWidget(const QSharedPointer<GitBase> &git, QWidget *parent)
+ConfigWidget::ConfigWidget(const QSharedPointer<GitCache> &cache, const QSharedPointer<GitBase> &git, QWidget *parent)
    : QWidget(parent)
    , ui(new Ui::ConfigWidget)
    , mGit(git)
@@ -106,6 +108,14 @@ ConfigWidget::ConfigWidget(const QSharedPointer<GitBase> &git, QWidget *parent)
    ui->tabWidget->setCurrentIndex(0);
    connect(ui->pbClearCache, &ButtonLink::clicked, this, &ConfigWidget::clearCache);
 
+   // The statistics are computed from the in-memory cache, so the tab only schedules work while
+   // it is visible
+   ui->tabWidget_2->addTab(new RepositoryStatsWidget(cache), tr("Statistics"));
+
+   // The health metrics come from the object database on disk, so they are collected by a
+   // background process and refreshed only when the cache is rebuilt after a mutating operation
+   ui->tabWidget_2->addTab(new RepoHealthWidget(git, cache), tr("Health"));
+
    ui->cbPomodoroEnabled->setChecked(settings.localValue("Pomodoro/Enabled", true).toBool());
 
    ui->cbStash->setChecked(settings.localValue("StashesHeader", true).toBool());
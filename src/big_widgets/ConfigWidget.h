@@ -4,6 +4,7 @@
 #include <QMap>
 
 class GitBase;
+class GitCache;
 class QTimer;
 class FileEditor;
 class QPushButton;
@@ -24,7 +25,8 @@ signals:
    void panelsVisibilityChaned();
 
 public:
-   explicit ConfigWidget(const QSharedPointer<GitBase> &git, QWidget *parent = nullptr);
+   explicit ConfigWidget(const QSharedPointer<GitCache> &cache, const QSharedPointer<GitBase> &git,
+                         QWidget *parent = nullptr);
    ~ConfigWidget();
 
    void onPanelsVisibilityChanged();
@@ -12,22 +12,26 @@
 #include <GitTags.h>
 #include <PomodoroButton.h>
 #include <QLogger.h>
+#include <TaskPool.h>
 
 #include <QApplication>
 #include <QButtonGroup>
 #include <QHBoxLayout>
 #include <QMenu>
 #include <QMessageBox>
+#include <QPointer>
 #include <QProgressBar>
 #include <QPushButton>
 #include <QTimer>
 #include <QToolButton>
+#include <QtConcurrent>
 
 using namespace QLogger;
 
 Controls::Controls(const QSharedPointer<GitCache> &cache, const QSharedPointer<GitBase> &git, QWidget *parent)
    : QFrame(parent)
    , mGit(git)
+   , mCache(cache)
    , mGitTags(new GitTags(mGit, cache))
    , mHistory(new QToolButton())
    , mDiff(new QToolButton())
@@ -234,10 +238,42 @@ void Controls::enableButtons(bool enabled)
 
 void Controls::pullCurrentBranch()
 {
-   QApplication::setOverrideCursor(QCursor(Qt::WaitCursor));
-   QScopedPointer<GitRemote> git(new GitRemote(mGit));
-   const auto ret = git->pull();
-   QApplication::restoreOverrideCursor();
+   if (mPullInProgress)
+      return;
+
+   mPullInProgress = true;
+   mPullBtn->setEnabled(false);
+
+   emit operationStarted(QStringLiteral("pull"), tr("Pulling current branch..."));
+
+   // The pull can run for minutes and the tab may be closed meanwhile, so the task only holds a
+   // guarded pointer to the widget and its own reference to the git object
+   QPointer<Controls> guard(this);
+   const auto gitBase = mGit;
+
+   QtConcurrent::run(TaskPool::instance()->pool(), [guard, gitBase]() {
+      QScopedPointer<GitRemote> git(new GitRemote(gitBase));
+      const auto ret = git->pull();
+
+      if (!guard)
+         return;
+
+      QMetaObject::invokeMethod(
+          guard,
+          [guard, ret]() {
+             if (guard)
+                guard->onPullFinished(ret);
+          },
+          Qt::QueuedConnection);
+   });
+}
+
+void Controls::onPullFinished(const GitExecResult &ret)
+{
+   mPullInProgress = false;
+   mPullBtn->setEnabled(true);
+
+   emit operationFinished(QStringLiteral("pull"));
 
    const auto msg = ret.output.toString();
 
@@ -270,16 +306,51 @@ void Controls::pullCurrentBranch()
 
 void Controls::fetchAll()
 {
-   QApplication::setOverrideCursor(QCursor(Qt::WaitCursor));
-   QScopedPointer<GitRemote> git(new GitRemote(mGit));
-   const auto ret = git->fetch();
-   QApplication::restoreOverrideCursor();
-
-   if (ret)
-   {
-      mGitTags->getRemoteTags();
-      emit requestReload(true);
-   }
+   if (mFetchInProgress)
+      return;
+
+   mFetchInProgress = true;
+   mRefreshBtn->setEnabled(false);
+
+   emit operationStarted(QStringLiteral("fetch"), tr("Fetching remotes..."));
+
+   // The widget may be destroyed while the fetch runs, so the task reads the git objects through
+   // its own references and only touches the widget through the guard
+   QPointer<Controls> guard(this);
+   const auto gitBase = mGit;
+   const auto gitTags = mGitTags;
+
+   QtConcurrent::run(TaskPool::instance()->pool(), [guard, gitBase, gitTags]() {
+      // The refs snapshot taken around the fetch tells whether anything actually arrived, so
+      // periodic fetches of an unchanged remote end without touching the UI at all
+      const auto refsBefore = gitBase->run("git show-ref --hash").output.toString();
+
+      QScopedPointer<GitRemote> git(new GitRemote(gitBase));
+      const auto success = git->fetch();
+      const auto changed = success && gitBase->run("git show-ref --hash").output.toString() != refsBefore;
+
+      if (!guard)
+         return;
+
+      QMetaObject::invokeMethod(
+          guard,
+          [guard, gitTags, success, changed]() {
+             if (!guard)
+                return;
+
+             guard->mFetchInProgress = false;
+             guard->mRefreshBtn->setEnabled(true);
+
+             emit guard->operationFinished(QStringLiteral("fetch"));
+
+             if (success && changed)
+             {
+                gitTags->refreshRemoteTags();
+                emit guard->requestReload(true);
+             }
+          },
+          Qt::QueuedConnection);
+   });
 }
 
 void Controls::activateMergeWarning()
@@ -317,7 +388,7 @@ void Controls::pushCurrentBranch()
    if (ret.output.toString().contains("has no upstream branch"))
    {
       const auto currentBranch = mGit->getCurrentBranch();
-      BranchDlg dlg({ currentBranch, BranchDlgMode::PUSH_UPSTREAM, mGit });
+      BranchDlg dlg({ currentBranch, BranchDlgMode::PUSH_UPSTREAM, mGit, mCache });
       const auto dlgRet = dlg.exec();
 
       if (dlgRet == QDialog::Accepted)
@@ -23,6 +23,8 @@
  ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
  ***************************************************************************************/
 
+#include <GitExecResult.h>
+
 #include <QFrame>
 
 class QToolButton;
@@ -113,6 +115,20 @@ signals:
     */
    void goConfig();
 
+   /**
+    * @brief operationStarted Signal triggered when a background git operation starts, so the
+    * non-modal progress surface shows a row for it.
+    * @param id The identifier of the operation.
+    * @param description The text shown for the operation.
+    */
+   void operationStarted(const QString &id, const QString &description);
+
+   /**
+    * @brief operationFinished Signal triggered when a background git operation ended.
+    * @param id The identifier of the operation.
+    */
+   void operationFinished(const QString &id);
+
 public:
    /*!
     \brief Default constructor.
@@ -146,7 +162,9 @@ public:
    */
    void enableButtons(bool enabled);
    /*!
-    \brief Performs the fetch action. Can be triggered manually or by a timer.
+    \brief Performs the fetch action on the worker pool. Can be triggered manually or by a timer. The
+    refresh afterwards only fires when the fetch actually updated some reference, so periodic fetches
+    of an unchanged remote are free.
 
    */
    void fetchAll();
@@ -180,6 +198,7 @@ public:
 private:
    QString mCurrentSha;
    QSharedPointer<GitBase> mGit;
+   QSharedPointer<GitCache> mCache;
    QSharedPointer<GitTags> mGitTags;
    QToolButton *mHistory = nullptr;
    QToolButton *mDiff = nullptr;
@@ -197,12 +216,21 @@ private:
    GitQlientUpdater *mUpdater = nullptr;
    QButtonGroup *mBtnGroup = nullptr;
    bool mGoGitServerView = false;
+   bool mFetchInProgress = false;
+   bool mPullInProgress = false;
 
    /*!
-    \brief Pulls the current branch.
+    \brief Pulls the current branch on the worker pool, so the UI stays responsive while the
+    remote is contacted.
 
    */
    void pullCurrentBranch();
+   /*!
+    \brief Handles the result of the pull once it finished in the background.
+
+    \param ret The result of the pull operation.
+   */
+   void onPullFinished(const GitExecResult &ret);
    /*!
     \brief Pushes the current local branch changes.
 
@@ -1,5 +1,7 @@
 #include "DiffWidget.h"
 
+#include <GitAsyncProcess.h>
+#include <GitBase.h>
 #include <GitCache.h>
 #include <CommitInfoPanel.h>
 #include <FileDiffWidget.h>
@@ -63,7 +65,7 @@ DiffWidget::DiffWidget(const QSharedPointer<GitBase> git, QSharedPointer<GitCach
 
    setLayout(layout);
 
-   connect(fileListWidget, &FileListWidget::itemDoubleClicked, this, &DiffWidget::onDoubleClick);
+   connect(fileListWidget, &FileListWidget::fileDoubleClicked, this, &DiffWidget::onDoubleClick);
    connect(fileListWidget, &FileListWidget::signalShowFileHistory, this, &DiffWidget::signalShowFileHistory);
 
    fileListWidget->setVisible(false);
@@ -109,8 +111,8 @@ bool DiffWidget::loadFileDiff(const QString &currentSha, const QString &previous
 
       if (fileWithModifications)
       {
-         mInfoPanelBase->configure(mCache->commitInfo(currentSha));
-         mInfoPanelParent->configure(mCache->commitInfo(previousSha));
+         mInfoPanelBase->configure(commitWithBody(currentSha));
+         mInfoPanelParent->configure(commitWithBody(previousSha));
 
          mDiffWidgets.insert(id, fileDiffWidget);
 
@@ -151,33 +153,24 @@ bool DiffWidget::loadCommitDiff(const QString &sha, const QString &parentSha)
 
    if (!mDiffWidgets.contains(id))
    {
-      QScopedPointer<GitHistory> git(new GitHistory(mGit));
-      const auto ret = git->getCommitDiff(sha, parentSha);
-
-      if (ret.success && !ret.output.toString().isEmpty())
+      // A newer selection supersedes the diff still being computed: its process is killed right
+      // away and the late result dropped, so rapid commit browsing only pays the newest request
+      if (mCommitDiffProcess)
       {
-         const auto fullDiffWidget = new FullDiffWidget(mGit, mCache);
-         fullDiffWidget->loadDiff(sha, parentSha, ret.output.toString());
-
-         mInfoPanelBase->configure(mCache->commitInfo(sha));
-         mInfoPanelParent->configure(mCache->commitInfo(parentSha));
+         disconnect(mCommitDiffProcess, nullptr, this, nullptr);
+         mCommitDiffProcess->onCancel();
+         mCommitDiffProcess = nullptr;
+      }
 
-         mDiffWidgets.insert(id, fullDiffWidget);
+      QLog_Info("UI", QString("Requested diff for commit {%1} to {%2}").arg(sha, parentSha));
 
-         const auto index = mCenterStackedWidget->addTab(fullDiffWidget,
-                                                         QString("(%1 \u2194 %2)").arg(sha.left(6), parentSha.left(6)));
-         mCenterStackedWidget->setCurrentIndex(index);
+      mPendingDiffSha = sha;
+      mPendingDiffParentSha = parentSha;
 
-         fileListWidget->insertFiles(sha, parentSha);
-         fileListWidget->setVisible(true);
+      mCommitDiffProcess = new GitAsyncProcess(mGit->getWorkingDir());
+      connect(mCommitDiffProcess, &GitAsyncProcess::signalDataReady, this, &DiffWidget::onCommitDiffReady);
 
-         return true;
-      }
-      else
-         QMessageBox::information(this, tr("No diff to show!"),
-                                  tr("There is no diff to show between commit SHAs {%1} and {%2}").arg(sha, parentSha));
-
-      return false;
+      mCommitDiffProcess->run(GitHistory::getCommitDiffCmd(sha, parentSha));
    }
    else
    {
@@ -185,11 +178,48 @@ bool DiffWidget::loadCommitDiff(const QString &sha, const QString &parentSha)
       const auto diff = dynamic_cast<FullDiffWidget *>(diffWidget);
       diff->reload();
       mCenterStackedWidget->setCurrentWidget(diff);
+
+      emit commitDiffLoaded();
    }
 
    return true;
 }
 
+void DiffWidget::onCommitDiffReady(const GitExecResult &result)
+{
+   if (sender() != mCommitDiffProcess)
+      return;
+
+   mCommitDiffProcess = nullptr;
+
+   const auto sha = mPendingDiffSha;
+   const auto parentSha = mPendingDiffParentSha;
+
+   if (const auto diffData = result.outputText(); result.success && !diffData.isEmpty())
+   {
+      const auto fullDiffWidget = new FullDiffWidget(mGit, mCache);
+      fullDiffWidget->loadDiff(sha, parentSha, diffData);
+
+      mInfoPanelBase->configure(commitWithBody(sha));
+      mInfoPanelParent->configure(commitWithBody(parentSha));
+
+      const auto id = QString("Commit diff (%1 \u2194 %2)").arg(sha.left(6), parentSha.left(6));
+      mDiffWidgets.insert(id, fullDiffWidget);
+
+      const auto index = mCenterStackedWidget->addTab(fullDiffWidget,
+                                                      QString("(%1 \u2194 %2)").arg(sha.left(6), parentSha.left(6)));
+      mCenterStackedWidget->setCurrentIndex(index);
+
+      fileListWidget->insertFiles(sha, parentSha);
+      fileListWidget->setVisible(true);
+
+      emit commitDiffLoaded();
+   }
+   else
+      QMessageBox::information(this, tr("No diff to show!"),
+                               tr("There is no diff to show between commit SHAs {%1} and {%2}").arg(sha, parentSha));
+}
+
 void DiffWidget::changeSelection(int index)
 {
    const auto widget = qobject_cast<IDiffWidget *>(mCenterStackedWidget->widget(index));
@@ -214,7 +244,17 @@ void DiffWidget::onTabClosed(int index)
    }
 }
 
-void DiffWidget::onDoubleClick(QListWidgetItem *item)
+void DiffWidget::onDoubleClick(const QString &fileName)
 {
-   loadFileDiff(mCurrentSha, mParentSha, item->text(), false);
+   loadFileDiff(mCurrentSha, mParentSha, fileName, false);
+}
+
+CommitInfo DiffWidget::commitWithBody(const QString &sha)
+{
+   auto commit = mCache->commitInfo(sha);
+
+   if (commit.longLog().isEmpty() && !commit.isWip())
+      commit.setLongLog(mGit->getCommitBody(commit.sha()));
+
+   return commit;
 }
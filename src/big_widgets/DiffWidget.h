@@ -23,17 +23,20 @@
  ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
  ***************************************************************************************/
 
+#include <CommitInfo.h>
+#include <GitExecResult.h>
+
 #include <QFrame>
 #include <QMap>
 
 class CommitInfoPanel;
+class GitAsyncProcess;
 class GitBase;
 class QPinnableTabWidget;
 class IDiffWidget;
 class QVBoxLayout;
 class FileListWidget;
 class GitCache;
-class QListWidgetItem;
 
 /*!
  \brief The DiffWidget class creates the layout to display the dif information for both files and commits.
@@ -56,6 +59,11 @@ signals:
 
    */
    void signalDiffEmpty();
+   /*!
+    \brief Signal triggered when a commit diff requested through loadCommitDiff is ready to be shown.
+
+   */
+   void commitDiffLoaded();
 
 public:
    /*!
@@ -93,11 +101,13 @@ public:
    */
    bool loadFileDiff(const QString &sha, const QString &previousSha, const QString &file, bool isCached);
    /*!
-    \brief Loads a full commit diff.
+    \brief Loads a full commit diff. The diff is computed asynchronously and commitDiffLoaded is emitted once it
+    can be shown. A request fired while a previous one is still being computed supersedes it: the old process is
+    killed and its late result dropped, so rapid commit browsing is bound to the newest selection only.
 
     \param sha The base SHA.
     \param parentSha The SHA to compare to.
-    \return True if the load was successful, otherwise false.
+    \return True if the request was accepted, otherwise false.
    */
    bool loadCommitDiff(const QString &sha, const QString &parentSha);
 
@@ -111,6 +121,18 @@ private:
    FileListWidget *fileListWidget = nullptr;
    QString mCurrentSha;
    QString mParentSha;
+   GitAsyncProcess *mCommitDiffProcess = nullptr;
+   QString mPendingDiffSha;
+   QString mPendingDiffParentSha;
+
+   /*!
+    \brief Retrieves the commit from the cache fetching its body on demand, since the log ingest
+    doesn't store commit descriptions.
+
+    \param sha The SHA of the commit.
+    \return The commit with its long log filled in.
+   */
+   CommitInfo commitWithBody(const QString &sha);
 
    /*!
     \brief When the user selects a different diff from a different tab, it changes the information in the commit info
@@ -126,5 +148,12 @@ private:
     */
    void onTabClosed(int index);
 
-   void onDoubleClick(QListWidgetItem *item);
+   void onDoubleClick(const QString &fileName);
+
+   /**
+    * @brief onCommitDiffReady Creates the diff tab for the commit diff computed asynchronously by loadCommitDiff.
+    * Results of superseded requests are dropped.
+    * @param result The result of the git diff command.
+    */
+   void onCommitDiffReady(const GitExecResult &result);
 };
@@ -1,6 +1,7 @@
 #include "GitQlient.h"
 
 #include <CreateRepoDlg.h>
+#include <FederatedHistoryWidget.h>
 #include <GitBase.h>
 #include <GitConfig.h>
 #include <GitQlientRepo.h>
@@ -8,6 +9,7 @@
 #include <GitQlientStyles.h>
 #include <InitScreen.h>
 #include <InitialRepoConfig.h>
+#include <PerfHud.h>
 #include <ProgressDlg.h>
 #include <QPinnableTabWidget.h>
 
@@ -15,13 +17,17 @@
 #include <QEvent>
 #include <QFile>
 #include <QFileDialog>
+#include <QLocalServer>
+#include <QLocalSocket>
 #include <QMenu>
 #include <QMessageBox>
+#include <QPointer>
 #include <QProcess>
 #include <QPushButton>
 #include <QStackedLayout>
 #include <QTabBar>
 #include <QTextStream>
+#include <QThread>
 #include <QToolButton>
 
 #include <QLogger.h>
@@ -91,11 +97,21 @@ GitQlient::GitQlient(QWidget *parent)
 
    menu->addMenu(mostUsed);
 
+   menu->addSeparator();
+
+   const auto perfHud = menu->addAction(tr("Performance HUD"));
+   connect(perfHud, &QAction::triggered, this, &GitQlient::showPerformanceHud);
+
+   const auto federatedHistory = menu->addAction(tr("Federated history"));
+   connect(federatedHistory, &QAction::triggered, this, &GitQlient::showFederatedHistory);
+
    mRepos->setObjectName("GitQlientTab");
    mRepos->setStyleSheet(GitQlientStyles::getStyles());
    mRepos->setCornerWidget(homeMenu, Qt::TopLeftCorner);
    connect(mRepos, &QTabWidget::tabCloseRequested, this, &GitQlient::closeTab);
    connect(mRepos, &QTabWidget::currentChanged, this, &GitQlient::updateWindowTitle);
+   connect(mRepos, &QTabWidget::currentChanged, this, &GitQlient::prioritizeCurrentRepoLoad);
+   connect(mRepos, &QTabWidget::currentChanged, this, &GitQlient::updateTabsSuspension);
 
    mStackedLayout->setContentsMargins(QMargins());
    mStackedLayout->addWidget(mConfigWidget);
@@ -117,6 +133,21 @@ GitQlient::GitQlient(QWidget *parent)
    connect(mGit.data(), &GitConfig::signalCloningProgress, this, &GitQlient::updateProgressDialog,
            Qt::DirectConnection);
    connect(mGit.data(), &GitConfig::signalCloningFailure, this, &GitQlient::showError, Qt::DirectConnection);
+
+   // Re-polishing is scoped to the main window trees: the stylesheet itself comes from the per-schema
+   // cache, so switching back and forth doesn't recompose it.
+   connect(GitQlientSettings::notifier(), &GitQlientSettings::valueChanged, this,
+           [this](const QString &key, const QVariant &) {
+              if (key == "colorSchema")
+              {
+                 const auto styles = GitQlientStyles::getStyles();
+
+                 setStyleSheet(styles);
+                 mRepos->setStyleSheet(styles);
+              }
+           });
+
+   startInstanceServer();
 }
 
 GitQlient::~GitQlient()
@@ -191,6 +222,37 @@ void GitQlient::initRepo()
    cloneDlg.exec();
 }
 
+void GitQlient::showPerformanceHud()
+{
+   if (!mPerfHud)
+      mPerfHud = new PerfHud(this);
+
+   mPerfHud->show();
+   mPerfHud->raise();
+}
+
+void GitQlient::showFederatedHistory()
+{
+   if (!mFederatedHistory)
+      mFederatedHistory = new FederatedHistoryWidget(this);
+
+   QVector<QPair<QString, QSharedPointer<GitCache>>> sources;
+   const auto totalTabs = mRepos->count();
+
+   for (auto i = 0; i < totalTabs; ++i)
+   {
+      if (const auto repo = dynamic_cast<GitQlientRepo *>(mRepos->widget(i)))
+      {
+         const auto repoPath = repo->currentDir();
+         sources.append(qMakePair(repoPath.mid(repoPath.lastIndexOf("/") + 1), repo->cache()));
+      }
+   }
+
+   mFederatedHistory->setSources(sources);
+   mFederatedHistory->show();
+   mFederatedHistory->raise();
+}
+
 void GitQlient::updateProgressDialog(QString stepDescription, int value)
 {
    if (value >= 0)
@@ -226,6 +288,70 @@ void GitQlient::setRepositories(const QStringList &repositories)
       addRepoTab(repo);
 }
 
+void GitQlient::scheduleRepoLoad(GitQlientRepo *repo, const QString &repoName)
+{
+   mPendingLoads.append(qMakePair(QPointer<GitQlientRepo>(repo), repoName));
+
+   startNextPendingLoad();
+}
+
+void GitQlient::startNextPendingLoad()
+{
+   const auto maxConcurrentLoads = qMax(1, QThread::idealThreadCount());
+
+   while (mRunningLoads.count() < maxConcurrentLoads && !mPendingLoads.isEmpty())
+   {
+      const auto load = mPendingLoads.takeFirst();
+
+      if (load.first.isNull())
+         continue;
+
+      mRunningLoads.insert(load.first.data());
+
+      connect(load.first.data(), &GitQlientRepo::repoOpened, this, &GitQlient::onRepoLoadEnded);
+      connect(load.first.data(), &QObject::destroyed, this, &GitQlient::onRepoLoadEnded);
+
+      load.first->setRepository(load.second);
+   }
+}
+
+void GitQlient::onRepoLoadEnded()
+{
+   if (mRunningLoads.remove(sender()))
+      startNextPendingLoad();
+}
+
+void GitQlient::prioritizeCurrentRepoLoad()
+{
+   const auto current = mRepos->currentWidget();
+
+   for (auto i = 0; i < mPendingLoads.count(); ++i)
+   {
+      if (mPendingLoads.at(i).first.data() == current)
+      {
+         mPendingLoads.move(i, 0);
+         break;
+      }
+   }
+}
+
+void GitQlient::updateTabsSuspension()
+{
+   const auto current = mRepos->currentWidget();
+   const auto totalTabs = mRepos->count();
+
+   for (auto i = 0; i < totalTabs; ++i)
+   {
+      if (const auto repo = dynamic_cast<GitQlientRepo *>(mRepos->widget(i)))
+      {
+         if (repo == current)
+            repo->resumeBackgroundTasks();
+         else
+            repo->suspendBackgroundTasks();
+      }
+   }
+}
+
 bool GitQlient::setArgumentsPostInit(const QStringList &arguments)
 {
    QLog_Info("UI", QString("External call with the params {%1}").arg(arguments.join(",")));
@@ -237,6 +363,73 @@ bool GitQlient::setArgumentsPostInit(const QStringList &arguments)
    return ret;
 }
 
+bool GitQlient::forwardToRunningInstance(const QStringList &arguments)
+{
+   QLocalSocket socket;
+   socket.connectToServer(instanceServerName());
+
+   if (!socket.waitForConnected(100))
+      return false;
+
+   socket.write(arguments.join(QChar('\n')).toUtf8());
+
+   const auto delivered = socket.waitForBytesWritten(500) || socket.bytesToWrite() == 0;
+
+   socket.disconnectFromServer();
+
+   return delivered;
+}
+
+QString GitQlient::instanceServerName()
+{
+   // One endpoint per user, so concurrent desktop sessions do not receive each other's repos
+   return QString("GitQlient-%1").arg(QString::fromLocal8Bit(qgetenv("USER") + qgetenv("USERNAME")));
+}
+
+void GitQlient::startInstanceServer()
+{
+   mInstanceServer = new QLocalServer(this);
+
+   connect(mInstanceServer, &QLocalServer::newConnection, this, &GitQlient::onInstanceConnection);
+
+   if (!mInstanceServer->listen(instanceServerName()))
+   {
+      // A crashed session can leave the socket behind; the name is only reclaimed when no live
+      // instance answers on it
+      QLocalSocket probe;
+      probe.connectToServer(instanceServerName());
+
+      if (!probe.waitForConnected(100))
+      {
+         QLocalServer::removeServer(instanceServerName());
+         mInstanceServer->listen(instanceServerName());
+      }
+   }
+}
+
+void GitQlient::onInstanceConnection()
+{
+   while (const auto connection = mInstanceServer->nextPendingConnection())
+   {
+      connect(connection, &QLocalSocket::readyRead, this, [this, connection]() {
+#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
+         const auto arguments = QString::fromUtf8(connection->readAll()).split(QChar('\n'), Qt::SkipEmptyParts);
+#else
+         const auto arguments = QString::fromUtf8(connection->readAll()).split(QChar('\n'), QString::SkipEmptyParts);
+#endif
+
+         connection->disconnectFromServer();
+         connection->deleteLater();
+
+         setArgumentsPostInit(arguments);
+
+         // The repos landed in this warm instance, so the window comes to the front
+         raise();
+         activateWindow();
+      });
+   }
+}
+
 bool GitQlient::parseArguments(const QStringList &arguments, QStringList *repos)
 {
    bool ret = true;
@@ -312,83 +505,108 @@ void GitQlient::addRepoTab(const QString &repoPath)
    addNewRepoTab(repoPath, false);
 }
 
+void GitQlient::openWorktreeTab(const QString &worktreePath)
+{
+   const auto canonicalPath = QFileInfo(worktreePath).canonicalFilePath();
+
+   for (auto i = 0; i < mRepos->count(); ++i)
+   {
+      if (const auto repo = dynamic_cast<GitQlientRepo *>(mRepos->widget(i)); repo && repo->currentDir() == canonicalPath)
+      {
+         mRepos->setCurrentIndex(i);
+         return;
+      }
+   }
+
+   addRepoTab(worktreePath);
+}
+
 void GitQlient::addNewRepoTab(const QString &repoPathArg, bool pinned)
 {
    const auto repoPath = QFileInfo(repoPathArg).canonicalFilePath();
 
-   if (!mCurrentRepos.contains(repoPath))
+   // Tabs pointing at the same repository share the cache and the loader, so an additional view
+   // (i.e. to compare branches side by side) only pays for its widgets.
+   if (mCurrentRepos.contains(repoPath))
+      QLog_Info("UI", QString("Repository at {%1} already opened. The new tab shares its cache.").arg(repoPath));
+
+   QFileInfo info(QString("%1/.git").arg(repoPath));
+
+   if (info.isFile() || info.isDir())
    {
-      QFileInfo info(QString("%1/.git").arg(repoPath));
+      const auto repoName = repoPath.contains("/") ? repoPath.split("/").last() : "";
 
-      if (info.isFile() || info.isDir())
+      if (repoName.isEmpty())
       {
-         const auto repoName = repoPath.contains("/") ? repoPath.split("/").last() : "";
-
-         if (repoName.isEmpty())
-         {
-            QMessageBox::critical(
-                this, tr("Not a repository"),
-                tr("The selected folder is not a Git repository. Please make sure you open a Git repository."));
-            QLog_Error("UI", "The selected folder is not a Git repository");
-            return;
-         }
+         QMessageBox::critical(
+             this, tr("Not a repository"),
+             tr("The selected folder is not a Git repository. Please make sure you open a Git repository."));
+         QLog_Error("UI", "The selected folder is not a Git repository");
+         return;
+      }
 
-         QSharedPointer<GitBase> git(new GitBase(repoPath));
-         QSharedPointer<GitQlientSettings> settings(new GitQlientSettings(git->getGitDir()));
+      QSharedPointer<GitBase> git(new GitBase(repoPath));
+      QSharedPointer<GitQlientSettings> settings(new GitQlientSettings(git->getGitDir()));
 
-         conditionallyOpenPreConfigDlg(settings);
+      conditionallyOpenPreConfigDlg(settings);
 
-         const auto repo = new GitQlientRepo(git, settings);
-         const auto index = pinned ? mRepos->addPinnedTab(repo, repoName) : mRepos->addTab(repo, repoName);
+      const auto repo = new GitQlientRepo(git, settings);
+      const auto index = pinned ? mRepos->addPinnedTab(repo, repoName) : mRepos->addTab(repo, repoName);
 
-         connect(repo, &GitQlientRepo::signalOpenSubmodule, this, &GitQlient::addRepoTab);
-         connect(repo, &GitQlientRepo::repoOpened, this, &GitQlient::onSuccessOpen);
-         connect(repo, &GitQlientRepo::currentBranchChanged, this, &GitQlient::updateWindowTitle);
+      connect(repo, &GitQlientRepo::signalOpenSubmodule, this, &GitQlient::addRepoTab);
+      connect(repo, &GitQlientRepo::signalOpenWorktree, this, &GitQlient::openWorktreeTab);
+      connect(repo, &GitQlientRepo::repoOpened, this, &GitQlient::onSuccessOpen);
+      connect(repo, &GitQlientRepo::currentBranchChanged, this, &GitQlient::updateWindowTitle);
 
-         repo->setRepository(repoName);
+      scheduleRepoLoad(repo, repoName);
 
-         if (!repoPath.isEmpty())
-         {
-            QProcess p;
-            p.setWorkingDirectory(repoPath);
-            p.start("git rev-parse", { "--show-superproject-working-tree" });
-            p.waitForFinished(5000);
+      if (!repoPath.isEmpty())
+      {
+         mRepos->setTabIcon(index, QIcon(QString(":/icons/local")));
 
-            const auto output = p.readAll().trimmed();
-            const auto isSubmodule = !output.isEmpty();
+         QLog_Info("UI", "Attaching repository to a new tab");
 
-            mRepos->setTabIcon(index, QIcon(isSubmodule ? QString(":/icons/submodules") : QString(":/icons/local")));
+         // The submodule check runs asynchronously so opening several tabs at startup doesn't
+         // block the UI waiting for one git call per repository.
+         const auto p = new QProcess(this);
+         p->setWorkingDirectory(repoPath);
 
-            QLog_Info("UI", "Attaching repository to a new tab");
+         connect(p, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished), this,
+                 [this, p, repoName, repoPtr = QPointer<GitQlientRepo>(repo)]() {
+                    p->deleteLater();
 
-            if (isSubmodule)
-            {
-               const auto parentRepo = QString::fromUtf8(output.split('/').last());
+                    const auto output = p->readAll().trimmed();
 
-               mRepos->setTabText(index, QString("%1 \u2192 %2").arg(parentRepo, repoName));
+                    if (const auto isSubmodule = !output.isEmpty(); isSubmodule && repoPtr)
+                    {
+                       const auto index = mRepos->indexOf(repoPtr.data());
+                       const auto parentRepo = QString::fromUtf8(output.split('/').last());
 
-               QLog_Info("UI",
-                         QString("Opening the submodule {%1} from the repo {%2} on tab index {%3}")
-                             .arg(repoName, parentRepo)
-                             .arg(index));
-            }
-         }
+                       mRepos->setTabIcon(index, QIcon(QString(":/icons/submodules")));
+                       mRepos->setTabText(index, QString("%1 \u2192 %2").arg(parentRepo, repoName));
 
-         mRepos->setCurrentIndex(index);
-         mStackedLayout->setCurrentIndex(1);
+                       QLog_Info("UI",
+                                 QString("Opening the submodule {%1} from the repo {%2} on tab index {%3}")
+                                     .arg(repoName, parentRepo)
+                                     .arg(index));
+                    }
+                 });
 
-         mCurrentRepos.insert(repoPath);
-      }
-      else
-      {
-         QLog_Info("UI", "Trying to open a directory that is not a Git repository.");
-         QMessageBox::information(
-             this, tr("Not a Git repository"),
-             tr("The selected path is not a Git repository. Please make sure you opened the correct directory."));
+         p->start("git rev-parse", { "--show-superproject-working-tree" });
       }
+
+      mRepos->setCurrentIndex(index);
+      mStackedLayout->setCurrentIndex(1);
+
+      ++mCurrentRepos[repoPath];
    }
    else
-      QLog_Warning("UI", QString("Repository at {%1} already opened. Skip adding it again.").arg(repoPath));
+   {
+      QLog_Info("UI", "Trying to open a directory that is not a Git repository.");
+      QMessageBox::information(
+          this, tr("Not a Git repository"),
+          tr("The selected path is not a Git repository. Please make sure you opened the correct directory."));
+   }
 }
 
 void GitQlient::closeTab(int tabIndex)
@@ -397,7 +615,9 @@ void GitQlient::closeTab(int tabIndex)
 
    QLog_Info("UI", QString("Removing repository {%1}").arg(repoToRemove->currentDir()));
 
-   mCurrentRepos.remove(repoToRemove->currentDir());
+   if (--mCurrentRepos[repoToRemove->currentDir()] <= 0)
+      mCurrentRepos.remove(repoToRemove->currentDir());
+
    repoToRemove->close();
 
    const auto totalTabs = mRepos->count() - 1;
@@ -23,15 +23,23 @@
  ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
  ***************************************************************************************/
 
-#include <QWidget>
+#include <QHash>
+#include <QPair>
+#include <QPointer>
 #include <QSet>
+#include <QVector>
+#include <QWidget>
 
+class QLocalServer;
 class QPinnableTabWidget;
 class InitScreen;
 class ProgressDlg;
 class GitConfig;
 class QStackedLayout;
 class GitQlientSettings;
+class GitQlientRepo;
+class PerfHud;
+class FederatedHistoryWidget;
 
 /*!
  \brief The GitQlient class is the MainWindow of the GitQlient application. Is the widget that stores all the tabs about
@@ -87,6 +95,16 @@ public:
    */
    static bool parseArguments(const QStringList &arguments, QStringList *repos);
 
+   /**
+    * @brief forwardToRunningInstance Tries to hand the command line arguments to an already
+    * running instance over the local instance socket. When a running instance accepts them, the
+    * repositories open as tabs of that instance, reusing its warm caches instead of paying a cold
+    * start in a new process.
+    * @param arguments Arguments from the command prompt.
+    * @return True if a running instance accepted the arguments.
+    */
+   static bool forwardToRunningInstance(const QStringList &arguments);
+
 protected:
    bool eventFilter(QObject *obj, QEvent *event) override;
 
@@ -94,10 +112,15 @@ private:
    QStackedLayout *mStackedLayout = nullptr;
    QPinnableTabWidget *mRepos = nullptr;
    InitScreen *mConfigWidget = nullptr;
-   QSet<QString> mCurrentRepos;
+   PerfHud *mPerfHud = nullptr;
+   FederatedHistoryWidget *mFederatedHistory = nullptr;
+   QHash<QString, int> mCurrentRepos;
    QSharedPointer<GitConfig> mGit;
    ProgressDlg *mProgressDlg = nullptr;
    QString mPathToOpen;
+   QVector<QPair<QPointer<GitQlientRepo>, QString>> mPendingLoads;
+   QSet<QObject *> mRunningLoads;
+   QLocalServer *mInstanceServer = nullptr;
 
    /*!
     \brief Opens a QFileDialog to select a repository in the local disk.
@@ -120,6 +143,18 @@ private:
    */
    void initRepo();
 
+   /**
+    * @brief Shows the performance HUD, creating it on first use. Opening it starts the hot-path
+    * instrumentation, so repositories that feel slow can be profiled in place.
+    */
+   void showPerformanceHud();
+
+   /**
+    * @brief Shows the federated history window, creating it on first use. Every time it opens it
+    * merges the histories of all currently open repositories.
+    */
+   void showFederatedHistory();
+
    /**
     * @brief Updates the progress dialog for cloning repos.
     *
@@ -143,6 +178,13 @@ private:
    */
    void addRepoTab(const QString &repoPath);
 
+   /**
+    * @brief openWorktreeTab Activates the tab that already shows the given worktree or opens a new one. Bouncing
+    * between branches through worktrees this way reuses the warm tab instead of reloading anything.
+    * @param worktreePath The path of the worktree.
+    */
+   void openWorktreeTab(const QString &worktreePath);
+
    /*!
     \brief Creates a new GitQlientWidget instance or the repository defined in the \p repoPath value. After that, it
     adds a new tab in the current widget.
@@ -158,6 +200,37 @@ private:
    */
    void closeTab(int tabIndex);
 
+   /**
+    * @brief scheduleRepoLoad Queues the initial load of the given @p repo. The number of loads running at the same
+    * time is bounded by the core count, so restoring a multi-repo session is limited by the largest repository
+    * instead of the sum of all of them.
+    * @param repo The repository view whose load is queued.
+    * @param repoName The repository name handed to the view when its load starts.
+    */
+   void scheduleRepoLoad(GitQlientRepo *repo, const QString &repoName);
+
+   /**
+    * @brief startNextPendingLoad Starts queued repository loads while there are free slots.
+    */
+   void startNextPendingLoad();
+
+   /**
+    * @brief onRepoLoadEnded Releases the slot held by a finished repository load and starts the next queued one.
+    */
+   void onRepoLoadEnded();
+
+   /**
+    * @brief prioritizeCurrentRepoLoad Moves the pending load of the foreground tab to the front of the queue, so the
+    * visible repository is always the first one served.
+    */
+   void prioritizeCurrentRepoLoad();
+
+   /**
+    * @brief updateTabsSuspension Suspends the background timers of every hidden tab and resumes the
+    * foreground one, which catches up with a single coalesced refresh.
+    */
+   void updateTabsSuspension();
+
    /**
     * @brief onSuccessOpen Refreshes the UI for the most used and most recent projects lists.
     * @param fullPath The full path of the project successfully opened.
@@ -176,4 +249,22 @@ private:
     * @param currentTabIndex The current tab index used to retrieve the repository.
     */
    void updateWindowTitle();
+
+   /**
+    * @brief startInstanceServer Starts listening on the local instance socket, so later command
+    * line invocations can hand their repositories to this instance.
+    */
+   void startInstanceServer();
+
+   /**
+    * @brief onInstanceConnection Reads the arguments forwarded by a new invocation, opens the
+    * repositories as tabs and brings the window to the front.
+    */
+   void onInstanceConnection();
+
+   /**
+    * @brief instanceServerName Gets the name of the local instance socket, unique per user.
+    * @return The name of the socket.
+    */
+   static QString instanceServerName();
 };
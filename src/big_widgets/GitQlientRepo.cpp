@@ -2,6 +2,7 @@
 
 #include <BlameWidget.h>
 #include <BranchesWidget.h>
+#include <CommandPalette.h>
 #include <CommitHistoryColumns.h>
 #include <CommitInfo.h>
 #include <ConfigData.h>
@@ -15,6 +16,7 @@
 #include <GitHistory.h>
 #include <GitHubRestApi.h>
 #include <GitLocal.h>
+#include <GitMaintenanceScheduler.h>
 #include <GitMerge.h>
 #include <GitQlientSettings.h>
 #include <GitRepoLoader.h>
@@ -26,43 +28,112 @@
 #include <HistoryWidget.h>
 #include <JenkinsWidget.h>
 #include <MergeWidget.h>
+#include <OperationProgressPanel.h>
 #include <QLogger.h>
-#include <WaitingDlg.h>
 
-#include <QApplication>
+#include <QDateTime>
 #include <QDirIterator>
+#include <QFile>
 #include <QFileDialog>
 #include <QFileSystemWatcher>
 #include <QGridLayout>
+#include <QHash>
 #include <QMessageBox>
+#include <QShortcut>
 #include <QStackedLayout>
 #include <QStackedWidget>
+#include <QThread>
 #include <QTimer>
 
 using namespace QLogger;
 using namespace GitServer;
 using namespace Jenkins;
 
+namespace
+{
+/**
+ * @brief sharedCaches Registry of the cache per working directory, so several tabs pointing at the same repository
+ * share one GitCache instead of duplicating it. The weak references let an entry die with its last tab.
+ * @return The caches registry.
+ */
+QHash<QString, QWeakPointer<GitCache>> &sharedCaches()
+{
+   static QHash<QString, QWeakPointer<GitCache>> registry;
+
+   return registry;
+}
+
+/**
+ * @brief sharedLoaders Registry of the loader per working directory, so tabs sharing a cache also share the loader
+ * that fills it and one refresh serves all of them.
+ * @return The loaders registry.
+ */
+QHash<QString, QWeakPointer<GitRepoLoader>> &sharedLoaders()
+{
+   static QHash<QString, QWeakPointer<GitRepoLoader>> registry;
+
+   return registry;
+}
+
+QSharedPointer<GitCache> acquireSharedCache(const QString &workingDir)
+{
+   if (const auto cache = sharedCaches().value(workingDir).toStrongRef())
+      return cache;
+
+   QSharedPointer<GitCache> cache(new GitCache());
+   sharedCaches().insert(workingDir, cache.toWeakRef());
+
+   return cache;
+}
+
+QSharedPointer<GitRepoLoader> acquireSharedLoader(const QSharedPointer<GitBase> &git,
+                                                  const QSharedPointer<GitCache> &cache,
+                                                  const QSharedPointer<GitQlientSettings> &settings)
+{
+   const auto workingDir = git->getWorkingDir();
+
+   if (const auto loader = sharedLoaders().value(workingDir).toStrongRef())
+      return loader;
+
+   // The loader owns its worker thread: it is stopped and destroyed when the last tab using the
+   // loader goes away.
+   const auto thread = new QThread();
+   QSharedPointer<GitRepoLoader> loader(new GitRepoLoader(git, cache, settings), [thread](GitRepoLoader *loader) {
+      thread->exit();
+      thread->wait();
+
+      delete loader;
+      delete thread;
+   });
+
+   loader->moveToThread(thread);
+   thread->start();
+
+   sharedLoaders().insert(workingDir, loader.toWeakRef());
+
+   return loader;
+}
+}
+
 GitQlientRepo::GitQlientRepo(const QSharedPointer<GitBase> &git, const QSharedPointer<GitQlientSettings> &settings,
                              QWidget *parent)
    : QFrame(parent)
-   , mGitQlientCache(new GitCache())
+   , mGitQlientCache(acquireSharedCache(git->getWorkingDir()))
    , mGitServerCache(new GitServerCache())
    , mGitBase(git)
    , mSettings(settings)
-   , mGitLoader(new GitRepoLoader(mGitBase, mGitQlientCache, mSettings))
+   , mGitLoader(acquireSharedLoader(git, mGitQlientCache, settings))
    , mHistoryWidget(new HistoryWidget(mGitQlientCache, mGitBase, mGitServerCache, mSettings))
    , mStackedLayout(new QStackedLayout())
    , mControls(new Controls(mGitQlientCache, mGitBase))
-   , mDiffWidget(new DiffWidget(mGitBase, mGitQlientCache))
-   , mBlameWidget(new BlameWidget(mGitQlientCache, mGitBase, mSettings))
-   , mMergeWidget(new MergeWidget(mGitQlientCache, mGitBase))
-   , mGitServerWidget(new GitServerWidget(mGitQlientCache, mGitBase, mGitServerCache))
-   , mJenkins(new JenkinsWidget(mGitBase))
-   , mConfigWidget(new ConfigWidget(mGitBase))
+   , mConfigWidget(new ConfigWidget(mGitQlientCache, mGitBase))
    , mAutoFetch(new QTimer())
    , mAutoFilesUpdate(new QTimer())
+   , mWipDebounce(new QTimer())
+   , mReloadDebounce(new QTimer())
+   , mRefsDebounce(new QTimer())
    , mGitTags(new GitTags(mGitBase, mGitQlientCache))
+   , mMaintenance(new GitMaintenanceScheduler(git, settings, this))
 {
    setAttribute(Qt::WA_DeleteOnClose);
 
@@ -75,22 +146,14 @@ GitQlientRepo::GitQlientRepo(const QSharedPointer<GitBase> &git, const QSharedPo
    const auto serverUrl = gitConfig->getServerUrl();
    const auto repoInfo = gitConfig->getCurrentRepoAndOwner();
 
-   mGitServerCache->init(serverUrl, repoInfo);
+   mGitServerCache->init(serverUrl, repoInfo, mGitBase->getGitDir());
 
+   // Only the history and the config views are built upfront: the rest of the big widgets are
+   // created on their first activation, so opening a repository only pays for the history view.
    mHistoryWidget->setContentsMargins(QMargins(5, 5, 5, 5));
-   mDiffWidget->setContentsMargins(QMargins(5, 5, 5, 5));
-   mBlameWidget->setContentsMargins(QMargins(5, 5, 5, 5));
-   mMergeWidget->setContentsMargins(QMargins(5, 5, 5, 5));
-   mGitServerWidget->setContentsMargins(QMargins(5, 5, 5, 5));
-   mJenkins->setContentsMargins(QMargins(5, 5, 5, 5));
    mConfigWidget->setContentsMargins(QMargins(5, 5, 5, 5));
 
    mStackedLayout->addWidget(mHistoryWidget);
-   mStackedLayout->addWidget(mDiffWidget);
-   mStackedLayout->addWidget(mBlameWidget);
-   mStackedLayout->addWidget(mMergeWidget);
-   mStackedLayout->addWidget(mGitServerWidget);
-   mStackedLayout->addWidget(mJenkins);
    mStackedLayout->addWidget(mConfigWidget);
 
    const auto mainLayout = new QVBoxLayout();
@@ -101,15 +164,29 @@ GitQlientRepo::GitQlientRepo(const QSharedPointer<GitBase> &git, const QSharedPo
 
    setLayout(mainLayout);
 
+   mProgressPanel = new OperationProgressPanel(this);
+
+   const auto paletteShortcut = new QShortcut(QKeySequence(Qt::CTRL + Qt::Key_P), this);
+   connect(paletteShortcut, &QShortcut::activated, this, &GitQlientRepo::showCommandPalette);
+
    showHistoryView();
 
    const auto fetchInterval = mSettings->localValue("AutoFetch", 5).toInt();
 
    mAutoFetch->setInterval(fetchInterval * 60 * 1000);
    mAutoFilesUpdate->setInterval(15000);
+   mWipDebounce->setSingleShot(true);
+   mWipDebounce->setInterval(300);
+   mReloadDebounce->setSingleShot(true);
+   mReloadDebounce->setInterval(200);
+   mRefsDebounce->setSingleShot(true);
+   mRefsDebounce->setInterval(500);
 
    connect(mAutoFetch, &QTimer::timeout, mControls, &Controls::fetchAll);
-   connect(mAutoFilesUpdate, &QTimer::timeout, this, &GitQlientRepo::updateUiFromWatcher);
+   connect(mAutoFilesUpdate, &QTimer::timeout, this, &GitQlientRepo::onPeriodicFilesUpdate);
+   connect(mWipDebounce, &QTimer::timeout, this, &GitQlientRepo::updateUiFromWatcher);
+   connect(mReloadDebounce, &QTimer::timeout, this, &GitQlientRepo::performReload);
+   connect(mRefsDebounce, &QTimer::timeout, this, [this]() { updateCache(true); });
 
    connect(mControls, &Controls::signalGoRepo, this, &GitQlientRepo::showHistoryView);
    connect(mControls, &Controls::signalGoBlame, this, &GitQlientRepo::showBlameView);
@@ -122,13 +199,17 @@ GitQlientRepo::GitQlientRepo(const QSharedPointer<GitBase> &git, const QSharedPo
    connect(mControls, &Controls::signalPullConflict, mControls, &Controls::activateMergeWarning);
    connect(mControls, &Controls::signalPullConflict, this, &GitQlientRepo::showWarningMerge);
    connect(mControls, &Controls::requestReload, mHistoryWidget, [this](bool) { mHistoryWidget->updateConfig(); });
+   connect(mControls, &Controls::operationStarted, this,
+           [this](const QString &id, const QString &description) { mProgressPanel->startOperation(id, description); });
+   connect(mControls, &Controls::operationFinished, this,
+           [this](const QString &id) { mProgressPanel->finishOperation(id); });
 
-   connect(mHistoryWidget, &HistoryWidget::signalAllBranchesActive, mGitLoader.data(), &GitRepoLoader::setShowAll);
    connect(mHistoryWidget, &HistoryWidget::panelsVisibilityChanged, mConfigWidget,
            &ConfigWidget::onPanelsVisibilityChanged);
-   connect(mHistoryWidget, &HistoryWidget::signalAllBranchesActive, this, &GitQlientRepo::updateCache);
    connect(mHistoryWidget, &HistoryWidget::signalUpdateCache, this, [this]() { updateCache(true); });
    connect(mHistoryWidget, &HistoryWidget::signalOpenSubmodule, this, &GitQlientRepo::signalOpenSubmodule);
+   connect(mHistoryWidget, &HistoryWidget::signalOpenWorktree, this, &GitQlientRepo::signalOpenWorktree);
+   connect(mHistoryWidget, &HistoryWidget::currentBranchChanged, this, &GitQlientRepo::currentBranchChanged);
    connect(mHistoryWidget, &HistoryWidget::requestReload, this, &GitQlientRepo::updateCache);
    connect(mHistoryWidget, &HistoryWidget::signalOpenDiff, this, &GitQlientRepo::openCommitDiff);
    connect(mHistoryWidget, &HistoryWidget::signalOpenCompareDiff, this, &GitQlientRepo::openCommitCompareDiff);
@@ -144,48 +225,46 @@ GitQlientRepo::GitQlientRepo(const QSharedPointer<GitBase> &git, const QSharedPo
    connect(mHistoryWidget, &HistoryWidget::signalPullConflict, this, &GitQlientRepo::showWarningMerge);
    connect(mHistoryWidget, &HistoryWidget::signalUpdateWip, this, &GitQlientRepo::updateWip);
    connect(mHistoryWidget, &HistoryWidget::showPrDetailedView, this, &GitQlientRepo::showGitServerPrView);
-
-   connect(mDiffWidget, &DiffWidget::signalShowFileHistory, this, &GitQlientRepo::showFileHistory);
-   connect(mDiffWidget, &DiffWidget::signalDiffEmpty, mControls, &Controls::disableDiff);
-   connect(mDiffWidget, &DiffWidget::signalDiffEmpty, this, &GitQlientRepo::showPreviousView);
-
-   connect(mBlameWidget, &BlameWidget::showFileDiff, this, &GitQlientRepo::loadFileDiff);
-   connect(mBlameWidget, &BlameWidget::signalOpenDiff, this, &GitQlientRepo::openCommitCompareDiff);
-
-   connect(mMergeWidget, &MergeWidget::signalMergeFinished, this, &GitQlientRepo::showHistoryView);
-   connect(mMergeWidget, &MergeWidget::signalMergeFinished, this, [this]() { updateCache(true); });
-   connect(mMergeWidget, &MergeWidget::signalMergeFinished, mControls, &Controls::disableMergeWarning);
+   connect(mHistoryWidget, &HistoryWidget::requestRefreshReferences, mGitLoader.data(),
+           &GitRepoLoader::refreshReferencesOnly);
 
    connect(mConfigWidget, &ConfigWidget::commitTitleMaxLenghtChanged, mHistoryWidget,
            &HistoryWidget::onCommitTitleMaxLenghtChanged);
    connect(mConfigWidget, &ConfigWidget::panelsVisibilityChaned, mHistoryWidget,
            &HistoryWidget::onPanelsVisibilityChanged);
+   // The sorting order is a presentation change, so the cached graph is permuted in memory
+   // instead of re-running the whole git log
+   connect(mConfigWidget, &ConfigWidget::reloadView, this,
+           [this]() { mGitQlientCache->resortCommits(mSettings->localValue("GraphSortingOrder", 0).toInt()); });
+   connect(mGitQlientCache.get(), &GitCache::signalCommitsResorted, this, [this]() {
+      const auto totalCommits = mGitQlientCache->commitCount();
 
-   connect(mGitServerWidget, &GitServerWidget::openDiff, this, &GitQlientRepo::openCommitDiff);
+      mHistoryWidget->onNewRevisions(totalCommits);
 
-   connect(mJenkins, &JenkinsWidget::gotoBranch, this, &GitQlientRepo::focusHistoryOnBranch);
-   connect(mJenkins, &JenkinsWidget::gotoPullRequest, this, &GitQlientRepo::focusHistoryOnPr);
+      if (mBlameWidget)
+         mBlameWidget->onNewRevisions(totalCommits);
+   });
 
    connect(mGitLoader.data(), &GitRepoLoader::signalLoadingStarted, this, &GitQlientRepo::createProgressDialog);
    connect(mGitLoader.data(), &GitRepoLoader::signalLoadingFinished, this, &GitQlientRepo::onRepoLoadFinished);
+   connect(mGitLoader.data(), &GitRepoLoader::referencesReloaded, this,
+           [this]() { mHistoryWidget->loadBranches(true); });
+   connect(mGitLoader.data(), &GitRepoLoader::wipReloaded, this,
+           [this]() { mHistoryWidget->updateUiFromWatcher(); });
 
-   m_loaderThread = new QThread();
-   mGitLoader->moveToThread(m_loaderThread);
    connect(this, SIGNAL(signalLoadRepo(bool)), mGitLoader.data(), SLOT(load(bool)));
-   m_loaderThread->start();
-
-   mGitLoader->setShowAll(mSettings->localValue("ShowAllBranches", true).toBool());
+   connect(this, SIGNAL(signalRefreshWip()), mGitLoader.data(), SLOT(refreshWipOnly()));
 }
 
 GitQlientRepo::~GitQlientRepo()
 {
    delete mAutoFetch;
    delete mAutoFilesUpdate;
+   delete mWipDebounce;
+   delete mReloadDebounce;
+   delete mRefsDebounce;
    delete mGitWatcher;
-
-   m_loaderThread->exit();
-   m_loaderThread->wait();
-   delete m_loaderThread;
+   delete mRefsWatcher;
 }
 
 QString GitQlientRepo::currentBranch() const
@@ -195,6 +274,21 @@ QString GitQlientRepo::currentBranch() const
 
 void GitQlientRepo::updateCache(bool full)
 {
+   // Burst operations (i.e. deleting several branches in a row) request several reloads: they are
+   // coalesced into a single one that keeps the widest requested scope.
+   mPendingFullReload |= full;
+   mReloadRequested = true;
+
+   if (!mSuspended)
+      mReloadDebounce->start();
+}
+
+void GitQlientRepo::performReload()
+{
+   const auto full = mPendingFullReload;
+   mPendingFullReload = false;
+   mReloadRequested = false;
+
    if (!mCurrentDir.isEmpty())
    {
       QLog_Debug("UI", QString("Updating the GitQlient UI"));
@@ -204,7 +298,8 @@ void GitQlientRepo::updateCache(bool full)
       if (full)
          emit currentBranchChanged();
 
-      mDiffWidget->reload();
+      if (mDiffWidget)
+         mDiffWidget->reload();
    }
 }
 
@@ -212,12 +307,92 @@ void GitQlientRepo::updateUiFromWatcher()
 {
    QLog_Info("UI", QString("Updating the GitQlient UI from watcher"));
 
+   const QStringList dirtyDirs = mDirtyWatcherDirs.values();
+   mDirtyWatcherDirs.clear();
+
    QScopedPointer<GitWip> git(new GitWip(mGitBase, mGitQlientCache));
-   git->updateWip();
+   git->updateWip(dirtyDirs);
 
    mHistoryWidget->updateUiFromWatcher();
 
-   mDiffWidget->reload();
+   if (mDiffWidget)
+      mDiffWidget->reload();
+}
+
+void GitQlientRepo::onWatcherPathChanged(const QString &path)
+{
+   if (path.endsWith(".autosave") || path.endsWith(".tmp") || path.endsWith(".user"))
+      return;
+
+   mDirtyWatcherDirs.insert(path);
+
+   // Directories created after the watcher was installed are added on the fly, since the change
+   // in their parent directory is the only event they ever produce.
+   const auto watched = mGitWatcher->directories();
+
+   QDirIterator it(path, QDir::Dirs | QDir::NoDotAndDotDot);
+   while (it.hasNext())
+   {
+      if (const auto dir = it.next(); !watched.contains(dir))
+      {
+         mGitWatcher->addPath(dir);
+         mDirtyWatcherDirs.insert(dir);
+      }
+   }
+
+   // While suspended the dirty directories keep accumulating and are served by the catch-up
+   // refresh on activation
+   if (!mSuspended)
+      mWipDebounce->start();
+}
+
+void GitQlientRepo::onPeriodicFilesUpdate()
+{
+   // The filesystem watcher reports changes within milliseconds, so the periodic pass only acts
+   // as a fallback for trees where the watcher could not be installed (i.e. inotify limits).
+   if (mGitWatcher && !mGitWatcher->directories().isEmpty())
+      return;
+
+   updateUiFromWatcher();
+}
+
+void GitQlientRepo::suspendBackgroundTasks()
+{
+   if (mSuspended)
+      return;
+
+   mSuspended = true;
+   mSuspendedAt = QDateTime::currentMSecsSinceEpoch();
+
+   mAutoFetchWasActive = mAutoFetch->isActive();
+   mAutoFilesWasActive = mAutoFilesUpdate->isActive();
+
+   mAutoFetch->stop();
+   mAutoFilesUpdate->stop();
+   mWipDebounce->stop();
+   mReloadDebounce->stop();
+}
+
+void GitQlientRepo::resumeBackgroundTasks()
+{
+   if (!mSuspended)
+      return;
+
+   mSuspended = false;
+
+   if (mAutoFetchWasActive)
+      mAutoFetch->start();
+
+   if (mAutoFilesWasActive)
+      mAutoFilesUpdate->start();
+
+   const auto hiddenFor = QDateTime::currentMSecsSinceEpoch() - mSuspendedAt;
+
+   // Everything missed while the tab was hidden collapses into a single catch-up pass
+   if (mReloadRequested)
+      mReloadDebounce->start();
+   else if (!mDirtyWatcherDirs.isEmpty() || (mAutoFilesWasActive && hiddenFor >= mAutoFilesUpdate->interval()))
+      updateUiFromWatcher();
 }
 
 void GitQlientRepo::setRepository(const QString &newDir)
@@ -226,8 +401,8 @@ void GitQlientRepo::setRepository(const QString &newDir)
    {
       QLog_Info("UI", QString("Loading repository at {%1}...").arg(newDir));
 
-      mGitLoader->cancelAll();
-
+      // A load in flight doesn't need to be cancelled: the loader queues this request and serves
+      // it right after, and the loader may be shared with another tab of the same repository.
       emit signalLoadRepo(true);
 
       mCurrentDir = newDir;
@@ -251,6 +426,7 @@ void GitQlientRepo::setWatcher()
       if (!path.endsWith(".autosave") && !path.endsWith(".tmp") && !path.endsWith(".user"))
          updateUiFromWatcher();
    });
+   connect(mGitWatcher, &QFileSystemWatcher::directoryChanged, this, &GitQlientRepo::onWatcherPathChanged);
 
    QLog_Info("UI", QString("Setting the file watcher for dir {%1}").arg(mCurrentDir));
 
@@ -279,12 +455,57 @@ void GitQlientRepo::setWatcher()
    }
 }
 
+void GitQlientRepo::setRefsWatcher()
+{
+   mRefsWatcher = new QFileSystemWatcher(this);
+
+   connect(mRefsWatcher, &QFileSystemWatcher::fileChanged, this, &GitQlientRepo::onRefsChanged);
+   connect(mRefsWatcher, &QFileSystemWatcher::directoryChanged, this, &GitQlientRepo::onRefsChanged);
+
+   QLog_Info("UI", QString("Setting the refs watcher for dir {%1}").arg(mGitBase->getGitDir()));
+
+   armRefsWatcher();
+}
+
+void GitQlientRepo::armRefsWatcher()
+{
+   const auto gitDir = mGitBase->getGitDir();
+
+   QStringList paths { gitDir + "/HEAD", gitDir + "/refs" };
+
+   if (QFile::exists(gitDir + "/packed-refs"))
+      paths.append(gitDir + "/packed-refs");
+
+   QDirIterator it(gitDir + "/refs", QDir::Dirs | QDir::NoDotAndDotDot, QDirIterator::Subdirectories);
+   while (it.hasNext())
+      paths.append(it.next());
+
+   const auto watched = mRefsWatcher->files() + mRefsWatcher->directories();
+
+   for (const auto &path : qAsConst(paths))
+   {
+      if (!watched.contains(path))
+         mRefsWatcher->addPath(path);
+   }
+}
+
+void GitQlientRepo::onRefsChanged()
+{
+   // Git updates HEAD and the ref files by renaming a lock file over them, so the watch is
+   // re-armed right away while the reload itself is debounced to swallow ref bursts
+   armRefsWatcher();
+
+   mRefsDebounce->start();
+}
+
 void GitQlientRepo::clearWindow()
 {
    blockSignals(true);
 
    mHistoryWidget->clear();
-   mDiffWidget->clear();
+
+   if (mDiffWidget)
+      mDiffWidget->clear();
 
    blockSignals(false);
 }
@@ -293,30 +514,26 @@ void GitQlientRepo::setWidgetsEnabled(bool enabled)
 {
    mControls->enableButtons(enabled);
    mHistoryWidget->setEnabled(enabled);
-   mDiffWidget->setEnabled(enabled);
+
+   if (mDiffWidget)
+      mDiffWidget->setEnabled(enabled);
 }
 
 void GitQlientRepo::showFileHistory(const QString &fileName)
 {
-   mBlameWidget->showFileHistory(fileName);
+   blameWidget()->showFileHistory(fileName);
 
    showBlameView();
 }
 
 void GitQlientRepo::createProgressDialog()
 {
-   if (!mWaitDlg)
-   {
-      mWaitDlg = new WaitingDlg(tr("Loading repository..."));
-      mWaitDlg->setWindowFlag(Qt::Tool);
-      mWaitDlg->exec();
-
-      QApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
-   }
+   mProgressPanel->startOperation(QStringLiteral("load"), tr("Loading repository..."));
 }
 
 void GitQlientRepo::onRepoLoadFinished(bool fullReload)
 {
+   // Served from the per-URL cache after the first listing; only fetch flows renew it
    mGitTags->getRemoteTags();
 
    if (!mIsInit)
@@ -330,12 +547,17 @@ void GitQlientRepo::onRepoLoadFinished(bool fullReload)
       setWidgetsEnabled(true);
 
       setWatcher();
+      setRefsWatcher();
 
-      mBlameWidget->init(mCurrentDir);
+      if (mBlameWidget)
+         mBlameWidget->init(mCurrentDir);
 
       mControls->enableButtons(true);
 
-      mAutoFilesUpdate->start();
+      if (!mSuspended)
+         mAutoFilesUpdate->start();
+      else
+         mAutoFilesWasActive = true;
 
       QScopedPointer<GitConfig> git(new GitConfig(mGitBase));
 
@@ -358,10 +580,11 @@ void GitQlientRepo::onRepoLoadFinished(bool fullReload)
    mHistoryWidget->loadBranches(fullReload);
 
    mHistoryWidget->onNewRevisions(totalCommits);
-   mBlameWidget->onNewRevisions(totalCommits);
 
-   if (mWaitDlg)
-      mWaitDlg->close();
+   if (mBlameWidget)
+      mBlameWidget->onNewRevisions(totalCommits);
+
+   mProgressPanel->finishOperation(QStringLiteral("load"));
 
    if (QScopedPointer<GitMerge> gitMerge(new GitMerge(mGitBase, mGitQlientCache)); gitMerge->isInMerge())
    {
@@ -387,7 +610,7 @@ void GitQlientRepo::onRepoLoadFinished(bool fullReload)
 void GitQlientRepo::loadFileDiff(const QString &currentSha, const QString &previousSha, const QString &file,
                                  bool isCached)
 {
-   const auto loaded = mDiffWidget->loadFileDiff(currentSha, previousSha, file, isCached);
+   const auto loaded = diffWidget()->loadFileDiff(currentSha, previousSha, file, isCached);
 
    if (loaded)
    {
@@ -396,6 +619,93 @@ void GitQlientRepo::loadFileDiff(const QString &currentSha, const QString &previ
    }
 }
 
+DiffWidget *GitQlientRepo::diffWidget()
+{
+   if (!mDiffWidget)
+   {
+      mDiffWidget = new DiffWidget(mGitBase, mGitQlientCache);
+      mDiffWidget->setContentsMargins(QMargins(5, 5, 5, 5));
+      mStackedLayout->addWidget(mDiffWidget);
+
+      connect(mDiffWidget, &DiffWidget::signalShowFileHistory, this, &GitQlientRepo::showFileHistory);
+      connect(mDiffWidget, &DiffWidget::signalDiffEmpty, mControls, &Controls::disableDiff);
+      connect(mDiffWidget, &DiffWidget::signalDiffEmpty, this, &GitQlientRepo::showPreviousView);
+      connect(mDiffWidget, &DiffWidget::commitDiffLoaded, this, [this]() {
+         mControls->enableDiff();
+         showDiffView();
+      });
+   }
+
+   return mDiffWidget;
+}
+
+BlameWidget *GitQlientRepo::blameWidget()
+{
+   if (!mBlameWidget)
+   {
+      mBlameWidget = new BlameWidget(mGitQlientCache, mGitBase, mSettings);
+      mBlameWidget->setContentsMargins(QMargins(5, 5, 5, 5));
+      mStackedLayout->addWidget(mBlameWidget);
+
+      connect(mBlameWidget, &BlameWidget::showFileDiff, this, &GitQlientRepo::loadFileDiff);
+      connect(mBlameWidget, &BlameWidget::signalOpenDiff, this, &GitQlientRepo::openCommitCompareDiff);
+
+      // The widget missed the load notifications while it didn't exist, so it catches up here.
+      if (mIsInit)
+      {
+         mBlameWidget->init(mCurrentDir);
+         mBlameWidget->onNewRevisions(mGitQlientCache->commitCount());
+      }
+   }
+
+   return mBlameWidget;
+}
+
+MergeWidget *GitQlientRepo::mergeWidget()
+{
+   if (!mMergeWidget)
+   {
+      mMergeWidget = new MergeWidget(mGitQlientCache, mGitBase);
+      mMergeWidget->setContentsMargins(QMargins(5, 5, 5, 5));
+      mStackedLayout->addWidget(mMergeWidget);
+
+      connect(mMergeWidget, &MergeWidget::signalMergeFinished, this, &GitQlientRepo::showHistoryView);
+      connect(mMergeWidget, &MergeWidget::signalMergeFinished, this, [this]() { updateCache(true); });
+      connect(mMergeWidget, &MergeWidget::signalMergeFinished, mControls, &Controls::disableMergeWarning);
+   }
+
+   return mMergeWidget;
+}
+
+GitServerWidget *GitQlientRepo::gitServerWidget()
+{
+   if (!mGitServerWidget)
+   {
+      mGitServerWidget = new GitServerWidget(mGitQlientCache, mGitBase, mGitServerCache);
+      mGitServerWidget->setContentsMargins(QMargins(5, 5, 5, 5));
+      mStackedLayout->addWidget(mGitServerWidget);
+
+      connect(mGitServerWidget, &GitServerWidget::openDiff, this, &GitQlientRepo::openCommitDiff);
+   }
+
+   return mGitServerWidget;
+}
+
+JenkinsWidget *GitQlientRepo::jenkinsWidget()
+{
+   if (!mJenkins)
+   {
+      mJenkins = new JenkinsWidget(mGitBase);
+      mJenkins->setContentsMargins(QMargins(5, 5, 5, 5));
+      mStackedLayout->addWidget(mJenkins);
+
+      connect(mJenkins, &JenkinsWidget::gotoBranch, this, &GitQlientRepo::focusHistoryOnBranch);
+      connect(mJenkins, &JenkinsWidget::gotoPullRequest, this, &GitQlientRepo::focusHistoryOnPr);
+   }
+
+   return mJenkins;
+}
+
 void GitQlientRepo::showHistoryView()
 {
    mPreviousView = qMakePair(mControls->getCurrentSelectedButton(), mStackedLayout->currentWidget());
@@ -408,7 +718,7 @@ void GitQlientRepo::showBlameView()
 {
    mPreviousView = qMakePair(mControls->getCurrentSelectedButton(), mStackedLayout->currentWidget());
 
-   mStackedLayout->setCurrentWidget(mBlameWidget);
+   mStackedLayout->setCurrentWidget(blameWidget());
    mControls->toggleButton(ControlsMainViews::Blame);
 }
 
@@ -416,7 +726,7 @@ void GitQlientRepo::showDiffView()
 {
    mPreviousView = qMakePair(mControls->getCurrentSelectedButton(), mStackedLayout->currentWidget());
 
-   mStackedLayout->setCurrentWidget(mDiffWidget);
+   mStackedLayout->setCurrentWidget(diffWidget());
    mControls->toggleButton(ControlsMainViews::Diff);
 }
 
@@ -432,7 +742,7 @@ void GitQlientRepo::showWarningMerge()
 
    const auto file = mGitQlientCache->revisionFile(CommitInfo::ZERO_SHA, wipCommit.parent(0));
 
-   mMergeWidget->configure(file, MergeWidget::ConflictReason::Merge);
+   mergeWidget()->configure(file, MergeWidget::ConflictReason::Merge);
 }
 
 // TODO: Optimize
@@ -447,7 +757,7 @@ void GitQlientRepo::showCherryPickConflict(const QStringList &shas)
 
    const auto files = mGitQlientCache->revisionFile(CommitInfo::ZERO_SHA, wipCommit.parent(0));
 
-   mMergeWidget->configureForCherryPick(files, shas);
+   mergeWidget()->configureForCherryPick(files, shas);
 }
 
 // TODO: Optimize
@@ -462,20 +772,20 @@ void GitQlientRepo::showPullConflict()
 
    const auto files = mGitQlientCache->revisionFile(CommitInfo::ZERO_SHA, wipCommit.parent(0));
 
-   mMergeWidget->configure(files, MergeWidget::ConflictReason::Pull);
+   mergeWidget()->configure(files, MergeWidget::ConflictReason::Pull);
 }
 
 void GitQlientRepo::showMergeView()
 {
-   mStackedLayout->setCurrentWidget(mMergeWidget);
+   mStackedLayout->setCurrentWidget(mergeWidget());
    mControls->toggleButton(ControlsMainViews::Merge);
 }
 
-bool GitQlientRepo::configureGitServer() const
+bool GitQlientRepo::configureGitServer()
 {
    bool isConfigured = false;
 
-   if (!mGitServerWidget->isConfigured())
+   if (!gitServerWidget()->isConfigured())
    {
       QScopedPointer<GitConfig> gitConfig(new GitConfig(mGitBase));
       const auto serverUrl = gitConfig->getServerUrl();
@@ -503,7 +813,7 @@ void GitQlientRepo::showGitServerView()
 {
    if (configureGitServer())
    {
-      mStackedLayout->setCurrentWidget(mGitServerWidget);
+      mStackedLayout->setCurrentWidget(gitServerWidget());
       mControls->toggleButton(ControlsMainViews::GitServer);
    }
    else
@@ -515,13 +825,13 @@ void GitQlientRepo::showGitServerPrView(int prNumber)
    if (configureGitServer())
    {
       showGitServerView();
-      mGitServerWidget->openPullRequest(prNumber);
+      gitServerWidget()->openPullRequest(prNumber);
    }
 }
 
 void GitQlientRepo::showBuildSystemView()
 {
-   mJenkins->reload();
+   jenkinsWidget()->reload();
    mStackedLayout->setCurrentWidget(mJenkins);
    mControls->toggleButton(ControlsMainViews::BuildSystem);
 }
@@ -542,29 +852,21 @@ void GitQlientRepo::updateWip()
 {
    mHistoryWidget->resetWip();
 
-   QScopedPointer<GitWip> git(new GitWip(mGitBase, mGitQlientCache));
-   git->updateWip();
-
-   mHistoryWidget->updateUiFromWatcher();
+   // The WIP diff runs in the loader thread; the UI refreshes when wipReloaded arrives.
+   emit signalRefreshWip();
 }
 
 void GitQlientRepo::focusHistoryOnBranch(const QString &branch)
 {
-   auto found = false;
    const auto fullBranch = QString("origin/%1").arg(branch);
-   const auto remoteBranches = mGitQlientCache->getBranches(References::Type::RemoteBranches);
+   const auto sha = mGitQlientCache->getShaOfReference(fullBranch);
 
-   for (const auto &remote : remoteBranches)
+   if (!sha.isEmpty())
    {
-      if (remote.second.contains(fullBranch))
-      {
-         found = true;
-         mHistoryWidget->focusOnCommit(remote.first);
-         showHistoryView();
-      }
+      mHistoryWidget->focusOnCommit(sha);
+      showHistoryView();
    }
-
-   if (!found)
+   else
       QMessageBox::information(
           this, tr("Branch not found"),
           tr("The branch couldn't be found. Please, make sure you fetched and have the latest changes."));
@@ -578,6 +880,21 @@ void GitQlientRepo::focusHistoryOnPr(int prNumber)
    showHistoryView();
 }
 
+void GitQlientRepo::showCommandPalette()
+{
+   if (!mCommandPalette)
+   {
+      mCommandPalette = new CommandPalette(mGitQlientCache, this);
+
+      connect(mCommandPalette, &CommandPalette::shaSelected, this, [this](const QString &sha) {
+         mHistoryWidget->focusOnCommit(sha);
+         showHistoryView();
+      });
+   }
+
+   mCommandPalette->open();
+}
+
 bool GitQlientRepo::containsSubmodule(const QString &path, const QVector<QString> &submodules)
 {
    for (const auto &submodule : submodules)
@@ -591,27 +908,14 @@ bool GitQlientRepo::containsSubmodule(const QString &path, const QVector<QString
 
 void GitQlientRepo::openCommitDiff(const QString currentSha)
 {
+   // The diff is computed asynchronously; the view switches when commitDiffLoaded arrives
    const auto rev = mGitQlientCache->commitInfo(currentSha);
-   const auto loaded = mDiffWidget->loadCommitDiff(currentSha, rev.parent(0));
-
-   if (loaded)
-   {
-      mControls->enableDiff();
-
-      showDiffView();
-   }
+   diffWidget()->loadCommitDiff(currentSha, rev.parent(0));
 }
 
 void GitQlientRepo::openCommitCompareDiff(const QStringList &shas)
 {
-   const auto loaded = mDiffWidget->loadCommitDiff(shas.last(), shas.first());
-
-   if (loaded)
-   {
-      mControls->enableDiff();
-
-      showDiffView();
-   }
+   diffWidget()->loadCommitDiff(shas.last(), shas.first());
 }
 
 void GitQlientRepo::changesCommitted(bool ok)
@@ -629,7 +933,7 @@ void GitQlientRepo::closeEvent(QCloseEvent *ce)
 {
    QLog_Info("UI", QString("Closing GitQlient for repository {%1}").arg(mCurrentDir));
 
-   mGitLoader->cancelAll();
-
+   // The loader may be shared with another tab of the same repository, so in-flight loads are left
+   // to finish; the loader and its thread are destroyed with the last tab referencing them.
    QWidget::closeEvent(ce);
 }
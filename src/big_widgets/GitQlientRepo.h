@@ -25,7 +25,7 @@
 
 #include <QFrame>
 #include <QPointer>
-#include <QThread>
+#include <QSet>
 
 class GitBase;
 class GitQlientSettings;
@@ -40,10 +40,12 @@ class DiffWidget;
 class BlameWidget;
 class MergeWidget;
 class GitServerWidget;
+class CommandPalette;
 class QTimer;
-class WaitingDlg;
+class OperationProgressPanel;
 class GitServerCache;
 class GitTags;
+class GitMaintenanceScheduler;
 class ConfigWidget;
 
 namespace Jenkins
@@ -81,12 +83,24 @@ signals:
    */
    void signalOpenSubmodule(const QString &submoduleName);
 
+   /**
+    * @brief signalOpenWorktree Signal triggered when the user wants to open a linked worktree in a new GitQlientRepo
+    * view.
+    * @param worktreePath The path of the worktree.
+    */
+   void signalOpenWorktree(const QString &worktreePath);
+
    /**
     * @brief signalLoadRepo Signal used to trigger the data update in a different thread.
     * @param full Requests a full repository refresh: includes commits and references.
     */
    void signalLoadRepo(bool full);
 
+   /**
+    * @brief signalRefreshWip Signal used to trigger a WIP-only refresh in the loader thread.
+    */
+   void signalRefreshWip();
+
    /**
     * @brief repoOpened Signal triggered when the repo was successfully opened.
     * @param repoPath The absolute path to the repository opened.
@@ -120,6 +134,13 @@ public:
    */
    QString currentDir() const { return mCurrentDir; }
 
+   /**
+    * @brief cache Gets the internal cache of the repository, shared with other views of the same
+    * working dir.
+    * @return The cache.
+    */
+   QSharedPointer<GitCache> cache() const { return mGitQlientCache; }
+
    /**
     * @brief currentBranch Gets the current branch.
     * @return QString The current branch.
@@ -133,9 +154,22 @@ public:
    */
    void setRepository(const QString &newDir);
 
+   /**
+    * @brief suspendBackgroundTasks Pauses the periodic timers of the tab while it is hidden behind
+    * another one. Watcher events keep accumulating dirty directories but no refresh work runs.
+    */
+   void suspendBackgroundTasks();
+
+   /**
+    * @brief resumeBackgroundTasks Restarts the periodic timers and performs a single coalesced
+    * catch-up refresh covering everything that happened while the tab was hidden.
+    */
+   void resumeBackgroundTasks();
+
 protected:
    /*!
-    \brief Overload of the close event cancel any pending loading.
+    \brief Overload of the close event. Pending loads are left to finish since the loader may be shared with another
+    tab of the same repository.
 
     \param ce The close event.
    */
@@ -155,30 +189,61 @@ private:
    BlameWidget *mBlameWidget = nullptr;
    MergeWidget *mMergeWidget = nullptr;
    GitServerWidget *mGitServerWidget = nullptr;
+   CommandPalette *mCommandPalette = nullptr;
    Jenkins::JenkinsWidget *mJenkins = nullptr;
    ConfigWidget *mConfigWidget = nullptr;
    QTimer *mAutoFetch = nullptr;
    QTimer *mAutoFilesUpdate = nullptr;
    QTimer *mAutoPrUpdater = nullptr;
-   QPointer<WaitingDlg> mWaitDlg;
+   OperationProgressPanel *mProgressPanel = nullptr;
    QFileSystemWatcher *mGitWatcher = nullptr;
+   QFileSystemWatcher *mRefsWatcher = nullptr;
+   QTimer *mWipDebounce = nullptr;
+   QTimer *mReloadDebounce = nullptr;
+   QTimer *mRefsDebounce = nullptr;
+   bool mPendingFullReload = false;
+   bool mReloadRequested = false;
+   bool mSuspended = false;
+   bool mAutoFetchWasActive = false;
+   bool mAutoFilesWasActive = false;
+   qint64 mSuspendedAt = 0;
+   QSet<QString> mDirtyWatcherDirs;
    QPair<ControlsMainViews, QWidget *> mPreviousView;
    QSharedPointer<GitServer::IRestApi> mApi;
    QSharedPointer<GitTags> mGitTags;
+   GitMaintenanceScheduler *mMaintenance = nullptr;
 
    bool mIsInit = false;
-   QThread *m_loaderThread;
 
    /*!
-    \brief Updates the UI cache and refreshes the subwidgets.
+    \brief Schedules a UI cache update. The requests are coalesced within a debounce window keeping the widest
+    requested scope, so burst operations end in a single reload.
 
    */
    void updateCache(bool full);
+   /*!
+    \brief Performs the reload requested through updateCache once the debounce window closes.
+
+   */
+   void performReload();
    /*!
     \brief Performs a light UI update triggered by the QFileSystemWatcher.
 
    */
    void updateUiFromWatcher();
+   /*!
+    \brief Method called when the filesystem watcher reports a change under \p path. The directory is added to the
+    dirty set and the refresh is debounced, so a burst of saves ends in a single scoped update.
+
+    \param path The directory that changed.
+   */
+   void onWatcherPathChanged(const QString &path);
+   /*!
+    \brief Method called by the periodic files update timer. It only refreshes when the filesystem watcher could not
+    be installed, since otherwise changes are already reported as they happen.
+
+   */
+   void onPeriodicFilesUpdate();
    /*!
     \brief Opens the diff view with the selected commit from the repository view.
     \param currentSha The current selected commit SHA.
@@ -201,6 +266,25 @@ private:
 
    */
    void setWatcher();
+
+   /**
+    * @brief setRefsWatcher Installs the watcher over .git/HEAD, .git/refs and .git/packed-refs, so
+    * commits and pushes done outside GitQlient show up as soon as they land instead of waiting
+    * for a periodic refresh.
+    */
+   void setRefsWatcher();
+
+   /**
+    * @brief armRefsWatcher Re-adds the watched ref paths. Git replaces HEAD and the ref files via
+    * rename, which silently drops them from the watcher after every change.
+    */
+   void armRefsWatcher();
+
+   /**
+    * @brief onRefsChanged Schedules a full scoped reload after a ref change settled.
+    */
+   void onRefsChanged();
+
    /*!
     \brief Clears the views and its subwidgets.
 
@@ -220,7 +304,7 @@ private:
    void showFileHistory(const QString &fileName);
 
    /*!
-    \brief Updates the progress dialog when loading a really huge repository.
+    \brief Shows the loading row in the progress panel when loading a really huge repository.
    */
    void createProgressDialog();
 
@@ -238,6 +322,38 @@ private:
    */
    void loadFileDiff(const QString &currentSha, const QString &previousSha, const QString &file, bool isCached);
 
+   /*!
+    \brief Gets the diff view creating it in its first use. The big widgets are built lazily so opening a repository
+    only pays for the views the user activates.
+
+    \return DiffWidget The diff view.
+   */
+   DiffWidget *diffWidget();
+   /*!
+    \brief Gets the blame & history view creating it in its first use.
+
+    \return BlameWidget The blame & history view.
+   */
+   BlameWidget *blameWidget();
+   /*!
+    \brief Gets the merge view creating it in its first use.
+
+    \return MergeWidget The merge view.
+   */
+   MergeWidget *mergeWidget();
+   /*!
+    \brief Gets the git server view creating it in its first use.
+
+    \return GitServerWidget The git server view.
+   */
+   GitServerWidget *gitServerWidget();
+   /*!
+    \brief Gets the build system view creating it in its first use.
+
+    \return JenkinsWidget The build system view.
+   */
+   Jenkins::JenkinsWidget *jenkinsWidget();
+
    /*!
     \brief Shows the history/repository view.
 
@@ -274,7 +390,7 @@ private:
    */
    void showMergeView();
 
-   bool configureGitServer() const;
+   bool configureGitServer();
 
    /**
     * @brief showGitServerView Shows the configured git server view.
@@ -319,6 +435,12 @@ private:
     */
    void focusHistoryOnPr(int prNumber);
 
+   /**
+    * @brief showCommandPalette Opens the Ctrl+P palette to jump to any branch, tag or commit by
+    * name. The palette is created on its first use.
+    */
+   void showCommandPalette();
+
    /**
     * @brief containsSubmodule Analyzes a path to see if the path is one of the submodules.
     * @param path The full path to check if submodule.
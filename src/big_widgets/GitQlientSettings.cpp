@@ -1,7 +1,120 @@
 #include "GitQlientSettings.h"
 
+#include <QCoreApplication>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QTimer>
 #include <QVector>
 
+#include <memory>
+
+namespace
+{
+QMutex kSettingsCacheMutex;
+
+// Delay before a burst of writes is flushed to disk in one pass
+constexpr auto kFlushDelayMs = 250;
+
+/**
+ * @brief settingsCache Write-through cache of the already read values keyed by scope and key, so hot paths resolve
+ * settings with a hash lookup instead of re-parsing the INI file on every call.
+ * @return The values cache.
+ */
+QHash<QString, QVariant> &settingsCache()
+{
+   static QHash<QString, QVariant> cache;
+
+   return cache;
+}
+
+QString cacheKey(const QString &scope, const QString &key)
+{
+   return QString("%1|%2").arg(scope, key);
+}
+
+/**
+ * @brief pendingWrites Values waiting to be flushed, grouped by scope (empty for the global
+ * settings, the repo path otherwise). Reads never miss them because every setter stores the value
+ * in the cache first.
+ * @return The pending writes.
+ */
+QHash<QString, QHash<QString, QVariant>> &pendingWrites()
+{
+   static QHash<QString, QHash<QString, QVariant>> pending;
+
+   return pending;
+}
+
+bool &flushScheduled()
+{
+   static auto scheduled = false;
+
+   return scheduled;
+}
+
+/**
+ * @brief flushPendingWrites Writes every queued value in one QSettings pass per scope and syncs
+ * once. QSettings serializes the INI into a temporary file and renames it over the old one, so an
+ * interrupted flush leaves the previous file intact.
+ */
+void flushPendingWrites()
+{
+   QHash<QString, QHash<QString, QVariant>> pending;
+
+   {
+      QMutexLocker lock(&kSettingsCacheMutex);
+      std::swap(pending, pendingWrites());
+      flushScheduled() = false;
+   }
+
+   for (auto scope = pending.cbegin(); scope != pending.cend(); ++scope)
+   {
+      const auto settings = scope.key().isEmpty()
+          ? std::make_unique<QSettings>()
+          : std::make_unique<QSettings>(scope.key() + "/GitQlientConfig.ini", QSettings::IniFormat);
+
+      for (auto value = scope.value().cbegin(); value != scope.value().cend(); ++value)
+         settings->setValue(value.key(), value.value());
+
+      settings->sync();
+   }
+}
+
+/**
+ * @brief scheduleWrite Queues a value and arms the flush timer. A burst of UI-state writes (tab
+ * pinning, splitter drags) collapses into a single disk write this way; a final flush at exit
+ * covers values written right before closing.
+ * @param scope The settings scope the value belongs to.
+ * @param key The key.
+ * @param value The value.
+ */
+void scheduleWrite(const QString &scope, const QString &key, const QVariant &value)
+{
+   auto schedule = false;
+
+   {
+      QMutexLocker lock(&kSettingsCacheMutex);
+      pendingWrites()[scope].insert(key, value);
+
+      if (!flushScheduled())
+      {
+         flushScheduled() = true;
+         schedule = true;
+
+         static const auto exitFlushRegistered = []() {
+            qAddPostRoutine(flushPendingWrites);
+            return true;
+         }();
+         Q_UNUSED(exitFlushRegistered)
+      }
+   }
+
+   if (schedule)
+      QTimer::singleShot(kFlushDelayMs, GitQlientSettings::notifier(), []() { flushPendingWrites(); });
+}
+}
+
 QString GitQlientSettings::PinnedRepos = "Config/PinnedRepos";
 QString GitQlientSettings::SplitFileDiffView = "SplitDiff";
 
@@ -10,28 +123,83 @@ GitQlientSettings::GitQlientSettings(const QString &gitRepoPath)
 {
 }
 
+GitQlientSettings *GitQlientSettings::notifier()
+{
+   static GitQlientSettings instance;
+
+   return &instance;
+}
+
 void GitQlientSettings::setGlobalValue(const QString &key, const QVariant &value)
 {
-   globalSettings.setValue(key, value);
-   globalSettings.sync();
+   {
+      QMutexLocker lock(&kSettingsCacheMutex);
+      settingsCache().insert(cacheKey(QString(), key), value);
+   }
+
+   // The value is visible through the cache right away; the disk write is batched behind a short
+   // delay so bursts cost one INI serialization
+   scheduleWrite(QString(), key, value);
+
+   emit notifier()->valueChanged(key, value);
 }
 
-QVariant GitQlientSettings::globalValue(const QString &key, const QVariant &defaultValue)
+QVariant GitQlientSettings::globalValue(const QString &key, const QVariant &defaultValue) const
 {
-   return globalSettings.value(key, defaultValue);
+   const auto compoundKey = cacheKey(QString(), key);
+
+   {
+      QMutexLocker lock(&kSettingsCacheMutex);
+
+      if (const auto iter = settingsCache().constFind(compoundKey); iter != settingsCache().constEnd())
+         return iter.value();
+   }
+
+   const auto value = globalSettings.value(key, defaultValue);
+
+   // Missing keys are not cached: a later call may provide a different default value.
+   if (globalSettings.contains(key))
+   {
+      QMutexLocker lock(&kSettingsCacheMutex);
+      settingsCache().insert(compoundKey, value);
+   }
+
+   return value;
 }
 
 void GitQlientSettings::setLocalValue(const QString &key, const QVariant &value)
 {
-   QSettings localSettings(mGitRepoPath + "/GitQlientConfig.ini", QSettings::IniFormat);
-   localSettings.setValue(key, value);
-   localSettings.sync();
+   {
+      QMutexLocker lock(&kSettingsCacheMutex);
+      settingsCache().insert(cacheKey(mGitRepoPath, key), value);
+   }
+
+   scheduleWrite(mGitRepoPath, key, value);
+
+   emit notifier()->localValueChanged(mGitRepoPath, key, value);
 }
 
 QVariant GitQlientSettings::localValue(const QString &key, const QVariant &defaultValue)
 {
+   const auto compoundKey = cacheKey(mGitRepoPath, key);
+
+   {
+      QMutexLocker lock(&kSettingsCacheMutex);
+
+      if (const auto iter = settingsCache().constFind(compoundKey); iter != settingsCache().constEnd())
+         return iter.value();
+   }
+
    QSettings localSettings(mGitRepoPath + "/GitQlientConfig.ini", QSettings::IniFormat);
-   return localSettings.value(key, defaultValue);
+   const auto value = localSettings.value(key, defaultValue);
+
+   if (localSettings.contains(key))
+   {
+      QMutexLocker lock(&kSettingsCacheMutex);
+      settingsCache().insert(compoundKey, value);
+   }
+
+   return value;
 }
 
 void GitQlientSettings::setProjectOpened(const QString &projectPath)
@@ -43,7 +211,7 @@ void GitQlientSettings::setProjectOpened(const QString &projectPath)
 
 QStringList GitQlientSettings::getRecentProjects() const
 {
-   auto projects = globalSettings.value("Config/RecentProjects", QStringList()).toStringList();
+   auto projects = globalValue("Config/RecentProjects", QStringList()).toStringList();
 
    QStringList recentProjects;
    const auto end = std::min(projects.count(), 5);
@@ -56,7 +224,7 @@ QStringList GitQlientSettings::getRecentProjects() const
 
 void GitQlientSettings::saveRecentProjects(const QString &projectPath)
 {
-   auto usedProjects = globalSettings.value("Config/RecentProjects", QStringList()).toStringList();
+   auto usedProjects = globalValue("Config/RecentProjects", QStringList()).toStringList();
 
    if (usedProjects.contains(projectPath))
    {
@@ -75,12 +243,17 @@ void GitQlientSettings::saveRecentProjects(const QString &projectPath)
 void GitQlientSettings::clearRecentProjects()
 {
    globalSettings.remove("Config/RecentProjects");
+
+   QMutexLocker lock(&kSettingsCacheMutex);
+   settingsCache().remove(cacheKey(QString(), "Config/RecentProjects"));
+   // A queued write would resurrect the key on the next flush
+   pendingWrites()[QString()].remove("Config/RecentProjects");
 }
 
 void GitQlientSettings::saveMostUsedProjects(const QString &projectPath)
 {
-   auto projects = globalSettings.value("Config/UsedProjects", QStringList()).toStringList();
-   auto timesUsed = globalSettings.value("Config/UsedProjectsCount", QList<QVariant>()).toList();
+   auto projects = globalValue("Config/UsedProjects", QStringList()).toStringList();
+   auto timesUsed = globalValue("Config/UsedProjectsCount", QList<QVariant>()).toList();
 
    if (projects.contains(projectPath))
    {
@@ -101,12 +274,18 @@ void GitQlientSettings::clearMostUsedProjects()
 {
    globalSettings.remove("Config/UsedProjects");
    globalSettings.remove("Config/UsedProjectsCount");
+
+   QMutexLocker lock(&kSettingsCacheMutex);
+   settingsCache().remove(cacheKey(QString(), "Config/UsedProjects"));
+   settingsCache().remove(cacheKey(QString(), "Config/UsedProjectsCount"));
+   pendingWrites()[QString()].remove("Config/UsedProjects");
+   pendingWrites()[QString()].remove("Config/UsedProjectsCount");
 }
 
 QStringList GitQlientSettings::getMostUsedProjects() const
 {
-   const auto projects = globalSettings.value("Config/UsedProjects", QStringList()).toStringList();
-   const auto timesUsed = globalSettings.value("Config/UsedProjectsCount", QString()).toList();
+   const auto projects = globalValue("Config/UsedProjects", QStringList()).toStringList();
+   const auto timesUsed = globalValue("Config/UsedProjectsCount", QString()).toList();
 
    QMultiMap<int, QString> projectOrderedByUse;
 
@@ -23,6 +23,7 @@
  ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
  ***************************************************************************************/
 
+#include <QObject>
 #include <QSettings>
 #include <QVector>
 
@@ -31,8 +32,26 @@
  parameter is modified by triggering a signal to notify the UI.
 
 */
-class GitQlientSettings
+class GitQlientSettings : public QObject
 {
+   Q_OBJECT
+
+signals:
+   /**
+    * @brief valueChanged Signal triggered through the notifier instance whenever a global value is stored.
+    * @param key The key that changed.
+    * @param value The new value.
+    */
+   void valueChanged(const QString &key, const QVariant &value);
+
+   /**
+    * @brief localValueChanged Signal triggered through the notifier instance whenever a repository value is stored.
+    * @param gitRepoPath The repository the value belongs to.
+    * @param key The key that changed.
+    * @param value The new value.
+    */
+   void localValueChanged(const QString &gitRepoPath, const QString &key, const QVariant &value);
+
 public:
    /*!
     \brief Default constructor.
@@ -42,6 +61,13 @@ public:
    GitQlientSettings(const QString &gitRepoPath);
    ~GitQlientSettings() { }
 
+   /**
+    * @brief notifier Shared instance that emits the change signals for every stored value, so UI components can
+    * subscribe to settings changes instead of re-reading values per event.
+    * @return The notifier instance.
+    */
+   static GitQlientSettings *notifier();
+
    /*!
     \brief Sets a value for a given \p key.
 
@@ -55,7 +81,7 @@ public:
     * @param key The key.
     * @param defaultValue (optional) A default value in case the key doesn't exist.
     */
-   QVariant globalValue(const QString &key, const QVariant &defaultValue = QVariant());
+   QVariant globalValue(const QString &key, const QVariant &defaultValue = QVariant()) const;
 
    /**
     * @brief setLocalValue Sets a value for a given @p repo with a @p key and @p value.
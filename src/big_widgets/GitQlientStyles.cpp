@@ -4,6 +4,23 @@
 #include <GitQlientSettings.h>
 
 #include <QFile>
+#include <QHash>
+
+namespace
+{
+/**
+ * @brief composedStylesCache Cache of the composed stylesheet per color schema. The stylesheet is applied by every
+ * dialog and message box, so composing it once per schema avoids re-reading the resource files on each call. The
+ * resources are immutable, hence the entries never go stale.
+ * @return The stylesheet cache.
+ */
+QHash<QString, QString> &composedStylesCache()
+{
+   static QHash<QString, QString> cache;
+
+   return cache;
+}
+}
 
 GitQlientStyles *GitQlientStyles::INSTANCE = nullptr;
 
@@ -17,12 +34,16 @@ GitQlientStyles *GitQlientStyles::getInstance()
 
 QString GitQlientStyles::getStyles()
 {
+   const auto colorSchema = GitQlientSettings().globalValue("colorSchema", "dark").toString();
+
+   if (const auto iter = composedStylesCache().constFind(colorSchema); iter != composedStylesCache().constEnd())
+      return iter.value();
+
    QString styles;
    QFile stylesFile(":/stylesheet");
 
    if (stylesFile.open(QIODevice::ReadOnly))
    {
-      const auto colorSchema = GitQlientSettings().globalValue("colorSchema", "dark").toString();
       QFile colorsFile(QString(":/colors_%1").arg(colorSchema));
       QString colorsCss;
 
@@ -35,6 +56,8 @@ QString GitQlientStyles::getStyles()
       styles = stylesFile.readAll() + colorsCss;
 
       stylesFile.close();
+
+      composedStylesCache().insert(colorSchema, styles);
    }
 
    return styles;
@@ -64,6 +64,14 @@ void GitServerWidget::openPullRequest(int prNumber)
    mDetailedView->loadData(IssueDetailedView::Config::PullRequests, prNumber);
 }
 
+void GitServerWidget::showEvent(QShowEvent *event)
+{
+   if (const auto api = mGitServerCache->getApi())
+      api->warmUpConnection();
+
+   QFrame::showEvent(event);
+}
+
 void GitServerWidget::createWidget()
 {
    const auto prLabel = QString::fromUtf8(
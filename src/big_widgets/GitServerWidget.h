@@ -73,6 +73,13 @@ public:
     */
    void openPullRequest(int prNumber);
 
+protected:
+   /**
+    * @brief showEvent Pre-warms the connection to the server endpoint, so the refresh burst the
+    * view triggers shares an already established TLS session.
+    */
+   void showEvent(QShowEvent *event) override;
+
 private:
    QSharedPointer<GitCache> mCache;
    QSharedPointer<GitBase> mGit;
@@ -23,20 +23,25 @@
 #include <GitRepoLoader.h>
 #include <GitWip.h>
 #include <RepositoryViewDelegate.h>
+#include <TaskPool.h>
 #include <WipWidget.h>
 
 #include <QLogger.h>
 
 #include <QApplication>
+#include <QBitArray>
 #include <QGridLayout>
 #include <QLabel>
 #include <QLineEdit>
 #include <QMenu>
 #include <QMessageBox>
+#include <QPointer>
 #include <QPushButton>
 #include <QScreen>
 #include <QSplitter>
 #include <QStackedWidget>
+#include <QTimer>
+#include <QtConcurrent>
 
 using namespace QLogger;
 
@@ -116,13 +121,15 @@ HistoryWidget::HistoryWidget(const QSharedPointer<GitCache> &cache, const QShare
 
    mSearchInput = new QLineEdit();
    mSearchInput->setObjectName("SearchInput");
-   mSearchInput->setPlaceholderText(tr("Press Enter to search by SHA or log message..."));
+   mSearchInput->setPlaceholderText(tr("Press Enter to search by SHA or log message. Wrap in / / for regex..."));
    connect(mSearchInput, &QLineEdit::returnPressed, this, &HistoryWidget::search);
 
    mRepositoryModel = new CommitHistoryModel(mCache, mGit, mGitServerCache);
    mRepositoryView = new CommitHistoryView(mCache, mGit, mSettings, mGitServerCache);
 
    connect(mRepositoryView, &CommitHistoryView::requestReload, this, &HistoryWidget::requestReload);
+   connect(mRepositoryView, &CommitHistoryView::requestRefreshReferences, this,
+           &HistoryWidget::requestRefreshReferences);
    connect(mRepositoryView, &CommitHistoryView::signalOpenDiff, this, [this](const QString &sha) {
       if (sha == CommitInfo::ZERO_SHA)
          showFullDiff();
@@ -151,10 +158,12 @@ HistoryWidget::HistoryWidget(const QSharedPointer<GitCache> &cache, const QShare
    mBranchesWidget = new BranchesWidget(mCache, mGit);
 
    connect(mBranchesWidget, &BranchesWidget::signalBranchesUpdated, this, &HistoryWidget::signalUpdateCache);
+   connect(mBranchesWidget, &BranchesWidget::localBranchesRemoved, this, &HistoryWidget::onLocalBranchesRemoved);
    connect(mBranchesWidget, &BranchesWidget::signalBranchCheckedOut, this, &HistoryWidget::onBranchCheckout);
    connect(mBranchesWidget, &BranchesWidget::signalSelectCommit, mRepositoryView, &CommitHistoryView::focusOnCommit);
    connect(mBranchesWidget, &BranchesWidget::signalSelectCommit, this, &HistoryWidget::goToSha);
    connect(mBranchesWidget, &BranchesWidget::signalOpenSubmodule, this, &HistoryWidget::signalOpenSubmodule);
+   connect(mBranchesWidget, &BranchesWidget::signalOpenWorktree, this, &HistoryWidget::signalOpenWorktree);
    connect(mBranchesWidget, &BranchesWidget::signalMergeRequired, this, &HistoryWidget::mergeBranch);
    connect(mBranchesWidget, &BranchesWidget::signalPullConflict, this, &HistoryWidget::signalPullConflict);
    connect(mBranchesWidget, &BranchesWidget::panelsVisibilityChanged, this, &HistoryWidget::panelsVisibilityChanged);
@@ -164,8 +173,12 @@ HistoryWidget::HistoryWidget(const QSharedPointer<GitCache> &cache, const QShare
    cherryPickBtn->setObjectName("cherryPickBtn");
    cherryPickBtn->setToolTip("Cherry-pick the commit");
    connect(cherryPickBtn, &QPushButton::clicked, this, &HistoryWidget::cherryPickCommit);
-   connect(mSearchInput, &QLineEdit::textChanged, this,
-           [cherryPickBtn](const QString &text) { cherryPickBtn->setEnabled(!text.isEmpty()); });
+   connect(mSearchInput, &QLineEdit::textChanged, this, [this, cherryPickBtn](const QString &text) {
+      cherryPickBtn->setEnabled(!text.isEmpty());
+
+      if (text.isEmpty())
+         mRepositoryView->setSearchMatches(QBitArray());
+   });
 
    mChShowAllBranches = new CheckBox(tr("Show all branches"));
    mChShowAllBranches->setChecked(mSettings->localValue("ShowAllBranches", true).toBool());
@@ -227,6 +240,13 @@ HistoryWidget::HistoryWidget(const QSharedPointer<GitCache> &cache, const QShare
 
    connect(mBranchesWidget, &BranchesWidget::minimalViewStateChanged, this, &HistoryWidget::rearrangeSplittrer);
 
+   // The prefetch is delayed so holding an arrow key only fetches the neighbours of the commit the
+   // user actually settles on
+   mDiffPrefetchTimer = new QTimer(this);
+   mDiffPrefetchTimer->setSingleShot(true);
+   mDiffPrefetchTimer->setInterval(300);
+   connect(mDiffPrefetchTimer, &QTimer::timeout, this, &HistoryWidget::prefetchAdjacentDiffs);
+
    const auto splitterSate = mSettings->localValue("HistoryWidgetState", QByteArray()).toByteArray();
 
    if (splitterSate.isEmpty())
@@ -306,10 +326,17 @@ void HistoryWidget::onNewRevisions(int totalCommits)
 {
    mRepositoryModel->onNewRevisions(totalCommits);
 
+   // A new delivery may contain commits of other branches, so the branch-only row set is rebuilt
+   if (!mChShowAllBranches->isChecked())
+      mRepositoryView->filterByCurrentBranch(true);
+
    onCommitSelected(CommitInfo::ZERO_SHA);
 
+   // The selection goes through the model of the view, which is the filter proxy once the user
+   // toggled the branch-only view at least once
+   const auto viewModel = mRepositoryView->model();
    mRepositoryView->selectionModel()->select(
-       QItemSelection(mRepositoryModel->index(0, 0), mRepositoryModel->index(0, mRepositoryModel->columnCount() - 1)),
+       QItemSelection(viewModel->index(0, 0), viewModel->index(0, viewModel->columnCount() - 1)),
        QItemSelectionModel::Select);
 }
 
@@ -384,6 +411,17 @@ void HistoryWidget::search()
 {
    if (const auto text = mSearchInput->text(); !text.isEmpty())
    {
+      // A search wrapped in slashes runs as a regular expression over the message index
+      if (text.length() > 2 && text.startsWith('/') && text.endsWith('/'))
+      {
+         searchRegex(text.mid(1, text.length() - 2));
+         return;
+      }
+
+      // Every match is resolved once per search: the view tints the matching rows and marks them
+      // in the scrollbar while find-next jumps between them
+      mRepositoryView->setSearchMatches(mCache->searchMatches(text));
+
       auto commitInfo = mCache->commitInfo(text);
 
       if (commitInfo.isValid())
@@ -410,6 +448,39 @@ void HistoryWidget::search()
    }
 }
 
+void HistoryWidget::searchRegex(const QString &pattern)
+{
+   const auto matches = mCache->searchMatchesRegex(pattern);
+
+   mRepositoryView->setSearchMatches(matches);
+
+   auto startingRow = 0;
+
+   if (auto selectedItems = mRepositoryView->selectedIndexes(); !selectedItems.isEmpty())
+   {
+      std::sort(selectedItems.begin(), selectedItems.end(),
+                [](const QModelIndex index1, const QModelIndex index2) { return index1.row() <= index2.row(); });
+      startingRow = selectedItems.constFirst().row();
+   }
+
+   // The bitset already holds every match, so find-next is a wrapped scan for the next set bit
+   const auto total = matches.count();
+   const auto step = mReverseSearch ? -1 : 1;
+
+   for (auto i = 1; i <= total; ++i)
+   {
+      const auto row = ((startingRow + i * step) % total + total) % total;
+
+      if (matches.testBit(row))
+      {
+         goToSha(mCache->commitInfo(row).sha());
+         return;
+      }
+   }
+
+   QMessageBox::information(this, tr("Not found!"), tr("No commits where found based on the search text."));
+}
+
 void HistoryWidget::goToSha(const QString &sha)
 {
    mRepositoryView->focusOnCommit(sha);
@@ -429,16 +500,52 @@ void HistoryWidget::onShowAllUpdated(bool showAll)
    GitQlientSettings settings(mGit->getGitDir());
    settings.setLocalValue("ShowAllBranches", showAll);
 
-   emit signalAllBranchesActive(showAll);
+   // The loader always streams the whole graph, so showing a single branch is a reachability
+   // filter over the cached commits and the toggle never re-runs the log pipeline
+   mRepositoryView->filterByCurrentBranch(!showAll);
+}
+
+void HistoryWidget::onLocalBranchesRemoved()
+{
+   // The deleted references are already gone from the cache; the delegate picks the new reference
+   // generation up on the next paint
+   mRepositoryView->viewport()->update();
 }
 
 void HistoryWidget::onBranchCheckout()
 {
+   const auto currentBranch = mGit->getCurrentBranch();
    QScopedPointer<GitBranches> gitBranches(new GitBranches(mGit));
-   const auto ret = gitBranches->getLastCommitOfBranch(mGit->getCurrentBranch());
+   const auto ret = gitBranches->getLastCommitOfBranch(currentBranch);
+   const auto sha = ret.output.toString().trimmed();
+
+   // A checkout leaves the DAG untouched: only HEAD, the WIP and the ancestry highlight move.
+   // Since the cache always holds every branch, when the new tip is already cached moving the
+   // branch decoration and refreshing the WIP row is enough and skips the whole log pipeline. The
+   // WIP update also marks the genealogy dirty, so the highlight is rebuilt from the in-memory
+   // graph on the next paint.
+   if (ret.success && mCache->commitInfo(sha).isValid())
+   {
+      mCache->reloadCurrentBranchInfo(currentBranch, sha);
+
+      QScopedPointer<GitWip> gitWip(new GitWip(mGit, mCache));
+      gitWip->updateWip();
+
+      // The genealogy moved with HEAD, so the branch-only row set is rebuilt as well
+      if (!mChShowAllBranches->isChecked())
+         mRepositoryView->filterByCurrentBranch(true);
+
+      mBranchesWidget->showBranches();
+      mRepositoryView->focusOnCommit(sha);
+      mRepositoryView->viewport()->update();
+
+      emit currentBranchChanged();
+
+      return;
+   }
 
    if (mChShowAllBranches->isChecked())
-      mRepositoryView->focusOnCommit(ret.output.toString());
+      mRepositoryView->focusOnCommit(sha);
 
    emit signalUpdateCache();
 }
@@ -512,7 +619,75 @@ void HistoryWidget::onCommitSelected(const QString &goToSha)
    if (isWip)
       mWipWidget->configure(CommitInfo::ZERO_SHA);
    else
+   {
       mCommitInfoWidget->configure(goToSha);
+
+      mDiffPrefetchTimer->start();
+   }
+}
+
+void HistoryWidget::prefetchAdjacentDiffs()
+{
+   if (mDiffPrefetchRunning)
+   {
+      mDiffPrefetchTimer->start();
+      return;
+   }
+
+   const auto row = mCache->commitPos(mCommitInfoWidget->getCurrentCommitSha());
+
+   if (row < 0)
+      return;
+
+   QVector<QPair<QString, QString>> pending;
+
+   for (const auto offset : { 1, -1, 2, -2, 3, -3 })
+   {
+      const auto commit = mCache->commitInfo(row + offset);
+      const auto sha = commit.sha();
+      const auto parentSha = commit.parent(0);
+
+      if (sha.isEmpty() || sha == CommitInfo::ZERO_SHA || parentSha.isEmpty())
+         continue;
+
+      if (!mCache->revisionFile(sha, parentSha).isValid())
+         pending.append(qMakePair(sha, parentSha));
+   }
+
+   if (pending.isEmpty())
+      return;
+
+   mDiffPrefetchRunning = true;
+
+   QPointer<HistoryWidget> guard(this);
+   const auto gitBase = mGit;
+
+   QtConcurrent::run(TaskPool::instance()->pool(), [guard, gitBase, pending]() {
+      QScopedPointer<GitHistory> git(new GitHistory(gitBase));
+      QVector<QPair<QPair<QString, QString>, RevisionFiles>> fetched;
+
+      for (const auto &shas : pending)
+      {
+         if (const auto ret = git->getDiffFiles(shas.first, shas.second); ret.success)
+            fetched.append(qMakePair(shas, RevisionFiles(ret.output.toString())));
+      }
+
+      if (!guard)
+         return;
+
+      QMetaObject::invokeMethod(
+          guard,
+          [guard, fetched]() {
+             if (!guard)
+                return;
+
+             for (const auto &entry : fetched)
+                guard->mCache->insertRevisionFile(entry.first.first, entry.first.second, entry.second);
+
+             guard->mDiffPrefetchRunning = false;
+          },
+          Qt::QueuedConnection);
+   });
 }
 
 void HistoryWidget::onAmendCommit(const QString &sha)
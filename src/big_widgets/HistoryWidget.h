@@ -45,6 +45,7 @@ class GitServerCache;
 class QLabel;
 class GitQlientSettings;
 class QSplitter;
+class QTimer;
 
 /*!
  \brief The HistoryWidget is responsible for showing the history of the repository. It is the first widget shown
@@ -71,6 +72,12 @@ signals:
     */
    void requestReload(bool full);
 
+   /**
+    * @brief requestRefreshReferences Signal triggered when only the references changed, so a references-only refresh
+    * is enough.
+    */
+   void requestRefreshReferences();
+
    /*!
     \brief Signal triggered when GitQlientRepo needs to update the UI for the current repo.
 
@@ -93,6 +100,11 @@ signals:
 
    */
    void signalUpdateCache();
+   /**
+    * @brief currentBranchChanged Signal triggered when a checkout completed through the fast path, so the window
+    * title refreshes without a cache reload.
+    */
+   void currentBranchChanged();
    /*!
     \brief Signal triggered when the user opens a new submodule. It is necessary to propagate this signal since is the
     GitQlient class the responsible of opening a new tab for the submodule.
@@ -100,6 +112,11 @@ signals:
     \param submodule The submodule to be opened.
    */
    void signalOpenSubmodule(const QString &submodule);
+   /**
+    * @brief signalOpenWorktree Signal triggered when a branch should be opened in its linked worktree as a new tab.
+    * @param worktreePath The path of the worktree.
+    */
+   void signalOpenWorktree(const QString &worktreePath);
    /*!
     \brief Signal triggered when the user wants to see the diff of a file between two commits.
 
@@ -121,12 +138,6 @@ signals:
     \param fileName The file name.
    */
    void signalShowFileHistory(const QString &fileName);
-   /*!
-    \brief Signal triggered when toggles the option of seeing all the branches in the repository graph view.
-
-    \param showAll True to show all the branches, false if only the current branch must be shown.
-   */
-   void signalAllBranchesActive(bool showAll);
    /*!
     \brief Signal triggered when the user performs a merge and it contains conflicts.
    */
@@ -207,6 +218,13 @@ public:
     \param goToSha The SHA to show.
    */
    void onCommitSelected(const QString &goToSha);
+   /**
+    * @brief prefetchAdjacentDiffs Speculatively fetches and parses the revision files of the commits surrounding the
+    * current selection into the cache, so walking the history with the arrow keys finds them already loaded instead
+    * of waiting for a diff-tree round trip. Runs shortly after the selection settles and only fetches the neighbours
+    * missing from the cache.
+    */
+   void prefetchAdjacentDiffs();
    /*!
     \brief Opens the AmendWidget.
 
@@ -276,12 +294,21 @@ private:
    QLabel *mUserEmail = nullptr;
    bool mReverseSearch = false;
    QSplitter *mSplitter = nullptr;
+   QTimer *mDiffPrefetchTimer = nullptr;
+   bool mDiffPrefetchRunning = false;
 
    /*!
     \brief Performs a search based on the input of the search QLineEdit with the users input.
 
    */
    void search();
+   /*!
+    \brief Performs a regex search over the commit messages with the given pattern, tinting the
+    matching rows and jumping to the next match.
+
+    \param pattern The regular expression pattern, without the wrapping slashes.
+   */
+   void searchRegex(const QString &pattern);
    /*!
     \brief Goes to the selected SHA.
 
@@ -296,12 +323,17 @@ private:
    */
    void commitSelected(const QModelIndex &index);
    /*!
-    \brief Action that stores in the settings the new value for the check box to show all the branches. It also triggers
-    the \ref signalAllBranchesActive signal.
+    \brief Action that stores in the settings the new value for the check box to show all the branches and applies the
+    branch-only filter over the cached graph, so the toggle is an instant view switch instead of a reload.
 
     \param showAll True to show all branches, false to show only the current branch.
    */
    void onShowAllUpdated(bool showAll);
+   /**
+    * @brief onLocalBranchesRemoved Repaints the graph decorations after local branches were deleted and the cache
+    * references were delta-updated, avoiding a repository reload.
+    */
+   void onLocalBranchesRemoved();
    /*!
     \brief Updates the visible widgets when a different branch to the former one is checked out.
 
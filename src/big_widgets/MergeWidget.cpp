@@ -1,15 +1,17 @@
 #include "MergeWidget.h"
 
 #include <CommitInfo.h>
+#include <ConflictMarkerIndex.h>
 #include <FileDiffWidget.h>
 #include <FileEditor.h>
 #include <GitBase.h>
 #include <GitCache.h>
 #include <GitLocal.h>
-#include <GitMerge.h>
+#include <GitOperationRunner.h>
 #include <GitQlientStyles.h>
 #include <GitRemote.h>
 #include <GitWip.h>
+#include <ProgressDlg.h>
 #include <QPinnableTabWidget.h>
 #include <RevisionFiles.h>
 
@@ -36,6 +38,7 @@ MergeWidget::MergeWidget(const QSharedPointer<GitCache> &gitQlientCache, const Q
    , mAbortBtn(new QPushButton(tr("Abort merge")))
    , mStacked(new QStackedWidget())
    , mFileDiff(new FileDiffWidget(mGit, mGitQlientCache))
+   , mConflictIndex(new ConflictMarkerIndex(this))
 {
    mCommitTitle->setObjectName("leCommitTitle");
 
@@ -111,6 +114,7 @@ MergeWidget::MergeWidget(const QSharedPointer<GitCache> &gitQlientCache, const Q
    connect(mMergedFiles, &QListWidget::itemDoubleClicked, this, &MergeWidget::changeDiffView);
    connect(mAbortBtn, &QPushButton::clicked, this, &MergeWidget::abort);
    connect(mMergeBtn, &QPushButton::clicked, this, &MergeWidget::commit);
+   connect(mConflictIndex, &ConflictMarkerIndex::indexUpdated, this, &MergeWidget::onConflictIndexUpdated);
 }
 
 void MergeWidget::configure(const RevisionFiles &files, ConflictReason reason)
@@ -160,6 +164,8 @@ void MergeWidget::configureForCherryPick(const RevisionFiles &files, const QStri
 
 void MergeWidget::fillButtonFileList(const RevisionFiles &files)
 {
+   QStringList conflictFiles;
+
    for (auto i = 0; i < files.count(); ++i)
    {
       const auto fileName = files.getFile(i);
@@ -167,8 +173,17 @@ void MergeWidget::fillButtonFileList(const RevisionFiles &files)
       const auto item = new QListWidgetItem(fileName);
       item->setData(Qt::UserRole, fileInConflict);
 
-      fileInConflict ? mConflictFiles->addItem(item) : mMergedFiles->addItem(item);
+      if (fileInConflict)
+      {
+         mConflictFiles->addItem(item);
+         conflictFiles.append(fileName);
+      }
+      else
+         mMergedFiles->addItem(item);
    }
+
+   if (!conflictFiles.isEmpty())
+      mConflictIndex->scan(mGit->getWorkingDir(), conflictFiles);
 }
 
 void MergeWidget::changeDiffView(QListWidgetItem *item)
@@ -187,83 +202,101 @@ void MergeWidget::changeDiffView(QListWidgetItem *item)
 
 void MergeWidget::abort()
 {
-   GitExecResult ret;
+   QString cmd;
 
    switch (mReason)
    {
       case ConflictReason::Pull:
-      case ConflictReason::Merge: {
-         QScopedPointer<GitMerge> git(new GitMerge(mGit, mGitQlientCache));
-         ret = git->abortMerge();
+      case ConflictReason::Merge:
+         cmd = "git merge --abort";
          break;
-      }
-      case ConflictReason::CherryPick: {
-         QScopedPointer<GitLocal> git(new GitLocal(mGit));
-         ret = git->cherryPickAbort();
+      case ConflictReason::CherryPick:
+         cmd = "git cherry-pick --abort";
          break;
-      }
       default:
-         break;
+         return;
    }
 
-   if (!ret.success)
-   {
-      QMessageBox msgBox(QMessageBox::Critical, tr("Error aborting"),
-                         tr("There were problems during the aborting the merge. Please, see the detailed "
-                            "description for more information."),
-                         QMessageBox::Ok, this);
-      msgBox.setDetailedText(ret.output.toString());
-      msgBox.setStyleSheet(GitQlientStyles::getStyles());
-      msgBox.exec();
-   }
-   else
-   {
-      mPendingShas.clear();
-      removeMergeComponents();
+   runOperation(cmd, tr("Aborting..."), [this](GitExecResult ret) {
+      if (!ret.success)
+      {
+         QMessageBox msgBox(QMessageBox::Critical, tr("Error aborting"),
+                            tr("There were problems during the aborting the merge. Please, see the detailed "
+                               "description for more information."),
+                            QMessageBox::Ok, this);
+         msgBox.setDetailedText(ret.output.toString());
+         msgBox.setStyleSheet(GitQlientStyles::getStyles());
+         msgBox.exec();
+      }
+      else
+      {
+         mPendingShas.clear();
+         removeMergeComponents();
 
-      emit signalMergeFinished();
-   }
+         emit signalMergeFinished();
+      }
+   });
 }
 
 void MergeWidget::commit()
 {
-   GitExecResult ret;
+   QString cmd;
 
    switch (mReason)
    {
       case ConflictReason::Pull:
-      case ConflictReason::Merge: {
-         QScopedPointer<GitMerge> git(new GitMerge(mGit, mGitQlientCache));
-         ret = git->applyMerge();
+      case ConflictReason::Merge:
+         cmd = "git commit --no-edit";
          break;
-      }
-      case ConflictReason::CherryPick: {
-         QScopedPointer<GitLocal> git(new GitLocal(mGit));
-         ret = git->cherryPickContinue();
+      case ConflictReason::CherryPick:
+         cmd = "git cherry-pick --continue";
          break;
-      }
       default:
-         break;
+         return;
    }
 
-   if (!ret.success)
-   {
-      QMessageBox msgBox(QMessageBox::Critical, tr("Error while merging"),
-                         tr("There were problems during the merge operation. Please, see the detailed description "
-                            "for more information."),
-                         QMessageBox::Ok, this);
-      msgBox.setDetailedText(ret.output.toString());
-      msgBox.setStyleSheet(GitQlientStyles::getStyles());
-      msgBox.exec();
-   }
-   else
-   {
-      removeMergeComponents();
+   runOperation(cmd, tr("Merging..."), [this](GitExecResult ret) {
+      if (!ret.success)
+      {
+         QMessageBox msgBox(QMessageBox::Critical, tr("Error while merging"),
+                            tr("There were problems during the merge operation. Please, see the detailed description "
+                               "for more information."),
+                            QMessageBox::Ok, this);
+         msgBox.setDetailedText(ret.output.toString());
+         msgBox.setStyleSheet(GitQlientStyles::getStyles());
+         msgBox.exec();
+      }
+      else
+      {
+         removeMergeComponents();
 
-      if (!mPendingShas.isEmpty()) { }
+         if (!mPendingShas.isEmpty()) { }
 
-      emit signalMergeFinished();
-   }
+         emit signalMergeFinished();
+      }
+   });
+}
+
+void MergeWidget::runOperation(const QString &cmd, const QString &labelText,
+                               const std::function<void(GitExecResult)> &onFinished)
+{
+   // The continuation commands run asynchronously with a non-modal busy dialog so the UI stays
+   // responsive while hooks or submodule checkouts take their time
+   const auto progressDlg = new ProgressDlg(labelText, QString(), 0, false, false);
+   const auto runner = new GitOperationRunner(mGit, this);
+
+   connect(runner, &GitOperationRunner::progressChanged, progressDlg,
+           [progressDlg](int, const QString &text) { progressDlg->setLabelText(text); });
+   connect(runner, &GitOperationRunner::operationFinished, this,
+           [progressDlg, runner, onFinished](GitExecResult ret) {
+              progressDlg->close();
+              runner->deleteLater();
+
+              onFinished(ret);
+           });
+
+   progressDlg->show();
+   runner->run(cmd);
 }
 
 void MergeWidget::removeMergeComponents()
@@ -274,6 +307,7 @@ void MergeWidget::removeMergeComponents()
    mConflictFiles->clear();
    mMergedFiles->clear();
    mFileDiff->clear();
+   mConflictIndex->clear();
 }
 
 void MergeWidget::onConflictResolved(const QString &)
@@ -297,6 +331,31 @@ void MergeWidget::onConflictResolved(const QString &)
    mStacked->setCurrentIndex(0);
 }
 
+void MergeWidget::onConflictIndexUpdated()
+{
+   for (auto row = 0; row < mConflictFiles->count(); ++row)
+   {
+      const auto item = mConflictFiles->item(row);
+      const auto ranges = mConflictIndex->markerRanges(item->text());
+
+      if (ranges.isEmpty())
+      {
+         item->setForeground(GitQlientStyles::getGreen());
+         item->setToolTip(tr("No conflict markers left. Stage the file to mark it as resolved."));
+      }
+      else
+      {
+         QStringList sections;
+
+         for (const auto &range : ranges)
+            sections.append(tr("lines %1-%2").arg(range.first).arg(range.second));
+
+         item->setForeground(GitQlientStyles::getRed());
+         item->setToolTip(tr("%n conflict section(s): ", "", ranges.count()) + sections.join(", "));
+      }
+   }
+}
+
 void MergeWidget::cherryPickCommit()
 {
    auto shas = mPendingShas;
@@ -23,9 +23,14 @@
  ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
  ***************************************************************************************/
 
+#include <GitExecResult.h>
+
 #include <QFrame>
 #include <QMap>
 
+#include <functional>
+
+class ConflictMarkerIndex;
 class GitBase;
 class QVBoxLayout;
 class QPushButton;
@@ -104,6 +109,7 @@ private:
    QStackedWidget *mStacked = nullptr;
    FileDiffWidget *mFileDiff = nullptr;
    QStringList mPendingShas;
+   ConflictMarkerIndex *mConflictIndex = nullptr;
 
    /**
     * @brief Fills both lists of ConflictButton.
@@ -127,6 +133,16 @@ private:
     *
     */
    void commit();
+   /**
+    * @brief Runs the given continuation command asynchronously, showing a non-modal busy dialog until it finishes and
+    * delivering the result to the given continuation.
+    *
+    * @param cmd The git command to execute.
+    * @param labelText The text shown in the busy dialog.
+    * @param onFinished The continuation invoked with the command result.
+    */
+   void runOperation(const QString &cmd, const QString &labelText,
+                     const std::function<void(GitExecResult)> &onFinished);
    /**
     * @brief This method removes all the handmade components before closing the merge view.
     *
@@ -138,6 +154,11 @@ private:
     * @param fileName The file name of the file whose conflict is resolved.
     */
    void onConflictResolved(const QString &fileName);
+   /**
+    * @brief Refreshes the decorations of the conflict list once the background scan of the files
+    * finishes, showing in the tooltip where the conflict sections of every file are.
+    */
+   void onConflictIndexUpdated();
 
    void cherryPickCommit();
 };
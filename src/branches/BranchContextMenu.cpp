@@ -4,9 +4,12 @@
 #include <BranchDlg.h>
 #include <GitBranches.h>
 #include <GitBase.h>
+#include <GitMergeAnalyzer.h>
 #include <GitRemote.h>
+#include <GitWorktrees.h>
 
 #include <QApplication>
+#include <QDir>
 #include <QMessageBox>
 #include <QApplication>
 #include <QClipboard>
@@ -41,10 +44,27 @@ BranchContextMenu::BranchContextMenu(BranchContextMenuConfig config, QWidget *pa
            &BranchContextMenu::createCheckoutBranch);
    connect(addAction(tr("Checkout branch")), &QAction::triggered, this, &BranchContextMenu::signalCheckoutBranch);
 
+   if (mConfig.isLocal && mConfig.currentBranch != mConfig.branchSelected)
+      connect(addAction(tr("Open in a worktree")), &QAction::triggered, this, &BranchContextMenu::openWorktree);
+
    if (mConfig.currentBranch != mConfig.branchSelected)
    {
       const auto actionName = tr("Merge %1 into %2").arg(mConfig.branchSelected, mConfig.currentBranch);
-      connect(addAction(actionName), &QAction::triggered, this, &BranchContextMenu::merge);
+      const auto mergeAction = addAction(actionName);
+      connect(mergeAction, &QAction::triggered, this, &BranchContextMenu::merge);
+
+      // The dry run works on trees only and its verdicts are cached per sha pair, so the badge
+      // costs one merge-tree the first time and nothing afterwards
+      if (mConfig.mCache)
+      {
+         const auto analyzer = new GitMergeAnalyzer(mConfig.mGit, mConfig.mCache, this);
+         connect(analyzer, &GitMergeAnalyzer::verdictReady, this,
+                 [mergeAction, actionName](const QString &, const QString &, bool conflicts) {
+                    mergeAction->setText(conflicts ? tr("%1 (conflicts expected)").arg(actionName)
+                                                   : tr("%1 (no conflicts)").arg(actionName));
+                 });
+         analyzer->analyze(mConfig.currentBranch, mConfig.branchSelected);
+      }
    }
 
    addSeparator();
@@ -110,7 +130,7 @@ void BranchContextMenu::push()
 
    if (ret.output.toString().contains("has no upstream branch"))
    {
-      BranchDlg dlg({ mConfig.branchSelected, BranchDlgMode::PUSH_UPSTREAM, mConfig.mGit });
+      BranchDlg dlg({ mConfig.branchSelected, BranchDlgMode::PUSH_UPSTREAM, mConfig.mGit, mConfig.mCache });
       const auto ret = dlg.exec();
 
       if (ret == QDialog::Accepted)
@@ -156,7 +176,7 @@ void BranchContextMenu::pushForce()
 
 void BranchContextMenu::createBranch()
 {
-   BranchDlg dlg({ mConfig.branchSelected, BranchDlgMode::CREATE, mConfig.mGit });
+   BranchDlg dlg({ mConfig.branchSelected, BranchDlgMode::CREATE, mConfig.mGit, mConfig.mCache });
    const auto ret = dlg.exec();
 
    if (ret == QDialog::Accepted)
@@ -165,7 +185,7 @@ void BranchContextMenu::createBranch()
 
 void BranchContextMenu::createCheckoutBranch()
 {
-   BranchDlg dlg({ mConfig.branchSelected, BranchDlgMode::CREATE_CHECKOUT, mConfig.mGit });
+   BranchDlg dlg({ mConfig.branchSelected, BranchDlgMode::CREATE_CHECKOUT, mConfig.mGit, mConfig.mCache });
    const auto ret = dlg.exec();
 
    if (ret == QDialog::Accepted)
@@ -177,9 +197,42 @@ void BranchContextMenu::merge()
    emit signalMergeRequired(mConfig.currentBranch, mConfig.branchSelected);
 }
 
+void BranchContextMenu::openWorktree()
+{
+   QScopedPointer<GitWorktrees> git(new GitWorktrees(mConfig.mGit));
+
+   // A worktree that already holds the branch is opened as it is: the tab it lands in keeps its
+   // warm cache, so the switch is instant
+   if (const auto existing = git->worktreeOfBranch(mConfig.branchSelected); !existing.isEmpty())
+   {
+      emit signalOpenWorktree(existing);
+      return;
+   }
+
+   const auto workingDir = QDir(mConfig.mGit->getWorkingDir());
+   const auto path = QString("%1_%2").arg(workingDir.absolutePath(), QString(mConfig.branchSelected).replace('/', '_'));
+
+   QApplication::setOverrideCursor(QCursor(Qt::WaitCursor));
+   const auto ret = git->addWorktree(path, mConfig.branchSelected);
+   QApplication::restoreOverrideCursor();
+
+   if (ret.success)
+      emit signalOpenWorktree(path);
+   else
+   {
+      QMessageBox msgBox(QMessageBox::Critical, tr("Error creating the worktree"),
+                         tr("There were problems while creating the worktree. Please, see the detailed description "
+                            "for more information."),
+                         QMessageBox::Ok, this);
+      msgBox.setDetailedText(ret.output.toString());
+      msgBox.setStyleSheet(GitQlientStyles::getStyles());
+      msgBox.exec();
+   }
+}
+
 void BranchContextMenu::rename()
 {
-   BranchDlg dlg({ mConfig.branchSelected, BranchDlgMode::RENAME, mConfig.mGit });
+   BranchDlg dlg({ mConfig.branchSelected, BranchDlgMode::RENAME, mConfig.mGit, mConfig.mCache });
    const auto ret = dlg.exec();
 
    if (ret == QDialog::Accepted)
@@ -26,6 +26,7 @@
 #include <QMenu>
 
 class GitBase;
+class GitCache;
 
 /*!
  \brief The BranchContextMenuConfig contains the necessary information to initialize the BranchContextMenu. It includes
@@ -38,6 +39,7 @@ struct BranchContextMenuConfig
    QString branchSelected;
    bool isLocal;
    QSharedPointer<GitBase> mGit;
+   QSharedPointer<GitCache> mCache;
 };
 
 /*!
@@ -83,6 +85,13 @@ signals:
     */
    void signalRefreshPRsCache();
 
+   /**
+    * @brief signalOpenWorktree Signal triggered when a worktree with the selected branch is ready to be opened as a
+    * new tab.
+    * @param worktreePath The path of the worktree.
+    */
+   void signalOpenWorktree(const QString &worktreePath);
+
 public:
    /*!
     \brief Default constructor.
@@ -131,6 +140,12 @@ private:
 
    */
    void merge();
+   /**
+    * @brief openWorktree Opens the selected branch in a linked worktree. An existing worktree holding the branch is
+    * reused; otherwise one is created next to the repository. The checkout happens in the worktree, so the current
+    * working dir and its loaded history stay untouched.
+    */
+   void openWorktree();
    /*!
     \brief Renames the selected branch.
 
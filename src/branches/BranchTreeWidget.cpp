@@ -3,6 +3,7 @@
 #include <GitQlientStyles.h>
 #include <GitBranches.h>
 #include <GitBase.h>
+#include <GitCache.h>
 #include <BranchContextMenu.h>
 #include <PullDlg.h>
 #include <GitQlientBranchItemRole.h>
@@ -11,15 +12,19 @@
 
 #include <QApplication>
 #include <QMessageBox>
+#include <QTreeWidgetItemIterator>
 
 using namespace GitQlient;
 
-BranchTreeWidget::BranchTreeWidget(const QSharedPointer<GitBase> &git, QWidget *parent)
+BranchTreeWidget::BranchTreeWidget(const QSharedPointer<GitCache> &cache, const QSharedPointer<GitBase> &git,
+                                   QWidget *parent)
    : QTreeWidget(parent)
+   , mCache(cache)
    , mGit(git)
 {
    setContextMenuPolicy(Qt::CustomContextMenu);
    setAttribute(Qt::WA_DeleteOnClose);
+   setSelectionMode(QAbstractItemView::ExtendedSelection);
 
    connect(this, &BranchTreeWidget::customContextMenuRequested, this, &BranchTreeWidget::showBranchesContextMenu);
    connect(this, &BranchTreeWidget::itemClicked, this, &BranchTreeWidget::selectCommit);
@@ -71,6 +76,17 @@ int BranchTreeWidget::focusOnBranch(const QString &branch, int lastPos)
 
 void BranchTreeWidget::showBranchesContextMenu(const QPoint &pos)
 {
+   if (mLocal && selectedItems().count() > 1)
+   {
+      const auto menu = new QMenu(this);
+      const auto deleteBranches = menu->addAction(tr("Delete selected branches"));
+      connect(deleteBranches, &QAction::triggered, this, &BranchTreeWidget::deleteSelectedBranches);
+
+      menu->exec(viewport()->mapToGlobal(pos));
+
+      return;
+   }
+
    if (const auto item = itemAt(pos); item != nullptr)
    {
       auto selectedBranch = item->data(0, FullNameRole).toString();
@@ -79,13 +95,14 @@ void BranchTreeWidget::showBranchesContextMenu(const QPoint &pos)
       {
          auto currentBranch = mGit->getCurrentBranch();
 
-         const auto menu = new BranchContextMenu({ currentBranch, selectedBranch, mLocal, mGit }, this);
+         const auto menu = new BranchContextMenu({ currentBranch, selectedBranch, mLocal, mGit, mCache }, this);
          connect(menu, &BranchContextMenu::signalRefreshPRsCache, this, &BranchTreeWidget::signalRefreshPRsCache);
          connect(menu, &BranchContextMenu::signalFetchPerformed, this, &BranchTreeWidget::signalFetchPerformed);
          connect(menu, &BranchContextMenu::signalBranchesUpdated, this, &BranchTreeWidget::signalBranchesUpdated);
          connect(menu, &BranchContextMenu::signalCheckoutBranch, this, [this, item]() { checkoutBranch(item); });
          connect(menu, &BranchContextMenu::signalMergeRequired, this, &BranchTreeWidget::signalMergeRequired);
          connect(menu, &BranchContextMenu::signalPullConflict, this, &BranchTreeWidget::signalPullConflict);
+         connect(menu, &BranchContextMenu::signalOpenWorktree, this, &BranchTreeWidget::signalOpenWorktree);
 
          menu->exec(viewport()->mapToGlobal(pos));
       }
@@ -114,6 +131,14 @@ void BranchTreeWidget::showBranchesContextMenu(const QPoint &pos)
             emit signalBranchesUpdated();
       });
 
+      menu->exec(viewport()->mapToGlobal(pos));
+   }
+   else
+   {
+      const auto menu = new QMenu(this);
+      const auto selectMerged = menu->addAction(tr("Select merged branches"));
+      connect(selectMerged, &QAction::triggered, this, &BranchTreeWidget::selectMergedBranches);
+
       menu->exec(viewport()->mapToGlobal(pos));
    }
 }
@@ -192,6 +217,84 @@ void BranchTreeWidget::onSelectionChanged()
       selectCommit(selection.constFirst());
 }
 
+void BranchTreeWidget::selectMergedBranches()
+{
+   const auto currentBranch = mGit->getCurrentBranch();
+
+   // The selection is built silently so the graph does not jump to every candidate
+   blockSignals(true);
+
+   clearSelection();
+
+   for (QTreeWidgetItemIterator it(this); *it; ++it)
+   {
+      if (!(*it)->data(0, IsLeaf).toBool())
+         continue;
+
+      const auto branch = (*it)->data(0, FullNameRole).toString();
+
+      if (branch.isEmpty() || branch == currentBranch)
+         continue;
+
+      // A branch is merged when its tip belongs to the ancestry of the current branch, answered
+      // by the in-memory graph without spawning any git process
+      if (mCache->isCommitInCurrentGeneologyTree((*it)->data(0, ShaRole).toString()))
+         (*it)->setSelected(true);
+   }
+
+   blockSignals(false);
+}
+
+void BranchTreeWidget::deleteSelectedBranches()
+{
+   const auto currentBranch = mGit->getCurrentBranch();
+   QStringList branches;
+
+   const auto selection = selectedItems();
+
+   for (const auto item : selection)
+   {
+      const auto branch = item->data(0, FullNameRole).toString();
+
+      if (item->data(0, IsLeaf).toBool() && !branch.isEmpty() && branch != currentBranch)
+         branches.append(branch);
+   }
+
+   if (branches.isEmpty())
+      return;
+
+   const auto ret
+       = QMessageBox::warning(this, tr("Delete branches!"),
+                              tr("Are you sure you want to delete the %1 selected branches?").arg(branches.count()),
+                              QMessageBox::Ok, QMessageBox::Cancel);
+
+   if (ret == QMessageBox::Ok)
+   {
+      QApplication::setOverrideCursor(QCursor(Qt::WaitCursor));
+      QScopedPointer<GitBranches> git(new GitBranches(mGit));
+      const auto ret2 = git->removeLocalBranches(branches);
+      QApplication::restoreOverrideCursor();
+
+      if (ret2.success)
+      {
+         // One delta-update of the reference table replaces the per-branch full refreshes
+         for (const auto &branch : qAsConst(branches))
+            mCache->removeReference(References::Type::LocalBranch, branch);
+
+         emit localBranchesRemoved();
+      }
+      else
+      {
+         QMessageBox::critical(
+             this, tr("Delete branches failed"),
+             tr("There were some problems while deleting the branches:<br><br> %1").arg(ret2.output.toString()));
+
+         // Some of the branches may be gone already, so a full refresh resyncs the view
+         emit signalBranchesUpdated();
+      }
+   }
+}
+
 QList<QTreeWidgetItem *> BranchTreeWidget::findChildItem(const QString &text) const
 {
    QModelIndexList indexes = model()->match(model()->index(0, 0, QModelIndex()), GitQlient::FullNameRole, text, -1,
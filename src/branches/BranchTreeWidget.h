@@ -26,6 +26,7 @@
 #include <QTreeWidget>
 
 class GitBase;
+class GitCache;
 
 /*!
  \brief The BranchTreeWidget class shows all the information regarding the branches and its position respect master and
@@ -53,6 +54,11 @@ signals:
     \param sha The selected sha.
    */
    void signalSelectCommit(const QString &sha);
+   /**
+    * @brief signalOpenWorktree Signal triggered when a branch should be opened in its linked worktree as a new tab.
+    * @param worktreePath The path of the worktree.
+    */
+   void signalOpenWorktree(const QString &worktreePath);
    /*!
     \brief Signal triggered when a merge is required.
 
@@ -73,15 +79,22 @@ signals:
     * @brief signalRefreshPRsCache Signal that refreshes PRs cache.
     */
    void signalRefreshPRsCache();
+   /**
+    * @brief localBranchesRemoved Signal triggered when local branches were deleted and the cache references were
+    * already delta-updated, so only the branches panel and the graph decorations need a refresh.
+    */
+   void localBranchesRemoved();
 
 public:
    /*!
     \brief Default constructor.
 
+    \param cache The internal repository cache.
     \param git The git object to perform Git operations.
     \param parent The parent widget if needed.
    */
-   explicit BranchTreeWidget(const QSharedPointer<GitBase> &git, QWidget *parent = nullptr);
+   explicit BranchTreeWidget(const QSharedPointer<GitCache> &cache, const QSharedPointer<GitBase> &git,
+                             QWidget *parent = nullptr);
    /*!
     \brief Configures the widget to be the local branches widget.
 
@@ -98,6 +111,7 @@ public:
 
 private:
    bool mLocal = false;
+   QSharedPointer<GitCache> mCache;
    QSharedPointer<GitBase> mGit;
 
    /*!
@@ -124,5 +138,17 @@ private:
     */
    void onSelectionChanged();
 
+   /**
+    * @brief selectMergedBranches Selects all the local branches whose tip is part of the ancestry of the current
+    * branch in the in-memory graph, leaving them ready for a batched deletion.
+    */
+   void selectMergedBranches();
+
+   /**
+    * @brief deleteSelectedBranches Deletes all the selected local branches through a single git invocation and
+    * delta-updates the cached references, so no repository reload is needed.
+    */
+   void deleteSelectedBranches();
+
    QList<QTreeWidgetItem *> findChildItem(const QString &text) const;
 };
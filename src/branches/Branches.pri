@@ -16,8 +16,10 @@ HEADERS += \
     $$PWD/BranchesWidgetMinimal.h \
     $$PWD/GitQlientBranchItemRole.h \
     $$PWD/StashesContextMenu.h \
+    $$PWD/StashesModel.h \
     $$PWD/SubmodulesContextMenu.h \
-    $$PWD/TagDlg.h
+    $$PWD/TagDlg.h \
+    $$PWD/TagsModel.h
 
 SOURCES += \
     $$PWD/AddRemoteDlg.cpp \
@@ -29,5 +31,7 @@ SOURCES += \
     $$PWD/BranchesWidget.cpp \
     $$PWD/BranchesWidgetMinimal.cpp \
     $$PWD/StashesContextMenu.cpp \
+    $$PWD/StashesModel.cpp \
     $$PWD/SubmodulesContextMenu.cpp \
-    $$PWD/TagDlg.cpp
+    $$PWD/TagDlg.cpp \
+    $$PWD/TagsModel.cpp
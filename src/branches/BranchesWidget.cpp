@@ -15,17 +15,22 @@
 #include <GitSubtree.h>
 #include <GitTags.h>
 #include <StashesContextMenu.h>
+#include <StashesModel.h>
 #include <SubmodulesContextMenu.h>
+#include <TagsModel.h>
 
 #include <QApplication>
 #include <QHeaderView>
 #include <QLabel>
 #include <QLineEdit>
+#include <QListView>
 #include <QListWidget>
 #include <QMenu>
 #include <QMessageBox>
 #include <QPushButton>
 #include <QToolButton>
+#include <QTreeView>
+#include <QTreeWidgetItemIterator>
 #include <QVBoxLayout>
 
 #include <QLogger.h>
@@ -50,6 +55,30 @@ QTreeWidgetItem *getChild(QTreeWidgetItem *parent, const QString &childName)
 
    return child;
 }
+
+QTreeWidgetItem *findBranchItem(QTreeWidget *tree, const QString &fullBranchName)
+{
+   for (QTreeWidgetItemIterator iter(tree); *iter; ++iter)
+   {
+      if ((*iter)->data(0, GitQlient::IsLeaf).toBool()
+          && (*iter)->data(0, GitQlient::FullNameRole).toString() == fullBranchName)
+         return *iter;
+   }
+
+   return nullptr;
+}
+
+void removeBranchItem(QTreeWidget *tree, const QString &fullBranchName)
+{
+   auto item = findBranchItem(tree, fullBranchName);
+
+   while (item)
+   {
+      const auto parent = item->parent();
+      delete item;
+      item = parent && parent->childCount() == 0 ? parent : nullptr;
+   }
+}
 }
 
 BranchesWidget::BranchesWidget(const QSharedPointer<GitCache> &cache, const QSharedPointer<GitBase> &git,
@@ -58,10 +87,12 @@ BranchesWidget::BranchesWidget(const QSharedPointer<GitCache> &cache, const QSha
    , mCache(cache)
    , mGit(git)
    , mGitTags(new GitTags(mGit, mCache))
-   , mLocalBranchesTree(new BranchTreeWidget(mGit))
-   , mRemoteBranchesTree(new BranchTreeWidget(mGit))
-   , mTagsTree(new QTreeWidget())
-   , mStashesList(new QListWidget())
+   , mLocalBranchesTree(new BranchTreeWidget(mCache, mGit))
+   , mRemoteBranchesTree(new BranchTreeWidget(mCache, mGit))
+   , mTagsModel(new TagsModel(this))
+   , mTagsTree(new QTreeView())
+   , mStashesModel(new StashesModel(this))
+   , mStashesList(new QListView())
    , mStashesCount(new QLabel(tr("(0)")))
    , mStashesArrow(new QLabel())
    , mSubmodulesCount(new QLabel("(0)"))
@@ -93,10 +124,7 @@ BranchesWidget::BranchesWidget(const QSharedPointer<GitCache> &cache, const QSha
    const auto remoteHeader = mRemoteBranchesTree->headerItem();
    remoteHeader->setText(0, tr("Remote"));
 
-   const auto tagHeader = mTagsTree->headerItem();
-   tagHeader->setText(0, tr("Tags"));
-
-   mTagsTree->setColumnCount(1);
+   mTagsTree->setModel(mTagsModel);
    mTagsTree->setMouseTracking(true);
    mTagsTree->setItemDelegate(mTagsDelegate = new BranchesViewDelegate(true));
    mTagsTree->setContextMenuPolicy(Qt::CustomContextMenu);
@@ -122,6 +150,7 @@ BranchesWidget::BranchesWidget(const QSharedPointer<GitCache> &cache, const QSha
    stashHeaderLayout->addStretch();
    stashHeaderLayout->addWidget(mStashesArrow);
 
+   mStashesList->setModel(mStashesModel);
    mStashesList->setMouseTracking(true);
    mStashesList->setContextMenuPolicy(Qt::CustomContextMenu);
 
@@ -139,11 +168,13 @@ BranchesWidget::BranchesWidget(const QSharedPointer<GitCache> &cache, const QSha
    /* STASHES END */
 
    /* SUBMODULES START */
-   if (const auto visible = settings.localValue("SubmodulesHeader", true).toBool(); !visible)
+   mSubmodulesExpanded = settings.localValue("SubmodulesHeader", true).toBool();
+
+   if (!mSubmodulesExpanded)
    {
-      const auto icon = QIcon(!visible ? QString(":/icons/add") : QString(":/icons/remove"));
+      const auto icon = QIcon(":/icons/add");
       mSubmodulesArrow->setPixmap(icon.pixmap(QSize(15, 15)));
-      mSubmodulesList->setVisible(visible);
+      mSubmodulesList->setVisible(false);
    }
    else
       mSubmodulesArrow->setPixmap(QIcon(":/icons/remove").pixmap(QSize(15, 15)));
@@ -285,25 +316,28 @@ BranchesWidget::BranchesWidget(const QSharedPointer<GitCache> &cache, const QSha
    connect(mLocalBranchesTree, &BranchTreeWidget::signalSelectCommit, this, &BranchesWidget::signalSelectCommit);
    connect(mLocalBranchesTree, &BranchTreeWidget::signalSelectCommit, mRemoteBranchesTree,
            &BranchTreeWidget::clearSelection);
-   connect(mLocalBranchesTree, &BranchTreeWidget::signalFetchPerformed, mGitTags.data(), &GitTags::getRemoteTags);
+   connect(mLocalBranchesTree, &BranchTreeWidget::signalFetchPerformed, mGitTags.data(), &GitTags::refreshRemoteTags);
    connect(mLocalBranchesTree, &BranchTreeWidget::signalBranchesUpdated, this, &BranchesWidget::signalBranchesUpdated);
+   connect(mLocalBranchesTree, &BranchTreeWidget::localBranchesRemoved, this,
+           &BranchesWidget::onLocalBranchesRemoved);
    connect(mLocalBranchesTree, &BranchTreeWidget::signalBranchCheckedOut, this,
            &BranchesWidget::signalBranchCheckedOut);
    connect(mLocalBranchesTree, &BranchTreeWidget::signalMergeRequired, this, &BranchesWidget::signalMergeRequired);
    connect(mLocalBranchesTree, &BranchTreeWidget::signalPullConflict, this, &BranchesWidget::signalPullConflict);
+   connect(mLocalBranchesTree, &BranchTreeWidget::signalOpenWorktree, this, &BranchesWidget::signalOpenWorktree);
    connect(mRemoteBranchesTree, &BranchTreeWidget::signalSelectCommit, this, &BranchesWidget::signalSelectCommit);
    connect(mRemoteBranchesTree, &BranchTreeWidget::signalSelectCommit, mLocalBranchesTree,
            &BranchTreeWidget::clearSelection);
-   connect(mRemoteBranchesTree, &BranchTreeWidget::signalFetchPerformed, mGitTags.data(), &GitTags::getRemoteTags);
+   connect(mRemoteBranchesTree, &BranchTreeWidget::signalFetchPerformed, mGitTags.data(), &GitTags::refreshRemoteTags);
    connect(mRemoteBranchesTree, &BranchTreeWidget::signalBranchesUpdated, this, &BranchesWidget::signalBranchesUpdated);
    connect(mRemoteBranchesTree, &BranchTreeWidget::signalBranchCheckedOut, this,
            &BranchesWidget::signalBranchCheckedOut);
    connect(mRemoteBranchesTree, &BranchTreeWidget::signalMergeRequired, this, &BranchesWidget::signalMergeRequired);
 
-   connect(mTagsTree, &QTreeWidget::itemClicked, this, &BranchesWidget::onTagClicked);
-   connect(mTagsTree, &QListWidget::customContextMenuRequested, this, &BranchesWidget::showTagsContextMenu);
-   connect(mStashesList, &QListWidget::itemClicked, this, &BranchesWidget::onStashClicked);
-   connect(mStashesList, &QListWidget::customContextMenuRequested, this, &BranchesWidget::showStashesContextMenu);
+   connect(mTagsTree, &QTreeView::clicked, this, &BranchesWidget::onTagClicked);
+   connect(mTagsTree, &QTreeView::customContextMenuRequested, this, &BranchesWidget::showTagsContextMenu);
+   connect(mStashesList, &QListView::clicked, this, &BranchesWidget::onStashClicked);
+   connect(mStashesList, &QListView::customContextMenuRequested, this, &BranchesWidget::showStashesContextMenu);
    connect(mSubmodulesList, &QListWidget::customContextMenuRequested, this, &BranchesWidget::showSubmodulesContextMenu);
    connect(mSubtreeList, &QListWidget::customContextMenuRequested, this, &BranchesWidget::showSubtreesContextMenu);
    connect(stashHeaderFrame, &ClickableFrame::clicked, this, &BranchesWidget::onStashesHeaderClicked);
@@ -328,55 +362,71 @@ void BranchesWidget::showBranches()
 {
    QLog_Info("UI", QString("Loading branches data"));
 
-   clear();
-   mMinimal->clearActions();
-
    QApplication::setOverrideCursor(QCursor(Qt::WaitCursor));
 
-   auto branches = mCache->getBranches(References::Type::LocalBranch);
+   QHash<QString, QString> localBranches;
 
-   if (!branches.empty())
-   {
-      QLog_Info("UI", QString("Fetched {%1} local branches").arg(branches.count()));
-      QLog_Info("UI", QString("Processing local branches..."));
+   // The minimal view is fed from the same shared snapshots, so its menus are only rebuilt when
+   // the references changed and the snapshot instance differs from the one already shown.
+   const auto localSnapshot = mCache->getBranchesSnapshot(References::Type::LocalBranch);
+   const auto localChanged = localSnapshot != mMinimalLocalSnapshot;
 
-      for (const auto &pair : branches)
+   if (localChanged)
+      mMinimal->clearLocalMenu();
+
+   for (const auto &pair : *localSnapshot)
+   {
+      for (const auto &branch : pair.second)
       {
-         for (const auto &branch : pair.second)
+         if (!branch.contains("HEAD->"))
          {
-            if (!branch.contains("HEAD->"))
-            {
-               processLocalBranch(pair.first, branch);
+            localBranches.insert(branch, pair.first);
+
+            if (localChanged)
                mMinimal->configureLocalMenu(pair.first, branch);
-            }
          }
       }
-
-      QLog_Info("UI", QString("... local branches processed"));
    }
 
-   branches = mCache->getBranches(References::Type::RemoteBranches);
+   mMinimalLocalSnapshot = localSnapshot;
 
-   if (!branches.empty())
-   {
-      QLog_Info("UI", QString("Fetched {%1} remote branches").arg(branches.count()));
-      QLog_Info("UI", QString("Processing remote branches..."));
+   QHash<QString, QString> remoteBranches;
+
+   const auto remoteSnapshot = mCache->getBranchesSnapshot(References::Type::RemoteBranches);
+   const auto remoteChanged = remoteSnapshot != mMinimalRemoteSnapshot;
 
-      for (const auto &pair : qAsConst(branches))
+   if (remoteChanged)
+      mMinimal->clearRemoteMenu();
+
+   for (const auto &pair : *remoteSnapshot)
+   {
+      for (const auto &branch : pair.second)
       {
-         for (const auto &branch : pair.second)
+         if (!branch.contains("HEAD->"))
          {
-            if (!branch.contains("HEAD->"))
-            {
-               processRemoteBranch(pair.first, branch);
+            remoteBranches.insert(branch, pair.first);
+
+            if (remoteChanged)
                mMinimal->configureRemoteMenu(pair.first, branch);
-            }
          }
       }
-
-      QLog_Info("UI", QString("... remote branches processed"));
    }
 
+   mMinimalRemoteSnapshot = remoteSnapshot;
+
+   QLog_Info("UI",
+             QString("Processing {%1} local and {%2} remote branches...")
+                 .arg(localBranches.count())
+                 .arg(remoteBranches.count()));
+
+   syncBranchTree(mLocalBranchesTree, mShownLocalBranches, localBranches, true);
+   syncBranchTree(mRemoteBranchesTree, mShownRemoteBranches, remoteBranches, false);
+
+   mShownLocalBranches = localBranches;
+   mShownRemoteBranches = remoteBranches;
+
+   QLog_Info("UI", QString("... branches processed"));
+
    processStashes();
    processSubmodules();
    processSubtrees();
@@ -397,6 +447,73 @@ void BranchesWidget::clear()
    mLocalBranchesTree->clear();
    mRemoteBranchesTree->clear();
    blockSignals(false);
+
+   mShownLocalBranches.clear();
+   mShownRemoteBranches.clear();
+   mMinimalLocalSnapshot.reset();
+   mMinimalRemoteSnapshot.reset();
+   mTagsModel->clear();
+   mShownSubmodules.clear();
+   mSubmodulesPopulated = false;
+   mMinimal->clearActions();
+}
+
+void BranchesWidget::syncBranchTree(BranchTreeWidget *tree, const QHash<QString, QString> &shownBranches,
+                                    const QHash<QString, QString> &newBranches, bool isLocal)
+{
+   blockSignals(true);
+
+   for (auto iter = shownBranches.constBegin(); iter != shownBranches.constEnd(); ++iter)
+   {
+      if (!newBranches.contains(iter.key()))
+         removeBranchItem(tree, iter.key());
+   }
+
+   for (auto iter = newBranches.constBegin(); iter != newBranches.constEnd(); ++iter)
+   {
+      if (!shownBranches.contains(iter.key()))
+      {
+         if (isLocal)
+            processLocalBranch(iter.value(), iter.key());
+         else
+            processRemoteBranch(iter.value(), iter.key());
+      }
+      else if (const auto item = findBranchItem(tree, iter.key()))
+      {
+         item->setData(0, GitQlient::ShaRole, iter.value());
+
+         if (isLocal)
+         {
+            const auto isCurrentBranch = iter.key() == mGit->getCurrentBranch();
+            item->setData(0, GitQlient::IsCurrentBranchRole, isCurrentBranch);
+
+            auto toolTip = iter.key();
+
+            if (const auto distances = mCache->getBranchDistances(iter.key());
+                distances.aheadOrigin != 0 || distances.behindOrigin != 0)
+               toolTip.append(tr("\nAhead: %1 - Behind: %2").arg(distances.aheadOrigin).arg(distances.behindOrigin));
+
+            item->setData(0, Qt::ToolTipRole, toolTip);
+
+            if (isCurrentBranch)
+            {
+               tree->setCurrentItem(item);
+               tree->scrollTo(tree->currentIndex());
+            }
+         }
+      }
+   }
+
+   blockSignals(false);
+}
+
+void BranchesWidget::onLocalBranchesRemoved()
+{
+   // The cached references already reflect the deletion, so the panel is rebuilt from memory and
+   // the graph view only repaints its decorations
+   showBranches();
+
+   emit localBranchesRemoved();
 }
 
 void BranchesWidget::fullView()
@@ -452,6 +569,11 @@ void BranchesWidget::onPanelsVisibilityChaned()
    visible = settings.localValue("SubmodulesHeader", true).toBool();
    icon = QIcon(!visible ? QString(":/icons/add") : QString(":/icons/remove"));
    mSubmodulesArrow->setPixmap(icon.pixmap(QSize(15, 15)));
+   mSubmodulesExpanded = visible;
+
+   if (mSubmodulesExpanded)
+      populateSubmodulesList();
+
    mSubmodulesList->setVisible(visible);
 
    visible = settings.localValue("SubtreeHeader", true).toBool();
@@ -522,7 +644,14 @@ void BranchesWidget::processLocalBranch(const QString &sha, QString branch)
    item->setData(0, GitQlient::FullNameRole, fullBranchName);
    item->setData(0, GitQlient::LocalBranchRole, true);
    item->setData(0, GitQlient::ShaRole, sha);
-   item->setData(0, Qt::ToolTipRole, fullBranchName);
+
+   auto toolTip = fullBranchName;
+
+   if (const auto distances = mCache->getBranchDistances(fullBranchName);
+       distances.aheadOrigin != 0 || distances.behindOrigin != 0)
+      toolTip.append(tr("\nAhead: %1 - Behind: %2").arg(distances.aheadOrigin).arg(distances.behindOrigin));
+
+   item->setData(0, Qt::ToolTipRole, toolTip);
    item->setData(0, GitQlient::IsLeaf, true);
 
    if (isCurrentBranch)
@@ -597,112 +726,82 @@ void BranchesWidget::processRemoteBranch(const QString &sha, QString branch)
 
 void BranchesWidget::processTags()
 {
-   mTagsTree->clear();
-
    const auto localTags = mCache->getTags(References::Type::LocalTag);
-   const auto remoteTags = mCache->getTags(References::Type::RemoteTag);
-
-   for (const auto &localTag : localTags.toStdMap())
-   {
-      QTreeWidgetItem *parent = nullptr;
-      auto fullTagName = localTag.first;
-      auto folders = fullTagName.split("/");
-      auto tagName = folders.takeLast();
-
-      for (const auto &folder : qAsConst(folders))
-      {
-         QTreeWidgetItem *child = nullptr;
 
-         if (parent)
-         {
-            child = getChild(parent, folder);
-         }
-         else
-         {
-            for (auto i = 0; i < mTagsTree->topLevelItemCount(); ++i)
-            {
-               if (mTagsTree->topLevelItem(i)->text(0) == folder)
-                  child = mTagsTree->topLevelItem(i);
-            }
-         }
-
-         if (!child)
-         {
-            const auto item = parent ? new QTreeWidgetItem(parent) : new QTreeWidgetItem();
-            item->setText(0, folder);
-
-            if (!parent)
-               mTagsTree->addTopLevelItem(item);
-
-            parent = item;
-         }
-         else
-            parent = child;
-      }
+   QLog_Debug("UI", QString("Processing {%1} tags").arg(localTags.count()));
 
-      const auto item = new QTreeWidgetItem(parent);
-
-      if (!remoteTags.contains(tagName))
-      {
-         tagName += " (local)";
-         item->setData(0, LocalBranchRole, false);
-      }
-      else
-         item->setData(0, LocalBranchRole, true);
-
-      QLog_Debug("UI", QString("Adding tag {%1}").arg(tagName));
-
-      item->setChildIndicatorPolicy(QTreeWidgetItem::DontShowIndicator);
-      item->setText(0, tagName);
-      item->setData(0, GitQlient::FullNameRole, fullTagName);
-      item->setData(0, GitQlient::ShaRole, localTag.second);
-      item->setData(0, Qt::ToolTipRole, fullTagName);
-      item->setData(0, GitQlient::IsLeaf, true);
+   if (mTagsModel->setTags(localTags, mCache->getTags(References::Type::RemoteTag)))
+   {
+      mMinimal->clearTagsMenu();
 
-      mTagsTree->addTopLevelItem(item);
+      for (auto iter = localTags.cbegin(); iter != localTags.cend(); ++iter)
+         mMinimal->configureTagsMenu(iter.value(), iter.key());
    }
-
-   mTagsTree->update();
 }
 
 void BranchesWidget::processStashes()
 {
-   mStashesList->clear();
-
    QScopedPointer<GitStashes> git(new GitStashes(mGit));
    const auto stashes = git->getStashes();
 
    QLog_Info("UI", QString("Fetching {%1} stashes").arg(stashes.count()));
 
+   QVector<QPair<QString, QString>> parsedStashes;
+   parsedStashes.reserve(stashes.count());
+
+   mMinimal->clearStashesMenu();
+
    for (const auto &stash : stashes)
    {
       const auto stashId = stash.split(":").first();
       const auto stashDesc = stash.split("}: ").last();
-      const auto item = new QListWidgetItem(stashDesc);
-      item->setData(Qt::UserRole, stashId);
-      mStashesList->addItem(item);
+      parsedStashes.append(qMakePair(stashId, stashDesc));
       mMinimal->configureStashesMenu(stashId, stashDesc);
    }
 
+   mStashesModel->setStashes(parsedStashes);
    mStashesCount->setText(QString("(%1)").arg(stashes.count()));
 }
 
 void BranchesWidget::processSubmodules()
 {
-   mSubmodulesList->clear();
-
    QScopedPointer<GitSubmodules> git(new GitSubmodules(mGit));
    const auto submodules = git->getSubmodules();
 
+   if (submodules == mShownSubmodules)
+      return;
+
+   mShownSubmodules = submodules;
+   mSubmodulesPopulated = false;
+
    QLog_Info("UI", QString("Fetching {%1} submodules").arg(submodules.count()));
 
+   mMinimal->clearSubmodulesMenu();
+
    for (const auto &submodule : submodules)
-   {
-      mSubmodulesList->addItem(submodule);
       mMinimal->configureSubmodulesMenu(submodule);
-   }
 
    mSubmodulesCount->setText('(' + QString::number(submodules.count()) + ')');
+
+   // The section is usually collapsed, so only the counter and the minimal view menu are kept
+   // current; the list itself is filled when the section is expanded.
+   if (mSubmodulesExpanded)
+      populateSubmodulesList();
+   else
+      mSubmodulesList->clear();
+}
+
+void BranchesWidget::populateSubmodulesList()
+{
+   if (mSubmodulesPopulated)
+      return;
+
+   mSubmodulesList->clear();
+
+   for (const auto &submodule : qAsConst(mShownSubmodules))
+      mSubmodulesList->addItem(submodule);
+
+   mSubmodulesPopulated = true;
 }
 
 void BranchesWidget::processSubtrees()
@@ -759,16 +858,16 @@ void BranchesWidget::adjustBranchesTree(BranchTreeWidget *treeWidget)
 
 void BranchesWidget::showTagsContextMenu(const QPoint &p)
 {
-   const auto item = mTagsTree->itemAt(p);
+   const auto index = mTagsTree->indexAt(p);
 
-   if (!item)
+   if (!index.isValid())
       return;
 
-   const auto tagName = item->data(0, GitQlient::FullNameRole).toString();
+   const auto tagName = index.data(GitQlient::FullNameRole).toString();
 
    if (!tagName.isEmpty())
    {
-      const auto isRemote = item->data(0, LocalBranchRole).toBool();
+      const auto isRemote = index.data(LocalBranchRole).toBool();
       const auto menu = new QMenu(this);
       const auto removeTagAction = menu->addAction(tr("Remove tag"));
       connect(removeTagAction, &QAction::triggered, this, [this, tagName, isRemote]() {
@@ -805,7 +904,7 @@ void BranchesWidget::showStashesContextMenu(const QPoint &p)
 
    if (index.isValid())
    {
-      const auto menu = new StashesContextMenu(mGit, index.data(Qt::UserRole).toString(), this);
+      const auto menu = new StashesContextMenu(mGit, mCache, index.data(Qt::UserRole).toString(), this);
       connect(menu, &StashesContextMenu::signalUpdateView, this, &BranchesWidget::signalBranchesUpdated);
       connect(menu, &StashesContextMenu::signalContentRemoved, this, &BranchesWidget::signalBranchesUpdated);
       menu->exec(mStashesList->viewport()->mapToGlobal(p));
@@ -921,6 +1020,11 @@ void BranchesWidget::onSubmodulesHeaderClicked()
    const auto submodulesAreVisible = mSubmodulesList->isVisible();
    const auto icon = QIcon(submodulesAreVisible ? QString(":/icons/add") : QString(":/icons/remove"));
    mSubmodulesArrow->setPixmap(icon.pixmap(QSize(15, 15)));
+   mSubmodulesExpanded = !submodulesAreVisible;
+
+   if (mSubmodulesExpanded)
+      populateSubmodulesList();
+
    mSubmodulesList->setVisible(!submodulesAreVisible);
 
    GitQlientSettings settings(mGit->getGitDir());
@@ -939,15 +1043,15 @@ void BranchesWidget::onSubtreesHeaderClicked()
    emit panelsVisibilityChanged();
 }
 
-void BranchesWidget::onTagClicked(QTreeWidgetItem *item)
+void BranchesWidget::onTagClicked(const QModelIndex &index)
 {
-   if (item && item->data(0, IsLeaf).toBool())
-      emit signalSelectCommit(item->data(0, ShaRole).toString());
+   if (index.isValid() && index.data(IsLeaf).toBool())
+      emit signalSelectCommit(index.data(ShaRole).toString());
 }
 
-void BranchesWidget::onStashClicked(QListWidgetItem *item)
+void BranchesWidget::onStashClicked(const QModelIndex &index)
 {
-   onStashSelected(item->data(Qt::UserRole).toString());
+   onStashSelected(index.data(Qt::UserRole).toString());
 }
 
 void BranchesWidget::onStashSelected(const QString &stashId)
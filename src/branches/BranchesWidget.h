@@ -24,6 +24,7 @@
  ***************************************************************************************/
 
 #include <QFrame>
+#include <QHash>
 
 class BranchTreeWidget;
 class QListWidget;
@@ -35,8 +36,11 @@ class GitCache;
 class QPushButton;
 class BranchesWidgetMinimal;
 class BranchesViewDelegate;
-class QTreeWidget;
-class QTreeWidgetItem;
+class QTreeView;
+class QListView;
+class QModelIndex;
+class TagsModel;
+class StashesModel;
 
 /*!
  \brief BranchesWidget is the widget that creates the layout that contains all the widgets related with the display of
@@ -61,6 +65,11 @@ signals:
 
    */
    void signalBranchesUpdated();
+   /**
+    * @brief localBranchesRemoved Signal triggered when local branches were deleted and the cache references were
+    * already delta-updated, so the graph decorations only need a repaint instead of a repository reload.
+    */
+   void localBranchesRemoved();
    /*!
     \brief Signal triggered when a branch is checked out and requires a GitQlient UI refresh.
 
@@ -79,6 +88,12 @@ signals:
     \param submoduleName The module name.
    */
    void signalOpenSubmodule(const QString &submoduleName);
+   /**
+    * @brief signalOpenWorktree Signal triggered when a branch should be opened in its linked worktree. As with
+    * submodules, GitQlient opens the worktree as a new tab.
+    * @param worktreePath The path of the worktree.
+    */
+   void signalOpenWorktree(const QString &worktreePath);
    /*!
     \brief Signal triggered when a merge is required.
 
@@ -158,8 +173,10 @@ private:
    BranchTreeWidget *mRemoteBranchesTree = nullptr;
    BranchesViewDelegate *mRemotesDelegate = nullptr;
    BranchesViewDelegate *mTagsDelegate = nullptr;
-   QTreeWidget *mTagsTree = nullptr;
-   QListWidget *mStashesList = nullptr;
+   TagsModel *mTagsModel = nullptr;
+   QTreeView *mTagsTree = nullptr;
+   StashesModel *mStashesModel = nullptr;
+   QListView *mStashesList = nullptr;
    QLabel *mStashesCount = nullptr;
    QLabel *mStashesArrow = nullptr;
    QLabel *mSubmodulesCount = nullptr;
@@ -174,6 +191,18 @@ private:
    QString mLastSearch;
    int mLastIndex;
    BranchTreeWidget *mLastTreeSearched = nullptr;
+   QHash<QString, QString> mShownLocalBranches;
+   QHash<QString, QString> mShownRemoteBranches;
+   QSharedPointer<const QVector<QPair<QString, QStringList>>> mMinimalLocalSnapshot;
+   QSharedPointer<const QVector<QPair<QString, QStringList>>> mMinimalRemoteSnapshot;
+   QVector<QString> mShownSubmodules;
+   bool mSubmodulesExpanded = true;
+   bool mSubmodulesPopulated = false;
+
+   /**
+    * @brief onLocalBranchesRemoved Refreshes the panel from the delta-updated cache and notifies the graph view.
+    */
+   void onLocalBranchesRemoved();
 
    /**
     * @brief fullView Shows the full branches view.
@@ -192,6 +221,17 @@ private:
     \param branch The branch to be added in the tree widget.
    */
    void processLocalBranch(const QString &sha, QString branch);
+   /*!
+    \brief Updates a branches tree with the new reference set by only adding, removing or modifying the items that
+    changed, so the expansion and scroll state of the tree is kept.
+
+    \param tree The tree widget to update.
+    \param shownBranches The branches currently shown, mapping full branch name to sha.
+    \param newBranches The new set of branches, mapping full branch name to sha.
+    \param isLocal True when updating the local branches tree.
+   */
+   void syncBranchTree(BranchTreeWidget *tree, const QHash<QString, QString> &shownBranches,
+                       const QHash<QString, QString> &newBranches, bool isLocal);
    /*!
     \brief Method that for a given \p branch process all the information and creates the item that will be stored in the
     remote branches BranchTreeWidget.
@@ -200,20 +240,28 @@ private:
    */
    void processRemoteBranch(const QString &sha, QString branch);
    /*!
-    \brief Process all the tags and adds them into the QListWidget.
+    \brief Process all the tags and hands them to the TagsModel.
 
    */
    void processTags();
    /*!
-    \brief Process all the stashes and adds them into the QListWidget.
+    \brief Process all the stashes and hands them to the StashesModel.
 
    */
    void processStashes();
    /*!
-    \brief Process all the submodules and adds them into QListWidget.
+    \brief Process all the submodules, refreshing the counter and the minimal view menu. The list
+    itself is only filled while the section is expanded; a collapsed section defers that work to
+    \ref populateSubmodulesList when its header is clicked.
 
    */
    void processSubmodules();
+   /*!
+    \brief Fills the submodules list with the last processed submodules, unless it is already up
+    to date.
+
+   */
+   void populateSubmodulesList();
 
    /**
     * @brief processSubtrees Process all the subtrees and adds them into the QListWidget.
@@ -268,15 +316,15 @@ private:
    /*!
     \brief Gets the SHA for a given tag and notifies the UI that it should select it in the repository view.
 
-    \param item The tag item from the tags list.
+    \param index The tag index from the tags view.
    */
-   void onTagClicked(QTreeWidgetItem *item);
+   void onTagClicked(const QModelIndex &index);
    /*!
     \brief Gets the SHA for a given stash and notifies the UI that it should select it in the repository view.
 
-    \param item The stash item from the stashes list.
+    \param index The stash index from the stashes view.
    */
-   void onStashClicked(QListWidgetItem *item);
+   void onStashClicked(const QModelIndex &index);
 
    /**
     * @brief onStashSelected Gets the SHA for a given stash and notifies the UI that it should select it in the
@@ -150,11 +150,41 @@ void BranchesWidgetMinimal::configureSubmodulesMenu(const QString &name)
    mSubmodules->setText("   " + QString::number(mSubmodulesMenu->actions().count()));
 }
 
-void BranchesWidgetMinimal::clearActions()
+void BranchesWidgetMinimal::clearLocalMenu()
 {
    mLocalMenu->clear();
+   mLocal->setText("   0");
+}
+
+void BranchesWidgetMinimal::clearRemoteMenu()
+{
    mRemoteMenu->clear();
+   mRemote->setText("   0");
+}
+
+void BranchesWidgetMinimal::clearTagsMenu()
+{
    mTagsMenu->clear();
+   mTags->setText("   0");
+}
+
+void BranchesWidgetMinimal::clearStashesMenu()
+{
    mStashesMenu->clear();
+   mStashes->setText("   0");
+}
+
+void BranchesWidgetMinimal::clearSubmodulesMenu()
+{
    mSubmodulesMenu->clear();
+   mSubmodules->setText("   0");
+}
+
+void BranchesWidgetMinimal::clearActions()
+{
+   clearLocalMenu();
+   clearRemoteMenu();
+   clearTagsMenu();
+   clearStashesMenu();
+   clearSubmodulesMenu();
 }
@@ -26,6 +26,12 @@ public:
    void configureStashesMenu(const QString &stashId, const QString &name);
    void configureSubmodulesMenu(const QString &name);
 
+   void clearLocalMenu();
+   void clearRemoteMenu();
+   void clearTagsMenu();
+   void clearStashesMenu();
+   void clearSubmodulesMenu();
+
    void clearActions();
 
 private:
@@ -6,9 +6,11 @@
 
 #include <QMessageBox>
 
-StashesContextMenu::StashesContextMenu(const QSharedPointer<GitBase> &git, const QString &stashId, QWidget *parent)
+StashesContextMenu::StashesContextMenu(const QSharedPointer<GitBase> &git, const QSharedPointer<GitCache> &cache,
+                                       const QString &stashId, QWidget *parent)
    : QMenu(parent)
    , mGit(git)
+   , mCache(cache)
    , mStashId(stashId)
 {
    setAttribute(Qt::WA_DeleteOnClose);
@@ -20,7 +22,7 @@ StashesContextMenu::StashesContextMenu(const QSharedPointer<GitBase> &git, const
 
 void StashesContextMenu::branch()
 {
-   BranchDlg dlg({ mStashId, BranchDlgMode::STASH_BRANCH, mGit });
+   BranchDlg dlg({ mStashId, BranchDlgMode::STASH_BRANCH, mGit, mCache });
    const auto ret = dlg.exec();
 
    if (ret == QDialog::Accepted)
@@ -26,6 +26,7 @@
 #include <QMenu>
 
 class GitBase;
+class GitCache;
 
 /*!
  \brief The StashesContextMenu shows the different options that can be performed to the stashes.
@@ -52,13 +53,16 @@ public:
     \brief Default constructor.
 
     \param git The git object to perform Git operations.
+    \param cache The internal repository cache.
     \param stashId The stash ID that will be used to perform operations into.
     \param parent The parent widget if needed.
    */
-   explicit StashesContextMenu(const QSharedPointer<GitBase> &git, const QString &stashId, QWidget *parent = nullptr);
+   explicit StashesContextMenu(const QSharedPointer<GitBase> &git, const QSharedPointer<GitCache> &cache,
+                               const QString &stashId, QWidget *parent = nullptr);
 
 private:
    QSharedPointer<GitBase> mGit;
+   QSharedPointer<GitCache> mCache;
    QString mStashId;
 
    /*!
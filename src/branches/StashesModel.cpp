@@ -0,0 +1,42 @@
+#include "StashesModel.h"
+
+StashesModel::StashesModel(QObject *parent)
+   : QAbstractListModel(parent)
+{
+}
+
+void StashesModel::setStashes(const QVector<QPair<QString, QString>> &stashes)
+{
+   if (stashes == mStashes)
+      return;
+
+   beginResetModel();
+   mStashes = stashes;
+   endResetModel();
+}
+
+void StashesModel::clear()
+{
+   beginResetModel();
+   mStashes.clear();
+   endResetModel();
+}
+
+int StashesModel::rowCount(const QModelIndex &parent) const
+{
+   return !parent.isValid() ? mStashes.count() : 0;
+}
+
+QVariant StashesModel::data(const QModelIndex &index, int role) const
+{
+   if (!index.isValid() || index.row() >= mStashes.count())
+      return QVariant();
+
+   if (role == Qt::DisplayRole)
+      return mStashes.at(index.row()).second;
+
+   if (role == Qt::UserRole)
+      return mStashes.at(index.row()).first;
+
+   return QVariant();
+}
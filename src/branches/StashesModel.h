@@ -0,0 +1,66 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+#include <QAbstractListModel>
+#include <QVector>
+
+/*!
+ \brief StashesModel is the model behind the stashes view of the BranchesWidget. It serves the
+ stash id and description straight from a plain vector, so the view materializes only the rows it
+ paints instead of one widget item per stash.
+
+*/
+class StashesModel : public QAbstractListModel
+{
+   Q_OBJECT
+
+public:
+   /*!
+    \brief Default constructor.
+
+    \param parent The parent object if needed.
+   */
+   explicit StashesModel(QObject *parent = nullptr);
+
+   /*!
+    \brief Replaces the shown stashes. When the given stashes equal the ones already shown the
+    call is a no-op.
+
+    \param stashes The stashes as pairs of stash id and description.
+   */
+   void setStashes(const QVector<QPair<QString, QString>> &stashes);
+
+   /*!
+    \brief Clears all the stashes of the model.
+
+   */
+   void clear();
+
+   int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+   QVariant data(const QModelIndex &index, int role) const override;
+
+private:
+   QVector<QPair<QString, QString>> mStashes;
+};
@@ -0,0 +1,163 @@
+#include "TagsModel.h"
+
+#include <GitQlientBranchItemRole.h>
+
+using namespace GitQlient;
+
+TagsModel::TagsModel(QObject *parent)
+   : QAbstractItemModel(parent)
+   , mRoot(new TagNode())
+{
+}
+
+TagsModel::~TagsModel()
+{
+   delete mRoot;
+}
+
+bool TagsModel::setTags(const QMap<QString, QString> &localTags, const QMap<QString, QString> &remoteTags)
+{
+   // With thousands of tags rebuilding the nodes is the expensive part of the refresh, so the
+   // model is only repopulated when the tag set changed since the last paint.
+   if (localTags == mLocalTags && remoteTags == mRemoteTags)
+      return false;
+
+   mLocalTags = localTags;
+   mRemoteTags = remoteTags;
+
+   beginResetModel();
+
+   delete mRoot;
+   mRoot = new TagNode();
+
+   for (const auto &localTag : localTags.toStdMap())
+   {
+      auto parent = mRoot;
+      const auto fullTagName = localTag.first;
+      auto folders = fullTagName.split("/");
+      auto tagName = folders.takeLast();
+
+      for (const auto &folder : qAsConst(folders))
+      {
+         TagNode *child = nullptr;
+
+         for (const auto &node : qAsConst(parent->children))
+         {
+            if (node->text == folder)
+            {
+               child = node;
+               break;
+            }
+         }
+
+         if (!child)
+         {
+            child = new TagNode();
+            child->text = folder;
+            child->row = parent->children.count();
+            child->parent = parent;
+            parent->children.append(child);
+         }
+
+         parent = child;
+      }
+
+      const auto item = new TagNode();
+      item->isLeaf = true;
+      item->isLocal = remoteTags.contains(tagName);
+
+      if (!item->isLocal)
+         tagName += " (local)";
+
+      item->text = tagName;
+      item->fullName = fullTagName;
+      item->sha = localTag.second;
+      item->row = parent->children.count();
+      item->parent = parent;
+      parent->children.append(item);
+   }
+
+   endResetModel();
+
+   return true;
+}
+
+void TagsModel::clear()
+{
+   beginResetModel();
+
+   delete mRoot;
+   mRoot = new TagNode();
+   mLocalTags.clear();
+   mRemoteTags.clear();
+
+   endResetModel();
+}
+
+TagsModel::TagNode *TagsModel::nodeOf(const QModelIndex &index) const
+{
+   return index.isValid() ? static_cast<TagNode *>(index.internalPointer()) : mRoot;
+}
+
+QModelIndex TagsModel::index(int row, int column, const QModelIndex &parent) const
+{
+   const auto parentNode = nodeOf(parent);
+
+   if (row < 0 || row >= parentNode->children.count() || column != 0)
+      return QModelIndex();
+
+   return createIndex(row, column, parentNode->children.at(row));
+}
+
+QModelIndex TagsModel::parent(const QModelIndex &index) const
+{
+   const auto node = nodeOf(index);
+
+   if (node == mRoot || node->parent == mRoot)
+      return QModelIndex();
+
+   return createIndex(node->parent->row, 0, node->parent);
+}
+
+int TagsModel::rowCount(const QModelIndex &parent) const
+{
+   return nodeOf(parent)->children.count();
+}
+
+int TagsModel::columnCount(const QModelIndex &) const
+{
+   return 1;
+}
+
+QVariant TagsModel::data(const QModelIndex &index, int role) const
+{
+   if (!index.isValid())
+      return QVariant();
+
+   const auto node = nodeOf(index);
+
+   switch (role)
+   {
+      case Qt::DisplayRole:
+         return node->text;
+      case Qt::ToolTipRole:
+      case FullNameRole:
+         return node->isLeaf ? QVariant(node->fullName) : QVariant();
+      case LocalBranchRole:
+         return node->isLocal;
+      case ShaRole:
+         return node->sha;
+      case IsLeaf:
+         return node->isLeaf;
+      default:
+         return QVariant();
+   }
+}
+
+QVariant TagsModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+   if (section == 0 && orientation == Qt::Horizontal && role == Qt::DisplayRole)
+      return tr("Tags");
+
+   return QVariant();
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+#include <QAbstractItemModel>
+#include <QMap>
+#include <QVector>
+
+/*!
+ \brief TagsModel is the model behind the tags view of the BranchesWidget. The tags are stored as
+ lightweight nodes grouped by their folder prefix and the view materializes only the rows it
+ paints, so refreshing a repository with thousands of tags no longer allocates one widget item per
+ tag.
+
+*/
+class TagsModel : public QAbstractItemModel
+{
+   Q_OBJECT
+
+public:
+   /*!
+    \brief Default constructor.
+
+    \param parent The parent object if needed.
+   */
+   explicit TagsModel(QObject *parent = nullptr);
+
+   /**
+    * @brief Destructor.
+    */
+   ~TagsModel() override;
+
+   /*!
+    \brief Replaces the shown tags. When the given tag sets equal the ones already shown the call
+    is a no-op, so the periodic cache refreshes of an unchanged repository cost two map
+    comparisons.
+
+    \param localTags The local tags, mapping tag name to sha.
+    \param remoteTags The remote tags, mapping tag name to sha.
+    \return bool True when the model was rebuilt, false when the tags were already shown.
+   */
+   bool setTags(const QMap<QString, QString> &localTags, const QMap<QString, QString> &remoteTags);
+
+   /*!
+    \brief Clears all the tags of the model.
+
+   */
+   void clear();
+
+   QModelIndex index(int row, int column, const QModelIndex &parent = QModelIndex()) const override;
+   QModelIndex parent(const QModelIndex &index) const override;
+   int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+   int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+   QVariant data(const QModelIndex &index, int role) const override;
+   QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+private:
+   /*!
+    \brief The TagNode struct holds the data of one row: either a folder grouping tags by prefix
+    or a leaf pointing to the tagged sha.
+   */
+   struct TagNode
+   {
+      QString text;
+      QString fullName;
+      QString sha;
+      bool isLeaf = false;
+      bool isLocal = false;
+      int row = 0;
+      TagNode *parent = nullptr;
+      QVector<TagNode *> children;
+
+      ~TagNode() { qDeleteAll(children); }
+   };
+
+   TagNode *mRoot = nullptr;
+   QMap<QString, QString> mLocalTags;
+   QMap<QString, QString> mRemoteTags;
+
+   TagNode *nodeOf(const QModelIndex &index) const;
+};
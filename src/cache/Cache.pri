@@ -1,21 +1,31 @@
 INCLUDEPATH += $$PWD
 
 HEADERS += \
+    $$PWD/CommitGraphSnapshot.h \
     $$PWD/CommitInfo.h \
+    $$PWD/CommitInfoArena.h \
+    $$PWD/CommitMessageIndex.h \
     $$PWD/GitCache.h \
     $$PWD/GitServerCache.h \
+    $$PWD/GitServerCacheSnapshot.h \
     $$PWD/Lane.h \
     $$PWD/LaneType.h \
     $$PWD/References.h \
+    $$PWD/RepositoryStats.h \
     $$PWD/RevisionFiles.h \
     $$PWD/WipRevisionInfo.h \
     $$PWD/lanes.h
 
 SOURCES += \
+    $$PWD/CommitGraphSnapshot.cpp \
     $$PWD/CommitInfo.cpp \
+    $$PWD/CommitInfoArena.cpp \
+    $$PWD/CommitMessageIndex.cpp \
     $$PWD/GitCache.cpp \
     $$PWD/GitServerCache.cpp \
+    $$PWD/GitServerCacheSnapshot.cpp \
     $$PWD/Lane.cpp \
     $$PWD/References.cpp \
+    $$PWD/RepositoryStats.cpp \
     $$PWD/RevisionFiles.cpp \
     $$PWD/lanes.cpp
@@ -0,0 +1,96 @@
+#include "CommitGraphSnapshot.h"
+
+#include <QLogger.h>
+
+#include <QDataStream>
+#include <QFile>
+
+using namespace QLogger;
+
+CommitGraphSnapshot::CommitGraphSnapshot(const QString &gitDirPath)
+   : mFilePath(gitDirPath + "/GitQlientGraphCache.dat")
+{
+}
+
+bool CommitGraphSnapshot::save(const QList<CommitInfo> &commits) const
+{
+   QFile file(mFilePath);
+
+   if (!file.open(QIODevice::WriteOnly))
+   {
+      QLog_Warning("Cache", QString("Unable to write the graph snapshot to {%1}.").arg(mFilePath));
+
+      return false;
+   }
+
+   QDataStream out(&file);
+   out.setVersion(QDataStream::Qt_5_9);
+
+   out << MagicNumber << Version << quint32(commits.count());
+
+   for (const auto &commit : commits)
+   {
+      out << commit.sha() << commit.parents() << commit.isBoundary() << commit.committer() << commit.author()
+          << commit.authorDateSecs() << commit.shortLog() << commit.longLog();
+   }
+
+   QLog_Debug("Cache", QString("Graph snapshot with {%1} commits stored.").arg(commits.count()));
+
+   return true;
+}
+
+QList<CommitInfo> CommitGraphSnapshot::load() const
+{
+   QFile file(mFilePath);
+
+   if (!file.open(QIODevice::ReadOnly))
+      return {};
+
+   // The snapshot is memory-mapped so the warm start reads pages on demand instead of copying the
+   // whole file upfront; readAll is only the fallback when mapping is not available.
+   const auto mapped = file.map(0, file.size());
+   const auto buffer = mapped
+       ? QByteArray::fromRawData(reinterpret_cast<const char *>(mapped), static_cast<int>(file.size()))
+       : file.readAll();
+
+   QDataStream in(buffer);
+   in.setVersion(QDataStream::Qt_5_9);
+
+   quint32 magic = 0;
+   quint16 version = 0;
+   quint32 count = 0;
+
+   in >> magic >> version;
+
+   if (magic != MagicNumber || version != Version)
+      return {};
+
+   in >> count;
+
+   QList<CommitInfo> commits;
+   commits.reserve(count);
+
+   for (auto i = 0u; i < count; ++i)
+   {
+      QString sha;
+      QStringList parents;
+      bool boundary = false;
+      QString committer;
+      QString author;
+      qint64 date = 0;
+      QString shortLog;
+      QString longLog;
+
+      in >> sha >> parents >> boundary >> committer >> author >> date >> shortLog >> longLog;
+
+      if (in.status() != QDataStream::Ok)
+         return {};
+
+      commits.append(
+          CommitInfo { sha, parents, boundary ? QChar('-') : QChar('>'), committer, date, author, shortLog, longLog });
+   }
+
+   QLog_Debug("Cache", QString("Graph snapshot with {%1} commits loaded.").arg(commits.count()));
+
+   return commits;
+}
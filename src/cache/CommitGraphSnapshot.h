@@ -0,0 +1,49 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+#include <CommitInfo.h>
+
+#include <QList>
+#include <QString>
+
+/*!
+ \brief Persists the parsed commit graph next to the repository configuration so the next session
+ can warm-start the history view from a memory-mapped file while the real git log runs in the
+ background.
+*/
+class CommitGraphSnapshot
+{
+public:
+   explicit CommitGraphSnapshot(const QString &gitDirPath);
+
+   bool save(const QList<CommitInfo> &commits) const;
+   QList<CommitInfo> load() const;
+
+private:
+   QString mFilePath;
+
+   static const quint32 MagicNumber = 0x47514347;
+   static const quint16 Version = 1;
+};
@@ -2,18 +2,25 @@
 
 #include <QStringList>
 
+#include <cstring>
+
 const QString CommitInfo::ZERO_SHA = QString("0000000000000000000000000000000000000000");
 const QString CommitInfo::INIT_SHA = QString("4b825dc642cb6eb9a060e54bf8d69288fbee4904");
 
 CommitInfo::CommitInfo(const QString sha, const QStringList &parents, const QChar &boundary, const QString &commiter,
-                       const QDateTime &commitDate, const QString &author, const QString &log, const QString &longLog,
+                       qint64 commitDateSecs, const QString &author, const QString &log, const QString &longLog,
                        bool isSigned, const QString &gpgKey)
 {
    mSha = sha;
-   mParentsSha = parents;
+
+   mParentsSha.reserve(parents.count() * RAW_SHA_LENGTH);
+
+   for (const auto &parent : parents)
+      mParentsSha.append(toRawSha(parent));
+
    mBoundaryInfo = boundary;
    mCommitter = commiter;
-   mCommitDate = commitDate;
+   mCommitDateSecs = commitDateSecs;
    mAuthor = author;
    mShortLog = log;
    mLongLog = longLog;
@@ -25,7 +32,7 @@ bool CommitInfo::operator==(const CommitInfo &commit) const
 {
    return (mSha == commit.mSha || mSha.startsWith(commit.sha()) || commit.sha().startsWith(mSha))
        && mParentsSha == commit.mParentsSha && mCommitter == commit.mCommitter && mAuthor == commit.mAuthor
-       && mCommitDate == commit.mCommitDate && mShortLog == commit.mShortLog && mLongLog == commit.mLongLog
+       && mCommitDateSecs == commit.mCommitDateSecs && mShortLog == commit.mShortLog && mLongLog == commit.mLongLog
        && mLanes == commit.mLanes;
 }
 
@@ -40,24 +47,47 @@ bool CommitInfo::contains(const QString &value)
        || mCommitter.contains(value, Qt::CaseInsensitive) || mAuthor.contains(value, Qt::CaseInsensitive);
 }
 
+QByteArray CommitInfo::toRawSha(const QString &sha)
+{
+   return QByteArray::fromHex(sha.toLatin1());
+}
+
 int CommitInfo::parentsCount() const
 {
-   auto count = mParentsSha.count();
+   static const auto rawInitSha = toRawSha(CommitInfo::INIT_SHA);
+
+   auto count = mParentsSha.count() / RAW_SHA_LENGTH;
 
-   if (count > 0 && mParentsSha.contains(CommitInfo::INIT_SHA))
-      --count;
+   for (auto i = 0; i < count; ++i)
+   {
+      if (memcmp(mParentsSha.constData() + i * RAW_SHA_LENGTH, rawInitSha.constData(), RAW_SHA_LENGTH) == 0)
+      {
+         --count;
+         break;
+      }
+   }
 
    return count;
 }
 
 QString CommitInfo::parent(int idx) const
 {
-   return mParentsSha.count() > idx ? mParentsSha.at(idx) : QString();
+   if (mParentsSha.count() / RAW_SHA_LENGTH > idx)
+      return QString::fromLatin1(mParentsSha.mid(idx * RAW_SHA_LENGTH, RAW_SHA_LENGTH).toHex());
+
+   return QString();
 }
 
 QStringList CommitInfo::parents() const
 {
-   return mParentsSha;
+   QStringList parents;
+   const auto count = mParentsSha.count() / RAW_SHA_LENGTH;
+   parents.reserve(count);
+
+   for (auto i = 0; i < count; ++i)
+      parents.append(QString::fromLatin1(mParentsSha.mid(i * RAW_SHA_LENGTH, RAW_SHA_LENGTH).toHex()));
+
+   return parents;
 }
 
 bool CommitInfo::isValid() const
@@ -81,3 +111,18 @@ int CommitInfo::getActiveLane() const
 
    return -1;
 }
+
+quint64 CommitInfo::memoryUsage() const
+{
+   auto bytes = static_cast<quint64>(sizeof(CommitInfo));
+
+   bytes += static_cast<quint64>(mSha.capacity() + mCommitter.capacity() + mAuthor.capacity() + mShortLog.capacity()
+                                 + mLongLog.capacity() + mDiff.capacity() + mGpgKey.capacity())
+       * sizeof(QChar);
+   bytes += static_cast<quint64>(mParentsSha.capacity());
+   bytes += static_cast<quint64>(mLanes.capacity()) * sizeof(Lane);
+
+   // The children pointers live in the contiguous array owned by GitCache and are accounted there.
+
+   return bytes;
+}
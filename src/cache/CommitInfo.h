@@ -25,7 +25,6 @@
 
 #include <QVector>
 #include <QStringList>
-#include <QDateTime>
 
 #include <Lane.h>
 #include <References.h>
@@ -46,7 +45,7 @@ public:
 
    CommitInfo() = default;
    explicit CommitInfo(const QString sha, const QStringList &parents, const QChar &boundary, const QString &commiter,
-                       const QDateTime &commitDate, const QString &author, const QString &log,
+                       qint64 commitDateSecs, const QString &author, const QString &log,
                        const QString &longLog = QString(), bool isSigned = false, const QString &gpgKey = QString());
    bool operator==(const CommitInfo &commit) const;
    bool operator!=(const CommitInfo &commit) const;
@@ -58,13 +57,21 @@ public:
    int parentsCount() const;
    QString parent(int idx) const;
    QStringList parents() const;
+   QByteArray rawParents() const { return mParentsSha; }
 
    QString sha() const { return mSha; }
    QString committer() const { return mCommitter; }
    QString author() const { return mAuthor; }
-   QString authorDate() const { return QString::number(mCommitDate.toSecsSinceEpoch()); }
+   QString authorDate() const { return QString::number(mCommitDateSecs); }
+   /**
+    * @brief authorDateSecs Returns the commit date as raw epoch seconds. The commit never builds a
+    * QDateTime itself; callers format on demand.
+    * @return The commit date in seconds since the epoch.
+    */
+   qint64 authorDateSecs() const { return mCommitDateSecs; }
    QString shortLog() const { return mShortLog; }
    QString longLog() const { return mLongLog; }
+   void setLongLog(const QString &longLog) { mLongLog = longLog; }
    QString fullLog() const { return QString("%1\n\n%2").arg(mShortLog, mLongLog.trimmed()); }
 
    bool isValid() const;
@@ -76,28 +83,58 @@ public:
    int getLanesCount() const { return mLanes.count(); }
    int getActiveLane() const;
 
-   void addChildReference(CommitInfo *commit) { mChilds.insert(commit->sha(), commit); }
-   QList<CommitInfo *> getChilds() const { return mChilds.values(); }
-   bool hasChilds() const { return !mChilds.empty(); }
+   /**
+    * @brief setChildsStorage Hands the commit its slice of the contiguous children array owned by
+    * GitCache. The commit doesn't own the storage; it stays valid until the next graph rebuild.
+    * @param childs The first child pointer of the slice.
+    * @param count The number of children.
+    */
+   void setChildsStorage(CommitInfo **childs, int count)
+   {
+      mChilds = childs;
+      mChildsCount = count;
+   }
+   QList<CommitInfo *> getChilds() const
+   {
+      QList<CommitInfo *> childs;
+      childs.reserve(mChildsCount);
+
+      for (auto i = 0; i < mChildsCount; ++i)
+         childs.append(mChilds[i]);
+
+      return childs;
+   }
+   bool hasChilds() const { return mChildsCount > 0; }
 
    bool isSigned() const { return mSigned; }
    QString getGpgKey() const { return mGpgKey; }
 
+   /**
+    * @brief memoryUsage Approximates the heap bytes held by the commit fields. Used by the memory
+    * diagnostics to attribute the footprint of a long session.
+    * @return The estimated size in bytes.
+    */
+   quint64 memoryUsage() const;
+
+   static QByteArray toRawSha(const QString &sha);
+
    static const QString ZERO_SHA;
    static const QString INIT_SHA;
+   static const int RAW_SHA_LENGTH = 20;
 
 private:
    QChar mBoundaryInfo;
    QString mSha;
-   QStringList mParentsSha;
+   QByteArray mParentsSha;
    QString mCommitter;
    QString mAuthor;
-   QDateTime mCommitDate;
+   qint64 mCommitDateSecs = 0;
    QString mShortLog;
    QString mLongLog;
    QString mDiff;
    QVector<Lane> mLanes;
-   QMap<QString, CommitInfo *> mChilds;
+   CommitInfo **mChilds = nullptr;
+   int mChildsCount = 0;
    bool mSigned = false;
    QString mGpgKey;
 };
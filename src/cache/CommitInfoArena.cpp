@@ -0,0 +1,42 @@
+#include "CommitInfoArena.h"
+
+#include <AllocationTracker.h>
+
+#include <utility>
+
+CommitInfoArena::~CommitInfoArena()
+{
+   clear();
+}
+
+CommitInfo *CommitInfoArena::append(CommitInfo &&commit)
+{
+   const auto offset = mCount % BlockSize;
+
+   if (offset == 0)
+   {
+      mBlocks.append(new CommitInfo[BlockSize]);
+
+      GQ_TRACK_ALLOC("CommitInfoArena::blocks", sizeof(CommitInfo) * BlockSize);
+   }
+
+   const auto slot = mBlocks.constLast() + offset;
+   *slot = std::move(commit);
+
+   ++mCount;
+
+   return slot;
+}
+
+void CommitInfoArena::clear()
+{
+   for (auto block : qAsConst(mBlocks))
+   {
+      delete[] block;
+
+      GQ_TRACK_FREE("CommitInfoArena::blocks", sizeof(CommitInfo) * BlockSize);
+   }
+
+   mBlocks.clear();
+   mCount = 0;
+}
@@ -0,0 +1,185 @@
+#include "CommitMessageIndex.h"
+
+#include <CommitInfo.h>
+#include <GitCache.h>
+#include <PerfProfiler.h>
+#include <TaskPool.h>
+
+#include <QtConcurrent/QtConcurrent>
+
+#include <QLogger.h>
+
+using namespace QLogger;
+
+namespace
+{
+/* The recent subjects and the path mapping only look at the newest commits: old history stops
+ * being representative of how the team writes messages today. */
+constexpr auto kRecentSubjects = 200;
+constexpr auto kPathMappingDepth = 500;
+
+QString prefixOf(const QString &subject)
+{
+   const auto colon = subject.indexOf(QChar(':'));
+
+   if (colon > 0 && colon <= 24)
+   {
+      const auto prefix = subject.left(colon).trimmed();
+
+      if (!prefix.contains(QChar::Space))
+         return prefix;
+   }
+
+   return QString();
+}
+
+QString topLevelOf(const QString &file)
+{
+   const auto slash = file.indexOf(QChar('/'));
+
+   return slash > 0 ? file.left(slash) : file;
+}
+}
+
+CommitMessageIndex::CommitMessageIndex(const QSharedPointer<GitCache> &cache, QObject *parent)
+   : QObject(parent)
+   , mCache(cache)
+{
+}
+
+CommitMessageIndex::~CommitMessageIndex()
+{
+   mGeneration.ref();
+   mFuture.waitForFinished();
+}
+
+void CommitMessageIndex::scheduleUpdate()
+{
+   mGeneration.ref();
+
+   const auto generation = mGeneration.loadAcquire();
+
+   mFuture = QtConcurrent::run(TaskPool::instance()->pool(), [this, generation]() { compute(generation); });
+}
+
+QStringList CommitMessageIndex::prefixes() const
+{
+   QMutexLocker guard(&mMutex);
+
+   return mPrefixes;
+}
+
+QStringList CommitMessageIndex::recentSubjects() const
+{
+   QMutexLocker guard(&mMutex);
+
+   return mRecentSubjects;
+}
+
+QStringList CommitMessageIndex::prefixesForPaths(const QStringList &paths) const
+{
+   QMutexLocker guard(&mMutex);
+
+   QStringList result;
+
+   for (const auto &path : paths)
+   {
+      for (const auto &prefix : mPathPrefixes.value(topLevelOf(path)))
+      {
+         if (!result.contains(prefix))
+            result.append(prefix);
+      }
+   }
+
+   return result;
+}
+
+void CommitMessageIndex::compute(int generation)
+{
+   PerfScopedTimer timer("CommitMessageIndex::compute", "cache");
+
+   const auto commitCount = mCache->commitCount();
+
+   {
+      QMutexLocker guard(&mMutex);
+
+      if (commitCount == mComputedCommits)
+         return;
+   }
+
+   QLog_Debug("Cache", QString("Building the commit message index for {%1} commits.").arg(commitCount));
+
+   QHash<QString, int> prefixCounts;
+   QHash<QString, QHash<QString, int>> pathPrefixCounts;
+   QStringList recentSubjects;
+
+   // Row 0 holds the WIP commit, so the pass starts at the first real one
+   for (auto row = 1; row < commitCount; ++row)
+   {
+      if (generation != mGeneration.loadAcquire())
+         return;
+
+      const auto commit = mCache->commitInfo(row);
+      const auto subject = commit.shortLog();
+
+      if (recentSubjects.count() < kRecentSubjects && !subject.isEmpty())
+         recentSubjects.append(subject);
+
+      const auto prefix = prefixOf(subject);
+
+      if (prefix.isEmpty())
+         continue;
+
+      ++prefixCounts[prefix];
+
+      // The path mapping only uses the revision files already present in the cache: spawning a
+      // diff per commit would defeat the zero-git-call requirement
+      if (row <= kPathMappingDepth && commit.parentsCount() > 0)
+      {
+         const auto files = mCache->revisionFile(commit.sha(), commit.parent(0));
+
+         for (auto i = 0; files.isValid() && i < files.count(); ++i)
+            ++pathPrefixCounts[topLevelOf(files.getFile(i))][prefix];
+      }
+   }
+
+   const auto sortByCount = [](const QHash<QString, int> &counts, int minimum) {
+      auto entries = counts.keys();
+
+      std::sort(entries.begin(), entries.end(), [&counts](const QString &a, const QString &b) {
+         return counts.value(a) != counts.value(b) ? counts.value(a) > counts.value(b) : a < b;
+      });
+
+      QStringList result;
+
+      for (const auto &entry : qAsConst(entries))
+      {
+         if (counts.value(entry) >= minimum)
+            result.append(QString("%1: ").arg(entry));
+      }
+
+      return result;
+   };
+
+   // A prefix typed once is likely a one-off, so only the repeated ones become suggestions
+   auto prefixes = sortByCount(prefixCounts, 2);
+
+   QHash<QString, QStringList> pathPrefixes;
+
+   for (auto iter = pathPrefixCounts.cbegin(); iter != pathPrefixCounts.cend(); ++iter)
+      pathPrefixes.insert(iter.key(), sortByCount(iter.value(), 1));
+
+   if (generation != mGeneration.loadAcquire())
+      return;
+
+   {
+      QMutexLocker guard(&mMutex);
+
+      mComputedCommits = commitCount;
+      mPrefixes = std::move(prefixes);
+      mRecentSubjects = std::move(recentSubjects);
+      mPathPrefixes = std::move(pathPrefixes);
+   }
+
+   emit indexReady();
+}
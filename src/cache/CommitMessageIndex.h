@@ -0,0 +1,109 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+#include <QAtomicInt>
+#include <QFuture>
+#include <QHash>
+#include <QMutex>
+#include <QObject>
+#include <QSharedPointer>
+#include <QStringList>
+
+class GitCache;
+
+/**
+ * @brief The CommitMessageIndex class builds an autocompletion index over the commit subjects
+ * already held by the GitCache: the frequency of subject prefixes like "net:" or "ui/diff:", the
+ * most recent subjects, and a mapping from top-level paths to the prefixes their commits used.
+ * The index is built on the shared worker pool without spawning a git process, so the lookups that
+ * feed the completer stay in-memory and cost microseconds per keystroke. A rebuild is skipped when
+ * the commits did not change and a newer request supersedes a pass that is still running.
+ */
+class CommitMessageIndex : public QObject
+{
+   Q_OBJECT
+
+signals:
+   /**
+    * @brief indexReady Emitted from the worker thread when a build pass finished and the
+    * accessors serve fresh data.
+    */
+   void indexReady();
+
+public:
+   /**
+    * @brief Default constructor.
+    * @param cache The internal cache of the current repository.
+    * @param parent The parent object if needed.
+    */
+   explicit CommitMessageIndex(const QSharedPointer<GitCache> &cache, QObject *parent = nullptr);
+
+   /**
+    * @brief Destructor. Supersedes and waits for the running pass.
+    */
+   ~CommitMessageIndex() override;
+
+   /**
+    * @brief scheduleUpdate Launches a build pass on the worker pool. A pass that is already
+    * running is superseded.
+    */
+   void scheduleUpdate();
+
+   /**
+    * @brief prefixes Gets the subject prefixes seen at least twice, most frequent first, already
+    * formatted for typing ("net: ").
+    * @return The list of prefixes.
+    */
+   QStringList prefixes() const;
+   /**
+    * @brief recentSubjects Gets the subjects of the most recent commits, newest first.
+    * @return The list of subjects.
+    */
+   QStringList recentSubjects() const;
+   /**
+    * @brief prefixesForPaths Gets the prefixes used by commits touching the given files, most
+    * frequent first, so the staged changes drive the first suggestions.
+    * @param paths The file paths of the pending changes.
+    * @return The list of prefixes.
+    */
+   QStringList prefixesForPaths(const QStringList &paths) const;
+
+private:
+   QSharedPointer<GitCache> mCache;
+   QAtomicInt mGeneration;
+   QFuture<void> mFuture;
+   mutable QMutex mMutex;
+   int mComputedCommits = -1;
+   QStringList mPrefixes;
+   QStringList mRecentSubjects;
+   QHash<QString, QStringList> mPathPrefixes;
+
+   /**
+    * @brief compute Runs one build pass over the cached commits. Aborts as soon as the given
+    * generation is superseded.
+    * @param generation The generation this pass was scheduled with.
+    */
+   void compute(int generation);
+};
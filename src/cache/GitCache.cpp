@@ -1,35 +1,82 @@
 #include "GitCache.h"
 
+#include <AllocationTracker.h>
+#include <CommitGraphReader.h>
+#include <MemoryTracker.h>
+#include <PerfProfiler.h>
 #include <QLogger.h>
+#include <TaskPool.h>
 #include <WipRevisionInfo.h>
 
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QRegularExpression>
+#include <QThread>
+#include <QtConcurrent>
+
+#include <queue>
+
 using namespace QLogger;
 
+static constexpr auto LanesBatchSize = 2048;
+static constexpr auto MaxRevisionFiles = 1000;
+
 GitCache::GitCache(QObject *parent)
    : QObject(parent)
-   , mMutex(QMutex::Recursive)
 {
+   mCommitsTrackerId = MemoryTracker::instance()->add(tr("Commits graph"), [this]() { return commitsMemoryUsage(); });
+   mRevisionFilesTrackerId = MemoryTracker::instance()->add(
+       tr("Revision files"), [this]() { return revisionFilesMemoryUsage(); }, [this]() { clearRevisionFiles(); });
 }
 
 GitCache::~GitCache()
 {
+   MemoryTracker::instance()->remove(mCommitsTrackerId);
+   MemoryTracker::instance()->remove(mRevisionFilesTrackerId);
+
+   mLaneGeneration.ref();
+   mResortFuture.waitForFinished();
+   mLanesFuture.waitForFinished();
+
    mCommits.clear();
    mCommitsMap.clear();
    mReferences.clear();
+   mReferenceShaIndex.clear();
 }
 
 void GitCache::setup(const WipRevisionInfo &wipInfo, const QList<CommitInfo> &commits)
 {
-   QMutexLocker lock(&mMutex);
+   PerfScopedTimer timer("GitCache::setup", "cache");
+
+   QWriteLocker lock(&mMutex);
 
    const auto totalCommits = commits.count() + 1;
 
    QLog_Debug("Cache", QString("Configuring the cache for {%1} elements.").arg(totalCommits));
 
    mConfigured = false;
+   mGenealogyDirty = true;
+
+   if (isSameGraph(commits))
+   {
+      QLog_Debug("Cache", QString("Graph unchanged: refreshing the WIP revision only."));
+
+      insertWipRevision(wipInfo);
+
+      return;
+   }
+
+#ifdef ALLOC_TRACKING
+   for (const auto &file : qAsConst(mRevisionFilesMap))
+      AllocationTracker::instance()->recordFree("GitCache::revisionFiles", file.memoryUsage());
+#endif
 
    mRevisionFilesMap.clear();
+   mRevisionFilesUsage.clear();
    mLanes.clear();
+   mShaToRow.clear();
+   mSearchIndex.clear();
+   mSortedShas.clear();
 
    if (mCommitsMap.isEmpty())
       mCommitsMap.reserve(totalCommits);
@@ -56,38 +103,366 @@ void GitCache::setup(const WipRevisionInfo &wipInfo, const QList<CommitInfo> &co
    {
       if (commit.isValid())
       {
-         commit.setLanes(calculateLanes(commit));
+         const auto rawSha = CommitInfo::toRawSha(commit.sha());
 
-         const auto sha = commit.sha();
+         auto &storedCommit = mCommitsMap[rawSha];
 
-         if (sha == mCommitsMap.value(CommitInfo::ZERO_SHA).parent(0))
-            commit.addChildReference(&mCommitsMap[CommitInfo::ZERO_SHA]);
+         if (storedCommit)
+            *storedCommit = std::move(commit);
+         else
+            storedCommit = mCommitArena.append(std::move(commit));
 
-         mCommitsMap[sha] = std::move(commit);
+         mCommits.replace(count, storedCommit);
+         mShaToRow.insert(rawSha, count);
 
-         mCommits.replace(count, &mCommitsMap[sha]);
+         ++count;
+      }
+   }
+
+   wireChildren();
+   rebuildColumns();
 
-         if (mTmpChildsStorage.contains(sha))
+   mLaneGeneration.ref();
+
+   // The lock is released first: launchLanesCalculation drains the previous lanes worker, which
+   // needs it to notice the superseded generation
+   lock.unlock();
+
+   launchLanesCalculation();
+}
+
+void GitCache::rebuildColumns()
+{
+   /* The sortable fields are copied into per-field vectors indexed by row. The reorder and search
+    * scans walk them sequentially, so they stay in cache instead of chasing every CommitInfo
+    * through the heap. The author/committer pairs are deduplicated into a small table referenced
+    * by id, which the interning of the identities keeps cheap to build. */
+   const auto total = mCommits.count();
+
+   mEpochColumn.resize(total);
+   mIdentityColumn.resize(total);
+   mIdentities.clear();
+
+   QHash<QString, int> identityIds;
+
+   for (auto row = 0; row < total; ++row)
+   {
+      const auto commit = mCommits.at(row);
+
+      if (!commit)
+      {
+         mEpochColumn[row] = 0;
+         mIdentityColumn[row] = -1;
+         continue;
+      }
+
+      mEpochColumn[row] = commit->authorDateSecs();
+
+      const auto identity = commit->author() + QChar('\n') + commit->committer();
+      auto id = identityIds.value(identity, -1);
+
+      if (id == -1)
+      {
+         id = mIdentities.count();
+         identityIds.insert(identity, id);
+         mIdentities.append(identity.toLower());
+      }
+
+      mIdentityColumn[row] = id;
+   }
+}
+
+void GitCache::wireChildren()
+{
+   /* Two-pass counting build over the rows: the first pass collects the child->parent edges and
+    * counts the children of every row, the second writes the child pointers into one contiguous
+    * array that each commit gets a slice of. This replaces the per-commit map insertions and the
+    * ordered-map walks the wiring used to do. */
+   const auto total = mCommits.count();
+
+   QVector<int> counts(total, 0);
+   QVector<QPair<int, int>> edges;
+   edges.reserve(total);
+
+   for (auto row = 0; row < total; ++row)
+   {
+      const auto commit = mCommits.at(row);
+
+      if (!commit)
+         continue;
+
+      const auto parents = commit->parents();
+
+      for (const auto &parent : parents)
+      {
+         const auto parentRow = mShaToRow.value(CommitInfo::toRawSha(parent), -1);
+
+         if (parentRow != -1)
          {
-            for (auto &child : mTmpChildsStorage.values(sha))
-               mCommitsMap[sha].addChildReference(child);
+            ++counts[parentRow];
+            edges.append(qMakePair(parentRow, row));
+         }
+      }
+   }
+
+   mChildsArena.clear();
+   mChildsArena.resize(edges.count());
 
-            mTmpChildsStorage.remove(sha);
+   QVector<int> offsets(total, 0);
+   auto offset = 0;
+
+   for (auto row = 0; row < total; ++row)
+   {
+      offsets[row] = offset;
+      offset += counts[row];
+   }
+
+   auto cursor = offsets;
+
+   for (const auto &edge : qAsConst(edges))
+      mChildsArena[cursor[edge.first]++] = mCommits.at(edge.second);
+
+   for (auto row = 0; row < total; ++row)
+   {
+      if (const auto commit = mCommits.at(row))
+         commit->setChildsStorage(mChildsArena.data() + offsets[row], counts[row]);
+   }
+}
+
+void GitCache::launchLanesCalculation()
+{
+   const auto generation = mLaneGeneration.loadAcquire();
+
+   // A previous calculation was superseded by the generation bump and exits at its next batch; it
+   // is drained here so reassigning the future never abandons a task that captured this
+   mLanesFuture.waitForFinished();
+
+   // The lanes are computed sequentially in a background task and published in batches, so the
+   // view can already show the incoming rows while the graph decoration catches up.
+   mLanesFuture = QtConcurrent::run(TaskPool::instance()->pool(), [this, generation]() {
+      PerfScopedTimer timer("GitCache::lanesCalculation", "cache");
+
+      QLog_Debug("Cache", "Calculating lanes in the background.");
+
+      // The walk keeps its own lane state machine, seeded by replaying the WIP row, so it never
+      // shares mLanes with a WIP refresh running on the caller's thread
+      Lanes lanes;
+
+      {
+         QWriteLocker lock(&mMutex);
+
+         if (generation != mLaneGeneration.loadAcquire())
+            return;
+
+         if (!mCommits.isEmpty() && mCommits.at(0))
+         {
+            lanes.init(mCommits.at(0)->sha());
+            calculateLanes(*mCommits.at(0), lanes);
          }
+      }
 
-         const auto parents = mCommitsMap.value(sha).parents();
+      auto row = 1;
+      auto finished = false;
 
-         for (const auto &parent : parents)
-            mTmpChildsStorage.insert(parent, &mCommitsMap[sha]);
+      while (!finished)
+      {
+         const auto batchStart = row;
 
-         ++count;
+         {
+            QWriteLocker lock(&mMutex);
+
+            if (generation != mLaneGeneration.loadAcquire())
+               return;
+
+            const auto end = qMin(row + LanesBatchSize, mCommits.count());
+
+            for (; row < end; ++row)
+            {
+               if (const auto commit = mCommits.at(row))
+                  commit->setLanes(calculateLanes(*commit, lanes));
+            }
+
+            finished = row >= mCommits.count();
+         }
+
+         // Only the decorated range is announced, so the views repaint those rows instead of
+         // refreshing everything on every batch
+         if (row > batchStart)
+            emit signalRowsUpdated(batchStart, row - 1);
       }
+
+      QLog_Debug("Cache", "Lanes calculation finished.");
+   });
+}
+
+void GitCache::resortCommits(int order)
+{
+   // The running lanes calculation is cancelled up front: it will be relaunched over the new order
+   mLaneGeneration.ref();
+
+   const auto generation = mLaneGeneration.loadAcquire();
+
+   // A reorder still in flight is drained before the future is reassigned, so no running task
+   // that captured this is ever left behind for the destructor to miss
+   mResortFuture.waitForFinished();
+
+   mResortFuture = QtConcurrent::run(TaskPool::instance()->pool(), [this, order, generation]() {
+      PerfScopedTimer timer("GitCache::resortCommits", "cache");
+
+      {
+         QWriteLocker lock(&mMutex);
+
+         // A superseded generation means the cache is being destroyed or a newer reorder replaced
+         // this one while it waited for the lock; the stale walk is skipped entirely
+         if (generation != mLaneGeneration.loadAcquire())
+            return;
+
+         const auto total = mCommits.count();
+
+         if (total <= 2)
+            return;
+
+         /* Kahn walk over the cached DAG: a commit becomes ready once all its children are placed,
+          * so no parent ever precedes one of its children. The date modes pick the newest ready
+          * commit; the topological mode follows the first parent of the last placed commit so the
+          * strands of history stay together instead of being interleaved by date. */
+         const auto byDate = order != 2;
+
+         QVector<int> pending(total, 0);
+
+         for (auto row = 1; row < total; ++row)
+         {
+            const auto commit = mCommits.at(row);
+
+            if (!commit)
+               continue;
+
+            const auto childs = commit->getChilds();
+
+            for (const auto child : childs)
+            {
+               if (mShaToRow.value(CommitInfo::toRawSha(child->sha()), 0) >= 1)
+                  ++pending[row];
+            }
+         }
+
+         std::priority_queue<std::pair<qint64, int>> readyByDate;
+         std::priority_queue<int, std::vector<int>, std::greater<int>> readyByRow;
+
+         const auto push = [&](int row) {
+            // The row is negated so equal dates keep their current relative order; the epoch comes
+            // from the dense column instead of the scattered commit objects
+            if (byDate)
+               readyByDate.push({ mEpochColumn.at(row), -row });
+            else
+               readyByRow.push(row);
+         };
+
+         for (auto row = 1; row < total; ++row)
+         {
+            if (pending[row] == 0 && mCommits.at(row))
+               push(row);
+         }
+
+         QVector<CommitInfo *> sorted;
+         sorted.reserve(total);
+         sorted.append(mCommits.at(0));
+
+         auto preferred = -1;
+
+         while (sorted.count() < total)
+         {
+            auto row = -1;
+
+            if (preferred != -1)
+            {
+               row = preferred;
+               preferred = -1;
+            }
+            else if (byDate && !readyByDate.empty())
+            {
+               row = -readyByDate.top().second;
+               readyByDate.pop();
+            }
+            else if (!byDate && !readyByRow.empty())
+            {
+               row = readyByRow.top();
+               readyByRow.pop();
+            }
+            else
+               break;
+
+            const auto commit = mCommits.at(row);
+
+            sorted.append(commit);
+
+            const auto parentsCount = commit->parentsCount();
+
+            for (auto i = 0; i < parentsCount; ++i)
+            {
+               const auto parentRow = mShaToRow.value(CommitInfo::toRawSha(commit->parent(i)), -1);
+
+               if (parentRow < 1)
+                  continue;
+
+               if (--pending[parentRow] == 0)
+               {
+                  if (!byDate && i == 0)
+                     preferred = parentRow;
+                  else
+                     push(parentRow);
+               }
+            }
+         }
+
+         // A truncated log can miss edges; on an incomplete walk the current order is kept
+         if (sorted.count() < total)
+         {
+            QLog_Warning("Cache", "The in-memory reorder could not place every commit; keeping the current order.");
+            return;
+         }
+
+         mCommits = sorted;
+
+         mShaToRow.clear();
+         mSearchIndex.clear();
+
+         for (auto row = 0; row < total; ++row)
+            mShaToRow.insert(CommitInfo::toRawSha(mCommits.at(row)->sha()), row);
+
+         rebuildColumns();
+
+         mLanes.clear();
+         mLaneGeneration.ref();
+      }
+
+      // Relaunched outside the locked scope: launchLanesCalculation drains the previous lanes
+      // worker, which needs the lock to notice it was superseded
+      launchLanesCalculation();
+
+      emit signalCommitsResorted();
+   });
+}
+
+bool GitCache::isSameGraph(const QList<CommitInfo> &commits) const
+{
+   if (mCommits.count() <= 1 || commits.count() + 1 != mCommits.count())
+      return false;
+
+   for (auto row = 1; row < mCommits.count(); ++row)
+   {
+      const auto commit = mCommits.at(row);
+
+      if (!commit || commit->sha() != commits.at(row - 1).sha())
+         return false;
    }
+
+   return true;
 }
 
 CommitInfo GitCache::commitInfo(int row)
 {
-   QMutexLocker lock(&mMutex);
+   QReadLocker lock(&mMutex);
 
    const auto commit = row >= 0 && row < mCommits.count() ? mCommits.at(row) : nullptr;
 
@@ -96,86 +471,263 @@ CommitInfo GitCache::commitInfo(int row)
 
 int GitCache::commitPos(const QString &sha)
 {
-   QMutexLocker lock(&mMutex);
+   QReadLocker lock(&mMutex);
 
+   if (sha.count() == 40)
+   {
+      if (const auto row = mShaToRow.value(CommitInfo::toRawSha(sha), -1); row != -1)
+         return row;
+   }
+
+   // Abbreviated shas still need the linear scan over the graph
    const auto iter = std::find_if(mCommitsMap.begin(), mCommitsMap.end(),
-                                  [sha](const CommitInfo &commit) { return commit.sha().startsWith(sha); });
+                                  [sha](const CommitInfo *commit) { return commit->sha().startsWith(sha); });
 
    if (iter != mCommitsMap.end())
-      return mCommits.indexOf(&iter.value());
+      return mCommits.indexOf(iter.value());
 
    return -1;
 }
 
-auto GitCache::searchCommit(const QString &text, const int startingPoint) const
+void GitCache::ensureSearchIndex()
 {
-   return std::find_if(mCommits.constBegin() + startingPoint, mCommits.constEnd(),
-                       [text](CommitInfo *info) { return info->contains(text); });
+   if (mSearchIndex.count() == mCommits.count())
+      return;
+
+   QLog_Debug("Cache", "Building the commit search index.");
+
+   mSearchIndex.resize(mCommits.count());
+
+   // Only the message goes into the per-row haystack; the author/committer side of the search is
+   // answered through the identity column, once per unique identity instead of once per row
+   for (auto row = 0; row < mCommits.count(); ++row)
+   {
+      const auto commit = mCommits.at(row);
+
+      mSearchIndex[row] = commit ? commit->shortLog().toLower() : QString();
+   }
 }
 
-auto GitCache::reverseSearchCommit(const QString &text, int startingPoint) const
+void GitCache::ensureShaIndex()
 {
-   const auto startEndPos = startingPoint > 0 ? mCommits.count() - startingPoint + 1 : 0;
+   if (mSortedShas.count() == mCommits.count())
+      return;
+
+   QLog_Debug("Cache", "Building the sorted sha index.");
+
+   mSortedShas.clear();
+   mSortedShas.reserve(mCommits.count());
 
-   return std::find_if(mCommits.crbegin() + startEndPos, mCommits.crend(),
-                       [text](CommitInfo *info) { return info->contains(text); });
+   for (const auto commit : qAsConst(mCommits))
+   {
+      if (commit)
+         mSortedShas.append(commit->sha());
+   }
+
+   std::sort(mSortedShas.begin(), mSortedShas.end());
+}
+
+QStringList GitCache::shasStartingWith(const QString &prefix, int maxCount)
+{
+   QWriteLocker lock(&mMutex);
+
+   ensureShaIndex();
+
+   QStringList shas;
+   const auto lowered = prefix.toLower();
+
+   // The sorted table turns the prefix query into a binary search plus a walk over the matching
+   // range, instead of the linear scan the abbreviated-sha paths pay
+   for (auto iter = std::lower_bound(mSortedShas.cbegin(), mSortedShas.cend(), lowered);
+        iter != mSortedShas.cend() && iter->startsWith(lowered) && shas.count() < maxCount; ++iter)
+      shas.append(*iter);
+
+   return shas;
 }
 
 CommitInfo GitCache::searchCommitInfo(const QString &text, int startingPoint, bool reverse)
 {
-   QMutexLocker lock(&mMutex);
-   CommitInfo commit;
+   QWriteLocker lock(&mMutex);
+
+   ensureSearchIndex();
+
+   const auto needle = text.toLower();
+   const auto total = mCommits.count();
+
+   const auto identityMatches = matchingIdentities(needle);
+
+   const auto matches = [this, &needle, &identityMatches](int row) {
+      const auto id = mIdentityColumn.at(row);
+
+      return mSearchIndex.at(row).contains(needle) || (id >= 0 && identityMatches.testBit(id))
+          || mCommits.at(row)->sha().startsWith(needle, Qt::CaseInsensitive);
+   };
 
    if (!reverse)
    {
-      auto commitIter = searchCommit(text, startingPoint);
-
-      if (commitIter == mCommits.constEnd())
-         commitIter = searchCommit(text);
+      for (auto row = startingPoint; row < total; ++row)
+      {
+         if (matches(row))
+            return *mCommits.at(row);
+      }
 
-      if (commitIter != mCommits.constEnd())
-         commit = **commitIter;
+      for (auto row = 0; row < startingPoint && row < total; ++row)
+      {
+         if (matches(row))
+            return *mCommits.at(row);
+      }
    }
    else
    {
-      auto commitIter = reverseSearchCommit(text, startingPoint);
+      const auto start = startingPoint > 0 ? qMin(startingPoint, total - 1) : total - 1;
+
+      for (auto row = start; row >= 0; --row)
+      {
+         if (matches(row))
+            return *mCommits.at(row);
+      }
 
-      if (commitIter == mCommits.crend())
-         commitIter = reverseSearchCommit(text);
+      for (auto row = total - 1; row > start; --row)
+      {
+         if (matches(row))
+            return *mCommits.at(row);
+      }
+   }
+
+   return CommitInfo();
+}
+
+QBitArray GitCache::searchMatches(const QString &text)
+{
+   QWriteLocker lock(&mMutex);
+
+   ensureSearchIndex();
+
+   const auto needle = text.toLower();
+   QBitArray matches(mCommits.count());
+
+   if (needle.isEmpty())
+      return matches;
+
+   const auto identityMatches = matchingIdentities(needle);
+
+   for (auto row = 0; row < mCommits.count(); ++row)
+   {
+      const auto id = mIdentityColumn.at(row);
 
-      if (commitIter != mCommits.crend())
-         commit = **commitIter;
+      if (mCommits.at(row)
+          && (mSearchIndex.at(row).contains(needle) || (id >= 0 && identityMatches.testBit(id))
+              || mCommits.at(row)->sha().startsWith(needle, Qt::CaseInsensitive)))
+         matches.setBit(row);
    }
 
-   return commit;
+   return matches;
+}
+
+QBitArray GitCache::searchMatchesRegex(const QString &pattern)
+{
+   QWriteLocker lock(&mMutex);
+
+   ensureSearchIndex();
+
+   const auto total = mCommits.count();
+   QBitArray matches(total);
+
+   QRegularExpression regex(pattern, QRegularExpression::CaseInsensitiveOption);
+
+   if (total == 0 || !regex.isValid())
+      return matches;
+
+   /* The pattern is compiled (and JIT-ed) once and shared by every worker: matching against a
+    * QRegularExpression is const and thread-safe, so the message column is partitioned into
+    * per-thread chunks and each worker fills its own bitset, merged at the end. */
+   regex.optimize();
+
+   const auto chunkSize = qMax(1, total / qMax(1, QThread::idealThreadCount()));
+
+   QVector<QPair<int, int>> chunks;
+
+   for (auto start = 0; start < total; start += chunkSize)
+      chunks.append(qMakePair(start, qMin(start + chunkSize, total)));
+
+   const auto chunkMatches = QtConcurrent::blockingMapped<QVector<QBitArray>>(
+       chunks, [this, &regex, total](const QPair<int, int> &range) {
+          QBitArray partial(total);
+
+          for (auto row = range.first; row < range.second; ++row)
+          {
+             if (regex.match(mSearchIndex.at(row)).hasMatch())
+                partial.setBit(row);
+          }
+
+          return partial;
+       });
+
+   for (const auto &partial : chunkMatches)
+      matches |= partial;
+
+   return matches;
+}
+
+QBitArray GitCache::matchingIdentities(const QString &needle) const
+{
+   // The repository has a handful of unique identities, so the author/committer side of a search
+   // costs one substring test per identity and a bit test per row afterwards
+   QBitArray matches(mIdentities.count());
+
+   for (auto id = 0; id < mIdentities.count(); ++id)
+      matches.setBit(id, mIdentities.at(id).contains(needle));
+
+   return matches;
 }
 
 bool GitCache::isCommitInCurrentGeneologyTree(const QString &sha) const
 {
-   return checkSha(sha, CommitInfo::ZERO_SHA);
+   if (mGenealogyDirty)
+      rebuildCurrentGenealogy();
+
+   return mCurrentGenealogy.contains(CommitInfo::toRawSha(sha));
 }
 
-CommitInfo GitCache::commitInfo(const QString &sha)
+void GitCache::rebuildCurrentGenealogy() const
 {
-   QMutexLocker lock(&mMutex);
+   /* The full ancestry of the WIP is collected once and kept as a set, so the reachability test is
+    * a single hash lookup until the graph or the WIP change. Every parent is followed, matching
+    * what git log over the current branch shows: commits brought in through the second parent of a
+    * merge belong to the tree as well. */
+   mCurrentGenealogy.clear();
 
-   if (!sha.isEmpty())
+   const auto rawWipSha = CommitInfo::toRawSha(CommitInfo::ZERO_SHA);
+   mCurrentGenealogy.insert(rawWipSha);
+
+   if (const auto wip = mCommitsMap.value(rawWipSha, nullptr))
    {
-      const auto c = mCommitsMap.value(sha, CommitInfo());
+      const auto ancestors = collectAncestors(wip);
 
-      if (!c.isValid())
-      {
-         const auto shas = mCommitsMap.keys();
-         const auto it = std::find_if(shas.cbegin(), shas.cend(),
-                                      [sha](const QString &shaToCompare) { return shaToCompare.startsWith(sha); });
+      for (const auto commit : ancestors)
+         mCurrentGenealogy.insert(CommitInfo::toRawSha(commit->sha()));
+   }
 
-         if (it != shas.cend())
-            return mCommitsMap.value(*it);
+   mGenealogyDirty = false;
+}
 
-         return CommitInfo();
+CommitInfo GitCache::commitInfo(const QString &sha)
+{
+   QReadLocker lock(&mMutex);
+
+   if (!sha.isEmpty())
+   {
+      if (sha.count() == 40)
+      {
+         if (const auto c = mCommitsMap.value(CommitInfo::toRawSha(sha), nullptr))
+            return *c;
       }
 
-      return c;
+      const auto it = std::find_if(mCommitsMap.cbegin(), mCommitsMap.cend(),
+                                   [&sha](const CommitInfo *commit) { return commit->sha().startsWith(sha); });
+
+      if (it != mCommitsMap.cend())
+         return **it;
    }
 
    return CommitInfo();
@@ -183,15 +735,77 @@ CommitInfo GitCache::commitInfo(const QString &sha)
 
 RevisionFiles GitCache::revisionFile(const QString &sha1, const QString &sha2) const
 {
-   const auto iter = mRevisionFilesMap.constFind(qMakePair(sha1, sha2));
+   const auto key = qMakePair(sha1, sha2);
+   const auto iter = mRevisionFilesMap.constFind(key);
+
+   if (iter != mRevisionFilesMap.cend())
+   {
+      touchRevisionFile(key);
+
+      return *iter;
+   }
+
+   return RevisionFiles();
+}
+
+quint64 GitCache::commitsMemoryUsage()
+{
+   QReadLocker lock(&mMutex);
+
+   auto bytes = static_cast<quint64>(mCommits.capacity()) * sizeof(CommitInfo *);
+   bytes += static_cast<quint64>(mChildsArena.capacity()) * sizeof(CommitInfo *);
+   bytes += static_cast<quint64>(mCommitsMap.capacity()) * (sizeof(QByteArray) + sizeof(CommitInfo *));
+   bytes += static_cast<quint64>(mShaToRow.capacity()) * (sizeof(QByteArray) + sizeof(int));
 
-   return iter != mRevisionFilesMap.cend() ? *iter : RevisionFiles();
+   for (const auto commit : qAsConst(mCommits))
+   {
+      if (commit)
+         bytes += commit->memoryUsage();
+   }
+
+   return bytes;
+}
+
+quint64 GitCache::revisionFilesMemoryUsage()
+{
+   QReadLocker lock(&mMutex);
+
+   quint64 bytes = 0;
+
+   for (auto iter = mRevisionFilesMap.cbegin(); iter != mRevisionFilesMap.cend(); ++iter)
+   {
+      bytes += static_cast<quint64>(iter.key().first.capacity() + iter.key().second.capacity()) * sizeof(QChar);
+      bytes += iter->memoryUsage();
+   }
+
+   return bytes;
+}
+
+void GitCache::clearRevisionFiles()
+{
+   QWriteLocker lock(&mMutex);
+
+#ifdef ALLOC_TRACKING
+   for (const auto &file : qAsConst(mRevisionFilesMap))
+      AllocationTracker::instance()->recordFree("GitCache::revisionFiles", file.memoryUsage());
+#endif
+
+   mRevisionFilesMap.clear();
+   mRevisionFilesUsage.clear();
+}
+
+void GitCache::touchRevisionFile(const QPair<QString, QString> &key) const
+{
+   mRevisionFilesUsage.removeOne(key);
+   mRevisionFilesUsage.prepend(key);
 }
 
 void GitCache::clearReferences()
 {
-   QMutexLocker lock(&mMutex);
+   QWriteLocker lock(&mMutex);
    mReferences.clear();
+   mReferenceShaIndex.clear();
+   mReferenceGeneration.ref();
 }
 
 void GitCache::insertWipRevision(const WipRevisionInfo &wipInfo)
@@ -200,6 +814,14 @@ void GitCache::insertWipRevision(const WipRevisionInfo &wipInfo)
 
    QLog_Debug("Cache", QString("Updating the WIP commit. The actual parent has SHA {%1}.").arg(newParentSha));
 
+   const auto previousWip = mCommits[0] && mCommits[0]->sha() == CommitInfo::ZERO_SHA ? mCommits[0] : nullptr;
+   const auto parentUnchanged
+       = previousWip && previousWip->parentsCount() > 0 && previousWip->parent(0) == newParentSha;
+
+   // A new WIP may sit on a different HEAD, which starts a different genealogy chain
+   if (!parentUnchanged)
+      mGenealogyDirty = true;
+
    const auto key = qMakePair(CommitInfo::ZERO_SHA, newParentSha);
    const auto fakeRevFile = fakeWorkDirRevFile(wipInfo.diffIndex, wipInfo.diffIndexCached);
 
@@ -212,21 +834,34 @@ void GitCache::insertWipRevision(const WipRevisionInfo &wipInfo)
    if (!newParentSha.isEmpty())
       parents.append(newParentSha);
 
-   CommitInfo c(CommitInfo::ZERO_SHA, parents, QChar(), QStringLiteral("-"), QDateTime::currentDateTime(),
+   CommitInfo c(CommitInfo::ZERO_SHA, parents, QChar(), QStringLiteral("-"), QDateTime::currentSecsSinceEpoch(),
                 QStringLiteral("-"), log);
 
-   if (mLanes.isEmpty())
-      mLanes.init(c.sha());
+   // With the same parent the lane layout cannot move, so the stored lane vector is reused and
+   // the recomputation is skipped entirely
+   if (parentUnchanged)
+      c.setLanes(previousWip->getLanes());
+   else
+   {
+      if (mLanes.isEmpty())
+         mLanes.init(c.sha());
+
+      c.setLanes(calculateLanes(c, mLanes));
 
-   c.setLanes(calculateLanes(c));
+      if (mCommits[0])
+         c.setLanes(mCommits[0]->getLanes());
+   }
 
-   if (mCommits[0])
-      c.setLanes(mCommits[0]->getLanes());
+   const auto rawSha = CommitInfo::toRawSha(c.sha());
+   auto &storedCommit = mCommitsMap[rawSha];
 
-   const auto sha = c.sha();
+   if (storedCommit)
+      *storedCommit = std::move(c);
+   else
+      storedCommit = mCommitArena.append(std::move(c));
 
-   mCommitsMap.insert(sha, std::move(c));
-   mCommits[0] = &mCommitsMap[sha];
+   mCommits[0] = storedCommit;
+   mShaToRow.insert(rawSha, 0);
 }
 
 bool GitCache::insertRevisionFile(const QString &sha1, const QString &sha2, const RevisionFiles &file)
@@ -239,7 +874,29 @@ bool GitCache::insertRevisionFile(const QString &sha1, const QString &sha2, cons
    {
       QLog_Debug("Cache", QString("Adding the revisions files between {%1} and {%2}.").arg(sha1, sha2));
 
+      if (const auto iter = mRevisionFilesMap.constFind(key); iter != mRevisionFilesMap.cend())
+         GQ_TRACK_FREE("GitCache::revisionFiles", iter->memoryUsage());
+
+      GQ_TRACK_ALLOC("GitCache::revisionFiles", file.memoryUsage());
+
       mRevisionFilesMap.insert(key, file);
+      touchRevisionFile(key);
+
+      // Keep the diff cache within budget evicting the least recently used entries; the WIP entry
+      // is pinned since the commit widgets rely on it permanently
+      for (auto i = mRevisionFilesUsage.count() - 1; i >= 0 && mRevisionFilesUsage.count() > MaxRevisionFiles; --i)
+      {
+         const auto evictionKey = mRevisionFilesUsage.at(i);
+
+         if (evictionKey.first == CommitInfo::ZERO_SHA)
+            continue;
+
+         mRevisionFilesUsage.removeAt(i);
+
+         GQ_TRACK_FREE("GitCache::revisionFiles", mRevisionFilesMap.value(evictionKey).memoryUsage());
+
+         mRevisionFilesMap.remove(evictionKey);
+      }
 
       return true;
    }
@@ -249,107 +906,244 @@ bool GitCache::insertRevisionFile(const QString &sha1, const QString &sha2, cons
 
 void GitCache::insertReference(const QString &sha, References::Type type, const QString &reference)
 {
-   QMutexLocker lock(&mMutex);
+   QWriteLocker lock(&mMutex);
 
    QLog_Debug("Cache", QString("Adding a new reference with SHA {%1}.").arg(sha));
 
-   mReferences[sha].addReference(type, reference);
+   const auto rawSha = CommitInfo::toRawSha(sha);
+
+   mReferences[rawSha].addReference(type, reference);
+   mReferenceShaIndex.insert(reference, rawSha);
+   mReferenceGeneration.ref();
 }
 
 bool GitCache::hasReferences(const QString &sha) const
 {
-   return mReferences.contains(sha) && !mReferences.value(sha).isEmpty();
+   const auto iter = mReferences.constFind(CommitInfo::toRawSha(sha));
+
+   return iter != mReferences.cend() && !iter->isEmpty();
 }
 
 QStringList GitCache::getReferences(const QString &sha, References::Type type) const
 {
-   return mReferences.value(sha).getReferences(type);
+   return mReferences.value(CommitInfo::toRawSha(sha)).getReferences(type);
 }
 
-void GitCache::reloadCurrentBranchInfo(const QString &currentBranch, const QString &currentSha)
+void GitCache::removeReference(References::Type type, const QString &reference)
 {
-   const auto lastItem = mReferences.end();
-   for (auto ref = mReferences.begin(); ref != lastItem; ++ref)
+   QWriteLocker lock(&mMutex);
+
+   QLog_Debug("Cache", QString("Removing the reference {%1}.").arg(reference));
+
+   if (const auto rawSha = mReferenceShaIndex.take(reference); !rawSha.isEmpty())
    {
-      if (ref.value().getReferences(References::Type::LocalBranch).contains(currentBranch))
+      if (const auto iter = mReferences.find(rawSha); iter != mReferences.end())
       {
-         ref.value().removeReference(References::Type::LocalBranch, currentBranch);
+         iter->removeReference(type, reference);
 
-         const auto key = ref.key();
+         if (iter->isEmpty())
+            mReferences.erase(iter);
+      }
 
-         if (mReferences.value(key).isEmpty())
-            mReferences.remove(key);
+      mReferenceGeneration.ref();
+   }
+}
+
+QString GitCache::getShaOfReference(const QString &referenceName) const
+{
+   const auto rawSha = mReferenceShaIndex.value(referenceName);
+
+   return rawSha.isEmpty() ? QString() : QString::fromLatin1(rawSha.toHex());
+}
+
+int GitCache::referenceGeneration() const
+{
+   return mReferenceGeneration.loadAcquire();
+}
+
+void GitCache::reloadCurrentBranchInfo(const QString &currentBranch, const QString &currentSha)
+{
+   // The inverse index points straight to the sha holding the branch, so the old decoration is
+   // removed without scanning the whole table
+   if (const auto oldRawSha = mReferenceShaIndex.value(currentBranch); !oldRawSha.isEmpty())
+   {
+      if (const auto iter = mReferences.find(oldRawSha); iter != mReferences.end())
+      {
+         iter->removeReference(References::Type::LocalBranch, currentBranch);
 
-         break;
+         if (iter->isEmpty())
+            mReferences.erase(iter);
       }
    }
 
-   mReferences[currentSha].addReference(References::Type::LocalBranch, currentBranch);
+   const auto rawSha = CommitInfo::toRawSha(currentSha);
+
+   mReferences[rawSha].addReference(References::Type::LocalBranch, currentBranch);
+   mReferenceShaIndex.insert(currentBranch, rawSha);
+   mReferenceGeneration.ref();
 }
 
 bool GitCache::updateWipCommit(const WipRevisionInfo &wipInfo)
 {
-   if (mConfigured)
    {
+      // The WIP refresh rewrites mCommits[0] and drives the lane state machine, so it takes the
+      // write lock against the background lanes and reorder workers
+      QWriteLocker lock(&mMutex);
+
+      if (!mConfigured)
+         return false;
+
       insertWipRevision(wipInfo);
-      return true;
    }
 
-   return false;
+   emit signalWipUpdated();
+
+   return true;
+}
+
+bool GitCache::updateWipFileStatus(const QString &file, const QString &fileDiffIndex,
+                                   const QString &fileDiffIndexCached)
+{
+   // The per-file refresh rewrites the WIP diff entry, so it takes the write lock against the
+   // background lanes and reorder workers like the full WIP update does
+   QWriteLocker lock(&mMutex);
+
+   if (!mConfigured || mCommits.isEmpty() || !mCommits[0] || mCommits[0]->sha() != CommitInfo::ZERO_SHA)
+      return false;
+
+   const auto parentSha
+       = mCommits[0]->parentsCount() > 0 ? mCommits[0]->parent(0) : QString(CommitInfo::INIT_SHA);
+   const auto key = qMakePair(QString(CommitInfo::ZERO_SHA), parentSha);
+   const auto iter = mRevisionFilesMap.constFind(key);
+
+   if (iter == mRevisionFilesMap.cend())
+      return false;
+
+   auto rf = iter.value();
+
+   // The scoped rows go through the same parser as the full WIP pass, so the merged status
+   // matches what a complete rebuild would produce for this file
+   const RevisionFiles fileRow(fileDiffIndex);
+   const RevisionFiles cachedRow(fileDiffIndexCached, true);
+
+   const auto rowIdx = fileRow.indexOfFile(file);
+   const auto pos = rf.indexOfFile(file);
+
+   if (rowIdx == -1)
+   {
+      // The file no longer differs from HEAD
+      if (pos != -1 && !mUntrackedfiles.contains(file))
+         rf.removeFile(pos);
+   }
+   else
+   {
+      auto status = fileRow.getStatus(rowIdx);
+
+      if (const auto cachedIdx = cachedRow.indexOfFile(file); cachedIdx != -1)
+      {
+         if (cachedRow.statusCmp(cachedIdx, RevisionFiles::CONFLICT))
+            status |= RevisionFiles::CONFLICT;
+         else if (cachedRow.statusCmp(cachedIdx, RevisionFiles::MODIFIED)
+                  && cachedRow.statusCmp(cachedIdx, RevisionFiles::IN_INDEX))
+            status |= RevisionFiles::PARTIALLY_CACHED;
+         else if (cachedRow.statusCmp(cachedIdx, RevisionFiles::IN_INDEX))
+            status |= RevisionFiles::IN_INDEX;
+      }
+
+      if (pos != -1)
+         rf.setStatus(pos, static_cast<RevisionFiles::StatusFlag>(status));
+      else
+      {
+         rf.appendFile(file, 1);
+         rf.setStatus(rf.count() - 1, static_cast<RevisionFiles::StatusFlag>(status));
+      }
+
+      // Once part of the file is in the index it is tracked from git's point of view
+      mUntrackedfiles.removeOne(file);
+   }
+
+   insertRevisionFile(CommitInfo::ZERO_SHA, parentSha, rf);
+
+   // The memoized full-rebuild entry no longer corresponds to its input digest
+   mWipInputsDigest.clear();
+   mWipRevFileCache = rf;
+
+   lock.unlock();
+
+   emit signalWipUpdated();
+
+   return true;
 }
 
-QVector<Lane> GitCache::calculateLanes(const CommitInfo &c)
+QVector<Lane> GitCache::calculateLanes(const CommitInfo &c, Lanes &lanes)
 {
    const auto sha = c.sha();
 
    QLog_Trace("Cache", QString("Updating the lanes for SHA {%1}.").arg(sha));
 
    bool isDiscontinuity;
-   bool isFork = mLanes.isFork(sha, isDiscontinuity);
+   bool isFork = lanes.isFork(sha, isDiscontinuity);
    bool isMerge = c.parentsCount() > 1;
 
    if (isDiscontinuity)
-      mLanes.changeActiveLane(sha); // uses previous isBoundary state
+      lanes.changeActiveLane(sha); // uses previous isBoundary state
 
    if (isFork)
-      mLanes.setFork(sha);
+      lanes.setFork(sha);
    if (isMerge)
-      mLanes.setMerge(c.parents());
+      lanes.setMerge(c.parents());
    if (c.parentsCount() == 0)
-      mLanes.setInitial();
+      lanes.setInitial();
 
-   const auto lanes = mLanes.getLanes();
+   const auto result = lanes.getLanes();
 
-   resetLanes(c, isFork);
+   resetLanes(c, isFork, lanes);
 
-   return lanes;
+   return result;
 }
 
 bool GitCache::pendingLocalChanges()
 {
-   QMutexLocker lock(&mMutex);
+   QWriteLocker lock(&mMutex);
    auto localChanges = false;
 
-   const auto commit = mCommitsMap.value(CommitInfo::ZERO_SHA, CommitInfo());
+   const auto commit = mCommitsMap.value(CommitInfo::toRawSha(CommitInfo::ZERO_SHA), nullptr);
 
-   if (commit.isValid())
+   if (commit && commit->isValid())
    {
-      const auto rf = revisionFile(CommitInfo::ZERO_SHA, commit.parent(0));
+      const auto rf = revisionFile(CommitInfo::ZERO_SHA, commit->parent(0));
       localChanges = rf.count() - mUntrackedfiles.count() > 0;
    }
 
    return localChanges;
 }
 
-QVector<QPair<QString, QStringList>> GitCache::getBranches(References::Type type)
+QSharedPointer<const QVector<QPair<QString, QStringList>>> GitCache::getBranchesSnapshot(References::Type type)
 {
-   QMutexLocker lock(&mMutex);
-   QVector<QPair<QString, QStringList>> branches;
+   QWriteLocker lock(&mMutex);
+
+   const auto generation = mReferenceGeneration.loadAcquire();
+   auto &snapshot = mBranchesSnapshots[static_cast<int>(type)];
 
-   for (const auto &ref : mReferences.toStdMap())
-      branches.append(QPair<QString, QStringList>(ref.first, ref.second.getReferences(type)));
+   if (!snapshot.branches || snapshot.generation != generation)
+   {
+      const auto branches = QSharedPointer<QVector<QPair<QString, QStringList>>>::create();
+      branches->reserve(mReferences.count());
+
+      for (auto iter = mReferences.cbegin(); iter != mReferences.cend(); ++iter)
+         branches->append(
+             QPair<QString, QStringList>(QString::fromLatin1(iter.key().toHex()), iter->getReferences(type)));
+
+      snapshot.branches = branches;
+      snapshot.generation = generation;
+   }
 
-   return branches;
+   return snapshot.branches;
+}
+
+QVector<QPair<QString, QStringList>> GitCache::getBranches(References::Type type)
+{
+   return *getBranchesSnapshot(type);
 }
 
 QMap<QString, QString> GitCache::getTags(References::Type tagType) const
@@ -358,12 +1152,12 @@ QMap<QString, QString> GitCache::getTags(References::Type tagType) const
 
    if (tagType == References::Type::LocalTag)
    {
-      for (auto &reference : mReferences.toStdMap())
+      for (auto iter = mReferences.cbegin(); iter != mReferences.cend(); ++iter)
       {
-         const auto tagNames = reference.second.getReferences(tagType);
+         const auto tagNames = iter->getReferences(tagType);
 
          for (const auto &tag : tagNames)
-            tags[tag] = reference.first;
+            tags[tag] = QString::fromLatin1(iter.key().toHex());
       }
    }
    else
@@ -374,37 +1168,30 @@ QMap<QString, QString> GitCache::getTags(References::Type tagType) const
 
 void GitCache::updateTags(const QMap<QString, QString> &remoteTags)
 {
+   // Every fetch re-delivers the full remote tag list; when nothing changed the update is
+   // dropped so no UI refresh ripples from it.
+   if (mRemoteTags == remoteTags)
+      return;
+
    mRemoteTags = remoteTags;
 
    emit signalCacheUpdated();
 }
 
-void GitCache::resetLanes(const CommitInfo &c, bool isFork)
+void GitCache::resetLanes(const CommitInfo &c, bool isFork, Lanes &lanes)
 {
    const auto nextSha = c.parentsCount() == 0 ? QString() : c.parent(0);
 
-   mLanes.nextParent(nextSha);
+   lanes.nextParent(nextSha);
 
    if (c.parentsCount() > 1)
-      mLanes.afterMerge();
+      lanes.afterMerge();
    if (isFork)
-      mLanes.afterFork();
-   if (mLanes.isBranch())
-      mLanes.afterBranch();
+      lanes.afterFork();
+   if (lanes.isBranch())
+      lanes.afterBranch();
 }
 
-bool GitCache::checkSha(const QString &originalSha, const QString &currentSha) const
-{
-   if (originalSha == currentSha)
-      return true;
-   else
-   {
-      if (const auto iter = mCommitsMap.find(currentSha); iter != mCommitsMap.cend())
-         return checkSha(originalSha, iter->parent(0));
-
-      return false;
-   }
-}
 
 int GitCache::commitCount() const
 {
@@ -413,21 +1200,37 @@ int GitCache::commitCount() const
 
 RevisionFiles GitCache::fakeWorkDirRevFile(const QString &diffIndex, const QString &diffIndexCache)
 {
+   QCryptographicHash hasher(QCryptographicHash::Sha1);
+   hasher.addData(reinterpret_cast<const char *>(diffIndex.constData()),
+                  diffIndex.size() * static_cast<int>(sizeof(QChar)));
+   hasher.addData(reinterpret_cast<const char *>(diffIndexCache.constData()),
+                  diffIndexCache.size() * static_cast<int>(sizeof(QChar)));
+
+   for (const auto &it : qAsConst(mUntrackedfiles))
+   {
+      hasher.addData("\n", 1);
+      hasher.addData(reinterpret_cast<const char *>(it.constData()), it.size() * static_cast<int>(sizeof(QChar)));
+   }
+
+   const auto digest = hasher.result();
+
+   if (digest == mWipInputsDigest)
+      return mWipRevFileCache;
+
    RevisionFiles rf(diffIndex);
    rf.setOnlyModified(false);
 
    for (const auto &it : qAsConst(mUntrackedfiles))
    {
-      rf.mFiles.append(it);
+      rf.appendFile(it, 1);
       rf.setStatus(RevisionFiles::UNKNOWN);
-      rf.mergeParent.append(1);
    }
 
    RevisionFiles cachedFiles(diffIndexCache, true);
 
    for (auto i = 0; i < rf.count(); i++)
    {
-      if (const auto cachedIndex = cachedFiles.mFiles.indexOf(rf.getFile(i)); cachedIndex != -1)
+      if (const auto cachedIndex = cachedFiles.indexOfFile(rf.getFile(i)); cachedIndex != -1)
       {
          if (cachedFiles.statusCmp(cachedIndex, RevisionFiles::CONFLICT))
             rf.appendStatus(i, RevisionFiles::CONFLICT);
@@ -439,6 +1242,9 @@ RevisionFiles GitCache::fakeWorkDirRevFile(const QString &diffIndex, const QStri
       }
    }
 
+   mWipInputsDigest = digest;
+   mWipRevFileCache = rf;
+
    return rf;
 }
 
@@ -446,3 +1252,139 @@ void GitCache::setUntrackedFilesList(const QVector<QString> &untrackedFiles)
 {
    mUntrackedfiles = untrackedFiles;
 }
+
+QVector<QString> GitCache::getUntrackedFiles() const
+{
+   return mUntrackedfiles;
+}
+
+void GitCache::updateBranchDistances(const QMap<QString, LocalBranchDistances> &distances)
+{
+   QWriteLocker lock(&mMutex);
+
+   mBranchDistances = distances;
+}
+
+GitCache::LocalBranchDistances GitCache::getBranchDistances(const QString &branchName) const
+{
+   return mBranchDistances.value(branchName, LocalBranchDistances());
+}
+
+QSet<const CommitInfo *> GitCache::collectAncestors(const CommitInfo *tip) const
+{
+   static const auto rawInitSha = CommitInfo::toRawSha(CommitInfo::INIT_SHA);
+
+   QSet<const CommitInfo *> ancestors;
+   QVector<const CommitInfo *> pending { tip };
+   ancestors.insert(tip);
+
+   while (!pending.isEmpty())
+   {
+      const auto commit = pending.takeLast();
+      const auto parents = commit->rawParents();
+      const auto count = parents.count() / CommitInfo::RAW_SHA_LENGTH;
+
+      for (auto i = 0; i < count; ++i)
+      {
+         const auto rawSha = parents.mid(i * CommitInfo::RAW_SHA_LENGTH, CommitInfo::RAW_SHA_LENGTH);
+
+         if (rawSha == rawInitSha)
+            continue;
+
+         if (const auto parent = mCommitsMap.value(rawSha, nullptr); parent && !ancestors.contains(parent))
+         {
+            ancestors.insert(parent);
+            pending.append(parent);
+         }
+      }
+   }
+
+   return ancestors;
+}
+
+void GitCache::setCommitGraphReader(const QSharedPointer<CommitGraphReader> &reader)
+{
+   QWriteLocker lock(&mMutex);
+
+   mCommitGraph = reader;
+}
+
+bool GitCache::isCommitReachableFrom(const QString &ancestorSha, const QString &tipSha)
+{
+   QReadLocker lock(&mMutex);
+
+   const auto rawTip = CommitInfo::toRawSha(tipSha);
+   const auto rawAncestor = CommitInfo::toRawSha(ancestorSha);
+   const auto tip = mCommitsMap.value(rawTip, nullptr);
+   const auto ancestor = mCommitsMap.value(rawAncestor, nullptr);
+
+   if (!tip || !ancestor)
+      return false;
+
+   if (tip == ancestor)
+      return true;
+
+   // An ancestor always sits at a strictly lower topological level than its descendants, so the
+   // commit-graph rules out reachability without walking the ancestry. A level of 0 means the
+   // commit is newer than the graph file and the walk below decides.
+   if (mCommitGraph)
+   {
+      const auto tipLevel = mCommitGraph->generation(rawTip);
+      const auto ancestorLevel = mCommitGraph->generation(rawAncestor);
+
+      if (tipLevel != 0 && ancestorLevel != 0 && ancestorLevel >= tipLevel)
+         return false;
+   }
+
+   return collectAncestors(tip).contains(ancestor);
+}
+
+QString GitCache::getMergeBase(const QString &shaA, const QString &shaB)
+{
+   QReadLocker lock(&mMutex);
+
+   const auto commitA = mCommitsMap.value(CommitInfo::toRawSha(shaA), nullptr);
+   const auto commitB = mCommitsMap.value(CommitInfo::toRawSha(shaB), nullptr);
+
+   if (!commitA || !commitB)
+      return QString();
+
+   auto common = collectAncestors(commitA);
+   common.intersect(collectAncestors(commitB));
+
+   // The log is ordered newest first, so the common ancestor with the lowest row
+   // is the closest one to both tips: the same heuristic git merge-base applies.
+   const CommitInfo *base = nullptr;
+   auto bestRow = mCommits.count();
+
+   for (const auto commit : qAsConst(common))
+   {
+      const auto row = mShaToRow.value(CommitInfo::toRawSha(commit->sha()), -1);
+
+      if (row != -1 && row < bestRow)
+      {
+         bestRow = row;
+         base = commit;
+      }
+   }
+
+   return base ? base->sha() : QString();
+}
+
+QPair<int, int> GitCache::getDistance(const QString &shaA, const QString &shaB)
+{
+   QReadLocker lock(&mMutex);
+
+   const auto commitA = mCommitsMap.value(CommitInfo::toRawSha(shaA), nullptr);
+   const auto commitB = mCommitsMap.value(CommitInfo::toRawSha(shaB), nullptr);
+
+   if (!commitA || !commitB)
+      return qMakePair(0, 0);
+
+   const auto ancestorsA = collectAncestors(commitA);
+   const auto ancestorsB = collectAncestors(commitB);
+   auto common = ancestorsA;
+   common.intersect(ancestorsB);
+
+   return qMakePair(ancestorsA.count() - common.count(), ancestorsB.count() - common.count());
+}
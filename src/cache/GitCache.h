@@ -24,14 +24,19 @@
  ***************************************************************************************/
 
 #include <CommitInfo.h>
+#include <CommitInfoArena.h>
 #include <RevisionFiles.h>
 #include <lanes.h>
 
+#include <QBitArray>
+#include <QFuture>
 #include <QHash>
-#include <QMutex>
 #include <QObject>
+#include <QReadWriteLock>
+#include <QSet>
 #include <QSharedPointer>
 
+class CommitGraphReader;
 struct WipRevisionInfo;
 
 class GitCache : public QObject
@@ -40,6 +45,24 @@ class GitCache : public QObject
 
 signals:
    void signalCacheUpdated();
+   /**
+    * @brief signalWipUpdated Emitted when only the WIP row changed, so the views repaint that
+    * single row instead of running a full refresh.
+    */
+   void signalWipUpdated();
+   /**
+    * @brief signalRowsUpdated Emitted when a range of existing rows changed in place, currently
+    * by the batches of the background lanes calculation. The views map it to a targeted repaint
+    * of that range, keeping selection and scroll position untouched.
+    * @param firstRow The first changed row.
+    * @param lastRow The last changed row.
+    */
+   void signalRowsUpdated(int firstRow, int lastRow);
+   /**
+    * @brief signalCommitsResorted Emitted when @ref resortCommits finished permuting the rows, so
+    * the views refresh their content for the new order.
+    */
+   void signalCommitsResorted();
 
 public:
    struct LocalBranchDistances
@@ -59,6 +82,33 @@ public:
 
    CommitInfo searchCommitInfo(const QString &text, int startingPoint = 0, bool reverse = false);
 
+   /**
+    * @brief searchMatches Resolves every row whose commit matches the given text into a bitset,
+    * one bit per row. The view consults it with a constant-cost test per painted row to tint the
+    * matches and to draw the match marks of the scrollbar.
+    * @param text The text to search for.
+    * @return The bitset with the matching rows set.
+    */
+   QBitArray searchMatches(const QString &text);
+
+   /**
+    * @brief searchMatchesRegex Resolves every row whose commit message matches the given regular
+    * expression into a bitset. The pattern is compiled once with the JIT enabled and matched over
+    * the dense message column in parallel chunks, so regex searches stay usable on huge logs.
+    * @param pattern The regular expression pattern.
+    * @return The bitset with the matching rows set; empty bits for an invalid pattern.
+    */
+   QBitArray searchMatchesRegex(const QString &pattern);
+
+   /**
+    * @brief shasStartingWith Returns the shas that start with the given hex prefix, resolved over
+    * a sorted sha table with a binary search instead of scanning the graph.
+    * @param prefix The hex prefix to match.
+    * @param maxCount The maximum number of shas to return.
+    * @return The matching shas.
+    */
+   QStringList shasStartingWith(const QString &prefix, int maxCount);
+
    bool isCommitInCurrentGeneologyTree(const QString &sha) const;
 
    bool insertRevisionFile(const QString &sha1, const QString &sha2, const RevisionFiles &file);
@@ -68,41 +118,184 @@ public:
    void insertReference(const QString &sha, References::Type type, const QString &reference);
    bool hasReferences(const QString &sha) const;
    QStringList getReferences(const QString &sha, References::Type type) const;
+   /**
+    * @brief getShaOfReference Resolves the sha the given reference name points to through the
+    * inverse index, without walking the reference table.
+    * @param referenceName The reference name (branch or tag).
+    * @return The sha of the reference or an empty string when unknown.
+    */
+   QString getShaOfReference(const QString &referenceName) const;
+   /**
+    * @brief removeReference Drops the given reference from the table and the inverse index. Used
+    * to delta-update the cache when references are deleted without reloading the repository.
+    * @param type The type of reference.
+    * @param reference The reference name.
+    */
+   void removeReference(References::Type type, const QString &reference);
+   int referenceGeneration() const;
 
    void reloadCurrentBranchInfo(const QString &currentBranch, const QString &currentSha);
 
    bool updateWipCommit(const WipRevisionInfo &wipInfo);
+   /**
+    * @brief updateWipFileStatus Delta-updates the status of a single file inside the cached WIP
+    * revision from file-scoped diff-index outputs, so staging or unstaging a hunk doesn't pay a
+    * full working-tree re-diff.
+    * @param file The file path relative to the working dir.
+    * @param fileDiffIndex The output of git diff-index scoped to the file.
+    * @param fileDiffIndexCached The output of git diff-index --cached scoped to the file.
+    * @return True if the WIP revision was present and got updated.
+    */
+   bool updateWipFileStatus(const QString &file, const QString &fileDiffIndex, const QString &fileDiffIndexCached);
 
    void setUntrackedFilesList(const QVector<QString> &untrackedFiles);
+   QVector<QString> getUntrackedFiles() const;
    bool pendingLocalChanges();
 
+   /**
+    * @brief getBranchesSnapshot Returns a shared, immutable snapshot of the branches of the given
+    * type. The snapshot is stamped with the reference generation it was taken at and rebuilt only
+    * when the references changed since, so the widgets refreshing from it share one vector instead
+    * of deep-copying the branch names on every refresh.
+    * @param type The type of branch: local or remote.
+    * @return The shared vector of sha and branch names pairs.
+    */
+   QSharedPointer<const QVector<QPair<QString, QStringList>>> getBranchesSnapshot(References::Type type);
    QVector<QPair<QString, QStringList>> getBranches(References::Type type);
    QMap<QString, QString> getTags(References::Type tagType) const;
 
    void updateTags(const QMap<QString, QString> &remoteTags);
 
+   void updateBranchDistances(const QMap<QString, LocalBranchDistances> &distances);
+   LocalBranchDistances getBranchDistances(const QString &branchName) const;
+
+   /**
+    * @brief commitsMemoryUsage Estimates the heap bytes held by the commits and their lookup
+    * tables. Reported to the MemoryTracker for the diagnostics panel.
+    * @return The estimated size in bytes.
+    */
+   quint64 commitsMemoryUsage();
+   /**
+    * @brief revisionFilesMemoryUsage Estimates the heap bytes held by the revision files cache.
+    * @return The estimated size in bytes.
+    */
+   quint64 revisionFilesMemoryUsage();
+   /**
+    * @brief clearRevisionFiles Drops the cached revision files. The entries are fetched again the
+    * next time a commit is selected, so purging only costs a refetch.
+    */
+   void clearRevisionFiles();
+
+   /**
+    * @brief setCommitGraphReader Hands the cache the mapped commit-graph file of the repository,
+    * when one exists. Its topological levels answer most negative reachability queries without
+    * walking the ancestry.
+    * @param reader The mapped commit-graph reader.
+    */
+   void setCommitGraphReader(const QSharedPointer<CommitGraphReader> &reader);
+
+   /**
+    * @brief resortCommits Recomputes the row order of the cached commits for the given sorting
+    * mode without re-running git log. The permutation is computed on a worker over the cached DAG
+    * and the lanes are recalculated for the new order, so switching the mode in the settings is a
+    * near-instant swap instead of a full reload.
+    * @param order The GraphSortingOrder setting: 0 author-date, 1 date, 2 topological.
+    */
+   void resortCommits(int order);
+
+   bool isCommitReachableFrom(const QString &ancestorSha, const QString &tipSha);
+   QString getMergeBase(const QString &shaA, const QString &shaB);
+   QPair<int, int> getDistance(const QString &shaA, const QString &shaB);
+
 private:
    friend class GitRepoLoader;
+   friend class GitQlientBench;
 
-   QMutex mMutex;
+   QReadWriteLock mMutex;
    bool mConfigured = true;
    QVector<CommitInfo *> mCommits;
-   QHash<QString, CommitInfo> mCommitsMap;
-   QMultiMap<QString, CommitInfo *> mTmpChildsStorage;
+   CommitInfoArena mCommitArena;
+   QHash<QByteArray, CommitInfo *> mCommitsMap;
+   QHash<QByteArray, int> mShaToRow;
+   QVector<QString> mSearchIndex;
+   QVector<QString> mSortedShas;
+   /* Column-oriented copies of the sortable commit fields, indexed by row and rebuilt with the
+    * graph: the reorder and search scans walk these dense vectors instead of chasing the scattered
+    * CommitInfo objects. The identity column is an id into the unique identity table, so a search
+    * resolves the author/committer match once per identity instead of once per row. */
+   QVector<qint64> mEpochColumn;
+   QVector<int> mIdentityColumn;
+   QVector<QString> mIdentities;
+   QVector<CommitInfo *> mChildsArena;
    QHash<QPair<QString, QString>, RevisionFiles> mRevisionFilesMap;
+   mutable QList<QPair<QString, QString>> mRevisionFilesUsage;
+   // Lane state machine of the WIP refresh; the background lanes worker walks the graph with its
+   // own local state so the two never share it
    Lanes mLanes;
+   QAtomicInt mLaneGeneration;
+   QFuture<void> mLanesFuture;
+   QFuture<void> mResortFuture;
    QVector<QString> mUntrackedfiles;
-   QMap<QString, References> mReferences;
+   QByteArray mWipInputsDigest;
+   RevisionFiles mWipRevFileCache;
+   // The references are keyed by the raw 20-byte sha in a flat hash; the inverse index resolves
+   // a reference name to its sha without walking the table
+   QHash<QByteArray, References> mReferences;
+   QHash<QString, QByteArray> mReferenceShaIndex;
+   /**
+    * @brief The BranchesSnapshot struct holds the shared branch vector handed out by @ref
+    * getBranchesSnapshot together with the reference generation it was built from; a stale stamp
+    * triggers a rebuild, otherwise the same vector is shared again.
+    */
+   struct BranchesSnapshot
+   {
+      int generation = -1;
+      QSharedPointer<const QVector<QPair<QString, QStringList>>> branches;
+   };
+   QHash<int, BranchesSnapshot> mBranchesSnapshots;
+   QAtomicInt mReferenceGeneration;
+   mutable QSet<QByteArray> mCurrentGenealogy;
+   mutable bool mGenealogyDirty = true;
    QMap<QString, QString> mRemoteTags;
+   QMap<QString, LocalBranchDistances> mBranchDistances;
+   QSharedPointer<CommitGraphReader> mCommitGraph;
+   int mCommitsTrackerId = -1;
+   int mRevisionFilesTrackerId = -1;
 
    void setup(const WipRevisionInfo &wipInfo, const QList<CommitInfo> &commits);
+   bool isSameGraph(const QList<CommitInfo> &commits) const;
+   void wireChildren();
+   /**
+    * @brief rebuildColumns Regenerates the column-oriented copies of the sortable commit fields
+    * after the rows were built or permuted, keeping the columns aligned with the row order.
+    */
+   void rebuildColumns();
+   /**
+    * @brief matchingIdentities Resolves which unique identities contain the given lowered needle,
+    * as a bitset indexed by identity id.
+    * @param needle The lowered text to search for.
+    * @return The bitset with the matching identities set.
+    */
+   QBitArray matchingIdentities(const QString &needle) const;
+   void launchLanesCalculation();
    void setConfigurationDone() { mConfigured = true; }
 
+   QSet<const CommitInfo *> collectAncestors(const CommitInfo *tip) const;
    void insertWipRevision(const WipRevisionInfo &wipInfo);
+   /**
+    * @brief fakeWorkDirRevFile Builds the RevisionFiles of the WIP commit from the raw diff-index
+    * outputs. The inputs are hashed together with the untracked list and the parse is skipped in
+    * favour of the previous result when the digest matches, so the periodic WIP refreshes of an
+    * idle tree only pay the hash.
+    * @param diffIndex The git diff-index output.
+    * @param diffIndexCache The git diff-index --cached output.
+    * @return The RevisionFiles of the WIP commit.
+    */
    RevisionFiles fakeWorkDirRevFile(const QString &diffIndex, const QString &diffIndexCache);
-   QVector<Lane> calculateLanes(const CommitInfo &c);
-   auto searchCommit(const QString &text, int startingPoint = 0) const;
-   auto reverseSearchCommit(const QString &text, int startingPoint = 0) const;
-   void resetLanes(const CommitInfo &c, bool isFork);
-   bool checkSha(const QString &originalSha, const QString &currentSha) const;
+   QVector<Lane> calculateLanes(const CommitInfo &c, Lanes &lanes);
+   void ensureSearchIndex();
+   void ensureShaIndex();
+   void touchRevisionFile(const QPair<QString, QString> &key) const;
+   void resetLanes(const CommitInfo &c, bool isFork, Lanes &lanes);
+   void rebuildCurrentGenealogy() const;
 };
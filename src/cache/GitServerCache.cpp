@@ -2,32 +2,195 @@
 
 #include <GitQlientSettings.h>
 #include <GitConfig.h>
+#include <GitHubGraphQlApi.h>
 #include <GitHubRestApi.h>
 #include <GitLabRestApi.h>
+#include <GitServerCacheSnapshot.h>
+#include <GitServerEventFeed.h>
+#include <IRestApi.h>
 
 #include <Label.h>
+#include <MemoryTracker.h>
 #include <Milestone.h>
 
+#include <QTimer>
+
 using namespace GitServer;
 
+namespace
+{
+enum PrPart
+{
+   PrComments = 1 << 0,
+   PrReviews = 1 << 1,
+   PrCodeReviews = 1 << 2,
+   PrAllParts = PrComments | PrReviews | PrCodeReviews
+};
+}
+
 GitServerCache::GitServerCache(QObject *parent)
    : QObject(parent)
 {
+   mTrackerId = MemoryTracker::instance()->add(
+       tr("Git server data"), [this]() { return memoryUsage(); }, [this]() { purge(); });
+
+   mPrPartsFallback = new QTimer(this);
+   mPrPartsFallback->setSingleShot(true);
+   mPrPartsFallback->setInterval(1000);
+   connect(mPrPartsFallback, &QTimer::timeout, this, [this]() {
+      if (!mPrPartsReceived.isEmpty())
+      {
+         mPrPartsReceived.clear();
+         emit prReviewsReceived();
+      }
+   });
+}
+
+GitServerCache::~GitServerCache()
+{
+   /* An empty store isn't saved: it would wipe a valid snapshot after an offline session. */
+   if (!mSnapshotPath.isEmpty() && (!mIssues.isEmpty() || !mPullRequests.isEmpty()))
+   {
+      GitServerCacheSnapshot(mSnapshotPath)
+          .save(mIssues.values().toVector(), mPullRequests.values().toVector(), mLabels, mMilestones);
+   }
+
+   MemoryTracker::instance()->remove(mTrackerId);
+}
+
+quint64 GitServerCache::memoryUsage() const
+{
+   const auto issueBytes = [](const GitServer::Issue &issue) {
+      auto bytes = static_cast<quint64>(issue.title.capacity() + issue.url.capacity()) * sizeof(QChar);
+      bytes += static_cast<quint64>(issue.body.capacity());
+
+      for (const auto &comment : issue.comments)
+         bytes += sizeof(GitServer::Comment) + static_cast<quint64>(comment.body.capacity()) * sizeof(QChar);
+
+      return bytes;
+   };
+
+   quint64 bytes = 0;
+
+   for (const auto &pr : mPullRequests)
+      bytes += sizeof(GitServer::PullRequest) + issueBytes(pr);
+
+   for (const auto &issue : mIssues)
+      bytes += sizeof(GitServer::Issue) + issueBytes(issue);
+
+   return bytes;
 }
 
-GitServerCache::~GitServerCache() { }
+void GitServerCache::purge()
+{
+   mPullRequests.clear();
+   mIssues.clear();
+
+   rebuildIndexes(mPullRequests, mPullRequestsIndexes);
+   rebuildIndexes(mIssues, mIssuesIndexes);
+}
 
-bool GitServerCache::init(const QString &serverUrl, const QPair<QString, QString> &repoInfo)
+template<typename T>
+void GitServerCache::rebuildIndexes(const QMap<int, T> &items, ItemIndexes &indexes)
+{
+   indexes.byCreation.clear();
+   indexes.byLabel.clear();
+   indexes.byAssignee.clear();
+   indexes.byMilestone.clear();
+
+   indexes.byCreation.reserve(items.count());
+
+   const auto end = items.cend();
+
+   for (auto iter = items.cbegin(); iter != end; ++iter)
+      indexes.byCreation.append(iter.key());
+
+   std::sort(indexes.byCreation.begin(), indexes.byCreation.end(),
+             [&items](int n1, int n2) { return items.constFind(n1)->creation > items.constFind(n2)->creation; });
+
+   /* The buckets are filled following the creation order so an index lookup already returns the
+    * numbers in the order the lists show them. */
+   for (const auto number : qAsConst(indexes.byCreation))
+   {
+      const auto &item = *items.constFind(number);
+
+      for (const auto &label : item.labels)
+         indexes.byLabel[label.name].append(number);
+
+      for (const auto &assignee : item.assignees)
+         indexes.byAssignee[assignee.name].append(number);
+
+      if (item.milestone.id != -1)
+         indexes.byMilestone[item.milestone.id].append(number);
+   }
+}
+
+template<typename T>
+QVector<T> GitServerCache::itemsForNumbers(const QMap<int, T> &items, const QVector<int> &numbers)
+{
+   QVector<T> result;
+   result.reserve(numbers.count());
+
+   for (const auto number : numbers)
+      result.append(items.value(number));
+
+   return result;
+}
+
+bool GitServerCache::init(const QString &serverUrl, const QPair<QString, QString> &repoInfo,
+                          const QString &snapshotDir)
 {
    mInit = true;
 
+   if (!snapshotDir.isEmpty())
+   {
+      mSnapshotPath = snapshotDir;
+
+      QVector<Issue> issues;
+      QVector<PullRequest> prs;
+
+      /* The snapshot warm-starts the views; the fetch triggered below refreshes the data in the
+       * background and overwrites the stored items as the replies come in. */
+      if (GitServerCacheSnapshot(snapshotDir).load(issues, prs, mLabels, mMilestones))
+      {
+         for (const auto &issue : qAsConst(issues))
+            mIssues.insert(issue.number, issue);
+
+         for (const auto &pr : qAsConst(prs))
+            mPullRequests.insert(pr.number, pr);
+
+         rebuildIndexes(mIssues, mIssuesIndexes);
+         rebuildIndexes(mPullRequests, mPullRequestsIndexes);
+      }
+   }
+
    GitQlientSettings settings;
    const auto userName = settings.globalValue(QString("%1/user").arg(serverUrl)).toString();
    const auto userToken = settings.globalValue(QString("%1/token").arg(serverUrl)).toString();
    const auto endpoint = settings.globalValue(QString("%1/endpoint").arg(serverUrl)).toString();
 
    if (serverUrl.contains("github"))
-      mApi.reset(new GitHubRestApi(repoInfo.first, repoInfo.second, { userName, userToken, endpoint }));
+   {
+      /* The GraphQL backend batches the read flows into single queries and is opt-in per server
+       * through the ServerConfigDlg. */
+      if (settings.globalValue(QString("%1/graphql").arg(serverUrl), false).toBool())
+         mApi.reset(new GitHubGraphQlApi(repoInfo.first, repoInfo.second, { userName, userToken, endpoint }));
+      else
+         mApi.reset(new GitHubRestApi(repoInfo.first, repoInfo.second, { userName, userToken, endpoint }));
+
+      /* The event feed turns server events into targeted refreshes instead of re-fetching on a
+       * fixed timer. It only exists for GitHub and can be switched off per server. */
+      if (settings.globalValue(QString("%1/eventFeed").arg(serverUrl), true).toBool())
+      {
+         mEventFeed = new GitServerEventFeed(repoInfo.first, repoInfo.second, { userName, userToken, endpoint }, this);
+
+         connect(mEventFeed, &GitServerEventFeed::issueCommented, this,
+                 [this](int number) { mApi->requestComments(number); });
+         connect(mEventFeed, &GitServerEventFeed::issuesChanged, this, [this]() { mApi->requestIssues(); });
+         connect(mEventFeed, &GitServerEventFeed::pullRequestsChanged, this,
+                 [this]() { mApi->requestPullRequests(); });
+      }
+   }
    else if (serverUrl.contains("gitlab"))
       mApi.reset(new GitLabRestApi(userName, repoInfo.second, serverUrl, { userName, userToken, endpoint }));
    else
@@ -63,12 +226,37 @@ QString GitServerCache::getUserName() const
 
 QVector<PullRequest> GitServerCache::getPullRequests() const
 {
-   auto pullRequests = mPullRequests.values();
+   return itemsForNumbers(mPullRequests, mPullRequestsIndexes.byCreation);
+}
 
-   std::sort(pullRequests.begin(), pullRequests.end(),
-             [](const PullRequest &p1, const PullRequest &p2) { return p1.creation > p2.creation; });
+QVector<Issue> GitServerCache::getIssuesByLabel(const QString &label) const
+{
+   return itemsForNumbers(mIssues, mIssuesIndexes.byLabel.value(label));
+}
+
+QVector<Issue> GitServerCache::getIssuesByAssignee(const QString &assignee) const
+{
+   return itemsForNumbers(mIssues, mIssuesIndexes.byAssignee.value(assignee));
+}
 
-   return pullRequests.toVector();
+QVector<Issue> GitServerCache::getIssuesByMilestone(int milestoneId) const
+{
+   return itemsForNumbers(mIssues, mIssuesIndexes.byMilestone.value(milestoneId));
+}
+
+QVector<PullRequest> GitServerCache::getPullRequestsByLabel(const QString &label) const
+{
+   return itemsForNumbers(mPullRequests, mPullRequestsIndexes.byLabel.value(label));
+}
+
+QVector<PullRequest> GitServerCache::getPullRequestsByAssignee(const QString &assignee) const
+{
+   return itemsForNumbers(mPullRequests, mPullRequestsIndexes.byAssignee.value(assignee));
+}
+
+QVector<PullRequest> GitServerCache::getPullRequestsByMilestone(int milestoneId) const
+{
+   return itemsForNumbers(mPullRequests, mPullRequestsIndexes.byMilestone.value(milestoneId));
 }
 
 void GitServerCache::onConnectionTested()
@@ -80,6 +268,11 @@ void GitServerCache::onConnectionTested()
    mApi->requestIssues();
    mApi->requestPullRequests();
 
+   /* The first poll only primes the event cursor, so the feed can start together with the
+    * initial fetch without duplicating it. */
+   if (mEventFeed)
+      mEventFeed->start();
+
    /*
    connect(mApi.get(), &IRestApi::milestonesReceived, this, [](){});
    connect(mApi.get(), &IRestApi::milestonesReceived, this, [](){});
@@ -90,6 +283,8 @@ void GitServerCache::onIssueUpdated(const Issue &issue)
 {
    mIssues[issue.number] = issue;
 
+   rebuildIndexes(mIssues, mIssuesIndexes);
+
    emit issueUpdated(issue);
 }
 
@@ -97,6 +292,8 @@ void GitServerCache::onPRUpdated(const PullRequest &pr)
 {
    mPullRequests[pr.number] = pr;
 
+   rebuildIndexes(mPullRequests, mPullRequestsIndexes);
+
    emit prUpdated(pr);
 }
 
@@ -110,7 +307,7 @@ void GitServerCache::onCommentsReceived(int number, const QVector<Comment> &comm
    else if (mPullRequests.contains(number))
    {
       mPullRequests[number].comments = comments;
-      emit prReviewsReceived();
+      markPrPartReceived(number, PrComments);
    }
 }
 
@@ -123,9 +320,9 @@ void GitServerCache::onCodeReviewsReceived(int number, const QVector<GitServer::
          if (!mPullRequests[number].reviewComment.contains(cReview))
             mPullRequests[number].reviewComment.append(cReview);
       }
-   }
 
-   emit prReviewsReceived();
+      markPrPartReceived(number, PrCodeReviews);
+   }
 }
 
 void GitServerCache::onCommentReviewsReceived(int number, const QMap<int, GitServer::Review> &commentReviews)
@@ -137,27 +334,54 @@ void GitServerCache::onCommentReviewsReceived(int number, const QMap<int, GitSer
       for (auto iter = commentReviews.cbegin(); iter != end; ++iter)
          mPullRequests[number].reviews.insert(iter.key(), iter.value());
 
+      markPrPartReceived(number, PrReviews);
+   }
+}
+
+void GitServerCache::markPrPartReceived(int number, int part)
+{
+   mPrPartsReceived[number] |= part;
+
+   if (mPrPartsReceived[number] == PrAllParts)
+   {
+      mPrPartsReceived.remove(number);
+
+      if (mPrPartsReceived.isEmpty())
+         mPrPartsFallback->stop();
+
       emit prReviewsReceived();
    }
+   else
+      mPrPartsFallback->start();
 }
 
 void GitServerCache::onCommitsReceived(int number, const QVector<GitServer::Commit> &commits, int currentPage,
                                        int lastPage)
 {
+   Q_UNUSED(lastPage)
+
    if (mPullRequests.contains(number))
    {
+      auto &pr = mPullRequests[number];
+
       if (currentPage == 1)
-         mPullRequests[number].commits.clear();
+         pr.commits.clear();
 
       for (auto &commit : commits)
       {
-         if (!mPullRequests[number].commits.contains(commit))
-            mPullRequests[number].commits.append(commit);
+         if (!pr.commits.contains(commit))
+            pr.commits.append(commit);
       }
-   }
 
-   if (currentPage == lastPage)
-      emit prUpdated(mPullRequests[number]);
+      // The pages are downloaded concurrently and can land in any order, so the merged list is
+      // kept sorted instead of relying on the arrival sequence
+      std::sort(pr.commits.begin(), pr.commits.end(), [](const GitServer::Commit &c1, const GitServer::Commit &c2) {
+         return c1.authorCommittedTimestamp < c2.authorCommittedTimestamp;
+      });
+
+      // Every page refreshes the view as soon as it lands instead of waiting for the full set
+      emit prUpdated(pr);
+   }
 }
 
 PullRequest GitServerCache::getPullRequest(const QString &sha) const
@@ -173,11 +397,7 @@ PullRequest GitServerCache::getPullRequest(const QString &sha) const
 
 QVector<Issue> GitServerCache::getIssues() const
 {
-   auto issues = mIssues.values();
-
-   std::sort(issues.begin(), issues.end(), [](const Issue &i1, const Issue &i2) { return i1.creation > i2.creation; });
-
-   return issues.toVector();
+   return itemsForNumbers(mIssues, mIssuesIndexes.byCreation);
 }
 
 GitServer::Platform GitServerCache::getPlatform() const
@@ -210,7 +430,15 @@ void GitServerCache::initMilestones(const QVector<Milestone> &milestones)
 void GitServerCache::initIssues(const QVector<Issue> &issues)
 {
    for (auto &issue : issues)
-      mIssues.insert(issue.number, issue);
+   {
+      // Incremental syncs report closed issues too; they are dropped so the cache keeps the open set
+      if (!issue.isOpen)
+         mIssues.remove(issue.number);
+      else
+         mIssues.insert(issue.number, issue);
+   }
+
+   rebuildIndexes(mIssues, mIssuesIndexes);
 
    triggerSignalConditionally();
 
@@ -220,7 +448,14 @@ void GitServerCache::initIssues(const QVector<Issue> &issues)
 void GitServerCache::initPullRequests(const QVector<PullRequest> &prs)
 {
    for (auto &pr : prs)
-      mPullRequests.insert(pr.number, pr);
+   {
+      if (!pr.isOpen)
+         mPullRequests.remove(pr.number);
+      else
+         mPullRequests.insert(pr.number, pr);
+   }
+
+   rebuildIndexes(mPullRequests, mPullRequestsIndexes);
 
    triggerSignalConditionally();
 
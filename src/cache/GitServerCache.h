@@ -24,6 +24,7 @@
  ***************************************************************************************/
 
 #include <QObject>
+#include <QHash>
 #include <QMap>
 #include <QVector>
 
@@ -31,9 +32,12 @@
 #include <Issue.h>
 #include <Platform.h>
 
+class QTimer;
+
 namespace GitServer
 {
 class IRestApi;
+class GitServerEventFeed;
 struct PullRequest;
 struct Issue;
 struct Label;
@@ -57,7 +61,17 @@ public:
    explicit GitServerCache(QObject *parent = nullptr);
    ~GitServerCache();
 
-   bool init(const QString &serverUrl, const QPair<QString, QString> &repoInfo);
+   /**
+    * @brief init Configures the REST API for the given server and repository. When @p snapshotDir
+    * is provided, the issues and pull requests of the previous session are loaded from the on-disk
+    * snapshot before the refresh starts, so the git server views show data instantly.
+    * @param serverUrl The git server url.
+    * @param repoInfo The owner and name of the repository.
+    * @param snapshotDir The directory where the snapshot is stored, usually the git directory.
+    * @return True if the server is supported.
+    */
+   bool init(const QString &serverUrl, const QPair<QString, QString> &repoInfo,
+             const QString &snapshotDir = QString());
 
    QString getUserName() const;
 
@@ -66,24 +80,109 @@ public:
    GitServer::PullRequest getPullRequest(const QString &sha) const;
    QVector<GitServer::Issue> getIssues() const;
    GitServer::Issue getIssue(int number) const { return mIssues.value(number); }
+
+   /**
+    * @brief getIssuesByLabel Returns the issues carrying the given label, newest first. The lookup
+    * hits a maintained index so filtering doesn't scan the whole store.
+    * @param label The label name.
+    * @return The issues with that label.
+    */
+   QVector<GitServer::Issue> getIssuesByLabel(const QString &label) const;
+   /**
+    * @brief getIssuesByAssignee Returns the issues assigned to the given user, newest first.
+    * @param assignee The user name.
+    * @return The issues assigned to that user.
+    */
+   QVector<GitServer::Issue> getIssuesByAssignee(const QString &assignee) const;
+   /**
+    * @brief getIssuesByMilestone Returns the issues attached to the given milestone, newest first.
+    * @param milestoneId The milestone id.
+    * @return The issues of that milestone.
+    */
+   QVector<GitServer::Issue> getIssuesByMilestone(int milestoneId) const;
+   /**
+    * @brief getPullRequestsByLabel Returns the pull requests carrying the given label, newest first.
+    * @param label The label name.
+    * @return The pull requests with that label.
+    */
+   QVector<GitServer::PullRequest> getPullRequestsByLabel(const QString &label) const;
+   /**
+    * @brief getPullRequestsByAssignee Returns the pull requests assigned to the given user, newest first.
+    * @param assignee The user name.
+    * @return The pull requests assigned to that user.
+    */
+   QVector<GitServer::PullRequest> getPullRequestsByAssignee(const QString &assignee) const;
+   /**
+    * @brief getPullRequestsByMilestone Returns the pull requests attached to the given milestone, newest first.
+    * @param milestoneId The milestone id.
+    * @return The pull requests of that milestone.
+    */
+   QVector<GitServer::PullRequest> getPullRequestsByMilestone(int milestoneId) const;
+
    QVector<GitServer::Label> getLabels() const { return mLabels; }
    QVector<GitServer::Milestone> getMilestones() const { return mMilestones; }
 
    GitServer::Platform getPlatform() const;
    GitServer::IRestApi *getApi() const;
 
+   /**
+    * @brief memoryUsage Estimates the heap bytes held by the stored pull requests and issues.
+    * Reported to the MemoryTracker for the diagnostics panel.
+    * @return The estimated size in bytes.
+    */
+   quint64 memoryUsage() const;
+   /**
+    * @brief purge Drops the stored pull requests and issues. They are fetched again on the next
+    * refresh of the git server view.
+    */
+   void purge();
+
 private:
+   /**
+    * @brief The ItemIndexes struct holds the secondary indexes of one of the stores. They are
+    * rebuilt whenever the store changes (a network event) so the UI reads are plain lookups.
+    */
+   struct ItemIndexes
+   {
+      QVector<int> byCreation;
+      QHash<QString, QVector<int>> byLabel;
+      QHash<QString, QVector<int>> byAssignee;
+      QHash<int, QVector<int>> byMilestone;
+   };
+
    bool mInit = false;
    int mPreSteps = -1;
    bool mWaitingConfirmation = false;
    QScopedPointer<GitServer::IRestApi> mApi;
+   GitServer::GitServerEventFeed *mEventFeed = nullptr;
    QMap<int, GitServer::PullRequest> mPullRequests;
    QMap<int, GitServer::Issue> mIssues;
+   ItemIndexes mPullRequestsIndexes;
+   ItemIndexes mIssuesIndexes;
    QVector<GitServer::Label> mLabels;
    QVector<GitServer::Milestone> mMilestones;
+   QString mSnapshotPath;
+   int mTrackerId = -1;
+   QHash<int, int> mPrPartsReceived;
+   QTimer *mPrPartsFallback = nullptr;
+
+   template<typename T>
+   static void rebuildIndexes(const QMap<int, T> &items, ItemIndexes &indexes);
+   template<typename T>
+   static QVector<T> itemsForNumbers(const QMap<int, T> &items, const QVector<int> &numbers);
 
    void triggerSignalConditionally();
 
+   /**
+    * @brief markPrPartReceived Records that one of the detail replies of the given pull request
+    * (comments, reviews or code reviews) landed. The three requests travel in parallel, so
+    * prReviewsReceived is emitted once when the last reply arrives instead of once per reply; a
+    * short fallback timer makes sure a failed endpoint doesn't hold back the parts that did land.
+    * @param number The pull request number.
+    * @param part The part that arrived.
+    */
+   void markPrPartReceived(int number, int part);
+
    void onConnectionTested();
    void onIssueUpdated(const GitServer::Issue &issue);
    void onPRUpdated(const GitServer::PullRequest &pr);
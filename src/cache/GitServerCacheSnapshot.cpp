@@ -0,0 +1,148 @@
+#include "GitServerCacheSnapshot.h"
+
+#include <QLogger.h>
+
+#include <QDataStream>
+#include <QFile>
+
+using namespace QLogger;
+using namespace GitServer;
+
+/* The operators live in the GitServer namespace so the QVector stream operators find them through
+ * argument-dependent lookup. */
+namespace GitServer
+{
+QDataStream &operator<<(QDataStream &out, const User &user)
+{
+   return out << user.id << user.name << user.avatar << user.url << user.type;
+}
+
+QDataStream &operator>>(QDataStream &in, User &user)
+{
+   return in >> user.id >> user.name >> user.avatar >> user.url >> user.type;
+}
+
+QDataStream &operator<<(QDataStream &out, const Label &label)
+{
+   return out << label.id << label.nodeId << label.url << label.name << label.description << label.colorHex
+              << label.isDefault;
+}
+
+QDataStream &operator>>(QDataStream &in, Label &label)
+{
+   return in >> label.id >> label.nodeId >> label.url >> label.name >> label.description >> label.colorHex
+       >> label.isDefault;
+}
+
+QDataStream &operator<<(QDataStream &out, const Milestone &milestone)
+{
+   return out << milestone.id << milestone.number << milestone.nodeId << milestone.title << milestone.description
+              << milestone.isOpen;
+}
+
+QDataStream &operator>>(QDataStream &in, Milestone &milestone)
+{
+   return in >> milestone.id >> milestone.number >> milestone.nodeId >> milestone.title >> milestone.description
+       >> milestone.isOpen;
+}
+
+/* The comments, reviews and commits of an item are left out on purpose: they are fetched on demand
+ * when a thread is opened and would multiply the snapshot size. */
+QDataStream &operator<<(QDataStream &out, const Issue &issue)
+{
+   return out << issue.number << issue.title << issue.body << issue.milestone << issue.labels << issue.creator
+              << issue.assignees << issue.url << issue.creation << issue.commentsCount << issue.isOpen;
+}
+
+QDataStream &operator>>(QDataStream &in, Issue &issue)
+{
+   return in >> issue.number >> issue.title >> issue.body >> issue.milestone >> issue.labels >> issue.creator
+       >> issue.assignees >> issue.url >> issue.creation >> issue.commentsCount >> issue.isOpen;
+}
+
+QDataStream &operator<<(QDataStream &out, const PullRequest &pr)
+{
+   out << static_cast<const Issue &>(pr);
+
+   return out << pr.head << pr.headRepo << pr.headUrl << pr.base << pr.baseRepo << pr.maintainerCanModify << pr.draft
+              << pr.id << pr.url << pr.state.sha << pr.state.state;
+}
+
+QDataStream &operator>>(QDataStream &in, PullRequest &pr)
+{
+   in >> static_cast<Issue &>(pr);
+
+   return in >> pr.head >> pr.headRepo >> pr.headUrl >> pr.base >> pr.baseRepo >> pr.maintainerCanModify >> pr.draft
+       >> pr.id >> pr.url >> pr.state.sha >> pr.state.state;
+}
+}
+
+GitServerCacheSnapshot::GitServerCacheSnapshot(const QString &gitDirPath)
+   : mFilePath(gitDirPath + "/GitQlientServerCache.dat")
+{
+}
+
+bool GitServerCacheSnapshot::save(const QVector<Issue> &issues, const QVector<PullRequest> &prs,
+                                  const QVector<Label> &labels, const QVector<Milestone> &milestones) const
+{
+   QFile file(mFilePath);
+
+   if (!file.open(QIODevice::WriteOnly))
+   {
+      QLog_Warning("Cache", QString("Unable to write the git server snapshot to {%1}.").arg(mFilePath));
+
+      return false;
+   }
+
+   QDataStream out(&file);
+   out.setVersion(QDataStream::Qt_5_9);
+
+   out << MagicNumber << Version;
+   out << labels << milestones << issues << prs;
+
+   QLog_Debug(
+       "Cache",
+       QString("Git server snapshot with {%1} issues and {%2} PRs stored.").arg(issues.count()).arg(prs.count()));
+
+   return true;
+}
+
+bool GitServerCacheSnapshot::load(QVector<Issue> &issues, QVector<PullRequest> &prs, QVector<Label> &labels,
+                                  QVector<Milestone> &milestones) const
+{
+   QFile file(mFilePath);
+
+   if (!file.open(QIODevice::ReadOnly))
+      return false;
+
+   const auto buffer = file.readAll();
+
+   QDataStream in(buffer);
+   in.setVersion(QDataStream::Qt_5_9);
+
+   quint32 magic = 0;
+   quint16 version = 0;
+
+   in >> magic >> version;
+
+   if (magic != MagicNumber || version != Version)
+      return false;
+
+   in >> labels >> milestones >> issues >> prs;
+
+   if (in.status() != QDataStream::Ok)
+   {
+      issues.clear();
+      prs.clear();
+      labels.clear();
+      milestones.clear();
+
+      return false;
+   }
+
+   QLog_Debug(
+       "Cache",
+       QString("Git server snapshot with {%1} issues and {%2} PRs loaded.").arg(issues.count()).arg(prs.count()));
+
+   return true;
+}
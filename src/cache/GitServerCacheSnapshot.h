@@ -0,0 +1,53 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+#include <Issue.h>
+#include <PullRequest.h>
+#include <Label.h>
+#include <Milestone.h>
+
+#include <QString>
+#include <QVector>
+
+/*!
+ \brief Persists the git server data next to the repository configuration so the next session shows
+ yesterday's issues and pull requests instantly while the REST refresh runs in the background.
+*/
+class GitServerCacheSnapshot
+{
+public:
+   explicit GitServerCacheSnapshot(const QString &gitDirPath);
+
+   bool save(const QVector<GitServer::Issue> &issues, const QVector<GitServer::PullRequest> &prs,
+             const QVector<GitServer::Label> &labels, const QVector<GitServer::Milestone> &milestones) const;
+   bool load(QVector<GitServer::Issue> &issues, QVector<GitServer::PullRequest> &prs,
+             QVector<GitServer::Label> &labels, QVector<GitServer::Milestone> &milestones) const;
+
+private:
+   QString mFilePath;
+
+   static const quint32 MagicNumber = 0x47515356;
+   static const quint16 Version = 1;
+};
@@ -0,0 +1,169 @@
+#include "RepositoryStats.h"
+
+#include <GitCache.h>
+#include <PerfProfiler.h>
+#include <TaskPool.h>
+
+#include <QDateTime>
+#include <QSet>
+#include <QtConcurrent/QtConcurrent>
+
+#include <QLogger.h>
+
+using namespace QLogger;
+
+RepositoryStats::RepositoryStats(const QSharedPointer<GitCache> &cache, QObject *parent)
+   : QObject(parent)
+   , mCache(cache)
+{
+}
+
+RepositoryStats::~RepositoryStats()
+{
+   mGeneration.ref();
+   mFuture.waitForFinished();
+}
+
+void RepositoryStats::scheduleUpdate()
+{
+   mGeneration.ref();
+
+   const auto generation = mGeneration.loadAcquire();
+
+   mFuture = QtConcurrent::run(TaskPool::instance()->pool(), [this, generation]() { compute(generation); });
+}
+
+void RepositoryStats::compute(int generation)
+{
+   PerfScopedTimer timer("RepositoryStats::compute", "cache");
+
+   const auto commitCount = mCache->commitCount();
+   const auto references = mCache->referenceGeneration();
+
+   {
+      QMutexLocker guard(&mMutex);
+
+      if (commitCount == mComputedCommits && references == mComputedReferences)
+         return;
+   }
+
+   QLog_Debug("Cache", QString("Computing repository stats for {%1} commits.").arg(commitCount));
+
+   QHash<QString, int> authorCommits;
+   QMap<QString, int> monthCommits;
+
+   // Row 0 holds the WIP commit, so the pass starts at the first real one
+   for (auto row = 1; row < commitCount; ++row)
+   {
+      if (generation != mGeneration.loadAcquire())
+         return;
+
+      const auto commit = mCache->commitInfo(row);
+
+      if (!commit.isValid())
+         continue;
+
+      ++authorCommits[commit.author().split('<').first().trimmed()];
+      ++monthCommits[QDateTime::fromSecsSinceEpoch(commit.authorDateSecs()).toString("yyyy-MM")];
+   }
+
+   QVector<AuthorActivity> contributors;
+   contributors.reserve(authorCommits.count());
+
+   for (auto iter = authorCommits.cbegin(); iter != authorCommits.cend(); ++iter)
+      contributors.append({ iter.key(), iter.value() });
+
+   std::sort(contributors.begin(), contributors.end(), [](const AuthorActivity &a, const AuthorActivity &b) {
+      return a.commits != b.commits ? a.commits > b.commits : a.author < b.author;
+   });
+
+   QVector<QPair<QString, int>> monthlyActivity;
+   const auto months = monthCommits.keys();
+   const auto firstMonth = qMax(0, months.count() - 12);
+
+   for (auto i = firstMonth; i < months.count(); ++i)
+      monthlyActivity.append(qMakePair(months.at(i), monthCommits.value(months.at(i))));
+
+   QVector<BranchActivity> branchActivity;
+   const auto branches = mCache->getBranchesSnapshot(References::Type::LocalBranch);
+
+   for (const auto &pair : *branches)
+   {
+      for (const auto &branch : pair.second)
+      {
+         if (branch.contains("HEAD->"))
+            continue;
+
+         QSet<QString> visited;
+         QVector<QString> pending { pair.first };
+
+         while (!pending.isEmpty())
+         {
+            if (generation != mGeneration.loadAcquire())
+               return;
+
+            const auto sha = pending.takeLast();
+
+            if (visited.contains(sha))
+               continue;
+
+            visited.insert(sha);
+
+            const auto commit = mCache->commitInfo(sha);
+
+            if (!commit.isValid())
+               continue;
+
+            for (const auto &parent : commit.parents())
+               pending.append(parent);
+         }
+
+         branchActivity.append({ branch, visited.count() });
+      }
+   }
+
+   std::sort(branchActivity.begin(), branchActivity.end(), [](const BranchActivity &a, const BranchActivity &b) {
+      return a.commits != b.commits ? a.commits > b.commits : a.branch < b.branch;
+   });
+
+   {
+      QMutexLocker guard(&mMutex);
+
+      mTotalCommits = commitCount > 0 ? commitCount - 1 : 0;
+      mComputedCommits = commitCount;
+      mComputedReferences = references;
+      mContributors = contributors;
+      mMonthlyActivity = monthlyActivity;
+      mBranchActivity = branchActivity;
+   }
+
+   emit statsReady();
+}
+
+int RepositoryStats::totalCommits() const
+{
+   QMutexLocker guard(&mMutex);
+
+   return mTotalCommits;
+}
+
+QVector<RepositoryStats::AuthorActivity> RepositoryStats::contributors() const
+{
+   QMutexLocker guard(&mMutex);
+
+   return mContributors;
+}
+
+QVector<QPair<QString, int>> RepositoryStats::monthlyActivity() const
+{
+   QMutexLocker guard(&mMutex);
+
+   return mMonthlyActivity;
+}
+
+QVector<RepositoryStats::BranchActivity> RepositoryStats::branchActivity() const
+{
+   QMutexLocker guard(&mMutex);
+
+   return mBranchActivity;
+}
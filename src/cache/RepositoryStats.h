@@ -0,0 +1,132 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+#include <QAtomicInt>
+#include <QFuture>
+#include <QMutex>
+#include <QObject>
+#include <QSharedPointer>
+#include <QVector>
+
+class GitCache;
+
+/**
+ * @brief The RepositoryStats class computes repository analytics from the commits already held by
+ * the GitCache: commits per contributor, activity per month and reachable commits per local
+ * branch. Everything is derived from the in-memory DAG on the shared worker pool, so the numbers
+ * come without a single additional git process. A recompute is skipped when neither the commits
+ * nor the references changed, and a newer request supersedes a pass that is still running.
+ */
+class RepositoryStats : public QObject
+{
+   Q_OBJECT
+
+signals:
+   /**
+    * @brief statsReady Emitted from the worker thread when a computation pass finished and the
+    * accessors serve fresh data.
+    */
+   void statsReady();
+
+public:
+   /**
+    * @brief The AuthorActivity struct holds the commit count of one contributor.
+    */
+   struct AuthorActivity
+   {
+      QString author;
+      int commits = 0;
+   };
+
+   /**
+    * @brief The BranchActivity struct holds the number of commits reachable from one local
+    * branch.
+    */
+   struct BranchActivity
+   {
+      QString branch;
+      int commits = 0;
+   };
+
+   /**
+    * @brief Default constructor.
+    * @param cache The internal cache of the current repository.
+    * @param parent The parent object if needed.
+    */
+   explicit RepositoryStats(const QSharedPointer<GitCache> &cache, QObject *parent = nullptr);
+
+   /**
+    * @brief Destructor. Supersedes and waits for the running pass.
+    */
+   ~RepositoryStats() override;
+
+   /**
+    * @brief scheduleUpdate Launches a computation pass on the worker pool. A pass that is already
+    * running is superseded.
+    */
+   void scheduleUpdate();
+
+   /**
+    * @brief totalCommits Gets the number of commits of the last computed pass.
+    * @return The total commit count.
+    */
+   int totalCommits() const;
+   /**
+    * @brief contributors Gets the contributors sorted by their commit count.
+    * @return The contributors and their commit counts.
+    */
+   QVector<AuthorActivity> contributors() const;
+   /**
+    * @brief monthlyActivity Gets the commits per month of the last twelve active months, oldest
+    * first.
+    * @return Pairs of month (yyyy-MM) and commit count.
+    */
+   QVector<QPair<QString, int>> monthlyActivity() const;
+   /**
+    * @brief branchActivity Gets the local branches sorted by the number of commits reachable from
+    * their tip.
+    * @return The branches and their commit counts.
+    */
+   QVector<BranchActivity> branchActivity() const;
+
+private:
+   QSharedPointer<GitCache> mCache;
+   QAtomicInt mGeneration;
+   QFuture<void> mFuture;
+   mutable QMutex mMutex;
+   int mTotalCommits = 0;
+   int mComputedCommits = -1;
+   int mComputedReferences = -1;
+   QVector<AuthorActivity> mContributors;
+   QVector<QPair<QString, int>> mMonthlyActivity;
+   QVector<BranchActivity> mBranchActivity;
+
+   /**
+    * @brief compute Runs one full pass over the cached commits and references. Aborts as soon as
+    * the given generation is superseded.
+    * @param generation The generation this pass was scheduled with.
+    */
+   void compute(int generation);
+};
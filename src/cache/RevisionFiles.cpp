@@ -1,5 +1,7 @@
 #include "RevisionFiles.h"
 
+#include <cstring>
+
 RevisionFiles::RevisionFiles(const QString &diff, bool cached)
 {
    auto parNum = 1;
@@ -16,9 +18,8 @@ RevisionFiles::RevisionFiles(const QString &diff, bool cached)
       {
          if (line[1] == ':')
          {
-            mFiles.append(line.section('\t', -1));
+            appendFile(line.section('\t', -1), parNum);
             setStatus("M");
-            mergeParent.append(parNum);
          }
          else
          {
@@ -29,9 +30,8 @@ RevisionFiles::RevisionFiles(const QString &diff, bool cached)
                auto fileIsCached = !dstSha.startsWith(QStringLiteral("000000"));
                const auto flag = fields.at(4).at(0);
 
-               mFiles.append(line.mid(99));
+               appendFile(line.mid(99), parNum);
                setStatus(flag, cached ? cached : fileIsCached);
-               mergeParent.append(parNum);
             }
             else // It's a rename or a copy, we are not in fast path now!
                setExtStatus(line.mid(97), parNum);
@@ -44,13 +44,13 @@ RevisionFiles::RevisionFiles(const QString &diff, bool cached)
 
 bool RevisionFiles::isValid() const
 {
-   return !(mFiles.empty() && mFileStatus.empty() && mRenamedFiles.empty());
+   return !(mRecords.empty() && mRenamedFiles.empty());
 }
 
 bool RevisionFiles::operator==(const RevisionFiles &revFiles) const
 {
-   return mFiles == revFiles.mFiles && mOnlyModified == revFiles.mOnlyModified && mergeParent == revFiles.mergeParent
-       && mFileStatus == revFiles.mFileStatus && mRenamedFiles == revFiles.mRenamedFiles;
+   return mPathArena == revFiles.mPathArena && mOnlyModified == revFiles.mOnlyModified
+       && mRecords == revFiles.mRecords && mRenamedFiles == revFiles.mRenamedFiles;
 }
 
 bool RevisionFiles::operator!=(const RevisionFiles &revFiles) const
@@ -60,10 +60,10 @@ bool RevisionFiles::operator!=(const RevisionFiles &revFiles) const
 
 bool RevisionFiles::statusCmp(int idx, RevisionFiles::StatusFlag sf) const
 {
-   if (idx >= mFileStatus.count())
+   if (idx >= mRecords.count())
       return false;
 
-   return (mOnlyModified ? MODIFIED : mFileStatus.at(static_cast<int>(idx))) & sf;
+   return (mOnlyModified ? MODIFIED : mRecords.at(idx).status) & sf;
 }
 
 const QString RevisionFiles::extendedStatus(int idx) const
@@ -76,48 +76,101 @@ const QString RevisionFiles::extendedStatus(int idx) const
    return !mRenamedFiles.isEmpty() && idx < mRenamedFiles.count() ? mRenamedFiles.at(idx) : "";
 }
 
+void RevisionFiles::appendFile(const QString &fileName, int parent)
+{
+   const auto utf8 = fileName.toUtf8();
+
+   FileRecord record;
+   record.pathOffset = static_cast<quint32>(mPathArena.size());
+   record.pathLength = static_cast<quint32>(utf8.size());
+   record.mergeParent = static_cast<quint8>(parent);
+
+   mPathArena.append(utf8);
+   mRecords.append(record);
+}
+
+QString RevisionFiles::getFile(int index) const
+{
+   const auto &record = mRecords.at(index);
+
+   return QString::fromUtf8(mPathArena.constData() + record.pathOffset, static_cast<int>(record.pathLength));
+}
+
+QStringList RevisionFiles::getFiles() const
+{
+   QStringList files;
+   files.reserve(mRecords.count());
+
+   for (auto i = 0; i < mRecords.count(); ++i)
+      files.append(getFile(i));
+
+   return files;
+}
+
+int RevisionFiles::indexOfFile(const QString &fileName) const
+{
+   const auto utf8 = fileName.toUtf8();
+
+   for (auto i = 0; i < mRecords.count(); ++i)
+   {
+      const auto &record = mRecords.at(i);
+
+      if (record.pathLength == static_cast<quint32>(utf8.size())
+          && std::memcmp(mPathArena.constData() + record.pathOffset, utf8.constData(), utf8.size()) == 0)
+         return i;
+   }
+
+   return -1;
+}
+
+void RevisionFiles::removeFile(int index)
+{
+   mRecords.remove(index);
+}
+
 void RevisionFiles::setStatus(const QString &rowSt, bool isStaged)
 {
+   auto &status = mRecords.last().status;
+
    switch (rowSt.at(0).toLatin1())
    {
       case 'M':
       case 'T':
-         mFileStatus.append(RevisionFiles::MODIFIED);
+         status = RevisionFiles::MODIFIED;
          if (isStaged)
-            mFileStatus[mFileStatus.count() - 1] |= RevisionFiles::IN_INDEX;
+            status |= RevisionFiles::IN_INDEX;
          break;
       case 'U':
-         mFileStatus.append(RevisionFiles::MODIFIED);
-         mFileStatus[mFileStatus.count() - 1] |= RevisionFiles::CONFLICT;
+         status = RevisionFiles::MODIFIED | RevisionFiles::CONFLICT;
          if (isStaged)
-            mFileStatus[mFileStatus.count() - 1] |= RevisionFiles::IN_INDEX;
+            status |= RevisionFiles::IN_INDEX;
          mOnlyModified = false;
          break;
       case 'D':
-         mFileStatus.append(RevisionFiles::DELETED);
+         status = RevisionFiles::DELETED;
          mOnlyModified = false;
          if (isStaged)
-            mFileStatus[mFileStatus.count() - 1] |= RevisionFiles::IN_INDEX;
+            status |= RevisionFiles::IN_INDEX;
          break;
       case 'A':
-         mFileStatus.append(RevisionFiles::NEW);
+         status = RevisionFiles::NEW;
          mOnlyModified = false;
          if (isStaged)
-            mFileStatus[mFileStatus.count() - 1] |= RevisionFiles::IN_INDEX;
+            status |= RevisionFiles::IN_INDEX;
          break;
       case '?':
-         mFileStatus.append(RevisionFiles::UNKNOWN);
+         status = RevisionFiles::UNKNOWN;
          mOnlyModified = false;
          break;
       default:
-         mFileStatus.append(RevisionFiles::MODIFIED);
+         status = RevisionFiles::MODIFIED;
          break;
    }
 }
 
 void RevisionFiles::setStatus(RevisionFiles::StatusFlag flag)
 {
-   mFileStatus.append(flag);
+   mRecords.last().status = static_cast<quint16>(flag);
 
    if (flag == RevisionFiles::DELETED || flag == RevisionFiles::NEW || flag == RevisionFiles::UNKNOWN)
       mOnlyModified = false;
@@ -125,12 +178,12 @@ void RevisionFiles::setStatus(RevisionFiles::StatusFlag flag)
 
 void RevisionFiles::setStatus(int pos, RevisionFiles::StatusFlag flag)
 {
-   mFileStatus[pos] = flag;
+   mRecords[pos].status = static_cast<quint16>(flag);
 }
 
 void RevisionFiles::appendStatus(int pos, RevisionFiles::StatusFlag flag)
 {
-   mFileStatus[pos] |= flag;
+   mRecords[pos].status |= static_cast<quint16>(flag);
 }
 
 void RevisionFiles::setExtStatus(const QString &rowSt, int parNum)
@@ -151,16 +204,14 @@ void RevisionFiles::setExtStatus(const QString &rowSt, int parNum)
    const QString &dest = sl[2];
    const QString extStatusInfo(orig + " --> " + dest + " (" + QString::number(type.toInt()) + "%)");
 
-   mFiles.append(dest);
-   mergeParent.append(parNum);
+   appendFile(dest, parNum);
    setStatus(RevisionFiles::NEW);
    appendExtStatus(extStatusInfo);
 
    // simulate deleted orig file only in case of rename
    if (type.at(0) == 'R')
    {
-      mFiles.append(orig);
-      mergeParent.append(parNum);
+      appendFile(orig, parNum);
       setStatus(RevisionFiles::DELETED);
       appendExtStatus(extStatusInfo);
    }
@@ -27,38 +27,92 @@ public:
    bool operator==(const RevisionFiles &revFiles) const;
    bool operator!=(const RevisionFiles &revFiles) const;
 
-   QVector<int> mergeParent;
-   QVector<QString> mFiles;
-
    // helper functions
-   int count() const { return mFiles.count(); }
+   int count() const { return mRecords.count(); }
    bool statusCmp(int idx, StatusFlag sf) const;
    const QString extendedStatus(int idx) const;
    void setStatus(const QString &rowSt, bool isStaged = false);
    void setStatus(RevisionFiles::StatusFlag flag);
    void setStatus(int pos, RevisionFiles::StatusFlag flag);
    void appendStatus(int pos, RevisionFiles::StatusFlag flag);
-   int getStatus(int pos) const { return mFileStatus.at(pos); }
+   int getStatus(int pos) const { return mRecords.at(pos).status; }
    void setOnlyModified(bool onlyModified) { mOnlyModified = onlyModified; }
-   int getFilesCount() const { return mFileStatus.size(); }
+   int getFilesCount() const { return mRecords.size(); }
    void appendExtStatus(const QString &file) { mRenamedFiles.append(file); }
-   QString getFile(int index) const { return mFiles.at(index); }
-   QStringList getFiles() const { return mFiles.toList(); }
-   bool containsFile(const QString &fileName) { return mFiles.contains(fileName); }
+
+   /**
+    * @brief appendFile Appends a file record. The path bytes are stored in the shared contiguous
+    * arena; the status of the new record is empty until the next setStatus call.
+    * @param fileName The file path.
+    * @param parent The merge parent the file belongs to.
+    */
+   void appendFile(const QString &fileName, int parent);
+   QString getFile(int index) const;
+   QStringList getFiles() const;
+   /**
+    * @brief indexOfFile Returns the record index of the given file or -1 when not present. The
+    * comparison runs over the path arena without materialising the stored paths.
+    * @param fileName The file path to look for.
+    * @return The index of the file.
+    */
+   int indexOfFile(const QString &fileName) const;
+   bool containsFile(const QString &fileName) const { return indexOfFile(fileName) != -1; }
+   /**
+    * @brief removeFile Drops the record at the given index. The path bytes stay in the arena
+    * until the next full rebuild, which keeps the removal O(records) without reindexing the
+    * remaining offsets.
+    * @param index The record index to remove.
+    */
+   void removeFile(int index);
+
+   /**
+    * @brief memoryUsage Approximates the heap bytes held by the file lists. Used by the memory
+    * diagnostics to size the revision files cache.
+    * @return The estimated size in bytes.
+    */
+   quint64 memoryUsage() const
+   {
+      auto bytes = static_cast<quint64>(sizeof(RevisionFiles));
+      bytes += static_cast<quint64>(mPathArena.capacity());
+      bytes += static_cast<quint64>(mRecords.capacity()) * sizeof(FileRecord);
+
+      for (const auto &file : mRenamedFiles)
+         bytes += sizeof(QString) + static_cast<quint64>(file.capacity()) * sizeof(QChar);
+
+      return bytes;
+   }
 
 private:
-   // Status information is split in a flags vector and in a string
-   // vector in 'status' are stored flags according to the info returned
-   // by 'git diff-tree' without -C option.
-   // In case of a working directory file an IN_INDEX flag is or-ed together in
-   // case file is present in git index.
-   // If file is renamed or copied an entry in 'extStatus' stores the
-   // value returned by 'git diff-tree -C' plus source and destination
-   // files info.
-   // When status of all the files is 'modified' then onlyModified is
-   // set, this let us to do some optimization in this common case
+   /**
+    * @brief The FileRecord struct is the per-file entry of a revision: the offset and length of
+    * the UTF-8 path inside the shared arena, the status bits and the merge parent. One compact
+    * record replaces a heap string plus two parallel vector entries, so caching the revision
+    * files of big commits costs a fraction of the memory and iterating the list stays within a
+    * couple of contiguous allocations.
+    *
+    * The status bits follow the info returned by 'git diff-tree' without the -C option. For a
+    * working directory file an IN_INDEX flag is or-ed in when the file is present in the git
+    * index. If a file is renamed or copied, an entry in mRenamedFiles stores the value returned
+    * by 'git diff-tree -C' plus source and destination info. When the status of all the files is
+    * 'modified', mOnlyModified is set, which allows some optimization in this common case.
+    */
+   struct FileRecord
+   {
+      quint32 pathOffset = 0;
+      quint32 pathLength = 0;
+      quint16 status = 0;
+      quint8 mergeParent = 0;
+
+      bool operator==(const FileRecord &other) const
+      {
+         return pathOffset == other.pathOffset && pathLength == other.pathLength && status == other.status
+             && mergeParent == other.mergeParent;
+      }
+   };
+
    bool mOnlyModified = true;
-   QVector<int> mFileStatus;
+   QByteArray mPathArena;
+   QVector<FileRecord> mRecords;
    QVector<QString> mRenamedFiles;
 
    void setExtStatus(const QString &rowSt, int parNum);
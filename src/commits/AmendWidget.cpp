@@ -2,6 +2,7 @@
 #include <ui_CommitChangesWidget.h>
 
 #include <GitCache.h>
+#include <GitHistory.h>
 #include <GitLocal.h>
 #include <GitQlientRole.h>
 #include <GitWip.h>
@@ -21,7 +22,10 @@ AmendWidget::AmendWidget(const QSharedPointer<GitCache> &cache, const QSharedPoi
 
 void AmendWidget::configure(const QString &sha)
 {
-   const auto commit = mCache->commitInfo(sha);
+   auto commit = mCache->commitInfo(sha);
+
+   if (commit.longLog().isEmpty())
+      commit.setLongLog(mGit->getCommitBody(commit.sha()));
 
    ui->amendFrame->setVisible(true);
    ui->warningButton->setVisible(true);
@@ -29,11 +33,30 @@ void AmendWidget::configure(const QString &sha)
    if (commit.parentsCount() <= 0)
       return;
 
-   QScopedPointer<GitWip> git(new GitWip(mGit, mCache));
-   git->updateWip();
+   // The file watcher keeps the WIP entry of the cache fresh, so the diff subprocess only runs
+   // when the cache holds nothing for this commit yet
+   auto files = mCache->revisionFile(CommitInfo::ZERO_SHA, sha);
+
+   if (!files.isValid())
+   {
+      QScopedPointer<GitWip> git(new GitWip(mGit, mCache));
+      git->updateWip();
+
+      files = mCache->revisionFile(CommitInfo::ZERO_SHA, sha);
+   }
+
+   auto amendFiles = mCache->revisionFile(sha, commit.parent(0));
 
-   const auto files = mCache->revisionFile(CommitInfo::ZERO_SHA, sha);
-   const auto amendFiles = mCache->revisionFile(sha, commit.parent(0));
+   if (!amendFiles.isValid())
+   {
+      QScopedPointer<GitHistory> git(new GitHistory(mGit));
+
+      if (const auto ret = git->getDiffFiles(sha, commit.parent(0)); ret.success)
+      {
+         amendFiles = RevisionFiles(ret.output.toString());
+         mCache->insertRevisionFile(sha, commit.parent(0), amendFiles);
+      }
+   }
 
    if (mCurrentSha != sha)
    {
@@ -3,6 +3,7 @@
 
 #include <ClickableFrame.h>
 #include <CommitInfo.h>
+#include <CommitMessageIndex.h>
 #include <FileWidget.h>
 #include <GitBase.h>
 #include <GitCache.h>
@@ -14,6 +15,7 @@
 #include <RevisionFiles.h>
 #include <UnstagedMenu.h>
 
+#include <QCompleter>
 #include <QDir>
 #include <QItemDelegate>
 #include <QKeyEvent>
@@ -24,6 +26,7 @@
 #include <QProcess>
 #include <QRegExp>
 #include <QScrollBar>
+#include <QStringListModel>
 #include <QTextCodec>
 #include <QTextStream>
 #include <QToolTip>
@@ -60,6 +63,17 @@ CommitChangesWidget::CommitChangesWidget(const QSharedPointer<GitCache> &cache,
    ui->leCommitTitle->setMaxLength(mTitleMaxLength);
    ui->teDescription->setMaximumHeight(100);
 
+   mMessageIndex = new CommitMessageIndex(mCache, this);
+   mTitleCompleter = new QCompleter(this);
+   mTitleCompleter->setModel(new QStringListModel(mTitleCompleter));
+   mTitleCompleter->setCaseSensitivity(Qt::CaseInsensitive);
+   mTitleCompleter->setCompletionMode(QCompleter::PopupCompletion);
+   ui->leCommitTitle->setCompleter(mTitleCompleter);
+
+   connect(mMessageIndex, &CommitMessageIndex::indexReady, this, &CommitChangesWidget::refreshTitleCompleter);
+
+   mMessageIndex->scheduleUpdate();
+
    connect(ui->leCommitTitle, &QLineEdit::textChanged, this, &CommitChangesWidget::updateCounter);
    connect(ui->leCommitTitle, &QLineEdit::returnPressed, this, &CommitChangesWidget::commitChanges);
    connect(ui->applyActionBtn, &QPushButton::clicked, this, &CommitChangesWidget::commitChanges);
@@ -83,6 +97,8 @@ CommitChangesWidget::~CommitChangesWidget()
 
 void CommitChangesWidget::reload()
 {
+   mMessageIndex->scheduleUpdate();
+
    configure(mCurrentSha);
 }
 
@@ -229,22 +245,26 @@ void CommitChangesWidget::insertFiles(const RevisionFiles &files, QListWidget *f
             itemPair.first->setSizeHint(itemPair.second->sizeHint());
          }
          else
-            mInternalCache[wip].keep = true;
+         {
+            auto &cached = mInternalCache[wip];
+            cached.keep = true;
+            updateFileItem(cached.item, fileName, isConflict, untrackedFile, getColorForFile(files, i));
+         }
       }
 
       if (!staged)
       {
          wip = QString("%1-%2").arg(fileName, fileList->objectName());
-         if (!mInternalCache.contains(wip))
-         {
-            // Item configuration
-            auto color = getColorForFile(files, i);
 
-            // If the item is not new but the color is green this is not correct.
-            // It means that the file was partially staged so the color backs to default.
-            if (!files.statusCmp(i, RevisionFiles::NEW) && color == GitQlientStyles::getGreen())
-               color = GitQlientStyles::getTextColor();
+         auto color = getColorForFile(files, i);
+
+         // If the item is not new but the color is green this is not correct.
+         // It means that the file was partially staged so the color backs to default.
+         if (!files.statusCmp(i, RevisionFiles::NEW) && color == GitQlientStyles::getGreen())
+            color = GitQlientStyles::getTextColor();
 
+         if (!mInternalCache.contains(wip))
+         {
             const auto itemPair
                 = fillFileItemInfo(fileName, isConflict, untrackedFile, QString(":/icons/add"), color, fileList);
 
@@ -255,9 +275,32 @@ void CommitChangesWidget::insertFiles(const RevisionFiles &files, QListWidget *f
             itemPair.first->setSizeHint(itemPair.second->sizeHint());
          }
          else
-            mInternalCache[wip].keep = true;
+         {
+            auto &cached = mInternalCache[wip];
+            cached.keep = true;
+            updateFileItem(cached.item, fileName, isConflict, untrackedFile, color);
+         }
       }
    }
+
+   // The staged set drives the first suggestions, so the completer follows the files the user
+   // just staged or unstaged
+   refreshTitleCompleter();
+}
+
+void CommitChangesWidget::refreshTitleCompleter()
+{
+   auto suggestions = mMessageIndex->prefixesForPaths(getFiles());
+
+   for (const auto &prefix : mMessageIndex->prefixes())
+   {
+      if (!suggestions.contains(prefix))
+         suggestions.append(prefix);
+   }
+
+   suggestions.append(mMessageIndex->recentSubjects());
+
+   static_cast<QStringListModel *>(mTitleCompleter->model())->setStringList(suggestions);
 }
 
 QPair<QListWidgetItem *, FileWidget *> CommitChangesWidget::fillFileItemInfo(const QString &file, bool isConflict,
@@ -292,6 +335,34 @@ QPair<QListWidgetItem *, FileWidget *> CommitChangesWidget::fillFileItemInfo(con
    return qMakePair(item, fileWidget);
 }
 
+void CommitChangesWidget::updateFileItem(QListWidgetItem *item, const QString &file, bool isConflict, bool isUntracked,
+                                         const QColor &color)
+{
+   const auto fileList = item->listWidget();
+   const auto fileWidget = qobject_cast<FileWidget *>(fileList ? fileList->itemWidget(item) : nullptr);
+
+   if (!fileWidget)
+      return;
+
+   if (fileWidget->getTextColor() != color)
+      fileWidget->setTextColor(color);
+
+   if (item->data(GitQlientRole::U_IsConflict).toBool() != isConflict)
+   {
+      item->setData(GitQlientRole::U_IsConflict, isConflict);
+
+      const auto modName = isConflict ? QString(file + " (conflicts)") : file;
+
+      QFontMetrics metrix(item->font());
+      fileWidget->setText(metrix.elidedText(modName, Qt::ElideMiddle, width() - 10));
+      fileWidget->setToolTip(modName);
+      item->setToolTip(modName);
+   }
+
+   if (item->data(GitQlientRole::U_IsUntracked).toBool() != isUntracked)
+      item->setData(GitQlientRole::U_IsUntracked, isUntracked);
+}
+
 void CommitChangesWidget::addAllFilesToCommitList()
 {
    QStringList files;
@@ -301,7 +372,7 @@ void CommitChangesWidget::addAllFilesToCommitList()
 
    const auto git = QScopedPointer<GitLocal>(new GitLocal(mGit));
 
-   if (const auto ret = git->markFilesAsResolved(files); ret.success)
+   if (const auto ret = git->stageFiles(files); ret.success)
    {
       QScopedPointer<GitWip> git(new GitWip(mGit, mCache));
       git->updateWip();
@@ -32,6 +32,8 @@ class GitCache;
 class GitBase;
 class RevisionFiles;
 class FileWidget;
+class CommitMessageIndex;
+class QCompleter;
 
 namespace Ui
 {
@@ -80,6 +82,8 @@ protected:
    Ui::CommitChangesWidget *ui = nullptr;
    QSharedPointer<GitCache> mCache;
    QSharedPointer<GitBase> mGit;
+   CommitMessageIndex *mMessageIndex = nullptr;
+   QCompleter *mTitleCompleter = nullptr;
    QString mCurrentSha;
    QMap<QString, WipCacheItem> mInternalCache;
    int mTitleMaxLength = 50;
@@ -91,6 +95,17 @@ protected:
    QPair<QListWidgetItem *, FileWidget *> fillFileItemInfo(const QString &file, bool isConflict, bool isUntracked,
                                                            const QString &icon, const QColor &color,
                                                            QListWidget *parent);
+   /**
+    * @brief updateFileItem Refreshes color, conflict suffix and flags of a reused row in place, so
+    * a file whose state flipped between two WIP updates doesn't keep stale decorations.
+    * @param item The cached row to refresh.
+    * @param file The file path.
+    * @param isConflict Whether the file is currently in conflict.
+    * @param isUntracked Whether the file is currently untracked.
+    * @param color The color the row must show.
+    */
+   void updateFileItem(QListWidgetItem *item, const QString &file, bool isConflict, bool isUntracked,
+                       const QColor &color);
    virtual void prepareCache() final;
    virtual void clearCache() final;
    virtual void addAllFilesToCommitList() final;
@@ -106,5 +121,12 @@ protected:
    virtual QColor getColorForFile(const RevisionFiles &files, int index) const final;
    virtual void deleteUntrackedFiles() final;
 
+   /**
+    * @brief refreshTitleCompleter Refills the commit title completer from the in-memory message
+    * index: the prefixes used by the staged paths first, then the repo-wide prefixes and the most
+    * recent subjects. Every keystroke filters over this list without touching git.
+    */
+   void refreshTitleCompleter();
+
    static QString lastMsgBeforeError;
 };
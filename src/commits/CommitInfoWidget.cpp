@@ -1,12 +1,18 @@
 #include <CommitInfoWidget.h>
 #include <CommitInfoPanel.h>
+#include <GitBase.h>
 #include <GitCache.h>
+#include <GitHistory.h>
 #include <CommitInfo.h>
 #include <FileListWidget.h>
+#include <RevisionFiles.h>
+#include <TaskPool.h>
 
 #include <QLabel>
+#include <QPointer>
 #include <QVBoxLayout>
 #include <QDateTime>
+#include <QtConcurrent>
 
 #include <QLogger.h>
 
@@ -37,8 +43,8 @@ CommitInfoWidget::CommitInfoWidget(const QSharedPointer<GitCache> &cache, const
    mainLayout->setRowStretch(2, 0);
    mainLayout->setRowStretch(2, 1);
 
-   connect(mFileListWidget, &FileListWidget::itemDoubleClicked, this,
-           [this](QListWidgetItem *item) { emit signalOpenFileCommit(mCurrentSha, mParentSha, item->text(), false); });
+   connect(mFileListWidget, &FileListWidget::fileDoubleClicked, this,
+           [this](const QString &fileName) { emit signalOpenFileCommit(mCurrentSha, mParentSha, fileName, false); });
    connect(mFileListWidget, &FileListWidget::signalShowFileHistory, this, &CommitInfoWidget::signalShowFileHistory);
    connect(mFileListWidget, &FileListWidget::signalEditFile, this, &CommitInfoWidget::signalEditFile);
 }
@@ -55,7 +61,7 @@ void CommitInfoWidget::configure(const QString &sha)
 
    if (sha != CommitInfo::ZERO_SHA && !sha.isEmpty())
    {
-      const auto commit = mCache->commitInfo(sha);
+      auto commit = mCache->commitInfo(sha);
 
       if (!commit.sha().isEmpty())
       {
@@ -63,9 +69,60 @@ void CommitInfoWidget::configure(const QString &sha)
          mCurrentSha = commit.sha();
          mParentSha = commit.parent(0);
 
-         mInfoPanel->configure(commit);
-
-         mFileListWidget->insertFiles(mCurrentSha, mParentSha);
+         const auto cachedFiles = mCache->revisionFile(mCurrentSha, mParentSha);
+
+         // When everything is already cached the selection renders straight away. Otherwise a
+         // single worker pass prepares the commit body and the file list and delivers them as one
+         // bundle, so browsing the history never spawns git processes on the GUI thread.
+         if (!commit.longLog().isEmpty() && cachedFiles.isValid())
+         {
+            mInfoPanel->configure(commit);
+            mFileListWidget->setFiles(cachedFiles, mCurrentSha);
+            return;
+         }
+
+         QtConcurrent::run(
+             TaskPool::instance()->pool(),
+             [guard = QPointer<CommitInfoWidget>(this), commit, cachedFiles, git = mGit, sha = mCurrentSha,
+              parentSha = mParentSha]() mutable {
+                if (commit.longLog().isEmpty())
+                   commit.setLongLog(git->getCommitBody(commit.sha()));
+
+                auto files = cachedFiles;
+                auto fetched = false;
+
+                if (!files.isValid())
+                {
+                   QScopedPointer<GitHistory> gitHistory(new GitHistory(git));
+
+                   if (const auto ret = gitHistory->getDiffFiles(sha, parentSha); ret.success)
+                   {
+                      files = RevisionFiles(ret.output.toString());
+                      fetched = true;
+                   }
+                }
+
+                if (!guard)
+                   return;
+
+                QMetaObject::invokeMethod(
+                    guard,
+                    [guard, commit, files, fetched, sha, parentSha]() {
+                       if (!guard)
+                          return;
+
+                       if (fetched)
+                          guard->mCache->insertRevisionFile(sha, parentSha, files);
+
+                       // The user may have selected another commit while the data was being prepared
+                       if (guard->mCurrentSha != sha)
+                          return;
+
+                       guard->mInfoPanel->configure(commit);
+                       guard->mFileListWidget->setFiles(files, sha);
+                    },
+                    Qt::QueuedConnection);
+             });
       }
    }
 }
@@ -9,6 +9,7 @@ HEADERS += \
     $$PWD/CommitInfoWidget.h \
     $$PWD/FileContextMenu.h \
     $$PWD/FileListDelegate.h \
+    $$PWD/FileListModel.h \
     $$PWD/FileListWidget.h \
     $$PWD/FileWidget.h \
     $$PWD/GitQlientRole.h \
@@ -22,6 +23,7 @@ SOURCES += \
     $$PWD/CommitInfoWidget.cpp \
     $$PWD/FileContextMenu.cpp \
     $$PWD/FileListDelegate.cpp \
+    $$PWD/FileListModel.cpp \
     $$PWD/FileListWidget.cpp \
     $$PWD/FileWidget.cpp \
     $$PWD/StagedFilesList.cpp \
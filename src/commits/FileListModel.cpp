@@ -0,0 +1,76 @@
+#include "FileListModel.h"
+
+#include <GitQlientStyles.h>
+
+FileListModel::FileListModel(QObject *parent)
+   : QAbstractListModel(parent)
+{
+}
+
+void FileListModel::setFiles(const RevisionFiles &files)
+{
+   beginResetModel();
+
+   mFiles = files;
+   mVisibleRows.clear();
+   mVisibleRows.reserve(files.count());
+
+   for (auto i = 0; i < files.count(); ++i)
+   {
+      if (!mFiles.statusCmp(i, RevisionFiles::UNKNOWN))
+         mVisibleRows.append(i);
+   }
+
+   endResetModel();
+}
+
+void FileListModel::clear()
+{
+   beginResetModel();
+
+   mFiles = RevisionFiles();
+   mVisibleRows.clear();
+
+   endResetModel();
+}
+
+int FileListModel::rowCount(const QModelIndex &parent) const
+{
+   return !parent.isValid() ? mVisibleRows.count() : 0;
+}
+
+QVariant FileListModel::data(const QModelIndex &index, int role) const
+{
+   if (!index.isValid() || index.row() >= mVisibleRows.count())
+      return QVariant();
+
+   const auto fileIndex = mVisibleRows.at(index.row());
+
+   switch (role)
+   {
+      case Qt::DisplayRole:
+      case Qt::ToolTipRole: {
+         if (mFiles.statusCmp(fileIndex, RevisionFiles::NEW))
+         {
+            const auto fileRename = mFiles.extendedStatus(fileIndex);
+
+            if (!fileRename.isEmpty())
+               return fileRename;
+         }
+
+         return mFiles.getFile(fileIndex);
+      }
+      case Qt::ForegroundRole: {
+         if (mFiles.statusCmp(fileIndex, RevisionFiles::NEW))
+         {
+            return mFiles.extendedStatus(fileIndex).isEmpty() ? GitQlientStyles::getGreen()
+                                                              : GitQlientStyles::getBlue();
+         }
+
+         return mFiles.statusCmp(fileIndex, RevisionFiles::DELETED) ? GitQlientStyles::getRed()
+                                                                    : GitQlientStyles::getTextColor();
+      }
+      default:
+         return QVariant();
+   }
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+#include <RevisionFiles.h>
+
+#include <QAbstractListModel>
+#include <QVector>
+
+/*!
+ \brief Adapts the files of a revision to the model/view framework. Names and colors are resolved
+ on demand in data(), so showing a commit only pays for the rows the viewport paints regardless
+ of how many files the commit touches.
+*/
+class FileListModel : public QAbstractListModel
+{
+   Q_OBJECT
+
+public:
+   explicit FileListModel(QObject *parent = nullptr);
+
+   /*!
+    \brief Replaces the files shown by the model.
+    \param files The files of the revision.
+   */
+   void setFiles(const RevisionFiles &files);
+   /*!
+    \brief Drops all the rows.
+   */
+   void clear();
+
+   int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+   QVariant data(const QModelIndex &index, int role) const override;
+
+private:
+   RevisionFiles mFiles;
+   QVector<int> mVisibleRows;
+};
@@ -2,31 +2,32 @@
 
 #include <FileContextMenu.h>
 #include <FileListDelegate.h>
+#include <FileListModel.h>
 #include <GitBase.h>
 #include <GitCache.h>
 #include <GitHistory.h>
-#include <GitQlientStyles.h>
 #include <RevisionFiles.h>
 
-#include <QApplication>
-#include <QDrag>
-#include <QItemDelegate>
 #include <QMenu>
-#include <QMimeData>
-#include <QMouseEvent>
-#include <QPainter>
-#include <QPalette>
 
 FileListWidget::FileListWidget(const QSharedPointer<GitBase> &git, QSharedPointer<GitCache> cache, QWidget *p)
-   : QListWidget(p)
+   : QListView(p)
    , mGit(git)
    , mCache(std::move(cache))
 {
    setContextMenuPolicy(Qt::CustomContextMenu);
    setItemDelegate(mFileDelegate = new FileListDelegate(this));
+   setModel(mModel = new FileListModel(this));
    setAttribute(Qt::WA_DeleteOnClose);
 
+   // The rows are laid out in batches so a commit touching thousands of files never freezes the
+   // UI computing geometry for rows far below the viewport.
+   setLayoutMode(QListView::Batched);
+   setBatchSize(100);
+
    connect(this, &FileListWidget::customContextMenuRequested, this, &FileListWidget::showContextMenu);
+   connect(this, &QListView::doubleClicked, this,
+           [this](const QModelIndex &index) { emit fileDoubleClicked(index.data().toString()); });
 }
 
 FileListWidget::~FileListWidget()
@@ -34,25 +35,23 @@ FileListWidget::~FileListWidget()
    delete mFileDelegate;
 }
 
-void FileListWidget::addItem(const QString &label, const QColor &clr)
+void FileListWidget::clear()
 {
-   const auto item = new QListWidgetItem(label, this);
-   item->setForeground(clr);
-   item->setToolTip(label);
+   mModel->clear();
 }
 
 void FileListWidget::showContextMenu(const QPoint &pos)
 {
-   const auto item = itemAt(pos);
+   const auto index = indexAt(pos);
 
-   if (item)
+   if (index.isValid())
    {
-      const auto fileName = item->data(Qt::DisplayRole).toString();
+      const auto fileName = index.data().toString();
       const auto menu = new FileContextMenu(fileName, mCurrentSha == CommitInfo::ZERO_SHA, this);
       connect(menu, &FileContextMenu::signalShowFileHistory, this,
               [this, fileName]() { emit signalShowFileHistory(fileName); });
       connect(menu, &FileContextMenu::signalOpenFileDiff, this,
-              [this, item] { emit QListWidget::itemDoubleClicked(item); });
+              [this, fileName] { emit fileDoubleClicked(fileName); });
       connect(menu, &FileContextMenu::signalEditFile, this,
               [this, fileName]() { emit signalEditFile(mGit->getWorkingDir() + "/" + fileName, 0, 0); });
       menu->exec(viewport()->mapToGlobal(pos));
@@ -61,53 +60,26 @@ void FileListWidget::showContextMenu(const QPoint &pos)
 
 void FileListWidget::insertFiles(const QString &currentSha, const QString &compareToSha)
 {
-   clear();
-
    RevisionFiles files;
 
-   mCurrentSha = currentSha;
-
-   if (files = mCache->revisionFile(mCurrentSha, compareToSha); !files.isValid())
+   if (files = mCache->revisionFile(currentSha, compareToSha); !files.isValid())
    {
       QScopedPointer<GitHistory> git(new GitHistory(mGit));
-      const auto ret = git->getDiffFiles(mCurrentSha, compareToSha);
+      const auto ret = git->getDiffFiles(currentSha, compareToSha);
 
       if (ret.success)
       {
          files = RevisionFiles(ret.output.toString());
-         mCache->insertRevisionFile(mCurrentSha, compareToSha, files);
+         mCache->insertRevisionFile(currentSha, compareToSha, files);
       }
    }
 
-   if (files.count() != 0)
-   {
-      setUpdatesEnabled(false);
-
-      for (auto i = 0; i < files.count(); ++i)
-      {
-         if (!files.statusCmp(i, RevisionFiles::UNKNOWN))
-         {
-            QColor clr;
-            QString fileName;
-
-            if (files.statusCmp(i, RevisionFiles::NEW))
-            {
-               const auto fileRename = files.extendedStatus(i);
-
-               clr = fileRename.isEmpty() ? GitQlientStyles::getGreen() : GitQlientStyles::getBlue();
-               fileName = fileRename.isEmpty() ? files.getFile(i) : fileRename;
-            }
-            else
-            {
-               clr = files.statusCmp(i, RevisionFiles::DELETED) ? GitQlientStyles::getRed()
-                                                                : GitQlientStyles::getTextColor();
-               fileName = files.getFile(i);
-            }
+   setFiles(files, currentSha);
+}
 
-            addItem(fileName, clr);
-         }
-      }
+void FileListWidget::setFiles(const RevisionFiles &files, const QString &currentSha)
+{
+   mCurrentSha = currentSha;
 
-      setUpdatesEnabled(true);
-   }
+   mModel->setFiles(files);
 }
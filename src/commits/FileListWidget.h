@@ -23,13 +23,15 @@
  ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
  ***************************************************************************************/
 
-#include <QListWidget>
+#include <QListView>
 
 class GitBase;
 class GitCache;
 class FileListDelegate;
+class FileListModel;
+class RevisionFiles;
 
-class FileListWidget : public QListWidget
+class FileListWidget : public QListView
 {
    Q_OBJECT
 
@@ -44,6 +46,12 @@ signals:
     */
    void signalEditFile(const QString &fileName, int line, int column);
 
+   /**
+    * @brief fileDoubleClicked Signal triggered when the user double-clicks a file to open its diff.
+    * @param fileName The file name
+    */
+   void fileDoubleClicked(const QString &fileName);
+
 public:
    explicit FileListWidget(const QSharedPointer<GitBase> &git, QSharedPointer<GitCache> cache,
                            QWidget *parent = nullptr);
@@ -51,12 +59,25 @@ public:
 
    void insertFiles(const QString &currentSha, const QString &compareToSha);
 
+   /**
+    * @brief setFiles Shows an already resolved set of files. Used by the selection pipeline, where
+    * the diff is computed in a worker and delivered ready to render.
+    * @param files The files of the revision.
+    * @param currentSha The sha the files belong to.
+    */
+   void setFiles(const RevisionFiles &files, const QString &currentSha);
+
+   /**
+    * @brief clear Drops all the rows of the list.
+    */
+   void clear();
+
 private:
    QSharedPointer<GitBase> mGit;
    QSharedPointer<GitCache> mCache;
    FileListDelegate *mFileDelegate = nullptr;
+   FileListModel *mModel = nullptr;
    QString mCurrentSha;
 
    void showContextMenu(const QPoint &);
-   void addItem(const QString &label, const QColor &clr);
 };
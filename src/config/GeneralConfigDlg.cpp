@@ -1,12 +1,16 @@
 #include "GeneralConfigDlg.h"
 
+#include <AllocationTracker.h>
 #include <GitQlientSettings.h>
 #include <GitQlientStyles.h>
+#include <MemoryTracker.h>
 #include <QLogger.h>
 #include <CheckBox.h>
 #include <ButtonLink.hpp>
 
 #include <QSpinBox>
+#include <QLocale>
+#include <QTreeWidget>
 #include <QComboBox>
 #include <QLabel>
 #include <QVBoxLayout>
@@ -27,6 +31,7 @@ GeneralConfigDlg::GeneralConfigDlg(QWidget *parent)
    , mLevelCombo(new QComboBox())
    , mStylesSchema(new QComboBox())
    , mGitLocation(new QLineEdit())
+   , mMemoryReport(new QTreeWidget())
    , mClose(new QPushButton(tr("Close")))
    , mReset(new QPushButton(tr("Reset")))
    , mApply(new QPushButton(tr("Apply")))
@@ -88,10 +93,25 @@ GeneralConfigDlg::GeneralConfigDlg(QWidget *parent)
 
    layout->addWidget(importLink, ++row, 0, 1, 2);
 
+   mMemoryReport->setColumnCount(3);
+   mMemoryReport->setHeaderLabels({ tr("Cache"), tr("Size"), QString() });
+   mMemoryReport->setRootIsDecorated(false);
+   mMemoryReport->setFixedHeight(150);
+
+   layout->addWidget(new QLabel(tr("Memory used by the caches:")), ++row, 0, 1, 2);
+   layout->addWidget(mMemoryReport, ++row, 0, 1, 2);
+
+   const auto refreshLink = new ButtonLink(tr("Refresh sizes"));
+   connect(refreshLink, &ButtonLink::clicked, this, &GeneralConfigDlg::refreshMemoryReport);
+
+   layout->addWidget(refreshLink, ++row, 0, 1, 2);
+
    layout->addItem(new QSpacerItem(1, 1, QSizePolicy::Expanding, QSizePolicy::Expanding), ++row, 0, 1, 2);
    layout->addLayout(buttonsLayout, ++row, 0, 1, 2);
 
-   setFixedSize(500, 300);
+   refreshMemoryReport();
+
+   setFixedSize(500, 540);
 
    setStyleSheet(GitQlientStyles::getStyles());
 }
@@ -190,3 +210,40 @@ void GeneralConfigDlg::exportConfig()
       }
    }
 }
+
+void GeneralConfigDlg::refreshMemoryReport()
+{
+   mMemoryReport->clear();
+
+   const auto reports = MemoryTracker::instance()->reports();
+
+   for (const auto &report : reports)
+   {
+      const auto item = new QTreeWidgetItem({ report.name, QLocale().formattedDataSize(report.bytes), QString() });
+      mMemoryReport->addTopLevelItem(item);
+
+      if (report.purgeable)
+      {
+         const auto purge = new QPushButton(tr("Purge"));
+         connect(purge, &QPushButton::clicked, this, [this, id = report.id]() {
+            MemoryTracker::instance()->purge(id);
+            refreshMemoryReport();
+         });
+
+         mMemoryReport->setItemWidget(item, 2, purge);
+      }
+   }
+
+#ifdef ALLOC_TRACKING
+   // Allocation-site rows only exist in instrumented builds; they attribute growth to the load
+   // that produced it during long sessions
+   for (const auto &site : AllocationTracker::instance()->reports())
+   {
+      const auto item = new QTreeWidgetItem({ site.site, QLocale().formattedDataSize(site.liveBytes),
+                                              tr("peak %1, %2 allocs")
+                                                  .arg(QLocale().formattedDataSize(site.peakBytes),
+                                                       QString::number(site.allocations)) });
+      mMemoryReport->addTopLevelItem(item);
+   }
+#endif
+}
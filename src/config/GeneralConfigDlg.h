@@ -31,6 +31,7 @@ class QComboBox;
 class QLabel;
 class QPushButton;
 class QLineEdit;
+class QTreeWidget;
 class GitQlientSettings;
 
 /*!
@@ -58,6 +59,7 @@ private:
    QComboBox *mLevelCombo = nullptr;
    QComboBox *mStylesSchema = nullptr;
    QLineEdit *mGitLocation = nullptr;
+   QTreeWidget *mMemoryReport = nullptr;
    bool mShowResetMsg = false;
    QPushButton *mClose = nullptr;
    QPushButton *mReset = nullptr;
@@ -79,6 +81,12 @@ private:
     */
    void importConfig();
 
+   /**
+    * @brief refreshMemoryReport Rebuilds the cache diagnostics table with the sizes reported to
+    * the MemoryTracker, adding a purge button for the caches that support it.
+    */
+   void refreshMemoryReport();
+
    /**
     * @brief exportConfig Exports the configuration to an external file.
     */
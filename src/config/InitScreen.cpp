@@ -20,9 +20,15 @@
 #include <QtGlobal>
 #include <QDesktopServices>
 #include <GitQlientStyles.h>
+#include <TaskPool.h>
 
 #include <QLogger.h>
 
+#include <QFileInfo>
+#include <QPointer>
+#include <QTimer>
+#include <QtConcurrent>
+
 using namespace QLogger;
 
 InitScreen::InitScreen(QWidget *parent)
@@ -144,6 +150,10 @@ InitScreen::InitScreen(QWidget *parent)
    connect(mGit.data(), &GitConfig::signalCloningProgress, this, &InitScreen::updateProgressDialog,
            Qt::DirectConnection);
    connect(mGit.data(), &GitConfig::signalCloningFailure, this, &InitScreen::showError, Qt::DirectConnection);
+
+   // The pages above are built from the on-disk metadata store only; the refresh walking the
+   // repositories starts once the window had the chance to paint
+   QTimer::singleShot(200, this, &InitScreen::refreshProjectsInfo);
 }
 
 void InitScreen::openRepo()
@@ -195,7 +205,7 @@ QWidget *InitScreen::createRecentProjectsPage()
    for (auto project : projects)
    {
       const auto projectName = project.mid(project.lastIndexOf("/") + 1);
-      const auto labelText = QString("%1<br><em>%2</em>").arg(projectName, project);
+      const auto labelText = QString("%1<br><em>%2</em>%3").arg(projectName, project, projectInfoHtml(project));
       const auto clickableFrame = new ButtonLink(labelText, this);
       connect(clickableFrame, &ButtonLink::clicked, this, [this, project]() { emit signalOpenRepo(project); });
       innerLayout->addWidget(clickableFrame);
@@ -238,7 +248,7 @@ QWidget *InitScreen::createUsedProjectsPage()
    for (auto project : projects)
    {
       const auto projectName = project.mid(project.lastIndexOf("/") + 1);
-      const auto labelText = QString("%1<br><em>%2</em>").arg(projectName, project);
+      const auto labelText = QString("%1<br><em>%2</em>%3").arg(projectName, project, projectInfoHtml(project));
       const auto clickableFrame = new ButtonLink(labelText);
       connect(clickableFrame, &ButtonLink::clicked, this, [this, project]() { emit signalOpenRepo(project); });
       innerLayout->addWidget(clickableFrame);
@@ -314,6 +324,59 @@ void InitScreen::openConfigDlg()
    dlg.exec();
 }
 
+QString InitScreen::projectInfoHtml(const QString &project)
+{
+   const auto info = GitQlientSettings().globalValue("ProjectsInfo").toMap().value(project).toStringList();
+
+   if (info.count() < 3)
+      return QString();
+
+   const auto dirtyMark = info.at(2) == "1" ? QString(" ●") : QString();
+
+   return QString("<br><em>%1 — %2%3</em>").arg(info.at(0), info.at(1).toHtmlEscaped(), dirtyMark);
+}
+
+void InitScreen::refreshProjectsInfo()
+{
+   GitQlientSettings settings;
+   auto projects = settings.getRecentProjects() + settings.getMostUsedProjects();
+   projects.removeDuplicates();
+
+   QPointer<InitScreen> guard(this);
+
+   QtConcurrent::run(TaskPool::instance()->pool(), [guard, projects]() {
+      QVariantMap store;
+
+      for (const auto &project : projects)
+      {
+         if (!QFileInfo::exists(QString("%1/.git").arg(project)))
+            continue;
+
+         const auto git = QSharedPointer<GitBase>::create(project);
+         const auto summary = git->run("git log -1 --pretty=format:%s").output.toString();
+         const auto dirty = !git->run("git status --porcelain -uno").output.toString().trimmed().isEmpty();
+
+         store.insert(project, QStringList({ git->getCurrentBranch(), summary, dirty ? "1" : "0" }));
+      }
+
+      GitQlientSettings().setGlobalValue("ProjectsInfo", store);
+
+      if (guard)
+      {
+         QMetaObject::invokeMethod(
+             guard,
+             [guard]() {
+                if (guard)
+                {
+                   guard->mRecentProjectsLayout->addWidget(guard->createRecentProjectsPage());
+                   guard->mUsedProjectsLayout->addWidget(guard->createUsedProjectsPage());
+                }
+             },
+             Qt::QueuedConnection);
+      }
+   });
+}
+
 void InitScreen::onRepoOpened()
 {
    mRecentProjectsLayout->addWidget(createRecentProjectsPage());
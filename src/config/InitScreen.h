@@ -132,4 +132,19 @@ private:
     * @brief openConfigDlg Opens the config dialog.
     */
    void openConfigDlg();
+
+   /**
+    * @brief projectInfoHtml Builds the extra description line of a project link from the metadata
+    * store: current branch, last commit summary and a dirty marker.
+    * @param project The absolute path of the project.
+    * @return The formatted line, or an empty string when there is no cached metadata yet.
+    */
+   static QString projectInfoHtml(const QString &project);
+
+   /**
+    * @brief refreshProjectsInfo Gathers the metadata of the listed projects on the worker pool and
+    * rebuilds the pages with the fresh store afterwards. It is scheduled after the first paint, so
+    * showing the window never waits for slow (or unreachable) repositories.
+    */
+   void refreshProjectsInfo();
 };
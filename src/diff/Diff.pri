@@ -10,6 +10,7 @@ HEADERS += \
     $$PWD/FileDiffWidget.h \
     $$PWD/FileEditor.h \
     $$PWD/FullDiffWidget.h \
+    $$PWD/IntraLineDiff.h \
     $$PWD/IDiffWidget.h \
     $$PWD/LineNumberArea.h
 
@@ -21,5 +22,6 @@ SOURCES += \
     $$PWD/FileDiffWidget.cpp \
     $$PWD/FileEditor.cpp \
     $$PWD/FullDiffWidget.cpp \
+    $$PWD/IntraLineDiff.cpp \
     $$PWD/IDiffWidget.cpp \
     $$PWD/LineNumberArea.cpp
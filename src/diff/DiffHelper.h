@@ -24,10 +24,13 @@
  ***************************************************************************************/
 
 #include <DiffInfo.h>
+#include <GitQlientStyles.h>
+#include <PerfProfiler.h>
 
 #include <QStringList>
 #include <QPair>
 #include <QVector>
+#include <QHash>
 #include <QPlainTextEdit>
 #include <QMessageBox>
 
@@ -59,45 +62,49 @@ inline void extractLinesFromHeader(QString header, int &startOldFile, int &start
 inline QVector<DiffChange> splitDiff(const QString &diff)
 {
    QVector<DiffHelper::DiffChange> changes;
+   DiffHelper::DiffChange change;
+   auto inChange = false;
+   auto inHunk = false;
 
-#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
-   const auto flag = Qt::SkipEmptyParts;
-#else
-   const auto flag = QString::SkipEmptyParts;
-#endif
+   const auto totalLength = diff.length();
 
-   const auto chunks = diff.split("diff --git", flag);
-
-   for (const auto &chunk : chunks)
+   // The diff is walked in a single pass, slicing lines in place instead of splitting the whole
+   // buffer into intermediate string lists.
+   for (auto pos = 0; pos < totalLength;)
    {
-      auto lines = chunk.split("\n");
-      DiffHelper::DiffChange change;
+      auto lineEnd = diff.indexOf('\n', pos);
 
-      auto filesStr = lines.takeFirst();
-      auto files = filesStr.trimmed().split(" ");
-      change.newFileName = files.first().remove("a/");
-      change.oldFileName = files.last().remove("b/");
+      if (lineEnd == -1)
+         lineEnd = totalLength;
 
-      auto isA = lines.constFirst().startsWith("copy ") || lines.constFirst().startsWith("index ")
-          || lines.constFirst().startsWith("new ");
-      auto isB = lines.constFirst().startsWith("old ") || lines.constFirst().startsWith("rename ")
-          || lines.constFirst().startsWith("similarity ");
-      auto isC = lines.constFirst().startsWith("+++ ") || lines.constFirst().startsWith("--- ");
+      const auto line = diff.midRef(pos, lineEnd - pos);
 
-      while (isA || isB || isC)
+      if (line.startsWith(QLatin1String("diff --git")))
       {
-         lines.takeFirst();
+         if (inChange)
+            changes.append(change);
 
-         isA = lines.constFirst().startsWith("copy ") || lines.constFirst().startsWith("index ")
-             || lines.constFirst().startsWith("new ");
-         isB = lines.constFirst().startsWith("old ") || lines.constFirst().startsWith("rename ")
-             || lines.constFirst().startsWith("similarity ");
-         isC = lines.constFirst().startsWith("+++ ") || lines.constFirst().startsWith("--- ");
-      }
+         change = DiffHelper::DiffChange();
+         inChange = true;
+         inHunk = false;
 
-      for (auto &line : lines)
+         auto files = line.mid(10).trimmed().toString().split(" ");
+         change.newFileName = files.first().remove("a/");
+         change.oldFileName = files.last().remove("b/");
+      }
+      else if (inChange)
       {
-         if (line.startsWith("@@"))
+         const auto isHeaderLine = !inHunk
+             && (line.startsWith(QLatin1String("copy ")) || line.startsWith(QLatin1String("index "))
+                 || line.startsWith(QLatin1String("new ")) || line.startsWith(QLatin1String("old "))
+                 || line.startsWith(QLatin1String("rename ")) || line.startsWith(QLatin1String("similarity "))
+                 || line.startsWith(QLatin1String("+++ ")) || line.startsWith(QLatin1String("--- ")));
+
+         if (isHeaderLine)
+         {
+            // Skip the metadata lines between the file names and the first hunk
+         }
+         else if (line.startsWith(QLatin1String("@@")))
          {
             if (!change.content.isEmpty())
             {
@@ -105,58 +112,76 @@ inline QVector<DiffChange> splitDiff(const QString &diff)
                change.content.clear();
             }
 
-            change.header = line;
+            inHunk = true;
+            change.header = line.toString();
             extractLinesFromHeader(change.header, change.oldFileStartLine, change.newFileStartLine);
          }
          else
-            change.content.append(line + "\n");
+         {
+            change.content.append(line);
+            change.content.append('\n');
+         }
       }
 
-      changes.append(change);
+      pos = lineEnd + 1;
    }
+
+   if (inChange)
+      changes.append(change);
+
    return changes;
 }
 
 inline DiffInfo processDiff(const QString &text, QPair<QStringList, QVector<ChunkDiffInfo::ChunkInfo>> &newFileData,
                             QPair<QStringList, QVector<ChunkDiffInfo::ChunkInfo>> &oldFileData)
 {
+   PerfScopedTimer timer("DiffHelper::processDiff", "diff");
+
    DiffInfo diffInfo;
    ChunkDiffInfo diff;
    int oldFileRow = 1;
    int newFileRow = 1;
 
-   const auto lines = text.split("\n");
-   for (auto line : lines)
+   const auto totalLines = text.count('\n') + 1;
+   oldFileData.first.reserve(totalLines);
+   newFileData.first.reserve(totalLines);
+
+   const auto totalLength = text.length();
+
+   // Single pass over the raw buffer: every line is sliced in place and only its payload (the
+   // line without the diff marker) is copied once into the destination lists.
+   for (auto pos = 0; pos <= totalLength;)
    {
+      auto lineEnd = text.indexOf('\n', pos);
+
+      if (lineEnd == -1)
+         lineEnd = totalLength;
+
+      const auto line = text.midRef(pos, lineEnd - pos);
+
       if (line.startsWith('-'))
       {
-         line.remove(0, 1);
-
          if (diff.oldFile.startLine == -1)
             diff.oldFile.startLine = oldFileRow;
 
-         oldFileData.first.append(line);
+         oldFileData.first.append(line.mid(1).toString());
 
          ++oldFileRow;
       }
       else if (line.startsWith('+'))
       {
-         line.remove(0, 1);
-
          if (diff.newFile.startLine == -1)
          {
             diff.newFile.startLine = newFileRow;
             diff.newFile.addition = true;
          }
 
-         newFileData.first.append(line);
+         newFileData.first.append(line.mid(1).toString());
 
          ++newFileRow;
       }
       else
       {
-         line.remove(0, 1);
-
          if (diff.oldFile.startLine != -1)
             diff.oldFile.endLine = oldFileRow - 1;
 
@@ -174,43 +199,104 @@ inline DiffInfo processDiff(const QString &text, QPair<QStringList, QVector<Chun
             diffInfo.chunks.append(diff);
          }
 
-         oldFileData.first.append(line);
-         newFileData.first.append(line);
+         const auto content = line.mid(1).toString();
+         oldFileData.first.append(content);
+         newFileData.first.append(content);
 
          diff = ChunkDiffInfo();
 
          ++oldFileRow;
          ++newFileRow;
       }
+
+      pos = lineEnd + 1;
    }
 
-   diffInfo.fullDiff = lines;
    diffInfo.newFileDiff = newFileData.first;
    diffInfo.oldFileDiff = oldFileData.first;
 
    return diffInfo;
 }
 
+/**
+ * @brief The SearchMatches struct stores every match position of the last needle searched in a document revision, so
+ * find-next navigation is a table lookup instead of a rescan of the whole buffer.
+ */
+struct SearchMatches
+{
+   int revision = -1;
+   QString needle;
+   QVector<int> positions;
+};
+
 inline void findString(const QString &s, QPlainTextEdit *textEdit, QWidget *managerWidget)
 {
-   if (!s.isEmpty())
+   if (s.isEmpty())
+      return;
+
+   /* The table is keyed by document so the diff, blame and build-log views share the one index. The
+      key is never dereferenced for documents other than the current one, so entries outliving their
+      document are harmless and swept by the size cap. */
+   static QHash<const QTextDocument *, SearchMatches> indexedMatches;
+
+   const auto document = textEdit->document();
+
+   if (!indexedMatches.contains(document) && indexedMatches.count() >= 10)
+      indexedMatches.clear();
+
+   auto &matches = indexedMatches[document];
+
+   if (matches.revision != document->revision() || matches.needle.compare(s, Qt::CaseInsensitive) != 0)
    {
-      QTextCursor cursor = textEdit->textCursor();
-      QTextCursor cursorSaved = cursor;
+      matches.revision = document->revision();
+      matches.needle = s;
+      matches.positions.clear();
+
+      const auto text = document->toPlainText();
+
+      for (auto from = text.indexOf(s, 0, Qt::CaseInsensitive); from != -1;
+           from = text.indexOf(s, from + 1, Qt::CaseInsensitive))
+         matches.positions.append(from);
+
+      // Every match is marked at once, so the remaining occurrences are visible while navigating
+      QList<QTextEdit::ExtraSelection> selections;
+      selections.reserve(matches.positions.count());
 
-      if (!textEdit->find(s))
+      for (const auto position : matches.positions)
       {
-         cursor.movePosition(QTextCursor::Start);
-         textEdit->setTextCursor(cursor);
+         QTextEdit::ExtraSelection selection;
+         selection.cursor = QTextCursor(document);
+         selection.cursor.setPosition(position);
+         selection.cursor.setPosition(position + s.count(), QTextCursor::KeepAnchor);
+         selection.format.setBackground(GitQlientStyles::getOrange());
+         selections.append(selection);
+      }
 
-         if (!textEdit->find(s))
-         {
-            textEdit->setTextCursor(cursorSaved);
+      textEdit->setExtraSelections(selections);
+   }
 
-            QMessageBox::information(managerWidget, QObject::tr("Text not found"), QObject::tr("Text not found."));
-         }
+   if (matches.positions.isEmpty())
+   {
+      QMessageBox::information(managerWidget, QObject::tr("Text not found"), QObject::tr("Text not found."));
+      return;
+   }
+
+   const auto from = textEdit->textCursor().selectionEnd();
+   auto target = matches.positions.constFirst();
+
+   for (const auto position : matches.positions)
+   {
+      if (position >= from)
+      {
+         target = position;
+         break;
       }
    }
+
+   auto cursor = textEdit->textCursor();
+   cursor.setPosition(target);
+   cursor.setPosition(target + s.count(), QTextCursor::KeepAnchor);
+   textEdit->setTextCursor(cursor);
 }
 
 }
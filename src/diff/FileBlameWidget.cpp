@@ -1,16 +1,20 @@
 #include "FileBlameWidget.h"
 
+#include <GitAsyncProcess.h>
+#include <GitBase.h>
 #include <GitCache.h>
 #include <GitHistory.h>
 #include <CommitInfo.h>
 #include <ButtonLink.hpp>
+#include <MemoryTracker.h>
 
+#include <QDateTime>
 #include <QGridLayout>
 #include <QLabel>
 #include <QScrollArea>
-#include <QtMath>
 #include <QMessageBox>
 
+#include <algorithm>
 #include <array>
 
 namespace
@@ -19,9 +23,24 @@ static const int kTotalColors = 8;
 static const std::array<const char *, kTotalColors> kBorderColors { { "25, 65, 99", "36, 95, 146", "44, 116, 177",
                                                                       "56, 136, 205", "87, 155, 213", "118, 174, 221",
                                                                       "150, 192, 221", "197, 220, 240" } };
-qint64 kSecondsNewest = 0;
-qint64 kSecondsOldest = QDateTime::currentDateTime().toSecsSinceEpoch();
-qint64 kIncrementSecs = 0;
+
+static const int kMaxCachedBlames = 20;
+
+// The per-bucket stylesheets are built once, so painting a line is a table lookup
+const QString &borderStyle(int colorIndex)
+{
+   static const auto styles = []() {
+      QVector<QString> s;
+      s.reserve(kTotalColors);
+
+      for (const auto color : kBorderColors)
+         s.append(QString("QLabel { border-left: 5px solid rgb(%1) }").arg(QString::fromUtf8(color)));
+
+      return s;
+   }();
+
+   return styles.at(colorIndex);
+}
 }
 
 FileBlameWidget::FileBlameWidget(const QSharedPointer<GitCache> &cache, const QSharedPointer<GitBase> &git,
@@ -78,147 +97,322 @@ FileBlameWidget::FileBlameWidget(const QSharedPointer<GitCache> &cache, const QS
 void FileBlameWidget::setup(const QString &fileName, const QString &currentSha, const QString &previousSha)
 {
    mCurrentFile = fileName;
-   QScopedPointer<GitHistory> git(new GitHistory(mGit));
-   const auto ret = git->blame(mCurrentFile, currentSha);
+   mCurrentSha->setText(currentSha);
+   mPreviousSha->setText(previousSha);
 
-   if (ret.success && !ret.output.toString().startsWith("fatal:"))
+   startBlame(currentSha);
+}
+
+void FileBlameWidget::startBlame(const QString &currentSha)
+{
+   if (mBlameProcess)
    {
-      delete mAnotation;
-      mAnotation = nullptr;
+      disconnect(mBlameProcess, nullptr, this, nullptr);
+      mBlameProcess->onCancel();
+      mBlameProcess = nullptr;
+   }
 
-      mCurrentSha->setText(currentSha);
-      mPreviousSha->setText(previousSha);
+   mBlameBuffer.clear();
+   mBlamedSha = currentSha;
 
-      const auto annotations = processBlame(ret.output.toString());
-      formatAnnotatedFile(annotations);
-   }
-   else
-      QMessageBox::warning(
-          this, tr("File not in Git"),
-          tr("The file {%1} is not under Git control version. You cannot blame it.").arg(mCurrentFile));
-}
+   // Stepping back to a revision already blamed in this session reuses the parsed annotations,
+   // so navigating through the history of a file only pays the git process once per revision.
+   if (applyCachedBlame(currentSha))
+      return;
 
-void FileBlameWidget::reload(const QString &currentSha, const QString &previousSha)
-{
-   setup(mCurrentFile, currentSha, previousSha);
+   resetAnnotationView();
+
+   // The blame runs asynchronously and the annotations are painted as git resolves them, so the
+   // UI stays responsive from the first hunk even for files with a long history.
+   mBlameProcess = new GitAsyncProcess(mGit->getWorkingDir());
+   connect(mBlameProcess, &GitAsyncProcess::procDataReady, this, &FileBlameWidget::onBlameDataReady);
+   connect(mBlameProcess, &GitAsyncProcess::signalDataReady, this, &FileBlameWidget::onBlameFinished);
+
+   mBlameProcess->run(QString("git annotate %1 %2").arg(mCurrentFile, currentSha));
 }
 
-QString FileBlameWidget::getCurrentSha() const
+void FileBlameWidget::resetAnnotationView()
 {
-   return mCurrentSha->text();
+   delete mAnotation;
+   mAnotation = new QFrame();
+   mAnotation->setObjectName("AnnotationFrame");
+
+   mAnnotationLayout = new QGridLayout(mAnotation);
+   mAnnotationLayout->setContentsMargins(QMargins());
+   mAnnotationLayout->setSpacing(0);
+
+   mScrollArea->setWidget(mAnotation);
+   mScrollArea->setWidgetResizable(true);
+
+   mAnnotations.clear();
+   mEpochs.clear();
+   mAgeBuckets.clear();
+   mLastSha.clear();
+   mLabelRow = 0;
+   mPendingDateLabel = nullptr;
+   mPendingAuthorLabel = nullptr;
+   mPendingMessageLabel = nullptr;
 }
 
-QVector<FileBlameWidget::Annotation> FileBlameWidget::processBlame(const QString &blame)
+void FileBlameWidget::onBlameDataReady(const QByteArray &data)
 {
+   if (sender() != mBlameProcess)
+      return;
+
+   mBlameBuffer.append(data);
+
+   const auto lastLineEnd = mBlameBuffer.lastIndexOf('\n');
+
+   if (lastLineEnd == -1)
+      return;
+
+   const auto text = QString::fromUtf8(mBlameBuffer.left(lastLineEnd));
+   mBlameBuffer.remove(0, lastLineEnd + 1);
+
+   if (text.startsWith("fatal:"))
+      return;
+
 #if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
-   const auto lines = blame.split("\n", Qt::SkipEmptyParts);
+   const auto lines = text.split("\n", Qt::SkipEmptyParts);
 #else
-   const auto lines = blame.split("\n", QString::SkipEmptyParts);
+   const auto lines = text.split("\n", QString::SkipEmptyParts);
 #endif
+
    QVector<Annotation> annotations;
+   annotations.reserve(lines.count());
 
    for (const auto &line : lines)
-   {
-      auto start = 0;
-      auto indexOfTab = line.indexOf('\t');
-      const auto shortSha = line.mid(start, indexOfTab);
-      const auto revision = mCache->commitInfo(shortSha);
+      annotations.append(parseBlameLine(line));
 
-      start = indexOfTab + 1;
-      indexOfTab = line.indexOf('\t', start);
-      const auto name = line.mid(start, indexOfTab - start).remove("(");
+   rebuildAgeBuckets(annotations);
+   appendAnnotations(annotations);
+}
 
-      start = indexOfTab + 1;
-      indexOfTab = line.indexOf('\t', start);
-      const auto dtValue = line.mid(start, indexOfTab - start);
-      const auto dt = QDateTime::fromString(dtValue, Qt::ISODate);
+void FileBlameWidget::onBlameFinished(const GitExecResult &result)
+{
+   if (sender() != mBlameProcess)
+      return;
 
-      start = indexOfTab + 1;
+   mBlameProcess = nullptr;
 
-      const auto lineNumAndContent = line.mid(start);
-      const auto divisorChar = lineNumAndContent.indexOf(")");
-      const auto lineText = lineNumAndContent.mid(0, divisorChar);
-      const auto content = lineNumAndContent.mid(divisorChar + 1, lineNumAndContent.count() - lineText.count() - 1);
+   if (!result.success || result.output.toString().startsWith("fatal:"))
+   {
+      QMessageBox::warning(
+          this, tr("File not in Git"),
+          tr("The file {%1} is not under Git control version. You cannot blame it.").arg(mCurrentFile));
+      return;
+   }
 
-      annotations.append({ revision.sha(), name, dt, lineText.toInt(), content });
+   if (!mBlameBuffer.isEmpty())
+   {
+      const auto line = QString::fromUtf8(mBlameBuffer);
+      mBlameBuffer.clear();
 
-      if (revision.sha() != CommitInfo::ZERO_SHA)
+      if (!line.isEmpty())
       {
-         const auto dtSinceEpoch = dt.toSecsSinceEpoch();
+         const QVector<Annotation> annotations { parseBlameLine(line) };
 
-         if (kSecondsNewest < dtSinceEpoch)
-            kSecondsNewest = dtSinceEpoch;
-
-         if (kSecondsOldest > dtSinceEpoch)
-            kSecondsOldest = dtSinceEpoch;
+         rebuildAgeBuckets(annotations);
+         appendAnnotations(annotations);
       }
    }
 
-   kIncrementSecs = kSecondsNewest != kSecondsOldest ? (kSecondsNewest - kSecondsOldest) / (kTotalColors - 1) : 1;
+   flushPendingLabels();
+   mAnnotationLayout->addItem(new QSpacerItem(1, 1, QSizePolicy::Expanding, QSizePolicy::Expanding),
+                              mAnnotations.count(), 4);
 
-   return annotations;
+   storeBlameInCache();
 }
 
-void FileBlameWidget::formatAnnotatedFile(const QVector<Annotation> &annotations)
+QHash<QString, FileBlameWidget::CachedBlame> &FileBlameWidget::blameCache()
 {
-   auto labelRow = 0;
-   auto labelRowSpan = 1;
-   QLabel *dateLabel = nullptr;
-   QLabel *authorLabel = nullptr;
-   ButtonLink *messageLabel = nullptr;
-
-   const auto annotationLayout = new QGridLayout();
-   annotationLayout->setContentsMargins(QMargins());
-   annotationLayout->setSpacing(0);
-
-   const auto totalAnnot = annotations.count();
-   for (auto row = 0; row < totalAnnot; ++row)
-   {
-      const auto &lastAnnotation = row == 0 ? Annotation() : annotations.at(row - 1);
+   static QHash<QString, CachedBlame> cache;
+   static const auto trackerId = MemoryTracker::instance()->add(
+       tr("Blames"),
+       []() {
+          quint64 bytes = 0;
+
+          for (auto iter = cache.cbegin(); iter != cache.cend(); ++iter)
+          {
+             bytes += static_cast<quint64>(iter.key().capacity()) * sizeof(QChar);
+             bytes += static_cast<quint64>(iter.value().ageBuckets.capacity()) * sizeof(qint64);
+
+             for (const auto &annotation : iter.value().annotations)
+             {
+                bytes += sizeof(Annotation);
+                bytes += static_cast<quint64>(annotation.sha.capacity() + annotation.author.capacity()
+                                              + annotation.content.capacity())
+                    * sizeof(QChar);
+             }
+          }
+
+          return bytes;
+       },
+       []() {
+          cache.clear();
+          blameCacheUsage().clear();
+       });
+   Q_UNUSED(trackerId)
+
+   return cache;
+}
 
-      if (lastAnnotation.sha != annotations.at(row).sha)
-      {
-         if (dateLabel)
-            annotationLayout->addWidget(dateLabel, labelRow, 0);
+QStringList &FileBlameWidget::blameCacheUsage()
+{
+   static QStringList usage;
 
-         if (authorLabel)
-            annotationLayout->addWidget(authorLabel, labelRow, 1);
+   return usage;
+}
 
-         if (messageLabel)
-            annotationLayout->addWidget(messageLabel, labelRow, 2);
+QString FileBlameWidget::blameCacheKey(const QString &sha) const
+{
+   return QString("%1|%2|%3").arg(mGit->getGitDir(), mCurrentFile, sha);
+}
 
-         dateLabel = createDateLabel(annotations.at(row), row == 0);
-         authorLabel = createAuthorLabel(annotations.at(row).author, row == 0);
-         messageLabel = createMessageLabel(annotations.at(row).sha, row == 0);
+bool FileBlameWidget::applyCachedBlame(const QString &sha)
+{
+   if (sha == CommitInfo::ZERO_SHA)
+      return false;
 
-         labelRow = row;
-         labelRowSpan = 1;
-      }
-      else
-         ++labelRowSpan;
+   const auto key = blameCacheKey(sha);
+   const auto iter = blameCache().constFind(key);
+
+   if (iter == blameCache().constEnd())
+      return false;
+
+   blameCacheUsage().removeOne(key);
+   blameCacheUsage().append(key);
+
+   resetAnnotationView();
+
+   // The bucket table was computed when this revision was first blamed, so the replay skips the
+   // epoch sort and paints straight from the palette
+   mAgeBuckets = iter->ageBuckets;
+
+   appendAnnotations(iter->annotations);
+   flushPendingLabels();
+   mAnnotationLayout->addItem(new QSpacerItem(1, 1, QSizePolicy::Expanding, QSizePolicy::Expanding),
+                              mAnnotations.count(), 4);
+
+   return true;
+}
+
+void FileBlameWidget::storeBlameInCache()
+{
+   if (mBlamedSha == CommitInfo::ZERO_SHA || mAnnotations.isEmpty())
+      return;
+
+   const auto key = blameCacheKey(mBlamedSha);
+
+   if (!blameCache().contains(key) && blameCacheUsage().count() >= kMaxCachedBlames)
+      blameCache().remove(blameCacheUsage().takeFirst());
+
+   blameCacheUsage().removeOne(key);
+   blameCacheUsage().append(key);
+   blameCache().insert(key, { mAnnotations, mAgeBuckets });
+}
+
+void FileBlameWidget::reload(const QString &currentSha, const QString &previousSha)
+{
+   setup(mCurrentFile, currentSha, previousSha);
+}
+
+QString FileBlameWidget::getCurrentSha() const
+{
+   return mCurrentSha->text();
+}
+
+FileBlameWidget::Annotation FileBlameWidget::parseBlameLine(const QString &line)
+{
+   auto start = 0;
+   auto indexOfTab = line.indexOf('\t');
+   const auto shortSha = line.mid(start, indexOfTab);
+   const auto revision = mCache->commitInfo(shortSha);
+
+   start = indexOfTab + 1;
+   indexOfTab = line.indexOf('\t', start);
+   const auto name = line.mid(start, indexOfTab - start).remove("(");
+
+   start = indexOfTab + 1;
+   indexOfTab = line.indexOf('\t', start);
+   const auto dtValue = line.mid(start, indexOfTab - start);
+   const auto dt = QDateTime::fromString(dtValue, Qt::ISODate);
+
+   start = indexOfTab + 1;
 
-      annotationLayout->addWidget(createNumLabel(annotations.at(row), row), row, 3);
-      annotationLayout->addWidget(createCodeLabel(annotations.at(row).content), row, 4);
+   const auto lineNumAndContent = line.mid(start);
+   const auto divisorChar = lineNumAndContent.indexOf(")");
+   const auto lineText = lineNumAndContent.mid(0, divisorChar);
+   const auto content = lineNumAndContent.mid(divisorChar + 1, lineNumAndContent.count() - lineText.count() - 1);
+
+   return { revision.sha(), name, dt, lineText.toInt(), content };
+}
+
+void FileBlameWidget::rebuildAgeBuckets(const QVector<Annotation> &annotations)
+{
+   for (const auto &annotation : annotations)
+   {
+      if (annotation.sha != CommitInfo::ZERO_SHA)
+         mEpochs.append(annotation.dateTime.toSecsSinceEpoch());
    }
 
-   // Adding the last row
-   if (dateLabel)
-      annotationLayout->addWidget(dateLabel, labelRow, 0);
+   if (mEpochs.isEmpty())
+   {
+      mAgeBuckets.clear();
+      return;
+   }
 
-   if (authorLabel)
-      annotationLayout->addWidget(authorLabel, labelRow, 1);
+   auto sorted = mEpochs;
+   std::sort(sorted.begin(), sorted.end());
 
-   if (messageLabel)
-      annotationLayout->addWidget(messageLabel, labelRow, 2);
+   mAgeBuckets.clear();
+   mAgeBuckets.reserve(kTotalColors - 1);
 
-   annotationLayout->addItem(new QSpacerItem(1, 1, QSizePolicy::Expanding, QSizePolicy::Expanding), totalAnnot, 4);
+   // Quantile boundaries: every bucket covers the same number of lines, so the heatmap keeps its
+   // resolution even when a single line predates the rest of the file by years
+   for (auto i = 1; i < kTotalColors; ++i)
+      mAgeBuckets.append(sorted.at(qMin((i * sorted.count()) / kTotalColors, sorted.count() - 1)));
+}
 
-   mAnotation = new QFrame();
-   mAnotation->setObjectName("AnnotationFrame");
-   mAnotation->setLayout(annotationLayout);
+void FileBlameWidget::appendAnnotations(const QVector<Annotation> &annotations)
+{
+   for (const auto &annotation : annotations)
+   {
+      const auto row = mAnnotations.count();
 
-   mScrollArea->setWidget(mAnotation);
-   mScrollArea->setWidgetResizable(true);
+      if (row == 0 || annotation.sha != mLastSha)
+      {
+         flushPendingLabels();
+
+         mPendingDateLabel = createDateLabel(annotation, row == 0);
+         mPendingAuthorLabel = createAuthorLabel(annotation.author, row == 0);
+         mPendingMessageLabel = createMessageLabel(annotation.sha, row == 0);
+
+         mLabelRow = row;
+         mLastSha = annotation.sha;
+      }
+
+      mAnnotationLayout->addWidget(createNumLabel(annotation, row), row, 3);
+      mAnnotationLayout->addWidget(createCodeLabel(annotation.content), row, 4);
+
+      mAnnotations.append(annotation);
+   }
+}
+
+void FileBlameWidget::flushPendingLabels()
+{
+   if (mPendingDateLabel)
+      mAnnotationLayout->addWidget(mPendingDateLabel, mLabelRow, 0);
+
+   if (mPendingAuthorLabel)
+      mAnnotationLayout->addWidget(mPendingAuthorLabel, mLabelRow, 1);
+
+   if (mPendingMessageLabel)
+      mAnnotationLayout->addWidget(mPendingMessageLabel, mLabelRow, 2);
+
+   mPendingDateLabel = nullptr;
+   mPendingAuthorLabel = nullptr;
+   mPendingMessageLabel = nullptr;
 }
 
 QLabel *FileBlameWidget::createDateLabel(const Annotation &annotation, bool isFirst)
@@ -300,12 +494,14 @@ QLabel *FileBlameWidget::createNumLabel(const Annotation &annotation, int row)
    numberLabel->setObjectName("numberLabel");
    numberLabel->setAlignment(Qt::AlignVCenter | Qt::AlignRight);
 
-   if (annotation.sha != CommitInfo::ZERO_SHA)
+   if (annotation.sha != CommitInfo::ZERO_SHA && !mAgeBuckets.isEmpty())
    {
-      const auto dtSinceEpoch = annotation.dateTime.toSecsSinceEpoch();
-      const auto colorIndex = qCeil((kSecondsNewest - dtSinceEpoch) / kIncrementSecs);
-      numberLabel->setStyleSheet(
-          QString("QLabel { border-left: 5px solid rgb(%1) }").arg(QString::fromUtf8(kBorderColors.at(colorIndex))));
+      // The newest lines map to the low palette indexes; the bucket is resolved with a binary
+      // search over the precomputed boundaries
+      const auto epoch = annotation.dateTime.toSecsSinceEpoch();
+      const auto bucket = std::upper_bound(mAgeBuckets.cbegin(), mAgeBuckets.cend(), epoch) - mAgeBuckets.cbegin();
+
+      numberLabel->setStyleSheet(borderStyle((kTotalColors - 1) - static_cast<int>(bucket)));
    }
    else
       numberLabel->setStyleSheet("QLabel { border-left: 5px solid #D89000 }");
@@ -25,8 +25,13 @@
 
 #include <QFrame>
 #include <QDateTime>
+#include <QHash>
+
+#include <GitExecResult.h>
 
 class GitBase;
+class GitAsyncProcess;
+class QGridLayout;
 class QScrollArea;
 class ButtonLink;
 class QLabel;
@@ -102,6 +107,9 @@ private:
    QFont mInfoFont;
    QFont mCodeFont;
    QString mCurrentFile;
+   GitAsyncProcess *mBlameProcess = nullptr;
+   QGridLayout *mAnnotationLayout = nullptr;
+   QByteArray mBlameBuffer;
 
    /*!
     \brief Private class that stores data of a annotation. An annotation is the informatio regarding when a line was
@@ -117,19 +125,117 @@ private:
       QString content;
    };
 
+   QVector<Annotation> mAnnotations;
+   /*!
+    \brief The commit epochs of the annotations, kept aside to recompute the age buckets as the
+    blame streams in.
+   */
+   QVector<qint64> mEpochs;
+   /*!
+    \brief The ascending epoch boundaries of the age heatmap buckets. Computed as quantiles over
+    the annotation set, so each color covers the same number of lines and a single ancient line
+    cannot flatten the scale. Painting a line is a binary search over this table plus a palette
+    lookup.
+   */
+   QVector<qint64> mAgeBuckets;
+   QString mBlamedSha;
+   QString mLastSha;
+   int mLabelRow = 0;
+   QLabel *mPendingDateLabel = nullptr;
+   QLabel *mPendingAuthorLabel = nullptr;
+   ButtonLink *mPendingMessageLabel = nullptr;
+
+   /*!
+    \brief Starts an asynchronous blame of the current file. Any blame still running is cancelled. If the blame for
+    that revision was already computed, it is restored from the cache without running git.
+
+    \param currentSha The commit SHA to blame from.
+   */
+   void startBlame(const QString &currentSha);
+   /*!
+    \brief Retrieves the cache of already computed blames, shared by all the blame views of the process.
+
+    \return The blame cache keyed by repository, file and SHA.
+   */
+   /*!
+    \brief Private class that stores a cached blame: the parsed annotations plus the age bucket
+    table computed over them, so stepping back to a revision reuses both without resorting the
+    epochs.
+   */
+   struct CachedBlame
+   {
+      QVector<Annotation> annotations;
+      QVector<qint64> ageBuckets;
+   };
+
+   static QHash<QString, CachedBlame> &blameCache();
+   /*!
+    \brief Retrieves the usage order of the blame cache entries, used to evict the least recently used one.
+
+    \return The keys of the cache ordered from least to most recently used.
+   */
+   static QStringList &blameCacheUsage();
+   /*!
+    \brief Builds the cache key that identifies the blame of the current file at \p sha.
+
+    \param sha The commit SHA the file is blamed at.
+    \return QString The cache key.
+   */
+   QString blameCacheKey(const QString &sha) const;
    /*!
-    \brief Processes a blame converting the git output into a vector of annotations per each line.
+    \brief Repaints the annotation view from the cached blame of \p sha, if present.
 
-    \param blame The git blame output.
-    \return QVector<Annotation> Vector of the annotations for every line.
+    \param sha The commit SHA the file is blamed at.
+    \return bool True if a cached blame was applied, otherwise false.
    */
-   QVector<Annotation> processBlame(const QString &blame);
+   bool applyCachedBlame(const QString &sha);
    /*!
-    \brief Process all the \p annotations and creates the view of the file with that information.
+    \brief Stores the just finished blame in the cache, evicting the least recently used entry when full.
+
+   */
+   void storeBlameInCache();
+   /*!
+    \brief Clears the annotation view and the streaming state so a new blame can be painted.
+
+   */
+   void resetAnnotationView();
+   /*!
+    \brief Processes a chunk of the blame output as it arrives, painting the lines that are already resolved.
+
+    \param data The new chunk of blame output.
+   */
+   void onBlameDataReady(const QByteArray &data);
+   /*!
+    \brief Finalizes the annotation view once the blame process ends or warns the user if the file is not in Git.
+
+    \param result The result of the blame process.
+   */
+   void onBlameFinished(const GitExecResult &result);
+   /*!
+    \brief Processes a blame line converting the git output into the annotation of that line.
+
+    \param line The git blame output line.
+    \return Annotation The annotation of the line.
+   */
+   Annotation parseBlameLine(const QString &line);
+   /*!
+    \brief Appends the given \p annotations to the annotation view.
 
     \param annotations The annotations to process.
    */
-   void formatAnnotatedFile(const QVector<Annotation> &annotations);
+   void appendAnnotations(const QVector<Annotation> &annotations);
+   /*!
+    \brief Collects the commit epochs of \p annotations and recomputes the quantile boundaries of
+    the age buckets.
+
+    \param annotations The annotations to process.
+   */
+   void rebuildAgeBuckets(const QVector<Annotation> &annotations);
+   /*!
+    \brief Adds the date, author and message labels of the annotation group being built to the layout.
+
+   */
+   void flushPendingLabels();
    /*!
     \brief Factory method that creates a label with the date and time based on an annotation.
 
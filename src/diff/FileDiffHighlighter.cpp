@@ -1,35 +1,104 @@
 #include "FileDiffHighlighter.h"
 
 #include <GitQlientStyles.h>
+#include <QHash>
+#include <QSet>
 #include <QTextDocument>
 
+#include <algorithm>
+
 FileDiffHighlighter::FileDiffHighlighter(QTextDocument *document)
    : QSyntaxHighlighter(document)
 {
 }
 
+void FileDiffHighlighter::setDiffInfo(const QVector<ChunkDiffInfo::ChunkInfo> &fileDiffInfo)
+{
+   const auto oldChunks = mSortedChunks;
+
+   mFileDiffInfo = fileDiffInfo;
+   mSortedChunks = fileDiffInfo;
+   std::sort(mSortedChunks.begin(), mSortedChunks.end(),
+             [](const ChunkDiffInfo::ChunkInfo &l, const ChunkDiffInfo::ChunkInfo &r) {
+                return l.startLine < r.startLine;
+             });
+
+   if (!document() || document()->isEmpty())
+      return;
+
+   // Only the blocks whose decoration changed between the old and the new chunk set get
+   // rehighlighted instead of re-running the highlighter over the whole document.
+   const auto keyOf
+       = [](const ChunkDiffInfo::ChunkInfo &chunk) { return (qint64(chunk.startLine) << 1) | qint64(chunk.addition); };
+
+   QHash<qint64, int> oldIndex;
+   QHash<qint64, int> newIndex;
+
+   for (const auto &chunk : oldChunks)
+      oldIndex.insert(keyOf(chunk), chunk.endLine);
+
+   for (const auto &chunk : qAsConst(mSortedChunks))
+      newIndex.insert(keyOf(chunk), chunk.endLine);
+
+   QSet<int> linesToRefresh;
+
+   for (const auto &chunk : oldChunks)
+   {
+      if (newIndex.value(keyOf(chunk), -2) != chunk.endLine)
+         for (auto line = chunk.startLine; line <= chunk.endLine; ++line)
+            linesToRefresh.insert(line);
+   }
+
+   for (const auto &chunk : qAsConst(mSortedChunks))
+   {
+      if (oldIndex.value(keyOf(chunk), -2) != chunk.endLine)
+         for (auto line = chunk.startLine; line <= chunk.endLine; ++line)
+            linesToRefresh.insert(line);
+   }
+
+   for (const auto line : qAsConst(linesToRefresh))
+   {
+      if (const auto block = document()->findBlockByNumber(line - mStartingLine - 1); block.isValid())
+         rehighlightBlock(block);
+   }
+}
+
+void FileDiffHighlighter::addRefinementSpans(int line, const QVector<QPair<int, int>> &spans)
+{
+   mRefinementSpans.insert(line, spans);
+
+   if (const auto block = document()->findBlockByNumber(line - mStartingLine - 1); block.isValid())
+      rehighlightBlock(block);
+}
+
 void FileDiffHighlighter::highlightBlock(const QString &text)
 {
    setCurrentBlockState(previousBlockState() + 1);
 
    QTextBlockFormat myFormat;
    QTextCharFormat format;
-   const auto currentLine = currentBlock().blockNumber() + 1;
+   const auto currentLine = currentBlock().blockNumber() + mStartingLine + 1;
 
-   if (!mFileDiffInfo.isEmpty())
+   if (!mSortedChunks.isEmpty())
    {
-      for (const auto &diff : qAsConst(mFileDiffInfo))
+      // The chunks are sorted by start line, so the candidate containing the current line is
+      // found with a binary search instead of scanning the whole chunk list per block.
+      auto iter = std::upper_bound(
+          mSortedChunks.constBegin(), mSortedChunks.constEnd(), currentLine,
+          [](int line, const ChunkDiffInfo::ChunkInfo &chunk) { return line < chunk.startLine; });
+
+      for (; iter != mSortedChunks.constBegin();)
       {
-         if (diff.startLine <= currentLine && currentLine <= diff.endLine)
+         --iter;
+
+         if (iter->startLine <= currentLine && currentLine <= iter->endLine)
          {
-            if (diff.addition)
-            {
-               myFormat.setBackground(GitQlientStyles::getGreen());
-               // myFormat.setForeground(GitQlientStyles::getGreen());
-            }
-            else
-               myFormat.setBackground(GitQlientStyles::getRed());
+            myFormat.setBackground(iter->addition ? GitQlientStyles::getGreen() : GitQlientStyles::getRed());
+            break;
          }
+
+         if (iter->endLine < currentLine)
+            break;
       }
    }
    else if (!text.isEmpty())
@@ -56,4 +125,13 @@ void FileDiffHighlighter::highlightBlock(const QString &text)
       QTextCursor(currentBlock()).setBlockFormat(myFormat);
       setFormat(0, currentBlock().length(), format);
    }
+
+   // The word-level spans computed by IntraLineDiff are painted on top of the line decoration
+   for (const auto &span : mRefinementSpans.value(currentLine))
+   {
+      auto spanFormat = format;
+      spanFormat.setFontWeight(QFont::Bold);
+      spanFormat.setFontUnderline(true);
+      setFormat(span.first, span.second, spanFormat);
+   }
 }
@@ -23,6 +23,7 @@
  ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
  ***************************************************************************************/
 
+#include <QHash>
 #include <QSyntaxHighlighter>
 #include <DiffInfo.h>
 
@@ -55,8 +56,30 @@ public:
     * @brief setDiffInfo Sets the file diff information that will be used to colour the foreground and background text.
     * @param fileDiffInfo The file diff information.
     */
-   void setDiffInfo(const QVector<ChunkDiffInfo::ChunkInfo> &fileDiffInfo) { mFileDiffInfo = fileDiffInfo; }
+   void setDiffInfo(const QVector<ChunkDiffInfo::ChunkInfo> &fileDiffInfo);
+
+   /**
+    * @brief setStartingLine Sets the line of the full document that the first block of the QTextDocument represents.
+    * Used when the view only materializes a window of a bigger buffer.
+    * @param line The first line shown in the document.
+    */
+   void setStartingLine(int line) { mStartingLine = line; }
+
+   /**
+    * @brief addRefinementSpans Adds the word-level changed spans of @p line and rehighlights its block.
+    * @param line The line the spans belong to.
+    * @param spans The changed spans as pairs of start position and length.
+    */
+   void addRefinementSpans(int line, const QVector<QPair<int, int>> &spans);
+
+   /**
+    * @brief clearRefinementSpans Removes all the word-level spans. Called when a new diff is loaded.
+    */
+   void clearRefinementSpans() { mRefinementSpans.clear(); }
 
 private:
    QVector<ChunkDiffInfo::ChunkInfo> mFileDiffInfo;
+   QVector<ChunkDiffInfo::ChunkInfo> mSortedChunks;
+   QHash<int, QVector<QPair<int, int>>> mRefinementSpans;
+   int mStartingLine = 0;
 };
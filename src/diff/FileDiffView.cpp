@@ -58,9 +58,29 @@
 
 #include <QScrollBar>
 #include <QMenu>
+#include <QPlainTextDocumentLayout>
+#include <QTimer>
 
 using namespace QLogger;
 
+namespace
+{
+// Size in characters of the batches appended to the document when loading a large diff.
+constexpr auto DiffBatchSize = 64 * 1024;
+
+// Minimum number of lines to switch to the virtual document mode.
+constexpr auto VirtualModeMinLines = 20000;
+
+// Number of lines materialized into the document in virtual mode.
+constexpr auto VirtualWindowLines = 5000;
+
+// Distance in lines to the window edge at which the window is shifted.
+constexpr auto VirtualWindowMargin = 500;
+
+// Number of fully-built documents kept per view, so switching back to a recent file is a swap.
+constexpr auto MaxCachedDocuments = 8;
+}
+
 FileDiffView::FileDiffView(QWidget *parent)
    : QPlainTextEdit(parent)
    , mDiffHighlighter(new FileDiffHighlighter(document()))
@@ -69,10 +89,15 @@ FileDiffView::FileDiffView(QWidget *parent)
    setReadOnly(true);
    setContextMenuPolicy(Qt::CustomContextMenu);
 
+   // The document created by the widget acts as the scratch pad for the uncached loads
+   mScratchDocument = document();
+   mScratchHighlighter = mDiffHighlighter;
+
    connect(this, &FileDiffView::customContextMenuRequested, this, &FileDiffView::showStagingMenu);
    connect(this, &FileDiffView::blockCountChanged, this, &FileDiffView::updateLineNumberAreaWidth);
    connect(this, &FileDiffView::updateRequest, this, &FileDiffView::updateLineNumberArea);
    connect(verticalScrollBar(), &QScrollBar::valueChanged, this, &FileDiffView::signalScrollChanged);
+   connect(verticalScrollBar(), &QScrollBar::valueChanged, this, &FileDiffView::onVirtualScroll);
 }
 
 FileDiffView::~FileDiffView()
@@ -91,7 +116,8 @@ void FileDiffView::addNumberArea(LineNumberArea *numberArea)
    }
 }
 
-void FileDiffView::loadDiff(const QString &text, const QVector<ChunkDiffInfo::ChunkInfo> &fileDiffInfo)
+void FileDiffView::loadDiff(const QString &text, const QVector<ChunkDiffInfo::ChunkInfo> &fileDiffInfo,
+                            const QString &documentCacheKey)
 {
    QLog_Trace("UI",
               QString("FileDiffView::loadDiff - {%1} move scroll to pos {%2}")
@@ -99,14 +125,106 @@ void FileDiffView::loadDiff(const QString &text, const QVector<ChunkDiffInfo::Ch
 
    mFileDiffInfo = fileDiffInfo;
 
-   mDiffHighlighter->setDiffInfo(mFileDiffInfo);
+   if (!mPendingDiffText.isEmpty())
+   {
+      // An interrupted batched load leaves its document half built, so it cannot be served from
+      // the cache later on
+      if (!mCurrentDocumentKey.isEmpty())
+         removeCachedDocument(mCurrentDocumentKey);
+
+      mPendingDiffText.clear();
+      mPendingDiffPos = 0;
+   }
+
+   mVirtualMode = false;
+   mVirtualText.clear();
+   mVirtualLineOffsets.clear();
+   mVirtualFirstLine = 0;
 
    const auto pos = verticalScrollBar()->value();
-   auto cursor = textCursor();
    const auto tmpCursor = textCursor().position();
-   setPlainText(text);
 
-   cursor.setPosition(tmpCursor);
+   if (const auto iter = mDocumentCache.constFind(documentCacheKey);
+       !documentCacheKey.isEmpty() && iter != mDocumentCache.cend())
+   {
+      // The fully-built document is swapped in as-is: it keeps the formats its own highlighter
+      // already applied, so neither parsing nor highlighting happens again
+      mDiffHighlighter = iter.value()->findChild<FileDiffHighlighter *>();
+      mCurrentDocumentKey = documentCacheKey;
+
+      setDocument(iter.value());
+
+      mDocumentCacheUsage.removeOne(documentCacheKey);
+      mDocumentCacheUsage.append(documentCacheKey);
+   }
+   else
+   {
+      const auto totalLines = text.count('\n') + 1;
+
+      // Virtual documents mutate while scrolling, so they are never cached
+      if (!documentCacheKey.isEmpty() && totalLines <= VirtualModeMinLines)
+      {
+         const auto doc = new QTextDocument(this);
+         doc->setDocumentLayout(new QPlainTextDocumentLayout(doc));
+         doc->setDefaultFont(document()->defaultFont());
+
+         mDiffHighlighter = new FileDiffHighlighter(doc);
+         mCurrentDocumentKey = documentCacheKey;
+
+         setDocument(doc);
+         insertCachedDocument(documentCacheKey, doc);
+      }
+      else if (document() != mScratchDocument)
+      {
+         // Uncacheable content must not overwrite a cached document
+         mDiffHighlighter = mScratchHighlighter;
+         mCurrentDocumentKey.clear();
+
+         setDocument(mScratchDocument);
+      }
+
+      mDiffHighlighter->clearRefinementSpans();
+      mDiffHighlighter->setDiffInfo(mFileDiffInfo);
+      mDiffHighlighter->setStartingLine(0);
+
+      if (totalLines > VirtualModeMinLines)
+      {
+         // Huge documents are kept in a line-indexed buffer and only a window around the visible
+         // range is materialized, so the time to open a diff does not depend on its size.
+         mVirtualMode = true;
+         mVirtualText = text;
+         mVirtualLineOffsets.reserve(totalLines);
+         mVirtualLineOffsets.append(0);
+
+         for (auto i = text.indexOf('\n'); i != -1; i = text.indexOf('\n', i + 1))
+            mVirtualLineOffsets.append(i + 1);
+
+         materializeVirtualWindow(0);
+      }
+      else if (text.length() > DiffBatchSize)
+      {
+         // Only the first screenful is loaded synchronously; the rest of the diff is appended in
+         // batches so huge diffs don't block the UI while the document is built.
+         auto firstBatchEnd = text.indexOf('\n', DiffBatchSize);
+
+         if (firstBatchEnd == -1)
+            firstBatchEnd = text.length();
+
+         setPlainText(text.left(firstBatchEnd));
+
+         if (firstBatchEnd < text.length())
+         {
+            mPendingDiffText = text;
+            mPendingDiffPos = firstBatchEnd;
+            QTimer::singleShot(0, this, &FileDiffView::appendPendingDiff);
+         }
+      }
+      else
+         setPlainText(text);
+   }
+
+   auto cursor = textCursor();
+   cursor.setPosition(qMin(tmpCursor, document()->characterCount() - 1));
    setTextCursor(cursor);
 
    blockSignals(true);
@@ -119,6 +237,138 @@ void FileDiffView::loadDiff(const QString &text, const QVector<ChunkDiffInfo::Ch
               QString("FileDiffView::loadDiff - {%1} move scroll to pos {%2}").arg(objectName(), QString::number(pos)));
 }
 
+void FileDiffView::clearDiff()
+{
+   if (document() != mScratchDocument)
+   {
+      mDiffHighlighter = mScratchHighlighter;
+      mCurrentDocumentKey.clear();
+
+      setDocument(mScratchDocument);
+   }
+
+   clear();
+}
+
+void FileDiffView::insertCachedDocument(const QString &key, QTextDocument *document)
+{
+   mDocumentCache.insert(key, document);
+   mDocumentCacheUsage.removeOne(key);
+   mDocumentCacheUsage.append(key);
+
+   // The first candidate is never the displayed document: its key was touched last
+   while (mDocumentCacheUsage.count() > MaxCachedDocuments)
+      delete mDocumentCache.take(mDocumentCacheUsage.takeFirst());
+}
+
+void FileDiffView::removeCachedDocument(const QString &key)
+{
+   if (const auto doc = mDocumentCache.take(key))
+   {
+      mDocumentCacheUsage.removeOne(key);
+
+      // The document may still be installed in the view, so its deletion is delayed until the
+      // caller has put a new one in place
+      if (doc == document())
+         doc->deleteLater();
+      else
+         delete doc;
+   }
+
+   if (mCurrentDocumentKey == key)
+      mCurrentDocumentKey.clear();
+}
+
+void FileDiffView::addRefinementSpans(int line, const QVector<QPair<int, int>> &spans)
+{
+   mDiffHighlighter->addRefinementSpans(line, spans);
+}
+
+void FileDiffView::materializeVirtualWindow(int firstLine)
+{
+   const auto lineCount = mVirtualLineOffsets.count();
+   firstLine = qBound(0, firstLine, qMax(0, lineCount - VirtualWindowLines));
+
+   const auto lastLine = qMin(firstLine + VirtualWindowLines, lineCount);
+   const auto start = mVirtualLineOffsets.at(firstLine);
+   const auto end = lastLine < lineCount ? mVirtualLineOffsets.at(lastLine) - 1 : mVirtualText.length();
+
+   mVirtualFirstLine = firstLine;
+   mStartingLine = firstLine;
+   mDiffHighlighter->setStartingLine(firstLine);
+
+   mAdjustingVirtualWindow = true;
+   setPlainText(mVirtualText.mid(start, end - start));
+   mAdjustingVirtualWindow = false;
+
+   if (mLineNumberArea)
+      mLineNumberArea->update();
+}
+
+void FileDiffView::onVirtualScroll(int value)
+{
+   if (!mVirtualMode || mAdjustingVirtualWindow)
+      return;
+
+   const auto lineCount = mVirtualLineOffsets.count();
+
+   if (value >= verticalScrollBar()->maximum() - VirtualWindowMargin
+       && mVirtualFirstLine + VirtualWindowLines < lineCount)
+   {
+      const auto newFirst = qMin(mVirtualFirstLine + VirtualWindowLines / 2, lineCount - VirtualWindowLines);
+      const auto offset = newFirst - mVirtualFirstLine;
+
+      materializeVirtualWindow(newFirst);
+
+      mAdjustingVirtualWindow = true;
+      verticalScrollBar()->setValue(value - offset);
+      mAdjustingVirtualWindow = false;
+   }
+   else if (value <= VirtualWindowMargin && mVirtualFirstLine > 0)
+   {
+      const auto newFirst = qMax(0, mVirtualFirstLine - VirtualWindowLines / 2);
+      const auto offset = mVirtualFirstLine - newFirst;
+
+      materializeVirtualWindow(newFirst);
+
+      mAdjustingVirtualWindow = true;
+      verticalScrollBar()->setValue(value + offset);
+      mAdjustingVirtualWindow = false;
+   }
+}
+
+void FileDiffView::appendPendingDiff()
+{
+   if (mPendingDiffText.isEmpty())
+      return;
+
+   auto batchEnd = mPendingDiffText.indexOf('\n', mPendingDiffPos + DiffBatchSize);
+
+   if (batchEnd == -1)
+      batchEnd = mPendingDiffText.length();
+
+   const auto pos = verticalScrollBar()->value();
+
+   auto cursor = QTextCursor(document());
+   cursor.movePosition(QTextCursor::End);
+   cursor.insertText(mPendingDiffText.mid(mPendingDiffPos, batchEnd - mPendingDiffPos));
+
+   blockSignals(true);
+   verticalScrollBar()->setValue(pos);
+   blockSignals(false);
+
+   if (batchEnd < mPendingDiffText.length())
+   {
+      mPendingDiffPos = batchEnd;
+      QTimer::singleShot(0, this, &FileDiffView::appendPendingDiff);
+   }
+   else
+   {
+      mPendingDiffText.clear();
+      mPendingDiffPos = 0;
+   }
+}
+
 void FileDiffView::moveScrollBarToPos(int value)
 {
    blockSignals(true);
@@ -273,6 +523,10 @@ void FileDiffView::showStagingMenu(const QPoint &cursorPos)
             connect(stageChunk, &QAction::triggered, this,
                     [this, chunkId = chunk->id]() { emit signalStageChunk(chunkId); });
 
+            const auto unstageChunk = menu->addAction(tr("Unstage chunk"));
+            connect(unstageChunk, &QAction::triggered, this,
+                    [this, chunkId = chunk->id]() { emit signalUnstageChunk(chunkId); });
+
             menu->move(viewport()->mapToGlobal(cursorPos));
             menu->exec();
          }
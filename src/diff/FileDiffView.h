@@ -51,6 +51,7 @@
 **
 ****************************************************************************/
 
+#include <QHash>
 #include <QPlainTextEdit>
 #include <DiffInfo.h>
 
@@ -80,6 +81,12 @@ signals:
     */
    void signalStageChunk(const QString &id);
 
+   /**
+    * @brief signalUnstageChunk Signal triggered when the user orders to unstage a chunk.
+    * @param id The chunk id.
+    */
+   void signalUnstageChunk(const QString &id);
+
 public:
    /*!
     \brief Default constructor.
@@ -98,10 +105,26 @@ public:
    /**
     * @brief loadDiff Loads the text edit based on a diff text.
     * @param text The text representing a diff
+    * @param fileDiffInfo The chunks of the diff.
+    * @param documentCacheKey When set, the fully-built document is kept in an LRU keyed by this value and later loads
+    * of the same key swap it in without parsing or highlighting again.
     * @return True if correctly loaded, otherwise false.
     */
    void loadDiff(const QString &text,
-                 const QVector<ChunkDiffInfo::ChunkInfo> &fileDiffInfo = QVector<ChunkDiffInfo::ChunkInfo>());
+                 const QVector<ChunkDiffInfo::ChunkInfo> &fileDiffInfo = QVector<ChunkDiffInfo::ChunkInfo>(),
+                 const QString &documentCacheKey = QString());
+
+   /**
+    * @brief hasCachedDocument Tells whether a fully-built document is stored for @p documentCacheKey.
+    * @param documentCacheKey The key used when the diff was loaded.
+    * @return True if the document is cached, otherwise false.
+    */
+   bool hasCachedDocument(const QString &documentCacheKey) const { return mDocumentCache.contains(documentCacheKey); }
+
+   /**
+    * @brief clearDiff Clears the view leaving the cached documents untouched.
+    */
+   void clearDiff();
 
    /**
     * @brief moveScrollBarToPos Moves the vertical scroll bar to the value defined in @p value.
@@ -121,6 +144,13 @@ public:
     */
    void setUnifiedDiff(bool unified) { mUnified = unified; }
 
+   /**
+    * @brief addRefinementSpans Forwards the word-level changed spans of @p line to the highlighter.
+    * @param line The line the spans belong to.
+    * @param spans The changed spans as pairs of start position and length.
+    */
+   void addRefinementSpans(int line, const QVector<QPair<int, int>> &spans);
+
    /**
     * @brief getHeight Gets the approximated height of the widget based on the text of the QTextDocument.
     * @return The height.
@@ -177,7 +207,53 @@ private:
     */
    int lineNumberAreaWidth();
 
+   /**
+    * @brief appendPendingDiff Appends the next batch of a large diff to the document. The remaining text is scheduled
+    * again until the whole diff is loaded, keeping the UI responsive while the first screen is already visible.
+    */
+   void appendPendingDiff();
+
+   /**
+    * @brief materializeVirtualWindow Fills the document with the lines of the virtual buffer starting at
+    * @p firstLine, keeping the line number area and the highlighter in sync with the real line numbers.
+    * @param firstLine The first line of the buffer to materialize.
+    */
+   void materializeVirtualWindow(int firstLine);
+
+   /**
+    * @brief onVirtualScroll Shifts the materialized window when the scroll position gets close to one of its edges.
+    * @param value The new scrollbar position.
+    */
+   void onVirtualScroll(int value);
+
+   /**
+    * @brief insertCachedDocument Stores @p document in the LRU under @p key, evicting the least recently used entries
+    * beyond the cache capacity.
+    * @param key The cache key of the document.
+    * @param document The fully-built document.
+    */
+   void insertCachedDocument(const QString &key, QTextDocument *document);
+
+   /**
+    * @brief removeCachedDocument Drops the document stored under @p key, if any. Used when a load is interrupted and
+    * the document would stay half built.
+    * @param key The cache key of the document.
+    */
+   void removeCachedDocument(const QString &key);
+
    QVector<ChunkDiffInfo::ChunkInfo> mFileDiffInfo;
+   QTextDocument *mScratchDocument = nullptr;
+   FileDiffHighlighter *mScratchHighlighter = nullptr;
+   QString mCurrentDocumentKey;
+   QHash<QString, QTextDocument *> mDocumentCache;
+   QStringList mDocumentCacheUsage;
+   QString mPendingDiffText;
+   int mPendingDiffPos = 0;
+   bool mVirtualMode = false;
+   QString mVirtualText;
+   QVector<int> mVirtualLineOffsets;
+   int mVirtualFirstLine = 0;
+   bool mAdjustingVirtualWindow = false;
    LineNumberArea *mLineNumberArea = nullptr;
    FileDiffHighlighter *mDiffHighlighter = nullptr;
    int mStartingLine = 0;
@@ -11,10 +11,13 @@
 #include <GitLocal.h>
 #include <GitPatches.h>
 #include <GitQlientSettings.h>
+#include <GitWip.h>
+#include <IntraLineDiff.h>
 #include <LineNumberArea.h>
 
 #include <QDateTime>
 #include <QDir>
+#include <QFileInfo>
 #include <QHBoxLayout>
 #include <QLabel>
 #include <QLineEdit>
@@ -24,6 +27,55 @@
 #include <QStackedWidget>
 #include <QTemporaryFile>
 
+namespace
+{
+/**
+ * Parsed diffs between two commits are immutable, so they are kept in a small LRU cache shared
+ * by all the file diff widgets. WIP comparisons are cached too, with the modification time of
+ * the on-disk file as part of the key: saving the file changes the stamp, so a stale document is
+ * never served and superseded entries simply age out of the LRU.
+ */
+struct CachedFileDiff
+{
+   QString text;
+   DiffInfo chunks;
+   QPair<QStringList, QVector<ChunkDiffInfo::ChunkInfo>> oldData;
+   QPair<QStringList, QVector<ChunkDiffInfo::ChunkInfo>> newData;
+};
+
+constexpr auto MaxCachedDiffs = 100;
+
+// Files bigger than this are not piped through the diff parser unless the user asks for it
+constexpr auto MaxRenderableFileSize = qint64(10) * 1024 * 1024;
+
+QHash<QString, CachedFileDiff> &diffCache()
+{
+   static QHash<QString, CachedFileDiff> cache;
+   return cache;
+}
+
+QStringList &diffCacheUsage()
+{
+   static QStringList usage;
+   return usage;
+}
+
+void touchDiffCacheEntry(const QString &key)
+{
+   diffCacheUsage().removeOne(key);
+   diffCacheUsage().append(key);
+}
+
+void insertDiffCacheEntry(const QString &key, const CachedFileDiff &diff)
+{
+   diffCache().insert(key, diff);
+   touchDiffCacheEntry(key);
+
+   while (diffCacheUsage().count() > MaxCachedDiffs)
+      diffCache().remove(diffCacheUsage().takeFirst());
+}
+}
+
 FileDiffWidget::FileDiffWidget(const QSharedPointer<GitBase> &git, QSharedPointer<GitCache> cache, QWidget *parent)
    : IDiffWidget(git, cache, parent)
    , mBack(new QPushButton())
@@ -42,10 +94,18 @@ FileDiffWidget::FileDiffWidget(const QSharedPointer<GitBase> &git, QSharedPointe
    , mOldFile(new FileDiffView())
    , mFileEditor(new FileEditor())
    , mViewStackedWidget(new QStackedWidget())
+   , mIntraLineDiff(new IntraLineDiff(this))
+   , mPlaceholderLabel(new QLabel())
+   , mLoadAnyway(new QPushButton())
 {
    mNewFile->addNumberArea(new LineNumberArea(mNewFile));
    mOldFile->addNumberArea(new LineNumberArea(mOldFile));
 
+   connect(mIntraLineDiff, &IntraLineDiff::spanReady, this,
+           [this](int line, bool inNewFile, const QVector<QPair<int, int>> &spans) {
+              (inNewFile ? mNewFile : mOldFile)->addRefinementSpans(line, spans);
+           });
+
    mNewFile->setObjectName("newFile");
    mOldFile->setObjectName("oldFile");
 
@@ -97,6 +157,26 @@ FileDiffWidget::FileDiffWidget(const QSharedPointer<GitBase> &git, QSharedPointe
    mViewStackedWidget->addWidget(diffFrame);
    mViewStackedWidget->addWidget(mFileEditor);
 
+   mPlaceholderLabel->setAlignment(Qt::AlignCenter);
+
+   mLoadAnyway->setText(tr("Load anyway"));
+   connect(mLoadAnyway, &QPushButton::clicked, this, [this]() {
+      mForceLoad = true;
+      configure(mCurrentSha, mPreviousSha, mCurrentFile, mIsCached);
+      mForceLoad = false;
+   });
+
+   const auto placeholderLayout = new QVBoxLayout();
+   placeholderLayout->setSpacing(10);
+   placeholderLayout->addStretch();
+   placeholderLayout->addWidget(mPlaceholderLabel);
+   placeholderLayout->addWidget(mLoadAnyway, 0, Qt::AlignHCenter);
+   placeholderLayout->addStretch();
+
+   const auto placeholderFrame = new QFrame();
+   placeholderFrame->setLayout(placeholderLayout);
+   mViewStackedWidget->addWidget(placeholderFrame);
+
    mTitleFrame->setVisible(false);
 
    const auto titleLayout = new QHBoxLayout(mTitleFrame);
@@ -167,15 +247,17 @@ FileDiffWidget::FileDiffWidget(const QSharedPointer<GitBase> &git, QSharedPointe
 
    connect(mNewFile, &FileDiffView::signalScrollChanged, mOldFile, &FileDiffView::moveScrollBarToPos);
    connect(mNewFile, &FileDiffView::signalStageChunk, this, &FileDiffWidget::stageChunk);
+   connect(mNewFile, &FileDiffView::signalUnstageChunk, this, &FileDiffWidget::unstageChunk);
    connect(mOldFile, &FileDiffView::signalScrollChanged, mNewFile, &FileDiffView::moveScrollBarToPos);
    connect(mOldFile, &FileDiffView::signalStageChunk, this, &FileDiffWidget::stageChunk);
+   connect(mOldFile, &FileDiffView::signalUnstageChunk, this, &FileDiffWidget::unstageChunk);
 
    setAttribute(Qt::WA_DeleteOnClose);
 }
 
 void FileDiffWidget::clear()
 {
-   mNewFile->clear();
+   mNewFile->clearDiff();
 }
 
 bool FileDiffWidget::reload()
@@ -194,22 +276,72 @@ bool FileDiffWidget::configure(const QString &currentSha, const QString &previou
    if (destFile.contains("-->"))
       destFile = destFile.split("--> ").last().split("(").first().trimmed();
 
-   QScopedPointer<GitHistory> git(new GitHistory(mGit));
-   auto text
-       = git->getFileDiff(currentSha == CommitInfo::ZERO_SHA ? QString() : currentSha, previousSha, destFile, isCached);
-
-   if (text.isEmpty())
+   const auto isWip = currentSha == CommitInfo::ZERO_SHA;
+   // The file stamp invalidates on saves, the index stamp on stage/unstage operations
+   const auto modified = isWip
+       ? QFileInfo(mGit->getWorkingDir() + "/" + destFile).lastModified().toMSecsSinceEpoch()
+           + QFileInfo(mGit->getGitDir() + "/index").lastModified().toMSecsSinceEpoch()
+       : qint64(0);
+   const auto cacheKey = QString("%1|%2|%3|%4|%5|%6").arg(mGit->getGitDir(), currentSha, previousSha, destFile,
+                                                          QString::number(isCached), QString::number(modified));
+   const auto cacheHit = diffCache().contains(cacheKey);
+
+   QString text;
+
+   if (cacheHit)
    {
-      if (const auto ret = git->getUntrackedFileDiff(destFile); ret.success)
-         text = ret.output.toString();
+      text = diffCache().value(cacheKey).text;
+      touchDiffCacheEntry(cacheKey);
    }
+   else
+   {
+      QScopedPointer<GitHistory> git(new GitHistory(mGit));
 
-   if (text.startsWith("* "))
-      return false;
+      // Pre-flight stage: binary or huge files would freeze the session being piped through the
+      // parser, so a placeholder is rendered instead and the content only loads on explicit request
+      if (!mForceLoad)
+      {
+         const auto fileSize = git->getFileSize(isWip ? QString() : currentSha, destFile);
+         const auto oversized = fileSize > MaxRenderableFileSize;
+         // The binary probe is skipped for oversized files: the placeholder is shown either way
+         const auto isBinary
+             = !oversized && git->isFileBinary(isWip ? QString() : currentSha, previousSha, destFile, isCached);
+
+         if (oversized || isBinary)
+         {
+            mFileNameLabel->setText(file);
+
+            mIsCached = isCached;
+            mCurrentFile = file;
+            mCurrentSha = currentSha;
+            mPreviousSha = previousSha;
+
+            showPlaceholder(isBinary, fileSize);
+
+            return true;
+         }
+      }
+
+      text = git->getFileDiff(isWip ? QString() : currentSha, previousSha, destFile, isCached);
+
+      if (text.isEmpty())
+      {
+         if (const auto ret = git->getUntrackedFileDiff(destFile); ret.success)
+            text = ret.output.toString();
+      }
+
+      if (text.startsWith("* "))
+         return false;
+
+      auto pos = 0;
+      for (auto i = 0; i < 5; ++i)
+         pos = text.indexOf("\n", pos + 1);
+
+      text = text.mid(pos + 1);
+   }
 
    mFileNameLabel->setText(file);
 
-   const auto isWip = currentSha == CommitInfo::ZERO_SHA;
    mBack->setVisible(isWip);
    mEdition->setVisible(isWip);
    mSave->setVisible(isWip);
@@ -222,34 +354,56 @@ bool FileDiffWidget::configure(const QString &currentSha, const QString &previou
    mCurrentSha = currentSha;
    mPreviousSha = previousSha;
 
-   auto pos = 0;
-   for (auto i = 0; i < 5; ++i)
-      pos = text.indexOf("\n", pos + 1);
-
-   text = text.mid(pos + 1);
-
    if (!text.isEmpty())
    {
+      if (mViewStackedWidget->currentIndex() == 2)
+         mViewStackedWidget->setCurrentIndex(0);
+
+      // Separate documents are kept for the unified and the split rendering of the same diff
+      const auto docCacheKey = QString("%1|%2").arg(cacheKey, mFileVsFile ? "split" : "full");
+
       if (mFileVsFile)
       {
          QPair<QStringList, QVector<ChunkDiffInfo::ChunkInfo>> oldData;
          QPair<QStringList, QVector<ChunkDiffInfo::ChunkInfo>> newData;
 
-         mChunks = DiffHelper::processDiff(text, newData, oldData);
+         if (cacheHit)
+         {
+            const auto &cached = diffCache()[cacheKey];
+            mChunks = cached.chunks;
+            oldData = cached.oldData;
+            newData = cached.newData;
+         }
+         else
+         {
+            mChunks = DiffHelper::processDiff(text, newData, oldData);
+
+            insertDiffCacheEntry(cacheKey, { text, mChunks, oldData, newData });
+         }
+
+         // Cached documents already carry the word-level refinement in their formats
+         const auto documentsCached
+             = mNewFile->hasCachedDocument(docCacheKey) && mOldFile->hasCachedDocument(docCacheKey);
 
          mOldFile->blockSignals(true);
-         mOldFile->loadDiff(oldData.first.join('\n'), oldData.second);
+         mOldFile->loadDiff(oldData.first.join('\n'), oldData.second, docCacheKey);
          mOldFile->blockSignals(false);
 
          mNewFile->blockSignals(true);
-         mNewFile->loadDiff(newData.first.join('\n'), newData.second);
+         mNewFile->loadDiff(newData.first.join('\n'), newData.second, docCacheKey);
          mNewFile->blockSignals(false);
+
+         if (!documentsCached)
+            mIntraLineDiff->refine(mChunks.chunks, oldData.first, newData.first);
       }
       else
       {
          mNewFile->blockSignals(true);
-         mNewFile->loadDiff(text, {});
+         mNewFile->loadDiff(text, {}, docCacheKey);
          mNewFile->blockSignals(false);
+
+         if (!cacheHit)
+            insertDiffCacheEntry(cacheKey, { text, DiffInfo(), {}, {} });
       }
 
       if (editMode)
@@ -271,6 +425,21 @@ bool FileDiffWidget::configure(const QString &currentSha, const QString &previou
    return false;
 }
 
+void FileDiffWidget::showPlaceholder(bool isBinary, qint64 fileSize)
+{
+   if (isBinary)
+      mPlaceholderLabel->setText(tr("The file is binary and cannot be shown as text."));
+   else
+   {
+      mPlaceholderLabel->setText(
+          tr("The file is too big to be shown automatically (%1 MB).").arg(fileSize / (1024.0 * 1024.0), 0, 'f', 1));
+   }
+
+   mLoadAnyway->setVisible(!isBinary);
+
+   mViewStackedWidget->setCurrentIndex(2);
+}
+
 void FileDiffWidget::setSplitViewEnabled(bool enable)
 {
    mFileVsFile = enable;
@@ -442,6 +611,16 @@ void FileDiffWidget::revertFile()
 }
 
 void FileDiffWidget::stageChunk(const QString &id)
+{
+   applyChunk(id, false);
+}
+
+void FileDiffWidget::unstageChunk(const QString &id)
+{
+   applyChunk(id, true);
+}
+
+void FileDiffWidget::applyChunk(const QString &id, bool unstage)
 {
    const auto iter = std::find_if(mChunks.chunks.cbegin(), mChunks.chunks.cend(),
                                   [id](const ChunkDiffInfo &info) { return id == info.id; });
@@ -515,8 +694,20 @@ void FileDiffWidget::stageChunk(const QString &id)
 
          QScopedPointer<GitPatches> git(new GitPatches(mGit));
 
-         if (const auto ret = git->stagePatch(f.fileName()); ret.success)
-            QMessageBox::information(this, tr("Changes staged!"), tr("The chunk has been successfully staged."));
+         if (const auto ret = unstage ? git->unstagePatch(f.fileName()) : git->stagePatch(f.fileName()); ret.success)
+         {
+            auto relativePath = filePath;
+
+            if (relativePath.startsWith('/'))
+               relativePath.remove(0, 1);
+
+            // Only the touched file is re-examined: the WIP status is delta-updated in the cache
+            // and the new index stamp invalidates only this file's cached diff document
+            QScopedPointer<GitWip> wip(new GitWip(mGit, mCache));
+            wip->updateWipForFile(relativePath);
+
+            configure(mCurrentSha, mPreviousSha, mCurrentFile, mIsCached);
+         }
          else
          {
 #ifdef DEBUG
@@ -529,7 +720,7 @@ void FileDiffWidget::stageChunk(const QString &id)
                f.close();
             }
 #endif
-            QMessageBox::information(this, tr("Stage failed"),
+            QMessageBox::information(this, unstage ? tr("Unstage failed") : tr("Stage failed"),
                                      tr("The chunk couldn't be applied:\n%1").arg(ret.output.toString()));
          }
       }
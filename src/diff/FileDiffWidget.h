@@ -36,6 +36,7 @@ class QStackedWidget;
 class QLabel;
 class QLineEdit;
 class QPlainTextEdit;
+class IntraLineDiff;
 
 /*!
  \brief The FileDiffWidget creates the layout that contains all the widgets related with the creation of the diff of a
@@ -143,6 +144,10 @@ private:
    int mCurrentChunkLine = 0;
    FileEditor *mFileEditor = nullptr;
    QStackedWidget *mViewStackedWidget = nullptr;
+   IntraLineDiff *mIntraLineDiff = nullptr;
+   QLabel *mPlaceholderLabel = nullptr;
+   QPushButton *mLoadAnyway = nullptr;
+   bool mForceLoad = false;
 
    /**
     * @brief moveChunkUp Moves to the previous diff chunk.
@@ -172,5 +177,29 @@ private:
     */
    void revertFile();
 
+   /**
+    * @brief stageChunk Stages the given diff chunk into the index.
+    * @param id The id of the chunk.
+    */
    void stageChunk(const QString &id);
+   /**
+    * @brief unstageChunk Removes the given diff chunk from the index through a reverse apply.
+    * @param id The id of the chunk.
+    */
+   void unstageChunk(const QString &id);
+   /**
+    * @brief applyChunk Builds the patch of the chunk, applies it to the index and delta-updates
+    * the cached WIP status of the touched file, so a hunk action never re-diffs the whole tree.
+    * @param id The id of the chunk.
+    * @param unstage True to reverse-apply the chunk.
+    */
+   void applyChunk(const QString &id, bool unstage);
+
+   /**
+    * @brief showPlaceholder Shows the placeholder page for a file whose diff is not rendered
+    * automatically, either because it is binary or because it exceeds the size limit.
+    * @param isBinary True when git reports a binary change.
+    * @param fileSize The size in bytes of the file.
+    */
+   void showPlaceholder(bool isBinary, qint64 fileSize);
 };
@@ -4,9 +4,19 @@
 #include <GitQlientStyles.h>
 #include <Highlighter.h>
 
+#include <QFileInfo>
 #include <QVBoxLayout>
 #include <QMessageBox>
 
+namespace
+{
+/* Files above this size are shown as a truncated read-only preview: QPlainTextEdit needs the
+   whole document in memory and the highlighter touches every block, so fully loading them
+   freezes the UI for seconds. */
+constexpr qint64 LargeFileSizeBytes = 5 * 1024 * 1024;
+constexpr qint64 LargeFilePreviewBytes = 512 * 1024;
+}
+
 FileEditor::FileEditor(bool highlighter, QWidget *parent)
    : QFrame(parent)
    , mFileEditor(new FileDiffEditor())
@@ -23,16 +33,24 @@ FileEditor::FileEditor(bool highlighter, QWidget *parent)
 void FileEditor::editFile(const QString &fileName)
 {
    mFileName = fileName;
+   mIsPreview = QFileInfo(mFileName).size() > LargeFileSizeBytes;
 
    QFile f(mFileName);
 
    if (f.open(QIODevice::ReadOnly))
    {
-      mLoadedContent = QString::fromUtf8(f.readAll());
+      mLoadedContent = QString::fromUtf8(mIsPreview ? f.read(LargeFilePreviewBytes) : f.readAll());
       f.close();
    }
 
+   if (mHighlighter)
+      mHighlighter->setDocument(mIsPreview ? nullptr : mFileEditor->document());
+
+   if (mIsPreview)
+      mLoadedContent.append(tr("\n\n--- File too large to edit. Only the beginning is shown. ---\n"));
+
    mFileEditor->loadDiff(mLoadedContent, {});
+   mFileEditor->setReadOnly(mIsPreview);
 
    isEditing = true;
 }
@@ -41,6 +59,15 @@ void FileEditor::finishEdition()
 {
    if (isEditing)
    {
+      if (mIsPreview)
+      {
+         isEditing = false;
+
+         emit signalEditionClosed();
+
+         return;
+      }
+
       const auto currentContent = mFileEditor->toPlainText();
       QFile f(mFileName);
       QString fileContent;
@@ -71,6 +98,9 @@ void FileEditor::finishEdition()
 
 void FileEditor::saveFile()
 {
+   if (mIsPreview)
+      return;
+
    const auto currentContent = mFileEditor->toPlainText();
 
    saveTextInFile(currentContent);
@@ -62,6 +62,7 @@ private:
    QString mFileName;
    QString mLoadedContent;
    bool isEditing = false;
+   bool mIsPreview = false;
 
    /**
     * @brief saveTextInFile Saves the current file.
@@ -1,44 +1,48 @@
 #include "FullDiffWidget.h"
 
 #include <CommitInfo.h>
+#include <GitAsyncProcess.h>
+#include <GitBase.h>
 #include <GitHistory.h>
 #include <GitCache.h>
 #include <GitQlientStyles.h>
 #include <DiffHelper.h>
 
 #include <QScrollBar>
+#include <QTextBlock>
 #include <QTextCharFormat>
 #include <QTextCodec>
 #include <QVBoxLayout>
 #include <QLineEdit>
 #include <QPushButton>
 
-FullDiffWidget::DiffHighlighter::DiffHighlighter(QTextDocument *document)
-   : QSyntaxHighlighter(document)
+namespace
 {
-}
+enum LineType : char
+{
+   LinePlain,
+   LineFileHeader,
+   LineHunkHeader,
+   LineAddition,
+   LineRemoval,
+   LineMeta
+};
 
-void FullDiffWidget::DiffHighlighter::highlightBlock(const QString &text)
+// Lines are classified once while the diff is parsed; the highlighter only looks the type up,
+// so highlighting a block costs an array access instead of re-running the prefix matching.
+char classifyLine(const QString &text)
 {
-   // state is used to count paragraphs, starting from 0
-   setCurrentBlockState(previousBlockState() + 1);
    if (text.isEmpty())
-      return;
+      return LinePlain;
 
-   QTextCharFormat myFormat;
-   const char firstChar = text.at(0).toLatin1();
-   switch (firstChar)
+   switch (text.at(0).toLatin1())
    {
       case '@':
-         myFormat.setForeground(GitQlientStyles::getOrange());
-         myFormat.setFontWeight(QFont::ExtraBold);
-         break;
+         return LineHunkHeader;
       case '+':
-         myFormat.setForeground(GitQlientStyles::getGreen());
-         break;
+         return LineAddition;
       case '-':
-         myFormat.setForeground(GitQlientStyles::getRed());
-         break;
+         return LineRemoval;
       case 'c':
       case 'd':
       case 'i':
@@ -47,19 +51,53 @@ void FullDiffWidget::DiffHighlighter::highlightBlock(const QString &text)
       case 'r':
       case 's':
          if (text.startsWith("diff --git a/"))
-         {
-            myFormat.setForeground(GitQlientStyles::getBlue());
-            myFormat.setFontWeight(QFont::ExtraBold);
-         }
-         else if (text.startsWith("copy ") || text.startsWith("index ") || text.startsWith("new ")
-                  || text.startsWith("old ") || text.startsWith("rename ") || text.startsWith("similarity "))
-            myFormat.setForeground(GitQlientStyles::getBlue());
+            return LineFileHeader;
+         if (text.startsWith("copy ") || text.startsWith("index ") || text.startsWith("new ")
+             || text.startsWith("old ") || text.startsWith("rename ") || text.startsWith("similarity "))
+            return LineMeta;
          break;
       default:
          break;
    }
-   if (myFormat.isValid())
-      setFormat(0, text.length(), myFormat);
+
+   return LinePlain;
+}
+
+const QTextCharFormat &formatFor(char type)
+{
+   static const QVector<QTextCharFormat> formats = []() {
+      QVector<QTextCharFormat> f(LineMeta + 1);
+      f[LineFileHeader].setForeground(GitQlientStyles::getBlue());
+      f[LineFileHeader].setFontWeight(QFont::ExtraBold);
+      f[LineHunkHeader].setForeground(GitQlientStyles::getOrange());
+      f[LineHunkHeader].setFontWeight(QFont::ExtraBold);
+      f[LineAddition].setForeground(GitQlientStyles::getGreen());
+      f[LineRemoval].setForeground(GitQlientStyles::getRed());
+      f[LineMeta].setForeground(GitQlientStyles::getBlue());
+      return f;
+   }();
+
+   return formats.at(type);
+}
+}
+
+FullDiffWidget::DiffHighlighter::DiffHighlighter(const QVector<char> &lineTypes, QTextDocument *document)
+   : QSyntaxHighlighter(document)
+   , mLineTypes(lineTypes)
+{
+}
+
+void FullDiffWidget::DiffHighlighter::highlightBlock(const QString &text)
+{
+   // state is used to count paragraphs, starting from 0
+   setCurrentBlockState(previousBlockState() + 1);
+
+   const auto line = currentBlock().blockNumber();
+
+   if (line < 0 || line >= mLineTypes.count() || mLineTypes.at(line) == LinePlain)
+      return;
+
+   setFormat(0, text.length(), formatFor(mLineTypes.at(line)));
 }
 
 FullDiffWidget::FullDiffWidget(const QSharedPointer<GitBase> &git, QSharedPointer<GitCache> cache, QWidget *parent)
@@ -70,7 +108,7 @@ FullDiffWidget::FullDiffWidget(const QSharedPointer<GitBase> &git, QSharedPointe
 {
    setAttribute(Qt::WA_DeleteOnClose);
 
-   diffHighlighter = new DiffHighlighter(mDiffWidget->document());
+   diffHighlighter = new DiffHighlighter(mLineTypes, mDiffWidget->document());
 
    QFont font;
    font.setFamily(QString::fromUtf8("DejaVu Sans Mono"));
@@ -114,19 +152,37 @@ bool FullDiffWidget::reload()
 {
    if (mCurrentSha != CommitInfo::ZERO_SHA)
    {
-      QScopedPointer<GitHistory> git(new GitHistory(mGit));
-      const auto ret = git->getCommitDiff(mCurrentSha, mPreviousSha);
-
-      if (ret.success && !ret.output.toString().isEmpty())
+      // A reload fired while the previous one still runs supersedes it: the old process is killed
+      // and its late result dropped, so the view always ends showing the newest request
+      if (mDiffProcess)
       {
-         loadDiff(mCurrentSha, mPreviousSha, ret.output.toString());
-         return true;
+         disconnect(mDiffProcess, nullptr, this, nullptr);
+         mDiffProcess->onCancel();
+         mDiffProcess = nullptr;
       }
+
+      mDiffProcess = new GitAsyncProcess(mGit->getWorkingDir());
+      connect(mDiffProcess, &GitAsyncProcess::signalDataReady, this, &FullDiffWidget::onDiffFinished);
+
+      mDiffProcess->run(GitHistory::getCommitDiffCmd(mCurrentSha, mPreviousSha));
+
+      return true;
    }
 
    return false;
 }
 
+void FullDiffWidget::onDiffFinished(const GitExecResult &result)
+{
+   if (sender() != mDiffProcess)
+      return;
+
+   mDiffProcess = nullptr;
+
+   if (const auto diff = result.outputText(); result.success && !diff.isEmpty())
+      processData(diff);
+}
+
 void FullDiffWidget::processData(const QString &fileChunk)
 {
    if (mPreviousDiffText != fileChunk)
@@ -136,11 +192,17 @@ void FullDiffWidget::processData(const QString &fileChunk)
       auto count = 0;
       const auto chunks = fileChunk.split("\n");
 
+      mFilePositions.clear();
+      mLineTypes.clear();
+      mLineTypes.reserve(chunks.count());
+
       for (const auto &chunk : chunks)
       {
          if (chunk.startsWith("diff --"))
             mFilePositions.append(count);
 
+         mLineTypes.append(classifyLine(chunk));
+
          ++count;
       }
 
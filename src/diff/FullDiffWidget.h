@@ -23,10 +23,12 @@
  ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
  ***************************************************************************************/
 
+#include <GitExecResult.h>
 #include <IDiffWidget.h>
 
 #include <QSyntaxHighlighter>
 
+class GitAsyncProcess;
 class QPlainTextEdit;
 class QPushButton;
 
@@ -51,7 +53,9 @@ public:
                            QWidget *parent = nullptr);
 
    /*!
-    \brief Reloads the current diff in case the user loaded the work in progress as base commit.
+    \brief Reloads the current diff in case the user loaded the work in progress as base commit. The diff is
+    computed asynchronously and a reload fired while a previous one still runs kills its process and drops its
+    late result.
 
    */
    bool reload() override;
@@ -71,15 +75,20 @@ private:
    QString mPreviousDiffText;
    QPlainTextEdit *mDiffWidget = nullptr;
    QVector<int> mFilePositions;
+   GitAsyncProcess *mDiffProcess = nullptr;
 
    class DiffHighlighter : public QSyntaxHighlighter
    {
    public:
-      DiffHighlighter(QTextDocument *document);
+      DiffHighlighter(const QVector<char> &lineTypes, QTextDocument *document);
       void highlightBlock(const QString &text) override;
+
+   private:
+      const QVector<char> &mLineTypes;
    };
 
    DiffHighlighter *diffHighlighter = nullptr;
+   QVector<char> mLineTypes;
 
    /*!
     \brief Method that processes the data from the Git diff command.
@@ -87,6 +96,12 @@ private:
     \param fileChunk The file chuck to compare.
    */
    void processData(const QString &fileChunk);
+   /**
+    * @brief onDiffFinished Applies the diff computed asynchronously by reload. Results of superseded requests
+    * are dropped.
+    * @param result The result of the git diff command.
+    */
+   void onDiffFinished(const GitExecResult &result);
    /**
     * @brief moveChunkUp Moves to the previous diff chunk.
     */
@@ -0,0 +1,104 @@
+#include "IntraLineDiff.h"
+
+#include <TaskPool.h>
+
+#include <QtConcurrent>
+
+namespace
+{
+// Maximum number of refined lines per diff so a huge generated change cannot keep the pool busy.
+constexpr auto MaxRefinedLines = 5000;
+
+QVector<QPair<int, int>> changedSpan(const QString &reference, const QString &line)
+{
+   const auto minLength = qMin(reference.length(), line.length());
+   auto prefix = 0;
+
+   while (prefix < minLength && reference.at(prefix) == line.at(prefix))
+      ++prefix;
+
+   // Snap the prefix back to a word boundary so whole tokens get highlighted
+   while (prefix > 0 && prefix < line.length() && line.at(prefix - 1).isLetterOrNumber()
+          && line.at(prefix).isLetterOrNumber())
+      --prefix;
+
+   auto suffix = 0;
+
+   while (suffix < minLength - prefix
+          && reference.at(reference.length() - 1 - suffix) == line.at(line.length() - 1 - suffix))
+      ++suffix;
+
+   while (suffix > 0 && line.length() - suffix - 1 >= prefix && line.at(line.length() - suffix).isLetterOrNumber()
+          && line.at(line.length() - suffix - 1).isLetterOrNumber())
+      --suffix;
+
+   const auto length = line.length() - prefix - suffix;
+
+   if (length <= 0)
+      return QVector<QPair<int, int>>();
+
+   return { qMakePair(prefix, length) };
+}
+}
+
+IntraLineDiff::IntraLineDiff(QObject *parent)
+   : QObject(parent)
+{
+   qRegisterMetaType<QVector<QPair<int, int>>>("QVector<QPair<int,int>>");
+}
+
+IntraLineDiff::~IntraLineDiff()
+{
+   mGeneration.ref();
+   mFuture.waitForFinished();
+}
+
+void IntraLineDiff::refine(const QVector<ChunkDiffInfo> &chunks, const QStringList &oldLines,
+                           const QStringList &newLines)
+{
+   const auto generation = mGeneration.fetchAndAddRelaxed(1) + 1;
+
+   // A refinement still in flight is superseded by the generation bump and drained before the
+   // future is reassigned, so the destructor never misses a running task that captured this
+   mFuture.waitForFinished();
+
+   mFuture = QtConcurrent::run(TaskPool::instance()->pool(), [this, generation, chunks, oldLines, newLines]() {
+      auto refinedLines = 0;
+
+      for (const auto &chunk : chunks)
+      {
+         if (generation != mGeneration.loadRelaxed() || refinedLines >= MaxRefinedLines)
+            return;
+
+         if (!chunk.oldFile.isValid() || !chunk.newFile.isValid())
+            continue;
+
+         const auto oldCount = chunk.oldFile.endLine - chunk.oldFile.startLine + 1;
+         const auto newCount = chunk.newFile.endLine - chunk.newFile.startLine + 1;
+         const auto pairedLines = qMin(oldCount, newCount);
+
+         for (auto i = 0; i < pairedLines; ++i)
+         {
+            if (generation != mGeneration.loadRelaxed())
+               return;
+
+            const auto oldLineNumber = chunk.oldFile.startLine + i;
+            const auto newLineNumber = chunk.newFile.startLine + i;
+
+            if (oldLineNumber > oldLines.count() || newLineNumber > newLines.count())
+               break;
+
+            const auto &oldLine = oldLines.at(oldLineNumber - 1);
+            const auto &newLine = newLines.at(newLineNumber - 1);
+
+            if (const auto spans = changedSpan(newLine, oldLine); !spans.isEmpty())
+               emit spanReady(oldLineNumber, false, spans);
+
+            if (const auto spans = changedSpan(oldLine, newLine); !spans.isEmpty())
+               emit spanReady(newLineNumber, true, spans);
+
+            ++refinedLines;
+         }
+      }
+   });
+}
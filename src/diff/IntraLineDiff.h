@@ -0,0 +1,76 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+#include <DiffInfo.h>
+
+#include <QAtomicInt>
+#include <QFuture>
+#include <QObject>
+
+/**
+ * @brief The IntraLineDiff class refines the line-level chunks of a diff with word-level change spans. The
+ * comparison runs in the global thread pool and the spans are streamed back to the GUI thread one line at a time,
+ * so enabling intra-line highlighting adds no latency to the diff display.
+ *
+ * @class IntraLineDiff IntraLineDiff.h "IntraLineDiff.h"
+ */
+class IntraLineDiff : public QObject
+{
+   Q_OBJECT
+
+signals:
+   /**
+    * @brief spanReady Signal triggered when the changed spans of a line have been computed.
+    * @param line The line number the spans belong to.
+    * @param inNewFile True when the line belongs to the new file side of the diff.
+    * @param spans The changed spans as pairs of start position and length.
+    */
+   void spanReady(int line, bool inNewFile, QVector<QPair<int, int>> spans);
+
+public:
+   /**
+    * @brief Default constructor.
+    * @param parent The parent object if needed.
+    */
+   explicit IntraLineDiff(QObject *parent = nullptr);
+
+   /**
+    * @brief Destructor. Cancels the running refinement and waits for it to finish.
+    */
+   ~IntraLineDiff();
+
+   /**
+    * @brief refine Starts the refinement of @p chunks in the thread pool, pairing the lines of the old and the new
+    * file inside every chunk. Any previous refinement still running is cancelled.
+    * @param chunks The chunks of the diff.
+    * @param oldLines The lines of the old file.
+    * @param newLines The lines of the new file.
+    */
+   void refine(const QVector<ChunkDiffInfo> &chunks, const QStringList &oldLines, const QStringList &newLines);
+
+private:
+   QAtomicInt mGeneration;
+   QFuture<void> mFuture;
+};
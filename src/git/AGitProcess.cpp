@@ -1,8 +1,13 @@
 #include "AGitProcess.h"
 
+#include <QElapsedTimer>
+#include <QMutex>
 #include <QTemporaryFile>
 #include <QTextStream>
+#include <QThread>
+#include <QWaitCondition>
 #include <GitQlientSettings.h>
+#include <PerfProfiler.h>
 
 #include <QLogger.h>
 
@@ -99,6 +104,102 @@ QStringList splitArgList(const QString &cmd)
    }
    return sl;
 }
+
+// Building the environment block and reading the settings file on every spawn dominates the cost
+// of short git commands, so both are resolved once and shared by all processes.
+const QStringList &gitEnvironment()
+{
+   static const QStringList env = []() {
+      QStringList e = QProcess::systemEnvironment();
+      e << "GIT_TRACE=0"; // avoid choking on debug traces
+      e << "GIT_FLUSH=0"; // skip the fflush() in 'git log'
+
+      return e;
+   }();
+
+   return env;
+}
+
+const QString &gitProgram()
+{
+   static const QString gitAlternative = GitQlientSettings().globalValue("gitLocation", "").toString();
+
+   return gitAlternative;
+}
+
+// A queued command stops yielding to higher classes after this window, so refresh and background
+// commands are delayed but never starved
+constexpr auto kStarvationWindowMs = 3000;
+
+int maxConcurrentCommands()
+{
+   static const auto maxCommands = qMax(2, QThread::idealThreadCount() / 2);
+
+   return maxCommands;
+}
+
+// The scheduler bounds how many git child processes compete for the disk at the same time.
+// Interactive commands never queue since the user is actively waiting for them; refresh ones wait
+// for a free slot and background analytics additionally yield to queued refreshes.
+class GitCommandScheduler
+{
+public:
+   static GitCommandScheduler &instance()
+   {
+      static GitCommandScheduler scheduler;
+
+      return scheduler;
+   }
+
+   void acquire(GitExecPriority priority)
+   {
+      QMutexLocker guard(&mMutex);
+
+      if (priority == GitExecPriority::Interactive)
+      {
+         ++mRunning;
+         return;
+      }
+
+      QElapsedTimer waited;
+      waited.start();
+
+      const auto classIndex = static_cast<int>(priority);
+      ++mWaiting[classIndex];
+
+      while ((mRunning >= maxConcurrentCommands() || hasHigherClassWaiting(classIndex))
+             && waited.elapsed() < kStarvationWindowMs)
+         mSlotReleased.wait(&mMutex, 100);
+
+      --mWaiting[classIndex];
+      ++mRunning;
+   }
+
+   void release()
+   {
+      QMutexLocker guard(&mMutex);
+
+      --mRunning;
+      mSlotReleased.wakeAll();
+   }
+
+private:
+   QMutex mMutex;
+   QWaitCondition mSlotReleased;
+   int mRunning = 0;
+   int mWaiting[3] = { 0, 0, 0 };
+
+   bool hasHigherClassWaiting(int classIndex) const
+   {
+      for (auto i = 0; i < classIndex; ++i)
+      {
+         if (mWaiting[i] > 0)
+            return true;
+      }
+
+      return false;
+   }
+};
 }
 
 AGitProcess::AGitProcess(const QString &workingDir)
@@ -110,6 +211,26 @@ AGitProcess::AGitProcess(const QString &workingDir)
            Qt::DirectConnection);
    connect(this, static_cast<void (AGitProcess::*)(int, QProcess::ExitStatus)>(&AGitProcess::finished), this,
            &AGitProcess::onFinished, Qt::DirectConnection);
+   // The slot is released in a dedicated connection since subclasses override onFinished without
+   // always calling the base implementation
+   connect(this, static_cast<void (AGitProcess::*)(int, QProcess::ExitStatus)>(&AGitProcess::finished), this,
+           &AGitProcess::releaseCommandSlot, Qt::DirectConnection);
+}
+
+AGitProcess::~AGitProcess()
+{
+   // Covers processes destroyed while their command still runs, where finished is never emitted
+   releaseCommandSlot();
+}
+
+void AGitProcess::setPriority(GitExecPriority priority)
+{
+   mPriority = priority;
+}
+
+void AGitProcess::setInputData(const QByteArray &input)
+{
+   mInputData = input;
 }
 
 void AGitProcess::onCancel()
@@ -117,6 +238,11 @@ void AGitProcess::onCancel()
 
    mCanceling = true;
 
+   // The child is killed right away: a superseded query must not keep consuming CPU while the
+   // newest one competes for the disk
+   if (state() != QProcess::NotRunning)
+      kill();
+
    waitForFinished();
 }
 
@@ -126,7 +252,9 @@ void AGitProcess::onReadyStandardOutput()
    {
       const auto standardOutput = readAllStandardOutput();
 
-      mRunOutput.append(QString::fromUtf8(standardOutput));
+      // The output is accumulated as raw bytes; the conversion to UTF-16 happens lazily in the
+      // consumers that really need text, so huge log/diff outputs don't pay it twice
+      mRunOutput.append(standardOutput);
 
       emit procDataReady(standardOutput);
    }
@@ -134,6 +262,10 @@ void AGitProcess::onReadyStandardOutput()
 
 bool AGitProcess::execute(const QString &command)
 {
+   // The scope covers the slot wait and the actual spawn, so a profile shows whether slow
+   // commands spend their time queued, forking or working.
+   PerfScopedTimer timer("AGitProcess::execute", "git");
+
    mCommand = command;
 
    auto processStarted = false;
@@ -141,13 +273,12 @@ bool AGitProcess::execute(const QString &command)
 
    if (!arguments.isEmpty())
    {
-      QStringList env = QProcess::systemEnvironment();
-      env << "GIT_TRACE=0"; // avoid choking on debug traces
-      env << "GIT_FLUSH=0"; // skip the fflush() in 'git log'
+      const auto &gitAlternative = gitProgram();
 
-      const auto gitAlternative = GitQlientSettings().globalValue("gitLocation", "").toString();
+      GitCommandScheduler::instance().acquire(mPriority);
+      mSlotAcquired = true;
 
-      setEnvironment(env);
+      setEnvironment(gitEnvironment());
       setProgram(gitAlternative.isEmpty() ? arguments.takeFirst() : gitAlternative);
       setArguments(arguments);
       start();
@@ -155,9 +286,21 @@ bool AGitProcess::execute(const QString &command)
       processStarted = waitForStarted();
 
       if (!processStarted)
+      {
+         releaseCommandSlot();
+
          QLog_Warning("Git", QString("Unable to start the process:\n%1\nMore info:\n%2").arg(mCommand, errorString()));
+      }
       else
+      {
          QLog_Debug("Git", QString("Process started: %1").arg(mCommand));
+
+         if (!mInputData.isEmpty())
+         {
+            write(mInputData);
+            closeWriteChannel();
+         }
+      }
    }
 
    return processStarted;
@@ -177,9 +320,19 @@ void AGitProcess::onFinished(int exitCode, QProcess::ExitStatus exitStatus)
 
    if (mRealError)
    {
-      if (!mErrorOutput.isEmpty())
-         mRunOutput = mErrorOutput;
+      if (!errorOutput.isEmpty())
+         mRunOutput = errorOutput;
    }
    else
-      mRunOutput.append(readAllStandardOutput() + mErrorOutput);
+      mRunOutput.append(readAllStandardOutput() + errorOutput);
+}
+
+void AGitProcess::releaseCommandSlot()
+{
+   if (mSlotAcquired)
+   {
+      mSlotAcquired = false;
+
+      GitCommandScheduler::instance().release();
+   }
 }
@@ -36,20 +36,39 @@ signals:
 
 public:
    explicit AGitProcess(const QString &workingDir);
+   ~AGitProcess() override;
 
    virtual GitExecResult run(const QString &command) = 0;
    void onCancel();
+   /**
+    * @brief setPriority Sets the priority class the command scheduler uses for this invocation. Commands are
+    * interactive by default; refresh and background ones queue when too many commands compete for the disk.
+    * @param priority The priority class.
+    */
+   void setPriority(GitExecPriority priority);
+   /**
+    * @brief setInputData Sets the bytes written to the standard input of the child once it starts.
+    * Commands taking --pathspec-from-file=- receive their path list this way, so one spawn covers
+    * any number of files without hitting the command line length limit.
+    * @param input The bytes to feed through the standard input.
+    */
+   void setInputData(const QByteArray &input);
 
 protected:
-   QString mRunOutput;
+   QByteArray mRunOutput;
    QString mWorkingDirectory;
    QString mErrorOutput;
    QString mCommand;
+   GitExecPriority mPriority = GitExecPriority::Interactive;
    bool mRealError = false;
    bool mCanceling = false;
    bool execute(const QString &command);
    virtual void onFinished(int exitCode, QProcess::ExitStatus exitStatus);
 
 private:
+   QByteArray mInputData;
+   bool mSlotAcquired = false;
+
    void onReadyStandardOutput();
+   void releaseCommandSlot();
 };
@@ -0,0 +1,144 @@
+#include "CommitGraphReader.h"
+
+#include <QLogger.h>
+
+#include <cstring>
+
+using namespace QLogger;
+
+namespace
+{
+constexpr auto RawShaLength = 20;
+constexpr auto HeaderSize = 8;
+constexpr auto ChunkTableEntrySize = 12;
+constexpr auto FanoutSize = 256 * 4;
+// Tree OID plus two parent positions plus the generation/commit-time words
+constexpr auto CommitDataEntrySize = RawShaLength + 16;
+
+quint32 be32(const uchar *data)
+{
+   return (quint32(data[0]) << 24) | (quint32(data[1]) << 16) | (quint32(data[2]) << 8) | quint32(data[3]);
+}
+
+quint64 be64(const uchar *data)
+{
+   return (quint64(be32(data)) << 32) | be32(data + 4);
+}
+}
+
+CommitGraphReader::CommitGraphReader(const QString &gitDirPath)
+   : mFile(QString("%1/objects/info/commit-graph").arg(gitDirPath))
+{
+   if (!mFile.open(QIODevice::ReadOnly))
+      return;
+
+   const auto size = mFile.size();
+   const auto data = size > HeaderSize ? mFile.map(0, size) : nullptr;
+
+   if (!data)
+      return;
+
+   if (std::memcmp(data, "CGPH", 4) != 0 || data[4] != 1 /* format version */ || data[5] != 1 /* SHA-1 */)
+   {
+      QLog_Debug("Git", "The commit-graph file uses an unsupported version or hash.");
+
+      return;
+   }
+
+   const auto chunkCount = data[6];
+
+   // Incremental graph chains (split commit-graphs) keep part of the data in sibling files; only
+   // the single-file layout is mapped here.
+   if (data[7] != 0)
+   {
+      QLog_Debug("Git", "The commit-graph file is part of a chain, which is not supported.");
+
+      return;
+   }
+
+   if (size < HeaderSize + (chunkCount + 1) * ChunkTableEntrySize)
+      return;
+
+   const uchar *fanout = nullptr;
+   const uchar *lookup = nullptr;
+   const uchar *commitData = nullptr;
+   quint64 lookupSpan = 0;
+   quint64 commitDataSpan = 0;
+
+   for (auto i = 0; i < chunkCount; ++i)
+   {
+      const auto entry = data + HeaderSize + i * ChunkTableEntrySize;
+      const auto id = be32(entry);
+      const auto offset = be64(entry + 4);
+      const auto end = be64(entry + ChunkTableEntrySize + 4);
+
+      if (offset > end || end > static_cast<quint64>(size))
+         return;
+
+      if (id == 0x4F494446 /* OIDF */ && end - offset >= FanoutSize)
+         fanout = data + offset;
+      else if (id == 0x4F49444C /* OIDL */)
+      {
+         lookup = data + offset;
+         lookupSpan = end - offset;
+      }
+      else if (id == 0x43444154 /* CDAT */)
+      {
+         commitData = data + offset;
+         commitDataSpan = end - offset;
+      }
+   }
+
+   if (!fanout || !lookup || !commitData)
+      return;
+
+   const auto count = be32(fanout + 255 * 4);
+
+   if (lookupSpan < quint64(count) * RawShaLength || commitDataSpan < quint64(count) * CommitDataEntrySize)
+      return;
+
+   mOidFanout = fanout;
+   mOidLookup = lookup;
+   mCommitData = commitData;
+   mCommitCount = static_cast<int>(count);
+
+   QLog_Debug("Git", QString("Commit-graph file mapped with {%1} commits.").arg(mCommitCount));
+}
+
+int CommitGraphReader::indexOf(const QByteArray &rawSha) const
+{
+   if (!isValid() || rawSha.size() != RawShaLength)
+      return -1;
+
+   const auto firstByte = static_cast<uchar>(rawSha.at(0));
+   auto low = firstByte > 0 ? static_cast<int>(be32(mOidFanout + (firstByte - 1) * 4)) : 0;
+   auto high = static_cast<int>(be32(mOidFanout + firstByte * 4));
+
+   while (low < high)
+   {
+      const auto mid = low + (high - low) / 2;
+      const auto cmp = std::memcmp(rawSha.constData(), mOidLookup + mid * RawShaLength, RawShaLength);
+
+      if (cmp == 0)
+         return mid;
+
+      if (cmp < 0)
+         high = mid;
+      else
+         low = mid + 1;
+   }
+
+   return -1;
+}
+
+quint32 CommitGraphReader::generation(const QByteArray &rawSha) const
+{
+   const auto pos = indexOf(rawSha);
+
+   if (pos == -1)
+      return 0;
+
+   // The topological level lives in the upper 30 bits of the first generation word; the lower 2
+   // bits extend the commit time, which is not needed here.
+   return be32(mCommitData + pos * CommitDataEntrySize + RawShaLength + 8) >> 2;
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+#include <QByteArray>
+#include <QFile>
+#include <QString>
+
+/*!
+ \brief Memory-maps git's own commit-graph file (.git/objects/info/commit-graph), written by
+ git commit-graph write or git maintenance. The file stores the full topology plus commit dates
+ and topological levels, so the commit count and ancestry facts are available without running a
+ git subprocess. When the file is absent or uses an unsupported layout the reader reports itself
+ invalid and callers fall back to the regular git log path.
+*/
+class CommitGraphReader
+{
+public:
+   /*!
+    \brief Maps and validates the commit-graph file of the given .git directory.
+    \param gitDirPath The path to the .git directory.
+   */
+   explicit CommitGraphReader(const QString &gitDirPath);
+
+   /*!
+    \brief Whether a supported commit-graph file was mapped.
+   */
+   bool isValid() const { return mCommitCount > 0; }
+   /*!
+    \brief The number of commits indexed by the graph.
+   */
+   int commitCount() const { return mCommitCount; }
+   /*!
+    \brief Looks up the position of a commit in the graph.
+    \param rawSha The 20-byte raw SHA of the commit.
+    \return The graph position or -1 when the commit is not indexed.
+   */
+   int indexOf(const QByteArray &rawSha) const;
+   /*!
+    \brief The topological level of a commit: always strictly greater than the level of every one
+    of its ancestors, which makes it a cheap negative oracle for reachability.
+    \param rawSha The 20-byte raw SHA of the commit.
+    \return The topological level, or 0 when the commit is not indexed.
+   */
+   quint32 generation(const QByteArray &rawSha) const;
+
+private:
+   QFile mFile;
+   const uchar *mOidFanout = nullptr;
+   const uchar *mOidLookup = nullptr;
+   const uchar *mCommitData = nullptr;
+   int mCommitCount = 0;
+};
@@ -1,7 +1,15 @@
 INCLUDEPATH += $$PWD
 
+# Optional in-process backend for the read-only metadata queries. Enable it with:
+#   qmake USE_LIBGIT2=1
+!isEmpty(USE_LIBGIT2) {
+   DEFINES += USE_LIBGIT2
+   LIBS += -lgit2
+}
+
 HEADERS += \
     $$PWD/AGitProcess.h \
+    $$PWD/CommitGraphReader.h \
     $$PWD/GitAsyncProcess.h \
     $$PWD/GitBase.h \
     $$PWD/GitBranches.h \
@@ -9,9 +17,14 @@ HEADERS += \
     $$PWD/GitConfig.h \
     $$PWD/GitExecResult.h \
     $$PWD/GitHistory.h \
+    $$PWD/GitLibGit2.h \
     $$PWD/GitLocal.h \
+    $$PWD/GitMaintenanceScheduler.h \
     $$PWD/GitMerge.h \
+    $$PWD/GitMergeAnalyzer.h \
+    $$PWD/GitOperationRunner.h \
     $$PWD/GitPatches.h \
+    $$PWD/GitRefsReader.h \
     $$PWD/GitRemote.h \
     $$PWD/GitRepoLoader.h \
     $$PWD/GitRequestorProcess.h \
@@ -20,10 +33,13 @@ HEADERS += \
     $$PWD/GitSubtree.h \
     $$PWD/GitSyncProcess.h \
     $$PWD/GitTags.h \
-    $$PWD/GitWip.h
+    $$PWD/GitTree.h \
+    $$PWD/GitWip.h \
+    $$PWD/GitWorktrees.h
 
 SOURCES += \
     $$PWD/AGitProcess.cpp \
+    $$PWD/CommitGraphReader.cpp \
     $$PWD/GitAsyncProcess.cpp \
     $$PWD/GitBase.cpp \
     $$PWD/GitBranches.cpp \
@@ -31,9 +47,14 @@ SOURCES += \
     $$PWD/GitConfig.cpp \
     $$PWD/GitExecResult.cpp \
     $$PWD/GitHistory.cpp \
+    $$PWD/GitLibGit2.cpp \
     $$PWD/GitLocal.cpp \
+    $$PWD/GitMaintenanceScheduler.cpp \
     $$PWD/GitMerge.cpp \
+    $$PWD/GitMergeAnalyzer.cpp \
+    $$PWD/GitOperationRunner.cpp \
     $$PWD/GitPatches.cpp \
+    $$PWD/GitRefsReader.cpp \
     $$PWD/GitRemote.cpp \
     $$PWD/GitRepoLoader.cpp \
     $$PWD/GitRequestorProcess.cpp \
@@ -42,4 +63,6 @@ SOURCES += \
     $$PWD/GitSubtree.cpp \
     $$PWD/GitSyncProcess.cpp \
     $$PWD/GitTags.cpp \
-    $$PWD/GitWip.cpp
+    $$PWD/GitTree.cpp \
+    $$PWD/GitWip.cpp \
+    $$PWD/GitWorktrees.cpp
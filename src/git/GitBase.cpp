@@ -1,6 +1,7 @@
 #include "GitBase.h"
 
 #include <GitAsyncProcess.h>
+#include <GitLibGit2.h>
 #include <GitSyncProcess.h>
 
 #include <QLogger.h>
@@ -44,17 +45,38 @@ QString GitBase::getGitDir() const
    return mGitDirectory;
 }
 
-GitExecResult GitBase::run(const QString &cmd) const
+GitExecResult GitBase::run(const QString &cmd, GitExecPriority priority) const
 {
+   // The hot metadata queries are answered in-process when the libgit2 backend is compiled in,
+   // skipping the process-spawn cost entirely
+   if (GitExecResult backendResult; GitLibGit2::tryRun(mWorkingDirectory, cmd, backendResult))
+      return backendResult;
+
    GitSyncProcess p(mWorkingDirectory);
+   p.setPriority(priority);
 
    const auto ret = p.run(cmd);
-   const auto runOutput = ret.output.toString();
 
-   if (ret.success && runOutput.contains("fatal:"))
-      QLog_Info("Git", QString("Git command {%1} reported issues:\n%2").arg(cmd, runOutput));
+   // The check is done over the raw bytes so successful commands with big outputs don't pay a
+   // UTF-16 conversion just for logging purposes
+   if (ret.success && ret.outputBytes().contains("fatal:"))
+      QLog_Info("Git", QString("Git command {%1} reported issues:\n%2").arg(cmd, ret.outputText()));
    else if (!ret.success)
-      QLog_Warning("Git", QString("Git command {%1} has errors:\n%2").arg(cmd, runOutput));
+      QLog_Warning("Git", QString("Git command {%1} has errors:\n%2").arg(cmd, ret.outputText()));
+
+   return ret;
+}
+
+GitExecResult GitBase::runWithInput(const QString &cmd, const QByteArray &inputData, GitExecPriority priority) const
+{
+   GitSyncProcess p(mWorkingDirectory);
+   p.setPriority(priority);
+   p.setInputData(inputData);
+
+   const auto ret = p.run(cmd);
+
+   if (!ret.success)
+      QLog_Warning("Git", QString("Git command {%1} has errors:\n%2").arg(cmd, ret.outputText()));
 
    return ret;
 }
@@ -92,3 +114,29 @@ GitExecResult GitBase::getLastCommit() const
 
    return ret;
 }
+
+QString GitBase::getCommitBody(const QString &sha)
+{
+   {
+      QMutexLocker lock(&mCommitBodiesMutex);
+
+      if (const auto iter = mCommitBodies.constFind(sha); iter != mCommitBodies.cend())
+         return *iter;
+   }
+
+   QLog_Trace("Git", QString("Getting the body of the commit {%1}").arg(sha));
+
+   const auto ret = run(QString("git show --quiet --pretty=format:%b " + sha));
+   const auto body = ret.success ? ret.output.toString().trimmed() : QString();
+
+   QMutexLocker lock(&mCommitBodiesMutex);
+
+   // The bodies are kept for the commits the user visited; a full clear keeps the cache bounded
+   // without tracking usage order
+   if (mCommitBodies.count() > 250)
+      mCommitBodies.clear();
+
+   mCommitBodies.insert(sha, body);
+
+   return body;
+}
@@ -25,12 +25,27 @@
 
 #include <GitExecResult.h>
 
+#include <QHash>
+#include <QMutex>
+
 class GitBase final
 {
 public:
    explicit GitBase(const QString &workingDirectory);
 
-   GitExecResult run(const QString &cmd) const;
+   GitExecResult run(const QString &cmd, GitExecPriority priority = GitExecPriority::Interactive) const;
+
+   /**
+    * @brief runWithInput Runs a git command feeding the given bytes through its standard input.
+    * Used by the batch file operations, where the path list travels NUL-separated over stdin
+    * instead of the command line.
+    * @param cmd The command to execute.
+    * @param inputData The bytes written to the standard input of the child.
+    * @param priority The priority class for the command scheduler.
+    * @return GitExecResult The result of the execution.
+    */
+   GitExecResult runWithInput(const QString &cmd, const QByteArray &inputData,
+                              GitExecPriority priority = GitExecPriority::Interactive) const;
 
    QString getWorkingDir() const;
 
@@ -44,8 +59,14 @@ public:
 
    GitExecResult getLastCommit() const;
 
+   QString getCommitBody(const QString &sha);
+
 protected:
    QString mWorkingDirectory;
    QString mGitDirectory;
    QString mCurrentBranch;
+   QHash<QString, QString> mCommitBodies;
+   /* Guards mCommitBodies: the selection pipeline fetches bodies from a worker while the GUI
+    * thread may be reading others. */
+   QMutex mCommitBodiesMutex;
 };
@@ -146,6 +146,19 @@ GitExecResult GitBranches::removeLocalBranch(const QString &branchName)
    return ret;
 }
 
+GitExecResult GitBranches::removeLocalBranches(const QStringList &branchNames)
+{
+   QLog_Debug("Git", QString("Removing local branches: {%1}").arg(branchNames.join(", ")));
+
+   const auto cmd = QString("git branch -D %1").arg(branchNames.join(' '));
+
+   QLog_Trace("Git", QString("Removing local branches: {%1}").arg(cmd));
+
+   const auto ret = mGitBase->run(cmd);
+
+   return ret;
+}
+
 GitExecResult GitBranches::removeRemoteBranch(const QString &branchName)
 {
    auto branch = branchName;
@@ -195,3 +208,54 @@ GitExecResult GitBranches::pushUpstream(const QString &branchName)
 
    return ret;
 }
+
+QMap<QString, QPair<int, int>> GitBranches::getTrackingDistances()
+{
+   QLog_Debug("Git", QString("Getting the tracking distances for all the local branches."));
+
+   const auto cmd = QString("git for-each-ref refs/heads --format=\"%(refname:short);%(upstream:track)\"");
+
+   QLog_Trace("Git", QString("Getting the tracking distances: {%1}").arg(cmd));
+
+   QMap<QString, QPair<int, int>> distances;
+   // The sweep runs over every local branch, so it must never delay an interactive command
+   const auto ret = mGitBase->run(cmd, GitExecPriority::Background);
+
+   if (ret.success)
+   {
+#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
+      const auto lines = ret.output.toString().split('\n', Qt::SkipEmptyParts);
+#else
+      const auto lines = ret.output.toString().split('\n', QString::SkipEmptyParts);
+#endif
+
+      for (const auto &line : lines)
+      {
+         const auto separator = line.indexOf(';');
+
+         if (separator == -1)
+            continue;
+
+         const auto branch = line.left(separator);
+         const auto track = line.mid(separator + 1);
+
+         const auto countAfter = [&track](const QString &tag) {
+            const auto pos = track.indexOf(tag);
+
+            if (pos == -1)
+               return 0;
+
+            auto count = 0;
+
+            for (auto i = pos + tag.count(); i < track.count() && track.at(i).isDigit(); ++i)
+               count = count * 10 + track.at(i).digitValue();
+
+            return count;
+         };
+
+         distances.insert(branch, qMakePair(countAfter("ahead "), countAfter("behind ")));
+      }
+   }
+
+   return distances;
+}
@@ -25,6 +25,8 @@
 
 #include <GitExecResult.h>
 
+#include <QMap>
+#include <QPair>
 #include <QSharedPointer>
 
 class GitBase;
@@ -41,9 +43,11 @@ public:
    GitExecResult checkoutNewLocalBranch(const QString &branchName);
    GitExecResult renameBranch(const QString &oldName, const QString &newName);
    GitExecResult removeLocalBranch(const QString &branchName);
+   GitExecResult removeLocalBranches(const QStringList &branchNames);
    GitExecResult removeRemoteBranch(const QString &branchName);
    GitExecResult getLastCommitOfBranch(const QString &branch);
    GitExecResult pushUpstream(const QString &branchName);
+   QMap<QString, QPair<int, int>> getTrackingDistances();
 
 private:
    QSharedPointer<GitBase> mGitBase;
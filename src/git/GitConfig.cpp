@@ -5,8 +5,50 @@
 
 #include <QLogger.h>
 
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+
 using namespace QLogger;
 
+namespace
+{
+/**
+ * The full configuration of a repository, loaded with a single git config --list run and shared
+ * by every GitConfig instance of the same repository. The snapshot is revalidated through the
+ * modification times of the local and global config files, so consecutive reads during a refresh
+ * cycle are hash lookups instead of one subprocess per key.
+ */
+struct ConfigSnapshot
+{
+   QHash<QString, QString> values;
+   QDateTime localModified;
+   QDateTime globalModified;
+   bool loaded = false;
+};
+
+QHash<QString, ConfigSnapshot> configSnapshots;
+QMutex configSnapshotsMutex;
+
+QDateTime globalConfigModified()
+{
+   const auto home = QFileInfo(QDir::homePath() + QStringLiteral("/.gitconfig")).lastModified();
+   const auto xdg = QFileInfo(QDir::homePath() + QStringLiteral("/.config/git/config")).lastModified();
+
+   return home > xdg ? home : xdg;
+}
+
+void invalidateConfigSnapshot(const QString &gitDir)
+{
+   QMutexLocker lock(&configSnapshotsMutex);
+
+   configSnapshots.remove(gitDir);
+}
+}
+
 bool GitUserInfo::isValid() const
 {
    return !mUserEmail.isNull() && !mUserEmail.isEmpty() && !mUserName.isNull() && !mUserName.isEmpty();
@@ -43,6 +85,8 @@ void GitConfig::setGlobalUserInfo(const GitUserInfo &info)
 
    mGitBase->run(QString("git config --global user.name \"%1\"").arg(info.mUserName));
    mGitBase->run(QString("git config --global user.email %1").arg(info.mUserEmail));
+
+   invalidateConfigSnapshot(mGitBase->getGitDir());
 }
 
 GitExecResult GitConfig::setGlobalData(const QString &key, const QString &value)
@@ -51,6 +95,8 @@ GitExecResult GitConfig::setGlobalData(const QString &key, const QString &value)
 
    const auto ret = mGitBase->run(QString("git config --global %1 \"%2\"").arg(key, value));
 
+   invalidateConfigSnapshot(mGitBase->getGitDir());
+
    return ret;
 }
 
@@ -79,6 +125,8 @@ void GitConfig::setLocalUserInfo(const GitUserInfo &info)
 
    mGitBase->run(QString("git config --local user.name \"%1\"").arg(info.mUserName));
    mGitBase->run(QString("git config --local user.email %1").arg(info.mUserEmail));
+
+   invalidateConfigSnapshot(mGitBase->getGitDir());
 }
 
 GitExecResult GitConfig::setLocalData(const QString &key, const QString &value)
@@ -87,10 +135,12 @@ GitExecResult GitConfig::setLocalData(const QString &key, const QString &value)
 
    const auto ret = mGitBase->run(QString("git config --local %1 \"%2\"").arg(key, value));
 
+   invalidateConfigSnapshot(mGitBase->getGitDir());
+
    return ret;
 }
 
-GitExecResult GitConfig::clone(const QString &url, const QString &fullPath)
+GitExecResult GitConfig::clone(const QString &url, const QString &fullPath, bool partial, int depth, bool singleBranch)
 {
    QLog_Debug("Git", QString("Starting the clone process for repo {%1} at {%2}.").arg(url, fullPath));
 
@@ -101,7 +151,18 @@ GitExecResult GitConfig::clone(const QString &url, const QString &fullPath)
 
    mGitBase->setWorkingDir(fullPath);
 
-   return asyncRun->run(QString("git clone --progress %1 %2").arg(url, fullPath));
+   auto options = QString("--progress");
+
+   if (partial)
+      options.append(" --filter=blob:none");
+
+   if (depth > 0)
+      options.append(QString(" --depth %1").arg(depth));
+
+   if (singleBranch)
+      options.append(" --single-branch");
+
+   return asyncRun->run(QString("git clone %1 %2 %3").arg(options, url, fullPath));
 }
 
 GitExecResult GitConfig::initRepo(const QString &fullPath)
@@ -168,11 +229,53 @@ GitExecResult GitConfig::getRemoteForBranch(const QString &branch)
 
 GitExecResult GitConfig::getGitValue(const QString &key) const
 {
-   QLog_Debug("Git", QString("Getting value for config key {%1}").arg(key));
+   QMutexLocker lock(&configSnapshotsMutex);
 
-   const auto ret = mGitBase->run(QString("git config --get %1").arg(key));
+   auto &snapshot = configSnapshots[mGitBase->getGitDir()];
+   const auto localModified = QFileInfo(QString("%1/config").arg(mGitBase->getGitDir())).lastModified();
+   const auto globalModified = globalConfigModified();
 
-   return ret;
+   if (!snapshot.loaded || snapshot.localModified != localModified || snapshot.globalModified != globalModified)
+   {
+      QLog_Debug("Git", "Loading the full git configuration.");
+
+      const auto ret = mGitBase->run("git config --list -z");
+
+      if (!ret.success)
+         return mGitBase->run(QString("git config --get %1").arg(key));
+
+      snapshot.values.clear();
+      snapshot.localModified = localModified;
+      snapshot.globalModified = globalModified;
+      snapshot.loaded = true;
+
+      // Each -z record is key\nvalue; a repeated key keeps the last value, matching what
+      // git config --get answers for multi-valued entries.
+      const auto entries = ret.outputBytes().split('\0');
+
+      for (const auto &entry : entries)
+      {
+         if (entry.isEmpty())
+            continue;
+
+         const auto separator = entry.indexOf('\n');
+
+         if (separator == -1)
+            snapshot.values.insert(QString::fromUtf8(entry), QString());
+         else
+            snapshot.values.insert(QString::fromUtf8(entry.constData(), separator),
+                                   QString::fromUtf8(entry.constData() + separator + 1,
+                                                     entry.size() - separator - 1));
+      }
+   }
+
+   const auto value = snapshot.values.constFind(key);
+
+   // A missing key fails the same way git config --get exits with an error
+   if (value == snapshot.values.cend())
+      return GitExecResult();
+
+   return { true, *value };
 }
 
 QString GitConfig::getServerUrl() const
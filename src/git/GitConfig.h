@@ -56,7 +56,8 @@ public:
    GitUserInfo getLocalUserInfo() const;
    void setLocalUserInfo(const GitUserInfo &info);
    GitExecResult setLocalData(const QString &key, const QString &value);
-   GitExecResult clone(const QString &url, const QString &fullPath);
+   GitExecResult clone(const QString &url, const QString &fullPath, bool partial = false, int depth = 0,
+                       bool singleBranch = false);
    GitExecResult initRepo(const QString &fullPath);
    GitExecResult getLocalConfig() const;
    GitExecResult getGlobalConfig() const;
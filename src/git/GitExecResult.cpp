@@ -25,3 +25,13 @@ GitExecResult &GitExecResult::operator=(const QPair<bool, QString> &result)
 
    return *this;
 }
+
+QByteArray GitExecResult::outputBytes() const
+{
+   return output.toByteArray();
+}
+
+QString GitExecResult::outputText() const
+{
+   return output.toString();
+}
@@ -26,6 +26,18 @@
 #include <QPair>
 #include <QVariant>
 
+/**
+ * @brief The GitExecPriority enum classifies git invocations for the command scheduler. Interactive commands are
+ * the ones the user is actively waiting for, refresh covers the repository reloads and background the analytics
+ * sweeps that can be delayed without the user noticing.
+ */
+enum class GitExecPriority
+{
+   Interactive,
+   Refresh,
+   Background
+};
+
 struct GitExecResult
 {
    GitExecResult() = default;
@@ -33,6 +45,19 @@ struct GitExecResult
    GitExecResult(const QPair<bool, QVariant> &result);
    GitExecResult(const QPair<bool, QString> &result);
    GitExecResult &operator=(const QPair<bool, QString> &result);
+
+   /**
+    * @brief outputBytes Gets the output as raw bytes, without converting it to UTF-16. Heavy consumers of large
+    * outputs (log and diff parsing) should prefer this channel over @ref outputText.
+    */
+   QByteArray outputBytes() const;
+
+   /**
+    * @brief outputText Gets the output converted to text. The conversion is paid here, only by the consumers that
+    * really need a QString.
+    */
+   QString outputText() const;
+
    bool success = false;
    QVariant output {};
 };
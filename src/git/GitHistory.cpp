@@ -6,10 +6,29 @@
 
 #include <QLogger.h>
 
+#include <QFileInfo>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
 #include <QStringLiteral>
 
 using namespace QLogger;
 
+namespace
+{
+/* A file's follow walk visits the whole history and takes seconds on deep repositories, so the
+   resulting commit chain (rename hops included) is shared per repository and file, and only
+   recomputed when HEAD moves. */
+struct FileHistorySnapshot
+{
+   QString headSha;
+   QString shaChain;
+};
+
+QHash<QString, FileHistorySnapshot> fileHistorySnapshots;
+QMutex fileHistorySnapshotsMutex;
+}
+
 GitHistory::GitHistory(const QSharedPointer<GitBase> &gitBase)
    : mGitBase(gitBase)
 {
@@ -32,6 +51,17 @@ GitExecResult GitHistory::history(const QString &file)
 {
    QLog_Debug("Git", QString("Executing history: {%1}").arg(file));
 
+   const auto key = QString("%1\n%2").arg(mGitBase->getGitDir(), file);
+   const auto headSha = mGitBase->getLastCommit().output.toString().trimmed();
+
+   {
+      QMutexLocker lock(&fileHistorySnapshotsMutex);
+      const auto iter = fileHistorySnapshots.constFind(key);
+
+      if (iter != fileHistorySnapshots.cend() && iter->headSha == headSha)
+         return { true, iter->shaChain };
+   }
+
    const auto cmd = QString("git log --follow --pretty=%H %1").arg(file);
 
    QLog_Trace("Git", QString("Executing history: {%1}").arg(cmd));
@@ -41,6 +71,12 @@ GitExecResult GitHistory::history(const QString &file)
    if (ret.success && ret.output.toString().isEmpty())
       ret.success = false;
 
+   if (ret.success)
+   {
+      QMutexLocker lock(&fileHistorySnapshotsMutex);
+      fileHistorySnapshots.insert(key, { headSha, ret.output.toString() });
+   }
+
    return ret;
 }
 
@@ -75,19 +111,7 @@ GitExecResult GitHistory::getCommitDiff(const QString &sha, const QString &diffT
    {
       QLog_Debug("Git", QString("Executing diff for commit: {%1} to {%2}").arg(sha, diffToSha));
 
-      QString runCmd = QString("git diff-tree --no-color -r --patch-with-stat -m");
-
-      if (sha != CommitInfo::ZERO_SHA)
-      {
-         runCmd += " -C ";
-
-         if (diffToSha.isEmpty())
-            runCmd += " --root ";
-
-         runCmd.append(QString("%1 %2").arg(diffToSha, sha)); // diffToSha could be empty
-      }
-      else
-         runCmd = "git diff HEAD ";
+      const auto runCmd = getCommitDiffCmd(sha, diffToSha);
 
       QLog_Trace("Git", QString("Executing diff for commit: {%1}").arg(runCmd));
 
@@ -99,6 +123,25 @@ GitExecResult GitHistory::getCommitDiff(const QString &sha, const QString &diffT
    return qMakePair(false, QString());
 }
 
+QString GitHistory::getCommitDiffCmd(const QString &sha, const QString &diffToSha)
+{
+   QString runCmd = QString("git diff-tree --no-color -r --patch-with-stat -m");
+
+   if (sha != CommitInfo::ZERO_SHA)
+   {
+      runCmd += " -C ";
+
+      if (diffToSha.isEmpty())
+         runCmd += " --root ";
+
+      runCmd.append(QString("%1 %2").arg(diffToSha, sha)); // diffToSha could be empty
+   }
+   else
+      runCmd = "git diff HEAD ";
+
+   return runCmd;
+}
+
 QString GitHistory::getFileDiff(const QString &currentSha, const QString &previousSha, const QString &file,
                                 bool isCached)
 {
@@ -119,6 +162,40 @@ QString GitHistory::getFileDiff(const QString &currentSha, const QString &previo
    return QString();
 }
 
+bool GitHistory::isFileBinary(const QString &currentSha, const QString &previousSha, const QString &file,
+                              bool isCached)
+{
+   auto cmd = QString("git diff --numstat %1 ").arg(QString::fromUtf8(isCached ? "--cached" : ""));
+
+   if (currentSha.isEmpty() || currentSha == CommitInfo::ZERO_SHA)
+      cmd.append(file);
+   else
+      cmd.append(QString("%1 %2 %3").arg(previousSha, currentSha, file));
+
+   QLog_Trace("Git", QString("Checking if the file change is binary: {%1}").arg(cmd));
+
+   // Binary changes are reported with dashes instead of the added/removed line counters
+   if (const auto ret = mGitBase->run(cmd); ret.success)
+      return ret.output.toString().startsWith("-\t-\t");
+
+   return false;
+}
+
+qint64 GitHistory::getFileSize(const QString &sha, const QString &file)
+{
+   if (sha.isEmpty() || sha == CommitInfo::ZERO_SHA)
+      return QFileInfo(mGitBase->getWorkingDir() + "/" + file).size();
+
+   const auto cmd = QString("git cat-file -s %1:%2").arg(sha, file);
+
+   QLog_Trace("Git", QString("Reading the size of a file at a revision: {%1}").arg(cmd));
+
+   if (const auto ret = mGitBase->run(cmd); ret.success)
+      return ret.output.toString().trimmed().toLongLong();
+
+   return 0;
+}
+
 GitExecResult GitHistory::getDiffFiles(const QString &sha, const QString &diffToSha)
 {
    QLog_Debug("Git", QString("Getting modified files between SHAs: {%1} to {%2}").arg(sha, diffToSha));
@@ -38,7 +38,36 @@ public:
    GitExecResult history(const QString &file);
    GitExecResult getBranchesDiff(const QString &base, const QString &head);
    GitExecResult getCommitDiff(const QString &sha, const QString &diffToSha);
+   /**
+    * @brief getCommitDiffCmd Builds the git invocation used by getCommitDiff. It is exposed so asynchronous
+    * consumers can run the very same command through GitAsyncProcess and cancel it when superseded.
+    * @param sha The base commit SHA.
+    * @param diffToSha The commit SHA to compare to.
+    * @return The full git command.
+    */
+   static QString getCommitDiffCmd(const QString &sha, const QString &diffToSha);
    QString getFileDiff(const QString &currentSha, const QString &previousSha, const QString &file, bool isCached);
+
+   /**
+    * @brief isFileBinary Checks whether git considers the change of the given file binary. It is a
+    * pre-flight query based on the diff stats, so the diff body is never generated.
+    * @param currentSha The base SHA. Empty or ZERO_SHA for the work in progress state.
+    * @param previousSha The SHA to compare to.
+    * @param file The file to check.
+    * @param isCached True when the staged version must be checked.
+    * @return bool True when git reports a binary change.
+    */
+   bool isFileBinary(const QString &currentSha, const QString &previousSha, const QString &file, bool isCached);
+
+   /**
+    * @brief getFileSize Reads the size in bytes of the given file at the given revision without
+    * touching its content.
+    * @param sha The revision SHA. Empty or ZERO_SHA for the on-disk file.
+    * @param file The file to measure.
+    * @return qint64 The size in bytes, or 0 if the file cannot be read.
+    */
+   qint64 getFileSize(const QString &sha, const QString &file);
+
    GitExecResult getDiffFiles(const QString &sha, const QString &diffToSha);
    GitExecResult getUntrackedFileDiff(const QString &file) const;
 
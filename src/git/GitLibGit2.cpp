@@ -0,0 +1,196 @@
+#include "GitLibGit2.h"
+
+#ifndef USE_LIBGIT2
+
+bool GitLibGit2::tryRun(const QString &, const QString &, GitExecResult &)
+{
+   return false;
+}
+
+#else
+
+#include <git2.h>
+
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+
+namespace
+{
+/* One repository handle per working directory, opened lazily and kept for the whole session.
+ * libgit2 re-reads the refs from disk on every lookup, so a long-lived handle never answers with
+ * stale data. The map is guarded by the mutex below since GitBase::run is called from the
+ * TaskPool threads as well. */
+QHash<QString, git_repository *> openRepositories;
+QMutex repositoriesMutex;
+
+enum class ConfigScope
+{
+   Effective,
+   Local,
+   Global
+};
+
+git_repository *repositoryFor(const QString &workingDir)
+{
+   static auto initialized = false;
+
+   if (!initialized)
+   {
+      git_libgit2_init();
+      initialized = true;
+   }
+
+   if (const auto iter = openRepositories.constFind(workingDir); iter != openRepositories.cend())
+      return *iter;
+
+   git_repository *repo = nullptr;
+
+   if (git_repository_open(&repo, workingDir.toUtf8().constData()) != 0)
+      repo = nullptr;
+
+   openRepositories.insert(workingDir, repo);
+
+   return repo;
+}
+
+bool resolveHead(git_repository *repo, GitExecResult &result)
+{
+   git_oid oid;
+
+   if (git_reference_name_to_id(&oid, repo, "HEAD") != 0)
+      return false;
+
+   char sha[GIT_OID_HEXSZ + 1];
+   git_oid_tostr(sha, sizeof(sha), &oid);
+
+   result = GitExecResult(true, QString::fromLatin1(sha) + "\n");
+
+   return true;
+}
+
+bool resolveCurrentBranch(git_repository *repo, GitExecResult &result)
+{
+   /* A detached HEAD prints the literal "HEAD", matching git rev-parse --abbrev-ref. */
+   if (git_repository_head_detached(repo) == 1)
+   {
+      result = GitExecResult(true, QStringLiteral("HEAD\n"));
+      return true;
+   }
+
+   git_reference *head = nullptr;
+
+   if (git_repository_head(&head, repo) != 0)
+      return false;
+
+   result = GitExecResult(true, QString::fromUtf8(git_reference_shorthand(head)) + "\n");
+
+   git_reference_free(head);
+
+   return true;
+}
+
+bool configGet(git_repository *repo, const QString &key, ConfigScope scope, GitExecResult &result)
+{
+   git_config *config = nullptr;
+
+   if (git_repository_config(&config, repo) != 0)
+      return false;
+
+   git_config *scoped = nullptr;
+
+   if (scope == ConfigScope::Local)
+   {
+      if (git_config_open_level(&scoped, config, GIT_CONFIG_LEVEL_LOCAL) != 0)
+      {
+         git_config_free(config);
+         return false;
+      }
+   }
+   else if (scope == ConfigScope::Global)
+   {
+      /* git config --global covers both ~/.gitconfig and the XDG location. */
+      if (git_config_open_level(&scoped, config, GIT_CONFIG_LEVEL_GLOBAL) != 0
+          && git_config_open_level(&scoped, config, GIT_CONFIG_LEVEL_XDG) != 0)
+      {
+         git_config_free(config);
+         return false;
+      }
+   }
+
+   git_config *snapshot = nullptr;
+   auto answered = false;
+
+   if (git_config_snapshot(&snapshot, scoped ? scoped : config) == 0)
+   {
+      const char *value = nullptr;
+      const auto error = git_config_get_string(&value, snapshot, key.toUtf8().constData());
+
+      if (error == 0)
+      {
+         result = GitExecResult(true, QString::fromUtf8(value) + "\n");
+         answered = true;
+      }
+      else if (error == GIT_ENOTFOUND)
+      {
+         /* Matches the failed exit of git config --get for a missing key. */
+         result = GitExecResult(false, QString());
+         answered = true;
+      }
+
+      git_config_free(snapshot);
+   }
+
+   if (scoped)
+      git_config_free(scoped);
+
+   git_config_free(config);
+
+   return answered;
+}
+}
+
+bool GitLibGit2::tryRun(const QString &workingDir, const QString &cmd, GitExecResult &result)
+{
+   QMutexLocker lock(&repositoriesMutex);
+
+   const auto repo = repositoryFor(workingDir);
+
+   if (!repo)
+      return false;
+
+   if (cmd == QStringLiteral("git rev-parse HEAD") || cmd == QStringLiteral("git rev-parse --revs-only HEAD"))
+      return resolveHead(repo, result);
+
+   if (cmd == QStringLiteral("git rev-parse --abbrev-ref HEAD"))
+      return resolveCurrentBranch(repo, result);
+
+   const auto getPrefix = QStringLiteral("git config --get ");
+
+   if (cmd.startsWith(getPrefix))
+   {
+      auto key = cmd.mid(getPrefix.size());
+      auto scope = ConfigScope::Effective;
+
+      if (key.startsWith(QStringLiteral("--global ")))
+      {
+         scope = ConfigScope::Global;
+         key = key.mid(QStringLiteral("--global ").size());
+      }
+      else if (key.startsWith(QStringLiteral("--local ")))
+      {
+         scope = ConfigScope::Local;
+         key = key.mid(QStringLiteral("--local ").size());
+      }
+
+      /* Anything beyond a plain key (more options, multiple keys) goes to the subprocess. */
+      if (key.isEmpty() || key.contains(QLatin1Char(' ')) || key.startsWith(QLatin1Char('-')))
+         return false;
+
+      return configGet(repo, key, scope, result);
+   }
+
+   return false;
+}
+
+#endif
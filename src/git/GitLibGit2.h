@@ -0,0 +1,49 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+#include <GitExecResult.h>
+
+#include <QString>
+
+/**
+ * The GitLibGit2 namespace holds the optional in-process backend for the small read-only metadata
+ * queries (rev-parse and config reads). Those commands are answered through libgit2 without
+ * spawning a git child process, removing the process-spawn cost that dominates their runtime,
+ * especially on Windows. The backend is compiled in with `qmake USE_LIBGIT2=1`; without the flag,
+ * and for every command the backend doesn't understand, the regular subprocess path is used.
+ */
+namespace GitLibGit2
+{
+/**
+ * @brief tryRun Answers the given command in-process when it is one of the supported read-only
+ * metadata queries of the repository at @p workingDir.
+ * @param workingDir The working directory of the repository.
+ * @param cmd The git command to run.
+ * @param result The result of the execution. Only written when the command was answered.
+ * @return True when the command was answered in-process; false when it must go through the
+ * subprocess path.
+ */
+bool tryRun(const QString &workingDir, const QString &cmd, GitExecResult &result);
+}
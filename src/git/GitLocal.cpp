@@ -58,6 +58,22 @@ GitExecResult GitLocal::cherryPickCommit(const QString &sha) const
    return ret;
 }
 
+GitExecResult GitLocal::cherryPickCommits(const QStringList &shas) const
+{
+   if (shas.count() == 1)
+      return cherryPickCommit(shas.constFirst());
+
+   QLog_Debug("Git", QString("Cherry-picking {%1} commits").arg(shas.count()));
+
+   const auto cmd = QString("git cherry-pick %1").arg(shas.join(" "));
+
+   QLog_Trace("Git", QString("Cherry-picking commits: {%1}").arg(cmd));
+
+   const auto ret = mGitBase->run(cmd);
+
+   return ret;
+}
+
 GitExecResult GitLocal::cherryPickAbort() const
 {
    QLog_Debug("Git", QString("Aborting cherryPick"));
@@ -100,19 +116,67 @@ GitExecResult GitLocal::checkoutCommit(const QString &sha) const
    return ret;
 }
 
-GitExecResult GitLocal::markFilesAsResolved(const QStringList &files)
+GitExecResult GitLocal::stageFiles(const QStringList &files) const
 {
-   QLog_Debug("Git", QString("Marking {%1} files as resolved").arg(files.count()));
+   if (files.isEmpty())
+      return GitExecResult();
 
-   const auto cmd = QString("git add %1").arg(files.join(" "));
+   if (files.count() == 1)
+      return stageFile(files.constFirst());
 
-   QLog_Trace("Git", QString("Marking files as resolved: {%1}").arg(cmd));
+   QLog_Debug("Git", QString("Staging {%1} files").arg(files.count()));
 
-   const auto ret = mGitBase->run(cmd);
+   QByteArray paths;
+
+   for (const auto &file : files)
+   {
+      paths.append(file.toUtf8());
+      paths.append('\0');
+   }
+
+   const auto ret = mGitBase->runWithInput("git add --pathspec-from-file=- --pathspec-file-nul", paths);
+
+   // Clients older than git 2.25 don't know --pathspec-from-file; joining the paths on the
+   // command line keeps them working.
+   if (!ret.success && ret.outputText().contains("pathspec-from-file"))
+      return mGitBase->run(QString("git add %1").arg(files.join(" ")));
 
    return ret;
 }
 
+GitExecResult GitLocal::unstageFiles(const QStringList &files) const
+{
+   if (files.isEmpty())
+      return GitExecResult();
+
+   if (files.count() == 1)
+      return resetFile(files.constFirst());
+
+   QLog_Debug("Git", QString("Unstaging {%1} files").arg(files.count()));
+
+   QByteArray paths;
+
+   for (const auto &file : files)
+   {
+      paths.append(file.toUtf8());
+      paths.append('\0');
+   }
+
+   const auto ret = mGitBase->runWithInput("git reset --pathspec-from-file=- --pathspec-file-nul", paths);
+
+   if (!ret.success && ret.outputText().contains("pathspec-from-file"))
+      return mGitBase->run(QString("git reset %1").arg(files.join(" ")));
+
+   return ret;
+}
+
+GitExecResult GitLocal::markFilesAsResolved(const QStringList &files)
+{
+   QLog_Debug("Git", QString("Marking {%1} files as resolved").arg(files.count()));
+
+   return stageFiles(files);
+}
+
 bool GitLocal::checkoutFile(const QString &fileName) const
 {
    if (fileName.isEmpty())
@@ -237,7 +301,7 @@ GitExecResult GitLocal::updateIndex(const RevisionFiles &files, const QStringLis
 
    for (const auto &file : selFiles)
    {
-      const auto index = files.mFiles.indexOf(file);
+      const auto index = files.indexOfFile(file);
 
       if (index != -1 && files.statusCmp(index, RevisionFiles::DELETED))
          toRemove << file;
@@ -43,10 +43,31 @@ public:
    explicit GitLocal(const QSharedPointer<GitBase> &gitBase);
    bool isInCherryPickMerge() const;
    GitExecResult cherryPickCommit(const QString &sha) const;
+   /**
+    * @brief cherryPickCommits Cherry-picks all the given commits with a single git invocation,
+    * applied in the given order. On a conflict git's sequencer keeps the pending picks, so
+    * cherryPickContinue resumes the whole batch once the conflict is resolved.
+    * @param shas The commits to cherry-pick, oldest first.
+    * @return GitExecResult The result of the execution.
+    */
+   GitExecResult cherryPickCommits(const QStringList &shas) const;
    GitExecResult cherryPickAbort() const;
    GitExecResult cherryPickContinue() const;
    GitExecResult checkoutCommit(const QString &sha) const;
    GitExecResult stageFile(const QString &fileName) const;
+   /**
+    * @brief stageFiles Stages all the given files with a single git spawn: the path list travels
+    * NUL-separated over stdin, so any number of files fits.
+    * @param files The files to stage.
+    * @return GitExecResult The result of the execution.
+    */
+   GitExecResult stageFiles(const QStringList &files) const;
+   /**
+    * @brief unstageFiles Unstages all the given files with a single git spawn.
+    * @param files The files to unstage.
+    * @return GitExecResult The result of the execution.
+    */
+   GitExecResult unstageFiles(const QStringList &files) const;
    GitExecResult markFilesAsResolved(const QStringList &files);
    bool checkoutFile(const QString &fileName) const;
 
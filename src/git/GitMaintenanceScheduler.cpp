@@ -0,0 +1,112 @@
+#include "GitMaintenanceScheduler.h"
+
+#include <GitAsyncProcess.h>
+#include <GitBase.h>
+#include <GitQlientSettings.h>
+
+#include <QLogger.h>
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QEvent>
+#include <QTimer>
+
+using namespace QLogger;
+
+namespace
+{
+constexpr auto PollIntervalMs = 60 * 1000;
+constexpr auto IdleThresholdMs = 5 * 60 * 1000;
+constexpr auto MaintenanceCadenceSecs = 24 * 60 * 60;
+}
+
+GitMaintenanceScheduler::GitMaintenanceScheduler(const QSharedPointer<GitBase> &git,
+                                                 const QSharedPointer<GitQlientSettings> &settings, QObject *parent)
+   : QObject(parent)
+   , mGit(git)
+   , mSettings(settings)
+   , mPollTimer(new QTimer(this))
+{
+   mLastActivity.start();
+
+   mPollTimer->setInterval(PollIntervalMs);
+   connect(mPollTimer, &QTimer::timeout, this, &GitMaintenanceScheduler::onPollTimeout);
+   mPollTimer->start();
+
+   qApp->installEventFilter(this);
+}
+
+bool GitMaintenanceScheduler::eventFilter(QObject *watched, QEvent *event)
+{
+   switch (event->type())
+   {
+      case QEvent::KeyPress:
+      case QEvent::MouseButtonPress:
+      case QEvent::MouseMove:
+      case QEvent::Wheel:
+         mLastActivity.restart();
+         break;
+      default:
+         break;
+   }
+
+   return QObject::eventFilter(watched, event);
+}
+
+void GitMaintenanceScheduler::onPollTimeout()
+{
+   if (mRunning || mLastActivity.elapsed() < IdleThresholdMs)
+      return;
+
+   const auto lastRun = mSettings->localValue("LastMaintenance", 0).toLongLong();
+   const auto now = QDateTime::currentSecsSinceEpoch();
+
+   if (now - lastRun < MaintenanceCadenceSecs)
+      return;
+
+   QLog_Info("Git", "Starting idle repository maintenance.");
+
+   // The --auto thresholds make the tasks no-ops when the structures are already fresh, so a run
+   // on a healthy repository only costs a couple of short-lived processes.
+   mPendingTasks = { "git maintenance run --auto --task=commit-graph --task=loose-objects --task=incremental-repack",
+                     "git pack-refs --all --prune" };
+   mRunning = true;
+
+   runNextTask();
+}
+
+void GitMaintenanceScheduler::runNextTask()
+{
+   if (mPendingTasks.isEmpty())
+   {
+      mRunning = false;
+      mSettings->setLocalValue("LastMaintenance", QDateTime::currentSecsSinceEpoch());
+
+      QLog_Info("Git", "Idle repository maintenance finished.");
+
+      return;
+   }
+
+   const auto cmd = mPendingTasks.takeFirst();
+
+   // The background priority class keeps the maintenance child from competing with interactive
+   // and refresh commands for the bounded process slots and, through them, for the disk.
+   const auto process = new GitAsyncProcess(mGit->getWorkingDir());
+   process->setPriority(GitExecPriority::Background);
+
+   connect(process, &GitAsyncProcess::signalDataReady, this, [this, cmd](GitExecResult result) {
+      // Gits older than 2.30 lack the maintenance builtin; the same structures are then refreshed
+      // with the commands it wraps.
+      if (!result.success && cmd.startsWith("git maintenance"))
+         mPendingTasks = QStringList({ "git commit-graph write --reachable", "git gc --auto" }) + mPendingTasks;
+
+      runNextTask();
+   });
+
+   if (!process->run(cmd).success)
+   {
+      process->deleteLater();
+
+      runNextTask();
+   }
+}
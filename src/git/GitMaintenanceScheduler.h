@@ -0,0 +1,86 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QSharedPointer>
+#include <QStringList>
+
+class GitBase;
+class GitQlientSettings;
+class QTimer;
+
+/**
+ * @brief The GitMaintenanceScheduler class keeps the open repository healthy without user action.
+ * The speed of every command GitQlient issues depends on the repository structures git maintains
+ * lazily: a fresh commit-graph, consolidated packs and packed refs. The scheduler watches for user
+ * inactivity and, at most once a day per repository, runs the corresponding maintenance tasks
+ * through the background priority class so they never compete with interactive commands for the
+ * disk.
+ */
+class GitMaintenanceScheduler : public QObject
+{
+   Q_OBJECT
+
+public:
+   /**
+    * @brief Default constructor.
+    *
+    * @param git The git object to perform Git operations.
+    * @param settings The settings of the current repository, used to persist the last run.
+    * @param parent The parent object if needed.
+    */
+   explicit GitMaintenanceScheduler(const QSharedPointer<GitBase> &git,
+                                    const QSharedPointer<GitQlientSettings> &settings, QObject *parent = nullptr);
+
+protected:
+   /**
+    * @brief Records the user input events of the whole application to measure inactivity.
+    *
+    * @param watched The watched object.
+    * @param event The event being delivered.
+    * @return False so the event keeps its normal delivery.
+    */
+   bool eventFilter(QObject *watched, QEvent *event) override;
+
+private:
+   QSharedPointer<GitBase> mGit;
+   QSharedPointer<GitQlientSettings> mSettings;
+   QTimer *mPollTimer = nullptr;
+   QElapsedTimer mLastActivity;
+   QStringList mPendingTasks;
+   bool mRunning = false;
+
+   /**
+    * @brief Checks on every poll whether the idle and cadence conditions are met and starts the
+    * maintenance tasks when they are.
+    */
+   void onPollTimeout();
+   /**
+    * @brief Runs the next queued maintenance task; the chain runs one command at a time so at most
+    * one maintenance child process touches the disk.
+    */
+   void runNextTask();
+};
@@ -0,0 +1,132 @@
+#include "GitMergeAnalyzer.h"
+
+#include <GitBase.h>
+#include <GitCache.h>
+#include <TaskPool.h>
+
+#include <QLogger.h>
+
+#include <QMutex>
+#include <QMutexLocker>
+#include <QPointer>
+#include <QtConcurrent/QtConcurrentRun>
+
+using namespace QLogger;
+
+namespace
+{
+QMutex kVerdictsMutex;
+
+/**
+ * @brief verdicts Verdicts stored across instances, keyed by git dir and the sha pair. The key
+ * addresses the exact tree contents, so entries never go stale and are simply superseded by new
+ * pairs when the branches move.
+ * @return The verdicts store.
+ */
+QHash<QString, bool> &verdicts()
+{
+   static QHash<QString, bool> cache;
+
+   return cache;
+}
+
+QString verdictKey(const QString &gitDir, const QString &oursSha, const QString &theirsSha)
+{
+   return QString("%1|%2|%3").arg(gitDir, oursSha, theirsSha);
+}
+}
+
+GitMergeAnalyzer::GitMergeAnalyzer(const QSharedPointer<GitBase> &gitBase, const QSharedPointer<GitCache> &cache,
+                                   QObject *parent)
+   : QObject(parent)
+   , mGitBase(gitBase)
+   , mCache(cache)
+{
+}
+
+GitMergeAnalyzer::Verdict GitMergeAnalyzer::cachedVerdict(const QString &oursRef, const QString &theirsRef) const
+{
+   const auto shas = resolveShas(oursRef, theirsRef);
+
+   QMutexLocker lock(&kVerdictsMutex);
+   const auto iter = verdicts().constFind(verdictKey(mGitBase->getGitDir(), shas.first, shas.second));
+
+   if (iter == verdicts().constEnd())
+      return Verdict::Unknown;
+
+   return iter.value() ? Verdict::Conflicts : Verdict::Clean;
+}
+
+void GitMergeAnalyzer::analyze(const QString &oursRef, const QString &theirsRef)
+{
+   const auto shas = resolveShas(oursRef, theirsRef);
+
+   if (shas.first.isEmpty() || shas.second.isEmpty())
+      return;
+
+   {
+      QMutexLocker lock(&kVerdictsMutex);
+      const auto iter = verdicts().constFind(verdictKey(mGitBase->getGitDir(), shas.first, shas.second));
+
+      if (iter != verdicts().constEnd())
+      {
+         emit verdictReady(shas.first, shas.second, iter.value());
+         return;
+      }
+   }
+
+   QLog_Debug("Git", QString("Analyzing merge of {%1} into {%2}").arg(shas.second, shas.first));
+
+   const auto base = mCache->getMergeBase(shas.first, shas.second);
+
+   QtConcurrent::run(TaskPool::instance()->pool(),
+                     [git = mGitBase, base, shas, guard = QPointer<GitMergeAnalyzer>(this)]() {
+                        auto mergeBase = base;
+
+                        // The cached DAG may not contain both tips (shallow log); merge-base then
+                        // resolves the ancestor on the worker
+                        if (mergeBase.isEmpty())
+                        {
+                           const auto ret = git->run(QString("git merge-base %1 %2").arg(shas.first, shas.second));
+
+                           if (!ret.success)
+                              return;
+
+                           mergeBase = ret.output.toString().trimmed();
+                        }
+
+                        // merge-tree performs the three-way comparison at tree level and never
+                        // touches the working tree nor the index
+                        const auto ret
+                            = git->run(QString("git merge-tree %1 %2 %3").arg(mergeBase, shas.first, shas.second));
+
+                        if (!ret.success)
+                           return;
+
+                        const auto conflicts = ret.output.toString().contains("<<<<<<<");
+
+                        {
+                           QMutexLocker lock(&kVerdictsMutex);
+                           verdicts().insert(verdictKey(git->getGitDir(), shas.first, shas.second), conflicts);
+                        }
+
+                        if (guard)
+                        {
+                           QMetaObject::invokeMethod(
+                               guard,
+                               [guard, shas, conflicts]() {
+                                  if (guard)
+                                     emit guard->verdictReady(shas.first, shas.second, conflicts);
+                               },
+                               Qt::QueuedConnection);
+                        }
+                     });
+}
+
+QPair<QString, QString> GitMergeAnalyzer::resolveShas(const QString &oursRef, const QString &theirsRef) const
+{
+   const auto oursSha = mCache->getShaOfReference(oursRef);
+   const auto theirsSha = mCache->getShaOfReference(theirsRef);
+
+   return qMakePair(oursSha.isEmpty() ? oursRef : oursSha, theirsSha.isEmpty() ? theirsRef : theirsSha);
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+#include <QObject>
+#include <QSharedPointer>
+
+class GitBase;
+class GitCache;
+
+/**
+ * @brief The GitMergeAnalyzer class answers whether merging one branch into another would
+ * conflict, without touching the working tree. The merge base comes from the cached DAG and the
+ * three-way comparison runs through git merge-tree, which works at tree level only, on a worker
+ * of the task pool. Verdicts are cached per (ours, theirs) sha pair across instances: the shas
+ * address the exact tree contents, so a cached verdict can never go stale and reopening a menu
+ * answers synchronously.
+ */
+class GitMergeAnalyzer : public QObject
+{
+   Q_OBJECT
+
+signals:
+   /**
+    * @brief verdictReady Emitted when the analysis of a pair finished.
+    * @param oursSha The sha of the branch merged into.
+    * @param theirsSha The sha of the branch merged in.
+    * @param conflicts True when the merge would conflict.
+    */
+   void verdictReady(const QString &oursSha, const QString &theirsSha, bool conflicts);
+
+public:
+   /**
+    * @brief The Verdict enum is the cached answer for a pair of shas.
+    */
+   enum class Verdict
+   {
+      Unknown,
+      Clean,
+      Conflicts
+   };
+
+   /**
+    * @brief Default constructor.
+    * @param gitBase The git object to perform the git operations.
+    * @param cache The internal repository cache, used to resolve the refs and the merge base.
+    * @param parent The parent object.
+    */
+   explicit GitMergeAnalyzer(const QSharedPointer<GitBase> &gitBase, const QSharedPointer<GitCache> &cache,
+                             QObject *parent = nullptr);
+
+   /**
+    * @brief cachedVerdict Returns the stored verdict for the pair of refs, when one exists.
+    * @param oursRef The branch merged into.
+    * @param theirsRef The branch merged in.
+    * @return The verdict, Unknown when the pair was never analyzed.
+    */
+   Verdict cachedVerdict(const QString &oursRef, const QString &theirsRef) const;
+
+   /**
+    * @brief analyze Starts the dry-run analysis of the pair on a worker. A cached verdict is
+    * emitted right away; otherwise @ref verdictReady arrives once merge-tree finished.
+    * @param oursRef The branch merged into.
+    * @param theirsRef The branch merged in.
+    */
+   void analyze(const QString &oursRef, const QString &theirsRef);
+
+private:
+   QSharedPointer<GitBase> mGitBase;
+   QSharedPointer<GitCache> mCache;
+
+   /**
+    * @brief resolveShas Resolves both refs to shas through the reference index of the cache. A
+    * ref that doesn't resolve is kept as given, so abbreviated shas still work.
+    * @param oursRef The branch merged into.
+    * @param theirsRef The branch merged in.
+    * @return The pair of shas.
+    */
+   QPair<QString, QString> resolveShas(const QString &oursRef, const QString &theirsRef) const;
+};
@@ -0,0 +1,113 @@
+#include "GitOperationRunner.h"
+
+#include <GitAsyncProcess.h>
+#include <GitBase.h>
+
+#include <QLogger.h>
+
+#include <QRegExp>
+
+using namespace QLogger;
+
+GitOperationRunner::GitOperationRunner(const QSharedPointer<GitBase> &gitBase, QObject *parent)
+   : QObject(parent)
+   , mGitBase(gitBase)
+{
+}
+
+bool GitOperationRunner::run(const QString &cmd)
+{
+   if (mProcess)
+      return false;
+
+   QLog_Debug("Git", QString("Running long operation: {%1}").arg(cmd));
+
+   mCanceled = false;
+   mOutput.clear();
+   mErrorOutput.clear();
+
+   mProcess = new GitAsyncProcess(mGitBase->getWorkingDir());
+
+   connect(mProcess, &AGitProcess::procDataReady, this, &GitOperationRunner::onStandardOutput);
+   connect(mProcess, &QProcess::readyReadStandardError, this, &GitOperationRunner::onStandardError);
+   connect(mProcess, static_cast<void (QProcess::*)(int, QProcess::ExitStatus)>(&QProcess::finished), this,
+           [this](int exitCode, QProcess::ExitStatus exitStatus) {
+              onProcessFinished(exitCode, exitStatus != QProcess::NormalExit);
+           });
+
+   if (const auto started = mProcess->run(cmd).success; !started)
+   {
+      mProcess->deleteLater();
+      mProcess = nullptr;
+
+      return false;
+   }
+
+   return true;
+}
+
+void GitOperationRunner::cancel()
+{
+   if (mProcess)
+   {
+      mCanceled = true;
+      mProcess->onCancel();
+   }
+}
+
+void GitOperationRunner::onStandardOutput(const QByteArray &data)
+{
+   mOutput.append(QString::fromUtf8(data));
+}
+
+void GitOperationRunner::onStandardError()
+{
+   const auto chunk = QString::fromUtf8(mProcess->readAllStandardError());
+
+   mErrorOutput.append(chunk);
+
+   // Git rewrites the progress in place with carriage returns, so the last token of the chunk
+   // carries the most recent state
+#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
+   const auto lines = chunk.split(QRegExp("[\r\n]"), Qt::SkipEmptyParts);
+#else
+   const auto lines = chunk.split(QRegExp("[\r\n]"), QString::SkipEmptyParts);
+#endif
+
+   if (lines.isEmpty())
+      return;
+
+   const auto line = lines.constLast().trimmed();
+   auto percentage = -1;
+
+   if (QRegExp percentRx("(\\d+)%"); percentRx.indexIn(line) != -1)
+      percentage = percentRx.cap(1).toInt();
+   else if (QRegExp stepRx("\\((\\d+)/(\\d+)\\)"); stepRx.indexIn(line) != -1 && stepRx.cap(2).toInt() > 0)
+      percentage = stepRx.cap(1).toInt() * 100 / stepRx.cap(2).toInt();
+
+   emit progressChanged(percentage, line);
+}
+
+void GitOperationRunner::onProcessFinished(int exitCode, bool crashed)
+{
+   // The process deletes itself once finished
+   mProcess = nullptr;
+
+   if (mCanceled)
+   {
+      QLog_Debug("Git", QString("Long operation cancelled."));
+
+      emit operationCanceled();
+
+      return;
+   }
+
+   auto output = mOutput;
+
+   if (!mErrorOutput.isEmpty())
+      output.append((output.isEmpty() ? QString() : QString("\n")) + mErrorOutput);
+
+   // The exit code is authoritative here: the error channel was drained for progress, so the
+   // substring heuristics of AGitProcess cannot be applied
+   emit operationFinished({ exitCode == 0 && !crashed, output });
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+#include <GitExecResult.h>
+
+#include <QObject>
+#include <QSharedPointer>
+
+class GitBase;
+class GitAsyncProcess;
+
+/**
+ * @brief The GitOperationRunner class executes a long git operation through GitAsyncProcess, keeping the UI fully
+ * interactive while it runs. The progress git streams to the standard error channel is parsed and re-emitted so a
+ * non-modal surface can show it, and the operation can be cancelled at any time.
+ *
+ * @class GitOperationRunner GitOperationRunner.h "GitOperationRunner.h"
+ */
+class GitOperationRunner : public QObject
+{
+   Q_OBJECT
+
+signals:
+   /**
+    * @brief progressChanged Signal triggered when git streamed a new progress line.
+    * @param percentage The parsed percentage, or -1 when the line carries no quantifiable progress.
+    * @param text The last progress line streamed by git.
+    */
+   void progressChanged(int percentage, const QString &text);
+   /**
+    * @brief operationFinished Signal triggered when the operation ended, successfully or not.
+    * @param result The result with the combined standard and error output.
+    */
+   void operationFinished(GitExecResult result);
+   /**
+    * @brief operationCanceled Signal triggered when the operation was cancelled by the user.
+    */
+   void operationCanceled();
+
+public:
+   /**
+    * @brief Default constructor.
+    * @param gitBase The git object to extract the working directory.
+    * @param parent The parent object if needed.
+    */
+   explicit GitOperationRunner(const QSharedPointer<GitBase> &gitBase, QObject *parent = nullptr);
+
+   /**
+    * @brief run Starts the given command asynchronously. Only one operation can run at a time.
+    * @param cmd The full git command, including --progress when the operation supports it.
+    * @return True if the process started, otherwise false.
+    */
+   bool run(const QString &cmd);
+
+   /**
+    * @brief cancel Kills the running operation, if any.
+    */
+   void cancel();
+
+   /**
+    * @brief isRunning Tells whether an operation is currently running.
+    * @return True if an operation runs, otherwise false.
+    */
+   bool isRunning() const { return mProcess != nullptr; }
+
+private:
+   QSharedPointer<GitBase> mGitBase;
+   GitAsyncProcess *mProcess = nullptr;
+   QString mOutput;
+   QString mErrorOutput;
+   bool mCanceled = false;
+
+   /**
+    * @brief onStandardOutput Accumulates the standard output streamed by the process.
+    * @param data The new chunk of output.
+    */
+   void onStandardOutput(const QByteArray &data);
+
+   /**
+    * @brief onStandardError Accumulates the error output and parses the progress git rewrites in place on that
+    * channel.
+    */
+   void onStandardError();
+
+   /**
+    * @brief onProcessFinished Composes the final result once the process ended.
+    * @param exitCode The exit code of the process.
+    * @param crashed True when the process did not exit normally.
+    */
+   void onProcessFinished(int exitCode, bool crashed);
+};
@@ -65,6 +65,23 @@ bool GitPatches::applyPatch(const QString &fileName, bool asCommit)
    return ret.success;
 }
 
+GitExecResult GitPatches::applyPatches(const QStringList &fileNames, bool asCommit)
+{
+   QLog_Debug("Git",
+              QString("Applying a series of %1 patches %2")
+                  .arg(QString::number(fileNames.count()), asCommit ? QString("as commits.") : QString()));
+
+   // A single session applies the whole series, so long runs of patches don't pay one process
+   // start-up per file
+   auto cmd = asCommit ? QString("git am --signoff ") : QString("git apply ");
+
+   cmd.append(fileNames.join(QChar::Space));
+
+   QLog_Trace("Git", QString("Applying patch series: {%1}").arg(cmd));
+
+   return mGitBase->run(cmd);
+}
+
 GitExecResult GitPatches::stagePatch(const QString &fileName) const
 {
    QLog_Debug("Git", QString("Staging patch: {%1}").arg(fileName));
@@ -75,3 +92,14 @@ GitExecResult GitPatches::stagePatch(const QString &fileName) const
 
    return mGitBase->run(cmd);
 }
+
+GitExecResult GitPatches::unstagePatch(const QString &fileName) const
+{
+   QLog_Debug("Git", QString("Unstaging patch: {%1}").arg(fileName));
+
+   const auto cmd = QString("git apply --cached --reverse %1").arg(fileName);
+
+   QLog_Trace("Git", QString("Unstaging patch: {%1}").arg(cmd));
+
+   return mGitBase->run(cmd);
+}
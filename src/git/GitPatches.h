@@ -35,7 +35,9 @@ public:
    explicit GitPatches(const QSharedPointer<GitBase> &gitBase);
    GitExecResult exportPatch(const QStringList &shaList);
    bool applyPatch(const QString &fileName, bool asCommit = false);
+   GitExecResult applyPatches(const QStringList &fileNames, bool asCommit = false);
    GitExecResult stagePatch(const QString &fileName) const;
+   GitExecResult unstagePatch(const QString &fileName) const;
 
 private:
    QSharedPointer<GitBase> mGitBase;
@@ -0,0 +1,136 @@
+#include "GitRefsReader.h"
+
+#include <QLogger.h>
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+
+using namespace QLogger;
+
+GitRefsReader::GitRefsReader(const QString &gitDirPath)
+   : mGitDir(gitDirPath)
+{
+}
+
+QVector<GitRefsReader::Reference> GitRefsReader::readAll()
+{
+   const QFileInfo packedInfo(QString("%1/packed-refs").arg(mGitDir));
+
+   if (!packedInfo.exists())
+   {
+      mPackedModified = QDateTime();
+      mPackedSize = -1;
+      mPackedRefs.clear();
+      mPackedPeeled.clear();
+   }
+   else if (packedInfo.lastModified() != mPackedModified || packedInfo.size() != mPackedSize)
+   {
+      reloadPackedRefs();
+
+      mPackedModified = packedInfo.lastModified();
+      mPackedSize = packedInfo.size();
+   }
+
+   auto refs = mPackedRefs;
+
+   loadLooseRefs(QString("%1/refs").arg(mGitDir), QStringLiteral("refs"), refs);
+
+   QVector<Reference> references;
+   references.reserve(refs.count() + mPackedPeeled.count());
+
+   for (auto iter = refs.cbegin(); iter != refs.cend(); ++iter)
+   {
+      references.append({ iter.value(), iter.key() });
+
+      // A peeled entry is only valid while the packed ref it belongs to is the live one; a loose
+      // file shadowing the packed tag makes the stored peel stale.
+      if (const auto peeled = mPackedPeeled.constFind(iter.key());
+          peeled != mPackedPeeled.cend() && mPackedRefs.value(iter.key()) == iter.value())
+      {
+         references.append({ peeled.value(), iter.key() + QStringLiteral("^{}") });
+      }
+   }
+
+   return references;
+}
+
+void GitRefsReader::reloadPackedRefs()
+{
+   mPackedRefs.clear();
+   mPackedPeeled.clear();
+
+   QFile file(QString("%1/packed-refs").arg(mGitDir));
+
+   if (!file.open(QIODevice::ReadOnly))
+      return;
+
+   // The file is memory-mapped so the parse walks the page cache directly; readAll is only the
+   // fallback when mapping is not available.
+   const auto mapped = file.map(0, file.size());
+   const auto buffer = mapped
+       ? QByteArray::fromRawData(reinterpret_cast<const char *>(mapped), static_cast<int>(file.size()))
+       : file.readAll();
+
+   QString lastRef;
+   auto lineStart = 0;
+   const auto size = buffer.size();
+
+   while (lineStart < size)
+   {
+      auto lineEnd = buffer.indexOf('\n', lineStart);
+
+      if (lineEnd == -1)
+         lineEnd = size;
+
+      const auto length = lineEnd - lineStart;
+
+      if (length > 0)
+      {
+         const auto first = buffer.at(lineStart);
+
+         if (first == '^' && length >= 41 && !lastRef.isEmpty())
+            mPackedPeeled.insert(lastRef, QString::fromLatin1(buffer.constData() + lineStart + 1, 40));
+         else if (first != '#' && length > 41)
+         {
+            const auto sha = QString::fromLatin1(buffer.constData() + lineStart, 40);
+            const auto name = QString::fromUtf8(buffer.constData() + lineStart + 41, length - 41);
+
+            mPackedRefs.insert(name, sha);
+            lastRef = name;
+         }
+      }
+
+      lineStart = lineEnd + 1;
+   }
+
+   QLog_Debug("Git", QString("Packed-refs parsed with {%1} references.").arg(mPackedRefs.count()));
+}
+
+void GitRefsReader::loadLooseRefs(const QString &dirPath, const QString &prefix, QHash<QString, QString> &refs) const
+{
+   QDir dir(dirPath);
+
+   const auto entries = dir.entryInfoList(QDir::Files | QDir::Dirs | QDir::NoDotAndDotDot);
+
+   for (const auto &entry : entries)
+   {
+      const auto name = QString("%1/%2").arg(prefix, entry.fileName());
+
+      if (entry.isDir())
+         loadLooseRefs(entry.absoluteFilePath(), name, refs);
+      else
+      {
+         QFile file(entry.absoluteFilePath());
+
+         if (!file.open(QIODevice::ReadOnly))
+            continue;
+
+         const auto content = file.read(256).trimmed();
+
+         // Symbolic refs (ref: refs/heads/...) are not listed by show-ref either
+         if (content.length() == 40 && !content.startsWith("ref:"))
+            refs.insert(name, QString::fromLatin1(content));
+      }
+   }
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+#include <QDateTime>
+#include <QHash>
+#include <QString>
+#include <QVector>
+
+/*!
+ \brief Reads the repository references straight from .git/packed-refs and the loose refs
+ directory, replacing the git show-ref subprocess on every refresh. The packed file is parsed
+ once and revalidated by size and modification time, so a refresh where nothing was repacked
+ only rescans the loose files. Peeled tag entries from the packed file are reported with the
+ ^{} suffix, matching the show-ref -d output the reference loader expects.
+*/
+class GitRefsReader
+{
+public:
+   /*!
+    \brief A single reference: the target SHA and the full ref name (refs/heads/..., with the
+    ^{} suffix for peeled tags).
+   */
+   struct Reference
+   {
+      QString sha;
+      QString name;
+   };
+
+   /*!
+    \brief Creates the reader for the given .git directory.
+    \param gitDirPath The path to the .git directory.
+   */
+   explicit GitRefsReader(const QString &gitDirPath);
+
+   /*!
+    \brief Reads all the references, overlaying the loose files over the packed ones as git does.
+    \return The references, or an empty vector when the refs directory cannot be read.
+   */
+   QVector<Reference> readAll();
+
+private:
+   QString mGitDir;
+   QDateTime mPackedModified;
+   qint64 mPackedSize = -1;
+   QHash<QString, QString> mPackedRefs;
+   QHash<QString, QString> mPackedPeeled;
+
+   void reloadPackedRefs();
+   void loadLooseRefs(const QString &dirPath, const QString &prefix, QHash<QString, QString> &refs) const;
+};
@@ -81,9 +81,23 @@ bool GitRemote::fetch()
 
    GitQlientSettings settings(mGitBase->getGitDir());
    const auto pruneOnFetch = settings.localValue("PruneOnFetch", true).toBool();
+   const auto fetchTags = settings.localValue("FetchTags", true).toBool();
+   const auto prefixes = settings.localValue("FetchRefPrefixes", QString()).toString().split(',', Qt::SkipEmptyParts);
+
+   // Skipping the tags and narrowing the refspec to the tracked branch prefixes keeps the
+   // negotiation small on busy remotes: only the refs the user cares about are listed and
+   // transferred. --prune-tags is only valid when tags are fetched.
+   auto cmd = QString("git fetch %1 %2 --force %3")
+                  .arg(prefixes.isEmpty() ? QString("--all") : QString("origin"),
+                       fetchTags ? QString("--tags") : QString("--no-tags"),
+                       pruneOnFetch ? (fetchTags ? QString("--prune --prune-tags") : QString("--prune")) : QString());
+
+   for (const auto &prefix : prefixes)
+   {
+      if (const auto branch = prefix.trimmed(); !branch.isEmpty())
+         cmd.append(QString(" +refs/heads/%1*:refs/remotes/origin/%1*").arg(branch));
+   }
 
-   const auto cmd
-       = QString("git fetch --all --tags --force %1").arg(pruneOnFetch ? QString("--prune --prune-tags") : QString());
    const auto ret = mGitBase->run(cmd).success;
 
    return ret;
@@ -1,21 +1,82 @@
 #include "GitRepoLoader.h"
 
+#include <CommitGraphReader.h>
+#include <CommitGraphSnapshot.h>
 #include <GitBase.h>
 #include <GitBranches.h>
 #include <GitCache.h>
 #include <GitConfig.h>
 #include <GitLocal.h>
 #include <GitQlientSettings.h>
+#include <GitRefsReader.h>
 #include <GitRequestorProcess.h>
 #include <GitWip.h>
+#include <PerfProfiler.h>
+#include <TaskPool.h>
 
 #include <QLogger.h>
 
 #include <QDir>
+#include <QMutex>
+#include <QSet>
+#include <QtConcurrent>
+
+#include <cstring>
 
 using namespace QLogger;
 
-static const char *GIT_LOG_FORMAT("%m%HX%P%n%cn<%ce>%n%an<%ae>%n%at%n%s%n%b ");
+// The body (%b) is deliberately left out: it is the biggest contributor to the cache footprint
+// and is only shown for the selected commit, so it is fetched on demand through
+// GitBase::getCommitBody. The trailing space keeps the per-record field count stable.
+static const char *GIT_LOG_FORMAT("%m%HX%P%n%cn<%ce>%n%an<%ae>%n%at%n%s%n ");
+
+static constexpr auto FirstStreamedBatch = 5000;
+static constexpr auto ProgressiveWindow = 20000;
+
+static CommitInfo parseCommitData(const QByteArray &commitData, bool &isSubtree);
+
+namespace
+{
+/* A repository has a handful of distinct identities spread across every commit, so the committer
+ * and author strings are interned: the first occurrence enters the pool and every later one shares
+ * its allocation through QString's implicit sharing. The parse runs on several threads, hence the
+ * lock. */
+QString internIdentity(const QString &identity)
+{
+   static QMutex mutex;
+   static QSet<QString> pool;
+
+   QMutexLocker lock(&mutex);
+
+   const auto iter = pool.constFind(identity);
+
+   if (iter != pool.constEnd())
+      return *iter;
+
+   pool.insert(identity);
+
+   return identity;
+}
+
+struct ParsedCommitRecord
+{
+   CommitInfo commit;
+   bool isSubtree = false;
+};
+
+struct ParseCommitRecord
+{
+   using result_type = ParsedCommitRecord;
+
+   ParsedCommitRecord operator()(const QByteArray &commitData) const
+   {
+      ParsedCommitRecord record;
+      record.commit = parseCommitData(commitData, record.isSubtree);
+
+      return record;
+   }
+};
+}
 
 GitRepoLoader::GitRepoLoader(QSharedPointer<GitBase> gitBase, QSharedPointer<GitCache> cache,
                              const QSharedPointer<GitQlientSettings> &settings, QObject *parent)
@@ -39,7 +100,14 @@ bool GitRepoLoader::load()
 bool GitRepoLoader::load(bool refreshReferences)
 {
    if (mLocked)
-      QLog_Warning("Git", "Git is currently loading data.");
+   {
+      QLog_Warning("Git", "Git is currently loading data. Queuing the reload.");
+
+      // Requests that arrive while a load is in flight are merged into a single follow-up reload
+      // that keeps the widest requested scope.
+      mPendingReload = true;
+      mPendingRefreshReferences |= refreshReferences;
+   }
    else
    {
       mRefreshReferences = refreshReferences;
@@ -60,6 +128,11 @@ bool GitRepoLoader::load(bool refreshReferences)
 
             QLog_Info("Git", "Requesting revisions...");
 
+            startWipScan();
+
+            if (mRevCache->commitCount() == 0)
+               warmStartFromSnapshot();
+
             requestRevisions();
 
             return true;
@@ -72,6 +145,58 @@ bool GitRepoLoader::load(bool refreshReferences)
    return false;
 }
 
+void GitRepoLoader::refreshReferencesOnly()
+{
+   // A full load in flight reloads the references anyway.
+   if (mLocked)
+      return;
+
+   QLog_Debug("Git", "Refreshing only the references.");
+
+   loadReferences();
+
+   emit referencesReloaded();
+}
+
+void GitRepoLoader::refreshWipOnly()
+{
+   if (mLocked)
+      return;
+
+   QLog_Debug("Git", "Refreshing only the WIP.");
+
+   QScopedPointer<GitWip> git(new GitWip(mGitBase, mRevCache));
+   git->updateWip();
+
+   emit wipReloaded();
+}
+
+void GitRepoLoader::startWipScan()
+{
+   // The working-tree scan is independent from the log replay, so it runs on the task pool while
+   // the commits stream in and parse; the result is merged into the cache when both are done.
+   mWipFuture = QtConcurrent::run(TaskPool::instance()->pool(), [gitBase = mGitBase, cache = mRevCache]() {
+      QScopedPointer<GitWip> git(new GitWip(gitBase, cache));
+      git->updateUntrackedFiles();
+
+      return git->getWipInfo();
+   });
+}
+
+void GitRepoLoader::warmStartFromSnapshot()
+{
+   const auto commits = CommitGraphSnapshot(mGitBase->getGitDir()).load();
+
+   if (commits.isEmpty())
+      return;
+
+   QLog_Info("Git", "Warm-starting the history view from the graph snapshot.");
+
+   mRevCache->setup(mWipFuture.result(), commits);
+
+   emit signalLoadingFinished(false);
+}
+
 bool GitRepoLoader::configureRepoDirectory()
 {
    QLog_Debug("Git", "Configuring repository directory.");
@@ -93,16 +218,19 @@ void GitRepoLoader::loadReferences()
 {
    QLog_Debug("Git", "Loading references.");
 
-   const auto ret3 = mGitBase->run("git show-ref -d");
+   if (!mRefsReader)
+      mRefsReader = QSharedPointer<GitRefsReader>::create(mGitBase->getGitDir());
 
-   if (ret3.success)
-   {
-      auto ret = mGitBase->getLastCommit();
+   auto references = mRefsReader->readAll();
 
-      if (ret.success)
-         ret.output = ret.output.toString().trimmed();
+   // Worktrees and other layouts keep their refs outside the mapped .git directory; show-ref
+   // stays as the fallback when the direct read finds nothing.
+   if (references.isEmpty())
+   {
+      const auto ret3 = mGitBase->run("git show-ref -d");
 
-      QString prevRefSha;
+      if (!ret3.success)
+         return;
 
 #if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
       const auto referencesList = ret3.output.toString().split('\n', Qt::SkipEmptyParts);
@@ -110,52 +238,80 @@ void GitRepoLoader::loadReferences()
       const auto referencesList = ret3.output.toString().split('\n', QString::SkipEmptyParts);
 #endif
 
-      mRevCache->clearReferences();
+      references.reserve(referencesList.count());
 
       for (const auto &reference : referencesList)
-      {
-         const auto revSha = reference.left(40);
-         const auto refName = reference.mid(41);
+         references.append({ reference.left(40), reference.mid(41) });
+   }
 
-         if (!refName.startsWith("refs/tags/") || (refName.startsWith("refs/tags/") && refName.endsWith("^{}")))
-         {
-            References::Type type;
-            QString name;
+   mRevCache->clearReferences();
 
-            if (refName.startsWith("refs/tags/"))
-            {
-               type = References::Type::LocalTag;
-               name = refName.mid(10, reference.length());
-               name.remove("^{}");
-            }
-            else if (refName.startsWith("refs/heads/"))
-            {
-               type = References::Type::LocalBranch;
-               name = refName.mid(11);
-            }
-            else if (refName.startsWith("refs/remotes/") && !refName.endsWith("HEAD"))
-            {
-               type = References::Type::RemoteBranches;
-               name = refName.mid(13);
-            }
-            else
-               continue;
+   for (const auto &reference : qAsConst(references))
+   {
+      const auto &refName = reference.name;
+
+      if (!refName.startsWith("refs/tags/") || (refName.startsWith("refs/tags/") && refName.endsWith("^{}")))
+      {
+         References::Type type;
+         QString name;
 
-            mRevCache->insertReference(revSha, type, name);
+         if (refName.startsWith("refs/tags/"))
+         {
+            type = References::Type::LocalTag;
+            name = refName.mid(10);
+            name.remove("^{}");
+         }
+         else if (refName.startsWith("refs/heads/"))
+         {
+            type = References::Type::LocalBranch;
+            name = refName.mid(11);
          }
+         else if (refName.startsWith("refs/remotes/") && !refName.endsWith("HEAD"))
+         {
+            type = References::Type::RemoteBranches;
+            name = refName.mid(13);
+         }
+         else
+            continue;
 
-         prevRefSha = revSha;
+         mRevCache->insertReference(reference.sha, type, name);
       }
    }
+
+   // A single for-each-ref call brings the ahead/behind counters for every local branch
+   QScopedPointer<GitBranches> gitBranches(new GitBranches(mGitBase));
+   const auto trackingDistances = gitBranches->getTrackingDistances();
+
+   QMap<QString, GitCache::LocalBranchDistances> distances;
+
+   for (auto iter = trackingDistances.cbegin(); iter != trackingDistances.cend(); ++iter)
+      distances.insert(iter.key(), { iter.value().first, iter.value().second });
+
+   mRevCache->updateBranchDistances(distances);
 }
 
 void GitRepoLoader::requestRevisions()
 {
+   PerfScopedTimer timer("GitRepoLoader::requestRevisions", "git");
+
    QLog_Debug("Git", "Loading revisions.");
 
    const auto maxCommits = mSettings->localValue("MaxCommits", 0).toInt();
-   const auto commitsToRetrieve = maxCommits != 0 ? QString::fromUtf8("-n %1").arg(maxCommits)
-                                                  : mShowAll ? QString("--all") : mGitBase->getCurrentBranch();
+   // The superset of every branch is loaded once: the current-branch-only view is a reachability
+   // filter over the cached graph, so toggling it never replays the log
+   auto commitsToRetrieve = maxCommits != 0 ? QString::fromUtf8("-n %1").arg(maxCommits) : QString("--all");
+
+   QScopedPointer<GitConfig> gitConfig(new GitConfig(mGitBase));
+   const auto ret = gitConfig->getGitValue("log.showSignature");
+   const auto showSignature = ret.success ? ret.output.toString().contains("true") : false;
+
+   /* Progressive deepening of a full-history load: the first run only requests the newest window
+    * so the view becomes interactive immediately, and the whole log is replayed afterwards in the
+    * background, extending the graph with the older commits. */
+   mProgressivePrefix = !showSignature && maxCommits == 0 && !mDeepeningRun;
+
+   if (mProgressivePrefix)
+      commitsToRetrieve.prepend(QString("-n %1 ").arg(ProgressiveWindow));
 
    QString order;
 
@@ -180,15 +336,153 @@ void GitRepoLoader::requestRevisions()
 
    emit signalLoadingStarted();
 
-   const auto requestor = new GitRequestorProcess(mGitBase->getWorkingDir());
-   connect(requestor, &GitRequestorProcess::procDataReady, this, &GitRepoLoader::processRevision);
-   connect(this, &GitRepoLoader::cancelAllProcesses, requestor, &AGitProcess::onCancel);
+   if (showSignature)
+   {
+      const auto requestor = new GitRequestorProcess(mGitBase->getWorkingDir());
+      requestor->setPriority(GitExecPriority::Refresh);
+      connect(requestor, &GitRequestorProcess::procDataReady, this, &GitRepoLoader::processRevision);
+      connect(this, &GitRepoLoader::cancelAllProcesses, requestor, &AGitProcess::onCancel);
 
-   requestor->run(baseCmd);
+      requestor->run(baseCmd);
+   }
+   else
+   {
+      mStreamBuffer.clear();
+      mStreamedCommits.clear();
+      mStreamedSubtrees.clear();
+      // During the deepening run the view already shows the whole window, so the small first
+      // batch is skipped: delivering it would shrink the graph before regrowing it
+      mFirstBatchDelivered = mDeepeningRun;
+      mNextDeepeningDelivery = 2 * ProgressiveWindow;
+
+      // Repos maintained with git maintenance carry a commit-graph file that knows the exact
+      // commit count, so the streaming containers are sized once instead of growing chunk by
+      // chunk; the cache also keeps the reader to answer reachability queries from its
+      // topological levels.
+      const auto graphReader = QSharedPointer<CommitGraphReader>::create(mGitBase->getGitDir());
+
+      if (graphReader->isValid())
+      {
+         mStreamedCommits.reserve(graphReader->commitCount() + 1);
+         mRevCache->setCommitGraphReader(graphReader);
+      }
+
+      const auto requestor = new GitRequestorProcess(mGitBase->getWorkingDir(), true);
+      requestor->setPriority(GitExecPriority::Refresh);
+      connect(requestor, &GitRequestorProcess::procDataReady, this, &GitRepoLoader::processRevisionChunk);
+      connect(requestor, &GitRequestorProcess::procDataFinished, this, &GitRepoLoader::finishRevisionsStream);
+      connect(this, &GitRepoLoader::cancelAllProcesses, requestor, &AGitProcess::onCancel);
+
+      requestor->run(baseCmd);
+   }
+}
+
+void GitRepoLoader::processRevisionChunk(QByteArray chunk)
+{
+   mStreamBuffer.append(chunk);
+
+   const auto lastRecordEnd = mStreamBuffer.lastIndexOf('\000');
+
+   if (lastRecordEnd == -1)
+      return;
+
+   auto completeRecords = mStreamBuffer.left(lastRecordEnd);
+   mStreamBuffer.remove(0, lastRecordEnd + 1);
+
+   mStreamedCommits.append(processUnsignedLog(completeRecords, mStreamedSubtrees));
+
+   if (!mFirstBatchDelivered && mStreamedCommits.count() >= FirstStreamedBatch)
+      deliverStreamedBatch(false);
+   else if (mDeepeningRun && mStreamedCommits.count() >= mNextDeepeningDelivery)
+   {
+      // The deepening run extends the graph in window-sized batches, so search and graph grow
+      // while the rest of the history keeps streaming in
+      deliverStreamedBatch(false);
+
+      mNextDeepeningDelivery += ProgressiveWindow;
+   }
+}
+
+void GitRepoLoader::finishRevisionsStream()
+{
+   QLog_Info("Git", "Revisions stream finished!");
+
+   if (!mStreamBuffer.isEmpty())
+   {
+      mStreamedCommits.append(processUnsignedLog(mStreamBuffer, mStreamedSubtrees));
+      mStreamBuffer.clear();
+   }
+
+   // A completely filled window means older history remains, so the window is delivered as a
+   // partial result and the whole log is replayed to deepen the graph in the background
+   if (mProgressivePrefix && mStreamedCommits.count() >= ProgressiveWindow)
+   {
+      mProgressivePrefix = false;
+      mDeepeningRun = true;
+
+      deliverStreamedBatch(false);
+
+      mStreamedCommits.clear();
+      mStreamedSubtrees.clear();
+
+      requestRevisions();
+
+      return;
+   }
+
+   mProgressivePrefix = false;
+
+   deliverStreamedBatch(true);
+
+   mDeepeningRun = false;
+   mStreamedCommits.clear();
+   mStreamedSubtrees.clear();
+}
+
+void GitRepoLoader::deliverStreamedBatch(bool isFinal)
+{
+   QLog_Debug("Git",
+              QString("Delivering {%1} streamed revisions (%2).")
+                  .arg(QString::number(mStreamedCommits.count()), isFinal ? QString("final") : QString("partial")));
+
+   // The WIP scan was started together with the load and has been running concurrently with the
+   // parse, so this only waits for whatever remains of the slower stage
+   mRevCache->setup(mWipFuture.result(), mStreamedCommits);
+
+   if (isFinal)
+   {
+      QtConcurrent::run(TaskPool::instance()->pool(),
+                        [commits = mStreamedCommits, gitDir = mGitBase->getGitDir()]() {
+                           CommitGraphSnapshot(gitDir).save(commits);
+                        });
+
+      if (mRefreshReferences)
+         loadReferences();
+      else
+         mRevCache->reloadCurrentBranchInfo(mGitBase->getCurrentBranch(),
+                                            mGitBase->getLastCommit().output.toString().trimmed());
+
+      mRevCache->setConfigurationDone();
+
+      emit signalLoadingFinished(mRefreshReferences);
+
+      mLocked = false;
+      mRefreshReferences = false;
+
+      startPendingReload();
+   }
+   else
+   {
+      mFirstBatchDelivered = true;
+
+      emit signalLoadingFinished(false);
+   }
 }
 
 void GitRepoLoader::processRevision(QByteArray ba)
 {
+   PerfScopedTimer timer("GitRepoLoader::processRevision", "git");
+
    QLog_Info("Git", "Revisions received!");
 
    QScopedPointer<GitConfig> gitConfig(new GitConfig(mGitBase));
@@ -206,10 +500,10 @@ void GitRepoLoader::processRevision(QByteArray ba)
    const auto showSignature = ret.success ? ret.output.toString().contains("true") : false;
    const auto commits = showSignature ? processSignedLog(ba, subtrees) : processUnsignedLog(ba, subtrees);
 
-   QScopedPointer<GitWip> git(new GitWip(mGitBase, mRevCache));
-   git->updateUntrackedFiles();
+   mRevCache->setup(mWipFuture.result(), commits);
 
-   mRevCache->setup(git->getWipInfo(), commits);
+   QtConcurrent::run(TaskPool::instance()->pool(),
+                     [commits, gitDir = mGitBase->getGitDir()]() { CommitGraphSnapshot(gitDir).save(commits); });
 
    if (mRefreshReferences)
       loadReferences();
@@ -223,26 +517,66 @@ void GitRepoLoader::processRevision(QByteArray ba)
 
    mLocked = false;
    mRefreshReferences = false;
+
+   startPendingReload();
+}
+
+void GitRepoLoader::startPendingReload()
+{
+   if (!mPendingReload)
+      return;
+
+   mPendingReload = false;
+
+   const auto refreshReferences = mPendingRefreshReferences;
+   mPendingRefreshReferences = false;
+
+   load(refreshReferences);
 }
 
 QList<CommitInfo> GitRepoLoader::processUnsignedLog(QByteArray &log, QList<QPair<QString, QString>> &subtrees)
 {
+   PerfScopedTimer timer("GitRepoLoader::processUnsignedLog", "git");
+
+   // The record boundaries are located with memchr, which the C runtime vectorizes for the target
+   // (SSE2 on x86, NEON on ARM), and every record is a fromRawData view over the buffer, so the
+   // split is a single scan instead of one allocation and copy per commit. The views only stay
+   // valid while the log buffer lives, which the blocking parse below guarantees.
+   QVector<QByteArray> commitsLog;
+   commitsLog.reserve(log.size() / 256 + 1);
+
+   const auto data = log.constData();
+   const auto size = log.size();
+
+   for (auto pos = 0; pos < size;)
+   {
+      const auto nul = static_cast<const char *>(std::memchr(data + pos, '\0', size - pos));
+      const auto end = nul ? static_cast<int>(nul - data) : size;
+
+      commitsLog.append(QByteArray::fromRawData(data + pos, end - pos));
+
+      pos = end + 1;
+   }
+
+   // Every record is independent, so the parse is partitioned across the global
+   // thread pool and the results are merged back keeping the log order.
+   auto parsed = QtConcurrent::blockingMapped<QVector<ParsedCommitRecord>>(commitsLog, ParseCommitRecord());
+
    QList<CommitInfo> commits;
-   auto commitsLog = log.split('\000');
+   commits.reserve(parsed.count());
 
-   for (auto &commitData : commitsLog)
+   for (auto &record : parsed)
    {
-      bool subtree = false;
-      if (auto commit = parseCommitData(commitData, subtree); commit.isValid())
+      if (record.commit.isValid())
       {
-         commits.append(std::move(commit));
-
-         if (subtree)
+         if (record.isSubtree)
          {
-            auto fields = commit.longLog().trimmed().split("\n");
-            subtrees.append(qMakePair(fields.first().remove("git-subtree-dir:").trimmed(),
-                                      fields.last().remove("git-subtree-split:").trimmed()));
+            const auto fields = record.commit.longLog().trimmed().split("\n");
+            subtrees.append(qMakePair(QString(fields.first()).remove("git-subtree-dir:").trimmed(),
+                                      QString(fields.last()).remove("git-subtree-split:").trimmed()));
          }
+
+         commits.append(std::move(record.commit));
       }
    }
 
@@ -308,40 +642,81 @@ QList<CommitInfo> GitRepoLoader::processSignedLog(QByteArray &log, QList<QPair<Q
    return commits;
 }
 
-CommitInfo GitRepoLoader::parseCommitData(QByteArray &commitData, bool &isSubtree) const
+static CommitInfo parseCommitData(const QByteArray &commitData, bool &isSubtree)
 {
-   if (const auto fields = QString::fromUtf8(commitData).split('\n'); fields.count() > 6)
+   // The record is parsed over the raw log buffer: the line boundaries are located once and every
+   // field is sliced through fromRawData, so a QString is only materialized for the values that
+   // CommitInfo actually stores.
+   QVarLengthArray<int, 8> lineStart;
+   lineStart.append(0);
+
+   const auto dataSize = commitData.size();
+
+   for (auto i = 0; i < dataSize && lineStart.count() < 7; ++i)
    {
-      const auto firstField = fields.constFirst();
-      const auto isSigned = !fields.first().isEmpty() && !firstField.contains("log size") ? true : false;
-      auto combinedShas = fields.at(1);
-      auto commitSha = combinedShas.split('X').first();
-      const auto boundary = commitSha[0];
-      const auto sha = commitSha.remove(0, 1);
-      combinedShas = combinedShas.remove(0, sha.size() + 1 + 1).trimmed();
-      QStringList parentsSha;
-#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
-      parentsSha = combinedShas.split(' ', Qt::SkipEmptyParts);
-#else
-      parentsSha = combinedShas.split(' ', QString::SkipEmptyParts);
-#endif
-      const auto committer = fields.at(2);
-      const auto author = fields.at(3);
-      const auto commitDate = QDateTime::fromSecsSinceEpoch(fields.at(4).toInt());
-      const auto shortLog = fields.at(5);
-      QString longLog;
+      if (commitData.at(i) == '\n')
+         lineStart.append(i + 1);
+   }
+
+   if (lineStart.count() <= 6)
+      return CommitInfo();
+
+   const auto lineAt = [&commitData, &lineStart, dataSize](int line) {
+      const auto start = lineStart.at(line);
+      const auto end = line + 1 < lineStart.count() ? lineStart.at(line + 1) - 1 : dataSize;
+
+      return QByteArray::fromRawData(commitData.constData() + start, end - start);
+   };
+
+   const auto signatureLine = lineAt(0);
+   const auto isSigned = !signatureLine.isEmpty() && !signatureLine.contains("log size");
+
+   const auto shasLine = lineAt(1);
+   const auto shaEnd = shasLine.indexOf('X');
+
+   if (shasLine.count() < 2 || shaEnd < 1)
+      return CommitInfo();
+
+   const auto boundary = QChar(QLatin1Char(shasLine.at(0)));
+   const auto sha = QString::fromUtf8(shasLine.constData() + 1, shaEnd - 1);
+
+   QStringList parentsSha;
+   const auto shasLineSize = shasLine.size();
+
+   for (auto pos = shaEnd + 1; pos < shasLineSize;)
+   {
+      while (pos < shasLineSize && (shasLine.at(pos) == ' ' || shasLine.at(pos) == '\r'))
+         ++pos;
 
-      for (auto i = 6; i < fields.count(); ++i)
-         longLog += fields.at(i) + '\n';
+      auto tokenEnd = pos;
 
-      longLog = longLog.trimmed();
+      while (tokenEnd < shasLineSize && shasLine.at(tokenEnd) != ' ' && shasLine.at(tokenEnd) != '\r')
+         ++tokenEnd;
 
-      if (longLog.contains("git-subtree-dir") || shortLog.contains("git-subtree-dir"))
-         isSubtree = true;
+      if (tokenEnd > pos)
+         parentsSha.append(QString::fromUtf8(shasLine.constData() + pos, tokenEnd - pos));
 
-      return CommitInfo { sha,    parentsSha, boundary, committer, commitDate,
-                          author, shortLog,   longLog,  isSigned,  isSigned ? firstField : QString() };
+      pos = tokenEnd;
    }
 
-   return CommitInfo();
+   const auto committer = internIdentity(QString::fromUtf8(lineAt(2)));
+   const auto author = internIdentity(QString::fromUtf8(lineAt(3)));
+   const auto commitDate = lineAt(4).toLongLong();
+   const auto shortLogData = lineAt(5);
+   const auto longLogData
+       = QByteArray::fromRawData(commitData.constData() + lineStart.at(6), dataSize - lineStart.at(6));
+
+   if (longLogData.contains("git-subtree-dir") || shortLogData.contains("git-subtree-dir"))
+      isSubtree = true;
+
+   return CommitInfo { sha,
+                       parentsSha,
+                       boundary,
+                       committer,
+                       commitDate,
+                       author,
+                       QString::fromUtf8(shortLogData),
+                       QString::fromUtf8(longLogData).trimmed(),
+                       isSigned,
+                       isSigned ? QString::fromUtf8(signatureLine) : QString() };
 }
@@ -25,14 +25,16 @@
 
 #include <CommitInfo.h>
 #include <GitExecResult.h>
+#include <WipRevisionInfo.h>
 
+#include <QFuture>
 #include <QObject>
 #include <QSharedPointer>
 #include <QVector>
 
 class GitBase;
 class GitCache;
-struct WipRevisionInfo;
+class GitRefsReader;
 class GitQlientSettings;
 
 class GitRepoLoader : public QObject
@@ -42,31 +44,70 @@ class GitRepoLoader : public QObject
 signals:
    void signalLoadingStarted();
    void signalLoadingFinished(bool full);
+   /**
+    * @brief referencesReloaded Signal triggered when a references-only refresh finishes.
+    */
+   void referencesReloaded();
+   /**
+    * @brief wipReloaded Signal triggered when a WIP-only refresh finishes.
+    */
+   void wipReloaded();
    void cancelAllProcesses(QPrivateSignal);
 
 public slots:
    bool load(bool refreshReferences);
+   /**
+    * @brief refreshReferencesOnly Reloads only the references in the cache. Operations like creating a tag or a
+    * branch don't change the log, so replaying it is not needed: a single show-ref pass updates every reference.
+    */
+   void refreshReferencesOnly();
+   /**
+    * @brief refreshWipOnly Updates only the WIP revision in the cache, leaving log and references untouched.
+    */
+   void refreshWipOnly();
 
 public:
    explicit GitRepoLoader(QSharedPointer<GitBase> gitBase, QSharedPointer<GitCache> cache,
                           const QSharedPointer<GitQlientSettings> &settings, QObject *parent = nullptr);
    void cancelAll();
-   void setShowAll(bool showAll = true) { mShowAll = showAll; }
    bool load();
 
 private:
-   bool mShowAll = true;
+   friend class GitQlientBench;
+
    bool mLocked = false;
    bool mRefreshReferences = true;
+   bool mPendingReload = false;
+   bool mPendingRefreshReferences = false;
    QSharedPointer<GitBase> mGitBase;
    QSharedPointer<GitCache> mRevCache;
    QSharedPointer<GitQlientSettings> mSettings;
+   QSharedPointer<GitRefsReader> mRefsReader;
+
+   QByteArray mStreamBuffer;
+   QList<CommitInfo> mStreamedCommits;
+   QList<QPair<QString, QString>> mStreamedSubtrees;
+   bool mFirstBatchDelivered = false;
+   /* Progressive deepening: a full-history load first requests a window with the newest commits
+    * for immediate interactivity and then replays the whole log in the background. The first flag
+    * marks the windowed run, the second the follow-up full run. */
+   bool mProgressivePrefix = false;
+   bool mDeepeningRun = false;
+   int mNextDeepeningDelivery = 0;
+   /* The working-tree scan runs concurrently with the log parse; the future is consumed when the
+    * commits are ready, so only the slower of the two stages bounds the refresh latency. */
+   QFuture<WipRevisionInfo> mWipFuture;
 
    bool configureRepoDirectory();
+   void startWipScan();
+   void warmStartFromSnapshot();
    void loadReferences();
    void requestRevisions();
    void processRevision(QByteArray ba);
+   void processRevisionChunk(QByteArray chunk);
+   void finishRevisionsStream();
+   void deliverStreamedBatch(bool isFinal);
+   void startPendingReload();
    QList<CommitInfo> processUnsignedLog(QByteArray &log, QList<QPair<QString, QString>> &subtrees);
    QList<CommitInfo> processSignedLog(QByteArray &log, QList<QPair<QString, QString>> &subtrees) const;
-   CommitInfo parseCommitData(QByteArray &commitData, bool &isSubtree) const;
 };
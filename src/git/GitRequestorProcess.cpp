@@ -1,8 +1,9 @@
 #include "GitRequestorProcess.h"
 
 #include <QTemporaryFile>
-GitRequestorProcess::GitRequestorProcess(const QString &workingDir)
+GitRequestorProcess::GitRequestorProcess(const QString &workingDir, bool streaming)
    : AGitProcess(workingDir)
+   , mStreaming(streaming)
 {
 }
 
@@ -10,26 +11,47 @@ GitExecResult GitRequestorProcess::run(const QString &command)
 {
    auto ret = false;
 
-   // Create temporary file
-   mTempFile = new QTemporaryFile(this);
-
-   if (mTempFile->open()) // to read the file name
+   if (mStreaming)
    {
-      setStandardOutputFile(mTempFile->fileName());
-      mTempFile->close();
-
+      // The base class emits procDataReady for every chunk read from stdout
       ret = execute(command);
    }
+   else
+   {
+      // Create temporary file
+      mTempFile = new QTemporaryFile(this);
+
+      if (mTempFile->open()) // to read the file name
+      {
+         setStandardOutputFile(mTempFile->fileName());
+         mTempFile->close();
+
+         ret = execute(command);
+      }
+   }
 
    return { ret, "" };
 }
 
 void GitRequestorProcess::onFinished(int, QProcess::ExitStatus)
 {
-   bool ok = mTempFile && (mTempFile->isOpen() || (mTempFile->exists() && mTempFile->open()));
+   if (mStreaming)
+   {
+      if (!mCanceling)
+      {
+         if (const auto remaining = readAllStandardOutput(); !remaining.isEmpty())
+            emit procDataReady(remaining);
 
-   if (ok && !mCanceling)
-      emit procDataReady(mTempFile->readAll());
+         emit procDataFinished();
+      }
+   }
+   else
+   {
+      bool ok = mTempFile && (mTempFile->isOpen() || (mTempFile->exists() && mTempFile->open()));
+
+      if (ok && !mCanceling)
+         emit procDataReady(mTempFile->readAll());
+   }
 
    deleteLater();
 }
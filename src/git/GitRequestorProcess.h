@@ -29,8 +29,13 @@ class QTemporaryFile;
 
 class GitRequestorProcess : public AGitProcess
 {
+   Q_OBJECT
+
+signals:
+   void procDataFinished();
+
 public:
-   explicit GitRequestorProcess(const QString &workingDir);
+   explicit GitRequestorProcess(const QString &workingDir, bool streaming = false);
    GitExecResult run(const QString &command) override;
 
 private:
@@ -38,4 +43,5 @@ private:
 
 private:
    QTemporaryFile *mTempFile = nullptr;
+   bool mStreaming = false;
 };
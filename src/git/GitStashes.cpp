@@ -4,8 +4,57 @@
 
 #include <QLogger.h>
 
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+
 using namespace QLogger;
 
+namespace
+{
+/* GitStashes instances are created on demand, so the parsed stash list is shared per repository
+   and revalidated against the stash reflog instead of spawning `git stash list` on every
+   panel refresh. */
+struct StashSnapshot
+{
+   QVector<QString> stashes;
+   QDateTime reflogModified;
+   qint64 reflogSize = 0;
+   bool loaded = false;
+};
+
+QHash<QString, StashSnapshot> stashSnapshots;
+QMutex stashSnapshotsMutex;
+
+/* The stash reflog lives in the common dir; linked worktrees point to it through the commondir
+   file of their private git dir. */
+QString stashReflogPath(const QString &gitDir)
+{
+   auto commonDir = gitDir;
+
+   QFile commonFile(gitDir + "/commondir");
+
+   if (commonFile.open(QIODevice::ReadOnly))
+   {
+      const auto path = QString::fromUtf8(commonFile.readLine()).trimmed();
+      commonDir = QDir::isAbsolutePath(path) ? path : QDir::cleanPath(gitDir + "/" + path);
+   }
+
+   return commonDir + "/logs/refs/stash";
+}
+
+void invalidateStashSnapshot(const QString &gitDir)
+{
+   QMutexLocker lock(&stashSnapshotsMutex);
+
+   stashSnapshots.remove(gitDir);
+}
+}
+
 GitStashes::GitStashes(const QSharedPointer<GitBase> &gitBase)
    : mGitBase(gitBase)
 {
@@ -15,6 +64,25 @@ QVector<QString> GitStashes::getStashes()
 {
    QLog_Debug("Git", QString("Getting stashes"));
 
+   const auto gitDir = mGitBase->getGitDir();
+   const QFileInfo reflog(stashReflogPath(gitDir));
+
+   /* Git keeps a reflog for refs/stash whenever stashes exist, so a missing reflog means there
+      is nothing to list. */
+   if (!reflog.exists())
+      return {};
+
+   {
+      QMutexLocker lock(&stashSnapshotsMutex);
+      const auto snapshot = stashSnapshots.constFind(gitDir);
+
+      if (snapshot != stashSnapshots.cend() && snapshot->loaded && snapshot->reflogModified == reflog.lastModified()
+          && snapshot->reflogSize == reflog.size())
+      {
+         return snapshot->stashes;
+      }
+   }
+
    const auto cmd = QString("git stash list");
 
    QLog_Trace("Git", QString("Getting stashes: {%1}").arg(cmd));
@@ -30,6 +98,13 @@ QVector<QString> GitStashes::getStashes()
       for (const auto &tag : tagsTmp)
          if (tag != "\n" && !tag.isEmpty())
             stashes.append(tag);
+
+      QMutexLocker lock(&stashSnapshotsMutex);
+      auto &snapshot = stashSnapshots[gitDir];
+      snapshot.stashes = stashes;
+      snapshot.reflogModified = reflog.lastModified();
+      snapshot.reflogSize = reflog.size();
+      snapshot.loaded = true;
    }
 
    return stashes;
@@ -45,6 +120,8 @@ GitExecResult GitStashes::pop() const
 
    const auto ret = mGitBase->run(cmd);
 
+   invalidateStashSnapshot(mGitBase->getGitDir());
+
    return ret;
 }
 
@@ -58,6 +135,8 @@ GitExecResult GitStashes::stash()
 
    const auto ret = mGitBase->run(cmd);
 
+   invalidateStashSnapshot(mGitBase->getGitDir());
+
    return ret;
 }
 
@@ -71,6 +150,8 @@ GitExecResult GitStashes::stashBranch(const QString &stashId, const QString &bra
 
    const auto ret = mGitBase->run(cmd);
 
+   invalidateStashSnapshot(mGitBase->getGitDir());
+
    return ret;
 }
 
@@ -84,6 +165,8 @@ GitExecResult GitStashes::stashDrop(const QString &stashId)
 
    const auto ret = mGitBase->run(cmd);
 
+   invalidateStashSnapshot(mGitBase->getGitDir());
+
    return ret;
 }
 
@@ -97,5 +180,7 @@ GitExecResult GitStashes::stashClear()
 
    const auto ret = mGitBase->run(cmd);
 
+   invalidateStashSnapshot(mGitBase->getGitDir());
+
    return ret;
 }
@@ -3,13 +3,32 @@
 #include <GitBase.h>
 #include <QLogger.h>
 
+#include <QDateTime>
 #include <QFile>
+#include <QFileInfo>
+#include <QHash>
 #include <QTemporaryFile>
 #include <QTextStream>
 #include <QVector>
 
 using namespace QLogger;
 
+namespace
+{
+struct SubmodulesCacheEntry
+{
+   QDateTime lastModified;
+   QVector<QString> submodules;
+};
+
+QHash<QString, SubmodulesCacheEntry> &submodulesCache()
+{
+   static QHash<QString, SubmodulesCacheEntry> cache;
+
+   return cache;
+}
+}
+
 GitSubmodules::GitSubmodules(const QSharedPointer<GitBase> &gitBase)
    : mGitBase(gitBase)
 {
@@ -19,6 +38,16 @@ QVector<QString> GitSubmodules::getSubmodules()
 {
    QLog_Debug("Git", QString("Getting submodules"));
 
+   // The list only changes when .gitmodules does, so it is memoized per repository keyed by the
+   // file's modification time and repeated refreshes don't spawn a git process at all.
+   const auto workingDir = mGitBase->getWorkingDir();
+   const auto lastModified = QFileInfo(QString("%1/.gitmodules").arg(workingDir)).lastModified();
+
+   auto &cache = submodulesCache();
+
+   if (const auto iter = cache.constFind(workingDir); iter != cache.constEnd() && iter->lastModified == lastModified)
+      return iter->submodules;
+
    const auto cmd = QString("git config --file .gitmodules --name-only --get-regexp path");
 
    QLog_Trace("Git", QString("Getting submodules: {%1}").arg(cmd));
@@ -36,6 +65,8 @@ QVector<QString> GitSubmodules::getSubmodules()
       }
    }
 
+   cache.insert(workingDir, { lastModified, submodulesList });
+
    return submodulesList;
 }
 
@@ -4,8 +4,19 @@
 #include <GitTags.h>
 #include <QLogger.h>
 
+#include <QMutex>
+
 using namespace QLogger;
 
+namespace
+{
+/* Remote tag listings keyed by remote URL, shared by every GitTags instance. ls-remote pays WAN
+   latency, so refresh flows are served from here and the network is only queried after a fetch or
+   on an explicit refresh. */
+QMutex remoteTagsMutex;
+QHash<QString, QMap<QString, QString>> remoteTagsCache;
+}
+
 GitTags::GitTags(const QSharedPointer<GitBase> &gitBase)
    : mGitBase(gitBase)
 {
@@ -17,7 +28,33 @@ GitTags::GitTags(const QSharedPointer<GitBase> &gitBase, const QSharedPointer<Gi
 {
 }
 
-bool GitTags::getRemoteTags() const
+bool GitTags::getRemoteTags()
+{
+   if (!mCache.get())
+   {
+      QLog_Fatal("Git", QString("Getting remote tages without cache."));
+      assert(mCache.get());
+   }
+
+   const auto url = getRemoteUrl();
+
+   {
+      QMutexLocker lock(&remoteTagsMutex);
+
+      if (const auto iter = remoteTagsCache.constFind(url); iter != remoteTagsCache.cend())
+      {
+         QLog_Debug("Git", QString("Serving the remote tags from the cache."));
+
+         mCache->updateTags(iter.value());
+
+         return true;
+      }
+   }
+
+   return refreshRemoteTags();
+}
+
+bool GitTags::refreshRemoteTags()
 {
    if (!mCache.get())
    {
@@ -31,7 +68,10 @@ bool GitTags::getRemoteTags() const
 
    QLog_Trace("Git", QString("Getting remote tags: {%1}").arg(cmd));
 
+   mRemoteUrl = getRemoteUrl();
+
    const auto p = new GitAsyncProcess(mGitBase->getWorkingDir());
+   p->setPriority(GitExecPriority::Background);
    connect(p, &GitAsyncProcess::signalDataReady, this, &GitTags::onRemoteTagsRecieved);
 
    const auto ret = p->run(cmd);
@@ -39,6 +79,11 @@ bool GitTags::getRemoteTags() const
    return ret.success;
 }
 
+QString GitTags::getRemoteUrl() const
+{
+   return mGitBase->run("git ls-remote --get-url").output.toString().trimmed();
+}
+
 GitExecResult GitTags::addTag(const QString &tagName, const QString &tagMessage, const QString &sha)
 {
    QLog_Debug("Git", QString("Adding a tag: {%1}").arg(tagName));
@@ -118,12 +163,17 @@ void GitTags::onRemoteTagsRecieved(GitExecResult result)
       {
          if (tag != "\n" && !tag.isEmpty() && tag.contains("^{}"))
          {
-            const auto sha = tag.split('\t').constFirst();
-            const auto tagName = tag.split('\t').last().remove("refs/tags/").remove("^{}");
+            const auto fields = tag.split('\t');
+            const auto tagName = QString(fields.constLast()).remove("refs/tags/").remove("^{}");
 
-            tags.insert(tagName, sha);
+            tags.insert(tagName, fields.constFirst());
          }
       }
+
+      // Only a successful listing renews the cached set, so a transient network error does not
+      // erase the last known remote tags
+      QMutexLocker lock(&remoteTagsMutex);
+      remoteTagsCache.insert(mRemoteUrl, tags);
    }
 
    mCache->updateTags(tags);
@@ -40,7 +40,19 @@ public:
    explicit GitTags(const QSharedPointer<GitBase> &gitBase);
    explicit GitTags(const QSharedPointer<GitBase> &gitBase, const QSharedPointer<GitCache> &cache);
 
-   bool getRemoteTags() const;
+   /**
+    * @brief getRemoteTags Publishes the remote tags into the cache. The listing is served from a
+    * per-URL memory cache shared by all instances, so refresh flows never wait on the network;
+    * only the very first call for a remote starts a background listing.
+    * @return True if the listing could be served or started.
+    */
+   bool getRemoteTags();
+   /**
+    * @brief refreshRemoteTags Re-lists the remote tags over the network on a background process
+    * and renews the per-URL cache. Meant to run after a fetch or on an explicit user request.
+    * @return True if the background process started.
+    */
+   bool refreshRemoteTags();
    GitExecResult addTag(const QString &tagName, const QString &tagMessage, const QString &sha);
    GitExecResult removeTag(const QString &tagName, bool remote);
    GitExecResult pushTag(const QString &tagName);
@@ -49,6 +61,8 @@ public:
 private:
    QSharedPointer<GitBase> mGitBase;
    QSharedPointer<GitCache> mCache;
+   QString mRemoteUrl;
 
+   QString getRemoteUrl() const;
    void onRemoteTagsRecieved(GitExecResult result);
 };
@@ -0,0 +1,72 @@
+#include <GitTree.h>
+
+#include <GitBase.h>
+
+#include <QLogger.h>
+
+#include <algorithm>
+
+using namespace QLogger;
+
+GitTree::GitTree(const QSharedPointer<GitBase> &gitBase)
+   : mGitBase(gitBase)
+{
+}
+
+QString GitTree::getCommitTreeOid(const QString &sha) const
+{
+   QLog_Trace("Git", QString("Resolving the root tree of the commit: {%1}").arg(sha));
+
+   const auto ret = mGitBase->run(QString("git rev-parse %1^{tree}").arg(sha));
+
+   return ret.success ? ret.output.toString().trimmed() : QString();
+}
+
+QVector<GitTree::TreeEntry> GitTree::getTreeEntries(const QString &treeOid) const
+{
+   QLog_Trace("Git", QString("Listing the entries of the tree: {%1}").arg(treeOid));
+
+   const auto ret = mGitBase->run(QString("git ls-tree %1").arg(treeOid));
+
+   QVector<TreeEntry> entries;
+
+   if (!ret.success)
+      return entries;
+
+#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
+   const auto lines = ret.output.toString().split('\n', Qt::SkipEmptyParts);
+#else
+   const auto lines = ret.output.toString().split('\n', QString::SkipEmptyParts);
+#endif
+
+   entries.reserve(lines.count());
+
+   for (const auto &line : lines)
+   {
+      // Each line is formatted as: <mode> <type> <oid>\t<name>
+      const auto tabPos = line.indexOf('\t');
+
+      if (tabPos == -1)
+         continue;
+
+      const auto metadata = line.left(tabPos).split(' ');
+
+      if (metadata.count() < 3)
+         continue;
+
+      TreeEntry entry;
+      entry.name = line.mid(tabPos + 1);
+      entry.oid = metadata.at(2);
+      entry.isDir = metadata.at(1) == "tree";
+      entries.append(entry);
+   }
+
+   std::sort(entries.begin(), entries.end(), [](const TreeEntry &l, const TreeEntry &r) {
+      if (l.isDir != r.isDir)
+         return l.isDir;
+
+      return l.name.compare(r.name, Qt::CaseInsensitive) < 0;
+   });
+
+   return entries;
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+#include <QSharedPointer>
+#include <QString>
+#include <QVector>
+
+class GitBase;
+
+/**
+ * @brief The GitTree class exposes the tree objects of the repository. A commit snapshot is
+ * browsed one directory per call through @ref getTreeEntries, so listing never pays for more of
+ * the tree than the directory being looked at.
+ */
+class GitTree
+{
+public:
+   /**
+    * @brief The TreeEntry struct represents one entry of a tree object listing.
+    */
+   struct TreeEntry
+   {
+      QString name;
+      QString oid;
+      bool isDir = false;
+   };
+
+   explicit GitTree(const QSharedPointer<GitBase> &gitBase);
+
+   /**
+    * @brief getCommitTreeOid Resolves the oid of the root tree of the given commit.
+    * @param sha The commit sha.
+    * @return The tree oid or an empty string when the commit cannot be resolved.
+    */
+   QString getCommitTreeOid(const QString &sha) const;
+   /**
+    * @brief getTreeEntries Lists the direct entries of the given tree object, directories first.
+    * @param treeOid The oid of the tree to list.
+    * @return The entries of the tree.
+    */
+   QVector<TreeEntry> getTreeEntries(const QString &treeOid) const;
+
+private:
+   QSharedPointer<GitBase> mGitBase;
+};
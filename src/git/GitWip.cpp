@@ -2,13 +2,27 @@
 
 #include <GitBase.h>
 #include <GitCache.h>
+#include <GitConfig.h>
 
 #include <QLogger.h>
 
+#include <QDir>
 #include <QFile>
+#include <QHash>
+#include <QScopedPointer>
 
 using namespace QLogger;
 
+namespace
+{
+QHash<QString, bool> &untrackedCacheSupport()
+{
+   static QHash<QString, bool> support;
+
+   return support;
+}
+}
+
 GitWip::GitWip(const QSharedPointer<GitBase> &git, const QSharedPointer<GitCache> &cache)
    : mGit(git)
    , mCache(cache)
@@ -20,10 +34,91 @@ void GitWip::updateUntrackedFiles() const
    mCache->setUntrackedFilesList(getUntrackedFiles());
 }
 
-QVector<QString> GitWip::getUntrackedFiles() const
+void GitWip::updateUntrackedFiles(const QStringList &dirtyDirectories) const
+{
+   QDir workingDir(mGit->getWorkingDir());
+   QStringList relativeDirs;
+
+   for (const auto &dir : dirtyDirectories)
+   {
+      const auto relative = workingDir.relativeFilePath(dir);
+
+      // A change in the root of the working dir cannot be scoped since its pathspec matches the
+      // whole tree, so it falls back to a full scan.
+      if (relative.isEmpty() || relative == QString("."))
+      {
+         updateUntrackedFiles();
+         return;
+      }
+
+      relativeDirs.append(relative);
+   }
+
+   if (relativeDirs.isEmpty())
+   {
+      updateUntrackedFiles();
+      return;
+   }
+
+   // Only the directories reported as changed are re-scanned: the entries under them are
+   // replaced while the untracked files of the rest of the tree are kept from the cache.
+   auto untracked = mCache->getUntrackedFiles();
+
+   for (auto i = untracked.count() - 1; i >= 0; --i)
+   {
+      for (const auto &dir : qAsConst(relativeDirs))
+      {
+         if (untracked.at(i).startsWith(dir + QString("/")))
+         {
+            untracked.remove(i);
+            break;
+         }
+      }
+   }
+
+   untracked += getUntrackedFiles(relativeDirs);
+
+   mCache->setUntrackedFilesList(untracked);
+}
+
+QVector<QString> GitWip::getUntrackedFiles(const QStringList &dirtyDirectories) const
 {
    QLog_Debug("Git", QString("Executing getUntrackedFiles."));
 
+   // git status consults the untracked-cache and fsmonitor extensions while ls-files rescans the
+   // tree, so when either is enabled the scan goes through status and git itself skips the
+   // directories that did not change since the last pass.
+   if (useStatusForUntracked())
+   {
+      auto statusCmd = QString("git status --porcelain --untracked-files=all");
+
+      if (!dirtyDirectories.isEmpty())
+      {
+         statusCmd.append(" --");
+
+         for (const auto &dir : dirtyDirectories)
+            statusCmd.append(QString(" $%1$").arg(dir));
+      }
+
+      if (const auto ret = mGit->run(statusCmd); ret.success)
+      {
+#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
+         const auto lines = ret.output.toString().split('\n', Qt::SkipEmptyParts);
+#else
+         const auto lines = ret.output.toString().split('\n', QString::SkipEmptyParts);
+#endif
+         QVector<QString> files;
+
+         for (const auto &line : lines)
+         {
+            if (line.startsWith("?? "))
+               files.append(line.mid(3));
+         }
+
+         return files;
+      }
+   }
+
    auto runCmd = QString("git ls-files --others");
    const auto exFile = QString("info/exclude");
    const auto path = QString("%1/%2").arg(mGit->getGitDir(), exFile);
@@ -33,6 +128,14 @@ QVector<QString> GitWip::getUntrackedFiles() const
 
    runCmd.append(QString(" --exclude-per-directory=$%1$").arg(".gitignore"));
 
+   if (!dirtyDirectories.isEmpty())
+   {
+      runCmd.append(" --");
+
+      for (const auto &dir : dirtyDirectories)
+         runCmd.append(QString(" $%1$").arg(dir));
+   }
+
 #if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
    const auto ret = mGit->run(runCmd).output.toString().split('\n', Qt::SkipEmptyParts).toVector();
 #else
@@ -79,3 +182,57 @@ bool GitWip::updateWip() const
 
    return false;
 }
+
+bool GitWip::updateWipForFile(const QString &file) const
+{
+   QLog_Debug("Git", QString("Executing updateWipForFile for {%1}.").arg(file));
+
+   const auto wip = mCache->commitInfo(CommitInfo::ZERO_SHA);
+   const auto parentSha = wip.parentsCount() > 0 ? wip.parent(0) : QString();
+
+   if (parentSha.isEmpty())
+      return updateWip();
+
+   // Both diffs are scoped to the touched file, so the cost of the refresh is independent of the
+   // size of the working tree
+   const auto ret = mGit->run(QString("git diff-index %1 -- $%2$").arg(parentSha, file));
+   const auto retCached = mGit->run(QString("git diff-index --cached %1 -- $%2$").arg(parentSha, file));
+
+   if (!ret.success || !retCached.success)
+      return updateWip();
+
+   return mCache->updateWipFileStatus(file, ret.output.toString(), retCached.output.toString());
+}
+
+bool GitWip::useStatusForUntracked() const
+{
+   auto &support = untrackedCacheSupport();
+   const auto gitDir = mGit->getGitDir();
+
+   if (const auto iter = support.constFind(gitDir); iter != support.constEnd())
+      return iter.value();
+
+   // The config is only probed once per repository, since spawning two git config calls per
+   // refresh would defeat the purpose of the cache.
+   QScopedPointer<GitConfig> git(new GitConfig(mGit));
+   const auto untrackedCache = git->getGitValue("core.untrackedCache").output.toString().trimmed();
+   const auto fsmonitor = git->getGitValue("core.fsmonitor").output.toString().trimmed();
+
+   const auto enabled = untrackedCache.startsWith("true") || !fsmonitor.isEmpty();
+   support.insert(gitDir, enabled);
+
+   return enabled;
+}
+
+bool GitWip::updateWip(const QStringList &dirtyDirectories) const
+{
+   if (dirtyDirectories.isEmpty())
+      return updateWip();
+
+   updateUntrackedFiles(dirtyDirectories);
+
+   if (const auto wipInfo = getWipInfo(); wipInfo.isValid())
+      return mCache->updateWipCommit(wipInfo);
+
+   return false;
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <QSharedPointer>
+#include <QStringList>
 
 #include <WipRevisionInfo.h>
 
@@ -13,12 +14,16 @@ public:
    explicit GitWip(const QSharedPointer<GitBase> &git, const QSharedPointer<GitCache> &cache);
 
    void updateUntrackedFiles() const;
+   void updateUntrackedFiles(const QStringList &dirtyDirectories) const;
    bool updateWip() const;
+   bool updateWip(const QStringList &dirtyDirectories) const;
+   bool updateWipForFile(const QString &file) const;
    WipRevisionInfo getWipInfo() const;
 
 private:
    QSharedPointer<GitBase> mGit;
    QSharedPointer<GitCache> mCache;
 
-   QVector<QString> getUntrackedFiles() const;
+   QVector<QString> getUntrackedFiles(const QStringList &dirtyDirectories = QStringList()) const;
+   bool useStatusForUntracked() const;
 };
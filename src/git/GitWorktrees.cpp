@@ -0,0 +1,73 @@
+#include "GitWorktrees.h"
+
+#include <GitBase.h>
+
+#include <QLogger.h>
+
+using namespace QLogger;
+
+GitWorktrees::GitWorktrees(const QSharedPointer<GitBase> &gitBase)
+   : mGitBase(gitBase)
+{
+}
+
+QVector<GitWorktrees::Worktree> GitWorktrees::getWorktrees() const
+{
+   QLog_Debug("Git", QString("Getting worktrees"));
+
+   const auto ret = mGitBase->run("git worktree list --porcelain");
+
+   QVector<Worktree> worktrees;
+
+   if (!ret.success)
+      return worktrees;
+
+   Worktree current;
+
+   const auto lines = ret.output.toString().split('\n');
+
+   for (const auto &line : lines)
+   {
+      if (line.startsWith("worktree "))
+      {
+         if (!current.path.isEmpty())
+            worktrees.append(current);
+
+         current = Worktree();
+         current.path = line.mid(QString("worktree ").count());
+      }
+      else if (line.startsWith("branch refs/heads/"))
+         current.branch = line.mid(QString("branch refs/heads/").count());
+   }
+
+   if (!current.path.isEmpty())
+      worktrees.append(current);
+
+   return worktrees;
+}
+
+QString GitWorktrees::worktreeOfBranch(const QString &branch) const
+{
+   const auto worktrees = getWorktrees();
+
+   for (const auto &worktree : worktrees)
+   {
+      if (worktree.branch == branch)
+         return worktree.path;
+   }
+
+   return QString();
+}
+
+GitExecResult GitWorktrees::addWorktree(const QString &path, const QString &branch) const
+{
+   QLog_Debug("Git", QString("Creating worktree: {%1} at {%2}").arg(branch, path));
+
+   const auto cmd = QString("git worktree add %1 %2").arg(path, branch);
+
+   QLog_Trace("Git", QString("Creating worktree: {%1}").arg(cmd));
+
+   const auto ret = mGitBase->run(cmd);
+
+   return ret;
+}
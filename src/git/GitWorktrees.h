@@ -0,0 +1,76 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+#include <GitExecResult.h>
+
+#include <QSharedPointer>
+#include <QVector>
+
+class GitBase;
+
+/**
+ * @brief The GitWorktrees class wraps the git worktree plumbing. A linked worktree gives every
+ * branch its own working directory over the shared object store, so switching branches becomes
+ * activating an already loaded tab instead of checking out in place and reloading the history.
+ */
+class GitWorktrees
+{
+public:
+   /**
+    * @brief The Worktree struct describes one entry of git worktree list: where it lives and
+    * which branch it has checked out.
+    */
+   struct Worktree
+   {
+      QString path;
+      QString branch;
+   };
+
+   explicit GitWorktrees(const QSharedPointer<GitBase> &gitBase);
+
+   /**
+    * @brief getWorktrees Lists the worktrees of the repository, the main one included.
+    * @return The worktrees.
+    */
+   QVector<Worktree> getWorktrees() const;
+
+   /**
+    * @brief worktreeOfBranch Finds the worktree that has the given branch checked out.
+    * @param branch The branch name.
+    * @return The worktree path or an empty string when no worktree holds the branch.
+    */
+   QString worktreeOfBranch(const QString &branch) const;
+
+   /**
+    * @brief addWorktree Creates a linked worktree at the given path with the branch checked out.
+    * @param path The absolute path of the new worktree.
+    * @param branch The branch to check out in it.
+    * @return The result of the operation.
+    */
+   GitExecResult addWorktree(const QString &path, const QString &branch) const;
+
+private:
+   QSharedPointer<GitBase> mGitBase;
+};
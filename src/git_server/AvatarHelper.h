@@ -23,9 +23,14 @@
  ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
  ***************************************************************************************/
 #include <CircularPixmap.h>
+#include <MemoryTracker.h>
+#include <TaskPool.h>
 
 #include <QString>
+#include <QGuiApplication>
+#include <QImageReader>
 #include <QLabel>
+#include <QHash>
 #include <QStandardPaths>
 #include <QNetworkAccessManager>
 #include <QNetworkReply>
@@ -33,9 +38,147 @@
 #include <QFile>
 #include <QDir>
 #include <QPointer>
+#include <QtConcurrent/QtConcurrentRun>
 
-inline void storeCreatorAvatar(QNetworkAccessManager *manager, QNetworkReply *reply, QLabel *avatar,
-                               const QString &fileName)
+/**
+ * @brief avatarNetworkManager Shared network manager for all the avatar downloads, so every request reuses the same
+ * connection pool instead of creating a manager per avatar.
+ * @return The shared network manager.
+ */
+inline QNetworkAccessManager *avatarNetworkManager()
+{
+   static const auto manager = new QNetworkAccessManager();
+
+   return manager;
+}
+
+/**
+ * @brief avatarPixmapCache In-memory cache of the already decoded avatars keyed by user name and display size, so
+ * repeated avatars in the same view don't touch the disk again. The entries are stored pre-scaled and ready to paint.
+ * @return The pixmap cache.
+ */
+inline QHash<QString, QPixmap> &avatarPixmapCache()
+{
+   static QHash<QString, QPixmap> cache;
+   static const auto trackerId = MemoryTracker::instance()->add(
+       QObject::tr("Avatars"),
+       []() {
+          quint64 bytes = 0;
+
+          for (const auto &pixmap : cache)
+             bytes += static_cast<quint64>(pixmap.width()) * pixmap.height() * pixmap.depth() / 8;
+
+          return bytes;
+       },
+       []() { cache.clear(); });
+   Q_UNUSED(trackerId)
+
+   return cache;
+}
+
+/**
+ * @brief pendingAvatarRequests Avatars waiting for a download in flight, keyed by user name. All the widgets asking
+ * for the same avatar while it downloads are coalesced into the single request already running.
+ * @return The pending avatar widgets and their requested sizes.
+ */
+inline QHash<QString, QVector<QPair<QPointer<CircularPixmap>, QSize>>> &pendingAvatarRequests()
+{
+   static QHash<QString, QVector<QPair<QPointer<CircularPixmap>, QSize>>> pending;
+
+   return pending;
+}
+
+/**
+ * @brief avatarCacheKey Key of an avatar in the pixmap cache: the user name plus the display size the pixmap was
+ * scaled to.
+ * @param userName The user name.
+ * @param size The display size.
+ * @return The cache key.
+ */
+inline QString avatarCacheKey(const QString &userName, const QSize &size)
+{
+   return QString("%1@%2x%3").arg(userName).arg(size.width()).arg(size.height());
+}
+
+/**
+ * @brief decodeAvatarAsync Decodes the avatar file on the shared pool already scaled to each requested display size
+ * at the current device pixel ratio, and hands every waiting widget its ready pixmap back on the GUI thread. A burst
+ * of comments never pays JPEG decodes during paint this way.
+ * @param userName The user name the avatar belongs to.
+ * @param path The avatar file on disk.
+ */
+inline void decodeAvatarAsync(const QString &userName, const QString &path)
+{
+   // The pending list stays in place while the worker runs, so widgets created meanwhile keep
+   // coalescing into it instead of scheduling their own decode.
+   const auto snapshot = pendingAvatarRequests().value(userName);
+
+   if (snapshot.isEmpty())
+      return;
+
+   const auto dpr = qGuiApp->devicePixelRatio();
+   QVector<QSize> sizes;
+
+   for (const auto &waiter : snapshot)
+   {
+      if (!sizes.contains(waiter.second))
+         sizes.append(waiter.second);
+   }
+
+   QtConcurrent::run(TaskPool::instance()->pool(), [userName, path, sizes, dpr]() {
+      QHash<QString, QImage> imagesBySize;
+
+      for (const auto &size : sizes)
+      {
+         QImageReader reader(path);
+         reader.setScaledSize(size * dpr);
+         imagesBySize.insert(avatarCacheKey(userName, size), reader.read());
+      }
+
+      QMetaObject::invokeMethod(
+          qGuiApp,
+          [userName, path, imagesBySize, dpr]() {
+             const auto waiters = pendingAvatarRequests().take(userName);
+             QVector<QPair<QPointer<CircularPixmap>, QSize>> leftovers;
+
+             for (const auto &waiter : waiters)
+             {
+                const auto key = avatarCacheKey(userName, waiter.second);
+
+                // A size that joined after the worker snapshot needs its own decode pass
+                if (!imagesBySize.contains(key))
+                {
+                   if (waiter.first)
+                      leftovers.append(waiter);
+
+                   continue;
+                }
+
+                const auto img = imagesBySize.value(key);
+
+                if (img.isNull())
+                   continue;
+
+                auto pixmap = QPixmap::fromImage(img);
+                pixmap.setDevicePixelRatio(dpr);
+
+                avatarPixmapCache().insert(key, pixmap);
+
+                if (waiter.first)
+                   waiter.first->setPixmap(pixmap);
+             }
+
+             if (!leftovers.isEmpty())
+             {
+                pendingAvatarRequests().insert(userName, leftovers);
+                decodeAvatarAsync(userName, path);
+             }
+          },
+          Qt::QueuedConnection);
+   });
+}
+
+inline void storeCreatorAvatar(QNetworkReply *reply, const QString &fileName)
 {
    const auto data = reply->readAll();
    const auto cache = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
@@ -51,18 +194,14 @@ inline void storeCreatorAvatar(QNetworkAccessManager *manager, QNetworkReply *re
       file.write(data);
       file.close();
 
-      QPixmap img(path);
-
-      if (!img.isNull())
-      {
-         img = img.scaled(50, 50, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
-
-         avatar->setPixmap(img);
-      }
+      // Every widget that asked for this avatar while the download was running gets served from
+      // the single decode.
+      decodeAvatarAsync(fileName, path);
    }
+   else
+      pendingAvatarRequests().remove(fileName);
 
    reply->deleteLater();
-   manager->deleteLater();
 }
 
 inline QPointer<CircularPixmap> createAvatar(const QString &userName, const QString &avatarUrl,
@@ -73,27 +212,32 @@ inline QPointer<CircularPixmap> createAvatar(const QString &userName, const QStr
    QPointer<CircularPixmap> avatar = new CircularPixmap(avatarSize);
    avatar->setObjectName("Avatar");
 
-   if (!QFile(fileName).exists())
+   if (const auto img = avatarPixmapCache().value(avatarCacheKey(userName, avatarSize)); !img.isNull())
+      avatar->setPixmap(img);
+   else if (QFile(fileName).exists())
    {
-      const auto manager = new QNetworkAccessManager();
-      QNetworkRequest request;
-      request.setUrl(avatarUrl);
-      request.setAttribute(QNetworkRequest::RedirectPolicyAttribute, true);
-      const auto reply = manager->get(request);
-      QObject::connect(reply, &QNetworkReply::finished, [manager, reply, avatar, userName]() {
-         if (avatar)
-            storeCreatorAvatar(manager, reply, avatar, userName);
-      });
+      auto &waiters = pendingAvatarRequests()[userName];
+      waiters.append(qMakePair(avatar, avatarSize));
+
+      // The file on disk is decoded on a worker; only the first widget asking schedules it and
+      // the rest join the pending list it serves.
+      if (waiters.count() == 1)
+         decodeAvatarAsync(userName, fileName);
    }
    else
    {
-      QPixmap img(fileName);
+      auto &waiters = pendingAvatarRequests()[userName];
+      waiters.append(qMakePair(avatar, avatarSize));
 
-      if (!img.isNull())
+      // Only the first widget asking for the avatar fires the request; the rest just wait for it.
+      if (waiters.count() == 1)
       {
-         img = img.scaled(avatarSize, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
-
-         avatar->setPixmap(img);
+         QNetworkRequest request;
+         request.setUrl(avatarUrl);
+         request.setAttribute(QNetworkRequest::RedirectPolicyAttribute, true);
+         const auto reply = avatarNetworkManager()->get(request);
+         QObject::connect(reply, &QNetworkReply::finished,
+                          [reply, userName]() { storeCreatorAvatar(reply, userName); });
       }
    }
 
@@ -2,15 +2,12 @@
 
 #include <Comment.h>
 #include <AvatarHelper.h>
-#include <previewpage.h>
-#include <GitQlientSettings.h>
+#include <MarkdownView.h>
 
 #include <QVBoxLayout>
 #include <QTextEdit>
 #include <QLabel>
 #include <QLocale>
-#include <QWebEngineView>
-#include <QWebChannel>
 
 CodeReviewComment::CodeReviewComment(const GitServer::CodeReview &review, QWidget *parent)
    : QFrame(parent)
@@ -28,27 +25,8 @@ CodeReviewComment::CodeReviewComment(const GitServer::CodeReview &review, QWidge
    avatarLayout->addWidget(creator);
    avatarLayout->addStretch();
 
-   GitQlientSettings settings("");
-   const auto colorSchema = settings.globalValue("colorSchema", "dark").toString();
-   const auto style = colorSchema == "dark" ? QString::fromUtf8("dark") : QString::fromUtf8("bright");
-
-   QPointer<QWebEngineView> body = new QWebEngineView();
-   PreviewPage *page = new PreviewPage(this);
-   body->setPage(page);
-
-   QWebChannel *channel = new QWebChannel(this);
-   channel->registerObject(QStringLiteral("content"), &m_content);
-   page->setWebChannel(channel);
-
-   body->setUrl(QUrl(QString("qrc:/resources/index_%1.html").arg(style)));
-   body->setFixedHeight(20);
-
-   connect(page, &PreviewPage::contentsSizeChanged, this, [body](const QSizeF size) {
-      if (body)
-         body->setFixedHeight(size.height());
-   });
-
-   m_content.setText(review.body);
+   const auto body = new MarkdownView();
+   body->setMarkdown(review.body);
 
    const auto frame = new QFrame();
    frame->setObjectName("CodeReviewComment");
@@ -23,10 +23,9 @@
  ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
  ***************************************************************************************/
 
+#include <QDateTime>
 #include <QFrame>
 
-#include <document.h>
-
 class QLabel;
 
 namespace GitServer
@@ -42,7 +41,5 @@ public:
    explicit CodeReviewComment(const GitServer::CodeReview &review, QWidget *parent = nullptr);
 
 private:
-   Document m_content;
-
    QLabel *createHeadline(const QDateTime &dt, const QString &prefix);
 };
@@ -5,6 +5,7 @@
 #include <GitQlientSettings.h>
 #include <GitServerCache.h>
 #include <Issue.h>
+#include <PerfProfiler.h>
 
 #include <previewpage.h>
 
@@ -230,13 +231,30 @@ void CreateIssueDlg::onIssueTemplateChange(int newIndex)
 
 void CreateIssueDlg::updateMarkdown(const QByteArray &fileContent)
 {
+   ui->teDescription->setText(QString::fromUtf8(fileContent));
+
+   // While the view is hidden in the stacked layout only the text is stored; the preview page is
+   // built on the first show so the web engine is not initialized before it is needed
+   if (isVisible())
+      ensurePreviewPage();
+}
+
+void CreateIssueDlg::ensurePreviewPage()
+{
+   if (mPreviewReady)
+      return;
+
+   mPreviewReady = true;
+
+   // The deferred engine bring-up shows in the perf HUD, which is also the time saved at startup
+   PerfScopedTimer timer("CreateIssueDlg::ensurePreviewPage", "ui");
+
    GitQlientSettings settings("");
    const auto colorSchema = settings.globalValue("colorSchema", "dark").toString();
    const auto style = colorSchema == "dark" ? QString::fromUtf8("dark") : QString::fromUtf8("bright");
 
    PreviewPage *page = new PreviewPage(this);
    ui->preview->setPage(page);
-   ui->teDescription->setText(QString::fromUtf8(fileContent));
 
    QWebChannel *channel = new QWebChannel(this);
    channel->registerObject(QStringLiteral("content"), &m_content);
@@ -244,3 +262,10 @@ void CreateIssueDlg::updateMarkdown(const QByteArray &fileContent)
 
    ui->preview->setUrl(QUrl(QString("qrc:/resources/index_%1.html").arg(style)));
 }
+
+void CreateIssueDlg::showEvent(QShowEvent *event)
+{
+   ensurePreviewPage();
+
+   QFrame::showEvent(event);
+}
@@ -67,10 +67,19 @@ public:
 
    bool configure(const QString &workingDir);
 
+protected:
+   /**
+    * @brief showEvent Builds the markdown preview page the first time the view is shown, so the
+    * web engine is not initialized while the view sits hidden in the stacked layout.
+    * @param event The show event.
+    */
+   void showEvent(QShowEvent *event) override;
+
 private:
    Ui::CreateIssueDlg *ui;
    QSharedPointer<GitServerCache> mGitServerCache;
    Document m_content;
+   bool mPreviewReady = false;
 
    /**
     * @brief accept Process the user input data and does a request to create an issue.
@@ -103,4 +112,11 @@ private:
    void onIssueTemplateChange(int newIndex);
 
    void updateMarkdown(const QByteArray &fileContent);
+
+   /**
+    * @brief ensurePreviewPage Creates the preview page and its channel binding once. The preview
+    * follows the description text through the bound Document, so template changes only need to
+    * update the text.
+    */
+   void ensurePreviewPage();
 };
@@ -0,0 +1,302 @@
+#include "GitHubGraphQlApi.h"
+#include <Issue.h>
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+
+#include <QLogger.h>
+
+using namespace QLogger;
+using namespace GitServer;
+
+GitHubGraphQlApi::GitHubGraphQlApi(const QString &repoOwner, const QString &repoName, const ServerAuthentication &auth,
+                                   QObject *parent)
+   : GitHubRestApi(repoOwner, repoName, auth, parent)
+   , mOwner(repoOwner)
+   , mName(repoName)
+{
+   if (mOwner.endsWith("/"))
+      mOwner = mOwner.left(mOwner.size() - 1);
+
+   if (mOwner.startsWith("/"))
+      mOwner = mOwner.mid(1);
+
+   if (mName.endsWith("/"))
+      mName = mName.left(mName.size() - 1);
+}
+
+void GitHubGraphQlApi::postQuery(const QString &query, const std::function<void(const QJsonObject &)> &onData)
+{
+   sendPaced(RequestPriority::Interactive, [this, query, onData]() {
+      QNetworkRequest request;
+      request.setUrl(QUrl(QString("%1/graphql").arg(mAuth.endpointUrl)));
+      request.setRawHeader("User-Agent", "GitQlient");
+      request.setRawHeader("X-Custom-User-Agent", "GitQlient");
+      request.setRawHeader("Content-Type", "application/json");
+      request.setRawHeader("Authorization", QByteArray("Bearer ").append(mAuth.userPass.toUtf8()));
+      allowHttp2(request);
+
+      QJsonObject body;
+      body.insert("query", query);
+
+      const auto data = QJsonDocument(body).toJson(QJsonDocument::Compact);
+      const auto reply = mManager->post(request, data);
+
+      connect(reply, &QNetworkReply::finished, this, [this, onData]() {
+         const auto reply = qobject_cast<QNetworkReply *>(sender());
+         QString errorStr;
+         const auto tmpDoc = validateData(reply, errorStr);
+
+         if (tmpDoc.isEmpty())
+            emit errorOccurred(errorStr);
+         else if (const auto errors = tmpDoc.object()["errors"].toArray(); !errors.isEmpty())
+            emit errorOccurred(errors.first().toObject()["message"].toString());
+         else
+            onData(tmpDoc.object()["data"].toObject());
+      });
+   });
+}
+
+void GitHubGraphQlApi::requestIssues(int page)
+{
+   // The deeper pages keep using the REST pagination: the first one is the interactive hot path
+   if (page != -1)
+   {
+      GitHubRestApi::requestIssues(page);
+      return;
+   }
+
+   QLog_Debug("Ui", QString("Requesting the issues through GraphQL"));
+
+   const auto query = QString("query { repository(owner: \"%1\", name: \"%2\") { "
+                              "issues(first: 100, states: OPEN, orderBy: {field: CREATED_AT, direction: DESC}) { "
+                              "nodes { number title body url createdAt "
+                              "author { login avatarUrl url } "
+                              "comments { totalCount } "
+                              "labels(first: 20) { nodes { name description color isDefault url } } "
+                              "assignees(first: 10) { nodes { login avatarUrl url } } "
+                              "milestone { number title description state } } } } }")
+                          .arg(mOwner, mName);
+
+   postQuery(query, [this](const QJsonObject &data) {
+      QVector<Issue> issues;
+      const auto nodes = data["repository"].toObject()["issues"].toObject()["nodes"].toArray();
+
+      for (const auto &node : nodes)
+      {
+         const auto issueObj = node.toObject();
+
+         Issue issue;
+         issue.number = issueObj["number"].toInt();
+         issue.title = issueObj["title"].toString();
+         issue.body = issueObj["body"].toString().toUtf8();
+         issue.url = issueObj["url"].toString();
+         issue.creation = issueObj["createdAt"].toVariant().toDateTime();
+         issue.commentsCount = issueObj["comments"].toObject()["totalCount"].toInt();
+         issue.isOpen = true;
+         issue.creator = userFromJson(issueObj["author"].toObject());
+
+         const auto labels = issueObj["labels"].toObject()["nodes"].toArray();
+
+         for (const auto &label : labels)
+         {
+            issue.labels.append({ 0, QString(), label["url"].toString(), label["name"].toString(),
+                                  label["description"].toString(), label["color"].toString(),
+                                  label["isDefault"].toBool() });
+         }
+
+         const auto assignees = issueObj["assignees"].toObject()["nodes"].toArray();
+
+         for (const auto &assignee : assignees)
+            issue.assignees.append(userFromJson(assignee.toObject()));
+
+         if (const auto milestoneObj = issueObj["milestone"].toObject(); !milestoneObj.isEmpty())
+         {
+            issue.milestone = { milestoneObj["number"].toInt(),       milestoneObj["number"].toInt(),
+                                QString(),                            milestoneObj["title"].toString(),
+                                milestoneObj["description"].toString(), milestoneObj["state"].toString() == "OPEN" };
+         }
+
+         issues.append(std::move(issue));
+      }
+
+      emit paginationPresent(0, 0, 0);
+      emit issuesReceived(issues);
+   });
+}
+
+void GitHubGraphQlApi::requestComments(int issueNumber)
+{
+   queryIssueOrPrView(issueNumber);
+}
+
+void GitHubGraphQlApi::requestReviews(int prNumber)
+{
+   queryIssueOrPrView(prNumber);
+}
+
+void GitHubGraphQlApi::queryIssueOrPrView(int number)
+{
+   /* The detailed view requests the comments and the reviews back-to-back; the single query below
+    * answers both, so the second call only needs to join the in-flight one. */
+   if (mPendingViews.contains(number))
+      return;
+
+   mPendingViews.insert(number);
+
+   QLog_Debug("Ui", QString("Requesting the full view of issue %1 through GraphQL").arg(number));
+
+   const auto userFields = QString("author { login avatarUrl url }");
+   const auto commentFields
+       = QString("nodes { databaseId body createdAt authorAssociation %1 }").arg(userFields);
+   const auto query
+       = QString("query { repository(owner: \"%1\", name: \"%2\") { issueOrPullRequest(number: %3) { "
+                 "... on Issue { comments(first: 100) { %4 } } "
+                 "... on PullRequest { comments(first: 100) { %4 } "
+                 "reviews(first: 100) { nodes { databaseId body submittedAt state authorAssociation %5 } } "
+                 "reviewThreads(first: 100) { nodes { isOutdated comments(first: 50) { nodes { databaseId body "
+                 "createdAt authorAssociation diffHunk path line originalLine "
+                 "pullRequestReview { databaseId } replyTo { databaseId } %5 } } } } } } } }")
+             .arg(mOwner, mName, QString::number(number), commentFields, userFields);
+
+   postQuery(query, [this, number](const QJsonObject &data) {
+      mPendingViews.remove(number);
+
+      const auto view = data["repository"].toObject()["issueOrPullRequest"].toObject();
+
+      emit commentsReceived(number, commentsFromJson(view["comments"].toObject()));
+
+      if (!view.contains("reviews"))
+         return;
+
+      QMap<int, Review> reviews;
+      const auto reviewNodes = view["reviews"].toObject()["nodes"].toArray();
+
+      for (const auto &node : reviewNodes)
+      {
+         const auto reviewObj = node.toObject();
+
+         Review r;
+         r.id = reviewObj["databaseId"].toInt();
+         r.body = reviewObj["body"].toString();
+         r.creation = reviewObj["submittedAt"].toVariant().toDateTime();
+         r.state = reviewObj["state"].toString();
+         r.association = reviewObj["authorAssociation"].toString();
+         r.creator = userFromJson(reviewObj["author"].toObject());
+
+         reviews.insert(r.id, std::move(r));
+      }
+
+      emit commentReviewsReceived(number, reviews);
+
+      QVector<CodeReview> codeReviews;
+      const auto threads = view["reviewThreads"].toObject()["nodes"].toArray();
+
+      for (const auto &thread : threads)
+      {
+         const auto threadObj = thread.toObject();
+         const auto outdated = threadObj["isOutdated"].toBool();
+         const auto commentNodes = threadObj["comments"].toObject()["nodes"].toArray();
+
+         for (const auto &node : commentNodes)
+         {
+            const auto commentObj = node.toObject();
+
+            CodeReview c;
+            c.outdated = outdated;
+            c.id = commentObj["databaseId"].toInt();
+            c.body = commentObj["body"].toString();
+            c.creation = commentObj["createdAt"].toVariant().toDateTime();
+            c.association = commentObj["authorAssociation"].toString();
+            c.diff.diff = commentObj["diffHunk"].toString();
+            c.diff.file = commentObj["path"].toString();
+            c.diff.line = commentObj["line"].toInt();
+            c.diff.originalLine = commentObj["originalLine"].toInt();
+            c.reviewId = commentObj["pullRequestReview"].toObject()["databaseId"].toInt();
+            c.replyToId = commentObj["replyTo"].toObject()["databaseId"].toInt();
+            c.creator = userFromJson(commentObj["author"].toObject());
+
+            codeReviews.append(std::move(c));
+         }
+      }
+
+      emit codeReviewsReceived(number, codeReviews);
+   });
+}
+
+void GitHubGraphQlApi::requestCommitsFromPR(int prNumber)
+{
+   QLog_Debug("Ui", QString("Requesting the commits of PR %1 through GraphQL").arg(prNumber));
+
+   const auto query = QString("query { repository(owner: \"%1\", name: \"%2\") { pullRequest(number: %3) { "
+                              "commits(first: 250) { nodes { url commit { oid message "
+                              "author { date user { login avatarUrl url } } "
+                              "committer { user { login avatarUrl url } } } } } } } }")
+                          .arg(mOwner, mName, QString::number(prNumber));
+
+   postQuery(query, [this, prNumber](const QJsonObject &data) {
+      QVector<Commit> commits;
+      const auto nodes
+          = data["repository"].toObject()["pullRequest"].toObject()["commits"].toObject()["nodes"].toArray();
+
+      for (const auto &node : nodes)
+      {
+         const auto nodeObj = node.toObject();
+         const auto commitObj = nodeObj["commit"].toObject();
+
+         Commit c;
+         c.url = nodeObj["url"].toString();
+         c.sha = commitObj["oid"].toString();
+         c.message = commitObj["message"].toString();
+         c.author = userFromJson(commitObj["author"].toObject()["user"].toObject());
+         c.commiter = userFromJson(commitObj["committer"].toObject()["user"].toObject());
+         c.authorCommittedTimestamp = commitObj["author"].toObject()["date"].toVariant().toDateTime();
+
+         commits.append(std::move(c));
+      }
+
+      std::sort(commits.begin(), commits.end(), [](const Commit &c1, const Commit &c2) {
+         return c1.authorCommittedTimestamp < c2.authorCommittedTimestamp;
+      });
+
+      emit commitsReceived(prNumber, commits, 1, 1);
+   });
+}
+
+User GitHubGraphQlApi::userFromJson(const QJsonObject &json) const
+{
+   // The GraphQL Actor interface doesn't expose the numeric id nor the account type
+   User user;
+   user.id = 0;
+   user.name = json["login"].toString();
+   user.avatar = json["avatarUrl"].toString();
+   user.url = json["url"].toString();
+
+   return user;
+}
+
+QVector<Comment> GitHubGraphQlApi::commentsFromJson(const QJsonObject &json) const
+{
+   QVector<Comment> comments;
+   const auto nodes = json["nodes"].toArray();
+
+   for (const auto &node : nodes)
+   {
+      const auto commentObj = node.toObject();
+
+      Comment c;
+      c.id = commentObj["databaseId"].toInt();
+      c.body = commentObj["body"].toString();
+      c.creation = commentObj["createdAt"].toVariant().toDateTime();
+      c.association = commentObj["authorAssociation"].toString();
+      c.creator = userFromJson(commentObj["author"].toObject());
+
+      comments.append(std::move(c));
+   }
+
+   return comments;
+}
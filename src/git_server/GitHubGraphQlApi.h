@@ -0,0 +1,94 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+#include <GitHubRestApi.h>
+
+#include <QSet>
+
+class QJsonObject;
+
+namespace GitServer
+{
+
+/**
+ * @brief The GitHubGraphQlApi class batches the read-heavy GitHub flows into single GraphQL
+ * queries. The REST flows need one round trip per resource (comments, reviews, review threads and
+ * commits of a PR all travel separately); the GraphQL endpoint returns the whole view in one
+ * response, which makes a big difference on high-latency links. Mutations and anything not
+ * overridden here keep using the inherited REST implementation, which is why the class derives
+ * from GitHubRestApi instead of implementing IRestApi from scratch.
+ *
+ * The backend is opt-in per server through the ServerConfigDlg.
+ */
+class GitHubGraphQlApi : public GitHubRestApi
+{
+   Q_OBJECT
+
+public:
+   explicit GitHubGraphQlApi(const QString &repoOwner, const QString &repoName, const ServerAuthentication &auth,
+                             QObject *parent = nullptr);
+
+   /**
+    * @brief requestIssues Requests the first page of open issues with their labels, assignees and
+    * milestone in one query. Deeper pages fall back to the REST pagination.
+    */
+   void requestIssues(int page = -1) override;
+   /**
+    * @brief requestComments Requests the full view of an issue or PR. For a PR the comments,
+    * reviews and review threads arrive in the same response.
+    */
+   void requestComments(int issueNumber) override;
+   /**
+    * @brief requestReviews Coalesced with @ref requestComments: both trigger the same single
+    * query, so the usual back-to-back calls when a PR opens produce one request instead of three.
+    */
+   void requestReviews(int prNumber) override;
+   /**
+    * @brief requestCommitsFromPR Requests all the commits of a PR in one query.
+    */
+   void requestCommitsFromPR(int prNumber) override;
+
+private:
+   QString mOwner;
+   QString mName;
+   QSet<int> mPendingViews;
+
+   /**
+    * @brief postQuery Sends the given GraphQL query through the paced scheduler and hands the
+    * "data" object of the reply to \p onData. Errors are reported through errorOccurred.
+    */
+   void postQuery(const QString &query, const std::function<void(const QJsonObject &)> &onData);
+   /**
+    * @brief queryIssueOrPrView Fetches the comments of an issue or the comments, reviews and
+    * review threads of a PR in one query, emitting the same signals the REST replies would.
+    * Concurrent calls for the same number are coalesced into one in-flight request.
+    */
+   void queryIssueOrPrView(int number);
+
+   User userFromJson(const QJsonObject &json) const;
+   QVector<Comment> commentsFromJson(const QJsonObject &json) const;
+};
+
+}
@@ -1,4 +1,5 @@
 #include "GitHubRestApi.h"
+#include <GitQlientSettings.h>
 #include <Issue.h>
 
 #include <QNetworkAccessManager>
@@ -31,23 +32,41 @@ GitHubRestApi::GitHubRestApi(QString repoOwner, QString repoName, const ServerAu
 
    mAuthString = "Basic "
        + QByteArray(QString(QStringLiteral("%1:%2")).arg(mAuth.userName, mAuth.userPass).toLocal8Bit()).toBase64();
+
+   // The updated-at cursors survive sessions, so the first refresh after a restart is already an
+   // incremental one instead of a full re-fetch
+   GitQlientSettings settings;
+   mIssuesCursor = settings.globalValue(QString("GitServerSince/%1/issues").arg(mRepoEndpoint)).toDateTime();
+   mPullsCursor = settings.globalValue(QString("GitServerSince/%1/pulls").arg(mRepoEndpoint)).toDateTime();
+}
+
+void GitHubRestApi::advanceCursor(QDateTime &cursor, const QDateTime &newest, const QString &kind)
+{
+   if (newest.isValid() && newest > cursor)
+   {
+      cursor = newest;
+
+      GitQlientSettings().setGlobalValue(QString("GitServerSince/%1/%2").arg(mRepoEndpoint, kind), cursor);
+   }
 }
 
 void GitHubRestApi::testConnection()
 {
-   auto request = createRequest("/user/repos");
+   sendPaced(RequestPriority::Interactive, [this]() {
+      auto request = createRequest("/user/repos");
 
-   const auto reply = mManager->get(request);
+      const auto reply = mManager->get(request);
 
-   connect(reply, &QNetworkReply::finished, this, [this]() {
-      const auto reply = qobject_cast<QNetworkReply *>(sender());
-      QString errorStr;
-      const auto tmpDoc = validateData(reply, errorStr);
+      connect(reply, &QNetworkReply::finished, this, [this]() {
+         const auto reply = qobject_cast<QNetworkReply *>(sender());
+         QString errorStr;
+         const auto tmpDoc = validateData(reply, errorStr);
 
-      if (!tmpDoc.isEmpty())
-         emit connectionTested();
-      else
-         emit errorOccurred(errorStr);
+         if (!tmpDoc.isEmpty())
+            emit connectionTested();
+         else
+            emit errorOccurred(errorStr);
+      });
    });
 }
 
@@ -138,16 +157,20 @@ void GitHubRestApi::createPullRequest(const PullRequest &pullRequest)
 
 void GitHubRestApi::requestLabels()
 {
-   const auto reply = mManager->get(createRequest(mRepoEndpoint + "/labels"));
+   sendPaced(RequestPriority::Background, [this]() {
+      const auto reply = mManager->get(createRequest(mRepoEndpoint + "/labels"));
 
-   connect(reply, &QNetworkReply::finished, this, &GitHubRestApi::onLabelsReceived);
+      connect(reply, &QNetworkReply::finished, this, &GitHubRestApi::onLabelsReceived);
+   });
 }
 
 void GitHubRestApi::requestMilestones()
 {
-   const auto reply = mManager->get(createRequest(mRepoEndpoint + "/milestones"));
+   sendPaced(RequestPriority::Background, [this]() {
+      const auto reply = mManager->get(createRequest(mRepoEndpoint + "/milestones"));
 
-   connect(reply, &QNetworkReply::finished, this, &GitHubRestApi::onMilestonesReceived);
+      connect(reply, &QNetworkReply::finished, this, &GitHubRestApi::onMilestonesReceived);
+   });
 }
 
 void GitHubRestApi::requestIssues(int page)
@@ -162,14 +185,24 @@ void GitHubRestApi::requestIssues(int page)
       url.setQuery(query);
    }
 
+   // Once a cursor exists only the issues updated after it are requested; closed ones come back
+   // in the delta so the cache can evict them
+   if (mIssuesCursor.isValid())
+   {
+      query.addQueryItem("state", "all");
+      query.addQueryItem("since", mIssuesCursor.toUTC().toString(Qt::ISODate));
+   }
+
    query.addQueryItem("per_page", QString::number(100));
    url.setQuery(query);
 
    request.setUrl(url);
 
-   const auto reply = mManager->get(request);
+   sendPaced(RequestPriority::Interactive, [this, request]() {
+      const auto reply = mManager->get(request);
 
-   connect(reply, &QNetworkReply::finished, this, &GitHubRestApi::onIssuesReceived);
+      connect(reply, &QNetworkReply::finished, this, &GitHubRestApi::onIssuesReceived);
+   });
 }
 
 void GitHubRestApi::requestPullRequests(int page)
@@ -184,14 +217,25 @@ void GitHubRestApi::requestPullRequests(int page)
       url.setQuery(query);
    }
 
+   // The pulls endpoint has no since parameter, so the incremental sync asks for the most
+   // recently updated ones first and stops paging once it reaches the cursor
+   if (mPullsCursor.isValid())
+   {
+      query.addQueryItem("state", "all");
+      query.addQueryItem("sort", "updated");
+      query.addQueryItem("direction", "desc");
+   }
+
    query.addQueryItem("per_page", QString::number(100));
    url.setQuery(query);
 
    request.setUrl(url);
 
-   const auto reply = mManager->get(request);
+   sendPaced(RequestPriority::Interactive, [this, request]() {
+      const auto reply = mManager->get(request);
 
-   connect(reply, &QNetworkReply::finished, this, &GitHubRestApi::onPullRequestReceived);
+      connect(reply, &QNetworkReply::finished, this, &GitHubRestApi::onPullRequestReceived);
+   });
 }
 
 void GitHubRestApi::mergePullRequest(int number, const QByteArray &data)
@@ -203,24 +247,34 @@ void GitHubRestApi::mergePullRequest(int number, const QByteArray &data)
 
 void GitHubRestApi::requestComments(int issueNumber)
 {
-   const auto reply = mManager->get(createRequest(mRepoEndpoint + QString("/issues/%1/comments").arg(issueNumber)));
+   sendPaced(RequestPriority::Interactive, [this, issueNumber]() {
+      const auto reply = mManager->get(createRequest(mRepoEndpoint + QString("/issues/%1/comments").arg(issueNumber)));
 
-   connect(reply, &QNetworkReply::finished, this, [this, issueNumber]() { onCommentsReceived(issueNumber); });
+      connect(reply, &QNetworkReply::finished, this, [this, issueNumber]() { onCommentsReceived(issueNumber); });
+   });
 }
 
 void GitHubRestApi::requestReviews(int prNumber)
 {
-   const auto reply = mManager->get(createRequest(mRepoEndpoint + QString("/pulls/%1/reviews").arg(prNumber)));
+   sendPaced(RequestPriority::Interactive, [this, prNumber]() {
+      const auto reply = mManager->get(createRequest(mRepoEndpoint + QString("/pulls/%1/reviews").arg(prNumber)));
+
+      connect(reply, &QNetworkReply::finished, this, [this, prNumber]() { onReviewsReceived(prNumber); });
+   });
 
-   connect(reply, &QNetworkReply::finished, this, [this, prNumber]() { onReviewsReceived(prNumber); });
+   /* The review comments endpoint doesn't depend on the reviews reply, so both requests travel in
+    * parallel instead of chaining the second one after the first answer lands. */
+   requestReviewComments(prNumber);
 }
 
 void GitHubRestApi::requestCommitsFromPR(int prNumber)
 {
-   auto request = createRequest(mRepoEndpoint + QString("/pulls/%1/commits").arg(prNumber));
-   const auto reply = mManager->get(request);
+   sendPaced(RequestPriority::Interactive, [this, prNumber]() {
+      auto request = createRequest(mRepoEndpoint + QString("/pulls/%1/commits").arg(prNumber));
+      const auto reply = mManager->get(request);
 
-   connect(reply, &QNetworkReply::finished, this, [this, prNumber]() { onCommitsReceived(prNumber); });
+      connect(reply, &QNetworkReply::finished, this, [this, prNumber]() { onCommitsReceived(prNumber); });
+   });
 }
 
 void GitHubRestApi::addIssueComment(const Issue &issue, const QString &text)
@@ -454,6 +508,7 @@ QNetworkRequest GitHubRestApi::createRequest(const QString &page) const
    request.setRawHeader("Content-Type", "application/json");
    request.setRawHeader("Accept", "application/vnd.github.v3+json");
    request.setRawHeader("Authorization", mAuthString);
+   allowHttp2(request);
 
    return request;
 }
@@ -550,7 +605,7 @@ void GitHubRestApi::onPullRequestCreated()
             connect(reply, &QNetworkReply::finished, this, [this, pr]() { onPullRequestDetailesReceived(pr); });
          });
          */
-      QTimer::singleShot(200, this, [this, pr]() {
+      sendPaced(RequestPriority::Background, [this, pr]() {
          auto request = createRequest(mRepoEndpoint + QString("/commits/%1/status").arg(pr.state.sha));
          const auto reply = mManager->get(request);
          connect(reply, &QNetworkReply::finished, this, [this, pr] { onPullRequestStatusReceived(pr); });
@@ -577,13 +632,14 @@ void GitHubRestApi::onPullRequestMerged()
 void GitHubRestApi::onPullRequestReceived()
 {
    const auto reply = qobject_cast<QNetworkReply *>(sender());
+   auto next = 0;
+   auto total = 0;
 
    if (const auto pagination = QString::fromUtf8(reply->rawHeader("Link")); !pagination.isEmpty())
    {
       QStringList pages = pagination.split(",");
       auto current = 0;
-      auto next = 0;
-      auto total = 0;
+      auto isFirstPage = true;
 
       for (const auto &page : pages)
       {
@@ -596,6 +652,18 @@ void GitHubRestApi::onPullRequestReceived()
          }
          else if (values.last().contains("last"))
             total = values.first().split("page=").last().toInt();
+         else if (values.last().contains("prev"))
+            isFirstPage = false;
+      }
+
+      // All the remaining pages are requested from the first reply at once, so the network
+      // manager downloads them concurrently instead of each page waiting for the previous one.
+      // During an incremental sync the responses are sorted by updated-at, so the next page is
+      // only fetched when the cursor was not reached yet.
+      if (isFirstPage && !mPullsCursor.isValid())
+      {
+         for (auto page = next; page > 0 && page <= total; ++page)
+            requestPullRequests(page);
       }
 
       emit paginationPresent(current, next, total);
@@ -606,13 +674,27 @@ void GitHubRestApi::onPullRequestReceived()
    QString errorStr;
    const auto tmpDoc = validateData(reply, errorStr);
    QVector<PullRequest> pullRequests;
+   auto newest = QDateTime();
+   auto reachedCursor = false;
 
    if (!tmpDoc.isEmpty())
    {
       const auto issuesArray = tmpDoc.array();
       for (const auto &issueData : issuesArray)
       {
-         const auto pr = prFromJson(issueData.toObject());
+         const auto prObj = issueData.toObject();
+         const auto updated = prObj["updated_at"].toVariant().toDateTime();
+
+         if (mPullsCursor.isValid() && updated.isValid() && updated <= mPullsCursor)
+         {
+            reachedCursor = true;
+            break;
+         }
+
+         if (updated > newest)
+            newest = updated;
+
+         const auto pr = prFromJson(prObj);
          pullRequests.append(pr);
 
          /*
@@ -621,7 +703,7 @@ void GitHubRestApi::onPullRequestReceived()
             connect(reply, &QNetworkReply::finished, this, [this, pr]() { onPullRequestDetailsReceived(pr); });
          });
          */
-         QTimer::singleShot(200, this, [this, pr]() {
+         sendPaced(RequestPriority::Background, [this, pr]() {
             auto request = createRequest(mRepoEndpoint + QString("/commits/%1/status").arg(pr.state.sha));
             const auto reply = mManager->get(request);
             connect(reply, &QNetworkReply::finished, this, [this, pr] { onPullRequestStatusReceived(pr); });
@@ -631,6 +713,11 @@ void GitHubRestApi::onPullRequestReceived()
    else
       emit errorOccurred(errorStr);
 
+   if (mPullsCursor.isValid() && !reachedCursor && next > 0 && next <= total)
+      requestPullRequests(next);
+
+   advanceCursor(mPullsCursor, newest, QStringLiteral("pulls"));
+
    std::sort(pullRequests.begin(), pullRequests.end(),
              [](const PullRequest &p1, const PullRequest &p2) { return p1.creation > p2.creation; });
 
@@ -686,6 +773,7 @@ void GitHubRestApi::onIssuesReceived()
       auto current = 0;
       auto next = 0;
       auto total = 0;
+      auto isFirstPage = true;
 
       for (const auto &page : pages)
       {
@@ -698,6 +786,16 @@ void GitHubRestApi::onIssuesReceived()
          }
          else if (values.last().contains("last"))
             total = values.first().split("page=").last().toInt();
+         else if (values.last().contains("prev"))
+            isFirstPage = false;
+      }
+
+      // All the remaining pages are requested from the first reply at once, so the network
+      // manager downloads them concurrently instead of each page waiting for the previous one.
+      if (isFirstPage)
+      {
+         for (auto page = next; page > 0 && page <= total; ++page)
+            requestIssues(page);
       }
 
       emit paginationPresent(current, next, total);
@@ -708,6 +806,7 @@ void GitHubRestApi::onIssuesReceived()
    QString errorStr;
    const auto tmpDoc = validateData(reply, errorStr);
    QVector<Issue> issues;
+   auto newest = QDateTime();
 
    if (!tmpDoc.isEmpty())
    {
@@ -715,17 +814,32 @@ void GitHubRestApi::onIssuesReceived()
 
       for (const auto &issueData : issuesArray)
       {
-         if (const auto issueObj = issueData.toObject(); !issueObj.contains("pull_request"))
+         const auto issueObj = issueData.toObject();
+
+         if (const auto updated = issueObj["updated_at"].toVariant().toDateTime(); updated > newest)
+            newest = updated;
+
+         if (!issueObj.contains("pull_request"))
             issues.append(issueFromJson(issueObj));
       }
    }
    else
       emit errorOccurred(errorStr);
 
+   advanceCursor(mIssuesCursor, newest, QStringLiteral("issues"));
+
    emit issuesReceived(issues);
 
+   /* The comments of every listed issue are prefetched with background priority: the scheduler
+    * paces them and lets interactive requests jump ahead, replacing the old fixed stagger. */
    for (auto &issue : issues)
-      QTimer::singleShot(200, this, [this, num = issue.number]() { requestComments(num); });
+   {
+      sendPaced(RequestPriority::Background, [this, num = issue.number]() {
+         const auto reply = mManager->get(createRequest(mRepoEndpoint + QString("/issues/%1/comments").arg(num)));
+
+         connect(reply, &QNetworkReply::finished, this, [this, num]() { onCommentsReceived(num); });
+      });
+   }
 }
 
 void GitHubRestApi::onCommentsReceived(int issueNumber)
@@ -821,16 +935,16 @@ void GitHubRestApi::onReviewsReceived(int prNumber)
       }
 
       emit commentReviewsReceived(prNumber, reviews);
-
-      QTimer::singleShot(200, this, [this, prNumber]() { requestReviewComments(prNumber); });
    }
 }
 
 void GitHubRestApi::requestReviewComments(int prNumber)
 {
-   const auto reply = mManager->get(createRequest(mRepoEndpoint + QString("/pulls/%1/comments").arg(prNumber)));
+   sendPaced(RequestPriority::Interactive, [this, prNumber]() {
+      const auto reply = mManager->get(createRequest(mRepoEndpoint + QString("/pulls/%1/comments").arg(prNumber)));
 
-   connect(reply, &QNetworkReply::finished, this, [this, prNumber]() { onReviewCommentsReceived(prNumber); });
+      connect(reply, &QNetworkReply::finished, this, [this, prNumber]() { onReviewCommentsReceived(prNumber); });
+   });
 }
 
 void GitHubRestApi::onReviewCommentsReceived(int prNumber)
@@ -934,8 +1048,10 @@ void GitHubRestApi::onCommitsReceived(int prNumber)
 
       QString nextUrl;
       QString lastUrl;
-      auto currentPage = 0;
+      auto nextPage = 0;
+      auto prevPage = 0;
       auto lastPage = 0;
+      auto isFirstPage = true;
 
       for (auto &pair : link)
       {
@@ -948,7 +1064,7 @@ void GitHubRestApi::onCommitsReceived(int prNumber)
             nextUrl.remove(0, 1);
             nextUrl.remove(nextUrl.size() - 1, 1);
 
-            currentPage = nextUrl.split("page=").last().toInt();
+            nextPage = nextUrl.split("page=").last().toInt();
          }
          else if (rel.contains("last"))
          {
@@ -958,22 +1074,50 @@ void GitHubRestApi::onCommitsReceived(int prNumber)
 
             lastPage = lastUrl.split("page=").last().toInt();
          }
+         else if (rel.contains("prev"))
+         {
+            isFirstPage = false;
+
+            auto prevUrl = QString::fromUtf8(page.first().trimmed());
+            prevUrl.remove(0, 1);
+            prevUrl.remove(prevUrl.size() - 1, 1);
+
+            prevPage = prevUrl.split("page=").last().toInt();
+         }
       }
 
-      if (currentPage <= lastPage)
+      // All the remaining pages are requested from the first reply at once: the scheduler bounds
+      // how many travel concurrently and every page inserts its rows as soon as it lands, instead
+      // of each one waiting for the previous reply.
+      if (isFirstPage && !nextUrl.isEmpty())
       {
-         auto request = createRequest(mRepoEndpoint + QString("/pulls/%1/commits").arg(prNumber));
-         request.setUrl(nextUrl);
-         const auto reply = mManager->get(request);
-
-         connect(reply, &QNetworkReply::finished, this, [this, prNumber]() { onCommitsReceived(prNumber); });
+         for (auto page = nextPage; page > 0 && page <= lastPage; ++page)
+         {
+            auto url = QUrl(nextUrl);
+            QUrlQuery query(url);
+            query.removeQueryItem("page");
+            query.addQueryItem("page", QString::number(page));
+            url.setQuery(query);
+
+            sendPaced(RequestPriority::Interactive, [this, prNumber, url]() {
+               auto request = createRequest(mRepoEndpoint + QString("/pulls/%1/commits").arg(prNumber));
+               request.setUrl(url);
+               const auto reply = mManager->get(request);
+
+               connect(reply, &QNetworkReply::finished, this, [this, prNumber]() { onCommitsReceived(prNumber); });
+            });
+         }
       }
 
       std::sort(commits.begin(), commits.end(), [](const Commit &c1, const Commit &c2) {
          return c1.authorCommittedTimestamp < c2.authorCommittedTimestamp;
       });
 
-      emit commitsReceived(prNumber, commits, currentPage, lastPage);
+      // The reported page is the one this reply belongs to, so the cache can merge the pages in
+      // whatever order they land
+      const auto thisPage = isFirstPage ? 1 : prevPage + 1;
+
+      emit commitsReceived(prNumber, commits, thisPage, lastPage > 0 ? lastPage : thisPage);
    }
 }
 
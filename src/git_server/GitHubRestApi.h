@@ -25,6 +25,7 @@
 
 #include <IRestApi.h>
 
+#include <QDateTime>
 #include <QUrl>
 #include <QNetworkRequest>
 
@@ -36,7 +37,7 @@ namespace GitServer
 
 struct Issue;
 
-class GitHubRestApi final : public IRestApi
+class GitHubRestApi : public IRestApi
 {
    Q_OBJECT
 
@@ -65,6 +66,8 @@ public:
 private:
    QString mRepoEndpoint;
    QByteArray mAuthString;
+   QDateTime mIssuesCursor;
+   QDateTime mPullsCursor;
 
    QNetworkRequest createRequest(const QString &page) const override;
    void onLabelsReceived();
@@ -85,6 +88,15 @@ private:
 
    Issue issueFromJson(const QJsonObject &json) const;
    PullRequest prFromJson(const QJsonObject &json) const;
+
+   /**
+    * @brief advanceCursor Moves the given updated-at cursor forward and persists it per repo, so
+    * the next session resumes the incremental sync where this one stopped.
+    * @param cursor The cursor to advance.
+    * @param newest The most recent updated-at value of the last response.
+    * @param kind The settings suffix ("issues" or "pulls").
+    */
+   void advanceCursor(QDateTime &cursor, const QDateTime &newest, const QString &kind);
 };
 
 }
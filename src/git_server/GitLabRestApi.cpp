@@ -37,6 +37,16 @@ GitLabRestApi::GitLabRestApi(const QString &userName, const QString &repoName, c
          ++mPreRequisites;
          getUserInfo();
       }
+
+      /* When both ids come from the settings cache the tab requests can fire right away; the
+       * cached values are revalidated in the background once the startup traffic is on its way. */
+      if (mPreRequisites == 0)
+      {
+         QTimer::singleShot(1000, this, [this]() {
+            getProjects();
+            getUserInfo();
+         });
+      }
    }
 }
 
@@ -200,6 +210,7 @@ QNetworkRequest GitLabRestApi::createRequest(const QString &page) const
    request.setRawHeader("Content-Type", "application/json");
    request.setRawHeader(QByteArray("PRIVATE-TOKEN"),
                         QByteArray(QString(QStringLiteral("%1")).arg(mAuth.userPass).toLocal8Bit()));
+   allowHttp2(request);
 
    return request;
 }
@@ -238,13 +249,16 @@ void GitLabRestApi::onUserInfoReceived()
          GitQlientSettings settings("");
          settings.setGlobalValue(QString("%1/%2-userId").arg(mSettingsKey, mRepoName), mUserId);
 
-         --mPreRequisites;
+         if (mPreRequisites > 0)
+         {
+            --mPreRequisites;
 
-         if (mPreRequisites == 0 && mTestRequested)
-            testConnection();
+            if (mPreRequisites == 0 && mTestRequested)
+               testConnection();
+         }
       }
    }
-   else
+   else if (mPreRequisites > 0)
       emit errorOccurred(errorStr);
 }
 
@@ -276,16 +290,20 @@ void GitLabRestApi::onProjectsReceived()
 
             GitQlientSettings settings("");
             settings.setGlobalValue(QString("%1/%2-repoId").arg(mSettingsKey, mRepoName), mRepoId);
-            --mPreRequisites;
 
-            if (mPreRequisites == 0 && mTestRequested)
-               testConnection();
+            if (mPreRequisites > 0)
+            {
+               --mPreRequisites;
+
+               if (mPreRequisites == 0 && mTestRequested)
+                  testConnection();
+            }
 
             break;
          }
       }
    }
-   else
+   else if (mPreRequisites > 0)
       emit errorOccurred(errorStr);
 }
 
@@ -4,8 +4,10 @@ HEADERS += \
    $$PWD/Comment.h \
    $$PWD/Commit.h \
    $$PWD/ConfigData.h \
+   $$PWD/GitHubGraphQlApi.h \
    $$PWD/GitHubRestApi.h \
    $$PWD/GitLabRestApi.h \
+   $$PWD/GitServerEventFeed.h \
    $$PWD/IRestApi.h \
    $$PWD/Issue.h \
    $$PWD/Label.h \
@@ -15,6 +17,8 @@ HEADERS += \
    $$PWD/User.h
 
 SOURCES += \
+   $$PWD/GitHubGraphQlApi.cpp \
    $$PWD/GitHubRestApi.cpp \
    $$PWD/GitLabRestApi.cpp \
+   $$PWD/GitServerEventFeed.cpp \
    $$PWD/IRestApi.cpp
@@ -0,0 +1,121 @@
+#include "GitServerEventFeed.h"
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QTimer>
+
+#include <QLogger.h>
+
+using namespace QLogger;
+using namespace GitServer;
+
+GitServerEventFeed::GitServerEventFeed(const QString &repoOwner, const QString &repoName,
+                                       const ServerAuthentication &auth, QObject *parent)
+   : QObject(parent)
+   , mManager(new QNetworkAccessManager(this))
+   , mPollTimer(new QTimer(this))
+{
+   auto owner = repoOwner;
+
+   if (owner.endsWith("/"))
+      owner = owner.left(owner.size() - 1);
+
+   if (owner.startsWith("/"))
+      owner = owner.mid(1);
+
+   auto name = repoName;
+
+   if (name.endsWith("/"))
+      name = name.left(name.size() - 1);
+
+   mEventsUrl = QString("%1/repos/%2/%3/events").arg(auth.endpointUrl, owner, name);
+   mAuthString = "Basic "
+       + QByteArray(QString(QStringLiteral("%1:%2")).arg(auth.userName, auth.userPass).toLocal8Bit()).toBase64();
+
+   mPollTimer->setSingleShot(true);
+   connect(mPollTimer, &QTimer::timeout, this, &GitServerEventFeed::poll);
+}
+
+void GitServerEventFeed::start()
+{
+   poll();
+}
+
+void GitServerEventFeed::poll()
+{
+   QNetworkRequest request;
+   request.setUrl(QUrl(mEventsUrl));
+   request.setRawHeader("User-Agent", "GitQlient");
+   request.setRawHeader("Accept", "application/vnd.github.v3+json");
+   request.setRawHeader("Authorization", mAuthString);
+
+   // The conditional request turns an unchanged feed into a 304 that doesn't count against the
+   // API quota, so the listener can poll frequently without burning requests
+   if (!mEtag.isEmpty())
+      request.setRawHeader("If-None-Match", mEtag);
+
+   const auto reply = mManager->get(request);
+
+   connect(reply, &QNetworkReply::finished, this, &GitServerEventFeed::onEventsReceived);
+}
+
+void GitServerEventFeed::onEventsReceived()
+{
+   const auto reply = qobject_cast<QNetworkReply *>(sender());
+   reply->deleteLater();
+
+   auto pollInterval = 60;
+
+   if (const auto interval = reply->rawHeader("X-Poll-Interval").toInt(); interval > 0)
+      pollInterval = interval;
+
+   const auto statusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+
+   if (statusCode == 200)
+   {
+      mEtag = reply->rawHeader("ETag");
+
+      const auto firstPoll = mLastEventId == 0;
+      auto newestId = mLastEventId;
+      const auto events = QJsonDocument::fromJson(reply->readAll()).array();
+
+      for (const auto &event : events)
+      {
+         const auto eventObj = event.toObject();
+         const auto id = eventObj["id"].toString().toLongLong();
+
+         if (id <= mLastEventId)
+            continue;
+
+         if (id > newestId)
+            newestId = id;
+
+         // The first reply only primes the cursor: everything in it predates the session and was
+         // already loaded by the initial fetch
+         if (firstPoll)
+            continue;
+
+         const auto type = eventObj["type"].toString();
+
+         QLog_Trace("Ui", QString("Server event received: %1").arg(type));
+
+         if (type == "IssueCommentEvent")
+            emit issueCommented(eventObj["payload"].toObject()["issue"].toObject()["number"].toInt());
+         else if (type == "IssuesEvent")
+            emit issuesChanged();
+         else if (type == "PullRequestEvent" || type == "PullRequestReviewEvent"
+                  || type == "PullRequestReviewCommentEvent")
+            emit pullRequestsChanged();
+      }
+
+      mLastEventId = newestId;
+   }
+   else if (statusCode != 304)
+      QLog_Warning("Ui", QString("The events feed answered with status %1").arg(statusCode));
+
+   mPollTimer->start(pollInterval * 1000);
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+#include <IRestApi.h>
+
+#include <QObject>
+
+class QNetworkAccessManager;
+class QTimer;
+
+namespace GitServer
+{
+
+/**
+ * @brief The GitServerEventFeed class listens to the repository events API and converts the
+ * events into targeted refresh signals, so the git server tab updates in near real time without
+ * re-fetching everything on a fixed timer. The listener polls with an If-None-Match header: an
+ * unchanged feed answers 304 without consuming API quota, and the poll cadence follows the
+ * X-Poll-Interval the server advertises. Only GitHub exposes this feed; for other platforms the
+ * periodic reload stays as the fallback.
+ */
+class GitServerEventFeed : public QObject
+{
+   Q_OBJECT
+
+signals:
+   /**
+    * @brief issueCommented Signal triggered when a comment was added to an issue or PR, so only
+    * the comments of that item need a refresh.
+    * @param issueNumber The number of the commented issue or PR.
+    */
+   void issueCommented(int issueNumber);
+   /**
+    * @brief issuesChanged Signal triggered when an issue was opened, closed or edited.
+    */
+   void issuesChanged();
+   /**
+    * @brief pullRequestsChanged Signal triggered when a PR or one of its reviews changed.
+    */
+   void pullRequestsChanged();
+
+public:
+   explicit GitServerEventFeed(const QString &repoOwner, const QString &repoName, const ServerAuthentication &auth,
+                               QObject *parent = nullptr);
+
+   /**
+    * @brief start Fires the first poll; the following ones re-arm from the replies.
+    */
+   void start();
+
+private:
+   QNetworkAccessManager *mManager = nullptr;
+   QTimer *mPollTimer = nullptr;
+   QString mEventsUrl;
+   QByteArray mAuthString;
+   QByteArray mEtag;
+   qlonglong mLastEventId = 0;
+
+   void poll();
+   void onEventsReceived();
+};
+
+}
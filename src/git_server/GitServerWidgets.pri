@@ -18,6 +18,7 @@ HEADERS += \
    $$PWD/IssueDetailedView.h \
    $$PWD/IssueItem.h \
    $$PWD/IssuesList.h \
+   $$PWD/MarkdownView.h \
    $$PWD/MergePullRequestDlg.h \
    $$PWD/PrChangeListItem.h \
    $$PWD/PrChangesList.h \
@@ -39,6 +40,7 @@ SOURCES += \
    $$PWD/IssueDetailedView.cpp \
    $$PWD/IssueItem.cpp \
    $$PWD/IssuesList.cpp \
+   $$PWD/MarkdownView.cpp \
    $$PWD/MergePullRequestDlg.cpp \
    $$PWD/PrChangeListItem.cpp \
    $$PWD/PrChangesList.cpp \
@@ -1,21 +1,53 @@
 #include <IRestApi.h>
 
+#include <QDateTime>
 #include <QNetworkAccessManager>
+#include <QNetworkDiskCache>
 #include <QNetworkReply>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
+#include <QStandardPaths>
+#include <QTimer>
 
 #include <QLogger.h>
 
 using namespace QLogger;
 using namespace GitServer;
 
+namespace
+{
+/* An authenticated GitHub token refills at 5000 requests per hour (~1.4/s); the bucket allows
+ * short bursts (opening a PR fans out a handful of requests) while keeping the average below it. */
+constexpr auto BucketCapacity = 10.0;
+constexpr auto RefillPerSecond = 1.4;
+/* Below this many remaining requests the refill is stretched to make the quota last until the
+ * reset instead of exhausting it and stalling the tab completely. */
+constexpr auto LowQuotaThreshold = 100;
+}
+
 IRestApi::IRestApi(const ServerAuthentication &auth, QObject *parent)
    : QObject(parent)
    , mManager(new QNetworkAccessManager())
    , mAuth(auth)
 {
+   // The responses are stored in a persistent disk cache together with their ETag and
+   // Last-Modified headers. On the next refresh the manager revalidates them with conditional
+   // requests, so when the server answers 304 the payload is served from disk: most visits to
+   // the server view become header-only round trips that do not consume the API rate limit.
+   const auto diskCache = new QNetworkDiskCache(mManager);
+   diskCache->setCacheDirectory(
+       QString("%1/network").arg(QStandardPaths::writableLocation(QStandardPaths::CacheLocation)));
+   mManager->setCache(diskCache);
+
+   connect(mManager, &QNetworkAccessManager::finished, this, &IRestApi::updateQuota);
+
+   mTokens = BucketCapacity;
+   mLastRefillMs = QDateTime::currentMSecsSinceEpoch();
+
+   mDispatchTimer = new QTimer(this);
+   mDispatchTimer->setSingleShot(true);
+   connect(mDispatchTimer, &QTimer::timeout, this, &IRestApi::dispatchPaced);
 }
 
 IRestApi::~IRestApi()
@@ -23,6 +55,23 @@ IRestApi::~IRestApi()
    delete mManager;
 }
 
+void IRestApi::warmUpConnection()
+{
+   const QUrl url(mAuth.endpointUrl);
+
+   if (!url.host().isEmpty())
+      mManager->connectToHostEncrypted(url.host(), static_cast<quint16>(url.port(443)));
+}
+
+void IRestApi::allowHttp2(QNetworkRequest &request)
+{
+#if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
+   request.setAttribute(QNetworkRequest::Http2AllowedAttribute, true);
+#else
+   request.setAttribute(QNetworkRequest::HTTP2AllowedAttribute, true);
+#endif
+}
+
 QJsonDocument IRestApi::validateData(QNetworkReply *reply, QString &errorString)
 {
    const auto data = reply->readAll();
@@ -76,3 +125,62 @@ QJsonDocument IRestApi::validateData(QNetworkReply *reply, QString &errorString)
 
    return jsonDoc;
 }
+
+void IRestApi::sendPaced(RequestPriority priority, const std::function<void()> &send)
+{
+   if (priority == RequestPriority::Interactive)
+      mInteractivePending.append(send);
+   else
+      mBackgroundPending.append(send);
+
+   dispatchPaced();
+}
+
+void IRestApi::updateQuota(QNetworkReply *reply)
+{
+   if (reply->hasRawHeader("X-RateLimit-Remaining"))
+      mQuotaRemaining = reply->rawHeader("X-RateLimit-Remaining").toInt();
+
+   if (reply->hasRawHeader("X-RateLimit-Reset"))
+      mQuotaResetMs = reply->rawHeader("X-RateLimit-Reset").toLongLong() * 1000;
+
+   if (mQuotaRemaining == 0)
+   {
+      QLog_Warning("Ui",
+                   QString("Rate limit exhausted. Holding requests until %1.")
+                       .arg(QDateTime::fromMSecsSinceEpoch(mQuotaResetMs).toString(Qt::ISODate)));
+   }
+}
+
+void IRestApi::dispatchPaced()
+{
+   const auto now = QDateTime::currentMSecsSinceEpoch();
+
+   /* With the quota exhausted every send would burn into a guaranteed 403, so everything waits
+    * for the reset. The wait is re-checked every minute in case the clocks disagree. */
+   if (mQuotaRemaining == 0 && now < mQuotaResetMs)
+   {
+      if (!mInteractivePending.isEmpty() || !mBackgroundPending.isEmpty())
+         mDispatchTimer->start(static_cast<int>(qMin(mQuotaResetMs - now, qint64(60000))));
+
+      return;
+   }
+
+   auto refill = RefillPerSecond;
+
+   if (mQuotaRemaining > 0 && mQuotaRemaining < LowQuotaThreshold && mQuotaResetMs > now)
+      refill = qMin(refill, mQuotaRemaining / ((mQuotaResetMs - now) / 1000.0));
+
+   mTokens = qMin(BucketCapacity, mTokens + ((now - mLastRefillMs) / 1000.0) * refill);
+   mLastRefillMs = now;
+
+   while (mTokens >= 1.0 && (!mInteractivePending.isEmpty() || !mBackgroundPending.isEmpty()))
+   {
+      const auto send = !mInteractivePending.isEmpty() ? mInteractivePending.takeFirst() : mBackgroundPending.takeFirst();
+      mTokens -= 1.0;
+      send();
+   }
+
+   if (!mInteractivePending.isEmpty() || !mBackgroundPending.isEmpty())
+      mDispatchTimer->start(static_cast<int>(qMax(1.0, ((1.0 - mTokens) / refill) * 1000.0)));
+}
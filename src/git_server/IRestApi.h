@@ -30,9 +30,13 @@
 #include <QObject>
 #include <QMap>
 #include <QNetworkRequest>
+#include <QVector>
+
+#include <functional>
 
 class QNetworkAccessManager;
 class QNetworkReply;
+class QTimer;
 
 namespace GitServer
 {
@@ -139,6 +143,17 @@ signals:
    void pullRequestUpdated(const GitServer::PullRequest &pr);
 
 public:
+   /**
+    * @brief The RequestPriority enum classifies the scheduled requests. Interactive requests (the
+    * user is waiting for the answer) are dispatched before background ones (prefetches and
+    * revalidations) when the rate limit forces the scheduler to pace the traffic.
+    */
+   enum class RequestPriority
+   {
+      Interactive,
+      Background
+   };
+
    explicit IRestApi(const ServerAuthentication &auth, QObject *parent = nullptr);
    virtual ~IRestApi();
 
@@ -146,6 +161,13 @@ public:
 
    static QJsonDocument validateData(QNetworkReply *reply, QString &errorString);
 
+   /**
+    * @brief warmUpConnection Pre-establishes the TLS session to the configured endpoint, so the
+    * refresh burst that follows shares an already hot connection instead of paying the handshake
+    * round trips first. Called when the git server view becomes visible.
+    */
+   void warmUpConnection();
+
    /**
     * @brief testConnection Tests the connection against the server.
     */
@@ -237,6 +259,43 @@ protected:
     * @return Returns a QNetworkRequest object with the configuration needed by the server.
     */
    virtual QNetworkRequest createRequest(const QString &page) const = 0;
+
+   /**
+    * @brief allowHttp2 Marks the request as HTTP/2 capable, so a burst of requests to the same
+    * server multiplexes over a few connections instead of opening (and re-handshaking) one each.
+    */
+   static void allowHttp2(QNetworkRequest &request);
+
+   /**
+    * @brief sendPaced Schedules the given send through the rate-limit-aware dispatcher. The
+    * dispatcher paces bursts with a token bucket fed by the X-RateLimit headers of the replies:
+    * with quota to spare the send fires immediately, close to the quota edge the refill is
+    * stretched to last until the reset, and with the quota exhausted everything is held back until
+    * the server resets it instead of burning requests on guaranteed 403s.
+    * @param priority Whether the user is waiting for this request.
+    * @param send The closure performing the network send.
+    */
+   void sendPaced(RequestPriority priority, const std::function<void()> &send);
+
+private:
+   QVector<std::function<void()>> mInteractivePending;
+   QVector<std::function<void()>> mBackgroundPending;
+   QTimer *mDispatchTimer = nullptr;
+   double mTokens = 0;
+   qint64 mLastRefillMs = 0;
+   int mQuotaRemaining = -1;
+   qint64 mQuotaResetMs = 0;
+
+   /**
+    * @brief updateQuota Records the X-RateLimit headers of every finished reply.
+    * @param reply The finished reply.
+    */
+   void updateQuota(QNetworkReply *reply);
+   /**
+    * @brief dispatchPaced Refills the token bucket and fires as many pending sends as the tokens
+    * allow, interactive ones first. Re-arms the dispatch timer when sends remain queued.
+    */
+   void dispatchPaced();
 };
 
 }
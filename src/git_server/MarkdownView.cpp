@@ -0,0 +1,104 @@
+#include "MarkdownView.h"
+
+#include <GitQlientSettings.h>
+#include <PerfProfiler.h>
+#include <document.h>
+#include <previewpage.h>
+
+#include <QUrl>
+#include <QWebChannel>
+
+namespace
+{
+/* Enough bundles for the bubbles of a viewport; anything beyond is destroyed on release instead
+   of keeping a renderer process alive. */
+constexpr auto MaxPooledBundles = 8;
+}
+
+/**
+ * @brief The Bundle struct groups the page, the channel and the Document of one renderer. The page keeps the preview
+ * html loaded between uses, so reusing a bundle only swaps the Document content.
+ */
+struct MarkdownView::Bundle
+{
+   PreviewPage *page = nullptr;
+   QWebChannel *channel = nullptr;
+   Document *document = nullptr;
+};
+
+MarkdownView::MarkdownView(QWidget *parent)
+   : QWebEngineView(parent)
+   , mBundle(acquireBundle())
+{
+   setPage(mBundle->page);
+   setFixedHeight(20);
+
+   connect(mBundle->page, &PreviewPage::contentsSizeChanged, this,
+           [this](const QSizeF size) { setFixedHeight(size.height()); });
+}
+
+MarkdownView::~MarkdownView()
+{
+   setPage(nullptr);
+   releaseBundle(mBundle);
+}
+
+void MarkdownView::setMarkdown(const QString &text)
+{
+   mBundle->document->setText(text);
+}
+
+void MarkdownView::prewarm(int count)
+{
+   while (pool().count() < count)
+      pool().append(createBundle());
+}
+
+QVector<MarkdownView::Bundle *> &MarkdownView::pool()
+{
+   static QVector<Bundle *> bundles;
+   return bundles;
+}
+
+MarkdownView::Bundle *MarkdownView::createBundle()
+{
+   // The first bundle boots the whole web-engine runtime; the scope makes that deferred cost
+   // visible in the perf HUD, which is also the time saved at startup by not paying it eagerly
+   PerfScopedTimer timer("MarkdownView::createBundle", "ui");
+
+   const auto bundle = new Bundle();
+   bundle->page = new PreviewPage();
+   bundle->document = new Document(bundle->page);
+   bundle->channel = new QWebChannel(bundle->page);
+   bundle->channel->registerObject(QStringLiteral("content"), bundle->document);
+   bundle->page->setWebChannel(bundle->channel);
+
+   GitQlientSettings settings("");
+   const auto colorSchema = settings.globalValue("colorSchema", "dark").toString();
+   const auto style = colorSchema == "dark" ? QString::fromUtf8("dark") : QString::fromUtf8("bright");
+
+   bundle->page->setUrl(QUrl(QString("qrc:/resources/index_%1.html").arg(style)));
+
+   return bundle;
+}
+
+MarkdownView::Bundle *MarkdownView::acquireBundle()
+{
+   if (!pool().isEmpty())
+      return pool().takeLast();
+
+   return createBundle();
+}
+
+void MarkdownView::releaseBundle(Bundle *bundle)
+{
+   bundle->document->setText(QString());
+
+   if (pool().count() < MaxPooledBundles)
+      pool().append(bundle);
+   else
+   {
+      delete bundle->page;
+      delete bundle;
+   }
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+#include <QVector>
+#include <QWebEngineView>
+
+/**
+ * @brief The MarkdownView class shows a rendered markdown text. The view draws its page, channel and Document binding
+ * from a shared pool of renderer bundles that keep the preview html loaded, so creating a view for a comment bubble
+ * swaps the Document content of a warm renderer instead of spinning up fresh web-engine machinery. Destroyed views
+ * return their bundle to the pool.
+ *
+ * The view fixes its own height to the rendered content, so it can be dropped into any vertical layout.
+ */
+class MarkdownView : public QWebEngineView
+{
+   Q_OBJECT
+
+public:
+   /**
+    * @brief Default constructor. Acquires a renderer bundle from the pool, creating one if none is available.
+    *
+    * @param parent The parent widget if needed.
+    */
+   explicit MarkdownView(QWidget *parent = nullptr);
+   /**
+    * @brief Destructor. Returns the renderer bundle to the pool for the next view.
+    */
+   ~MarkdownView() override;
+
+   /**
+    * @brief Sets the markdown text to render.
+    *
+    * @param text The markdown text.
+    */
+   void setMarkdown(const QString &text);
+
+   /**
+    * @brief Creates up to @p count renderer bundles and starts loading their preview page, so the first thread opened
+    * does not pay the web-engine initialization.
+    *
+    * @param count The number of bundles to prepare.
+    */
+   static void prewarm(int count);
+
+private:
+   struct Bundle;
+
+   Bundle *mBundle = nullptr;
+
+   static QVector<Bundle *> &pool();
+   static Bundle *createBundle();
+   static Bundle *acquireBundle();
+   static void releaseBundle(Bundle *bundle);
+};
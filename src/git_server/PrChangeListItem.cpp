@@ -12,17 +12,15 @@ using namespace DiffHelper;
 
 PrChangeListItem::PrChangeListItem(DiffChange change, QWidget *parent)
    : QFrame(parent)
-   , mNewFileStartingLine(change.newFileStartLine)
-   , mOldFileName(change.oldFileName)
-   , mNewFileName(change.newFileName)
+   , mChange(std::move(change))
+   , mNewFileStartingLine(mChange.newFileStartLine)
+   , mOldFileName(mChange.oldFileName)
+   , mNewFileName(mChange.newFileName)
 {
    setObjectName("PrChangeListItem");
 
-   DiffHelper::processDiff(change.content, change.newData, change.oldData);
-
-   const auto fileName = change.oldFileName == change.newFileName
-       ? change.newFileName
-       : QString("%1 -> %2").arg(change.oldFileName, change.newFileName);
+   const auto fileName = mOldFileName == mNewFileName ? mNewFileName
+                                                      : QString("%1 -> %2").arg(mOldFileName, mNewFileName);
 
    const auto fileNameLabel = new QLabel(fileName);
    fileNameLabel->setObjectName("ChangeFileName");
@@ -35,59 +33,83 @@ PrChangeListItem::PrChangeListItem(DiffChange change, QWidget *parent)
    headerFrame->setObjectName("ChangeHeaderFrame");
    headerFrame->setLayout(headerLayout);
 
-   const auto mainLayout = new QVBoxLayout(this);
-   mainLayout->setContentsMargins(QMargins());
-   mainLayout->setSpacing(0);
-   mainLayout->addWidget(headerFrame);
+   mMainLayout = new QVBoxLayout(this);
+   mMainLayout->setContentsMargins(QMargins());
+   mMainLayout->setSpacing(0);
+   mMainLayout->addWidget(headerFrame);
 
-   if (!change.header.isEmpty())
+   if (!mChange.header.isEmpty())
    {
-      const auto headerLabel = new QLabel(change.header);
+      const auto headerLabel = new QLabel(mChange.header);
       headerLabel->setObjectName("ChangeHeader");
       headerLayout->addWidget(headerLabel);
-
-      mNewFileEndingLine = mNewFileStartingLine + change.newData.first.count();
-
-      const auto oldFile = new FileDiffView();
-      const auto numberArea = new LineNumberArea(oldFile, true);
-      numberArea->setObjectName("LineNumberArea");
-      numberArea->setEditor(oldFile);
-      connect(numberArea, &LineNumberArea::addComment, this, &PrChangeListItem::openReviewDialog);
-
-      oldFile->setStartingLine(change.oldFileStartLine - 1);
-      oldFile->loadDiff(change.oldData.first.join("\n").trimmed(), change.oldData.second);
-      oldFile->addNumberArea(numberArea);
-      oldFile->setMinimumWidth(590);
-      oldFile->show();
-      oldFile->setMinimumHeight(oldFile->getHeight());
-
-      mNewFileDiff = new FileDiffView();
-      mNewNumberArea = new LineNumberArea(mNewFileDiff, true);
-      mNewNumberArea->setObjectName("LineNumberArea");
-      mNewNumberArea->setEditor(mNewFileDiff);
-      connect(mNewNumberArea, &LineNumberArea::addComment, this, &PrChangeListItem::openReviewDialog);
-
-      mNewFileDiff->setStartingLine(change.newFileStartLine - 1);
-      mNewFileDiff->loadDiff(change.newData.first.join("\n").trimmed(), change.newData.second);
-      mNewFileDiff->addNumberArea(mNewNumberArea);
-      mNewFileDiff->setMinimumWidth(590);
-      mNewFileDiff->show();
-      mNewFileDiff->setMinimumHeight(mNewFileDiff->getHeight());
-
-      const auto diffLayout = new QHBoxLayout();
-      diffLayout->setContentsMargins(QMargins());
-      diffLayout->setSpacing(5);
-      diffLayout->addWidget(oldFile);
-      diffLayout->addWidget(mNewFileDiff);
-      mainLayout->addLayout(diffLayout);
-
-      connect(mNewNumberArea, &LineNumberArea::gotoReview, this, &PrChangeListItem::gotoReview);
    }
 }
 
+void PrChangeListItem::loadDiffContent()
+{
+   if (mDiffLoaded || mChange.header.isEmpty())
+      return;
+
+   mDiffLoaded = true;
+
+   DiffHelper::processDiff(mChange.content, mChange.newData, mChange.oldData);
+
+   mNewFileEndingLine = mNewFileStartingLine + mChange.newData.first.count();
+
+   const auto oldFile = new FileDiffView();
+   const auto numberArea = new LineNumberArea(oldFile, true);
+   numberArea->setObjectName("LineNumberArea");
+   numberArea->setEditor(oldFile);
+   connect(numberArea, &LineNumberArea::addComment, this, &PrChangeListItem::openReviewDialog);
+
+   oldFile->setStartingLine(mChange.oldFileStartLine - 1);
+   oldFile->loadDiff(mChange.oldData.first.join("\n").trimmed(), mChange.oldData.second);
+   oldFile->addNumberArea(numberArea);
+   oldFile->setMinimumWidth(590);
+   oldFile->show();
+   oldFile->setMinimumHeight(oldFile->getHeight());
+
+   mNewFileDiff = new FileDiffView();
+   mNewNumberArea = new LineNumberArea(mNewFileDiff, true);
+   mNewNumberArea->setObjectName("LineNumberArea");
+   mNewNumberArea->setEditor(mNewFileDiff);
+   connect(mNewNumberArea, &LineNumberArea::addComment, this, &PrChangeListItem::openReviewDialog);
+
+   mNewFileDiff->setStartingLine(mChange.newFileStartLine - 1);
+   mNewFileDiff->loadDiff(mChange.newData.first.join("\n").trimmed(), mChange.newData.second);
+   mNewFileDiff->addNumberArea(mNewNumberArea);
+   mNewFileDiff->setMinimumWidth(590);
+   mNewFileDiff->show();
+   mNewFileDiff->setMinimumHeight(mNewFileDiff->getHeight());
+
+   const auto diffLayout = new QHBoxLayout();
+   diffLayout->setContentsMargins(QMargins());
+   diffLayout->setSpacing(5);
+   diffLayout->addWidget(oldFile);
+   diffLayout->addWidget(mNewFileDiff);
+   mMainLayout->addLayout(diffLayout);
+
+   connect(mNewNumberArea, &LineNumberArea::gotoReview, this, &PrChangeListItem::gotoReview);
+}
+
+int PrChangeListItem::getEndingLine() const
+{
+   if (mDiffLoaded)
+      return mNewFileEndingLine;
+
+   /* Estimated from the raw chunk until the diff is parsed. It overshoots by the removed lines,
+    * which is good enough to decide whether a bookmark belongs to this file section. */
+   return mNewFileStartingLine + mChange.content.count(QLatin1Char('\n'));
+}
+
 void PrChangeListItem::setBookmarks(const QMap<int, int> &bookmarks)
 {
-   mNewNumberArea->setCommentBookmarks(bookmarks);
+   /* A bookmarked section is worth showing even if the user didn't scroll to it yet. */
+   loadDiffContent();
+
+   if (mNewNumberArea)
+      mNewNumberArea->setCommentBookmarks(bookmarks);
 }
 
 void PrChangeListItem::openReviewDialog(int line)
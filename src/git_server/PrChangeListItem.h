@@ -1,14 +1,12 @@
 #pragma once
 
-#include <QFrame>
+#include <DiffHelper.h>
 
-namespace DiffHelper
-{
-struct DiffChange;
-}
+#include <QFrame>
 
 class LineNumberArea;
 class FileDiffView;
+class QVBoxLayout;
 
 class PrChangeListItem : public QFrame
 {
@@ -21,16 +19,31 @@ signals:
 public:
    explicit PrChangeListItem(DiffHelper::DiffChange change, QWidget *parent = nullptr);
 
+   /**
+    * @brief loadDiffContent Parses the diff chunk and builds the side-by-side views. The
+    * constructor only builds the header, so the changes list can instantiate hundreds of rows
+    * cheaply and fill them when they become visible.
+    */
+   void loadDiffContent();
+   /**
+    * @brief diffLoaded Tells whether the diff content was already parsed and built.
+    * @return True if the content is built.
+    */
+   bool diffLoaded() const { return mDiffLoaded; }
+
    void setBookmarks(const QMap<int, int> &bookmarks);
    int getStartingLine() const { return mNewFileStartingLine; }
-   int getEndingLine() const { return mNewFileEndingLine; }
+   int getEndingLine() const;
    QString getFileName() const { return mNewFileName; }
 
 private:
+   DiffHelper::DiffChange mChange;
+   bool mDiffLoaded = false;
    int mNewFileStartingLine = 0;
    int mNewFileEndingLine = 0;
    QString mOldFileName;
    QString mNewFileName;
+   QVBoxLayout *mMainLayout = nullptr;
    FileDiffView *mNewFileDiff = nullptr;
    LineNumberArea *mNewNumberArea = nullptr;
 
@@ -12,6 +12,8 @@
 #include <QGridLayout>
 #include <QLabel>
 #include <QScrollArea>
+#include <QScrollBar>
+#include <QTimer>
 
 using namespace GitServer;
 using namespace QLogger;
@@ -82,6 +84,10 @@ void PrChangesList::loadData(const GitServer::PullRequest &prInfo)
 
       if (!changes.isEmpty())
       {
+         delete mScroll;
+         mScroll = nullptr;
+         mListItems.clear();
+
          delete layout();
 
          const auto mainLayout = new QVBoxLayout();
@@ -104,18 +110,44 @@ void PrChangesList::loadData(const GitServer::PullRequest &prInfo)
          mIssuesFrame->setObjectName("IssuesViewFrame");
          mIssuesFrame->setLayout(mainLayout);
 
-         const auto mScroll = new QScrollArea();
+         mScroll = new QScrollArea();
          mScroll->setWidgetResizable(true);
          mScroll->setWidget(mIssuesFrame);
 
+         connect(mScroll->verticalScrollBar(), &QScrollBar::valueChanged, this, &PrChangesList::loadVisibleItems);
+
          const auto aLayout = new QVBoxLayout(this);
          aLayout->setContentsMargins(QMargins());
          aLayout->setSpacing(0);
          aLayout->addWidget(mScroll);
+
+         /* The geometry of the rows is only valid once the layout run finished. */
+         QTimer::singleShot(0, this, &PrChangesList::loadVisibleItems);
       }
    }
 }
 
+void PrChangesList::loadVisibleItems()
+{
+   if (!mScroll)
+      return;
+
+   const auto viewport = mScroll->viewport();
+   /* The margin preloads the rows right after the visible ones so scrolling doesn't stutter. */
+   const auto visibleRect = QRect(QPoint(), viewport->size()).adjusted(0, 0, 0, viewport->height());
+
+   for (const auto item : qAsConst(mListItems))
+   {
+      if (item->diffLoaded())
+         continue;
+
+      const auto itemRect = QRect(item->mapTo(viewport, QPoint()), item->size());
+
+      if (visibleRect.intersects(itemRect))
+         item->loadDiffContent();
+   }
+}
+
 void PrChangesList::onReviewsReceived(PullRequest pr)
 {
    using Bookmark = QPair<int, int>;
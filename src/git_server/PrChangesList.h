@@ -29,6 +29,7 @@
 class GitBase;
 class FileDiffView;
 class PrChangeListItem;
+class QScrollArea;
 
 namespace GitServer
 {
@@ -56,4 +57,12 @@ private:
    FileDiffView *mOldFile = nullptr;
    FileDiffView *mNewFile = nullptr;
    QVector<PrChangeListItem *> mListItems;
+   QScrollArea *mScroll = nullptr;
+
+   /**
+    * @brief loadVisibleItems Builds the diff content of the rows currently inside the scroll
+    * viewport. The rows are created as cheap headers, so opening the view doesn't depend on how
+    * many files the pull request touches.
+    */
+   void loadVisibleItems();
 };
@@ -9,8 +9,7 @@
 #include <CodeReviewComment.h>
 #include <ButtonLink.hpp>
 #include <Colors.h>
-#include <previewpage.h>
-#include <GitQlientSettings.h>
+#include <MarkdownView.h>
 
 #include <QNetworkAccessManager>
 #include <QVBoxLayout>
@@ -26,11 +25,16 @@
 #include <QPushButton>
 #include <QIcon>
 #include <QScrollBar>
-#include <QWebChannel>
-#include <QWebEngineView>
 
 using namespace GitServer;
 
+namespace
+{
+/* Roughly a viewport of bubbles: enough to fill the visible area on open while keeping the number
+   of web views instantiated per step small. */
+constexpr auto BubbleBatchSize = 10;
+}
+
 PrCommentsList::PrCommentsList(const QSharedPointer<GitServerCache> &gitServerCache, QWidget *parent)
    : QFrame(parent)
    , mMutex(QMutex::Recursive)
@@ -49,11 +53,23 @@ void PrCommentsList::loadData(PrCommentsList::Config config, int issueNumber)
 {
    QMutexLocker lock(&mMutex);
 
+   /* The web engine is only brought up when a thread is actually opened: a couple of warm
+    * renderers cover the description and first comment, while history-only sessions never pay for
+    * the browser runtime. */
+   MarkdownView::prewarm(2);
+
    connect(mGitServerCache.get(), &GitServerCache::issueUpdated, this, &PrCommentsList::processComments,
            Qt::UniqueConnection);
    connect(mGitServerCache.get(), &GitServerCache::prReviewsReceived, this, &PrCommentsList::onReviewsReceived,
            Qt::UniqueConnection);
 
+   /* The cached bubbles only make sense while the same thread is shown: reopening it reuses them,
+    * opening another one renders from scratch. */
+   if (mIssueNumber != issueNumber)
+      clearBubblesCache();
+   else
+      detachCachedBubbles();
+
    mConfig = config;
    mIssueNumber = issueNumber;
 
@@ -65,6 +81,9 @@ void PrCommentsList::loadData(PrCommentsList::Config config, int issueNumber)
    delete layout();
 
    mCommentsFrame = nullptr;
+   mCommentsLayout = nullptr;
+   mPendingBubbles.clear();
+   mHasPendingLinks = false;
 
    mIssuesLayout = new QVBoxLayout();
    mIssuesLayout->setContentsMargins(QMargins());
@@ -130,6 +149,17 @@ void PrCommentsList::loadData(PrCommentsList::Config config, int issueNumber)
    mScroll->setWidgetResizable(true);
    mScroll->setWidget(mIssuesFrame);
 
+   // The queued bubbles are instantiated as the user approaches the bottom; the range connection
+   // tops up threads whose first batch does not fill the viewport
+   connect(mScroll->verticalScrollBar(), &QScrollBar::valueChanged, this, [this](int value) {
+      if (value >= mScroll->verticalScrollBar()->maximum() - mScroll->verticalScrollBar()->pageStep())
+         appendPendingBubbles(BubbleBatchSize);
+   });
+   connect(mScroll->verticalScrollBar(), &QScrollBar::rangeChanged, this, [this](int, int max) {
+      if (mScroll->verticalScrollBar()->value() >= max - mScroll->verticalScrollBar()->pageStep())
+         appendPendingBubbles(BubbleBatchSize);
+   });
+
    const auto aLayout = new QVBoxLayout(this);
    aLayout->setContentsMargins(QMargins());
    aLayout->setSpacing(0);
@@ -212,28 +242,8 @@ void PrCommentsList::loadData(PrCommentsList::Config config, int issueNumber)
    const auto bodyDescLayout = new QVBoxLayout(bodyDescFrame);
    bodyDescLayout->setContentsMargins(10, 10, 10, 10);
 
-   GitQlientSettings settings("");
-   const auto colorSchema = settings.globalValue("colorSchema", "dark").toString();
-   const auto style = colorSchema == "dark" ? QString::fromUtf8("dark") : QString::fromUtf8("bright");
-
-   QPointer<QWebEngineView> body = new QWebEngineView();
-
-   PreviewPage *page = new PreviewPage(this);
-   body->setPage(page);
-
-   QWebChannel *channel = new QWebChannel(this);
-   channel->registerObject(QStringLiteral("content"), &m_content);
-   page->setWebChannel(channel);
-
-   body->setUrl(QUrl(QString("qrc:/resources/index_%1.html").arg(style)));
-   body->setFixedHeight(20);
-
-   connect(page, &PreviewPage::contentsSizeChanged, this, [body](const QSizeF size) {
-      if (body)
-         body->setFixedHeight(size.height());
-   });
-
-   m_content.setText(QString::fromUtf8(issue.body));
+   const auto body = new MarkdownView();
+   body->setMarkdown(QString::fromUtf8(issue.body));
 
    bodyDescLayout->addWidget(body);
    layout->addWidget(bodyDescFrame);
@@ -291,23 +301,33 @@ void PrCommentsList::processComments(const Issue &issue)
    if (mIssueNumber != issue.number)
       return;
 
+   detachCachedBubbles();
+
    delete mCommentsFrame;
 
    mCommentsFrame = new QFrame();
 
    mIssuesLayout->addWidget(mCommentsFrame);
 
-   const auto commentsLayout = new QVBoxLayout(mCommentsFrame);
-   commentsLayout->setContentsMargins(QMargins());
-   commentsLayout->setSpacing(30);
+   mCommentsLayout = new QVBoxLayout(mCommentsFrame);
+   mCommentsLayout->setContentsMargins(QMargins());
+   mCommentsLayout->setSpacing(30);
+   mCommentsLayout->addStretch();
 
-   for (auto &comment : issue.comments)
+   mPendingBubbles.clear();
+   mHasPendingLinks = false;
+
+   for (const auto &comment : issue.comments)
    {
-      const auto layout = createBubbleForComment(comment);
-      commentsLayout->addLayout(layout);
+      mPendingBubbles.append([this, comment]() -> QLayout * {
+         const auto layout = new QHBoxLayout();
+         layout->setContentsMargins(QMargins());
+         layout->addWidget(bubbleForComment(comment));
+         return layout;
+      });
    }
 
-   commentsLayout->addStretch();
+   appendPendingBubbles(BubbleBatchSize);
 }
 
 QLabel *PrCommentsList::createHeadline(const QDateTime &dt, const QString &prefix)
@@ -333,50 +353,127 @@ void PrCommentsList::onReviewsReceived()
 
    const auto originalPr = pr;
 
-   QMultiMap<QDateTime, QLayout *> bubblesMap;
+   /* The cached bubbles are reused below, so they have to leave the frame before it is deleted. */
+   detachCachedBubbles();
+
+   /* The builders are queued in chronological order but only instantiated on demand. The code
+      reviews of a review are extracted from a copy shared across the builders, mirroring how the
+      eager loop consumed pr.reviewComment. */
+   QMultiMap<QDateTime, std::function<QLayout *()>> bubblesMap;
 
    for (const auto &comment : qAsConst(pr.comments))
    {
-      const auto layout = createBubbleForComment(comment);
-      bubblesMap.insert(comment.creation, layout);
+      bubblesMap.insert(comment.creation, [this, comment]() -> QLayout * {
+         const auto layout = new QHBoxLayout();
+         layout->setContentsMargins(QMargins());
+         layout->addWidget(bubbleForComment(comment));
+         return layout;
+      });
    }
 
+   const auto reviewComments = QSharedPointer<QVector<CodeReview>>::create(pr.reviewComment);
+
    for (const auto &review : qAsConst(pr.reviews))
    {
-      const auto layouts = new QVBoxLayout();
-
-      const auto reviewLayout = createBubbleForReview(review);
+      bubblesMap.insert(review.creation, [this, review, reviewComments]() -> QLayout * {
+         const auto layouts = new QVBoxLayout();
 
-      if (reviewLayout)
-         layouts->addLayout(reviewLayout);
+         if (const auto reviewLayout = createBubbleForReview(review))
+            layouts->addLayout(reviewLayout);
 
-      auto codeReviewsLayouts = createBubbleForCodeReview(review.id, pr.reviewComment);
+         const auto codeReviewsLayouts = createBubbleForCodeReview(review.id, *reviewComments);
 
-      for (auto layout : codeReviewsLayouts)
-         layouts->addLayout(layout);
+         for (const auto layout : codeReviewsLayouts)
+            layouts->addLayout(layout);
 
-      bubblesMap.insert(review.creation, layouts);
+         return layouts;
+      });
    }
 
    delete mCommentsFrame;
    mCommentsFrame = new QFrame();
 
-   const auto reviewsLayout = new QVBoxLayout(mCommentsFrame);
-   reviewsLayout->setContentsMargins(QMargins());
-   reviewsLayout->setSpacing(30);
+   mCommentsLayout = new QVBoxLayout(mCommentsFrame);
+   mCommentsLayout->setContentsMargins(QMargins());
+   mCommentsLayout->setSpacing(30);
+   mCommentsLayout->addStretch();
 
-   for (auto layout : bubblesMap)
+   mPendingBubbles = bubblesMap.values().toVector();
+   mPendingPr = originalPr;
+   mHasPendingLinks = true;
+
+   mIssuesLayout->addWidget(mCommentsFrame);
+
+   if (mPendingBubbles.isEmpty())
+      emit frameReviewLink(originalPr, mFrameLinks);
+   else
+      appendPendingBubbles(BubbleBatchSize);
+}
+
+void PrCommentsList::appendPendingBubbles(int count)
+{
+   if (!mCommentsLayout || mPendingBubbles.isEmpty())
+      return;
+
+   auto appended = false;
+
+   while (count-- > 0 && !mPendingBubbles.isEmpty())
    {
-      if (layout)
-         reviewsLayout->addLayout(layout);
+      const auto builder = mPendingBubbles.takeFirst();
+
+      if (const auto layout = builder())
+      {
+         // New bubbles land before the trailing stretch so the thread keeps growing downwards
+         mCommentsLayout->insertLayout(mCommentsLayout->count() - 1, layout);
+         appended = true;
+      }
    }
 
-   reviewsLayout->addStretch();
-   reviewsLayout->addItem(new QSpacerItem(1, 1, QSizePolicy::Fixed, QSizePolicy::Expanding));
+   /* The links of freshly built code-review frames are re-announced so the changes view gains
+      their bookmarks as the thread unfolds. */
+   if (appended && mHasPendingLinks)
+      emit frameReviewLink(mPendingPr, mFrameLinks);
+}
 
-   emit frameReviewLink(originalPr, mFrameLinks);
+QFrame *PrCommentsList::bubbleForComment(const Comment &comment)
+{
+   const auto bodyHash = qHash(comment.body);
+   const auto iter = mBubblesCache.constFind(comment.id);
 
-   mIssuesLayout->addWidget(mCommentsFrame);
+   if (iter != mBubblesCache.constEnd() && iter->first == bodyHash)
+   {
+      iter->second->show();
+      return iter->second;
+   }
+
+   if (iter != mBubblesCache.constEnd())
+      delete iter->second;
+
+   const auto bubble = new QFrame();
+   const auto layout = createBubbleForComment(comment);
+   layout->setContentsMargins(QMargins());
+   bubble->setLayout(layout);
+
+   mBubblesCache.insert(comment.id, qMakePair(bodyHash, bubble));
+
+   return bubble;
+}
+
+void PrCommentsList::detachCachedBubbles()
+{
+   for (const auto &bubble : qAsConst(mBubblesCache))
+   {
+      bubble.second->hide();
+      bubble.second->setParent(this);
+   }
+}
+
+void PrCommentsList::clearBubblesCache()
+{
+   for (const auto &bubble : qAsConst(mBubblesCache))
+      delete bubble.second;
+
+   mBubblesCache.clear();
 }
 
 QLayout *PrCommentsList::createBubbleForComment(const Comment &comment)
@@ -394,31 +491,8 @@ QLayout *PrCommentsList::createBubbleForComment(const Comment &comment)
    creationLayout->addStretch();
    creationLayout->addWidget(new QLabel(comment.association));
 
-   GitQlientSettings settings("");
-   const auto colorSchema = settings.globalValue("colorSchema", "dark").toString();
-   const auto style = colorSchema == "dark" ? QString::fromUtf8("dark") : QString::fromUtf8("bright");
-
-   const auto doc = new Document(this);
-   m_commentContents.append(doc);
-
-   const auto channel = new QWebChannel(this);
-   channel->registerObject(QStringLiteral("content"), doc);
-
-   const auto page = new PreviewPage(this);
-   page->setWebChannel(channel);
-
-   QPointer<QWebEngineView> body = new QWebEngineView();
-
-   connect(page, &PreviewPage::contentsSizeChanged, this, [body](const QSizeF size) {
-      if (body)
-         body->setFixedHeight(size.height());
-   });
-
-   body->setPage(page);
-   body->setUrl(QUrl(QString("qrc:/resources/index_%1.html").arg(style)));
-   body->setFixedHeight(20);
-
-   doc->setText(comment.body.trimmed());
+   const auto body = new MarkdownView();
+   body->setMarkdown(comment.body.trimmed());
 
    const auto frame = new QFrame();
    frame->setObjectName("IssueIntro");
@@ -25,11 +25,12 @@
 
 #include <Issue.h>
 #include <GitServerCache.h>
-#include <document.h>
 
 #include <QFrame>
 #include <QMutex>
 
+#include <functional>
+
 namespace GitServer
 {
 struct Issue;
@@ -84,6 +85,10 @@ private:
    QSharedPointer<GitServerCache> mGitServerCache = nullptr;
    QNetworkAccessManager *mManager = nullptr;
    QFrame *mCommentsFrame = nullptr;
+   QVBoxLayout *mCommentsLayout = nullptr;
+   QVector<std::function<QLayout *()>> mPendingBubbles;
+   GitServer::PullRequest mPendingPr;
+   bool mHasPendingLinks = false;
    QVBoxLayout *mIssuesLayout = nullptr;
    QFrame *mIssuesFrame = nullptr;
    QFrame *mInputFrame = nullptr;
@@ -95,12 +100,35 @@ private:
    QMap<int, QFrame *> mComments {};
    QMap<int, int> mFrameLinks {};
    inline static int mCommentId = 0;
-   Document m_content;
-   QVector<Document *> m_commentContents;
+   QHash<int, QPair<uint, QFrame *>> mBubblesCache;
 
    void processComments(const GitServer::Issue &issue);
+   /**
+    * @brief appendPendingBubbles Instantiates up to @p count of the queued bubble builders and appends them to the
+    * thread. The rest of the conversation stays queued until the user scrolls near the bottom, so opening a thread
+    * only renders the first viewport instead of years of discussion.
+    * @param count The maximum number of bubbles to instantiate.
+    */
+   void appendPendingBubbles(int count);
    QLabel *createHeadline(const QDateTime &dt, const QString &prefix = QString());
    void onReviewsReceived();
+   /**
+    * @brief bubbleForComment Returns the rendered bubble of the given comment. Bubbles are cached
+    * by comment id and body hash, so rebuilding the thread only pushes new or edited comments
+    * through the markdown view and reopening a long thread reuses everything.
+    * @param comment The comment to render.
+    * @return The frame holding the rendered comment.
+    */
+   QFrame *bubbleForComment(const GitServer::Comment &comment);
+   /**
+    * @brief detachCachedBubbles Reparents the cached bubbles out of the thread frame about to be
+    * destroyed so they survive the rebuild.
+    */
+   void detachCachedBubbles();
+   /**
+    * @brief clearBubblesCache Deletes the cached bubbles. Called when a different thread is loaded.
+    */
+   void clearBubblesCache();
    QLayout *createBubbleForComment(const GitServer::Comment &comment);
    QLayout *createBubbleForReview(const GitServer::Review &review);
    QVector<QLayout *> createBubbleForCodeReview(int reviewId, QVector<GitServer::CodeReview> &comments);
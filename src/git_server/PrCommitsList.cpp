@@ -46,8 +46,8 @@ void PrCommitsList::loadData(int number)
 
 void PrCommitsList::onCommitsReceived(const GitServer::PullRequest &pr)
 {
-   disconnect(mGitServerCache.get(), &GitServerCache::prUpdated, this, &PrCommitsList::onCommitsReceived);
-
+   // The connection stays alive while the commit pages stream in: every page that lands rebuilds
+   // the list, so long release PRs fill progressively instead of appearing all at once
    if (mPrNumber != pr.number)
       return;
 
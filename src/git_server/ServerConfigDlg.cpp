@@ -63,6 +63,7 @@ ServerConfigDlg::ServerConfigDlg(const QSharedPointer<GitServerCache> &gitServer
    ui->leUserToken->setText(mData.token);
    ui->leEndPoint->setText(
        settings.globalValue(QString("%1/endpoint").arg(mData.serverUrl), repoUrls.value(GitHub)).toString());
+   ui->chbGraphQl->setChecked(settings.globalValue(QString("%1/graphql").arg(mData.serverUrl), false).toBool());
 
    ui->cbServer->insertItem(GitHub, "GitHub", repoUrls.value(GitHub));
    ui->cbServer->insertItem(GitHubEnterprise, "GitHub Enterprise", repoUrls.value(GitHubEnterprise));
@@ -77,6 +78,7 @@ ServerConfigDlg::ServerConfigDlg(const QSharedPointer<GitServerCache> &gitServer
       ui->cbServer->insertItem(GitLab, "GitLab", repoUrls.value(GitLab));
       ui->cbServer->setCurrentIndex(GitLab);
       ui->cbServer->setVisible(false);
+      ui->chbGraphQl->setVisible(false);
    }
 
    ui->lAccessToken->setText(tr("How to get a token?"));
@@ -114,6 +116,8 @@ void ServerConfigDlg::accept()
    settings.setGlobalValue(QString("%1/user").arg(mData.serverUrl), ui->leUserName->text());
    settings.setGlobalValue(QString("%1/token").arg(mData.serverUrl), ui->leUserToken->text());
    settings.setGlobalValue(QString("%1/endpoint").arg(mData.serverUrl), endpoint);
+   settings.setGlobalValue(QString("%1/graphql").arg(mData.serverUrl),
+                           ui->chbGraphQl->isVisible() && ui->chbGraphQl->isChecked());
 
    connect(mGitServerCache.get(), &GitServerCache::errorOccurred, this, &ServerConfigDlg::onGitServerError);
    connect(mGitServerCache.get(), &GitServerCache::connectionTested, this, [this]() { onDataValidated(); });
@@ -7,15 +7,20 @@
 #include <GitBase.h>
 #include <GitBranches.h>
 #include <GitCache.h>
+#include <GitConfig.h>
 #include <GitHubRestApi.h>
 #include <GitLocal.h>
+#include <GitOperationRunner.h>
 #include <GitPatches.h>
+#include <GitQlientSettings.h>
 #include <GitQlientStyles.h>
 #include <GitRemote.h>
 #include <GitServerCache.h>
 #include <GitStashes.h>
+#include <GitSubmodules.h>
 #include <GitTags.h>
 #include <MergePullRequestDlg.h>
+#include <ProgressDlg.h>
 #include <PullDlg.h>
 #include <TagDlg.h>
 
@@ -28,6 +33,8 @@
 
 #include <QLogger.h>
 
+#include <algorithm>
+
 using namespace QLogger;
 
 CommitHistoryContextMenu::CommitHistoryContextMenu(const QSharedPointer<GitCache> &cache,
@@ -47,6 +54,12 @@ CommitHistoryContextMenu::CommitHistoryContextMenu(const QSharedPointer<GitCache
       createIndividualShaMenu();
    else
       createMultipleShasMenu();
+
+   addSeparator();
+
+   // The export covers what the view currently shows, so it lives in the view rather than here
+   const auto exportHistoryAction = addAction(tr("Export history to file"));
+   connect(exportHistoryAction, &QAction::triggered, this, &CommitHistoryContextMenu::requestHistoryExport);
 }
 
 void CommitHistoryContextMenu::createIndividualShaMenu()
@@ -72,6 +85,32 @@ void CommitHistoryContextMenu::createIndividualShaMenu()
 
       if (sha != CommitInfo::ZERO_SHA)
       {
+         // Parents and children are already wired in the cached graph, so jumping between them is
+         // a row lookup with no subprocess regardless of their distance
+         const auto commit = mCache->commitInfo(sha);
+
+         if (commit.parentsCount() > 0 || commit.hasChilds())
+         {
+            const auto navigateMenu = addMenu(tr("Navigate"));
+            const auto parents = commit.parents();
+
+            for (auto i = 0; i < parents.count(); ++i)
+            {
+               const auto label = parents.count() == 1 ? tr("To parent") : tr("To parent %1").arg(i + 1);
+               connect(navigateMenu->addAction(label), &QAction::triggered, this,
+                       [this, parentSha = parents.at(i)]() { emit signalFocusCommit(parentSha); });
+            }
+
+            const auto childs = commit.getChilds();
+
+            for (auto i = 0; i < childs.count(); ++i)
+            {
+               const auto label = childs.count() == 1 ? tr("To child") : tr("To child %1").arg(i + 1);
+               connect(navigateMenu->addAction(label), &QAction::triggered, this,
+                       [this, childSha = childs.at(i)->sha()]() { emit signalFocusCommit(childSha); });
+            }
+         }
+
          const auto createMenu = addMenu(tr("Create"));
 
          const auto createBranchAction = createMenu->addAction(tr("Branch"));
@@ -90,41 +129,38 @@ void CommitHistoryContextMenu::createIndividualShaMenu()
 
          addBranchActions(sha);
 
-         QScopedPointer<GitBranches> git(new GitBranches(mGit));
-         const auto ret = git->getLastCommitOfBranch(mGit->getCurrentBranch());
+         // The tip of the current branch is the commit carrying its local reference, so
+         // the check is answered from the cache instead of spawning a git process.
+         const auto isBranchTip
+             = mCache->getReferences(sha, References::Type::LocalBranch).contains(mGit->getCurrentBranch());
 
-         if (ret.success)
+         if (isBranchTip)
          {
-            const auto lastShaStr = ret.output.toString().remove('\n');
+            const auto amendCommitAction = addAction(tr("Amend"));
+            connect(amendCommitAction, &QAction::triggered, this,
+                    [this]() { emit signalAmendCommit(mShas.first()); });
 
-            if (lastShaStr == sha)
-            {
-               const auto amendCommitAction = addAction(tr("Amend"));
-               connect(amendCommitAction, &QAction::triggered, this,
-                       [this]() { emit signalAmendCommit(mShas.first()); });
-
-               const auto applyMenu = addMenu(tr("Apply"));
+            const auto applyMenu = addMenu(tr("Apply"));
 
-               const auto applyPatchAction = applyMenu->addAction(tr("Patch"));
-               connect(applyPatchAction, &QAction::triggered, this, &CommitHistoryContextMenu::applyPatch);
+            const auto applyPatchAction = applyMenu->addAction(tr("Patch"));
+            connect(applyPatchAction, &QAction::triggered, this, &CommitHistoryContextMenu::applyPatch);
 
-               const auto applyCommitAction = applyMenu->addAction(tr("Commit"));
-               connect(applyCommitAction, &QAction::triggered, this, &CommitHistoryContextMenu::applyCommit);
+            const auto applyCommitAction = applyMenu->addAction(tr("Commit"));
+            connect(applyCommitAction, &QAction::triggered, this, &CommitHistoryContextMenu::applyCommit);
 
-               const auto pushAction = addAction(tr("Push"));
-               connect(pushAction, &QAction::triggered, this, &CommitHistoryContextMenu::push);
+            const auto pushAction = addAction(tr("Push"));
+            connect(pushAction, &QAction::triggered, this, &CommitHistoryContextMenu::push);
 
-               const auto pullAction = addAction(tr("Pull"));
-               connect(pullAction, &QAction::triggered, this, &CommitHistoryContextMenu::pull);
+            const auto pullAction = addAction(tr("Pull"));
+            connect(pullAction, &QAction::triggered, this, &CommitHistoryContextMenu::pull);
 
-               const auto fetchAction = addAction(tr("Fetch"));
-               connect(fetchAction, &QAction::triggered, this, &CommitHistoryContextMenu::fetch);
-            }
-            else if (mCache->isCommitInCurrentGeneologyTree(mShas.first()))
-            {
-               const auto pushAction = addAction(tr("Push"));
-               connect(pushAction, &QAction::triggered, this, &CommitHistoryContextMenu::push);
-            }
+            const auto fetchAction = addAction(tr("Fetch"));
+            connect(fetchAction, &QAction::triggered, this, &CommitHistoryContextMenu::fetch);
+         }
+         else if (mCache->isCommitInCurrentGeneologyTree(mShas.first()))
+         {
+            const auto pushAction = addAction(tr("Push"));
+            connect(pushAction, &QAction::triggered, this, &CommitHistoryContextMenu::push);
          }
 
          const auto resetMenu = addMenu(tr("Reset"));
@@ -243,11 +279,11 @@ void CommitHistoryContextMenu::stashPop()
 
 void CommitHistoryContextMenu::createBranch()
 {
-   BranchDlg dlg({ mShas.first(), BranchDlgMode::CREATE_FROM_COMMIT, mGit });
+   BranchDlg dlg({ mShas.first(), BranchDlgMode::CREATE_FROM_COMMIT, mGit, mCache });
    const auto ret = dlg.exec();
 
    if (ret == QDialog::Accepted)
-      emit requestReload(true); // TODO: Optimize
+      emit requestRefreshReferences();
 }
 
 void CommitHistoryContextMenu::createTag()
@@ -256,7 +292,7 @@ void CommitHistoryContextMenu::createTag()
    const auto ret = dlg.exec();
 
    if (ret == QDialog::Accepted)
-      emit requestReload(true); // TODO: Optimize
+      emit requestRefreshReferences();
 }
 
 void CommitHistoryContextMenu::exportAsPatch()
@@ -336,7 +372,7 @@ void CommitHistoryContextMenu::checkoutBranch()
 
 void CommitHistoryContextMenu::createCheckoutBranch()
 {
-   BranchDlg dlg({ mShas.constFirst(), BranchDlgMode::CREATE_CHECKOUT_FROM_COMMIT, mGit });
+   BranchDlg dlg({ mShas.constFirst(), BranchDlgMode::CREATE_CHECKOUT_FROM_COMMIT, mGit, mCache });
    const auto ret = dlg.exec();
 
    if (ret == QDialog::Accepted)
@@ -368,121 +404,195 @@ void CommitHistoryContextMenu::checkoutCommit()
 void CommitHistoryContextMenu::cherryPickCommit()
 {
    auto shas = mShas;
-   for (const auto &sha : qAsConst(mShas))
-   {
-      QScopedPointer<GitLocal> git(new GitLocal(mGit));
-      const auto ret = git->cherryPickCommit(sha);
 
-      shas.takeFirst();
+   // The selection comes in view order (newest first); the picks must apply oldest first so
+   // every commit lands on top of the previous one.
+   std::sort(shas.begin(), shas.end(),
+             [this](const QString &sha1, const QString &sha2) { return mCache->commitPos(sha1) > mCache->commitPos(sha2); });
 
-      if (ret.success && shas.isEmpty())
-         emit requestReload(false);
-      else if (!ret.success)
-      {
-         const auto errorMsg = ret.output.toString();
+   QScopedPointer<GitLocal> git(new GitLocal(mGit));
+   const auto ret = git->cherryPickCommits(shas);
 
-         if (errorMsg.contains("error: could not apply", Qt::CaseInsensitive)
-             && errorMsg.contains("after resolving the conflicts", Qt::CaseInsensitive))
-         {
-            emit signalCherryPickConflict(shas);
-         }
-         else
-         {
-            QMessageBox msgBox(QMessageBox::Critical, tr("Error while cherry-pick"),
-                               tr("There were problems during the cherry-pich operation. Please, see the detailed "
-                                  "description for more information."),
-                               QMessageBox::Ok, this);
-            msgBox.setDetailedText(errorMsg);
-            msgBox.setStyleSheet(GitQlientStyles::getStyles());
-            msgBox.exec();
-         }
+   if (ret.success)
+      emit requestReload(false);
+   else
+   {
+      const auto errorMsg = ret.output.toString();
+
+      if (errorMsg.contains("error: could not apply", Qt::CaseInsensitive)
+          && errorMsg.contains("after resolving the conflicts", Qt::CaseInsensitive))
+      {
+         // The pending picks stay in git's sequencer; cherry-pick --continue resumes them once
+         // the conflict is resolved.
+         emit signalCherryPickConflict();
+      }
+      else
+      {
+         QMessageBox msgBox(QMessageBox::Critical, tr("Error while cherry-pick"),
+                            tr("There were problems during the cherry-pich operation. Please, see the detailed "
+                               "description for more information."),
+                            QMessageBox::Ok, this);
+         msgBox.setDetailedText(errorMsg);
+         msgBox.setStyleSheet(GitQlientStyles::getStyles());
+         msgBox.exec();
       }
    }
 }
 
 void CommitHistoryContextMenu::applyPatch()
 {
-   const QString fileName(QFileDialog::getOpenFileName(this, tr("Select a patch to apply")));
+   auto fileNames = QFileDialog::getOpenFileNames(this, tr("Select one or more patches to apply"));
    QScopedPointer<GitPatches> git(new GitPatches(mGit));
 
-   if (!fileName.isEmpty() && git->applyPatch(fileName))
+   // The numbered prefixes of an exported series define the order the patches apply in
+   fileNames.sort();
+
+   if (!fileNames.isEmpty() && git->applyPatches(fileNames).success)
       emit requestReload(false);
 }
 
 void CommitHistoryContextMenu::applyCommit()
 {
-   const QString fileName(QFileDialog::getOpenFileName(this, "Select a patch to apply"));
+   auto fileNames = QFileDialog::getOpenFileNames(this, tr("Select one or more patches to apply"));
    QScopedPointer<GitPatches> git(new GitPatches(mGit));
 
-   if (!fileName.isEmpty() && git->applyPatch(fileName, true))
+   fileNames.sort();
+
+   if (!fileNames.isEmpty() && git->applyPatches(fileNames, true).success)
       emit requestReload(false);
 }
 
 void CommitHistoryContextMenu::push()
 {
-   QApplication::setOverrideCursor(QCursor(Qt::WaitCursor));
-   QScopedPointer<GitRemote> git(new GitRemote(mGit));
-   const auto ret = git->pushCommit(mShas.first(), mGit->getCurrentBranch());
-   QApplication::restoreOverrideCursor();
-
-   if (ret.output.toString().contains("has no upstream branch"))
-   {
-      const auto currentBranch = mGit->getCurrentBranch();
-      BranchDlg dlg({ currentBranch, BranchDlgMode::PUSH_UPSTREAM, mGit });
-      const auto ret = dlg.exec();
+   const auto currentBranch = mGit->getCurrentBranch();
 
-      if (ret == QDialog::Accepted)
-      {
-         emit signalRefreshPRsCache();
-         emit requestReload(false);
-      }
-   }
-   else if (ret.success)
-   {
-      emit signalRefreshPRsCache();
-      emit requestReload(false);
-   }
-   else
-   {
-      QMessageBox msgBox(QMessageBox::Critical, tr("Error while pushing"),
-                         tr("There were problems during the push operation. Please, see the detailed description "
-                            "for more information."),
-                         QMessageBox::Ok, this);
-      msgBox.setDetailedText(ret.output.toString());
-      msgBox.setStyleSheet(GitQlientStyles::getStyles());
-      msgBox.exec();
-   }
+   QScopedPointer<GitConfig> gitConfig(new GitConfig(mGit));
+   const auto remoteRet = gitConfig->getRemoteForBranch(currentBranch);
+   const auto remote = remoteRet.success && !remoteRet.output.toString().isEmpty() ? remoteRet.output.toString()
+                                                                                  : QString("origin");
+
+   const auto progressDlg = new ProgressDlg(tr("Pushing changes..."), tr("Cancel"), 100, false, false);
+   const auto runner = new GitOperationRunner(mGit, this);
+
+   connect(progressDlg, &QProgressDialog::canceled, runner, &GitOperationRunner::cancel);
+   connect(runner, &GitOperationRunner::progressChanged, progressDlg, [progressDlg](int percentage, const QString &text) {
+      if (percentage >= 0)
+         progressDlg->setValue(percentage);
+
+      if (!text.isEmpty())
+         progressDlg->setLabelText(text);
+   });
+   connect(runner, &GitOperationRunner::operationCanceled, this, [progressDlg, runner]() {
+      progressDlg->close();
+      runner->deleteLater();
+   });
+   connect(runner, &GitOperationRunner::operationFinished, this,
+           [this, progressDlg, runner, currentBranch](GitExecResult ret) {
+              progressDlg->close();
+              runner->deleteLater();
+
+              if (ret.output.toString().contains("has no upstream branch"))
+              {
+                 BranchDlg dlg({ currentBranch, BranchDlgMode::PUSH_UPSTREAM, mGit, mCache });
+                 const auto ret = dlg.exec();
+
+                 if (ret == QDialog::Accepted)
+                 {
+                    emit signalRefreshPRsCache();
+                    emit requestReload(false);
+                 }
+              }
+              else if (ret.success)
+              {
+                 emit signalRefreshPRsCache();
+                 emit requestReload(false);
+              }
+              else
+              {
+                 QMessageBox msgBox(
+                     QMessageBox::Critical, tr("Error while pushing"),
+                     tr("There were problems during the push operation. Please, see the detailed description "
+                        "for more information."),
+                     QMessageBox::Ok, this);
+                 msgBox.setDetailedText(ret.output.toString());
+                 msgBox.setStyleSheet(GitQlientStyles::getStyles());
+                 msgBox.exec();
+              }
+           });
+
+   progressDlg->show();
+   runner->run(QString("git push --progress %1 %2:refs/heads/%3").arg(remote, mShas.first(), currentBranch));
 }
 
 void CommitHistoryContextMenu::pull()
 {
-   QApplication::setOverrideCursor(QCursor(Qt::WaitCursor));
-   QScopedPointer<GitRemote> git(new GitRemote(mGit));
-   const auto ret = git->pull();
-   QApplication::restoreOverrideCursor();
+   // The pull runs asynchronously with its progress streamed to a non-modal dialog, so the UI
+   // stays fully interactive for its whole duration
+   const auto progressDlg = new ProgressDlg(tr("Pulling changes..."), tr("Cancel"), 100, false, false);
+   const auto runner = new GitOperationRunner(mGit, this);
+
+   connect(progressDlg, &QProgressDialog::canceled, runner, &GitOperationRunner::cancel);
+   connect(runner, &GitOperationRunner::progressChanged, progressDlg, [progressDlg](int percentage, const QString &text) {
+      if (percentage >= 0)
+         progressDlg->setValue(percentage);
+
+      if (!text.isEmpty())
+         progressDlg->setLabelText(text);
+   });
+   connect(runner, &GitOperationRunner::operationCanceled, this, [progressDlg, runner]() {
+      progressDlg->close();
+      runner->deleteLater();
+   });
+   connect(runner, &GitOperationRunner::operationFinished, this, [this, progressDlg, runner](GitExecResult ret) {
+      progressDlg->close();
+      runner->deleteLater();
+
+      if (ret.success)
+      {
+         GitQlientSettings settings(mGit->getGitDir());
 
-   if (ret.success)
-      emit requestReload(true);
-   else
-   {
-      const auto errorMsg = ret.output.toString();
+         if (settings.localValue("UpdateOnPull", true).toBool())
+         {
+            QScopedPointer<GitSubmodules> git(new GitSubmodules(mGit));
 
-      if (errorMsg.contains("error: could not apply", Qt::CaseInsensitive)
-          && errorMsg.contains("causing a conflict", Qt::CaseInsensitive))
-      {
-         emit signalPullConflict();
+            if (!git->submoduleUpdate(QString()))
+            {
+               QMessageBox msgBox(
+                   QMessageBox::Critical, tr("Error while pulling"),
+                   tr("There was a problem updating the submodules after pull. Please review that you don't "
+                      "have any local modifications in the submodules"),
+                   QMessageBox::Ok, this);
+               msgBox.setStyleSheet(GitQlientStyles::getStyles());
+               msgBox.exec();
+            }
+         }
+
+         emit requestReload(true);
       }
       else
       {
-         QMessageBox msgBox(QMessageBox::Critical, tr("Error while pulling"),
-                            tr("There were problems during the pull operation. Please, see the detailed "
-                               "description for more information."),
-                            QMessageBox::Ok, this);
-         msgBox.setDetailedText(errorMsg);
-         msgBox.setStyleSheet(GitQlientStyles::getStyles());
-         msgBox.exec();
+         const auto errorMsg = ret.output.toString();
+
+         if (errorMsg.contains("error: could not apply", Qt::CaseInsensitive)
+             && errorMsg.contains("causing a conflict", Qt::CaseInsensitive))
+         {
+            emit signalPullConflict();
+         }
+         else
+         {
+            QMessageBox msgBox(QMessageBox::Critical, tr("Error while pulling"),
+                               tr("There were problems during the pull operation. Please, see the detailed "
+                                  "description for more information."),
+                               QMessageBox::Ok, this);
+            msgBox.setDetailedText(errorMsg);
+            msgBox.setStyleSheet(GitQlientStyles::getStyles());
+            msgBox.exec();
+         }
       }
-   }
+   });
+
+   progressDlg->show();
+   runner->run("git pull --ff-only --progress");
 }
 
 void CommitHistoryContextMenu::fetch()
@@ -491,7 +601,7 @@ void CommitHistoryContextMenu::fetch()
 
    if (git->fetch())
    {
-      mGitTags->getRemoteTags();
+      mGitTags->refreshRemoteTags();
       emit requestReload(true);
    }
 }
@@ -47,12 +47,31 @@ signals:
     */
    void requestReload(bool full);
 
+   /**
+    * @brief requestRefreshReferences Signal triggered when only the references changed (i.e. a tag or a branch was
+    * created), so the log doesn't need to be replayed.
+    */
+   void requestRefreshReferences();
+
+   /**
+    * @brief requestHistoryExport Signal triggered when the user wants to export the history shown
+    * by the view into a CSV or JSON file.
+    */
+   void requestHistoryExport();
+
    /*!
     \brief Signal triggered when the user wants to open the diff of a commit compared to its parent.
 
     \param sha The SHA to diff.
    */
    void signalOpenDiff(const QString &sha);
+
+   /**
+    * @brief signalFocusCommit Signal triggered when the user navigates to a parent or a child of
+    * the selected commit.
+    * @param sha The SHA to focus on.
+    */
+   void signalFocusCommit(const QString &sha);
    /*!
     \brief Signal triggered when the user wants to diff the shas in the list. This signal is only emitted if the user
     selected two SHAs.
@@ -22,11 +22,14 @@ CommitHistoryModel::CommitHistoryModel(const QSharedPointer<GitCache> &cache, co
    mColumns.insert(CommitHistoryColumns::Log, "History");
    mColumns.insert(CommitHistoryColumns::Author, "Author");
    mColumns.insert(CommitHistoryColumns::Date, "Date");
+
+   connect(mCache.get(), &GitCache::signalWipUpdated, this, &CommitHistoryModel::onWipUpdated);
+   connect(mCache.get(), &GitCache::signalRowsUpdated, this, &CommitHistoryModel::onRowsUpdated);
 }
 
 int CommitHistoryModel::rowCount(const QModelIndex &parent) const
 {
-   return !parent.isValid() ? mCache->commitCount() : 0;
+   return !parent.isValid() ? mRowCount : 0;
 }
 
 bool CommitHistoryModel::hasChildren(const QModelIndex &parent) const
@@ -42,17 +45,64 @@ QString CommitHistoryModel::sha(int row) const
 void CommitHistoryModel::clear()
 {
    beginResetModel();
+   mRowCount = 0;
+   mFormattedDates.clear();
+   mRowCache.clear();
    endResetModel();
    emit headerDataChanged(Qt::Horizontal, 0, 5);
 }
 
+void CommitHistoryModel::onWipUpdated()
+{
+   if (mRowCount == 0)
+      return;
+
+   // Only the WIP row changed: its memoized fields are dropped and that single row repainted,
+   // leaving the rest of the view untouched
+   mRowCache.remove(0);
+
+   emit dataChanged(index(0, 0), index(0, mColumns.count() - 1));
+}
+
+void CommitHistoryModel::onRowsUpdated(int firstRow, int lastRow)
+{
+   if (mRowCount == 0 || firstRow >= mRowCount)
+      return;
+
+   // The composed row strings are untouched by an in-place update, so only the graph column of
+   // the changed range is repainted
+   const auto graph = static_cast<int>(CommitHistoryColumns::Graph);
+
+   emit dataChanged(index(firstRow, graph), index(qMin(lastRow, mRowCount - 1), graph));
+}
+
 void CommitHistoryModel::onNewRevisions(int totalCommits)
 {
-   beginResetModel();
-   endResetModel();
+   // The composed rows are dropped on every cache update: the WIP row and the branch decorations can
+   // change without the row count moving, so stale entries would otherwise survive a refresh
+   mRowCache.clear();
+
+   if (totalCommits > mRowCount)
+   {
+      // New commits stream in at the bottom, so they are announced as appended rows: the view
+      // keeps its selection and scroll position instead of being reset
+      const auto firstNewRow = mRowCount;
+
+      beginInsertRows(QModelIndex(), firstNewRow, totalCommits - 1);
+      mRowCount = totalCommits;
+      endInsertRows();
 
-   beginInsertRows(QModelIndex(), 0, totalCommits - 2);
-   endInsertRows();
+      if (firstNewRow > 0)
+         emit dataChanged(index(0, 0), index(firstNewRow - 1, mColumns.count() - 1));
+   }
+   else if (totalCommits < mRowCount)
+   {
+      beginResetModel();
+      mRowCount = totalCommits;
+      endResetModel();
+   }
+   else if (mRowCount > 0)
+      emit dataChanged(index(0, 0), index(mRowCount - 1, mColumns.count() - 1));
 }
 
 QVariant CommitHistoryModel::headerData(int section, Qt::Orientation orientation, int role) const
@@ -65,7 +115,7 @@ QVariant CommitHistoryModel::headerData(int section, Qt::Orientation orientation
 
 QModelIndex CommitHistoryModel::index(int row, int column, const QModelIndex &) const
 {
-   return row >= 0 && row < mCache->commitCount() ? createIndex(row, column, nullptr) : QModelIndex();
+   return row >= 0 && row < mRowCount ? createIndex(row, column, nullptr) : QModelIndex();
 }
 
 QModelIndex CommitHistoryModel::parent(const QModelIndex &) const
@@ -96,8 +146,7 @@ QVariant CommitHistoryModel::getToolTipData(const CommitInfo &r) const
    if (!tags.isEmpty())
       auxMessage.append(tr("<p><b>Tags: </b>%1</p>").arg(tags.join(",")));
 
-   QDateTime d;
-   d.setSecsSinceEpoch(r.authorDate().toUInt());
+   const auto d = QDateTime::fromSecsSinceEpoch(r.authorDateSecs());
 
    QLocale locale;
 
@@ -117,40 +166,53 @@ QVariant CommitHistoryModel::getToolTipData(const CommitInfo &r) const
    return tooltip;
 }
 
-QVariant CommitHistoryModel::getDisplayData(const CommitInfo &rev, int column) const
+QVariant CommitHistoryModel::getDisplayData(int row, int column) const
 {
+   auto &cached = mRowCache[row];
+
+   if (!cached.valid)
+   {
+      const auto rev = mCache->commitInfo(row);
+
+      cached.sha = rev.sha();
+      cached.shortLog = rev.shortLog();
+      cached.author = rev.author().split("<").first();
+      cached.date = formattedDate(rev.authorDateSecs());
+      cached.valid = true;
+   }
+
    switch (static_cast<CommitHistoryColumns>(column))
    {
-      case CommitHistoryColumns::Sha: {
-         const auto sha = rev.sha();
-         return sha;
-      }
+      case CommitHistoryColumns::Sha:
+         return cached.sha;
       case CommitHistoryColumns::Log:
-         return rev.shortLog();
-      case CommitHistoryColumns::Author: {
-         const auto author = rev.author().split("<").first();
-         return author;
-      }
-      case CommitHistoryColumns::Date: {
-         return QDateTime::fromSecsSinceEpoch(rev.authorDate().toUInt()).toString("dd MMM yyyy hh:mm");
-      }
+         return cached.shortLog;
+      case CommitHistoryColumns::Author:
+         return cached.author;
+      case CommitHistoryColumns::Date:
+         return cached.date;
       default:
          return QVariant();
    }
 }
 
+QString CommitHistoryModel::formattedDate(qint64 secs) const
+{
+   auto &cached = mFormattedDates[secs];
+
+   if (cached.isEmpty())
+      cached = QDateTime::fromSecsSinceEpoch(secs).toString("dd MMM yyyy hh:mm");
+
+   return cached;
+}
+
 QVariant CommitHistoryModel::data(const QModelIndex &index, int role) const
 {
    if (!index.isValid() || (role != Qt::DisplayRole && role != Qt::ToolTipRole))
       return QVariant();
 
-   const auto r = mCache->commitInfo(index.row());
-
    if (role == Qt::ToolTipRole)
-      return getToolTipData(r);
+      return getToolTipData(mCache->commitInfo(index.row()));
 
-   if (role == Qt::DisplayRole)
-      return getDisplayData(r, index.column());
-
-   return QVariant();
+   return getDisplayData(index.row(), index.column());
 }
@@ -24,6 +24,7 @@
  ***************************************************************************************/
 
 #include <QAbstractItemModel>
+#include <QHash>
 #include <QSharedPointer>
 
 class GitCache;
@@ -125,6 +126,18 @@ public:
     * @param totalCommits The total of new revisions.
     */
    void onNewRevisions(int totalCommits);
+   /**
+    * @brief onWipUpdated Repaints the WIP row after an incremental update of the working directory
+    * state, avoiding the full view refresh a cache reset would trigger.
+    */
+   void onWipUpdated();
+   /**
+    * @brief onRowsUpdated Repaints the graph column of the given row range after the cache
+    * updated those rows in place, leaving selection and scroll position untouched.
+    * @param firstRow The first changed row.
+    * @param lastRow The last changed row.
+    */
+   void onRowsUpdated(int firstRow, int lastRow);
    /*!
     * \brief Gets the number of columns in the model.
     * \return The number of columns.
@@ -132,10 +145,26 @@ public:
    int columnCount() const { return mColumns.count(); }
 
 private:
+   /**
+    * @brief The RowData struct stores the composed display strings of a row, so the repeated data() queries Qt
+    * performs while painting and selecting become constant-time struct reads.
+    */
+   struct RowData
+   {
+      bool valid = false;
+      QString sha;
+      QString shortLog;
+      QString author;
+      QString date;
+   };
+
    QSharedPointer<GitCache> mCache;
    QSharedPointer<GitBase> mGit;
    QSharedPointer<GitServerCache> mGitServerCache;
    QMap<CommitHistoryColumns, QString> mColumns;
+   int mRowCount = 0;
+   mutable QHash<qint64, QString> mFormattedDates;
+   mutable QHash<int, RowData> mRowCache;
 
    /**
     * @brief Returns the tool tip data.
@@ -145,11 +174,20 @@ private:
     */
    QVariant getToolTipData(const CommitInfo &r) const;
    /**
-    * @brief Returns the data that will be display for every \p column.
+    * @brief Returns the data that will be display for every \p column. The composed values of the row are filled on
+    * the first query and served from @ref RowData afterwards.
     *
-    * @param rev The commit info to retrieve the data that will be displayed.
+    * @param row The row to retrieve the data that will be displayed.
     * @param column The column where the data will be shown.
     * @return QVariant The data to be shown.
     */
-   QVariant getDisplayData(const CommitInfo &rev, int column) const;
+   QVariant getDisplayData(int row, int column) const;
+   /**
+    * @brief Returns the formatted date for the Date column, memoized by epoch second so repaints
+    * during scrolling become a lookup instead of a QDateTime format.
+    *
+    * @param secs The commit date in seconds since the epoch.
+    * @return QString The formatted date.
+    */
+   QString formattedDate(qint64 secs) const;
 };
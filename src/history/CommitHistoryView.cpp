@@ -9,13 +9,76 @@
 #include <GitConfig.h>
 #include <GitQlientSettings.h>
 #include <GitBase.h>
+#include <HistoryExporter.h>
+#include <ProgressDlg.h>
+
+#include <Colors.h>
 
 #include <QHeaderView>
 #include <QDateTime>
+#include <QFileDialog>
+#include <QKeyEvent>
+#include <QMessageBox>
+#include <QPainter>
+#include <QScrollBar>
 
 #include <QLogger.h>
 using namespace QLogger;
 
+namespace
+{
+/* Thin transparent child of the vertical scrollbar that paints one mark per search match. The
+ * marks map the graph rows onto the scrollbar height, so the distribution of the matches over the
+ * whole history is visible without scrolling. */
+class SearchMarksOverlay : public QWidget
+{
+public:
+   explicit SearchMarksOverlay(CommitHistoryView *view, QScrollBar *scrollBar)
+      : QWidget(scrollBar)
+      , mView(view)
+   {
+      setAttribute(Qt::WA_TransparentForMouseEvents);
+      scrollBar->installEventFilter(this);
+      setGeometry(scrollBar->rect());
+   }
+
+protected:
+   bool eventFilter(QObject *obj, QEvent *event) override
+   {
+      if (event->type() == QEvent::Resize)
+         setGeometry(qobject_cast<QWidget *>(obj)->rect());
+
+      return QWidget::eventFilter(obj, event);
+   }
+
+   void paintEvent(QPaintEvent *) override
+   {
+      const auto &matches = mView->searchMatches();
+      const auto total = matches.count();
+
+      if (total == 0)
+         return;
+
+      QPainter painter(this);
+      auto markColor = gitQlientOrange;
+      markColor.setAlpha(200);
+      painter.setPen(markColor);
+
+      for (auto row = 0; row < total; ++row)
+      {
+         if (matches.testBit(row))
+         {
+            const auto y = static_cast<int>(static_cast<qint64>(row) * (height() - 1) / total);
+            painter.drawLine(2, y, width() - 3, y);
+         }
+      }
+   }
+
+private:
+   CommitHistoryView *mView = nullptr;
+};
+}
+
 CommitHistoryView::CommitHistoryView(const QSharedPointer<GitCache> &cache, const QSharedPointer<GitBase> &git,
                                      const QSharedPointer<GitQlientSettings> &settings,
                                      const QSharedPointer<GitServerCache> &gitServerCache, QWidget *parent)
@@ -38,6 +101,8 @@ CommitHistoryView::CommitHistoryView(const QSharedPointer<GitCache> &cache, cons
 
    connect(mCache.get(), &GitCache::signalCacheUpdated, this, &CommitHistoryView::refreshView);
 
+   mSearchMarksOverlay = new SearchMarksOverlay(this, verticalScrollBar());
+
    connect(this, &CommitHistoryView::doubleClicked, this, [this](const QModelIndex &index) {
       if (mCommitHistoryModel)
       {
@@ -73,6 +138,7 @@ void CommitHistoryView::filterBySha(const QStringList &shaList)
    if (mProxyModel)
    {
       mProxyModel->beginResetModel();
+      mProxyModel->setFilterActive(true);
       mProxyModel->setAcceptedSha(shaList);
       mProxyModel->endResetModel();
    }
@@ -87,6 +153,35 @@ void CommitHistoryView::filterBySha(const QStringList &shaList)
    setupGeometry();
 }
 
+void CommitHistoryView::filterByCurrentBranch(bool active)
+{
+   if (active)
+   {
+      const auto totalCommits = mCache->commitCount();
+      QStringList shas;
+      shas.reserve(totalCommits);
+
+      for (auto row = 0; row < totalCommits; ++row)
+      {
+         const auto sha = mCache->commitInfo(row).sha();
+
+         // The WIP row belongs to every branch view
+         if (sha == CommitInfo::ZERO_SHA || mCache->isCommitInCurrentGeneologyTree(sha))
+            shas.append(sha);
+      }
+
+      filterBySha(shas);
+   }
+   else if (mProxyModel)
+   {
+      mIsFiltering = false;
+
+      mProxyModel->beginResetModel();
+      mProxyModel->setFilterActive(false);
+      mProxyModel->endResetModel();
+   }
+}
+
 CommitHistoryView::~CommitHistoryView()
 {
    mSettings->setLocalValue(QString("%1").arg(objectName()), header()->saveState());
@@ -127,27 +222,12 @@ void CommitHistoryView::currentChanged(const QModelIndex &index, const QModelInd
 
 void CommitHistoryView::refreshView()
 {
-   QModelIndex topLeft;
-   QModelIndex bottomRight;
-
-   if (mProxyModel)
-   {
-      topLeft = mProxyModel->index(0, 0);
-      bottomRight = mProxyModel->index(mProxyModel->rowCount() - 1, mProxyModel->columnCount() - 1);
-      mProxyModel->beginResetModel();
-      mProxyModel->endResetModel();
-   }
-   else
-   {
-      topLeft = mCommitHistoryModel->index(0, 0);
-      bottomRight
-          = mCommitHistoryModel->index(mCommitHistoryModel->rowCount() - 1, mCommitHistoryModel->columnCount() - 1);
+   // The model announces inserted and changed rows itself and the proxy forwards them, so no
+   // reset is needed here anymore: the repaint covers decoration-only changes like updated tags
+   if (!mProxyModel)
       mCommitHistoryModel->onNewRevisions(mCache->commitCount());
-   }
 
-   const auto auxTL = visualRect(topLeft);
-   const auto auxBR = visualRect(bottomRight);
-   viewport()->update(auxTL.x(), auxTL.y(), auxBR.x() + auxBR.width(), auxBR.y() + auxBR.height());
+   viewport()->update();
 }
 
 void CommitHistoryView::onHeaderContextMenu(const QPoint &pos)
@@ -171,6 +251,14 @@ void CommitHistoryView::onHeaderContextMenu(const QPoint &pos)
    menu->exec(header()->mapToGlobal(pos));
 }
 
+void CommitHistoryView::setSearchMatches(const QBitArray &matches)
+{
+   mSearchMatches = matches;
+
+   viewport()->update();
+   mSearchMarksOverlay->update();
+}
+
 void CommitHistoryView::clear()
 {
    mCommitHistoryModel->clear();
@@ -214,7 +302,10 @@ void CommitHistoryView::showContextMenu(const QPoint &pos)
          const auto menu = new CommitHistoryContextMenu(mCache, mGit, mGitServerCache, shas, this);
          // connect(menu, &CommitHistoryContextMenu::signalRefreshPRsCache, mCache.get(), &GitCache::refreshPRsCache);
          connect(menu, &CommitHistoryContextMenu::requestReload, this, &CommitHistoryView::requestReload);
+         connect(menu, &CommitHistoryContextMenu::requestRefreshReferences, this,
+                 &CommitHistoryView::requestRefreshReferences);
          connect(menu, &CommitHistoryContextMenu::signalOpenDiff, this, &CommitHistoryView::signalOpenDiff);
+         connect(menu, &CommitHistoryContextMenu::signalFocusCommit, this, &CommitHistoryView::focusOnCommit);
          connect(menu, &CommitHistoryContextMenu::signalOpenCompareDiff, this,
                  &CommitHistoryView::signalOpenCompareDiff);
          connect(menu, &CommitHistoryContextMenu::signalAmendCommit, this, &CommitHistoryView::signalAmendCommit);
@@ -223,6 +314,7 @@ void CommitHistoryView::showContextMenu(const QPoint &pos)
                  &CommitHistoryView::signalCherryPickConflict);
          connect(menu, &CommitHistoryContextMenu::signalPullConflict, this, &CommitHistoryView::signalPullConflict);
          connect(menu, &CommitHistoryContextMenu::showPrDetailedView, this, &CommitHistoryView::showPrDetailedView);
+         connect(menu, &CommitHistoryContextMenu::requestHistoryExport, this, &CommitHistoryView::exportHistory);
          menu->exec(viewport()->mapToGlobal(pos));
       }
       else
@@ -230,6 +322,72 @@ void CommitHistoryView::showContextMenu(const QPoint &pos)
    }
 }
 
+void CommitHistoryView::exportHistory()
+{
+   const auto filePath = QFileDialog::getSaveFileName(this, tr("Export history"), QString(),
+                                                      tr("CSV files (*.csv);;JSON files (*.json)"));
+
+   if (filePath.isEmpty())
+      return;
+
+   // The export covers what the view shows: the filtered rows when a filter is active, the whole
+   // graph otherwise
+   QVector<int> rows;
+
+   if (mIsFiltering && mProxyModel)
+   {
+      const auto total = mProxyModel->rowCount();
+      rows.reserve(total);
+
+      for (auto row = 0; row < total; ++row)
+         rows.append(mProxyModel->mapToSource(mProxyModel->index(row, 0)).row());
+   }
+   else
+   {
+      const auto total = mCache->commitCount();
+      rows.reserve(total);
+
+      for (auto row = 0; row < total; ++row)
+         rows.append(row);
+   }
+
+   const auto progressDlg = new ProgressDlg(tr("Exporting history..."), QString(), 100, false, false);
+   const auto exporter = new HistoryExporter(mCache, this);
+
+   connect(exporter, &HistoryExporter::progressChanged, progressDlg, &QProgressDialog::setValue);
+   connect(exporter, &HistoryExporter::exportFinished, this,
+           [this, progressDlg, exporter](bool success, const QString &filePath) {
+              progressDlg->close();
+              exporter->deleteLater();
+
+              if (!success)
+              {
+                 QMessageBox::critical(this, tr("Error while exporting"),
+                                       tr("The history could not be exported to %1.").arg(filePath));
+              }
+           });
+
+   progressDlg->show();
+   exporter->exportRows(filePath, rows);
+}
+
+void CommitHistoryView::keyPressEvent(QKeyEvent *event)
+{
+   if (event->modifiers() == Qt::AltModifier && (event->key() == Qt::Key_Down || event->key() == Qt::Key_Up))
+   {
+      const auto commit = mCache->commitInfo(mCurrentSha);
+
+      if (event->key() == Qt::Key_Down && commit.parentsCount() > 0)
+         focusOnCommit(commit.parent(0));
+      else if (event->key() == Qt::Key_Up && commit.hasChilds())
+         focusOnCommit(commit.getChilds().constFirst()->sha());
+
+      return;
+   }
+
+   QTreeView::keyPressEvent(event);
+}
+
 QList<QString> CommitHistoryView::getSelectedShaList() const
 {
    const auto indexes = selectedIndexes();
@@ -23,6 +23,7 @@
  ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
  ***************************************************************************************/
 
+#include <QBitArray>
 #include <QTreeView>
 
 class GitCache;
@@ -49,6 +50,12 @@ signals:
     */
    void requestReload(bool full);
 
+   /**
+    * @brief requestRefreshReferences Signal triggered when only the references changed, so a references-only refresh
+    * is enough.
+    */
+   void requestRefreshReferences();
+
    /*!
     \brief Signal triggered when the user wants to open the diff of a commit compared to its parent.
 
@@ -124,6 +131,14 @@ public:
     * @param shaList List of SHA to pass to the filter.
     */
    void filterBySha(const QStringList &shaList);
+   /**
+    * @brief filterByCurrentBranch Restricts the view to the commits reachable from the current
+    * branch, resolved over the in-memory graph. The whole history stays cached, so toggling
+    * between the branch-only and the all-branches view is an instant model reset with no reload.
+    *
+    * @param active True to show only the current branch, false to show every branch.
+    */
+   void filterByCurrentBranch(bool active);
    /**
     * @brief Activates/deactivates filtering in the view.
     *
@@ -137,6 +152,25 @@ public:
     */
    bool hasActiveFilter() const { return mIsFiltering; }
 
+   /**
+    * @brief setSearchMatches Sets the bitset of graph rows matching the current search. The
+    * delegate tints the matching rows and the vertical scrollbar shows one mark per match, so the
+    * whole distribution of the matches is visible at a glance.
+    * @param matches The bitset with one bit per graph row. An empty bitset clears the highlight.
+    */
+   void setSearchMatches(const QBitArray &matches);
+   /**
+    * @brief isSearchMatch Tells if the given graph row matches the current search.
+    * @param row The row in the graph model.
+    * @return True if the row is a search match.
+    */
+   bool isSearchMatch(int row) const { return row >= 0 && row < mSearchMatches.count() && mSearchMatches.testBit(row); }
+   /**
+    * @brief searchMatches Returns the bitset of graph rows matching the current search.
+    * @return The bitset with one bit per graph row.
+    */
+   const QBitArray &searchMatches() const { return mSearchMatches; }
+
    /**
     * @brief Clears any selection or data in the view.
     */
@@ -160,6 +194,16 @@ public:
     */
    QModelIndexList selectedIndexes() const override;
 
+protected:
+   /**
+    * @brief keyPressEvent Handles graph navigation shortcuts: Alt+Down jumps to the first parent
+    * of the current commit and Alt+Up to its first child, resolved through the cached graph with
+    * no subprocess.
+    *
+    * @param event The key event.
+    */
+   void keyPressEvent(QKeyEvent *event) override;
+
 private:
    QSharedPointer<GitCache> mCache;
    QSharedPointer<GitBase> mGit;
@@ -169,6 +213,12 @@ private:
    ShaFilterProxyModel *mProxyModel = nullptr;
    bool mIsFiltering = false;
    QString mCurrentSha;
+   QBitArray mSearchMatches;
+   /**
+    * @brief mSearchMarksOverlay Thin transparent widget on top of the vertical scrollbar that
+    * paints one mark per search match.
+    */
+   QWidget *mSearchMarksOverlay = nullptr;
 
    /**
     * @brief Shows the context menu for the CommitHistoryView.
@@ -176,6 +226,11 @@ private:
     * @param p The point where the context menu will be shown.
     */
    void showContextMenu(const QPoint &p);
+   /**
+    * @brief exportHistory Asks for a destination file and streams the history shown by the view
+    * (the filtered rows when a filter is active) into it as CSV or JSON, with a progress dialog.
+    */
+   void exportHistory();
    /**
     * @brief Configures the tree view and how the columns look like.
     *
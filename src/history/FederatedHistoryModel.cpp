@@ -0,0 +1,192 @@
+#include "FederatedHistoryModel.h"
+
+#include <CommitInfo.h>
+#include <GitCache.h>
+
+#include <QDateTime>
+#include <QTimer>
+
+namespace
+{
+/* The merge advances in small chunks driven by the view, so a 12-repo federation never pays more
+ * than the scrolled window regardless of the total commit count. */
+constexpr auto kMergeChunk = 100;
+}
+
+FederatedHistoryModel::FederatedHistoryModel(QObject *parent)
+   : QAbstractItemModel(parent)
+   , mResetDebounce(new QTimer(this))
+{
+   mResetDebounce->setSingleShot(true);
+   mResetDebounce->setInterval(200);
+   connect(mResetDebounce, &QTimer::timeout, this, &FederatedHistoryModel::restartMerge);
+}
+
+void FederatedHistoryModel::setSources(const QVector<QPair<QString, QSharedPointer<GitCache>>> &sources)
+{
+   beginResetModel();
+
+   for (const auto &source : qAsConst(mSources))
+      disconnect(source.cache.get(), nullptr, this, nullptr);
+
+   mSources.clear();
+   mMerged.clear();
+
+   for (const auto &source : sources)
+   {
+      mSources.append({ source.first, source.second, 1 });
+
+      // Any cache activity restarts the merge after a short quiet period, so a burst of lane
+      // batches during a reload collapses into a single restart
+      connect(source.second.get(), &GitCache::signalCacheUpdated, mResetDebounce,
+              static_cast<void (QTimer::*)()>(&QTimer::start));
+      connect(source.second.get(), &GitCache::signalRowsUpdated, mResetDebounce,
+              [this](int, int) { mResetDebounce->start(); });
+   }
+
+   endResetModel();
+}
+
+QVariant FederatedHistoryModel::data(const QModelIndex &index, int role) const
+{
+   if (!index.isValid() || index.row() >= mMerged.count())
+      return QVariant();
+
+   const auto &entry = mMerged.at(index.row());
+   const auto &source = mSources.at(entry.source);
+
+   if (role == Qt::DisplayRole)
+   {
+      const auto commit = source.cache->commitInfo(entry.sha);
+
+      switch (static_cast<FederatedHistoryColumns>(index.column()))
+      {
+         case FederatedHistoryColumns::Repository:
+            return source.name;
+         case FederatedHistoryColumns::Sha:
+            return entry.sha.left(8);
+         case FederatedHistoryColumns::Log:
+            return commit.shortLog();
+         case FederatedHistoryColumns::Author:
+            return commit.author();
+         case FederatedHistoryColumns::Date:
+            return QDateTime::fromSecsSinceEpoch(commit.authorDateSecs()).toString("dd MMM yyyy hh:mm");
+      }
+   }
+   else if (role == Qt::ToolTipRole)
+      return QString("%1 in %2").arg(entry.sha, source.name);
+
+   return QVariant();
+}
+
+QVariant FederatedHistoryModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+   if (orientation == Qt::Horizontal && role == Qt::DisplayRole)
+   {
+      switch (static_cast<FederatedHistoryColumns>(section))
+      {
+         case FederatedHistoryColumns::Repository:
+            return tr("Repository");
+         case FederatedHistoryColumns::Sha:
+            return tr("Sha");
+         case FederatedHistoryColumns::Log:
+            return tr("History");
+         case FederatedHistoryColumns::Author:
+            return tr("Author");
+         case FederatedHistoryColumns::Date:
+            return tr("Date");
+      }
+   }
+
+   return QVariant();
+}
+
+QModelIndex FederatedHistoryModel::index(int row, int column, const QModelIndex &parent) const
+{
+   return !parent.isValid() && row >= 0 && row < mMerged.count() ? createIndex(row, column) : QModelIndex();
+}
+
+QModelIndex FederatedHistoryModel::parent(const QModelIndex &) const
+{
+   return QModelIndex();
+}
+
+int FederatedHistoryModel::rowCount(const QModelIndex &parent) const
+{
+   return !parent.isValid() ? mMerged.count() : 0;
+}
+
+int FederatedHistoryModel::columnCount(const QModelIndex &) const
+{
+   return 5;
+}
+
+bool FederatedHistoryModel::canFetchMore(const QModelIndex &parent) const
+{
+   if (parent.isValid())
+      return false;
+
+   for (const auto &source : mSources)
+   {
+      if (source.nextRow < source.cache->commitCount())
+         return true;
+   }
+
+   return false;
+}
+
+void FederatedHistoryModel::fetchMore(const QModelIndex &parent)
+{
+   if (parent.isValid())
+      return;
+
+   QVector<Entry> chunk;
+   chunk.reserve(kMergeChunk);
+
+   while (chunk.count() < kMergeChunk)
+   {
+      auto newest = -1;
+      qint64 newestDate = -1;
+
+      // Every per-repo history is already newest-first, so the merge only has to compare the
+      // cursor head of each source
+      for (auto i = 0; i < mSources.count(); ++i)
+      {
+         if (mSources[i].nextRow >= mSources[i].cache->commitCount())
+            continue;
+
+         const auto date = mSources[i].cache->commitInfo(mSources[i].nextRow).authorDateSecs();
+
+         if (date > newestDate)
+         {
+            newestDate = date;
+            newest = i;
+         }
+      }
+
+      if (newest == -1)
+         break;
+
+      chunk.append({ newest, mSources[newest].cache->commitInfo(mSources[newest].nextRow).sha() });
+      ++mSources[newest].nextRow;
+   }
+
+   if (!chunk.isEmpty())
+   {
+      beginInsertRows(QModelIndex(), mMerged.count(), mMerged.count() + chunk.count() - 1);
+      mMerged.append(chunk);
+      endInsertRows();
+   }
+}
+
+void FederatedHistoryModel::restartMerge()
+{
+   beginResetModel();
+
+   mMerged.clear();
+
+   for (auto &source : mSources)
+      source.nextRow = 1;
+
+   endResetModel();
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+#include <QAbstractItemModel>
+#include <QSharedPointer>
+#include <QVector>
+
+class GitCache;
+class QTimer;
+
+/**
+ * @brief The columns shown by the federated history view.
+ */
+enum class FederatedHistoryColumns
+{
+   Repository,
+   Sha,
+   Log,
+   Author,
+   Date
+};
+
+/**
+ * @brief The FederatedHistoryModel merges the commit streams of several open repositories into one
+ * time-ordered list. It works as a k-way index merge over the per-repository caches: no git
+ * process is spawned and commits are pulled lazily through the fetchMore() mechanism, so the
+ * merged view only ever pays for the window the user scrolled to. When any source cache updates,
+ * the merge is restarted from scratch, which is equally cheap thanks to the lazy refill.
+ *
+ * @class FederatedHistoryModel FederatedHistoryModel.h "FederatedHistoryModel.h"
+ */
+class FederatedHistoryModel : public QAbstractItemModel
+{
+   Q_OBJECT
+
+public:
+   /**
+    * @brief Default constructor.
+    *
+    * @param parent The parent object if needed.
+    */
+   explicit FederatedHistoryModel(QObject *parent = nullptr);
+
+   /**
+    * @brief setSources Replaces the set of repositories whose histories are merged.
+    * @param sources Pairs of repository name and its cache.
+    */
+   void setSources(const QVector<QPair<QString, QSharedPointer<GitCache>>> &sources);
+
+   /**
+    * @brief Overridden method that returns the data for the given index and role.
+    */
+   QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+   /**
+    * @brief Overridden method that returns the header data for the given section.
+    */
+   QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+   /**
+    * @brief Overridden method that returns the index for the given row and column.
+    */
+   QModelIndex index(int row, int column, const QModelIndex &parent = QModelIndex()) const override;
+   /**
+    * @brief Overridden method that returns an invalid index since the model is a plain list.
+    */
+   QModelIndex parent(const QModelIndex &index) const override;
+   /**
+    * @brief Overridden method that returns the number of merged rows.
+    */
+   int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+   /**
+    * @brief Overridden method that returns the number of columns.
+    */
+   int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+   /**
+    * @brief Overridden method that tells the view whether any source still holds unmerged commits.
+    */
+   bool canFetchMore(const QModelIndex &parent) const override;
+   /**
+    * @brief Overridden method that merges the next chunk of commits into the list.
+    */
+   void fetchMore(const QModelIndex &parent) override;
+
+private:
+   struct Source
+   {
+      QString name;
+      QSharedPointer<GitCache> cache;
+      int nextRow = 1;
+   };
+
+   struct Entry
+   {
+      int source = -1;
+      QString sha;
+   };
+
+   QVector<Source> mSources;
+   QVector<Entry> mMerged;
+   QTimer *mResetDebounce = nullptr;
+
+   /**
+    * @brief restartMerge Drops the merged list and restarts every source cursor. The view refills
+    * the visible window lazily afterwards.
+    */
+   void restartMerge();
+};
@@ -0,0 +1,36 @@
+#include "FederatedHistoryWidget.h"
+
+#include <FederatedHistoryModel.h>
+
+#include <QHeaderView>
+#include <QTreeView>
+#include <QVBoxLayout>
+
+FederatedHistoryWidget::FederatedHistoryWidget(QWidget *parent)
+   : QFrame(parent)
+   , mModel(new FederatedHistoryModel(this))
+   , mView(new QTreeView())
+{
+   setWindowFlags(Qt::Window);
+   setWindowTitle(tr("Federated history"));
+   setAttribute(Qt::WA_DeleteOnClose, false);
+
+   mView->setModel(mModel);
+   mView->setRootIsDecorated(false);
+   mView->setItemsExpandable(false);
+   mView->setUniformRowHeights(true);
+   mView->setSelectionMode(QAbstractItemView::SingleSelection);
+   mView->header()->setSectionResizeMode(static_cast<int>(FederatedHistoryColumns::Log), QHeaderView::Stretch);
+   mView->header()->setStretchLastSection(false);
+
+   const auto layout = new QVBoxLayout(this);
+   layout->setContentsMargins(10, 10, 10, 10);
+   layout->addWidget(mView);
+
+   resize(900, 600);
+}
+
+void FederatedHistoryWidget::setSources(const QVector<QPair<QString, QSharedPointer<GitCache>>> &sources)
+{
+   mModel->setSources(sources);
+}
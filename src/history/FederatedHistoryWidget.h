@@ -0,0 +1,62 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+#include <QFrame>
+#include <QSharedPointer>
+#include <QVector>
+
+class FederatedHistoryModel;
+class GitCache;
+class QTreeView;
+
+/**
+ * @brief The FederatedHistoryWidget shows the merged, time-ordered history of every open
+ * repository in a standalone window. The data comes from the per-repository caches through
+ * FederatedHistoryModel, so no extra git process runs for the federated view.
+ *
+ * @class FederatedHistoryWidget FederatedHistoryWidget.h "FederatedHistoryWidget.h"
+ */
+class FederatedHistoryWidget : public QFrame
+{
+   Q_OBJECT
+
+public:
+   /**
+    * @brief Default constructor.
+    *
+    * @param parent The parent widget if needed.
+    */
+   explicit FederatedHistoryWidget(QWidget *parent = nullptr);
+
+   /**
+    * @brief setSources Replaces the set of repositories whose histories are merged.
+    * @param sources Pairs of repository name and its cache.
+    */
+   void setSources(const QVector<QPair<QString, QSharedPointer<GitCache>>> &sources);
+
+private:
+   FederatedHistoryModel *mModel = nullptr;
+   QTreeView *mView = nullptr;
+};
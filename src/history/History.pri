@@ -5,6 +5,9 @@ HEADERS += \
     $$PWD/CommitHistoryContextMenu.h \
     $$PWD/CommitHistoryModel.h \
     $$PWD/CommitHistoryView.h \
+    $$PWD/FederatedHistoryModel.h \
+    $$PWD/FederatedHistoryWidget.h \
+    $$PWD/HistoryExporter.h \
     $$PWD/RepositoryViewDelegate.h \
     $$PWD/ShaFilterProxyModel.h
 
@@ -12,5 +15,8 @@ SOURCES += \
     $$PWD/CommitHistoryContextMenu.cpp \
     $$PWD/CommitHistoryModel.cpp \
     $$PWD/CommitHistoryView.cpp \
+    $$PWD/FederatedHistoryModel.cpp \
+    $$PWD/FederatedHistoryWidget.cpp \
+    $$PWD/HistoryExporter.cpp \
     $$PWD/RepositoryViewDelegate.cpp \
     $$PWD/ShaFilterProxyModel.cpp
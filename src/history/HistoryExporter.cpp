@@ -0,0 +1,180 @@
+#include "HistoryExporter.h"
+
+#include <CommitInfo.h>
+#include <GitCache.h>
+#include <TaskPool.h>
+
+#include <QLogger.h>
+
+#include <QDateTime>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QtConcurrent>
+
+using namespace QLogger;
+
+namespace
+{
+// The rows are serialized into a memory buffer flushed in large writes, so the export pays one
+// syscall per chunk instead of one per row
+constexpr auto FlushThresholdBytes = 256 * 1024;
+// Progress is reported once per batch of rows to keep the queued signal traffic negligible
+constexpr auto ProgressBatchMask = 0xFFF;
+}
+
+HistoryExporter::HistoryExporter(const QSharedPointer<GitCache> &cache, QObject *parent)
+   : QObject(parent)
+   , mCache(cache)
+{
+}
+
+HistoryExporter::~HistoryExporter()
+{
+   mGeneration.ref();
+   mFuture.waitForFinished();
+}
+
+void HistoryExporter::exportRows(const QString &filePath, const QVector<int> &rows)
+{
+   QLog_Info("UI", QString("Exporting {%1} commits into {%2}.").arg(QString::number(rows.count()), filePath));
+
+   mGeneration.ref();
+
+   const auto generation = mGeneration.loadAcquire();
+
+   // An export still in flight is superseded by the generation bump and drained before the future
+   // is reassigned, so the destructor never misses a running task that captured this
+   mFuture.waitForFinished();
+
+   mFuture = QtConcurrent::run(TaskPool::instance()->pool(), [this, filePath, rows, generation]() {
+      QFile file(filePath);
+
+      if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+      {
+         if (generation == mGeneration.loadAcquire())
+            emit exportFinished(false, filePath);
+
+         return;
+      }
+
+      const auto success = filePath.endsWith(".json", Qt::CaseInsensitive) ? writeJson(file, rows, generation)
+                                                                           : writeCsv(file, rows, generation);
+
+      // A superseded generation means the exporter is being destroyed; nothing listens anymore
+      if (generation != mGeneration.loadAcquire())
+         return;
+
+      emit exportFinished(success && file.error() == QFile::NoError, filePath);
+   });
+}
+
+bool HistoryExporter::writeCsv(QFile &file, const QVector<int> &rows, int generation)
+{
+   QByteArray buffer;
+   buffer.reserve(FlushThresholdBytes + 1024);
+   buffer.append("sha,date,author,committer,message\n");
+
+   const auto total = rows.count();
+
+   for (auto i = 0; i < total; ++i)
+   {
+      const auto commit = mCache->commitInfo(rows.at(i));
+
+      if (!commit.isValid())
+         continue;
+
+      buffer.append(commit.sha().toUtf8());
+      buffer.append(',');
+      buffer.append(QDateTime::fromSecsSinceEpoch(commit.authorDateSecs()).toString(Qt::ISODate).toUtf8());
+      buffer.append(',');
+      buffer.append(csvEscape(commit.author()).toUtf8());
+      buffer.append(',');
+      buffer.append(csvEscape(commit.committer()).toUtf8());
+      buffer.append(',');
+      buffer.append(csvEscape(commit.shortLog()).toUtf8());
+      buffer.append('\n');
+
+      if (buffer.count() >= FlushThresholdBytes)
+      {
+         if (file.write(buffer) == -1)
+            return false;
+
+         buffer.clear();
+      }
+
+      if ((i & ProgressBatchMask) == 0)
+      {
+         if (generation != mGeneration.loadAcquire())
+            return false;
+
+         emit progressChanged(static_cast<int>(i * 100LL / total));
+      }
+   }
+
+   return file.write(buffer) != -1;
+}
+
+bool HistoryExporter::writeJson(QFile &file, const QVector<int> &rows, int generation)
+{
+   QByteArray buffer;
+   buffer.reserve(FlushThresholdBytes + 1024);
+   buffer.append("[\n");
+
+   const auto total = rows.count();
+   auto first = true;
+
+   for (auto i = 0; i < total; ++i)
+   {
+      const auto commit = mCache->commitInfo(rows.at(i));
+
+      if (!commit.isValid())
+         continue;
+
+      if (!first)
+         buffer.append(",\n");
+
+      first = false;
+
+      // Each row is serialized through QJsonObject so the escaping stays correct; the document
+      // itself is never materialized as a whole
+      const QJsonObject entry { { "sha", commit.sha() },
+                                { "date", QDateTime::fromSecsSinceEpoch(commit.authorDateSecs()).toString(Qt::ISODate) },
+                                { "author", commit.author() },
+                                { "committer", commit.committer() },
+                                { "message", commit.shortLog() } };
+
+      buffer.append(QJsonDocument(entry).toJson(QJsonDocument::Compact));
+
+      if (buffer.count() >= FlushThresholdBytes)
+      {
+         if (file.write(buffer) == -1)
+            return false;
+
+         buffer.clear();
+      }
+
+      if ((i & ProgressBatchMask) == 0)
+      {
+         if (generation != mGeneration.loadAcquire())
+            return false;
+
+         emit progressChanged(static_cast<int>(i * 100LL / total));
+      }
+   }
+
+   buffer.append("\n]\n");
+
+   return file.write(buffer) != -1;
+}
+
+QString HistoryExporter::csvEscape(const QString &value)
+{
+   if (!value.contains(',') && !value.contains('"') && !value.contains('\n'))
+      return value;
+
+   auto escaped = value;
+   escaped.replace("\"", "\"\"");
+
+   return QString("\"%1\"").arg(escaped);
+}
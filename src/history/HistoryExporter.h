@@ -0,0 +1,107 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+#include <QAtomicInt>
+#include <QFuture>
+#include <QObject>
+#include <QSharedPointer>
+#include <QVector>
+
+class GitCache;
+class QFile;
+
+/**
+ * @brief The HistoryExporter class streams the commit metadata of the given rows from the cache
+ * into a CSV or JSON file, chosen by the file extension. The export runs on the task pool with
+ * buffered writes and reports its progress, so even very large histories export in seconds
+ * without freezing the UI.
+ */
+class HistoryExporter : public QObject
+{
+   Q_OBJECT
+
+signals:
+   /**
+    * @brief progressChanged Signal triggered while the export advances.
+    * @param percentage The progress percentage.
+    */
+   void progressChanged(int percentage);
+   /**
+    * @brief exportFinished Signal triggered when the export ends.
+    * @param success True if the file was fully written.
+    * @param filePath The path of the exported file.
+    */
+   void exportFinished(bool success, QString filePath);
+
+public:
+   /**
+    * @brief Default constructor.
+    *
+    * @param cache The internal repository cache to export from.
+    * @param parent The parent object if needed.
+    */
+   explicit HistoryExporter(const QSharedPointer<GitCache> &cache, QObject *parent = nullptr);
+   /**
+    * @brief Destructor. Cancels a running export and waits for the worker, so destroying the
+    * exporter mid-export never leaves the task writing through a dangling pointer.
+    */
+   ~HistoryExporter();
+
+   /**
+    * @brief exportRows Starts the export of the given cache rows into the given file. A .json
+    * extension selects the JSON format, anything else exports CSV.
+    * @param filePath The destination file path.
+    * @param rows The cache rows to export, in the order they should be written.
+    */
+   void exportRows(const QString &filePath, const QVector<int> &rows);
+
+private:
+   QSharedPointer<GitCache> mCache;
+   QAtomicInt mGeneration;
+   QFuture<void> mFuture;
+
+   /**
+    * @brief writeCsv Streams the rows as CSV with a header line.
+    * @param file The open destination file.
+    * @param rows The cache rows to export.
+    * @param generation The export generation; the writer aborts when it is superseded.
+    * @return True on success.
+    */
+   bool writeCsv(QFile &file, const QVector<int> &rows, int generation);
+   /**
+    * @brief writeJson Streams the rows as a JSON array of objects.
+    * @param file The open destination file.
+    * @param rows The cache rows to export.
+    * @param generation The export generation; the writer aborts when it is superseded.
+    * @return True on success.
+    */
+   bool writeJson(QFile &file, const QVector<int> &rows, int generation);
+   /**
+    * @brief csvEscape Quotes the given value when it contains separators, quotes or newlines.
+    * @param value The value to escape.
+    * @return The CSV-safe value.
+    */
+   static QString csvEscape(const QString &value);
+};
@@ -9,6 +9,7 @@
 #include <GitCache.h>
 #include <GitLocal.h>
 #include <GitQlientStyles.h>
+#include <PerfProfiler.h>
 #include <GitServerCache.h>
 #include <Lane.h>
 #include <LaneType.h>
@@ -16,10 +17,13 @@
 
 #include <QApplication>
 #include <QClipboard>
+#include <QDateTime>
 #include <QDesktopServices>
 #include <QEvent>
+#include <QMouseEvent>
 #include <QPainter>
 #include <QPainterPath>
+#include <QPixmapCache>
 #include <QSortFilterProxyModel>
 #include <QToolTip>
 #include <QUrl>
@@ -28,6 +32,10 @@ using namespace GitServer;
 
 static const int MIN_VIEW_WIDTH_PX = 480;
 
+// Rows wider than this cap collapse their cold lanes into a summarized gutter, so octopus merges
+// and wide release branches don't make every painted row scale with the branch width
+static const int MAX_VISIBLE_LANES = 16;
+
 RepositoryViewDelegate::RepositoryViewDelegate(const QSharedPointer<GitCache> &cache,
                                                const QSharedPointer<GitBase> &git,
                                                const QSharedPointer<GitServerCache> &gitServerCache,
@@ -41,20 +49,29 @@ RepositoryViewDelegate::RepositoryViewDelegate(const QSharedPointer<GitCache> &c
 
 void RepositoryViewDelegate::paint(QPainter *p, const QStyleOptionViewItem &opt, const QModelIndex &index) const
 {
+   PerfScopedTimer timer("RepositoryViewDelegate::paint", "ui");
+
    p->setRenderHints(QPainter::Antialiasing);
 
    QStyleOptionViewItem newOpt(opt);
    newOpt.font.setPointSize(9);
 
+   const auto row = mView->hasActiveFilter()
+       ? dynamic_cast<QSortFilterProxyModel *>(mView->model())->mapToSource(index).row()
+       : index.row();
+
    if (newOpt.state & QStyle::State_Selected)
       p->fillRect(newOpt.rect, GitQlientStyles::getGraphSelectionColor());
+   else if (mView->isSearchMatch(row))
+   {
+      // The bitset test is constant cost, so every match of the search is tinted per paint
+      auto matchColor = gitQlientOrange;
+      matchColor.setAlpha(50);
+      p->fillRect(newOpt.rect, matchColor);
+   }
    else if (newOpt.state & QStyle::State_MouseOver)
       p->fillRect(newOpt.rect, GitQlientStyles::getGraphHoverColor());
 
-   const auto row = mView->hasActiveFilter()
-       ? dynamic_cast<QSortFilterProxyModel *>(mView->model())->mapToSource(index).row()
-       : index.row();
-
    const auto commit = mCache->commitInfo(row);
 
    if (commit.sha().isEmpty())
@@ -140,6 +157,33 @@ bool RepositoryViewDelegate::editorEvent(QEvent *event, QAbstractItemModel *mode
       mColumnPressed = cursorColumn;
       return true;
    }
+   else if (event->type() == QEvent::MouseButtonRelease && cursorColumn == index.column()
+            && cursorColumn == static_cast<int>(CommitHistoryColumns::Graph)
+            && (mGraphCompressionActive || mGraphExpanded))
+   {
+      const auto row = mView->hasActiveFilter()
+          ? dynamic_cast<QSortFilterProxyModel *>(mView->model())->mapToSource(index).row()
+          : index.row();
+      const auto commit = mCache->commitInfo(row);
+      const auto laneNum = commit.getLanesCount();
+
+      if (laneNum > MAX_VISIBLE_LANES)
+      {
+         const auto visibleLanes
+             = mGraphExpanded ? laneNum : qMin(qMax(MAX_VISIBLE_LANES, commit.getActiveLane() + 2), laneNum);
+         const auto clickX = static_cast<QMouseEvent *>(event)->pos().x() - option.rect.x() - 10;
+
+         // Only clicks on the summarized gutter (or past it, once expanded) toggle the compression
+         if (clickX >= LANE_WIDTH * (visibleLanes - 1))
+         {
+            mGraphExpanded = !mGraphExpanded;
+            mGraphCompressionActive = false;
+            mView->viewport()->update();
+
+            return true;
+         }
+      }
+   }
    else if (event->type() == QEvent::MouseButtonRelease && cursorColumn == index.column() && mColumnPressed != -1)
    {
       const auto text = index.data().toString();
@@ -159,6 +203,45 @@ bool RepositoryViewDelegate::editorEvent(QEvent *event, QAbstractItemModel *mode
 void RepositoryViewDelegate::paintGraphLane(QPainter *p, const Lane &lane, bool laneHeadPresent, int x1, int x2,
                                             const QColor &col, const QColor &activeCol, const QColor &mergeColor,
                                             bool isWip, bool hasChilds) const
+{
+   // The same few glyph combinations repeat for thousands of rows, so each one is rasterized once
+   // per color set and blitted from the global pixmap cache afterwards
+   const auto dpr = p->device() ? p->device()->devicePixelRatioF() : 1.0;
+   const auto key = QString("gql_%1_%2_%3_%4_%5_%6_%7_%8")
+                        .arg(static_cast<int>(lane.getType()))
+                        .arg(laneHeadPresent)
+                        .arg(col.rgba())
+                        .arg(activeCol.rgba())
+                        .arg(mergeColor.rgba())
+                        .arg(isWip)
+                        .arg(hasChilds)
+                        .arg(dpr);
+
+   QPixmap glyph;
+
+   if (!QPixmapCache::find(key, &glyph))
+   {
+      const auto width = x2 - x1 + 4;
+
+      glyph = QPixmap(QSizeF(width * dpr, ROW_HEIGHT * dpr).toSize());
+      glyph.setDevicePixelRatio(dpr);
+      glyph.fill(Qt::transparent);
+
+      QPainter glyphPainter(&glyph);
+      glyphPainter.setRenderHints(QPainter::Antialiasing);
+
+      drawGraphLane(&glyphPainter, lane, laneHeadPresent, 0, x2 - x1, col, activeCol, mergeColor, isWip, hasChilds);
+      glyphPainter.end();
+
+      QPixmapCache::insert(key, glyph);
+   }
+
+   p->drawPixmap(x1, 0, glyph);
+}
+
+void RepositoryViewDelegate::drawGraphLane(QPainter *p, const Lane &lane, bool laneHeadPresent, int x1, int x2,
+                                           const QColor &col, const QColor &activeCol, const QColor &mergeColor,
+                                           bool isWip, bool hasChilds) const
 {
    const auto padding = 2;
    x1 += padding;
@@ -375,6 +458,13 @@ void RepositoryViewDelegate::paintGraph(QPainter *p, const QStyleOptionViewItem
          paintGraphLane(p, LaneType::BRANCH, false, 0, LANE_WIDTH, color, activeColor, activeColor, true,
                         commit.parentsCount() != 0);
       }
+      else if (commit.getLanesCount() == 0)
+      {
+         // The lanes for this row are still being computed in the background: paint a plain lane
+         // as placeholder until the cache publishes them
+         const auto color = GitQlientStyles::getBranchColorAt(0);
+         paintGraphLane(p, LaneType::ACTIVE, false, 0, LANE_WIDTH, color, color, color, false, false);
+      }
       else
       {
          const auto laneNum = commit.getLanesCount();
@@ -386,7 +476,33 @@ void RepositoryViewDelegate::paintGraph(QPainter *p, const QStyleOptionViewItem
          auto laneHeadPresent = false;
          auto mergeColor = GitQlientStyles::getBranchColorAt((laneNum - 1) % GitQlientStyles::getTotalBranchColors());
 
-         for (auto i = laneNum - 1, x2 = LANE_WIDTH * laneNum; i >= 0; --i, x2 -= LANE_WIDTH)
+         // The lanes beyond the cap are collapsed into a summarized gutter unless the user expanded
+         // the graph by clicking on it; the active lane is always kept visible
+         auto visibleLanes = laneNum;
+
+         if (!mGraphExpanded && laneNum > MAX_VISIBLE_LANES)
+         {
+            visibleLanes = qMin(qMax(MAX_VISIBLE_LANES, activeLane + 2), laneNum);
+
+            if (visibleLanes < laneNum)
+               mGraphCompressionActive = true;
+         }
+
+         const auto collapsedLanes = visibleLanes < laneNum ? laneNum - visibleLanes + 1 : 0;
+
+         if (collapsedLanes > 0)
+         {
+            auto font = opt.font;
+            font.setPointSize(7);
+            p->setFont(font);
+            p->setPen(GitQlientStyles::getTextColor());
+            p->drawText(QRect(LANE_WIDTH * (visibleLanes - 1), 0, LANE_WIDTH + 10, ROW_HEIGHT),
+                        Qt::AlignVCenter | Qt::AlignLeft, QString("+%1").arg(collapsedLanes));
+         }
+
+         const auto firstPaintedLane = collapsedLanes > 0 ? visibleLanes - 2 : laneNum - 1;
+
+         for (auto i = firstPaintedLane, x2 = LANE_WIDTH * (firstPaintedLane + 1); i >= 0; --i, x2 -= LANE_WIDTH)
          {
             x1 = x2 - LANE_WIDTH;
 
@@ -445,64 +561,45 @@ void RepositoryViewDelegate::paintLog(QPainter *p, const QStyleOptionViewItem &o
    auto newOpt = opt;
    newOpt.rect.setX(opt.rect.x() + offset + 5);
 
-   QFontMetrics fm(newOpt.font);
+   // The elided and prepared layout of the message is reused until the column width changes, so
+   // scrolling doesn't re-elide and re-lay-out every visible row on each paint
+   if (!mLogTextCache.contains(text) && mLogTextCache.count() >= 20000)
+      mLogTextCache.clear();
+
+   auto &cached = mLogTextCache[text];
+
+   if (cached.width != newOpt.rect.width())
+   {
+      QFontMetrics fm(newOpt.font);
+      cached.width = newOpt.rect.width();
+      cached.text.setText(fm.elidedText(text, Qt::ElideRight, cached.width));
+      cached.text.prepare(QTransform(), newOpt.font);
+   }
 
    p->setFont(newOpt.font);
    p->setPen(GitQlientStyles::getTextColor());
-   p->drawText(newOpt.rect, fm.elidedText(text, Qt::ElideRight, newOpt.rect.width()),
-               QTextOption(Qt::AlignLeft | Qt::AlignVCenter));
+
+   const auto y = newOpt.rect.y() + (newOpt.rect.height() - cached.text.size().height()) / 2.0;
+   p->drawStaticText(QPointF(newOpt.rect.x(), y), cached.text);
 }
 
 void RepositoryViewDelegate::paintTagBranch(QPainter *painter, QStyleOptionViewItem o, int &startPoint,
                                             const QString &sha) const
 {
-   if (mCache->hasReferences(sha) && !mView->hasActiveFilter())
+   if (!mView->hasActiveFilter())
    {
-      QVector<QString> marks;
-      QVector<QColor> colors;
-      const auto currentBranch = mGit->getCurrentBranch();
+      // Undecorated commits are the vast majority, so their empty entries are cached too and the
+      // whole check is a single table access
+      const auto &decoration = decorationFor(sha);
+      const auto &marks = decoration.marks;
+      const auto &colors = decoration.colors;
+
+      if (marks.isEmpty())
+         return;
 
       if (startPoint == 0)
          startPoint = 5;
 
-      if ((currentBranch.isEmpty() || currentBranch == "HEAD"))
-      {
-         if (const auto ret = mGit->getLastCommit(); ret.success && sha == ret.output.toString().trimmed())
-         {
-            marks.append("detached");
-            colors.append(graphDetached);
-         }
-      }
-
-      const auto localBranches = mCache->getReferences(sha, References::Type::LocalBranch);
-      for (const auto &branch : localBranches)
-      {
-         if (branch == currentBranch)
-         {
-            marks.prepend(branch);
-            colors.prepend(graphCurrentBranch);
-         }
-         else
-         {
-            marks.append(branch);
-            colors.append(graphLocalBranch);
-         }
-      }
-
-      const auto tags = mCache->getReferences(sha, References::Type::LocalTag);
-      for (const auto &tag : tags)
-      {
-         marks.append(tag);
-         colors.append(graphTag);
-      }
-
-      const auto remoteBranches = mCache->getReferences(sha, References::Type::RemoteBranches);
-      for (const auto &branch : remoteBranches)
-      {
-         marks.append(branch);
-         colors.append(graphRemoteBranch);
-      }
-
       const auto showMinimal = o.rect.width() <= MIN_VIEW_WIDTH_PX;
       const auto mark_spacing = 5; // Space between markers in pixels
       const auto mapEnd = marks.constEnd();
@@ -511,7 +608,7 @@ void RepositoryViewDelegate::paintTagBranch(QPainter *painter, QStyleOptionViewI
       auto colorIter = colors.constBegin();
       for (; mapIt != mapEnd; ++mapIt, ++colorIter)
       {
-         const auto isCurrentSpot = *mapIt == "detached" || *mapIt == currentBranch;
+         const auto isCurrentSpot = *mapIt == "detached" || *mapIt == mCurrentBranch;
          o.font.setBold(isCurrentSpot);
 
          const auto nameToDisplay = showMinimal ? QString(". . .") : *mapIt;
@@ -541,6 +638,72 @@ void RepositoryViewDelegate::paintTagBranch(QPainter *painter, QStyleOptionViewI
    }
 }
 
+const RepositoryViewDelegate::Decoration &RepositoryViewDelegate::decorationFor(const QString &sha) const
+{
+   if (const auto generation = mCache->referenceGeneration(); generation != mDecorationGeneration)
+   {
+      // The references changed: the table is dropped and every commit resolves its badges again on
+      // its first paint. The current branch and the detached HEAD are resolved once per update
+      // instead of once per painted row.
+      mDecorations.clear();
+      mDecorationGeneration = generation;
+      mCurrentBranch = mGit->getCurrentBranch();
+      mDetachedSha.clear();
+
+      if (mCurrentBranch.isEmpty() || mCurrentBranch == "HEAD")
+      {
+         if (const auto ret = mGit->getLastCommit(); ret.success)
+            mDetachedSha = ret.output.toString().trimmed();
+      }
+   }
+
+   auto iter = mDecorations.find(sha);
+
+   if (iter == mDecorations.end())
+   {
+      Decoration decoration;
+
+      if (sha == mDetachedSha && mCache->hasReferences(sha))
+      {
+         decoration.marks.append("detached");
+         decoration.colors.append(graphDetached);
+      }
+
+      const auto localBranches = mCache->getReferences(sha, References::Type::LocalBranch);
+      for (const auto &branch : localBranches)
+      {
+         if (branch == mCurrentBranch)
+         {
+            decoration.marks.prepend(branch);
+            decoration.colors.prepend(graphCurrentBranch);
+         }
+         else
+         {
+            decoration.marks.append(branch);
+            decoration.colors.append(graphLocalBranch);
+         }
+      }
+
+      const auto tags = mCache->getReferences(sha, References::Type::LocalTag);
+      for (const auto &tag : tags)
+      {
+         decoration.marks.append(tag);
+         decoration.colors.append(graphTag);
+      }
+
+      const auto remoteBranches = mCache->getReferences(sha, References::Type::RemoteBranches);
+      for (const auto &branch : remoteBranches)
+      {
+         decoration.marks.append(branch);
+         decoration.colors.append(graphRemoteBranch);
+      }
+
+      iter = mDecorations.insert(sha, decoration);
+   }
+
+   return *iter;
+}
+
 void RepositoryViewDelegate::paintPrStatus(QPainter *painter, QStyleOptionViewItem opt, int &startPoint,
                                            const PullRequest &pr) const
 {
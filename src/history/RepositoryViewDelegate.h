@@ -25,6 +25,8 @@
 
 #include <QStyledItemDelegate>
 #include <QDateTime>
+#include <QHash>
+#include <QStaticText>
 
 class CommitHistoryView;
 class GitCache;
@@ -82,12 +84,39 @@ protected:
                     const QModelIndex &index) override;
 
 private:
+   /**
+    * @brief The Decoration struct stores the resolved branch/tag badges of a commit, so painting a row is a table
+    * access instead of repeated reference-map queries.
+    */
+   struct Decoration
+   {
+      QVector<QString> marks;
+      QVector<QColor> colors;
+   };
+
+   /**
+    * @brief The CachedText struct keeps the elided and laid-out text of a cell for the width it was last painted
+    * with, so steady-state scrolling draws prepared layouts instead of re-eliding every row.
+    */
+   struct CachedText
+   {
+      int width = -1;
+      QStaticText text;
+   };
+
    QSharedPointer<GitCache> mCache;
    QSharedPointer<GitBase> mGit;
    QSharedPointer<GitServerCache> mGitServerCache;
    CommitHistoryView *mView = nullptr;
    int diffTargetRow = -1;
    int mColumnPressed = -1;
+   mutable QHash<QString, Decoration> mDecorations;
+   mutable QHash<QString, CachedText> mLogTextCache;
+   mutable int mDecorationGeneration = -1;
+   mutable QString mCurrentBranch;
+   mutable QString mDetachedSha;
+   mutable bool mGraphCompressionActive = false;
+   bool mGraphExpanded = false;
 
    /**
     * @brief Paints the log column. This method is in charge of painting the commit message as well as tags or
@@ -124,6 +153,13 @@ private:
                        const QColor &activeCol, const QColor &mergeColor, bool isWip = false,
                        bool hasChilds = true) const;
 
+   /**
+    * @brief Draws the lane glyph with vector primitives. Only called by @ref paintGraphLane on a
+    * pixmap cache miss; the blit path is taken for the repeated combinations.
+    */
+   void drawGraphLane(QPainter *p, const Lane &type, bool laneHeadPresent, int x1, int x2, const QColor &col,
+                      const QColor &activeCol, const QColor &mergeColor, bool isWip, bool hasChilds) const;
+
    /**
     * @brief Specialized method that paints a tag in the commit message column.
     *
@@ -134,6 +170,14 @@ private:
     */
    void paintTagBranch(QPainter *painter, QStyleOptionViewItem opt, int &startPoint, const QString &sha) const;
 
+   /**
+    * @brief decorationFor Gets the badges of the given commit from the decoration table. The table is dropped
+    * whenever the cached references change, so scrolling only resolves every commit once per reference update.
+    * @param sha The SHA of the commit being painted.
+    * @return The resolved badges for the commit.
+    */
+   const Decoration &decorationFor(const QString &sha) const;
+
    /**
     * @brief Specialized method that paints a tag in the commit message column.
     *
@@ -9,6 +9,9 @@ ShaFilterProxyModel::ShaFilterProxyModel(QObject *parent)
 
 bool ShaFilterProxyModel::filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const
 {
+   if (!mFilterActive)
+      return true;
+
    const auto shaIndex = sourceModel()->index(sourceRow, static_cast<int>(CommitHistoryColumns::Sha), sourceParent);
    const auto sha = sourceModel()->data(shaIndex).toString();
    return mAcceptedShas.contains(sha);
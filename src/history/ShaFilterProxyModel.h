@@ -23,6 +23,7 @@
  ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
  ***************************************************************************************/
 
+#include <QSet>
 #include <QSortFilterProxyModel>
 
 /**
@@ -43,11 +44,27 @@ public:
    explicit ShaFilterProxyModel(QObject *parent = nullptr);
 
    /**
-    * @brief Sets the list of accepted SHAs that will be shown in the source model.
+    * @brief Sets the list of accepted SHAs that will be shown in the source model. The list is
+    * indexed into a hash set so the per-row filter check is O(1) regardless of the branch size.
     *
     * @param acceptedShaList The SHAs list.
     */
-   void setAcceptedSha(const QStringList &acceptedShaList) { mAcceptedShas = acceptedShaList; }
+   void setAcceptedSha(const QStringList &acceptedShaList)
+   {
+#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
+      mAcceptedShas = QSet<QString>(acceptedShaList.cbegin(), acceptedShaList.cend());
+#else
+      mAcceptedShas = QSet<QString>::fromList(acceptedShaList);
+#endif
+   }
+   /**
+    * @brief Enables or disables the filter. When disabled the proxy accepts every source row, so
+    * the view keeps its proxy installed and switching between the filtered and the full history is
+    * a model reset instead of a model swap.
+    *
+    * @param active True to filter by the accepted SHAs, false to accept every row.
+    */
+   void setFilterActive(bool active) { mFilterActive = active; }
    /**
     * @brief Starts the reset of the model
     *
@@ -72,7 +89,11 @@ protected:
 
 private:
    /**
-    * @brief mAcceptedShas List of accepted shas.
+    * @brief mAcceptedShas Set of accepted shas.
+    */
+   QSet<QString> mAcceptedShas;
+   /**
+    * @brief mFilterActive Whether the filter applies. When false every row is accepted.
     */
-   QStringList mAcceptedShas;
+   bool mFilterActive = true;
 };
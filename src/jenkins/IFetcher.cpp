@@ -1,5 +1,7 @@
 #include "IFetcher.h"
 
+#include <TaskPool.h>
+
 #include <QNetworkAccessManager>
 #include <QNetworkReply>
 #include <QNetworkRequest>
@@ -7,12 +9,43 @@
 
 #include <QLogger.h>
 
+#include <QPointer>
+#include <QQueue>
 #include <QUrlQuery>
+#include <QtConcurrent/QtConcurrentRun>
 
 using namespace QLogger;
 
 namespace Jenkins
 {
+
+namespace
+{
+// Bound of concurrent Jenkins requests. Enough to keep the pipeline busy while populating big
+// instances, low enough not to flood the server or starve the rest of the network stack.
+constexpr auto MaxInFlightRequests = 8;
+
+struct PendingRequest
+{
+   QPointer<IFetcher> fetcher;
+   QNetworkRequest request;
+};
+
+// All the fetchers live in the UI thread, so the queue needs no locking.
+QQueue<PendingRequest> &pendingRequests()
+{
+   static QQueue<PendingRequest> queue;
+
+   return queue;
+}
+
+int &inFlightRequests()
+{
+   static auto count = 0;
+
+   return count;
+}
+}
 IFetcher::IFetcher(const Config &config, QObject *parent)
    : QObject(parent)
    , mConfig(config)
@@ -45,8 +78,35 @@ void IFetcher::get(const QString &urlStr, bool customUrl)
       request.setRawHeader("Authorization", QString(QString::fromUtf8("Basic ") + data).toLocal8Bit());
    }
 
-   const auto reply = mConfig.accessManager->get(request);
-   connect(reply, &QNetworkReply::finished, this, &IFetcher::processReply);
+   enqueueRequest(this, request);
+}
+
+void IFetcher::enqueueRequest(IFetcher *fetcher, const QNetworkRequest &request)
+{
+   pendingRequests().enqueue({ fetcher, request });
+
+   dispatchPendingRequests();
+}
+
+void IFetcher::dispatchPendingRequests()
+{
+   while (inFlightRequests() < MaxInFlightRequests && !pendingRequests().isEmpty())
+   {
+      const auto pending = pendingRequests().dequeue();
+
+      // The fetcher may have been destroyed while its request waited in the queue.
+      if (!pending.fetcher)
+         continue;
+
+      ++inFlightRequests();
+
+      const auto reply = pending.fetcher->mConfig.accessManager->get(pending.request);
+      connect(reply, &QNetworkReply::finished, pending.fetcher, &IFetcher::processReply);
+      connect(reply, &QNetworkReply::finished, reply, []() {
+         --inFlightRequests();
+         dispatchPendingRequests();
+      });
+   }
 }
 
 void IFetcher::processReply()
@@ -57,15 +117,30 @@ void IFetcher::processReply()
    if (data.isEmpty())
       QLog_Warning("Jenkins", QString("Reply from {%1} is empty.").arg(reply->url().toString()));
 
-   const auto json = QJsonDocument::fromJson(data);
-
-   if (json.isNull())
-   {
-      QLog_Error("Jenkins", QString("Data from {%1} is not a valid JSON").arg(reply->url().toString()));
-      QLog_Trace("Jenkins", QString("Data received:\n%1").arg(QString::fromUtf8(data)));
-      return;
-   }
-
-   processData(json);
+   // Big instances answer with multi-MB documents: the JSON is parsed once on the shared pool and
+   // the parsed document is handed back queued, so the UI thread never stalls on the parse. The
+   // queued call is dropped automatically when the fetcher is destroyed meanwhile.
+   QtConcurrent::run(TaskPool::instance()->pool(),
+                     [fetcher = QPointer<IFetcher>(this), data, url = reply->url().toString()]() {
+                        const auto json = QJsonDocument::fromJson(data);
+
+                        if (json.isNull())
+                        {
+                           QLog_Error("Jenkins", QString("Data from {%1} is not a valid JSON").arg(url));
+                           QLog_Trace("Jenkins", QString("Data received:\n%1").arg(QString::fromUtf8(data)));
+                           return;
+                        }
+
+                        if (fetcher)
+                        {
+                           QMetaObject::invokeMethod(
+                               fetcher,
+                               [fetcher, json]() {
+                                  if (fetcher)
+                                     fetcher->processData(json);
+                               },
+                               Qt::QueuedConnection);
+                        }
+                     });
 }
 }
@@ -6,6 +6,7 @@
 
 class QNetworkAccessManager;
 class QNetworkReply;
+class QNetworkRequest;
 class QJsonDocument;
 
 namespace Jenkins
@@ -34,5 +35,19 @@ protected:
 private:
    virtual void processReply() final;
    virtual void processData(const QJsonDocument &json) = 0;
+
+   /**
+    * @brief enqueueRequest Queues the request in the shared pipeline. The pipeline keeps a bounded
+    * number of requests in flight so a Jenkins instance with hundreds of jobs is fetched in
+    * parallel without flooding the server, and every fetcher streams its result as soon as its
+    * reply lands.
+    * @param fetcher The fetcher that will process the reply.
+    * @param request The prepared network request.
+    */
+   static void enqueueRequest(IFetcher *fetcher, const QNetworkRequest &request);
+   /**
+    * @brief dispatchPendingRequests Issues queued requests until the in-flight bound is reached.
+    */
+   static void dispatchPendingRequests();
 };
 }
@@ -1,27 +1,29 @@
 INCLUDEPATH += $$PWD
 
 SOURCES += \
-    $$PWD/BuildGeneralInfoFetcher.cpp \
     $$PWD/IFetcher.cpp \
+    $$PWD/JenkinsCacheSnapshot.cpp \
     $$PWD/JenkinsJobPanel.cpp \
+    $$PWD/JenkinsLogViewer.cpp \
     $$PWD/JenkinsWidget.cpp \
+    $$PWD/JobBuildsFetcher.cpp \
     $$PWD/JobButton.cpp \
     $$PWD/JobContainer.cpp \
     $$PWD/JobDetailsFetcher.cpp \
     $$PWD/JobFetcher.cpp \
-    $$PWD/RepoFetcher.cpp \
-    $$PWD/StageFetcher.cpp
+    $$PWD/RepoFetcher.cpp
 
 HEADERS += \
-    $$PWD/BuildGeneralInfoFetcher.h \
     $$PWD/IFetcher.h \
+    $$PWD/JenkinsCacheSnapshot.h \
     $$PWD/JenkinsJobInfo.h \
     $$PWD/JenkinsJobPanel.h \
+    $$PWD/JenkinsLogViewer.h \
     $$PWD/JenkinsViewInfo.h \
     $$PWD/JenkinsWidget.h \
+    $$PWD/JobBuildsFetcher.h \
     $$PWD/JobButton.h \
     $$PWD/JobContainer.h \
     $$PWD/JobDetailsFetcher.h \
     $$PWD/JobFetcher.h \
-    $$PWD/RepoFetcher.h \
-    $$PWD/StageFetcher.h
+    $$PWD/RepoFetcher.h
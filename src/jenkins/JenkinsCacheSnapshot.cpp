@@ -0,0 +1,89 @@
+#include "JenkinsCacheSnapshot.h"
+
+#include <QLogger.h>
+
+#include <QDataStream>
+#include <QFile>
+
+using namespace QLogger;
+
+namespace Jenkins
+{
+
+QDataStream &operator<<(QDataStream &out, const JenkinsViewInfo &view)
+{
+   return out << view.url << view.name;
+}
+
+QDataStream &operator>>(QDataStream &in, JenkinsViewInfo &view)
+{
+   return in >> view.url >> view.name;
+}
+
+/* Only the listing fields are persisted: the builds, stages and config of a job are fetched on
+ * demand when it is opened. */
+QDataStream &operator<<(QDataStream &out, const JenkinsJobInfo &job)
+{
+   return out << job.name << job.url << job.color << job.lastBuildNumber;
+}
+
+QDataStream &operator>>(QDataStream &in, JenkinsJobInfo &job)
+{
+   return in >> job.name >> job.url >> job.color >> job.lastBuildNumber;
+}
+
+JenkinsCacheSnapshot::JenkinsCacheSnapshot(const QString &gitDirPath)
+   : mFilePath(gitDirPath + "/GitQlientJenkinsCache.dat")
+{
+}
+
+bool JenkinsCacheSnapshot::save(const QVector<JenkinsViewInfo> &views,
+                                const QHash<QString, QMultiMap<QString, JenkinsJobInfo>> &jobsByView) const
+{
+   QFile file(mFilePath);
+
+   if (!file.open(QIODevice::WriteOnly))
+   {
+      QLog_Warning("Jenkins", QString("Unable to write the Jenkins snapshot to {%1}.").arg(mFilePath));
+
+      return false;
+   }
+
+   QDataStream out(&file);
+   out.setVersion(QDataStream::Qt_5_9);
+
+   out << MagicNumber << Version;
+   out << views << jobsByView;
+
+   QLog_Debug("Jenkins", QString("Jenkins snapshot with {%1} views stored.").arg(views.count()));
+
+   return true;
+}
+
+bool JenkinsCacheSnapshot::load(QVector<JenkinsViewInfo> &views,
+                                QHash<QString, QMultiMap<QString, JenkinsJobInfo>> &jobsByView) const
+{
+   QFile file(mFilePath);
+
+   if (!file.open(QIODevice::ReadOnly))
+      return false;
+
+   const auto buffer = file.readAll();
+
+   QDataStream in(buffer);
+   in.setVersion(QDataStream::Qt_5_9);
+
+   quint32 magic = 0;
+   quint16 version = 0;
+
+   in >> magic >> version;
+
+   if (magic != MagicNumber || version != Version)
+      return false;
+
+   in >> views >> jobsByView;
+
+   return in.status() == QDataStream::Ok && !views.isEmpty();
+}
+
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <JenkinsJobInfo.h>
+#include <JenkinsViewInfo.h>
+
+#include <QHash>
+#include <QMultiMap>
+#include <QString>
+#include <QVector>
+
+namespace Jenkins
+{
+
+/**
+ * @brief Persists the last fetched job tree next to the repository configuration, so the next
+ * session renders the Jenkins tab immediately with the previous data (marked stale) while the
+ * fetchers reconcile it in the background.
+ */
+class JenkinsCacheSnapshot
+{
+public:
+   explicit JenkinsCacheSnapshot(const QString &gitDirPath);
+
+   bool save(const QVector<JenkinsViewInfo> &views,
+             const QHash<QString, QMultiMap<QString, JenkinsJobInfo>> &jobsByView) const;
+   bool load(QVector<JenkinsViewInfo> &views, QHash<QString, QMultiMap<QString, JenkinsJobInfo>> &jobsByView) const;
+
+private:
+   QString mFilePath;
+
+   static const quint32 MagicNumber = 0x47514A4B;
+   static const quint16 Version = 1;
+};
+
+}
@@ -87,6 +87,7 @@ struct JenkinsJobInfo
    QString name;
    QString url;
    QString color;
+   int lastBuildNumber = 0;
    bool buildable;
    bool inQueue;
    HealthStatus healthStatus;
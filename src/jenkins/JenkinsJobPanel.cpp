@@ -1,11 +1,11 @@
 #include <JenkinsJobPanel.h>
 
-#include <BuildGeneralInfoFetcher.h>
+#include <JobBuildsFetcher.h>
 #include <CheckBox.h>
 #include <ButtonLink.hpp>
 #include <QPinnableTabWidget.h>
+#include <JenkinsLogViewer.h>
 #include <JobDetailsFetcher.h>
-#include <DiffHelper.h>
 
 #include <QLogger.h>
 
@@ -14,7 +14,6 @@
 #include <QUrlQuery>
 #include <QComboBox>
 #include <QLineEdit>
-#include <QPlainTextEdit>
 #include <QUrl>
 #include <QFile>
 #include <QLabel>
@@ -136,16 +135,38 @@ void JenkinsJobPanel::loadJobInfo(const JenkinsJobInfo &job)
       else
       {
          mBuild->setVisible(false);
+
+         // The layouts are created upfront and every build is inserted as soon as its details
+         // arrive: the panel is usable with the first reply instead of waiting for the whole set.
+         mBuildListLayout = new QVBoxLayout(mScrollFrame);
+         mBuildListLayout->setContentsMargins(QMargins());
+         mBuildListLayout->setSpacing(10);
+         mBuildListLayout->addStretch();
+
+         mLastBuildLayout = new QHBoxLayout(mLastBuildFrame);
+         mLastBuildLayout->setContentsMargins(10, 10, 10, 10);
+         mLastBuildLayout->setSpacing(10);
+
+         mInsertedBuilds.clear();
+         mLastBuildNumber = 0;
+
          for (const auto &build : qAsConst(mRequestedJob.builds))
-         {
-            const auto buildFetcher = new BuildGeneralInfoFetcher(mConfig, build, this);
-            connect(buildFetcher, &BuildGeneralInfoFetcher::signalBuildInfoReceived, this,
-                    [this](const JenkinsJobBuildInfo &build) { appendJobsData(mRequestedJob.name, build); });
-            connect(buildFetcher, &BuildGeneralInfoFetcher::signalBuildInfoReceived, buildFetcher,
-                    &BuildGeneralInfoFetcher::deleteLater);
-
-            buildFetcher->triggerFetch();
-         }
+            mLastBuildNumber = qMax(mLastBuildNumber, build.number);
+
+         // A single tree-filtered request plus one workflow call bring the details of every
+         // build, instead of two requests per build
+         const auto buildsFetcher = new JobBuildsFetcher(mConfig, mRequestedJob, this);
+         connect(buildsFetcher, &JobBuildsFetcher::signalBuildsInfoReceived, this,
+                 [this, jobName = mRequestedJob.name](const QVector<JenkinsJobBuildInfo> &builds) {
+                    mTmpBuildsCounter = builds.count();
+
+                    for (const auto &build : builds)
+                       appendJobsData(jobName, build);
+                 });
+         connect(buildsFetcher, &JobBuildsFetcher::signalBuildsInfoReceived, buildsFetcher,
+                 &JobBuildsFetcher::deleteLater);
+
+         buildsFetcher->triggerFetch();
       }
    }
 }
@@ -164,44 +185,34 @@ void JenkinsJobPanel::appendJobsData(const QString &jobName, const JenkinsJobBui
 
    --mTmpBuildsCounter;
 
-   if (mTmpBuildsCounter == 0)
-   {
-      mBuildListLayout = new QVBoxLayout(mScrollFrame);
-      mBuildListLayout->setContentsMargins(QMargins());
-      mBuildListLayout->setSpacing(10);
-
-      mLastBuildLayout = new QHBoxLayout(mLastBuildFrame);
-      mLastBuildLayout->setContentsMargins(10, 10, 10, 10);
-      mLastBuildLayout->setSpacing(10);
-
-      std::sort(mRequestedJob.builds.begin(), mRequestedJob.builds.end(),
-                [](const JenkinsJobBuildInfo &build1, const JenkinsJobBuildInfo &build2) {
-                   return build1.number > build2.number;
-                });
-
-      const auto build = mRequestedJob.builds.takeFirst();
-
+   if (build.number == mLastBuildNumber)
       fillBuildLayout(build, mLastBuildLayout);
+   else
+   {
+      const auto stagesLayout = new QHBoxLayout();
+      stagesLayout->setContentsMargins(10, 10, 10, 10);
+      stagesLayout->setSpacing(10);
 
-      for (const auto &build : qAsConst(mRequestedJob.builds))
-      {
-         const auto stagesLayout = new QHBoxLayout();
-         stagesLayout->setContentsMargins(10, 10, 10, 10);
-         stagesLayout->setSpacing(10);
+      fillBuildLayout(build, stagesLayout);
 
-         fillBuildLayout(build, stagesLayout);
+      // The replies arrive in any order: the row is inserted at its place in the number-descending
+      // list, so the streamed panel keeps the same order the batched one had.
+      const auto pos = std::lower_bound(mInsertedBuilds.cbegin(), mInsertedBuilds.cend(), build.number,
+                                        [](int inserted, int number) { return inserted > number; });
+      const auto row = static_cast<int>(std::distance(mInsertedBuilds.cbegin(), pos));
+      mInsertedBuilds.insert(row, build.number);
 
-         mBuildListLayout->addLayout(stagesLayout);
-      }
+      mBuildListLayout->insertLayout(row, stagesLayout);
+   }
 
+   if (mTmpBuildsCounter == 0)
+   {
       const auto hasCustomBuildConfig = !mRequestedJob.configFields.isEmpty();
 
       mBuild->setVisible(!hasCustomBuildConfig);
 
       if (hasCustomBuildConfig)
          createBuildConfigPanel();
-
-      mBuildListLayout->addStretch();
    }
 }
 
@@ -280,53 +291,16 @@ void JenkinsJobPanel::requestFile(const JenkinsJobBuildInfo &build)
       mTabWidget->setCurrentIndex(mTabBuildMap.value(build.number));
    else
    {
-      auto urlStr = build.url;
-      urlStr.append("/consoleText");
-      QNetworkRequest request(urlStr);
-
-      if (!mConfig.user.isEmpty() && !mConfig.token.isEmpty())
-         request.setRawHeader(QByteArray("Authorization"),
-                              QString("Basic %1:%2").arg(mConfig.user, mConfig.token).toLocal8Bit().toBase64());
-
-      const auto reply = mManager->get(request);
-      connect(reply, &QNetworkReply::finished, this, [this, number = build.number]() { storeFile(number); });
-   }
-}
+      // The console output streams through the progressive-text endpoint into the viewer, so the
+      // tab opens right away and huge pipeline logs never arrive as one blob
+      const auto viewer = new JenkinsLogViewer(mConfig, build.url);
+      mTempWidgets.append(viewer);
 
-void JenkinsJobPanel::storeFile(int buildNumber)
-{
-   const auto reply = qobject_cast<QNetworkReply *>(sender());
-   const auto data = reply->readAll();
-
-   if (!data.isEmpty())
-   {
-      const auto text = new QPlainTextEdit(QString::fromUtf8(data));
-      text->setReadOnly(true);
-      text->setObjectName("JenkinsOutput");
-      mTempWidgets.append(text);
-
-      const auto find = new QLineEdit();
-      find->setPlaceholderText(tr("Find text... "));
-      connect(find, &QLineEdit::editingFinished, this,
-              [this, text, find]() { DiffHelper::findString(find->text(), text, this); });
-      mTempWidgets.append(find);
-
-      const auto frame = new QFrame();
-      frame->setObjectName("JenkinsOutput");
-
-      const auto layout = new QVBoxLayout(frame);
-      layout->setContentsMargins(10, 10, 10, 10);
-      layout->setSpacing(10);
-      layout->addWidget(find);
-      layout->addWidget(text);
-
-      const auto index = mTabWidget->addTab(frame, QString("Output for #%1").arg(buildNumber));
+      const auto index = mTabWidget->addTab(viewer, QString("Output for #%1").arg(build.number));
       mTabWidget->setCurrentIndex(index);
 
-      mTabBuildMap.insert(buildNumber, index);
+      mTabBuildMap.insert(build.number, index);
    }
-
-   reply->deleteLater();
 }
 
 void JenkinsJobPanel::createBuildConfigPanel()
@@ -12,7 +12,6 @@ class QButtonGroup;
 class QRadioButton;
 class QPinnableTabWidget;
 class QNetworkAccessManager;
-class QPlainTextEdit;
 class QPushButton;
 class ButtonLink;
 
@@ -44,6 +43,8 @@ private:
    QPinnableTabWidget *mTabWidget = nullptr;
    JenkinsJobInfo mRequestedJob;
    int mTmpBuildsCounter = 0;
+   int mLastBuildNumber = 0;
+   QVector<int> mInsertedBuilds;
    QVector<QWidget *> mTempWidgets;
    QVector<QString> mDownloadedFiles;
    QNetworkAccessManager *mManager = nullptr;
@@ -53,7 +54,6 @@ private:
    void appendJobsData(const QString &jobName, const JenkinsJobBuildInfo &build);
    void fillBuildLayout(const Jenkins::JenkinsJobBuildInfo &build, QHBoxLayout *layout);
    void requestFile(const Jenkins::JenkinsJobBuildInfo &build);
-   void storeFile(int buildNumber);
    void createBuildConfigPanel();
    void triggerBuild();
    void showArtifacts(const Jenkins::JenkinsJobBuildInfo &build);
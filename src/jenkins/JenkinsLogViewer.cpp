@@ -0,0 +1,106 @@
+#include <JenkinsLogViewer.h>
+
+#include <DiffHelper.h>
+
+#include <QLineEdit>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QPlainTextEdit>
+#include <QScrollBar>
+#include <QTextCursor>
+#include <QTimer>
+#include <QVBoxLayout>
+
+namespace Jenkins
+{
+
+namespace
+{
+// The view keeps at most this many lines: older ones are dropped from the top, so the memory
+// stays constant no matter how long the pipeline log grows
+constexpr auto MaxLogLines = 20000;
+// Polling period while the build reports that more data is coming
+constexpr auto PollIntervalMs = 2000;
+}
+
+JenkinsLogViewer::JenkinsLogViewer(const IFetcher::Config &config, const QString &buildUrl, QWidget *parent)
+   : QFrame(parent)
+   , mConfig(config)
+   , mBuildUrl(buildUrl)
+   , mFind(new QLineEdit())
+   , mText(new QPlainTextEdit())
+{
+   setObjectName("JenkinsOutput");
+
+   mText->setReadOnly(true);
+   mText->setObjectName("JenkinsOutput");
+   mText->setMaximumBlockCount(MaxLogLines);
+
+   mFind->setPlaceholderText(tr("Find text... "));
+   connect(mFind, &QLineEdit::editingFinished, this,
+           [this]() { DiffHelper::findString(mFind->text(), mText, this); });
+
+   const auto layout = new QVBoxLayout(this);
+   layout->setContentsMargins(10, 10, 10, 10);
+   layout->setSpacing(10);
+   layout->addWidget(mFind);
+   layout->addWidget(mText);
+
+   requestChunk();
+}
+
+void JenkinsLogViewer::requestChunk()
+{
+   if (mFetchInFlight)
+      return;
+
+   mFetchInFlight = true;
+
+   auto urlStr = mBuildUrl;
+   urlStr.append(QString("/logText/progressiveText?start=%1").arg(mOffset));
+   QNetworkRequest request(urlStr);
+
+   if (!mConfig.user.isEmpty() && !mConfig.token.isEmpty())
+      request.setRawHeader(QByteArray("Authorization"),
+                           QString("Basic %1:%2").arg(mConfig.user, mConfig.token).toLocal8Bit().toBase64());
+
+   const auto reply = mConfig.accessManager->get(request);
+   connect(reply, &QNetworkReply::finished, this, [this, reply]() { onChunkReceived(reply); });
+}
+
+void JenkinsLogViewer::onChunkReceived(QNetworkReply *reply)
+{
+   mFetchInFlight = false;
+
+   const auto data = reply->readAll();
+   const auto scrollBar = mText->verticalScrollBar();
+   const auto followTail = scrollBar->value() == scrollBar->maximum();
+
+   if (!data.isEmpty())
+   {
+      // The text is inserted at the end instead of appended as a block, so a line split across
+      // two chunks is stitched back together
+      auto cursor = mText->textCursor();
+      cursor.movePosition(QTextCursor::End);
+      cursor.insertText(QString::fromUtf8(data));
+
+      // The tail is only followed while the user is already at the bottom, so scrolling back to
+      // read an earlier stage isn't fought by the stream
+      if (followTail)
+         scrollBar->setValue(scrollBar->maximum());
+   }
+
+   // The progressive endpoint reports the next offset and whether the build is still producing
+   // output; polling stops on the last chunk of a finished build
+   if (const auto textSize = reply->rawHeader("X-Text-Size"); !textSize.isEmpty())
+      mOffset = textSize.toLongLong();
+   else
+      mOffset += data.size();
+
+   if (reply->rawHeader("X-More-Data") == "true")
+      QTimer::singleShot(PollIntervalMs, this, &JenkinsLogViewer::requestChunk);
+
+   reply->deleteLater();
+}
+
+}
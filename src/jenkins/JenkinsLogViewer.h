@@ -0,0 +1,53 @@
+#pragma once
+
+#include <IFetcher.h>
+
+#include <QFrame>
+
+class QLineEdit;
+class QPlainTextEdit;
+class QNetworkReply;
+
+namespace Jenkins
+{
+
+/**
+ * @brief The JenkinsLogViewer class shows the console output of a build by streaming it through
+ * the Jenkins progressive-text endpoint instead of downloading it as one blob. Every poll asks
+ * only for the bytes after the last received offset, and the view keeps a bounded number of lines
+ * so even multi-hundred-MB pipeline logs display with constant memory. While the build is still
+ * running the viewer keeps polling and follows the tail unless the user scrolled away from it.
+ */
+class JenkinsLogViewer : public QFrame
+{
+   Q_OBJECT
+
+public:
+   /**
+    * @brief JenkinsLogViewer Creates the viewer and starts streaming right away.
+    * @param config The fetcher config with the user and token.
+    * @param buildUrl The URL of the build whose console will be shown.
+    * @param parent The parent widget.
+    */
+   explicit JenkinsLogViewer(const IFetcher::Config &config, const QString &buildUrl, QWidget *parent = nullptr);
+
+private:
+   IFetcher::Config mConfig;
+   QString mBuildUrl;
+   QLineEdit *mFind = nullptr;
+   QPlainTextEdit *mText = nullptr;
+   qint64 mOffset = 0;
+   bool mFetchInFlight = false;
+
+   /**
+    * @brief requestChunk Asks for the console text starting at the current offset.
+    */
+   void requestChunk();
+   /**
+    * @brief onChunkReceived Appends the received bytes, advances the offset and schedules the
+    * next poll when the build reports more data to come.
+    */
+   void onChunkReceived(QNetworkReply *reply);
+};
+
+}
@@ -1,6 +1,7 @@
 #include "JenkinsWidget.h"
 
 #include <RepoFetcher.h>
+#include <JenkinsCacheSnapshot.h>
 #include <JobContainer.h>
 #include <GitQlientSettings.h>
 #include <GitBase.h>
@@ -54,17 +55,57 @@ JenkinsWidget::JenkinsWidget(const QSharedPointer<GitBase> &git, QWidget *parent
    mRepoFetcher = new RepoFetcher(mConfig, url, this);
    connect(mRepoFetcher, &RepoFetcher::signalViewsReceived, this, &JenkinsWidget::configureGeneralView);
 
+   /* The job tree of the previous session renders instantly (marked stale on the view buttons)
+    * while the fetch every container triggers on creation reconciles it in the background. */
+   QVector<JenkinsViewInfo> cachedViews;
+   QHash<QString, QMultiMap<QString, JenkinsJobInfo>> cachedJobs;
+
+   if (JenkinsCacheSnapshot(mGit->getGitDir()).load(cachedViews, cachedJobs))
+   {
+      mWarmStarting = true;
+      configureGeneralView(cachedViews);
+      mWarmStarting = false;
+
+      const auto end = mJobsMap.cend();
+
+      for (auto iter = mJobsMap.cbegin(); iter != end; ++iter)
+      {
+         if (cachedJobs.contains(iter.key()))
+            iter.value()->warmStart(cachedJobs.value(iter.key()));
+      }
+   }
+
 #if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
    connect(mBtnGroup, &QButtonGroup::idClicked, mStackedLayout, &QStackedLayout::setCurrentIndex);
 #else
    connect(mBtnGroup, SIGNAL(buttonClicked(int)), mStackedLayout, SLOT(setCurrentIndex(int)));
 #endif
 
+   // The periodic refresh only polls the lightweight jobs listing: containers update in place the
+   // jobs whose state changed, so an idle tab barely touches the network.
+   connect(mTimer, &QTimer::timeout, this, [this]() {
+      for (const auto &container : qAsConst(mJobsMap))
+         container->poll();
+   });
+
    mTimer->setInterval(15 * 60 * 1000); // 15 mins
+   mTimer->start();
 }
 
 JenkinsWidget::~JenkinsWidget()
 {
+   /* An empty tree isn't saved: it would wipe a valid snapshot after an offline session. */
+   if (!mViews.isEmpty())
+   {
+      QHash<QString, QMultiMap<QString, JenkinsJobInfo>> jobsByView;
+      const auto end = mJobsMap.cend();
+
+      for (auto iter = mJobsMap.cbegin(); iter != end; ++iter)
+         jobsByView.insert(iter.key(), iter.value()->groupedJobs());
+
+      JenkinsCacheSnapshot(mGit->getGitDir()).save(mViews, jobsByView);
+   }
+
    delete mBtnGroup;
 }
 
@@ -87,6 +128,19 @@ void JenkinsWidget::configureGeneralView(const QVector<JenkinsViewInfo> &views)
 
          const auto container = new JobContainer(mConfig, view, this);
          container->setObjectName("JobContainer");
+
+         if (mWarmStarting)
+         {
+            // The stale mark goes away when the first listing fetched from the server lands
+            button->setText(view.name + QStringLiteral(" *"));
+            button->setToolTip(tr("Showing cached data"));
+
+            connect(container, &JobContainer::liveDataReceived, button, [button, view]() {
+               button->setText(view.name);
+               button->setToolTip(QString());
+            });
+         }
+
          connect(container, &JobContainer::signalJobAreViews, this, &JenkinsWidget::configureGeneralView);
          connect(container, &JobContainer::gotoBranch, this, &JenkinsWidget::gotoBranch);
          connect(container, &JobContainer::gotoPullRequest, this, &JenkinsWidget::gotoPullRequest);
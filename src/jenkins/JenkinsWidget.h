@@ -44,6 +44,7 @@ private:
    QVector<JenkinsViewInfo> mViews;
    QMap<QString, JobContainer *> mJobsMap;
    QTimer *mTimer = nullptr;
+   bool mWarmStarting = false;
 
    void configureGeneralView(const QVector<JenkinsViewInfo> &views);
 };
@@ -0,0 +1,141 @@
+#include "JobBuildsFetcher.h"
+
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+
+namespace Jenkins
+{
+
+JobBuildsFetcher::JobBuildsFetcher(const Config &config, const JenkinsJobInfo &job, QObject *parent)
+   : IFetcher(config, parent)
+   , mJob(job)
+{
+}
+
+void JobBuildsFetcher::triggerFetch()
+{
+   const auto base = mJob.url.endsWith("/") ? mJob.url : mJob.url + "/";
+
+   // One filtered request returns for every build what the old chain fetched with a request per
+   // build, and the server only serializes the listed fields
+   get(base
+           + QString::fromUtf8("api/json?tree=builds[number,url,duration,result,timestamp,"
+                               "culprits[fullName],artifacts[fileName]]"),
+       true);
+}
+
+void JobBuildsFetcher::processData(const QJsonDocument &json)
+{
+   // The builds reply is an object while the workflow runs reply is a plain array
+   if (json.isArray())
+      processRuns(json);
+   else
+      processBuilds(json);
+}
+
+void JobBuildsFetcher::processBuilds(const QJsonDocument &json)
+{
+   const auto buildsArray = json.object()[QStringLiteral("builds")].toArray();
+
+   for (const auto &buildData : buildsArray)
+   {
+      const auto jsonObject = buildData.toObject();
+      JenkinsJobBuildInfo build;
+
+      if (jsonObject.contains(QStringLiteral("number")))
+         build.number = jsonObject[QStringLiteral("number")].toInt();
+      if (jsonObject.contains(QStringLiteral("url")))
+         build.url = jsonObject[QStringLiteral("url")].toString();
+      if (jsonObject.contains(QStringLiteral("duration")))
+         build.duration = jsonObject[QStringLiteral("duration")].toInt();
+      if (jsonObject.contains(QStringLiteral("result")))
+         build.result = jsonObject[QStringLiteral("result")].toString();
+      if (jsonObject.contains(QStringLiteral("timestamp")))
+         build.date = QDateTime::fromMSecsSinceEpoch(
+             static_cast<qint64>(jsonObject[QStringLiteral("timestamp")].toDouble()));
+
+      if (jsonObject.contains(QStringLiteral("culprits")))
+      {
+         const auto culprits = jsonObject[QStringLiteral("culprits")].toArray();
+
+         for (const auto &item : culprits)
+         {
+            const auto obj = item.toObject();
+
+            if (obj.contains(QStringLiteral("fullName")))
+            {
+               build.user = obj[QStringLiteral("fullName")].toString();
+               break;
+            }
+         }
+      }
+
+      if (jsonObject.contains(QStringLiteral("artifacts")))
+      {
+         const auto artifacts = jsonObject[QStringLiteral("artifacts")].toArray();
+
+         for (const auto &artifact : artifacts)
+         {
+            JenkinsJobBuildInfo::Artifact sArtifact;
+            sArtifact.fileName = artifact[QStringLiteral("fileName")].toString();
+            sArtifact.url = QString("%1artifact/%2").arg(build.url, sArtifact.fileName);
+
+            build.artifacts.append(sArtifact);
+         }
+      }
+
+      mBuilds.append(build);
+   }
+
+   const auto base = mJob.url.endsWith("/") ? mJob.url : mJob.url + "/";
+
+   // The workflow API lists the stages of all the runs at once, replacing the wfapi/describe
+   // request the old chain issued per build
+   get(base + QString::fromUtf8("wfapi/runs"), true);
+}
+
+void JobBuildsFetcher::processRuns(const QJsonDocument &json)
+{
+   const auto runs = json.array();
+
+   for (const auto &runData : runs)
+   {
+      const auto runObj = runData.toObject();
+      const auto number = runObj[QStringLiteral("id")].toString().toInt();
+
+      const auto iter = std::find_if(mBuilds.begin(), mBuilds.end(),
+                                     [number](const JenkinsJobBuildInfo &build) { return build.number == number; });
+
+      if (iter == mBuilds.end())
+         continue;
+
+      const auto stages = runObj[QStringLiteral("stages")].toArray();
+
+      for (const auto &stageInfo : stages)
+      {
+         JenkinsStageInfo stage;
+         const auto obj = stageInfo.toObject();
+
+         if (obj.contains(QStringLiteral("name")) && !obj[QStringLiteral("name")].toString().contains("Build"))
+         {
+            stage.name = obj[QStringLiteral("name")].toString();
+
+            if (obj.contains(QStringLiteral("id")))
+               stage.id = obj[QStringLiteral("id")].toInt();
+            if (obj.contains(QStringLiteral("links")))
+               stage.url = obj[QStringLiteral("links")].toObject()["self"].toObject()["href"].toString();
+            if (obj.contains(QStringLiteral("status")))
+               stage.result = obj[QStringLiteral("status")].toString();
+            if (obj.contains(QStringLiteral("durationMillis")))
+               stage.duration = obj[QStringLiteral("durationMillis")].toInt();
+
+            iter->stages.append(stage);
+         }
+      }
+   }
+
+   emit signalBuildsInfoReceived(mBuilds);
+}
+
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <IFetcher.h>
+#include <JenkinsJobInfo.h>
+
+namespace Jenkins
+{
+
+/**
+ * @brief The JobBuildsFetcher class retrieves the details of every build of a job in one
+ * tree-filtered request, instead of chaining two requests per build. A second call to the
+ * workflow API brings the stages of all the runs at once, so a refresh costs two requests no
+ * matter how many builds the job has.
+ */
+class JobBuildsFetcher : public IFetcher
+{
+   Q_OBJECT
+
+signals:
+   /**
+    * @brief signalBuildsInfoReceived Signal emitted once with the full details of all the builds.
+    * @param builds The builds with their stages.
+    */
+   void signalBuildsInfoReceived(const QVector<JenkinsJobBuildInfo> &builds);
+
+public:
+   /**
+    * @brief JobBuildsFetcher Constructor.
+    * @param config The fetcher config with the user and token.
+    * @param job The job whose builds will be fetched.
+    * @param parent The parent object.
+    */
+   JobBuildsFetcher(const IFetcher::Config &config, const JenkinsJobInfo &job, QObject *parent = nullptr);
+
+   /**
+    * @brief triggerFetch Fires the tree-filtered builds request.
+    */
+   void triggerFetch() override;
+
+private:
+   JenkinsJobInfo mJob;
+   QVector<JenkinsJobBuildInfo> mBuilds;
+
+   /**
+    * @brief processData Parses the builds reply first and the runs reply afterwards; the two are
+    * told apart by their JSON shape.
+    * @param json The data to process.
+    */
+   void processData(const QJsonDocument &json) override;
+   /**
+    * @brief processBuilds Fills the builds from the tree-filtered reply and asks for the stages.
+    * @param json The builds reply.
+    */
+   void processBuilds(const QJsonDocument &json);
+   /**
+    * @brief processRuns Attaches the stages of every run to its build and emits the result.
+    * @param json The workflow runs reply.
+    */
+   void processRuns(const QJsonDocument &json);
+};
+
+}
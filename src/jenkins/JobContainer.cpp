@@ -46,11 +46,35 @@ void JobContainer::reload()
    mJobFetcher->triggerFetch();
 }
 
+void JobContainer::poll()
+{
+   mJobFetcher->triggerPoll();
+}
+
+void JobContainer::warmStart(const QMultiMap<QString, JenkinsJobInfo> &jobs)
+{
+   mWarmStarting = true;
+   addJobs(jobs);
+   mWarmStarting = false;
+}
+
 void JobContainer::addJobs(const QMultiMap<QString, JenkinsJobInfo> &jobs)
 {
    QVector<JenkinsViewInfo> views;
 
    const auto keys = jobs.uniqueKeys();
+
+   /* Every listing carries the full set of its views, so the persisted copy replaces them
+    * wholesale instead of accumulating removed jobs. */
+   for (const auto &key : keys)
+   {
+      mGroupedJobs.remove(key);
+
+      const auto values = jobs.values(key);
+
+      for (const auto &job : values)
+         mGroupedJobs.insert(key, job);
+   }
    const auto totalKeys = keys.count();
    const auto splitView = totalKeys <= 2;
 
@@ -96,8 +120,22 @@ void JobContainer::addJobs(const QMultiMap<QString, JenkinsJobInfo> &jobs)
 
       for (const auto &job : qAsConst(values))
       {
-         if (mJobsList.contains(job))
+         const auto jobIndex = mJobsList.indexOf(job);
+
+         if (jobIndex != -1)
+         {
+            auto &storedJob = mJobsList[jobIndex];
+
+            if (storedJob.color != job.color || storedJob.lastBuildNumber != job.lastBuildNumber)
+            {
+               storedJob.color = job.color;
+               storedJob.lastBuildNumber = job.lastBuildNumber;
+
+               updateJobItem(storedJob);
+            }
+
             continue;
+         }
 
          mJobsList.append(job);
 
@@ -121,6 +159,8 @@ void JobContainer::addJobs(const QMultiMap<QString, JenkinsJobInfo> &jobs)
                QVariant v;
                v.setValue(job);
                jobItem->setData(Qt::UserRole, std::move(v));
+
+               mListItems.insert(job.name, jobItem);
             }
             else
             {
@@ -133,6 +173,8 @@ void JobContainer::addJobs(const QMultiMap<QString, JenkinsJobInfo> &jobs)
 
                jobItem->setData(0, Qt::UserRole, std::move(v));
                jobItem->setIcon(0, getIconForJob(job));
+
+               mTreeItems.insert(job.name, jobItem);
             }
          }
       }
@@ -143,6 +185,29 @@ void JobContainer::addJobs(const QMultiMap<QString, JenkinsJobInfo> &jobs)
 
    if (!views.isEmpty())
       emit signalJobAreViews(views);
+
+   if (!mWarmStarting && !mLiveDataReceived)
+   {
+      mLiveDataReceived = true;
+      emit liveDataReceived();
+   }
+}
+
+void JobContainer::updateJobItem(const JenkinsJobInfo &job)
+{
+   QVariant v;
+   v.setValue(job);
+
+   if (const auto listItem = mListItems.value(job.name, nullptr))
+   {
+      listItem->setIcon(getIconForJob(job));
+      listItem->setData(Qt::UserRole, v);
+   }
+   else if (const auto treeItem = mTreeItems.value(job.name, nullptr))
+   {
+      treeItem->setIcon(0, getIconForJob(job));
+      treeItem->setData(0, Qt::UserRole, v);
+   }
 }
 
 void JobContainer::requestUpdatedJobInfo(const JenkinsJobInfo &jobInfo)
@@ -9,6 +9,7 @@
 class QVBoxLayout;
 class QTreeWidgetItem;
 class QListWidget;
+class QListWidgetItem;
 class QLabel;
 class QHBoxLayout;
 class QTreeWidget;
@@ -24,6 +25,11 @@ class JobContainer : public QFrame
 
 signals:
    void signalJobAreViews(const QVector<JenkinsViewInfo> &views);
+   /**
+    * @brief liveDataReceived Signal triggered when the first listing fetched from the server
+    * lands, meaning the warm-started data is reconciled and no longer stale.
+    */
+   void liveDataReceived();
    void gotoPullRequest(int prNumber);
    void gotoBranch(const QString &branchName);
 
@@ -32,6 +38,25 @@ public:
 
    void reload();
 
+   /**
+    * @brief poll Requests the lightweight jobs listing so the refresh timer only detects state
+    * changes instead of re-downloading every job. Jobs whose color or last build number changed
+    * are updated in place by @ref addJobs.
+    */
+   void poll();
+
+   /**
+    * @brief warmStart Renders the jobs stored by the previous session while the fetch triggered
+    * in the constructor reconciles them in the background.
+    * @param jobs The jobs of the snapshot, grouped by view.
+    */
+   void warmStart(const QMultiMap<QString, JenkinsJobInfo> &jobs);
+
+   /**
+    * @brief groupedJobs Returns the last received listing grouped by view, ready to be persisted.
+    */
+   QMultiMap<QString, JenkinsJobInfo> groupedJobs() const { return mGroupedJobs; }
+
 private:
    IFetcher::Config mConfig;
    JenkinsViewInfo mView;
@@ -40,10 +65,16 @@ private:
    QVBoxLayout *mJobListLayout = nullptr;
    JenkinsJobPanel *mJobPanel = nullptr;
    QVector<JenkinsJobInfo> mJobsList;
+   QMultiMap<QString, JenkinsJobInfo> mGroupedJobs;
+   bool mWarmStarting = false;
+   bool mLiveDataReceived = false;
    QTreeWidget *mJobsTree = nullptr;
    QMap<QString, QListWidget *> mListsMap;
+   QMap<QString, QListWidgetItem *> mListItems;
+   QMap<QString, QTreeWidgetItem *> mTreeItems;
 
    void addJobs(const QMultiMap<QString, JenkinsJobInfo> &jobs);
+   void updateJobItem(const JenkinsJobInfo &job);
    void requestUpdatedJobInfo(const JenkinsJobInfo &jobInfo);
    void onJobInfoReceived(JenkinsJobInfo oldInfo, const JenkinsJobInfo &newInfo);
    void showJobInfo(QTreeWidgetItem *item, int column);
@@ -25,6 +25,13 @@ void JobFetcher::triggerFetch()
    get(mJobUrl);
 }
 
+void JobFetcher::triggerPoll()
+{
+   get(mJobUrl
+           + QString::fromUtf8("api/json?tree=views[name,jobs[_class,name,displayName,url,color,lastBuild[number]]]"),
+       true);
+}
+
 void JobFetcher::processData(const QJsonDocument &json)
 {
    const auto jsonObject = json.object();
@@ -69,6 +76,10 @@ void JobFetcher::processData(const QJsonDocument &json)
             if (jobObject.contains(QStringLiteral("color")))
                jobInfo.color = jobObject[QStringLiteral("color")].toString();
 
+            if (jobObject.contains(QStringLiteral("lastBuild")))
+               jobInfo.lastBuildNumber
+                   = jobObject[QStringLiteral("lastBuild")].toObject()[QStringLiteral("number")].toInt();
+
             jobsMap.insert(view[QStringLiteral("name")].toString(), jobInfo);
          }
       }
@@ -18,6 +18,13 @@ public:
 
    void triggerFetch() override;
 
+   /**
+    * @brief triggerPoll Requests a tree-filtered version of the jobs listing that only carries the
+    * fields needed to detect that a job advanced (name, color and last build number). Used by the
+    * refresh timer so an idle instance costs a few KB instead of the full JSON.
+    */
+   void triggerPoll();
+
 private:
    QString mJobUrl;
 
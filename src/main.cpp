@@ -26,6 +26,11 @@ int main(int argc, char *argv[])
    QStringList repos;
    if (GitQlient::parseArguments(app.arguments(), &repos))
    {
+      // A running instance with warm caches beats a cold start: when one accepts the arguments
+      // the repos open as tabs there and this process exits right away
+      if (!repos.isEmpty() && GitQlient::forwardToRunningInstance(app.arguments()))
+         return 0;
+
       GitQlient mainWin;
       mainWin.setRepositories(repos);
       mainWin.show();